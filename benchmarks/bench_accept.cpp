@@ -0,0 +1,113 @@
+// bench_accept.cpp
+//
+// Connection-rate benchmarks for the TCP acceptor.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// Each iteration makes a new loopback connection, accepts it, and closes
+// both sides, so this is the full cost of setting up and tearing down a
+// connection, as seen by a single-threaded server and client.
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+
+using namespace sockpp;
+
+// Closes the client with a reset rather than a FIN, so that no socket is
+// left in TIME_WAIT. Otherwise a long run would exhaust the ephemeral
+// ports.
+
+static void abort_close(tcp_connector& conn) {
+    conn.set_option(SOL_SOCKET, SO_LINGER, linger{1, 0});
+    conn.close();
+}
+
+// --------------------------------------------------------------------------
+
+static void BM_tcp_accept(benchmark::State& state) {
+    tcp_acceptor acc{bench::loopback(), 1024, acceptor::REUSE};
+    auto addr = acc.address();
+
+    for (auto _ : state) {
+        tcp_connector conn;
+        if (!conn.connect(addr)) {
+            state.SkipWithError("connect failed");
+            break;
+        }
+
+        auto res = acc.accept();
+        if (!res) {
+            state.SkipWithError("accept failed");
+            break;
+        }
+
+        abort_close(conn);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_tcp_accept);
+
+// --------------------------------------------------------------------------
+
+static void BM_tcp_accept_peer(benchmark::State& state) {
+    tcp_acceptor acc{bench::loopback(), 1024, acceptor::REUSE};
+    auto addr = acc.address();
+
+    for (auto _ : state) {
+        tcp_connector conn;
+        if (!conn.connect(addr)) {
+            state.SkipWithError("connect failed");
+            break;
+        }
+
+        inet_address peer;
+        auto res = acc.accept(&peer);
+        if (!res) {
+            state.SkipWithError("accept failed");
+            break;
+        }
+        benchmark::DoNotOptimize(peer);
+        abort_close(conn);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_tcp_accept_peer);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+// bench_address.cpp
+//
+// Benchmarks for creating, parsing and formatting internet addresses.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <benchmark/benchmark.h>
+
+#include "sockpp/inet6_address.h"
+#include "sockpp/inet_address.h"
+
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+// Creating
+
+static void BM_inet_address_create_numeric(benchmark::State& state) {
+    for (auto _ : state) {
+        auto res = inet_address::create("192.168.1.100", 12345);
+        benchmark::DoNotOptimize(res);
+    }
+}
+BENCHMARK(BM_inet_address_create_numeric);
+
+// This goes through the resolver, so it's mostly a measure of the system
+// name lookup.
+static void BM_inet_address_create_localhost(benchmark::State& state) {
+    for (auto _ : state) {
+        auto res = inet_address::create("localhost", 12345);
+        benchmark::DoNotOptimize(res);
+    }
+}
+BENCHMARK(BM_inet_address_create_localhost);
+
+static void BM_inet_address_parse(benchmark::State& state) {
+    for (auto _ : state) {
+        auto res = inet_address::parse("192.168.1.100:12345");
+        benchmark::DoNotOptimize(res);
+    }
+}
+BENCHMARK(BM_inet_address_parse);
+
+static void BM_inet6_address_create_numeric(benchmark::State& state) {
+    for (auto _ : state) {
+        auto res = inet6_address::create("fe80::1:2:3:4", 12345);
+        benchmark::DoNotOptimize(res);
+    }
+}
+BENCHMARK(BM_inet6_address_create_numeric);
+
+// --------------------------------------------------------------------------
+// Formatting
+
+static void BM_inet_address_to_string(benchmark::State& state) {
+    inet_address addr{"192.168.1.100", 12345};
+
+    for (auto _ : state) {
+        auto s = addr.to_string();
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_inet_address_to_string);
+
+static void BM_inet_address_to_chars(benchmark::State& state) {
+    inet_address addr{"192.168.1.100", 12345};
+    char buf[inet_address::MAX_STR_LEN];
+
+    for (auto _ : state) {
+        auto res = addr.to_chars(buf, buf + sizeof(buf));
+        benchmark::DoNotOptimize(res);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_inet_address_to_chars);
+
+static void BM_inet6_address_to_string(benchmark::State& state) {
+    inet6_address addr{"fe80::1:2:3:4", 12345};
+
+    for (auto _ : state) {
+        auto s = addr.to_string();
+        benchmark::DoNotOptimize(s);
+    }
+}
+BENCHMARK(BM_inet6_address_to_string);
+
+BENCHMARK_MAIN();
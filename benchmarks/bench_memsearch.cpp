@@ -0,0 +1,130 @@
+// bench_memsearch.cpp
+//
+// Benchmarks for the vectorized memory searches.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// These scan a buffer with no match until the very end, so the rate
+// reported by each one is the scan speed of a kernel, in bytes per second
+// on one core. The plain memchr() and string_view::find() runs are the
+// baselines.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "sockpp/memsearch.h"
+
+using namespace sockpp;
+
+// A buffer of text with a line ending only at the very end. Stray '\r'
+// bytes make the CRLF search verify some false candidates.
+static std::string make_text(size_t n) {
+    std::string s(n, 'x');
+    for (size_t i = 61; i + 2 < n; i += 64) s[i] = '\r';
+    s.replace(n - 2, 2, "\r\n");
+    return s;
+}
+
+// --------------------------------------------------------------------------
+
+static void BM_memchr(benchmark::State& state) {
+    auto s = make_text(size_t(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::memchr(s.data(), '\n', s.size()));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_memchr)->Range(64, 64 << 10);
+
+template <search_kernel K>
+static void BM_find_byte(benchmark::State& state) {
+    if (!search_kernel_supported(K)) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    auto s = make_text(size_t(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_byte(K, s.data(), s.size(), '\n'));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_find_byte, search_kernel::generic)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_byte, search_kernel::sse2)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_byte, search_kernel::avx2)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_byte, search_kernel::neon)->Range(64, 64 << 10);
+
+// --------------------------------------------------------------------------
+
+static void BM_string_view_find(benchmark::State& state) {
+    auto s = make_text(size_t(state.range(0)));
+    std::string_view sv{s};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sv.find("\r\n"));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_string_view_find)->Range(64, 64 << 10);
+
+template <search_kernel K>
+static void BM_find_crlf(benchmark::State& state) {
+    if (!search_kernel_supported(K)) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    auto s = make_text(size_t(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_seq(K, s.data(), s.size(), "\r\n"));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_find_crlf, search_kernel::generic)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_crlf, search_kernel::sse2)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_crlf, search_kernel::avx2)->Range(64, 64 << 10);
+BENCHMARK_TEMPLATE(BM_find_crlf, search_kernel::neon)->Range(64, 64 << 10);
+
+BENCHMARK_MAIN();
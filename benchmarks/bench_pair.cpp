@@ -0,0 +1,93 @@
+// bench_pair.cpp
+//
+// Benchmarks for connected socket pairs.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// These measure the cost of creating a connected pair of sockets, and
+// of a single-threaded round trip through the pair, which is all system
+// call and wrapper overhead with no scheduling in between.
+
+#include <benchmark/benchmark.h>
+
+#include "sockpp/datagram_socket.h"
+#include "sockpp/stream_socket.h"
+
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+
+static void BM_socket_pair_create(benchmark::State& state) {
+    for (auto _ : state) {
+        auto res = socket::pair(AF_UNIX, SOCK_STREAM);
+        if (!res) {
+            state.SkipWithError("pair failed");
+            break;
+        }
+        benchmark::DoNotOptimize(res);
+    }
+}
+BENCHMARK(BM_socket_pair_create);
+
+// --------------------------------------------------------------------------
+
+template <int TYPE>
+static void BM_socket_pair_round_trip(benchmark::State& state) {
+    auto res = socket::pair(AF_UNIX, TYPE);
+    if (!res) {
+        state.SkipWithError("pair failed");
+        return;
+    }
+
+    auto [a, b] = res.release();
+    auto n = size_t(state.range(0));
+    std::vector<char> buf(n, 'x');
+
+    for (auto _ : state) {
+        if (a.send(buf.data(), n) != n || b.recv(buf.data(), n) != n ||
+            b.send(buf.data(), n) != n || a.recv(buf.data(), n) != n) {
+            state.SkipWithError("round trip failed");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_socket_pair_round_trip, SOCK_STREAM)->Arg(1)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_socket_pair_round_trip, SOCK_DGRAM)->Arg(1)->Arg(1024);
+
+BENCHMARK_MAIN();
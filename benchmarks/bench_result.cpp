@@ -0,0 +1,157 @@
+// bench_result.cpp
+//
+// Microbenchmarks for the per-call overhead of sockpp::result.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// Each pair of benchmarks does the same system call, once directly and
+// once through the sockpp wrapper, so the difference between them is the
+// cost of building and checking a result<>. The error-path benchmarks
+// read from an empty, non-blocking socket, so the call fails immediately
+// with EAGAIN and never touches any data.
+
+#include <benchmark/benchmark.h>
+#include <sys/socket.h>
+
+#include "sockpp/unix_stream_socket.h"
+
+using namespace sockpp;
+
+namespace {
+
+// A connected pair of non-blocking UNIX-domain stream sockets.
+struct sock_pair
+{
+    unix_stream_socket a, b;
+
+    sock_pair() {
+        auto [sa, sb] = unix_stream_socket::pair().release_or_throw();
+        a = std::move(sa);
+        b = std::move(sb);
+        a.set_non_blocking();
+        b.set_non_blocking();
+    }
+};
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+// Failed reads (EAGAIN)
+
+static void BM_raw_recv_wouldblock(benchmark::State& state) {
+    sock_pair sp;
+    char buf[64];
+    int64_t nerr = 0;
+
+    for (auto _ : state) {
+        auto n = ::recv(sp.b.handle(), buf, sizeof(buf), 0);
+        if (n < 0 && errno == EAGAIN)
+            ++nerr;
+        benchmark::DoNotOptimize(n);
+    }
+    state.counters["errors"] = double(nerr);
+}
+BENCHMARK(BM_raw_recv_wouldblock);
+
+static void BM_sockpp_read_wouldblock(benchmark::State& state) {
+    sock_pair sp;
+    char buf[64];
+    int64_t nerr = 0;
+
+    for (auto _ : state) {
+        auto res = sp.b.read(buf, sizeof(buf));
+        if (res.is_error(errc::operation_would_block))
+            ++nerr;
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["errors"] = double(nerr);
+}
+BENCHMARK(BM_sockpp_read_wouldblock);
+
+// --------------------------------------------------------------------------
+// Successful single-byte transfers
+
+static void BM_raw_send_recv(benchmark::State& state) {
+    sock_pair sp;
+    char c = 'x';
+
+    for (auto _ : state) {
+        auto n = ::send(sp.a.handle(), &c, 1, 0);
+        n += ::recv(sp.b.handle(), &c, 1, 0);
+        benchmark::DoNotOptimize(n);
+    }
+}
+BENCHMARK(BM_raw_send_recv);
+
+static void BM_sockpp_write_read(benchmark::State& state) {
+    sock_pair sp;
+    char c = 'x';
+
+    for (auto _ : state) {
+        auto n = sp.a.write(&c, 1).value();
+        n += sp.b.read(&c, 1).value();
+        benchmark::DoNotOptimize(n);
+    }
+}
+BENCHMARK(BM_sockpp_write_read);
+
+// --------------------------------------------------------------------------
+// Error checks, without any system call
+
+static void BM_result_is_interrupted(benchmark::State& state) {
+    auto res = result<size_t>::from_error(EAGAIN);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(res);
+        bool b = (res == errc::interrupted);
+        benchmark::DoNotOptimize(b);
+    }
+}
+BENCHMARK(BM_result_is_interrupted);
+
+static void BM_error_code_is_interrupted(benchmark::State& state) {
+    auto ec = error_code{EAGAIN, std::system_category()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ec);
+        bool b = (ec == errc::interrupted);
+        benchmark::DoNotOptimize(b);
+    }
+}
+BENCHMARK(BM_error_code_is_interrupted);
+
+BENCHMARK_MAIN();
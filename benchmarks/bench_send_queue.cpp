@@ -0,0 +1,145 @@
+// bench_send_queue.cpp
+//
+// Benchmarks for many threads writing to one connection.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// Each benchmark thread is a producer sending small messages to the same
+// TCP connection, as in a pub/sub fanout to one subscriber. The baseline
+// serializes the producers with a mutex around a blocking write. The
+// send_queue version has them push without a lock, while a separate
+// thread owns the socket and flushes the queue with gathered writes.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "bench_util.h"
+#include "sockpp/send_queue.h"
+
+using namespace sockpp;
+
+// The size of each message
+static constexpr size_t MSG_SIZE = 64;
+
+// Producers wait when this much is queued, so memory stays bounded
+static constexpr size_t MAX_QUEUED = 1024 * 1024;
+
+namespace {
+
+// A connection to a thread that discards everything it receives.
+struct connection
+{
+    tcp_socket sock;
+    bench::peer<tcp_socket> sink;
+
+    connection(std::tuple<tcp_socket, tcp_socket> socks)
+        : sock{std::move(std::get<0>(socks))},
+          sink{bench::peer<tcp_socket>::sink(std::move(std::get<1>(socks)))} {}
+
+    ~connection() { sock.shutdown(); }
+};
+
+std::unique_ptr<connection> conn;
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+static void BM_mutex_write(benchmark::State& state) {
+    static std::mutex mtx;
+
+    if (state.thread_index() == 0)
+        conn = std::make_unique<connection>(bench::tcp_pair());
+
+    char msg[MSG_SIZE] = {0};
+
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lk{mtx};
+        conn->sock.write_n(msg, MSG_SIZE);
+    }
+
+    if (state.thread_index() == 0)
+        conn.reset();
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(MSG_SIZE));
+}
+BENCHMARK(BM_mutex_write)->ThreadRange(1, 8)->UseRealTime();
+
+// --------------------------------------------------------------------------
+
+static void BM_send_queue(benchmark::State& state) {
+    static std::unique_ptr<buffer_pool> pool;
+    static std::unique_ptr<send_queue> que;
+    static std::atomic<bool> done;
+    static std::thread flusher;
+
+    if (state.thread_index() == 0) {
+        conn = std::make_unique<connection>(bench::tcp_pair());
+        pool = std::make_unique<buffer_pool>(4096);
+        que = std::make_unique<send_queue>(*pool);
+        done = false;
+        flusher = std::thread([] {
+            while (!done) {
+                if (que->flush(conn->sock).value() == 0)
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    char msg[MSG_SIZE] = {0};
+
+    for (auto _ : state) {
+        while (que->size() > MAX_QUEUED) std::this_thread::yield();
+        que->push(msg, MSG_SIZE);
+    }
+
+    if (state.thread_index() == 0) {
+        done = true;
+        flusher.join();
+        que.reset();
+        pool.reset();
+        conn.reset();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(MSG_SIZE));
+}
+BENCHMARK(BM_send_queue)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,104 @@
+// bench_sim_link.cpp
+//
+// Benchmarks of transfers over simulated network links.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+// Each iteration moves a block of data across a simulated link, with the
+// application writing and reading in non-blocking mode and running the
+// link in 1ms steps, like an event loop would. The time measured is the
+// CPU cost of the simulation. The virtual time that the transfer took on
+// the simulated link is reported as the "sim_ms" counter, which is the
+// same on every run, so it can be used to catch regressions in how the
+// code behaves on a slow or lossy network.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "sockpp/sim_link.h"
+
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+
+static void BM_sim_stream_transfer(benchmark::State& state) {
+    const size_t N = 1024 * 1024;
+    std::string data(N, 'x');
+    std::vector<char> buf(64 * 1024);
+
+    sim_link::params p;
+    p.latency = milliseconds{10};
+    p.bandwidth = 100'000'000;
+    p.loss = double(state.range(0)) / 1000.0;
+
+    nanoseconds simTime{0};
+
+    for (auto _ : state) {
+        sim_stream_link link{p};
+        auto &a = link.first(), &b = link.second();
+        a.set_non_blocking();
+        b.set_non_blocking();
+
+        size_t nsent = 0, nrcvd = 0;
+        while (nrcvd < N) {
+            if (nsent < N) {
+                if (auto res = a.write(data.data() + nsent, N - nsent); res)
+                    nsent += res.value();
+            }
+            link.advance(milliseconds{1});
+            while (auto res = b.read(buf.data(), buf.size())) {
+                if (res.value() == 0)
+                    break;
+                nrcvd += res.value();
+            }
+        }
+        simTime = link.now();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(N));
+    state.counters["sim_ms"] = double(simTime.count()) / 1.0e6;
+}
+
+// --------------------------------------------------------------------------
+
+// The loss rate, in parts per thousand
+BENCHMARK(BM_sim_stream_transfer)->Arg(0)->Arg(10)->Arg(50);
+
+BENCHMARK_MAIN();
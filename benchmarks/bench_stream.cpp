@@ -0,0 +1,114 @@
+// bench_stream.cpp
+//
+// Throughput and latency benchmarks for TCP and UNIX-domain stream sockets.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// The throughput benchmarks stream blocks of the given size to a thread
+// that just discards them. The latency benchmarks do a ping-pong of a
+// block with a thread that echoes it back, so each iteration is one full
+// round trip.
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+
+template <typename SOCK, std::tuple<SOCK, SOCK> (*MakePair)()>
+static void BM_stream_throughput(benchmark::State& state) {
+    auto [sock, srv] = MakePair();
+    auto n = size_t(state.range(0));
+    std::vector<char> buf(n, 'x');
+
+    auto thr = bench::peer<SOCK>::sink(std::move(srv));
+
+    for (auto _ : state) {
+        if (sock.write_n(buf.data(), n) != n) {
+            state.SkipWithError("write failed");
+            break;
+        }
+    }
+
+    sock.shutdown();
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template <typename SOCK, std::tuple<SOCK, SOCK> (*MakePair)()>
+static void BM_stream_latency(benchmark::State& state) {
+    auto [sock, srv] = MakePair();
+    auto n = size_t(state.range(0));
+    std::vector<char> buf(n, 'x');
+
+    auto thr = bench::peer<SOCK>::echo(std::move(srv), n);
+
+    for (auto _ : state) {
+        if (sock.write_n(buf.data(), n) != n || sock.read_n(buf.data(), n) != n) {
+            state.SkipWithError("round trip failed");
+            break;
+        }
+    }
+
+    sock.shutdown();
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+
+// --------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE(BM_stream_throughput, tcp_socket, bench::tcp_pair)
+    ->RangeMultiplier(4)
+    ->Range(64, 64 * 1024);
+
+BENCHMARK_TEMPLATE(BM_stream_latency, tcp_socket, bench::tcp_pair)
+    ->Arg(1)
+    ->Arg(64)
+    ->Arg(1024);
+
+#if !defined(_WIN32)
+BENCHMARK_TEMPLATE(BM_stream_throughput, unix_stream_socket, bench::unix_pair)
+    ->RangeMultiplier(4)
+    ->Range(64, 64 * 1024);
+
+BENCHMARK_TEMPLATE(BM_stream_latency, unix_stream_socket, bench::unix_pair)
+    ->Arg(1)
+    ->Arg(64)
+    ->Arg(1024);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+// bench_timer_wheel.cpp
+//
+// Benchmarks for the timer wheel.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// These model the idle timeouts of a server with many keepalive
+// connections: each read re-arms one connection's timer, and the loop
+// advances the wheel once per pass.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "sockpp/timer_wheel.h"
+
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+
+static void BM_timer_wheel_rearm(benchmark::State& state) {
+    auto n = size_t(state.range(0));
+    timer_wheel wheel;
+    std::vector<timer_wheel::timer> timers(n);
+
+    for (auto& tmr : timers) wheel.schedule(tmr, std::chrono::seconds{60});
+
+    size_t i = 0;
+    for (auto _ : state) {
+        wheel.schedule(timers[i], std::chrono::seconds{60});
+        if (++i == n)
+            i = 0;
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_timer_wheel_rearm)->Arg(1000)->Arg(100000);
+
+static void BM_timer_wheel_schedule_cancel(benchmark::State& state) {
+    timer_wheel wheel;
+    timer_wheel::timer tmr;
+
+    for (auto _ : state) {
+        wheel.schedule(tmr, std::chrono::milliseconds{5000});
+        wheel.cancel(tmr);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_timer_wheel_schedule_cancel);
+
+static void BM_timer_wheel_fire(benchmark::State& state) {
+    auto n = size_t(state.range(0));
+    timer_wheel wheel;
+    std::vector<timer_wheel::timer> timers(n);
+    auto t = wheel.now();
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i)
+            wheel.schedule(timers[i], std::chrono::milliseconds{1 + i % 10000});
+        t += std::chrono::seconds{11};
+        benchmark::DoNotOptimize(wheel.advance(t));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+BENCHMARK(BM_timer_wheel_fire)->Arg(100000);
+
+BENCHMARK_MAIN();
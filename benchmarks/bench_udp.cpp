@@ -0,0 +1,116 @@
+// bench_udp.cpp
+//
+// Packet-rate benchmarks for UDP sockets.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+// Datagrams are sent between a pair of connected UDP sockets on the
+// loopback interface. Loopback delivery is synchronous, so a datagram is
+// always waiting by the time the receive is made, and one thread can
+// measure the send and receive cost of each packet.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "bench_util.h"
+#include "sockpp/udp_socket.h"
+
+using namespace sockpp;
+
+namespace {
+
+// A pair of UDP sockets, bound to ephemeral loopback ports and connected
+// to each other.
+struct udp_pair
+{
+    udp_socket a, b;
+
+    udp_pair() {
+        a.bind(bench::loopback()).value_or_throw();
+        b.bind(bench::loopback()).value_or_throw();
+        a.connect(b.address()).value_or_throw();
+        b.connect(a.address()).value_or_throw();
+    }
+};
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+static void BM_udp_send_recv(benchmark::State& state) {
+    udp_pair pr;
+    auto n = size_t(state.range(0));
+    std::vector<char> buf(n, 'x');
+
+    for (auto _ : state) {
+        if (pr.a.send(buf.data(), n) != n || pr.b.recv(buf.data(), n) != n) {
+            state.SkipWithError("datagram lost");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+BENCHMARK(BM_udp_send_recv)->Arg(16)->Arg(512)->Arg(1400);
+
+// --------------------------------------------------------------------------
+
+// Unconnected sockets, with the address given on each send.
+
+static void BM_udp_send_to(benchmark::State& state) {
+    udp_socket sock, rcv;
+    sock.bind(bench::loopback()).value_or_throw();
+    rcv.bind(bench::loopback()).value_or_throw();
+
+    auto n = size_t(state.range(0));
+    auto addr = rcv.address();
+    std::vector<char> buf(n, 'x');
+
+    for (auto _ : state) {
+        if (sock.send_to(buf.data(), n, addr) != n || rcv.recv(buf.data(), n) != n) {
+            state.SkipWithError("datagram lost");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+BENCHMARK(BM_udp_send_to)->Arg(16)->Arg(512)->Arg(1400);
+
+BENCHMARK_MAIN();
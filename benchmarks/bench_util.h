@@ -0,0 +1,133 @@
+// bench_util.h
+//
+// Common helpers for the sockpp benchmarks.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#ifndef __sockpp_bench_util_h
+#define __sockpp_bench_util_h
+
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+#if !defined(_WIN32)
+    #include "sockpp/unix_stream_socket.h"
+#endif
+
+namespace bench {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/** The address for all the loopback benchmarks. The port is ephemeral. */
+inline sockpp::inet_address loopback() { return sockpp::inet_address{"127.0.0.1", 0}; }
+
+/**
+ * Creates a connected pair of TCP sockets over the loopback interface.
+ * @return The client and server sides of the connection.
+ */
+inline std::tuple<sockpp::tcp_socket, sockpp::tcp_socket> tcp_pair() {
+    sockpp::tcp_acceptor acc{loopback()};
+    sockpp::tcp_connector conn{acc.address()};
+    auto srv = acc.accept().release_or_throw();
+
+    conn.nodelay(true);
+    srv.nodelay(true);
+    return {sockpp::tcp_socket{conn.release()}, std::move(srv)};
+}
+
+#if !defined(_WIN32)
+/**
+ * Creates a connected pair of UNIX-domain stream sockets.
+ * @return The two sides of the connection.
+ */
+inline std::tuple<sockpp::unix_stream_socket, sockpp::unix_stream_socket> unix_pair() {
+    return sockpp::unix_stream_socket::pair().release_or_throw();
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A thread that services the far side of a stream benchmark.
+ *
+ * In sink mode, it reads and discards everything until the connection
+ * closes. In echo mode, it reads blocks of a fixed size and writes each
+ * one back. The thread is joined when the object is destroyed, which
+ * should be after the near side of the connection is shut down.
+ */
+template <typename SOCK>
+class peer
+{
+    std::thread thr_;
+
+public:
+    /** Starts a thread that reads and discards all incoming data */
+    static peer sink(SOCK sock) {
+        return peer{std::thread{[sock = std::move(sock)]() mutable {
+            std::vector<char> buf(64 * 1024);
+            while (true) {
+                auto res = sock.read(buf.data(), buf.size());
+                if (!res || res.value() == 0)
+                    break;
+            }
+        }}};
+    }
+
+    /** Starts a thread that echoes back each block of @a n bytes */
+    static peer echo(SOCK sock, size_t n) {
+        return peer{std::thread{[sock = std::move(sock), n]() mutable {
+            std::vector<char> buf(n);
+            while (sock.read_n(buf.data(), n) == n && sock.write_n(buf.data(), n) == n);
+        }}};
+    }
+
+    explicit peer(std::thread&& thr) : thr_{std::move(thr)} {}
+    peer(peer&&) = default;
+    ~peer() {
+        if (thr_.joinable())
+            thr_.join();
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace bench
+
+#endif  // __sockpp_bench_util_h
@@ -4,10 +4,14 @@
 #
 #   Sockpp::sockpp
 #   Sockpp::sockpp-static
+#   Sockpp::sockpp-coro
 #
 
 include(CMakeFindDependencyMacro)
 
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_dependency(Threads)
+
 if(NOT TARGET Sockpp::sockpp AND NOT TARGET Sockpp::sockpp-static)
 	include("${CMAKE_CURRENT_LIST_DIR}/sockppTargets.cmake")
 endif()
@@ -0,0 +1,117 @@
+// canbcm.cpp
+//
+// Simple Linux SocketCAN example using the broadcast manager (BCM).
+//
+// The kernel sends a heartbeat frame once a second, and reports only the
+// frames for an ID whose contents have changed.
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "sockpp/can_bcm_socket.h"
+#include "sockpp/version.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    cout << "Sample SocketCAN broadcast manager for 'sockpp' " << sockpp::SOCKPP_VERSION
+         << endl;
+
+    string canIface = (argc > 1) ? argv[1] : "can0";
+    canid_t txID = (argc > 2) ? atoi(argv[2]) : 0x20;
+    canid_t rxID = (argc > 3) ? atoi(argv[3]) : 0x21;
+
+    sockpp::initialize();
+
+    error_code ec;
+    sockpp::can_bcm_socket sock;
+
+    if (auto addrRes = sockpp::can_address::create(canIface); !addrRes)
+        ec = addrRes.error();
+    else
+        sock = sockpp::can_bcm_socket(addrRes.value(), ec);
+
+    if (ec) {
+        cerr << "Error opening a BCM socket on the CAN interface '" << canIface << "'\n\t"
+             << ec.message() << endl;
+        return 1;
+    }
+
+    // The kernel keeps sending the heartbeat, even if we're busy.
+    sockpp::can_frame heartbeat{txID, "alive"};
+    if (auto res = sock.tx_setup(heartbeat, seconds{1}); !res) {
+        cerr << "Error setting up the heartbeat: " << res.error_message() << endl;
+        return 1;
+    }
+
+    // Only wake up when the contents change, or if the frame goes missing
+    // for more than 3 sec.
+    if (auto res = sock.rx_filter_id(rxID, seconds{3}); !res) {
+        cerr << "Error setting up the receive filter: " << res.error_message() << endl;
+        return 1;
+    }
+
+    cout << "Sending ID 0x" << hex << txID << ", watching ID 0x" << rxID << endl;
+    cout << uppercase << setfill('0');
+
+    while (true) {
+        bcm_msg_head head;
+        sockpp::can_frame frame;
+
+        auto res = sock.recv(head, &frame, 1);
+        if (!res) {
+            cerr << "Error reading from the BCM socket: " << res.error_message() << endl;
+            break;
+        }
+
+        if (head.opcode == RX_TIMEOUT) {
+            cout << "Timeout" << endl;
+            continue;
+        }
+
+        for (uint8_t i = 0; i < frame.can_dlc; ++i)
+            cout << hex << setw(2) << unsigned(frame.data[i]) << " ";
+        cout << endl;
+    }
+
+    return 1;
+}
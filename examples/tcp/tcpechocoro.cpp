@@ -0,0 +1,141 @@
+// tcpechocoro.cpp
+//
+// A TCP echo server for sockpp library using C++20 coroutines.
+// Each connection is handled by a coroutine written as straight-line
+// code, like the thread function in tcpechosvr, but all the coroutines
+// are run by a reactor event loop on each of a small number of threads.
+// Each thread has its own listener on the same port, with SO_REUSEPORT,
+// and the kernel spreads the incoming connections across them.
+//
+// USAGE:
+//  	tcpechocoro [port] [nthreads]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "sockpp/coro.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/version.h"
+
+using namespace std;
+using sockpp::async_socket;
+using sockpp::task;
+
+// --------------------------------------------------------------------------
+// The coroutine for a single connection. Ownership of the socket is
+// transferred to the coroutine, so when it completes, the socket is
+// removed from the reactor and closed.
+
+task<> run_echo(sockpp::reactor& rctr, sockpp::tcp_socket sock) {
+    async_socket<sockpp::tcp_socket> s{rctr, std::move(sock)};
+
+    char buf[512];
+    sockpp::result<size_t> res;
+
+    while ((res = co_await s.read(buf, sizeof(buf))) && res.value() > 0) {
+        if (!co_await s.write_n(buf, res.value()))
+            break;
+    }
+}
+
+// --------------------------------------------------------------------------
+// The acceptor coroutine. Each new connection gets its own coroutine on
+// the same reactor.
+
+task<> run_acceptor(sockpp::reactor& rctr, sockpp::tcp_acceptor acc) {
+    async_socket<sockpp::tcp_acceptor> a{rctr, std::move(acc)};
+
+    while (true) {
+        auto res = co_await a.accept();
+        if (!res) {
+            cerr << "Error accepting incoming connection: " << res.error_message() << endl;
+            continue;
+        }
+        sockpp::spawn(run_echo(rctr, res.release()));
+    }
+}
+
+// --------------------------------------------------------------------------
+// Each thread runs its own reactor with its own listener.
+
+void run_loop(sockpp::tcp_acceptor acc) {
+    sockpp::reactor rctr;
+    sockpp::spawn(run_acceptor(rctr, std::move(acc)));
+
+    if (auto res = rctr.run(); !res)
+        cerr << "Reactor error: " << res.error_message() << endl;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    cout << "Sample TCP coroutine echo server for 'sockpp' " << sockpp::SOCKPP_VERSION << '\n'
+         << endl;
+
+    in_port_t port = (argc > 1) ? atoi(argv[1]) : sockpp::TEST_PORT;
+    unsigned nthr = (argc > 2) ? unsigned(atoi(argv[2])) : 1;
+
+    sockpp::initialize();
+
+#if defined(SO_REUSEPORT)
+    const int REUSE = SO_REUSEPORT;
+#else
+    const int REUSE = 0;
+    nthr = 1;
+#endif
+
+    // A deep listen queue, for lots of clients connecting at once
+    const int QUE_SIZE = 1024;
+
+    vector<thread> threads;
+
+    for (unsigned i = 0; i < nthr; ++i) {
+        sockpp::tcp_acceptor acc;
+        if (auto res = acc.open(port, QUE_SIZE, REUSE); !res) {
+            cerr << "Error creating the acceptor: " << res.error_message() << endl;
+            return 1;
+        }
+        threads.emplace_back(run_loop, std::move(acc));
+    }
+
+    cout << "Awaiting connections on port " << port << " with " << nthr << " thread(s)..."
+         << endl;
+
+    for (auto& thr : threads) thr.join();
+    return 0;
+}
@@ -0,0 +1,108 @@
+// tcpechogroup.cpp
+//
+// A multi-threaded TCP echo server using a group of SO_REUSEPORT
+// acceptors, with one listener and one thread per CPU.
+//
+// USAGE:
+//  	tcpechogroup [port]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "sockpp/acceptor_group.h"
+#include "sockpp/version.h"
+
+using namespace std;
+
+// --------------------------------------------------------------------------
+// Each worker accepts from its own listener and services one connection
+// at a time. A real server would multiplex the connections for each worker
+// with a reactor.
+
+void run_worker(size_t id, sockpp::tcp_acceptor& acc) {
+    while (true) {
+        sockpp::inet_address peer;
+        auto res = acc.accept(&peer);
+        if (!res) {
+            cerr << "[" << id << "] Error accepting connection: " << res.error_message()
+                 << endl;
+            continue;
+        }
+
+        cout << "[" << id << "] Received a connection request from " << peer << endl;
+        auto sock = res.release();
+
+        char buf[512];
+        sockpp::result<size_t> rres;
+
+        while ((rres = sock.read(buf, sizeof(buf))) && rres.value() > 0)
+            sock.write_n(buf, rres.value());
+
+        cout << "[" << id << "] Connection closed from " << peer << endl;
+    }
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    cout << "Sample TCP acceptor group echo server for 'sockpp' " << sockpp::SOCKPP_VERSION
+         << '\n' << endl;
+
+    in_port_t port = (argc > 1) ? atoi(argv[1]) : sockpp::TEST_PORT;
+
+    sockpp::initialize();
+
+    auto n = sockpp::tcp_acceptor_group::default_size();
+
+    // Steer connections by CPU where the OS supports it.
+    error_code ec;
+    sockpp::tcp_acceptor_group grp{sockpp::inet_address{port}, n, 64, true, ec};
+
+    if (ec) {
+        cerr << "Error creating the acceptor group: " << ec.message() << endl;
+        return 1;
+    }
+    cout << "Awaiting connections on port " << port << " with " << n << " listeners..."
+         << endl;
+
+    vector<thread> thrs;
+    for (size_t i = 0; i < n; ++i) thrs.emplace_back(run_worker, i, std::ref(grp[i]));
+
+    for (auto& thr : thrs) thr.join();
+    return 0;
+}
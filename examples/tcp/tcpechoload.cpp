@@ -0,0 +1,425 @@
+// tcpechoload.cpp
+//
+// Load generator and latency histogram for sockpp echo servers.
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+// This drives a number of connections against any of the echo servers,
+// keeping several requests in flight on each one, then reports the
+// throughput and the distribution of round-trip latencies.
+//
+// By default it runs a closed loop: each connection sends a new request as
+// soon as a response comes back. With a target rate (-r), it runs an open
+// loop, where requests are scheduled at fixed intervals whether or not
+// the server is keeping up. In that mode, latency is measured from the
+// time a request was *scheduled* to be sent, not when it was actually
+// sent, so a stalled server shows up in the results rather than quietly
+// slowing down the client (the "coordinated omission" problem).
+//
+// The same tool can be pointed at the thread-per-connection servers
+// (tcpechosvr, unechosvr), or the event-driven ones (tcpechoreactor,
+// tcpechopool), to compare them under identical load.
+//
+// USAGE:
+//  	tcpechoload [options] [host] [port]
+//
+//  	-c <n>      Number of connections (default 8)
+//  	-d <n>      Requests in flight on each connection (default 1)
+//  	-s <n>      Size of each request, in bytes (default 64)
+//  	-t <sec>    Duration of the test, in seconds (default 10)
+//  	-r <n>      Target request rate, in total requests/sec, for an
+//  	            open-loop test. Zero (the default) runs a closed loop.
+//  	-u <path>   Connect to a UNIX-domain server at the path, rather
+//  	            than TCP.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sockpp/tcp_connector.h"
+#include "sockpp/version.h"
+
+#if !defined(_WIN32)
+    #include "sockpp/unix_connector.h"
+#endif
+
+using namespace std;
+using namespace std::chrono;
+
+using fpsec = duration<double>;
+
+// --------------------------------------------------------------------------
+// A histogram of latencies in the spirit of HdrHistogram.
+//
+// Values are kept in buckets that are linear within each power of two,
+// with SUB_BITS bits of resolution, so any recorded value is within
+// 1/64 (about 1.5%) of its true value, over the full range, using a
+// small, fixed amount of memory.
+
+class latency_histogram
+{
+    static constexpr int SUB_BITS = 7;
+    static constexpr uint64_t SUB_COUNT = 1 << SUB_BITS, HALF_COUNT = SUB_COUNT / 2;
+    static constexpr int MAX_BITS = 40;  // ~18min in nanoseconds
+
+    vector<uint64_t> counts_;
+    uint64_t total_{0}, max_{0};
+    double sum_{0.0};
+
+    static size_t index(uint64_t v) {
+        if (v < SUB_COUNT)
+            return size_t(v);
+        int msb = 63;
+        while (!(v & (uint64_t(1) << msb))) --msb;
+        int shift = msb - (SUB_BITS - 1);
+        return size_t(SUB_COUNT + (shift - 1) * HALF_COUNT + ((v >> shift) - HALF_COUNT));
+    }
+
+    // The highest value that maps to the bucket.
+    static uint64_t value_at(size_t idx) {
+        if (idx < SUB_COUNT)
+            return idx;
+        int shift = int((idx - SUB_COUNT) / HALF_COUNT) + 1;
+        uint64_t sub = (idx - SUB_COUNT) % HALF_COUNT + HALF_COUNT;
+        return ((sub + 1) << shift) - 1;
+    }
+
+public:
+    latency_histogram() : counts_(index((uint64_t(1) << MAX_BITS) - 1) + 1) {}
+
+    void record(nanoseconds d) {
+        auto v = uint64_t(std::max<int64_t>(d.count(), 0));
+        v = std::min(v, (uint64_t(1) << MAX_BITS) - 1);
+        ++counts_[index(v)];
+        ++total_;
+        max_ = std::max(max_, v);
+        sum_ += double(v);
+    }
+
+    void merge(const latency_histogram& other) {
+        for (size_t i = 0; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+        sum_ += other.sum_;
+    }
+
+    uint64_t count() const { return total_; }
+    nanoseconds max() const { return nanoseconds(max_); }
+    nanoseconds mean() const {
+        return nanoseconds(total_ ? int64_t(sum_ / double(total_)) : 0);
+    }
+
+    // Gets the value at the given percentile (0-100)
+    nanoseconds percentile(double pct) const {
+        if (total_ == 0)
+            return nanoseconds(0);
+        auto target = uint64_t(std::ceil(double(total_) * pct / 100.0));
+        target = std::max<uint64_t>(target, 1);
+        uint64_t n = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            if ((n += counts_[i]) >= target)
+                return nanoseconds(std::min(value_at(i), max_));
+        }
+        return nanoseconds(max_);
+    }
+};
+
+// --------------------------------------------------------------------------
+
+struct options
+{
+    string host{"localhost"};
+    in_port_t port{sockpp::TEST_PORT};
+    string unixPath;
+    size_t nconn{8};
+    size_t depth{1};
+    size_t size{64};
+    seconds dur{10};
+    double rate{0.0};
+};
+
+// --------------------------------------------------------------------------
+// The state of a single connection.
+//
+// A writer thread sends requests and a reader thread takes the responses,
+// each on its own handle to the socket. The echo server returns the
+// responses in order, so the send times are kept in a ring with one slot
+// for each request in flight.
+
+class connection
+{
+    sockpp::stream_socket sock_;
+    size_t depth_, size_;
+
+    vector<steady_clock::time_point> sendTimes_;
+    atomic<uint64_t> nsent_{0}, nrecv_{0};
+    latency_histogram hist_;
+    bool err_{false};
+
+public:
+    connection(sockpp::stream_socket&& sock, size_t depth, size_t sz)
+        : sock_{std::move(sock)}, depth_{depth}, size_{sz}, sendTimes_(depth) {}
+
+    // Sends the requests until the deadline. An interval of zero is a
+    // closed loop, sending each request as soon as there's room for it.
+    void write_loop(
+        sockpp::stream_socket sock, steady_clock::time_point start,
+        steady_clock::time_point deadline, nanoseconds interval
+    ) {
+        string req(size_, 'x');
+        auto next = start;
+
+        while (true) {
+            auto now = steady_clock::now();
+            if (interval.count() > 0) {
+                if (next > now) {
+                    this_thread::sleep_for(next - now);
+                    now = steady_clock::now();
+                }
+            }
+            else {
+                next = now;
+            }
+
+            if (now >= deadline)
+                break;
+
+            // Wait for room in the pipeline. In open-loop mode, the time
+            // spent waiting counts against the request.
+            uint64_t n = nsent_.load(memory_order_relaxed);
+            while (n - nrecv_.load(memory_order_acquire) >= depth_) this_thread::yield();
+
+            sendTimes_[n % depth_] = next;
+            nsent_.store(n + 1, memory_order_release);
+
+            if (sock.write_n(req.data(), size_) != size_) {
+                err_ = true;
+                break;
+            }
+            next += interval;
+        }
+
+        sock.shutdown(SHUT_WR);
+    }
+
+    // Reads the responses until the server closes the connection.
+    void read_loop() {
+        string resp(size_, '\0');
+
+        while (sock_.read_n(&resp[0], size_) == size_) {
+            auto now = steady_clock::now();
+            uint64_t n = nrecv_.load(memory_order_relaxed);
+
+            // Syncs with the writer's update of the send time
+            nsent_.load(memory_order_acquire);
+            hist_.record(now - sendTimes_[n % depth_]);
+            nrecv_.store(n + 1, memory_order_release);
+        }
+    }
+
+    void run(
+        steady_clock::time_point start, steady_clock::time_point deadline,
+        nanoseconds interval
+    ) {
+        thread wrThr{&connection::write_loop, this, sock_.clone(), start, deadline, interval};
+        read_loop();
+        wrThr.join();
+    }
+
+    const latency_histogram& histogram() const { return hist_; }
+    bool error() const { return err_ || nsent_ != nrecv_; }
+};
+
+// --------------------------------------------------------------------------
+
+sockpp::result<sockpp::stream_socket> connect(const options& opts) {
+#if !defined(_WIN32)
+    if (!opts.unixPath.empty()) {
+        sockpp::unix_connector conn;
+        if (auto res = conn.connect(sockpp::unix_address{opts.unixPath}); !res)
+            return res.error();
+        return sockpp::stream_socket{conn.release()};
+    }
+#endif
+    sockpp::tcp_connector conn;
+    if (auto res = conn.connect(sockpp::inet_address{opts.host, opts.port}); !res)
+        return res.error();
+    conn.nodelay(true);
+    return sockpp::stream_socket{conn.release()};
+}
+
+// --------------------------------------------------------------------------
+
+bool parse_args(int argc, char* argv[], options& opts) {
+    int npos = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg{argv[i]};
+
+        if (arg.size() == 2 && arg[0] == '-') {
+            if (++i >= argc)
+                return false;
+            string val{argv[i]};
+
+            switch (arg[1]) {
+                case 'c':
+                    opts.nconn = std::max<size_t>(size_t(stoul(val)), 1);
+                    break;
+                case 'd':
+                    opts.depth = std::max<size_t>(size_t(stoul(val)), 1);
+                    break;
+                case 's':
+                    opts.size = std::max<size_t>(size_t(stoul(val)), 1);
+                    break;
+                case 't':
+                    opts.dur = seconds(stol(val));
+                    break;
+                case 'r':
+                    opts.rate = stod(val);
+                    break;
+                case 'u':
+                    opts.unixPath = val;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        else if (npos == 0) {
+            opts.host = arg;
+            ++npos;
+        }
+        else if (npos == 1) {
+            opts.port = in_port_t(stoi(arg));
+            ++npos;
+        }
+        else
+            return false;
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    cout << "Echo server load generator for 'sockpp' " << sockpp::SOCKPP_VERSION << '\n'
+         << endl;
+
+    options opts;
+    try {
+        if (!parse_args(argc, argv, opts)) {
+            cerr << "USAGE: tcpechoload [-c conns] [-d depth] [-s size] [-t secs]"
+                 << " [-r rate] [-u path] [host] [port]" << endl;
+            return 2;
+        }
+    }
+    catch (const exception&) {
+        cerr << "Invalid numeric argument" << endl;
+        return 2;
+    }
+
+    sockpp::initialize();
+
+    vector<unique_ptr<connection>> conns;
+    for (size_t i = 0; i < opts.nconn; ++i) {
+        auto res = connect(opts);
+        if (!res) {
+            cerr << "Error connecting to the server: " << res.error_message() << endl;
+            return 1;
+        }
+        conns.push_back(make_unique<connection>(res.release(), opts.depth, opts.size));
+    }
+
+    // Each connection sends at an equal share of the total rate.
+    nanoseconds interval{0};
+    if (opts.rate > 0.0)
+        interval = nanoseconds(int64_t(1.0e9 * double(opts.nconn) / opts.rate));
+
+    cout << "Running " << (interval.count() ? "open" : "closed") << " loop for "
+         << opts.dur.count() << "s with " << opts.nconn << " connections, " << opts.depth
+         << " in flight, " << opts.size << "-byte requests";
+    if (interval.count())
+        cout << ", at " << opts.rate << " req/s";
+    cout << "..." << endl;
+
+    auto start = steady_clock::now();
+    auto deadline = start + opts.dur;
+
+    // Stagger the open-loop schedules, so the connections don't all
+    // send at the same instant.
+    vector<thread> thrs;
+    for (size_t i = 0; i < conns.size(); ++i) {
+        auto offset = interval * int64_t(i) / int64_t(conns.size());
+        thrs.emplace_back(
+            &connection::run, conns[i].get(), start + offset, deadline, interval
+        );
+    }
+    for (auto& thr : thrs) thr.join();
+
+    auto elapsed = fpsec(steady_clock::now() - start).count();
+
+    latency_histogram hist;
+    size_t nerr = 0;
+    for (const auto& conn : conns) {
+        hist.merge(conn->histogram());
+        if (conn->error())
+            ++nerr;
+    }
+
+    auto us = [](nanoseconds d) { return double(d.count()) / 1000.0; };
+
+    cout << "\nRequests:   " << hist.count() << "\n"
+         << "Throughput: " << uint64_t(double(hist.count()) / elapsed) << " req/s\n"
+         << fixed << setprecision(1) << "Latency (us):\n"
+         << "    mean  " << us(hist.mean()) << "\n"
+         << "    p50   " << us(hist.percentile(50.0)) << "\n"
+         << "    p90   " << us(hist.percentile(90.0)) << "\n"
+         << "    p99   " << us(hist.percentile(99.0)) << "\n"
+         << "    p99.9 " << us(hist.percentile(99.9)) << "\n"
+         << "    max   " << us(hist.max()) << endl;
+
+    if (nerr)
+        cerr << "\n" << nerr << " connection(s) had errors" << endl;
+
+    return nerr ? 1 : 0;
+}
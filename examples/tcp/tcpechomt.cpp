@@ -40,6 +40,7 @@
 #include <string>
 #include <thread>
 
+#include "sockpp/shared_socket.h"
 #include "sockpp/tcp_connector.h"
 #include "sockpp/version.h"
 
@@ -50,7 +51,7 @@ using namespace std;
 // server and writing them to the console. When the main (write) thread
 // shuts down the socket, we exit.
 
-void read_thr(sockpp::tcp_socket rdSock) {
+void read_thr(sockpp::read_half<sockpp::tcp_connector> rdSock) {
     char buf[512];
 
     while (true) {
@@ -93,16 +94,18 @@ int main(int argc, char* argv[]) {
 
     cout << "Created a connection from " << conn.address() << endl;
 
-    // We create a read thread and send it a clone (dup) of the
-    // connector socket.
+    // Split the connection into read and write halves, and give the read
+    // half to a separate thread. Both share the one socket, which is
+    // closed when the two halves are gone.
 
-    std::thread rdThr(read_thr, std::move(conn.clone()));
+    auto [rdSock, wrSock] = sockpp::split(std::move(conn));
+    std::thread rdThr(read_thr, std::move(rdSock));
 
     // The write loop get user input and writes it to the socket.
 
     string s, sret;
     while (getline(cin, s) && !s.empty()) {
-        if (auto res = conn.write(s); !res || res != s.length()) {
+        if (auto res = wrSock.write(s); !res || res != s.length()) {
             if (res == errc::broken_pipe) {
                 cerr << "It appears that the socket was closed." << endl;
             }
@@ -112,12 +115,12 @@ int main(int argc, char* argv[]) {
             break;
         }
     }
-    int ret = !conn ? 1 : 0;
+    int ret = !wrSock ? 1 : 0;
 
     // Shutting down the socket will cause the read thread to exit.
     // We wait for it to exit before we leave the app.
 
-    conn.shutdown(SHUT_WR);
+    wrSock.shutdown();
     rdThr.join();
 
     return ret;
@@ -0,0 +1,182 @@
+// tcpechopool.cpp
+//
+// A multi-threaded TCP echo server for sockpp library, using a pool of
+// event loops.
+//
+// The main thread accepts connections and hands each one to the loop with
+// the fewest connections. From then on, the connection is serviced by
+// that loop's reactor, so a handful of threads can service a large number
+// of clients, with no locks and no duplicated sockets.
+//
+// USAGE:
+//  	tcpechopool [port] [nthreads]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "sockpp/io_context.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/version.h"
+
+using namespace std;
+
+// --------------------------------------------------------------------------
+// The state for a single client connection. Any data that could not be
+// echoed back immediately is kept until the socket becomes writable.
+
+struct connection
+{
+    sockpp::tcp_socket sock;
+    vector<char> pending;
+
+    explicit connection(sockpp::tcp_socket&& s) : sock{std::move(s)} {}
+};
+
+// Each loop thread has its own table of connections, so it's never shared.
+static thread_local map<sockpp::socket_t, unique_ptr<connection>> conns;
+
+// --------------------------------------------------------------------------
+
+void close_conn(sockpp::reactor& rx, connection& conn) {
+    auto h = conn.sock.handle();
+    rx.remove(h);
+    conns.erase(h);
+}
+
+// --------------------------------------------------------------------------
+
+void on_client(sockpp::reactor& rx, connection& conn, uint32_t events) {
+    if (events & sockpp::poller::READABLE) {
+        char buf[4096];
+        while (true) {
+            auto res = conn.sock.read(buf, sizeof(buf));
+            if (!res) {
+                if (res == errc::operation_would_block)
+                    break;
+                if (res == errc::interrupted)
+                    continue;
+                close_conn(rx, conn);
+                return;
+            }
+            if (res.value() == 0) {
+                close_conn(rx, conn);
+                return;
+            }
+            conn.pending.insert(conn.pending.end(), buf, buf + res.value());
+        }
+    }
+
+    while (!conn.pending.empty()) {
+        auto res = conn.sock.write(conn.pending.data(), conn.pending.size());
+        if (!res) {
+            if (res == errc::operation_would_block || res == errc::interrupted)
+                break;
+            close_conn(rx, conn);
+            return;
+        }
+        conn.pending.erase(conn.pending.begin(), conn.pending.begin() + res.value());
+    }
+
+    auto events_wanted = sockpp::poller::READABLE;
+    if (!conn.pending.empty())
+        events_wanted |= sockpp::poller::WRITABLE;
+    rx.modify(conn.sock, events_wanted);
+}
+
+// --------------------------------------------------------------------------
+// Runs on the loop's thread, which takes ownership of the connection.
+
+void add_conn(sockpp::reactor& rx, sockpp::tcp_socket sock) {
+    auto conn = make_unique<connection>(std::move(sock));
+    auto pconn = conn.get();
+    auto h = conn->sock.handle();
+    conns[h] = std::move(conn);
+
+    rx.add(h, sockpp::poller::READABLE, [&rx, pconn](uint32_t events) {
+        on_client(rx, *pconn, events);
+    });
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    cout << "Sample TCP event loop pool echo server for 'sockpp' " << sockpp::SOCKPP_VERSION
+         << '\n'
+         << endl;
+
+    in_port_t port = (argc > 1) ? atoi(argv[1]) : sockpp::TEST_PORT;
+    size_t nthr = (argc > 2) ? size_t(atoi(argv[2]))
+                             : sockpp::io_context_pool::default_size();
+
+    sockpp::initialize();
+
+    error_code ec;
+    sockpp::tcp_acceptor acc{port, 1024, ec};
+
+    if (ec) {
+        cerr << "Error creating the acceptor: " << ec.message() << endl;
+        return 1;
+    }
+
+    sockpp::io_context_pool pool{nthr};
+    pool.start();
+
+    cout << "Awaiting connections on port " << port << " with " << pool.size()
+         << " event loops..." << endl;
+
+    while (true) {
+        sockpp::inet_address peer;
+
+        auto res = acc.accept(&peer, sockpp::acceptor::NON_BLOCKING);
+        if (!res) {
+            cerr << "Error accepting incoming connection: " << res.error_message() << endl;
+            continue;
+        }
+
+        cout << "Received a connection request from " << peer << endl;
+
+        // Hand the socket over to the loop that's doing the least
+        auto& ctx = pool.least_loaded();
+        ctx.post([&ctx, sock = res.release()]() mutable {
+            add_conn(ctx.get_reactor(), std::move(sock));
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+// tcpechoreactor.cpp
+//
+// A single-threaded TCP echo server for sockpp library.
+// This uses a reactor to service all of the connections from a single
+// thread, using non-blocking sockets.
+// 
+// USAGE:
+//  	tcpechoreactor [port]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "sockpp/reactor.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/version.h"
+
+using namespace std;
+
+// --------------------------------------------------------------------------
+// The state for a single client connection. Any data that could not be
+// echoed back immediately is kept until the socket becomes writable.
+
+struct connection
+{
+    sockpp::tcp_socket sock;
+    vector<char> pending;
+
+    explicit connection(sockpp::tcp_socket&& s) : sock{std::move(s)} {}
+};
+
+static map<sockpp::socket_t, unique_ptr<connection>> conns;
+
+// Read buffers are only borrowed while a socket has data ready, so idle
+// connections don't each hold one.
+static sockpp::buffer_pool pool;
+
+// --------------------------------------------------------------------------
+
+void close_conn(sockpp::reactor& rx, connection& conn) {
+    auto h = conn.sock.handle();
+    cout << "Connection closed from " << conn.sock.peer_address() << endl;
+    rx.remove(h);
+    conns.erase(h);
+}
+
+// --------------------------------------------------------------------------
+// Writes all the pending data that the socket will take. Returns false on
+// a fatal error.
+
+bool flush(connection& conn) {
+    while (!conn.pending.empty()) {
+        auto res = conn.sock.write(conn.pending.data(), conn.pending.size());
+        if (!res)
+            return res == errc::operation_would_block || res == errc::interrupted;
+        conn.pending.erase(conn.pending.begin(), conn.pending.begin() + res.value());
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------
+
+void on_client(sockpp::reactor& rx, connection& conn, uint32_t events) {
+    if (events & sockpp::poller::READABLE) {
+        while (true) {
+            auto res = conn.sock.read(pool);
+            if (!res) {
+                if (res == errc::operation_would_block)
+                    break;
+                if (res == errc::interrupted)
+                    continue;
+                close_conn(rx, conn);
+                return;
+            }
+            auto buf = res.release();
+            if (buf.empty()) {
+                close_conn(rx, conn);
+                return;
+            }
+            conn.pending.insert(conn.pending.end(), buf.data(), buf.data() + buf.size());
+        }
+    }
+
+    if (!flush(conn)) {
+        close_conn(rx, conn);
+        return;
+    }
+
+    // Only ask for write notifications while there's data waiting to go out.
+    auto events_wanted = sockpp::poller::READABLE;
+    if (!conn.pending.empty())
+        events_wanted |= sockpp::poller::WRITABLE;
+    rx.modify(conn.sock, events_wanted);
+}
+
+// --------------------------------------------------------------------------
+
+void on_accept(sockpp::reactor& rx, sockpp::tcp_acceptor& acc) {
+    // Drain the whole listen queue, getting sockets that are already
+    // non-blocking.
+    vector<pair<sockpp::tcp_socket, sockpp::inet_address>> accepted;
+    auto res = acc.accept_many(accepted, 64, sockpp::acceptor::NON_BLOCKING);
+
+    if (!res) {
+        cerr << "Error accepting incoming connection: " << res.error_message() << endl;
+        return;
+    }
+
+    for (auto& [sock, peer] : accepted) {
+        cout << "Received a connection request from " << peer << endl;
+
+        auto conn = make_unique<connection>(std::move(sock));
+        auto pconn = conn.get();
+        auto h = conn->sock.handle();
+        conns[h] = std::move(conn);
+
+        rx.add(h, sockpp::poller::READABLE, [&rx, pconn](uint32_t events) {
+            on_client(rx, *pconn, events);
+        });
+    }
+}
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    cout << "Sample TCP reactor echo server for 'sockpp' " << sockpp::SOCKPP_VERSION << '\n'
+         << endl;
+
+    in_port_t port = (argc > 1) ? atoi(argv[1]) : sockpp::TEST_PORT;
+
+    sockpp::initialize();
+
+    error_code ec;
+    sockpp::tcp_acceptor acc{port, 64, ec};
+
+    if (ec) {
+        cerr << "Error creating the acceptor: " << ec.message() << endl;
+        return 1;
+    }
+    acc.set_non_blocking();
+
+    sockpp::reactor rx{ec};
+    if (ec) {
+        cerr << "Error creating the reactor: " << ec.message() << endl;
+        return 1;
+    }
+
+    rx.add(acc, sockpp::poller::READABLE, [&](uint32_t) { on_accept(rx, acc); });
+    cout << "Awaiting connections on port " << port << "..." << endl;
+
+    if (auto res = rx.run(); !res) {
+        cerr << "Error running the reactor: " << res.error_message() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+// tcpechouring.cpp
+//
+// A single-threaded TCP echo server for sockpp library.
+// This uses an io_uring with multishot accept and multishot receives into
+// a ring of kernel-selected buffers, so that a busy server can service all
+// of its connections with very few system calls.
+//
+// USAGE:
+//  	tcpechouring [port]
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <map>
+
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/uring.h"
+#include "sockpp/version.h"
+
+using namespace std;
+
+// The operation for each request is kept in the top byte of the user data,
+// the buffer ID (for sends) in the next two, and the socket handle in the
+// bottom four bytes.
+enum : uint64_t { OP_ACCEPT = 1, OP_RECV = 2, OP_SEND = 3 };
+
+static uint64_t tag(uint64_t op, int fd, uint16_t bid = 0) {
+    return (op << 56) | (uint64_t(bid) << 32) | uint32_t(fd);
+}
+
+static uint64_t tag_op(uint64_t ud) { return ud >> 56; }
+static int tag_fd(uint64_t ud) { return int(uint32_t(ud)); }
+static uint16_t tag_bid(uint64_t ud) { return uint16_t(ud >> 32); }
+
+static constexpr uint16_t BUF_GROUP = 1;
+
+// --------------------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    cout << "Sample TCP io_uring echo server for 'sockpp' " << sockpp::SOCKPP_VERSION << '\n'
+         << endl;
+
+    in_port_t port = (argc > 1) ? atoi(argv[1]) : sockpp::TEST_PORT;
+
+    sockpp::initialize();
+
+    error_code ec;
+    sockpp::tcp_acceptor acc{port, 64, ec};
+
+    if (ec) {
+        cerr << "Error creating the acceptor: " << ec.message() << endl;
+        return 1;
+    }
+
+    sockpp::uring ring{sockpp::uring::DFLT_ENTRIES, ec};
+    if (ec) {
+        cerr << "Error creating the io_uring: " << ec.message() << endl;
+        return 1;
+    }
+
+    sockpp::uring_buffer_ring bufs{ring, BUF_GROUP, 256, 4096, ec};
+    if (ec) {
+        cerr << "Error registering the receive buffers: " << ec.message() << endl;
+        return 1;
+    }
+
+    map<int, sockpp::tcp_socket> conns;
+
+    ring.accept_multishot(acc, tag(OP_ACCEPT, acc.handle()));
+    cout << "Awaiting connections on port " << port << "..." << endl;
+
+    sockpp::uring::completion cqes[64];
+
+    while (true) {
+        auto res = ring.wait(cqes, 64);
+        if (!res) {
+            cerr << "Error waiting for completions: " << res.error_message() << endl;
+            return 1;
+        }
+
+        for (size_t i = 0; i < res.value(); ++i) {
+            const auto& cqe = cqes[i];
+            int fd = tag_fd(cqe.user_data);
+
+            switch (tag_op(cqe.user_data)) {
+                case OP_ACCEPT:
+                    if (cqe.res >= 0) {
+                        sockpp::tcp_socket sock{sockpp::socket_t(cqe.res)};
+                        cout << "Received a connection from " << sock.peer_address()
+                             << endl;
+                        ring.recv_select(sock, BUF_GROUP, tag(OP_RECV, cqe.res));
+                        conns.emplace(cqe.res, std::move(sock));
+                    }
+                    if (!cqe.more())
+                        ring.accept_multishot(acc, tag(OP_ACCEPT, acc.handle()));
+                    break;
+
+                case OP_RECV: {
+                    auto it = conns.find(fd);
+                    if (it == conns.end())
+                        break;
+
+                    if (cqe.res <= 0) {
+                        // A lack of buffers just means we're falling behind
+                        if (cqe.res == -ENOBUFS) {
+                            ring.recv_select(it->second, BUF_GROUP, cqe.user_data);
+                            break;
+                        }
+                        cout << "Connection closed from " << it->second.peer_address()
+                             << endl;
+                        conns.erase(it);
+                        break;
+                    }
+
+                    // Echo the data straight from the kernel-selected buffer.
+                    // It is recycled once the send completes.
+                    auto bid = cqe.buffer_id();
+                    ring.send(
+                        it->second, bufs.buffer(bid), size_t(cqe.res), tag(OP_SEND, fd, bid)
+                    );
+                    if (!cqe.more())
+                        ring.recv_select(it->second, BUF_GROUP, cqe.user_data);
+                    break;
+                }
+
+                case OP_SEND:
+                    bufs.recycle(tag_bid(cqe.user_data));
+                    break;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+// tlsechosvr.cpp
+//
+// Simple multi-threaded TLS echo server
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <thread>
+
+#include "sockpp/inet_address.h"
+#include "sockpp/tls_acceptor.h"
+#include "sockpp/version.h"
+
+using namespace std;
+
+// --------------------------------------------------------------------------
+// The thread function, which owns the secure socket.
+
+void run_echo(sockpp::tls_socket sock) {
+    char buf[512];
+    sockpp::result<size_t> res;
+
+    while ((res = sock.read(buf, sizeof(buf))) && res.value() > 0)
+        sock.write_n(buf, res.value());
+
+    cout << "Connection closed from " << sockpp::inet_address{sock.peer_address()} << endl;
+}
+
+// --------------------------------------------------------------------------
+// Usage: tlsechosvr <cert.pem> <key.pem> [port]
+
+int main(int argc, char* argv[]) {
+    cout << "Sample TLS echo server for 'sockpp' " << sockpp::SOCKPP_VERSION << '\n' << endl;
+
+    if (argc < 3) {
+        cerr << "USAGE: tlsechosvr <cert.pem> <key.pem> [port]" << endl;
+        return 2;
+    }
+
+    in_port_t port = (argc > 3) ? atoi(argv[3]) : sockpp::TEST_PORT;
+
+    sockpp::initialize();
+
+    error_code ec;
+    sockpp::tls_context ctx{sockpp::tls_context::SERVER, ec};
+    if (ec) {
+        cerr << "Error creating the TLS context: " << ec.message() << endl;
+        return 1;
+    }
+
+    if (auto res = ctx.cert_file(argv[1]); !res) {
+        cerr << "Error loading the certificate: " << res.error_message() << endl;
+        return 1;
+    }
+    if (auto res = ctx.key_file(argv[2]); !res) {
+        cerr << "Error loading the key: " << res.error_message() << endl;
+        return 1;
+    }
+    ctx.ktls();
+
+    sockpp::tls_acceptor acc{ctx, sockpp::inet_address{port}, 4, ec};
+    if (ec) {
+        cerr << "Error creating the acceptor: " << ec.message() << endl;
+        return 1;
+    }
+    cout << "Awaiting connections on port " << port << "..." << endl;
+
+    while (true) {
+        sockpp::inet_address peer;
+
+        if (auto res = acc.accept(&peer); !res) {
+            cerr << "Error accepting a connection from " << peer << ": "
+                 << res.error_message() << endl;
+        }
+        else {
+            auto sock = res.release();
+            cout << "Secure connection from " << peer << " using " << sock.protocol()
+                 << ", " << sock.cipher() << (sock.session_reused() ? " (resumed)" : "")
+                 << endl;
+
+            thread thr(run_echo, std::move(sock));
+            thr.detach();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+// tlsget.cpp
+//
+// Fetches a page from an HTTPS server, twice, to show session resumption
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+
+#include "sockpp/inet_address.h"
+#include "sockpp/tls_connector.h"
+#include "sockpp/version.h"
+
+using namespace std;
+
+// --------------------------------------------------------------------------
+// Usage: tlsget [host] [port]
+
+int main(int argc, char* argv[]) {
+    cout << "Sample TLS client for 'sockpp' " << sockpp::SOCKPP_VERSION << '\n' << endl;
+
+    string host = (argc > 1) ? argv[1] : "example.com";
+    in_port_t port = (argc > 2) ? atoi(argv[2]) : 443;
+
+    sockpp::initialize();
+
+    auto addrRes = sockpp::inet_address::create(host, port);
+    if (!addrRes) {
+        cerr << "Error resolving " << host << ": " << addrRes.error_message() << endl;
+        return 1;
+    }
+    auto addr = addrRes.value();
+
+    sockpp::tls_context ctx;
+    ctx.ktls();
+
+    const string req = "GET / HTTP/1.1\r\nHost: " + host + "\r\nConnection: close\r\n\r\n";
+
+    // The second connection should resume the session from the first
+    for (int i = 0; i < 2; ++i) {
+        sockpp::tls_connector conn{ctx};
+        if (auto res = conn.connect(addr, host); !res) {
+            cerr << "Error connecting to " << host << ": " << res.error_message() << endl;
+            return 1;
+        }
+
+        cout << "Connected to " << addr << " using " << conn.protocol() << ", "
+             << conn.cipher() << (conn.session_reused() ? " (resumed)" : "")
+             << (conn.ktls_send() ? " [kTLS]" : "") << endl;
+
+        if (auto res = conn.write(req); !res) {
+            cerr << "Error sending the request: " << res.error_message() << endl;
+            return 1;
+        }
+
+        char buf[4096];
+        size_t n = 0;
+        sockpp::result<size_t> res;
+        while ((res = conn.read(buf, sizeof(buf))) && res.value() > 0) n += res.value();
+
+        cout << "Got " << n << " bytes" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+// mcastrecv.cpp
+//
+// Multicast receiver that joins one or more groups on a single socket
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+
+#include "sockpp/udp_socket.h"
+#include "sockpp/version.h"
+
+using namespace std;
+
+// --------------------------------------------------------------------------
+// Usage: mcastrecv [port] [group...]
+
+int main(int argc, char* argv[]) {
+    cout << "Sample UDP multicast receiver for 'sockpp' " << sockpp::SOCKPP_VERSION << '\n'
+         << endl;
+
+    in_port_t port = (argc > 1) ? atoi(argv[1]) : sockpp::TEST_PORT;
+
+    sockpp::initialize();
+
+    sockpp::udp_socket sock;
+
+    // Let other receivers (perhaps one per core) share the port, but only
+    // deliver the groups joined on this socket.
+    sock.reuse_address(true);
+    if (auto res = sock.bind(sockpp::inet_address(port)); !res) {
+        cerr << "Error binding to port " << port << ": " << res.error_message() << endl;
+        return 1;
+    }
+    sock.multicast_all(false);
+
+    for (int i = 2; i < max(argc, 3); ++i) {
+        string grp = (i < argc) ? argv[i] : "239.255.0.1";
+        auto addr = sockpp::inet_address::create(grp, 0);
+        if (!addr) {
+            cerr << "Invalid group '" << grp << "': " << addr.error_message() << endl;
+            return 1;
+        }
+        if (auto res = sock.join_group(addr.value()); !res) {
+            cerr << "Error joining " << grp << ": " << res.error_message() << endl;
+            return 1;
+        }
+        cout << "Joined " << grp << " on port " << port << endl;
+    }
+
+    // Drain the socket a batch at a time
+    constexpr size_t N = 16;
+    char bufs[N][1500];
+    iovec iov[N];
+    size_t lens[N];
+    sockpp::inet_address srcs[N];
+
+    for (size_t i = 0; i < N; ++i) iov[i] = iovec{bufs[i], sizeof(bufs[i])};
+
+    while (true) {
+        auto res = sock.recv_many(iov, lens, N, srcs);
+        if (!res) {
+            cerr << "Error reading from the socket: " << res.error_message() << endl;
+            break;
+        }
+        for (size_t i = 0; i < res.value(); ++i)
+            cout << srcs[i] << ": " << string(bufs[i], lens[i]) << endl;
+    }
+
+    return 1;
+}
@@ -45,7 +45,11 @@
 #ifndef __sockpp_acceptor_h
 #define __sockpp_acceptor_h
 
+#include <utility>
+#include <vector>
+
 #include "sockpp/inet_address.h"
+#include "sockpp/socket_options.h"
 #include "sockpp/stream_socket.h"
 
 namespace sockpp {
@@ -65,10 +69,22 @@ class acceptor : public socket
     /** The base class */
     using base = socket;
 
+    /** The options applied to the listener and accepted sockets */
+    socket_options opts_;
+
     // Non-copyable
     acceptor(const acceptor&) = delete;
     acceptor& operator=(const acceptor&) = delete;
 
+    /**
+     * Accepts a connection into a raw address buffer.
+     * @param p Pointer to the buffer for the peer address, or null.
+     * @param plen Pointer to the size of the buffer, or null.
+     * @param flags Options for the new socket.
+     * @return A socket to the remote client.
+     */
+    result<stream_socket> do_accept(sockaddr* p, socklen_t* plen, int flags) noexcept;
+
 protected:
     /**
      * Creates an underlying acceptor socket.
@@ -76,17 +92,44 @@ protected:
      * classified (derived from) a streaming socket, since it doesn't
      * support read and write to the socket.
      * @param domain The communications domain (address family).
+     * @param type The socket type, which must be connection-oriented.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @param protocol The protocol, or zero for the default one.
      * @return An OS handle to a stream socket on success, or an error code
      *         on failure.
      */
-    static result<socket_t> create_handle(int domain) {
-        return stream_socket::create_handle(domain);
+    static result<socket_t> create_handle(
+        int domain, int type = stream_socket::COMM_TYPE, int flags = 0, int protocol = 0
+    ) {
+        return base::create_handle(domain, type, protocol, flags);
     }
+    /**
+     * Opens the acceptor socket with the specified socket type, binds it
+     * to the address, and starts listening.
+     * This lets derived classes listen for connection-oriented sockets
+     * other than streams, like SOCK_SEQPACKET.
+     * @param addr The address to which this server should be bound.
+     * @param type The socket type, which must be connection-oriented.
+     * @param queSize The listener queue size.
+     * @param reuse A reuse option for the socket, or zero for none.
+     * @param flags Options for the listening socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @param protocol The protocol, or zero for the default one.
+     * @return The error code on failure.
+     */
+    result<> do_open(
+        const sock_address& addr, int type, int queSize, int reuse, int flags = 0,
+        int protocol = 0
+    ) noexcept;
 
 public:
     /** The default listener queue size. */
     static constexpr int DFLT_QUE_SIZE = 4;
 
+    /** The default maximum number of connections for accept_many() */
+    static constexpr size_t DFLT_ACCEPT_BATCH = 64;
+
 #if defined(_WIN32) || defined(__CYGWIN__)
     static constexpr int REUSE = SO_REUSEADDR;
 #else
@@ -132,15 +175,19 @@ public:
      * Creates an acceptor by moving the other acceptor to this one.
      * @param acc Another acceptor
      */
-    acceptor(acceptor&& acc) noexcept : base(std::move(acc)) {}
+    acceptor(acceptor&& acc) noexcept : base(std::move(acc)), opts_{std::move(acc.opts_)} {}
     /**
      * Creates an unbound acceptor socket with an open OS socket handle.
      * An application would need to manually bind and listen to this
      * acceptor to get incoming connections.
      * @param domain The communications domain (address family).
+     * @param flags Options for the socket. This can be any combination of
+     *  			@ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @param protocol The protocol, or zero for the default stream
+     *  			   protocol of the domain.
      * @return An open, but unbound acceptor socket.
      */
-    static result<acceptor> create(int domain) noexcept;
+    static result<acceptor> create(int domain, int flags = 0, int protocol = 0) noexcept;
     /**
      * Move assignment.
      * @param rhs The other socket to move into this one.
@@ -148,8 +195,25 @@ public:
      */
     acceptor& operator=(acceptor&& rhs) {
         base::operator=(std::move(rhs));
+        opts_ = std::move(rhs.opts_);
         return *this;
     }
+    /**
+     * Gets the options that are applied to the sockets of this acceptor.
+     *
+     * These should be set before the acceptor is opened. The ones that
+     * the system passes on to accepted sockets are then set once, on the
+     * listener, and the rest are set on each new connection. A failure
+     * to set an option on an accepted socket doesn't fail the accept, but
+     * is recorded in the option.
+     * @return A reference to the socket options.
+     */
+    socket_options& options() noexcept { return opts_; }
+    /**
+     * Gets the options that are applied to the sockets of this acceptor.
+     * @return A reference to the socket options.
+     */
+    const socket_options& options() const noexcept { return opts_; }
     /**
      * Sets the socket listening on the address to which it is bound.
      * @param queSize The listener queue size.
@@ -166,18 +230,98 @@ public:
      * @param reuse A reuse option for the socket. This can be SO_REUSE_ADDR
      *              or SO_REUSEPORT, and is set before it tries to bind. A
      *              value of zero doesn;t set an option.
+     * @param flags Options for the listening socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     *  			A listener that is serviced by a @ref reactor would
+     *  			normally be opened with both.
+     * @param protocol The protocol, or zero for the default stream
+     *  			   protocol of the address family.
      * @return The error code on failure.
      */
     result<> open(
-        const sock_address& addr, int queSize = DFLT_QUE_SIZE, int reuse = 0
+        const sock_address& addr, int queSize = DFLT_QUE_SIZE, int reuse = 0, int flags = 0,
+        int protocol = 0
     ) noexcept;
+    /**
+     * Enables TCP Fast Open on the listening socket.
+     *
+     * This lets clients that have a Fast Open cookie from an earlier
+     * connection send their first request in the SYN, saving a round trip
+     * on reconnect. It should be set before the acceptor starts listening.
+     * On Linux the value is the maximum number of pending Fast Open
+     * requests; elsewhere any nonzero value just enables it.
+     * @param queSize The maximum number of pending Fast Open connections.
+     *  			  Zero disables Fast Open.
+     * @return The error code on failure.
+     */
+    result<> fastopen(int queSize) noexcept;
+    /**
+     * Holds back new connections until the client sends data.
+     *
+     * The kernel finishes the handshake, but doesn't report the connection
+     * to accept() until its first data arrives, so a server that reads a
+     * request right away isn't woken for connections that are still idle.
+     * On Linux this is `TCP_DEFER_ACCEPT`, and a connection that sends
+     * nothing is accepted anyway once the timeout has passed. On FreeBSD it
+     * is the "dataready" accept filter, which has no timeout. This should
+     * be set after the acceptor starts listening.
+     * @param timeout How long to wait for data. Zero turns it off.
+     * @return The error code on failure, or @ref errc::operation_not_supported
+     *  	   if the platform has no way to defer accepts.
+     */
+    result<> defer_accept(seconds timeout) noexcept;
+    /**
+     * Applies a set of TCP options to the listening socket.
+     *
+     * Most systems pass these options on to the accepted sockets, which
+     * saves setting them on each new connection. Options that aren't
+     * available on the platform are skipped.
+     * @param prof The options to apply.
+     * @return The first error from an option that could not be set. The
+     *         remaining options are still applied.
+     */
+    result<> apply(const tcp_profile& prof) noexcept;
+#if defined(__linux__)
+    /**
+     * Attaches a classic BPF program to the `SO_REUSEPORT` group of this
+     * acceptor that steers each new connection by the CPU that received it.
+     *
+     * A connection arriving on CPU @em c is handed to the listener at
+     * index (c % nGroup) in the group, where the index is the order in
+     * which the listeners were opened. With one listener per CPU, and
+     * each serviced by a thread pinned to that CPU, a connection never
+     * leaves the CPU that took its receive interrupt. The program applies
+     * to the whole group, so it only needs to be attached to one member.
+     * @param nGroup The number of listeners in the group.
+     * @return The error code on failure.
+     */
+    result<> attach_reuseport_cpu_filter(unsigned nGroup) noexcept;
+#endif
     /**
      * Accepts an incoming TCP connection and gets the address of the client.
+     *
+     * Where the system has `accept4()`, the flags are applied atomically
+     * as the socket is created, otherwise with separate calls afterward.
      * @param clientAddr Pointer to the variable that will get the
      *  				 address of a client when it connects.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return A socket to the remote client.
+     */
+    result<stream_socket> accept(sock_address* clientAddr = nullptr, int flags = 0) noexcept;
+    /**
+     * Accepts an incoming TCP connection and gets the address of the client
+     * into a compact IP address.
+     *
+     * This avoids the full-size generic address when the peer is known to
+     * be IPv4 or IPv6. If the peer is of some other family, the address is
+     * left unset.
+     * @param clientAddr Gets the address of the client.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return A socket to the remote client.
      */
-    result<stream_socket> accept(sock_address* clientAddr = nullptr) noexcept;
+    result<stream_socket> accept(inet_any_address& clientAddr, int flags = 0) noexcept;
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -189,6 +333,9 @@ public:
  * which addresses type should be used to receive incoming connections,
  * like:
  *     using tcp_acceptor = acceptor_tmpl<tcp_socket>;
+ *
+ * The listening socket is created with the protocol of the stream socket
+ * type, `STREAM_SOCK::PROTOCOL`.
  */
 template <typename STREAM_SOCK, typename ADDR = typename STREAM_SOCK::addr_t>
 class acceptor_tmpl : public acceptor
@@ -258,13 +405,24 @@ public:
      * @param acc Another acceptor
      */
     acceptor_tmpl(acceptor_tmpl&& acc) noexcept : base(std::move(acc)) {}
+    /**
+     * Creates an acceptor from an existing OS socket handle and claims
+     * ownership of the handle.
+     * This can be a listening socket inherited from another process.
+     * @param handle A socket handle from the operating system.
+     */
+    explicit acceptor_tmpl(socket_t handle) noexcept : base(handle) {}
     /**
      * Creates an unbound acceptor socket with an open OS socket handle.
      * An application would need to manually bind and listen to this
      * acceptor to get incoming connections.
+     * @param flags Options for the socket. This can be any combination of
+     *  			@ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return An open, but unbound acceptor socket.
      */
-    static result<acceptor_tmpl> create() { return base::create(addr_t::ADDRESS_FAMILY); }
+    static result<acceptor_tmpl> create(int flags = 0) {
+        return base::create(addr_t::ADDRESS_FAMILY, flags, STREAM_SOCK::PROTOCOL);
+    }
     /**
      * Move assignment.
      * @param rhs The other socket to move into this one.
@@ -274,6 +432,8 @@ public:
         base::operator=(std::move(rhs));
         return *this;
     }
+    using socket::address;
+
     /**
      * Gets the local address to which we are bound.
      * @return The local address to which we are bound.
@@ -293,10 +453,14 @@ public:
      * @param reuse A reuse option for the socket. This can be SO_REUSE_ADDR
      *              or SO_REUSEPORT, and is set before it tries to bind. A
      *              value of zero doesn;t set an option.
+     * @param flags Options for the listening socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return @em true on success, @em false on error
      */
-    result<> open(const addr_t& addr, int queSize = DFLT_QUE_SIZE, int reuse = 0) noexcept {
-        return base::open(addr, queSize, reuse);
+    result<> open(
+        const addr_t& addr, int queSize = DFLT_QUE_SIZE, int reuse = 0, int flags = 0
+    ) noexcept {
+        return base::open(addr, queSize, reuse, flags, STREAM_SOCK::PROTOCOL);
     }
     /**
      * Opens the acceptor socket, binds the socket to all adapters and starts it
@@ -306,23 +470,88 @@ public:
      * @param reuse A reuse option for the socket. This can be SO_REUSE_ADDR
      *              or SO_REUSEPORT, and is set before it tries to bind. A
      *              value of zero doesn;t set an option.
+     * @param flags Options for the listening socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return @em true on success, @em false on error
      */
-    result<> open(in_port_t port, int queSize = DFLT_QUE_SIZE, int reuse = 0) noexcept {
-        return open(addr_t(port), queSize, reuse);
+    result<> open(
+        in_port_t port, int queSize = DFLT_QUE_SIZE, int reuse = 0, int flags = 0
+    ) noexcept {
+        return open(addr_t(port), queSize, reuse, flags);
     }
     /**
      * Accepts an incoming connection and gets the address of the client.
+     *
+     * When the address is requested, and the socket type caches the peer
+     * address, the new socket also keeps a copy of it, so that its
+     * `peer_address()` doesn't need a system call.
      * @param clientAddr Pointer to the variable that will get the
      *  				 address of a client when it connects.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return A tcp_socket to the remote client.
      */
-    result<stream_sock_t> accept(addr_t* clientAddr = nullptr) {
-        if (auto res = base::accept(clientAddr); res)
+    result<stream_sock_t> accept(addr_t* clientAddr = nullptr, int flags = 0) {
+        auto res = base::accept(clientAddr, flags);
+        if (!res)
+            return res.error();
+        if (clientAddr)
+            return stream_sock_t{res.release(), *clientAddr};
+        return stream_sock_t{res.release()};
+    }
+    /**
+     * Accepts an incoming connection and gets the address of the client
+     * into a compact IP address.
+     * @param clientAddr Gets the address of the client.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return A socket to the remote client.
+     */
+    result<stream_sock_t> accept(inet_any_address& clientAddr, int flags = 0) {
+        if (auto res = base::accept(clientAddr, flags); res)
             return stream_sock_t{res.release()};
         else
             return res.error();
     }
+    /**
+     * Accepts all the connections waiting in the listen queue, up to a
+     * maximum.
+     *
+     * This is meant for a non-blocking acceptor, typically when it's
+     * reported as readable by a poller. It accepts connections until the
+     * queue is empty (the call would block), or the maximum is reached.
+     * Connections that were aborted by the peer while in the queue are
+     * skipped. On a blocking acceptor this would wait for all @em maxN
+     * connections to arrive.
+     * @param conns Vector to which the new connections and their peer
+     *  			addresses are appended.
+     * @param maxN The maximum number of connections to accept.
+     * @param flags Options for the new sockets. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return The number of connections accepted, which can be zero if
+     *  	   none were waiting. An error is only returned if it occurs
+     *  	   before any connections are accepted.
+     */
+    result<size_t> accept_many(
+        std::vector<std::pair<stream_sock_t, addr_t>>& conns,
+        size_t maxN = DFLT_ACCEPT_BATCH, int flags = 0
+    ) {
+        size_t n = 0;
+        while (n < maxN) {
+            addr_t peer;
+            auto res = accept(&peer, flags);
+            if (!res) {
+                if (res == errc::interrupted || res == errc::connection_aborted)
+                    continue;
+                if (n > 0 || res.is_would_block())
+                    break;
+                return res.error();
+            }
+            conns.emplace_back(res.release(), peer);
+            ++n;
+        }
+        return n;
+    }
 };
 
 /////////////////////////////////////////////////////////////////////////////
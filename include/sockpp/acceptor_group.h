@@ -0,0 +1,313 @@
+/**
+ * @file acceptor_group.h
+ *
+ * A group of acceptors listening on the same address with SO_REUSEPORT,
+ * for spreading incoming connections across worker threads.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_acceptor_group_h
+#define __sockpp_acceptor_group_h
+
+#include <thread>
+#include <vector>
+
+#include "sockpp/tcp6_acceptor.h"
+#include "sockpp/tcp_acceptor.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A group of acceptors that all listen on the same address.
+ *
+ * Each acceptor in the group is a separate listening socket, opened with
+ * `SO_REUSEPORT`, so that the kernel spreads incoming connections across
+ * them. The intent is to have one acceptor per worker thread, with each
+ * worker accepting only from its own listener. This avoids the contention
+ * of many threads waiting on a single accept queue.
+ *
+ * On Linux the group can also be opened with a CPU steering filter (see
+ * @ref acceptor::attach_reuseport_cpu_filter) so that a connection goes to
+ * the listener for the CPU that received it. That works best when the
+ * thread for listener @em i is pinned to CPU @em i.
+ *
+ * The kernel only load balances reuseport listeners on some systems, like
+ * Linux and DragonFly BSD. Elsewhere the group can still be opened, but
+ * connections might all go to a single listener.
+ *
+ * Objects of this class are moveable, but not copyable.
+ */
+template <typename ACCEPTOR>
+class acceptor_group
+{
+public:
+    /** The type of acceptor in the group */
+    using acceptor_t = ACCEPTOR;
+    /** The type of address for the acceptors */
+    using addr_t = typename ACCEPTOR::addr_t;
+    /** Iterator over the acceptors */
+    using iterator = typename std::vector<ACCEPTOR>::iterator;
+    /** Const iterator over the acceptors */
+    using const_iterator = typename std::vector<ACCEPTOR>::const_iterator;
+
+    /** The default listener queue size for each acceptor. */
+    static constexpr int DFLT_QUE_SIZE = acceptor::DFLT_QUE_SIZE;
+
+private:
+    /** The acceptors in the group */
+    std::vector<acceptor_t> accs_;
+
+    // Non-copyable
+    acceptor_group(const acceptor_group&) = delete;
+    acceptor_group& operator=(const acceptor_group&) = delete;
+
+public:
+    /**
+     * Gets the default number of acceptors for a group.
+     * This is the number of hardware threads on the host.
+     * @return The default number of acceptors for a group.
+     */
+    static size_t default_size() noexcept {
+        auto n = std::thread::hardware_concurrency();
+        return n ? size_t(n) : size_t(1);
+    }
+    /**
+     * Creates an empty group.
+     */
+    acceptor_group() noexcept {}
+    /**
+     * Creates a group of acceptors all listening on the same address.
+     * @param addr The address on which to listen. If the port is zero, an
+     *  		   ephemeral port is chosen for the first acceptor, and the
+     *  		   rest are bound to the same one.
+     * @param n The number of acceptors in the group.
+     * @param queSize The listener queue size for each acceptor.
+     * @param steerByCpu Whether to steer connections to listeners by the
+     *  				 CPU that received them. This is ignored on
+     *  				 systems other than Linux.
+     * @throws std::system_error
+     */
+    acceptor_group(
+        const addr_t& addr, size_t n = default_size(), int queSize = DFLT_QUE_SIZE,
+        bool steerByCpu = false
+    ) {
+        if (auto res = open(addr, n, queSize, steerByCpu); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates a group of acceptors all listening on the same address.
+     * @param addr The address on which to listen.
+     * @param n The number of acceptors in the group.
+     * @param queSize The listener queue size for each acceptor.
+     * @param steerByCpu Whether to steer connections to listeners by the
+     *  				 CPU that received them.
+     * @param ec The error code, on failure
+     */
+    acceptor_group(
+        const addr_t& addr, size_t n, int queSize, bool steerByCpu, error_code& ec
+    ) noexcept {
+        ec = open(addr, n, queSize, steerByCpu).error();
+    }
+    /**
+     * Move constructor.
+     * @param other The group to move into this one.
+     */
+    acceptor_group(acceptor_group&& other) noexcept : accs_{std::move(other.accs_)} {}
+    /**
+     * Move assignment.
+     * @param rhs The other group to move into this one.
+     * @return A reference to this object.
+     */
+    acceptor_group& operator=(acceptor_group&& rhs) noexcept {
+        accs_ = std::move(rhs.accs_);
+        return *this;
+    }
+    /**
+     * Opens the group of acceptors, all listening on the same address.
+     * If any of the acceptors can't be opened, they're all closed.
+     * If the group is already open, this quietly succeeds without doing
+     * anything.
+     * @param addr The address on which to listen. If the port is zero, an
+     *  		   ephemeral port is chosen for the first acceptor, and the
+     *  		   rest are bound to the same one.
+     * @param n The number of acceptors in the group.
+     * @param queSize The listener queue size for each acceptor.
+     * @param steerByCpu Whether to steer connections to listeners by the
+     *  				 CPU that received them. This is ignored on
+     *  				 systems other than Linux.
+     * @return The error code on failure.
+     */
+    result<> open(
+        const addr_t& addr, size_t n = default_size(), int queSize = DFLT_QUE_SIZE,
+        bool steerByCpu = false
+    ) noexcept;
+    /**
+     * Determines if the group is open.
+     * @return @em true if the group has open acceptors.
+     */
+    bool is_open() const noexcept { return !accs_.empty(); }
+    /**
+     * Gets the number of acceptors in the group.
+     * @return The number of acceptors in the group.
+     */
+    size_t size() const noexcept { return accs_.size(); }
+    /**
+     * Determines if the group has no acceptors.
+     * @return @em true if the group has no acceptors.
+     */
+    bool empty() const noexcept { return accs_.empty(); }
+    /**
+     * Gets one of the acceptors in the group.
+     * @param i The index of the acceptor.
+     * @return A reference to the acceptor.
+     */
+    acceptor_t& operator[](size_t i) { return accs_[i]; }
+    /**
+     * Gets one of the acceptors in the group.
+     * @param i The index of the acceptor.
+     * @return A const reference to the acceptor.
+     */
+    const acceptor_t& operator[](size_t i) const { return accs_[i]; }
+    /**
+     * Gets an iterator to the first acceptor in the group.
+     * @return An iterator to the first acceptor in the group.
+     */
+    iterator begin() noexcept { return accs_.begin(); }
+    /**
+     * Gets an iterator past the last acceptor in the group.
+     * @return An iterator past the last acceptor in the group.
+     */
+    iterator end() noexcept { return accs_.end(); }
+    /**
+     * Gets a const iterator to the first acceptor in the group.
+     * @return A const iterator to the first acceptor in the group.
+     */
+    const_iterator begin() const noexcept { return accs_.begin(); }
+    /**
+     * Gets a const iterator past the last acceptor in the group.
+     * @return A const iterator past the last acceptor in the group.
+     */
+    const_iterator end() const noexcept { return accs_.end(); }
+    /**
+     * Gets the local address on which the group is listening.
+     * @return The local address on which the group is listening.
+     */
+    addr_t address() const { return accs_.empty() ? addr_t{} : accs_.front().address(); }
+    /**
+     * Puts all the acceptors into, or out of, non-blocking mode.
+     * @param on Whether to turn non-blocking mode on or off.
+     * @return The error code on failure.
+     */
+    result<> set_non_blocking(bool on = true) noexcept {
+        for (auto& acc : accs_) {
+            if (auto res = acc.set_non_blocking(on); !res)
+                return res;
+        }
+        return none{};
+    }
+    /**
+     * Closes all the acceptors, leaving the group empty.
+     */
+    void close() noexcept { accs_.clear(); }
+};
+
+// --------------------------------------------------------------------------
+
+template <typename ACCEPTOR>
+result<> acceptor_group<ACCEPTOR>::open(
+    const addr_t& addr, size_t n /*=default_size()*/, int queSize /*=DFLT_QUE_SIZE*/,
+    bool steerByCpu /*=false*/
+) noexcept {
+    if (is_open())
+        return none{};
+
+    if (n == 0)
+        return errc::invalid_argument;
+
+    std::vector<acceptor_t> accs;
+    try {
+        accs.reserve(n);
+    }
+    catch (const std::bad_alloc&) {
+        return errc::not_enough_memory;
+    }
+
+    auto bindAddr = addr;
+    for (size_t i = 0; i < n; ++i) {
+        acceptor_t acc;
+        if (auto res = acc.open(bindAddr, queSize, acceptor::REUSE); !res)
+            return res;
+
+        // With an ephemeral port, the rest must join the first one's.
+        if (i == 0)
+            bindAddr = acc.address();
+
+        accs.push_back(std::move(acc));
+    }
+
+#if defined(__linux__)
+    if (steerByCpu) {
+        if (auto res = accs.front().attach_reuseport_cpu_filter(unsigned(n)); !res)
+            return res;
+    }
+#else
+    (void)steerByCpu;
+#endif
+
+    accs_ = std::move(accs);
+    return none{};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+/** A group of IPv4 TCP acceptors */
+using tcp_acceptor_group = acceptor_group<tcp_acceptor>;
+
+/** A group of IPv6 TCP acceptors */
+using tcp6_acceptor_group = acceptor_group<tcp6_acceptor>;
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_acceptor_group_h
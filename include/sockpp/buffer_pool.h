@@ -0,0 +1,271 @@
+/**
+ * @file buffer_pool.h
+ *
+ * A pool of fixed-size I/O buffers which can be shared by many sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_buffer_pool_h
+#define __sockpp_buffer_pool_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace sockpp {
+
+class buffer_pool;
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A buffer on loan from a @ref buffer_pool.
+ *
+ * This is a move-only handle to a single fixed-size chunk of memory from
+ * a pool. The chunk is returned to the pool when the handle is destroyed,
+ * or explicitly with @ref reset().
+ *
+ * The buffer keeps a length, which is typically the number of bytes of
+ * valid data read into it, as distinct from its capacity, which is the
+ * chunk size of the pool.
+ *
+ * The pool must outlive any of the buffers taken from it.
+ */
+class pooled_buffer
+{
+    /** The pool that owns the memory */
+    buffer_pool* pool_{nullptr};
+    /** The memory chunk */
+    uint8_t* data_{nullptr};
+    /** The number of bytes of valid data in the buffer */
+    size_t len_{0};
+
+    friend class buffer_pool;
+
+    /** Creates a buffer for a chunk from the pool */
+    pooled_buffer(buffer_pool* pool, uint8_t* data) noexcept : pool_{pool}, data_{data} {}
+
+    // Non-copyable
+    pooled_buffer(const pooled_buffer&) = delete;
+    pooled_buffer& operator=(const pooled_buffer&) = delete;
+
+public:
+    /**
+     * Creates an empty buffer that doesn't refer to any memory.
+     */
+    pooled_buffer() noexcept = default;
+    /**
+     * Move constructor.
+     * @param other The buffer to move into this one.
+     */
+    pooled_buffer(pooled_buffer&& other) noexcept
+        : pool_{other.pool_}, data_{other.data_}, len_{other.len_} {
+        other.pool_ = nullptr;
+        other.data_ = nullptr;
+        other.len_ = 0;
+    }
+    /**
+     * Destructor returns the memory to the pool.
+     */
+    ~pooled_buffer() { reset(); }
+    /**
+     * Move assignment.
+     * Any memory currently held by this buffer is returned to its pool.
+     * @param rhs The other buffer to move into this one.
+     * @return A reference to this object.
+     */
+    pooled_buffer& operator=(pooled_buffer&& rhs) noexcept {
+        if (&rhs != this) {
+            reset();
+            std::swap(pool_, rhs.pool_);
+            std::swap(data_, rhs.data_);
+            std::swap(len_, rhs.len_);
+        }
+        return *this;
+    }
+    /**
+     * Determines if this buffer refers to any memory.
+     * @return @em true if the buffer has memory from a pool.
+     */
+    explicit operator bool() const noexcept { return data_ != nullptr; }
+    /**
+     * Gets a pointer to the memory.
+     * @return A pointer to the memory.
+     */
+    uint8_t* data() noexcept { return data_; }
+    /**
+     * Gets a pointer to the memory.
+     * @return A pointer to the memory.
+     */
+    const uint8_t* data() const noexcept { return data_; }
+    /**
+     * Gets the number of bytes of valid data in the buffer.
+     * @return The number of bytes of valid data in the buffer.
+     */
+    size_t size() const noexcept { return len_; }
+    /**
+     * Determines if the buffer has no valid data.
+     * @return @em true if the buffer has no valid data.
+     */
+    bool empty() const noexcept { return len_ == 0; }
+    /**
+     * Gets the capacity of the buffer.
+     * This is the chunk size of the pool.
+     * @return The capacity of the buffer.
+     */
+    inline size_t capacity() const noexcept;
+    /**
+     * Sets the number of bytes of valid data in the buffer.
+     * @param n The number of bytes. This is clamped to the capacity.
+     */
+    void resize(size_t n) noexcept {
+        auto cap = capacity();
+        len_ = (n < cap) ? n : cap;
+    }
+    /**
+     * Returns the memory to the pool, leaving this buffer empty.
+     */
+    inline void reset() noexcept;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A pool of fixed-size memory chunks for I/O buffers.
+ *
+ * Memory is carved out of large slabs, which are only released when the
+ * pool is destroyed. Each thread keeps a small cache of free chunks for
+ * each pool that it uses, so that getting and returning a buffer
+ * normally takes no locks. The caches are refilled from, and spill back
+ * into, a shared free list in batches.
+ *
+ * The intended use is that a server does not hold a buffer for an idle
+ * connection, but only takes one from the pool when the socket is known
+ * to be readable, and returns it as soon as the data is consumed. Many
+ * thousands of idle connections then cost very little memory.
+ *
+ * The pool is thread-safe. It must outlive any buffers taken from it.
+ */
+class buffer_pool
+{
+public:
+    /** The default size of each chunk, in bytes */
+    static constexpr size_t DFLT_CHUNK_SIZE = 16 * 1024;
+    /** The default number of chunks allocated at a time */
+    static constexpr size_t DFLT_SLAB_CHUNKS = 64;
+    /** The number of free chunks each thread keeps for itself */
+    static constexpr size_t THREAD_CACHE_SIZE = 32;
+
+    /** The shared state, which thread caches can refer to weakly */
+    struct core;
+
+private:
+    /** The size of each chunk */
+    size_t chunkSz_;
+    /** The shared state of the pool */
+    std::shared_ptr<core> core_;
+
+    friend class pooled_buffer;
+
+    /** Returns a chunk to the pool */
+    void release(uint8_t* p) noexcept;
+
+    // Non-copyable
+    buffer_pool(const buffer_pool&) = delete;
+    buffer_pool& operator=(const buffer_pool&) = delete;
+
+public:
+    /**
+     * Creates a buffer pool.
+     * No memory is allocated until the first buffer is requested.
+     * @param chunkSize The size of each buffer, in bytes.
+     * @param slabChunks The number of buffers to allocate at a time when
+     *  				 the pool needs to grow.
+     */
+    explicit buffer_pool(
+        size_t chunkSize = DFLT_CHUNK_SIZE, size_t slabChunks = DFLT_SLAB_CHUNKS
+    );
+    /**
+     * Destroys the pool, freeing all of its memory.
+     */
+    ~buffer_pool();
+    /**
+     * Gets the size of each buffer in the pool.
+     * @return The size of each buffer in the pool, in bytes.
+     */
+    size_t chunk_size() const noexcept { return chunkSz_; }
+    /**
+     * Gets a buffer from the pool.
+     * The pool grows if there are no free buffers.
+     * @return A buffer with a capacity of the chunk size.
+     * @throws std::bad_alloc if the pool needs to grow and there is no
+     *  	   memory.
+     */
+    pooled_buffer get();
+    /**
+     * Gets the total number of buffers that the pool has allocated,
+     * whether in use or not.
+     * @return The total number of buffers that the pool has allocated.
+     */
+    size_t capacity() const noexcept;
+};
+
+// --------------------------------------------------------------------------
+
+inline size_t pooled_buffer::capacity() const noexcept {
+    return pool_ ? pool_->chunk_size() : 0;
+}
+
+inline void pooled_buffer::reset() noexcept {
+    if (data_) {
+        pool_->release(data_);
+        pool_ = nullptr;
+        data_ = nullptr;
+        len_ = 0;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_buffer_pool_h
@@ -0,0 +1,264 @@
+/**
+ * @file buffered_stream.h
+ *
+ * A buffered reader for stream sockets, with in-place message framing.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_buffered_stream_h
+#define __sockpp_buffered_stream_h
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A read buffer over a stream socket that splits the incoming data into
+ * messages.
+ *
+ * The data is read into a single contiguous buffer, and each message is
+ * returned as a view into that buffer, so nothing is copied once it comes
+ * off the socket. A view is valid until the next read from the stream.
+ * Each refill of the buffer is a single read from the socket, for as much
+ * as fits, so a burst of small messages costs one system call.
+ *
+ * The buffer grows as needed to hold a whole message, up to a maximum
+ * size. A message that won't fit fails with `errc::message_size`.
+ *
+ * This works on a non-blocking socket. If a read would block, it fails
+ * with the socket error, and any partial message stays in the buffer for
+ * the next call, when the socket is ready again.
+ *
+ * When the peer closes the connection, a read fails with
+ * `errc::not_connected` if it happened between messages, or with
+ * `errc::connection_reset` if it cut a message short.
+ *
+ * The stream refers to the socket, but does not own it. Since it reads
+ * through stream_socket::read(), it also works over a @ref tls_socket.
+ */
+class buffered_stream
+{
+public:
+    /** The byte order of a length prefix */
+    enum class endian { big, little };
+
+    /** The default initial size of the buffer */
+    static constexpr size_t DFLT_BUFFER_SIZE = 16 * 1024;
+    /** The default maximum size of the buffer, and thus of a message */
+    static constexpr size_t DFLT_MAX_SIZE = 1024 * 1024;
+
+private:
+    /** The socket being read */
+    stream_socket& sock_;
+    /** The buffer */
+    std::vector<char> buf_;
+    /** The offset of the first unread byte in the buffer */
+    size_t beg_{0};
+    /** The offset just past the last byte in the buffer */
+    size_t end_{0};
+    /** The largest that the buffer can grow */
+    size_t maxSize_;
+    /** Whether the peer has closed the connection */
+    bool eof_{false};
+    /** Whether to raise the socket's receive low-water mark for frames */
+    bool frameLowat_{false};
+    /** The receive low-water mark currently set on the socket */
+    size_t lowat_{1};
+
+    /**
+     * Makes room, and reads once from the socket into the end of the
+     * buffer.
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> fill();
+    /**
+     * Takes the next n bytes from the buffer.
+     */
+    std::string_view take(size_t n) {
+        std::string_view sv{buf_.data() + beg_, n};
+        beg_ += n;
+        return sv;
+    }
+    /**
+     * Sets the receive low-water mark on the socket, if it changed.
+     * If the socket won't take it, frame low-water marks are turned off.
+     */
+    void set_lowat(size_t n);
+    /**
+     * Reads a message with a length prefix of the specified size.
+     */
+    result<std::string_view> read_frame(size_t hdrSize, endian order);
+
+public:
+    /**
+     * Creates a buffered reader for a socket.
+     * @param sock The socket to read. It must outlive the stream.
+     * @param bufSize The initial size of the buffer.
+     * @param maxSize The largest the buffer can grow to hold a single
+     *  			  message.
+     */
+    explicit buffered_stream(
+        stream_socket& sock, size_t bufSize = DFLT_BUFFER_SIZE, size_t maxSize = DFLT_MAX_SIZE
+    );
+    /**
+     * Gets the socket being read.
+     * @return A reference to the socket being read.
+     */
+    stream_socket& sock() { return sock_; }
+    /**
+     * Gets the number of bytes in the buffer that have not been read.
+     * @return The number of buffered bytes.
+     */
+    size_t available() const { return end_ - beg_; }
+    /**
+     * Gets a view of the data in the buffer that has not been read.
+     * @return A view of the buffered data.
+     */
+    std::string_view buffered() const {
+        return std::string_view{buf_.data() + beg_, end_ - beg_};
+    }
+    /**
+     * Gets the current size of the buffer.
+     * @return The size of the buffer.
+     */
+    size_t capacity() const { return buf_.size(); }
+    /**
+     * Determines if the peer has closed the connection.
+     * There may still be unread data in the buffer.
+     * @return @em true if the peer closed the connection.
+     */
+    bool eof() const { return eof_; }
+    /**
+     * Sets whether to wait for whole frames in the kernel.
+     *
+     * When this is on, and a frame read finds only part of a large frame
+     * in the buffer, the stream sets the socket's `SO_RCVLOWAT` option to
+     * the size of the rest of the frame. A reactor or poller then doesn't
+     * report the socket as readable until the whole frame has arrived, so
+     * it can be read with a single call, rather than a wakeup and a read
+     * for each few packets. The low-water mark is set back to one byte
+     * once the frame is complete.
+     *
+     * This costs two extra system calls for each frame that doesn't
+     * arrive all at once, and nothing for those that do. It's off by
+     * default.
+     *
+     * @param on Whether to wait for whole frames.
+     */
+    void frame_lowat(bool on);
+    /**
+     * Determines if the stream waits for whole frames in the kernel.
+     * @return @em true if the stream sets the receive low-water mark for
+     *  	   frames.
+     */
+    bool frame_lowat() const { return frameLowat_; }
+    /**
+     * Reads up to the next delimiter.
+     * The delimiter is consumed, but not included in the returned view.
+     * @param delim The delimiter. This must not be empty.
+     * @return A view of the data up to the delimiter, or the error code on
+     *  	   failure.
+     */
+    result<std::string_view> read_until(std::string_view delim);
+    /**
+     * Reads up to the next byte value.
+     * The delimiter is consumed, but not included in the returned view.
+     * @param delim The delimiter.
+     * @return A view of the data up to the delimiter, or the error code on
+     *  	   failure.
+     */
+    result<std::string_view> read_until(char delim) {
+        return read_until(std::string_view{&delim, 1});
+    }
+    /**
+     * Reads a line of text.
+     * The line ends in a newline, which may be preceded by a carriage
+     * return. Neither is included in the returned view.
+     * @return A view of the line, or the error code on failure.
+     */
+    result<std::string_view> read_line();
+    /**
+     * Reads the specified number of bytes.
+     * @param n The number of bytes to read.
+     * @return A view of the data, or the error code on failure.
+     */
+    result<std::string_view> read_exact(size_t n);
+    /**
+     * Reads a message that is preceded by a 16-bit length.
+     * @param order The byte order of the length.
+     * @return A view of the message, without the length, or the error code
+     *  	   on failure.
+     */
+    result<std::string_view> read_frame16(endian order = endian::big) {
+        return read_frame(2, order);
+    }
+    /**
+     * Reads a message that is preceded by a 32-bit length.
+     * @param order The byte order of the length.
+     * @return A view of the message, without the length, or the error code
+     *  	   on failure.
+     */
+    result<std::string_view> read_frame32(endian order = endian::big) {
+        return read_frame(4, order);
+    }
+    /**
+     * Reads whatever is available into a caller's buffer.
+     * Data in the buffer is returned first. If the buffer is empty, this
+     * reads directly from the socket, without buffering.
+     * @param buf The buffer to receive the data.
+     * @param n The size of the buffer.
+     * @return The number of bytes read, zero if the peer has closed the
+     *  	   connection, or the error code on failure.
+     */
+    result<size_t> read(void* buf, size_t n);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_buffered_stream_h
@@ -0,0 +1,368 @@
+/**
+ * @file can_bcm_socket.h
+ *
+ * Class for the Linux SocketCAN broadcast manager (BCM) sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_can_bcm_socket_h
+#define __sockpp_can_bcm_socket_h
+
+#include <linux/can/bcm.h>
+
+#include "sockpp/can_address.h"
+#include "sockpp/can_frame.h"
+#include "sockpp/socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Linux SocketCAN broadcast manager (BCM) socket.
+ *
+ * The broadcast manager moves the timing of periodic CAN traffic into the
+ * kernel. Cyclic transmit jobs send their frames at a fixed interval with
+ * no help from the application, whose frames can be updated at any time
+ * without disturbing the timing. Receive jobs filter the incoming frames
+ * for an ID and only notify the application when the content changes
+ * (under a mask), or when a cyclic frame stops arriving.
+ *
+ * Each job is identified by its CAN ID. Setting up a job for an ID that
+ * already has one updates it. The jobs belong to the socket, and are
+ * removed when it is closed.
+ *
+ * Notifications are read with @ref recv(). Each comes with a message head,
+ * where the `opcode` is `RX_CHANGED`, `RX_TIMEOUT` or `TX_EXPIRED`, and
+ * the `can_id` is the ID of the job.
+ *
+ * The frame arguments can be classic or FD frames, but any one job must
+ * stick to one type.
+ */
+class can_bcm_socket : public socket
+{
+    /** The base class */
+    using base = socket;
+
+    // Non-copyable
+    can_bcm_socket(const can_bcm_socket&) = delete;
+    can_bcm_socket& operator=(const can_bcm_socket&) = delete;
+
+    /**
+     * Sends an operation to the broadcast manager.
+     * @param head The message head. The frame count and FD flag are set
+     *  		   from the frames.
+     * @param frames The frames for the operation.
+     * @param n The number of frames.
+     * @return The error code on failure.
+     */
+    template <typename FRAME>
+    result<> send_op(bcm_msg_head& head, const FRAME* frames, size_t n);
+    /**
+     * Receives a notification from the broadcast manager.
+     * @param head Gets the message head.
+     * @param frames Array to get the frames.
+     * @param n The number of frames in the array.
+     * @return The number of frames received, or the error code on failure.
+     */
+    template <typename FRAME>
+    result<size_t> recv_op(bcm_msg_head& head, FRAME* frames, size_t n);
+    /**
+     * Sets up a transmit job.
+     * See the public overloads.
+     */
+    template <typename FRAME>
+    result<> tx_setup_op(
+        const FRAME* frames, size_t n, microseconds interval, uint32_t count,
+        microseconds initInterval, uint32_t flags
+    );
+    /**
+     * Sets up a receive job.
+     * See the public overloads.
+     */
+    template <typename FRAME>
+    result<> rx_setup_op(
+        canid_t canID, const FRAME* masks, size_t n, microseconds timeout,
+        microseconds throttle, uint32_t flags
+    );
+
+public:
+    /** The SocketCAN protocol family. */
+    static const int PROTOCOL_FAMILY = AF_CAN;
+
+    /** The socket 'type' for communications semantics. */
+    static constexpr int COMM_TYPE = SOCK_DGRAM;
+
+    /**
+     * Creates an uninitialized BCM socket.
+     */
+    can_bcm_socket() noexcept {}
+    /**
+     * Creates a BCM socket from an existing OS socket handle and claims
+     * ownership of the handle.
+     * @param handle A socket handle from the operating system.
+     */
+    explicit can_bcm_socket(socket_t handle) noexcept : base(handle) {}
+    /**
+     * Creates a BCM socket and connects it to the interface.
+     * @param addr The address of the CAN interface.
+     * @throws std::system_error on failure
+     */
+    explicit can_bcm_socket(const can_address& addr) {
+        if (auto res = open(addr); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates a BCM socket and connects it to the interface.
+     * @param addr The address of the CAN interface.
+     * @param ec The error code, on failure
+     */
+    can_bcm_socket(const can_address& addr, error_code& ec) noexcept {
+        ec = open(addr).error();
+    }
+    /**
+     * Move constructor.
+     * @param other The other socket to move to this one
+     */
+    can_bcm_socket(can_bcm_socket&& other) : base(std::move(other)) {}
+    /**
+     * Move assignment.
+     * @param rhs The other socket to move into this one.
+     * @return A reference to this object.
+     */
+    can_bcm_socket& operator=(can_bcm_socket&& rhs) {
+        base::operator=(std::move(rhs));
+        return *this;
+    }
+    /**
+     * Opens the BCM socket and connects it to the CAN interface.
+     * @param addr The address of the CAN interface.
+     * @return The error code, on failure.
+     */
+    result<> open(const can_address& addr) noexcept;
+
+    // ----- Transmit -----
+
+    /**
+     * Sets up a cyclic transmission of one or more frames.
+     *
+     * The kernel sends the frames in turn, one per interval, starting
+     * right away. The job is identified by the ID of the first frame.
+     * When @em count is non-zero, the first @em count frames are sent at
+     * @em initInterval and the rest at @em interval. If @em interval is
+     * zero, the job then stops, and a `TX_EXPIRED` notification is sent
+     * if `TX_COUNTEVT` is in the flags.
+     * @param frames The frames to send.
+     * @param n The number of frames.
+     * @param interval The time between frames.
+     * @param count The number of frames to send at the initial interval.
+     * @param initInterval The time between the first @em count frames.
+     * @param flags Additional BCM flags, such as `TX_COUNTEVT` or
+     *  			`TX_CP_CAN_ID`.
+     * @return The error code on failure.
+     */
+    result<> tx_setup(
+        const can_frame* frames, size_t n, microseconds interval, uint32_t count = 0,
+        microseconds initInterval = microseconds{0}, uint32_t flags = 0
+    );
+    /**
+     * Sets up a cyclic transmission of one or more FD frames.
+     * @param frames The frames to send.
+     * @param n The number of frames.
+     * @param interval The time between frames.
+     * @param count The number of frames to send at the initial interval.
+     * @param initInterval The time between the first @em count frames.
+     * @param flags Additional BCM flags.
+     * @return The error code on failure.
+     */
+    result<> tx_setup(
+        const canfd_frame* frames, size_t n, microseconds interval, uint32_t count = 0,
+        microseconds initInterval = microseconds{0}, uint32_t flags = 0
+    );
+    /**
+     * Sets up a cyclic transmission of a single frame.
+     * @param frame The frame to send.
+     * @param interval The time between frames.
+     * @return The error code on failure.
+     */
+    result<> tx_setup(const can_frame& frame, microseconds interval) {
+        return tx_setup(&frame, 1, interval);
+    }
+    /**
+     * Sets up a cyclic transmission of a single FD frame.
+     * @param frame The frame to send.
+     * @param interval The time between frames.
+     * @return The error code on failure.
+     */
+    result<> tx_setup(const canfd_frame& frame, microseconds interval) {
+        return tx_setup(&frame, 1, interval);
+    }
+    /**
+     * Updates the content of a cyclic transmission, keeping its timing.
+     * @param frame The new frame. Its ID selects the job.
+     * @return The error code on failure.
+     */
+    result<> tx_update(const can_frame& frame);
+    /**
+     * Updates the content of a cyclic FD transmission, keeping its timing.
+     * @param frame The new frame. Its ID selects the job.
+     * @return The error code on failure.
+     */
+    result<> tx_update(const canfd_frame& frame);
+    /**
+     * Removes a cyclic transmission.
+     * @param canID The ID of the job.
+     * @param fd Whether it is a job for FD frames.
+     * @return The error code on failure.
+     */
+    result<> tx_delete(canid_t canID, bool fd = false);
+    /**
+     * Sends a single frame, once, through the broadcast manager.
+     * @param frame The frame to send.
+     * @return The error code on failure.
+     */
+    result<> tx_send(const can_frame& frame);
+    /**
+     * Sends a single FD frame, once, through the broadcast manager.
+     * @param frame The frame to send.
+     * @return The error code on failure.
+     */
+    result<> tx_send(const canfd_frame& frame);
+
+    // ----- Receive -----
+
+    /**
+     * Sets up a receive filter for frames with the specified ID.
+     *
+     * Only the bits that are set in the masks are compared. A frame is
+     * passed up, as an `RX_CHANGED` notification, only when any of those
+     * bits change from the last one. With more than one mask, the first
+     * byte of the data of the frame is a multiplex index that selects the
+     * mask to use. With no masks, every frame with the ID is passed up.
+     * @param canID The CAN ID to filter.
+     * @param masks The content masks.
+     * @param n The number of masks.
+     * @param timeout If not zero, an `RX_TIMEOUT` notification is sent
+     *  			  when no frame arrives within this time.
+     * @param throttle If not zero, the minimum time between changed
+     *  			   notifications.
+     * @param flags Additional BCM flags, such as `RX_CHECK_DLC` or
+     *  			`RX_ANNOUNCE_RESUME`.
+     * @return The error code on failure.
+     */
+    result<> rx_setup(
+        canid_t canID, const can_frame* masks, size_t n,
+        microseconds timeout = microseconds{0}, microseconds throttle = microseconds{0},
+        uint32_t flags = 0
+    );
+    /**
+     * Sets up a receive filter for FD frames with the specified ID.
+     * @param canID The CAN ID to filter.
+     * @param masks The content masks.
+     * @param n The number of masks.
+     * @param timeout If not zero, the time after which a missing frame is
+     *  			  reported.
+     * @param throttle If not zero, the minimum time between changed
+     *  			   notifications.
+     * @param flags Additional BCM flags.
+     * @return The error code on failure.
+     */
+    result<> rx_setup(
+        canid_t canID, const canfd_frame* masks, size_t n,
+        microseconds timeout = microseconds{0}, microseconds throttle = microseconds{0},
+        uint32_t flags = 0
+    );
+    /**
+     * Sets up a receive filter for any change to frames with the
+     * specified ID.
+     * @param canID The CAN ID to filter.
+     * @param mask The content mask.
+     * @param timeout If not zero, the time after which a missing frame is
+     *  			  reported.
+     * @return The error code on failure.
+     */
+    result<> rx_setup(
+        canid_t canID, const can_frame& mask, microseconds timeout = microseconds{0}
+    ) {
+        return rx_setup(canID, &mask, 1, timeout);
+    }
+    /**
+     * Sets up a receive filter that passes up every frame with the
+     * specified ID, with no content filtering.
+     * @param canID The CAN ID to filter.
+     * @param timeout If not zero, the time after which a missing frame is
+     *  			  reported.
+     * @return The error code on failure.
+     */
+    result<> rx_filter_id(canid_t canID, microseconds timeout = microseconds{0}) {
+        return rx_setup(canID, static_cast<const can_frame*>(nullptr), 0, timeout);
+    }
+    /**
+     * Removes a receive filter.
+     * @param canID The ID of the job.
+     * @param fd Whether it is a job for FD frames.
+     * @return The error code on failure.
+     */
+    result<> rx_delete(canid_t canID, bool fd = false);
+    /**
+     * Receives a notification from the broadcast manager.
+     * @param head Gets the message head.
+     * @param frames Array to get the frames of the notification, if any.
+     * @param n The number of frames in the array.
+     * @return The number of frames received, or the error code on failure.
+     */
+    result<size_t> recv(bcm_msg_head& head, can_frame* frames, size_t n);
+    /**
+     * Receives a notification from the broadcast manager for a job using
+     * FD frames.
+     * @param head Gets the message head.
+     * @param frames Array to get the frames of the notification, if any.
+     * @param n The number of frames in the array.
+     * @return The number of frames received, or the error code on failure.
+     */
+    result<size_t> recv(bcm_msg_head& head, canfd_frame* frames, size_t n);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_can_bcm_socket_h
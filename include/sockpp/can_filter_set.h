@@ -0,0 +1,139 @@
+/**
+ * @file can_filter_set.h
+ *
+ * Class to build a compact set of SocketCAN receive filters from a set of
+ * CAN ID's.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_can_filter_set_h
+#define __sockpp_can_filter_set_h
+
+#include <linux/can.h>
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A set of CAN ID's that can be compiled into receive filters.
+ *
+ * The kernel tests each received frame against every filter on a raw CAN
+ * socket, one after another. Pushing one filter per ID gets expensive as
+ * the number of ID's grows. This collects the ID's and ranges that the
+ * application wants, and then coalesces them into a minimal-ish list of
+ * ID/mask pairs which accept exactly those ID's, no more and no less.
+ *
+ * ID's with the CAN_EFF_FLAG bit set are extended (29-bit) ID's. All others
+ * are standard (11-bit) ID's. The filters match both data and remote
+ * (RTR) frames.
+ */
+class can_filter_set
+{
+    /** A closed range of ID's */
+    using range = std::pair<canid_t, canid_t>;
+
+    /** The ranges of standard ID's */
+    std::vector<range> sff_;
+    /** The ranges of extended ID's */
+    std::vector<range> eff_;
+
+public:
+    /**
+     * Creates an empty set.
+     */
+    can_filter_set() = default;
+    /**
+     * Creates a set from a list of ID's.
+     * @param ids The CAN ID's to add to the set.
+     */
+    can_filter_set(std::initializer_list<canid_t> ids);
+    /**
+     * Determines if the set is empty.
+     * @return @em true if no ID's have been added to the set.
+     */
+    bool empty() const { return sff_.empty() && eff_.empty(); }
+    /**
+     * Removes all the ID's from the set.
+     */
+    void clear() {
+        sff_.clear();
+        eff_.clear();
+    }
+    /**
+     * Adds a single ID to the set.
+     * @param id The CAN ID. Set CAN_EFF_FLAG for an extended ID.
+     * @return A reference to this object.
+     */
+    can_filter_set& add(canid_t id) { return add(id, id); }
+    /**
+     * Adds a range of ID's to the set.
+     * The range takes its type from the first ID. If CAN_EFF_FLAG is set
+     * on it, this is a range of extended ID's.
+     * @param first The first ID of the range.
+     * @param last The last ID of the range, inclusive.
+     * @return A reference to this object.
+     */
+    can_filter_set& add(canid_t first, canid_t last);
+    /**
+     * Determines if an ID is in the set.
+     * @param id The CAN ID. Set CAN_EFF_FLAG for an extended ID.
+     * @return @em true if the ID is in the set.
+     */
+    bool contains(canid_t id) const;
+    /**
+     * Creates the filters that accept all the ID's in the set.
+     * Note that an empty set compiles to an empty list of filters which,
+     * when applied to a socket, receives nothing.
+     * @return A list of filters for the set.
+     */
+    std::vector<can_filter> compile() const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_can_filter_set_h
@@ -54,6 +54,12 @@
 
 #include "sockpp/platform.h"
 
+// Older kernel headers don't have this flag, which the kernel sets on
+// received FD frames to tell them from classic ones.
+#if !defined(CANFD_FDF)
+    #define CANFD_FDF 0x04
+#endif
+
 namespace sockpp {
 
 /////////////////////////////////////////////////////////////////////////////
@@ -102,6 +108,85 @@ public:
     can_frame(const base& frame) : base{frame} {}
 };
 
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Class that represents a Linux SocketCAN FD frame.
+ *
+ * This inherits from the Linux CAN FD frame struct, just providing easier
+ * construction. An FD frame carries up to 64 bytes of data.
+ *
+ * The same struct can also hold a classic frame. When frames are read
+ * from a socket with FD frames enabled, the `CANFD_FDF` flag is set for
+ * those that were actually FD frames, which can be checked with
+ * @ref is_fd(). Likewise, a frame is sent as an FD frame only if it has
+ * the flag set, which the constructors here do by default.
+ */
+class canfd_frame : public ::canfd_frame
+{
+    /** The base class is the C library CAN FD frame struct. */
+    using base = ::canfd_frame;
+
+public:
+    /**
+     * Constructs an empty frame.
+     * The frame is initialized to all zeroes, and so is not considered to
+     * be an FD frame.
+     */
+    canfd_frame() : base{} {}
+    /**
+     * Constructs an FD frame with the specified ID and data.
+     * @param canID The CAN identifier for the frame
+     * @param data The data field for the frame
+     * @param flags Additional FD flags, like `CANFD_BRS` to use a faster
+     *  			bit rate for the data.
+     */
+    canfd_frame(canid_t canID, const string& data, uint8_t flags = 0)
+        : canfd_frame{canID, data.data(), data.length(), flags} {}
+    /**
+     * Constructs an FD frame with the specified ID and data.
+     * @param canID The CAN identifier for the frame
+     * @param data The data field for the frame
+     * @param n The number of bytes in the data field. This is cut to
+     *  		`CANFD_MAX_DLEN` if it's longer.
+     * @param flags Additional FD flags, like `CANFD_BRS` to use a faster
+     *  			bit rate for the data.
+     */
+    canfd_frame(canid_t canID, const void* data, size_t n, uint8_t flags = 0) : base{} {
+        if (n > CANFD_MAX_DLEN)
+            n = CANFD_MAX_DLEN;
+        this->can_id = canID;
+        this->len = uint8_t(n);
+        this->flags = uint8_t(flags | CANFD_FDF);
+        ::memcpy(&this->data, data, n);
+    }
+    /**
+     * Construct a frame from a C library CAN FD frame.
+     * @param frame A C lib CAN FD frame.
+     */
+    canfd_frame(const base& frame) : base{frame} {}
+    /**
+     * Construct a classic frame in the FD struct.
+     * @param frame A classic CAN frame.
+     */
+    canfd_frame(const ::can_frame& frame) : base{} {
+        this->can_id = frame.can_id;
+        this->len = frame.can_dlc;
+        ::memcpy(&this->data, frame.data, sizeof(frame.data));
+    }
+    /**
+     * Determines if this is an FD frame, as opposed to a classic one.
+     * @return @em true if the `CANFD_FDF` flag is set.
+     */
+    bool is_fd() const noexcept { return (this->flags & CANFD_FDF) != 0; }
+    /**
+     * Gets the number of bytes that this frame takes on a socket: the
+     * size of an FD frame, or of a classic frame.
+     * @return `CANFD_MTU` for an FD frame, otherwise `CAN_MTU`.
+     */
+    size_t mtu() const noexcept { return is_fd() ? CANFD_MTU : CAN_MTU; }
+};
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
 
@@ -0,0 +1,199 @@
+/**
+ * @file can_ring_socket.h
+ *
+ * Class for a memory-mapped receive ring on a Linux CAN interface.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_can_ring_socket_h
+#define __sockpp_can_ring_socket_h
+
+#include "sockpp/can_address.h"
+#include "sockpp/can_frame.h"
+#include "sockpp/packet_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A memory-mapped receive ring for all the traffic on a CAN interface.
+ *
+ * This is meant for bus loggers and similar applications that want to
+ * consume every frame on a busy bus. It's a @ref packet_socket with a
+ * TPACKET_V3 receive ring, bound to a CAN interface. The kernel fills
+ * blocks of frames in the ring, and the application consumes a whole block
+ * at a time, with no system calls at all while there are full blocks
+ * waiting.
+ *
+ * The kernel hands over a block when it fills up, or when the block
+ * retire timeout expires, whichever comes first. So the timeout sets the
+ * maximum latency for frames on a quiet bus.
+ *
+ * Frames sent by the host are reported once, as they come back from the
+ * interface. Both classic and FD frames are delivered. Opening the ring
+ * requires the CAP_NET_RAW capability. The CAN_RAW socket options, like
+ * filters, don't apply to it.
+ */
+class can_ring_socket : public packet_socket
+{
+    /** The base class */
+    using base = packet_socket;
+
+    /**
+     * Gets the frame from a packet in the ring.
+     * @return @em true if this is a frame that should be reported.
+     */
+    static bool get_frame(const packet& pkt, canfd_frame& frame) noexcept;
+
+public:
+    /** The default size of each block in the ring */
+    static constexpr size_t DFLT_BLOCK_SIZE = 1 << 16;
+    /** The default number of blocks in the ring */
+    static constexpr size_t DFLT_BLOCK_COUNT = 32;
+    /** The default block retire timeout */
+    static constexpr milliseconds DFLT_RETIRE_TIMEOUT{10};
+
+    /**
+     * Creates an unopened ring socket.
+     */
+    can_ring_socket() noexcept {}
+    /**
+     * Creates the receive ring on the CAN interface.
+     * @param addr The address of the CAN interface.
+     * @param blockSize The size of each block. This must be a multiple of
+     *  				the page size.
+     * @param nBlocks The number of blocks in the ring.
+     * @param retireTimeout How long the kernel can hold on to a block that
+     *  					isn't full.
+     * @throws std::system_error on failure
+     */
+    explicit can_ring_socket(
+        const can_address& addr, size_t blockSize = DFLT_BLOCK_SIZE,
+        size_t nBlocks = DFLT_BLOCK_COUNT, milliseconds retireTimeout = DFLT_RETIRE_TIMEOUT
+    ) {
+        if (auto res = open(addr, blockSize, nBlocks, retireTimeout); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates the receive ring on the CAN interface.
+     * @param addr The address of the CAN interface.
+     * @param ec The error code, on failure
+     * @param blockSize The size of each block. This must be a multiple of
+     *  				the page size.
+     * @param nBlocks The number of blocks in the ring.
+     * @param retireTimeout How long the kernel can hold on to a block that
+     *  					isn't full.
+     */
+    can_ring_socket(
+        const can_address& addr, error_code& ec, size_t blockSize = DFLT_BLOCK_SIZE,
+        size_t nBlocks = DFLT_BLOCK_COUNT, milliseconds retireTimeout = DFLT_RETIRE_TIMEOUT
+    ) noexcept {
+        ec = open(addr, blockSize, nBlocks, retireTimeout).error();
+    }
+    /**
+     * Move constructor.
+     * @param other The other socket to move to this one
+     */
+    can_ring_socket(can_ring_socket&& other) noexcept : base(std::move(other)) {}
+    /**
+     * Move assignment.
+     * @param rhs The other socket to move into this one.
+     * @return A reference to this object.
+     */
+    can_ring_socket& operator=(can_ring_socket&& rhs) noexcept {
+        base::operator=(std::move(rhs));
+        return *this;
+    }
+    /**
+     * Creates the receive ring on the CAN interface.
+     * @param addr The address of the CAN interface.
+     * @param blockSize The size of each block. This must be a multiple of
+     *  				the page size.
+     * @param nBlocks The number of blocks in the ring.
+     * @param retireTimeout How long the kernel can hold on to a block that
+     *  					isn't full.
+     * @return The error code, on failure.
+     */
+    result<> open(
+        const can_address& addr, size_t blockSize = DFLT_BLOCK_SIZE,
+        size_t nBlocks = DFLT_BLOCK_COUNT, milliseconds retireTimeout = DFLT_RETIRE_TIMEOUT
+    ) noexcept;
+    /**
+     * Consumes the next block of frames from the ring.
+     *
+     * This waits for a block, calls the function for each frame in it,
+     * and then hands the block back to the kernel. The frame is only
+     * valid for the duration of the call. The timestamp is the software
+     * receive time on the system clock.
+     *
+     * @param fn The function to call, like:
+     *  		 `fn(const canfd_frame& frame, nanoseconds ts)`
+     * @param timeout The maximum time to wait for a block. A negative
+     *  			  value waits forever.
+     * @return The number of frames reported from the block, which is zero
+     *  	   on a timeout, or the error code on failure.
+     */
+    template <typename Func>
+    result<size_t> read(Func&& fn, milliseconds timeout = milliseconds{-1}) {
+        size_t n = 0;
+        canfd_frame frame;
+
+        auto res = base::read(
+            [&](const packet& pkt) {
+                if (get_frame(pkt, frame)) {
+                    fn(const_cast<const canfd_frame&>(frame), pkt.timestamp());
+                    ++n;
+                }
+            },
+            timeout
+        );
+        if (!res)
+            return res;
+        return n;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_can_ring_socket_h
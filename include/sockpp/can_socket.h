@@ -52,6 +52,7 @@
 #include <vector>
 
 #include "sockpp/can_address.h"
+#include "sockpp/can_filter_set.h"
 #include "sockpp/can_frame.h"
 #include "sockpp/raw_socket.h"
 
@@ -91,9 +92,49 @@ class can_socket : public raw_socket
      */
     result<> connect(const sock_address&) = delete;
 
+    /**
+     * Receives a batch of frames, of either type, with recvmmsg().
+     * @param frames The array of frames.
+     * @param n The number of frames in the array.
+     * @param ts Array for the timestamps of the frames, or null.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of frames received, or the error code on failure.
+     */
+    template <typename FRAME>
+    result<size_t> recv_frames(FRAME* frames, size_t n, packet_timestamp* ts, int flags);
+    /**
+     * Sends a batch of frames, of either type, with sendmmsg().
+     * @param frames The array of frames.
+     * @param n The number of frames in the array.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of frames sent, or the error code on failure.
+     */
+    template <typename FRAME>
+    result<size_t> send_frames(const FRAME* frames, size_t n, int flags);
+    /**
+     * Marks a frame that was read as FD, if it was the size of one.
+     * @param frame The frame that was read.
+     * @param res The result of the read.
+     * @return The result of the read.
+     */
+    static result<size_t> mark_fd(canfd_frame* frame, result<size_t> res) {
+        if (res && res.value() == CANFD_MTU)
+            frame->flags |= CANFD_FDF;
+        return res;
+    }
+
 protected:
-    static result<socket_t> create_handle(int type, int protocol) {
-        return check_socket(socket_t(::socket(PROTOCOL_FAMILY, type, protocol)));
+    /**
+     * Creates a CAN socket.
+     * @param type The socket type, like SOCK_RAW.
+     * @param protocol The CAN protocol, like CAN_RAW.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return An OS handle to a CAN socket on success, or an error code
+     *         on failure.
+     */
+    static result<socket_t> create_handle(int type, int protocol, int flags = 0) {
+        return socket::create_handle(PROTOCOL_FAMILY, type, protocol, flags);
     }
 
 public:
@@ -151,9 +192,11 @@ public:
     /**
      * Opens the CANbus socket and binds it to the address.
      * @param addr The address to bind the socket
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return The error code, on failure.
      */
-    result<> open(const can_address& addr) noexcept;
+    result<> open(const can_address& addr, int flags = 0) noexcept;
     /**
      * Gets the system time of the last frame read from the socket.
      * @return The system time of the last frame read from the socket with
@@ -184,7 +227,9 @@ public:
      * @return @em true if the filters were set, @em false otherwise.
      */
     result<> set_filters(const can_filter* filters, size_t n) {
-        return set_option(SOL_CAN_RAW, CAN_RAW_FILTER, filters, socklen_t(n));
+        return set_option(
+            SOL_CAN_RAW, CAN_RAW_FILTER, filters, socklen_t(n * sizeof(can_filter))
+        );
     }
 
     /**
@@ -201,6 +246,40 @@ public:
     result<> set_filters(const std::vector<can_filter>& filters) {
         return set_filters(filters.data(), filters.size());
     }
+    /**
+     * Sets the filters for receiving CAN frames on this socket to accept
+     * the ID's in the set.
+     *
+     * The set is compiled into a compact list of filters, so this is
+     * better than a filter per ID when listening to a large number of
+     * ID's.
+     *
+     * @param ids The set of CAN ID's to receive.
+     * @return @em true if the filters were set, @em false otherwise.
+     */
+    result<> set_filters(const can_filter_set& ids) { return set_filters(ids.compile()); }
+
+    // ----- CAN FD -----
+
+    /**
+     * Determines if CAN FD frames are enabled on the socket.
+     * @return Whether FD frames are enabled, or the error code on failure.
+     */
+    result<bool> fd_frames() const noexcept {
+        return get_option<bool>(SOL_CAN_RAW, CAN_RAW_FD_FRAMES);
+    }
+    /**
+     * Enables or disables CAN FD frames on the socket.
+     *
+     * With FD frames enabled, the socket can send and receive both FD and
+     * classic frames, and should be read with a @ref canfd_frame, which
+     * can hold either. The interface must also be configured for FD.
+     * @param on Whether FD frames should be enabled.
+     * @return The error code on failure.
+     */
+    result<> fd_frames(bool on) noexcept {
+        return set_option(SOL_CAN_RAW, CAN_RAW_FD_FRAMES, int(on));
+    }
 
     // ----- I/O -----
 
@@ -242,7 +321,27 @@ public:
      * @return The number of bytes read or @em -1 on error.
      */
     result<size_t> recv_from(can_frame* frame, int flags, can_address* srcAddr = nullptr) {
-        return base::recv_from(frame, sizeof(frame), flags, srcAddr);
+        return base::recv_from(frame, sizeof(can_frame), flags, srcAddr);
+    }
+    /**
+     * Receives a frame from the CAN interface, along with its kernel
+     * timestamps.
+     *
+     * This gets the receive time in the same call as the frame, with
+     * nanosecond precision, rather than needing a separate
+     * @ref last_frame_time() call for each frame. Timestamps must first
+     * be enabled with @ref enable_timestamps().
+     * @param frame CAN frame to get the incoming data.
+     * @param ts Gets the timestamps of the frame.
+     * @param srcAddr Receives the address of the interface that the frame
+     *  			  arrived on, if not null.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_from(
+        can_frame* frame, packet_timestamp& ts, can_address* srcAddr = nullptr, int flags = 0
+    ) {
+        return base::recv_from(frame, sizeof(can_frame), ts, srcAddr, flags);
     }
     /**
      * Receives a message on the socket.
@@ -253,6 +352,158 @@ public:
     result<size_t> recv(can_frame* frame, int flags = 0) {
         return base::recv(frame, sizeof(can_frame), flags);
     }
+    /**
+     * Receives a frame on the socket, along with its kernel timestamps.
+     * @param frame CAN frame to get the incoming data.
+     * @param ts Gets the timestamps of the frame.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv(can_frame* frame, packet_timestamp& ts, int flags = 0) {
+        return base::recv(frame, sizeof(can_frame), ts, flags);
+    }
+
+    // ----- FD I/O -----
+
+    /**
+     * Sends an FD or classic frame to the CAN interface at the specified
+     * address.
+     * The frame is sent as an FD frame if it has the `CANFD_FDF` flag
+     * set, which requires @ref fd_frames() to be enabled.
+     * @param frame The CAN frame to send.
+     * @param flags The flags. See send(2).
+     * @param addr The remote destination of the data.
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> send_to(const canfd_frame& frame, int flags, const can_address& addr) {
+        return base::send_to(&frame, frame.mtu(), flags, addr);
+    }
+    /**
+     * Sends an FD or classic frame to the CAN interface at the specified
+     * address.
+     * @param frame The CAN frame to send.
+     * @param addr The remote destination of the data.
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> send_to(const canfd_frame& frame, const can_address& addr) {
+        return send_to(frame, 0, addr);
+    }
+    /**
+     * Sends an FD or classic frame to the CAN bus.
+     * The socket should be bound before calling this.
+     * @param frame The CAN frame to send.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> send(const canfd_frame& frame, int flags = 0) {
+        return base::send(&frame, frame.mtu(), flags);
+    }
+    /**
+     * Receives an FD or classic frame from the CAN interface.
+     * On return, the frame is an FD frame if @ref canfd_frame::is_fd() is
+     * true, which is also when the result is `CANFD_MTU` bytes.
+     * @param frame CAN frame to get the incoming data.
+     * @param flags The option bit flags. See recv(2).
+     * @param srcAddr Receives the address of the interface that the frame
+     *  			  arrived on, if not null.
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_from(canfd_frame* frame, int flags, can_address* srcAddr = nullptr) {
+        return mark_fd(frame, base::recv_from(frame, sizeof(canfd_frame), flags, srcAddr));
+    }
+    /**
+     * Receives an FD or classic frame from the CAN interface, along with
+     * its kernel timestamps.
+     * @param frame CAN frame to get the incoming data.
+     * @param ts Gets the timestamps of the frame.
+     * @param srcAddr Receives the address of the interface that the frame
+     *  			  arrived on, if not null.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_from(
+        canfd_frame* frame, packet_timestamp& ts, can_address* srcAddr = nullptr,
+        int flags = 0
+    ) {
+        auto res = base::recv_from(frame, sizeof(canfd_frame), ts, srcAddr, flags);
+        return mark_fd(frame, res);
+    }
+    /**
+     * Receives an FD or classic frame on the socket.
+     * @param frame CAN frame to get the incoming data.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv(canfd_frame* frame, int flags = 0) {
+        return mark_fd(frame, base::recv(frame, sizeof(canfd_frame), flags));
+    }
+    /**
+     * Receives an FD or classic frame on the socket, along with its kernel
+     * timestamps.
+     * @param frame CAN frame to get the incoming data.
+     * @param ts Gets the timestamps of the frame.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv(canfd_frame* frame, packet_timestamp& ts, int flags = 0) {
+        return mark_fd(frame, base::recv(frame, sizeof(canfd_frame), ts, flags));
+    }
+
+    // ----- Batched I/O -----
+
+    /**
+     * Receives a batch of frames with a single system call.
+     *
+     * On a blocking socket this waits for at least one frame to arrive,
+     * then takes any others that are immediately available, up to the
+     * size of the array. This lets a logger keep up with a busy bus
+     * without a system call for each frame.
+     * @param frames The array to get the frames.
+     * @param n The number of frames in the array.
+     * @param ts An array of @em n timestamps to get the kernel receive time
+     *  		 of each frame, or null if they're not wanted. Timestamps
+     *  		 must first be turned on with @ref enable_timestamps().
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of frames received, or the error code on failure.
+     */
+    result<size_t> recv_many(
+        can_frame* frames, size_t n, packet_timestamp* ts = nullptr, int flags = 0
+    );
+    /**
+     * Receives a batch of FD or classic frames with a single system call.
+     * This is like the batched receive of classic frames, but each frame
+     * is marked as an FD frame if that's what it was.
+     * @param frames The array to get the frames.
+     * @param n The number of frames in the array.
+     * @param ts An array of @em n timestamps to get the kernel receive time
+     *  		 of each frame, or null if they're not wanted.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of frames received, or the error code on failure.
+     */
+    result<size_t> recv_many(
+        canfd_frame* frames, size_t n, packet_timestamp* ts = nullptr, int flags = 0
+    );
+    /**
+     * Sends a batch of frames with a single system call.
+     * The socket should be bound before calling this.
+     * @param frames The frames to send.
+     * @param n The number of frames to send.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of frames sent, which may be less than @em n,
+     *         or the error code on failure.
+     */
+    result<size_t> send_many(const can_frame* frames, size_t n, int flags = 0);
+    /**
+     * Sends a batch of FD or classic frames with a single system call.
+     * Each frame goes out as an FD frame if it has the `CANFD_FDF` flag
+     * set.
+     * @param frames The frames to send.
+     * @param n The number of frames to send.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of frames sent, which may be less than @em n,
+     *         or the error code on failure.
+     */
+    result<size_t> send_many(const canfd_frame* frames, size_t n, int flags = 0);
 };
 
 /////////////////////////////////////////////////////////////////////////////
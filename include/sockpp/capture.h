@@ -0,0 +1,463 @@
+/**
+ * @file capture.h
+ *
+ * Memory-mapped packet capture and replay for message sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_capture_h
+#define __sockpp_capture_h
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sockpp/datagram_socket.h"
+#include "sockpp/raw_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The kind of packets in a capture.
+ * These are the pcap link types, which tell a reader like Wireshark how to
+ * decode the data.
+ */
+enum class capture_link : uint16_t {
+    /** Whole IPv4 or IPv6 packets, as read from a raw IP socket */
+    ip = 101,
+    /** Datagram payloads without any headers, as read from a UDP socket */
+    payload = 147,
+    /** Linux SocketCAN frames, classic or FD */
+    socketcan = 227
+};
+
+/**
+ * A packet read back from a capture.
+ */
+struct capture_record
+{
+    /** The time the packet was captured, since the epoch */
+    nanoseconds time{0};
+    /** The captured data, which may be truncated to the snapshot length */
+    std::string_view data;
+    /** The original length of the packet */
+    uint32_t origLen{0};
+    /** The kind of packet */
+    capture_link link{capture_link::payload};
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Records packets to a capture file in the pcapng format.
+ *
+ * The file is memory-mapped and grown in large chunks, so that adding a
+ * packet is usually just a copy into the page cache, with no system call.
+ * The kernel writes the pages out in the background. When the writer is
+ * closed, the file is cut back to the size of the data.
+ *
+ * Each file has one interface, of a single link type, and the timestamps
+ * have nanosecond resolution. The packets are normally stamped with the
+ * kernel receive time of a @ref socket::packet_timestamp, or, failing
+ * that, the time they're written.
+ *
+ * This is only available on POSIX systems.
+ */
+class capture_writer
+{
+    /** The file descriptor */
+    int fd_{-1};
+    /** The mapped file */
+    char* base_{nullptr};
+    /** The size of the mapping (and the file) */
+    size_t mapSize_{0};
+    /** The number of bytes written */
+    size_t size_{0};
+    /** The number of packets written */
+    size_t count_{0};
+    /** The amount to grow the file at a time */
+    size_t chunkSize_{DFLT_CHUNK_SIZE};
+    /** The most bytes to keep from each packet */
+    size_t snapLen_{0};
+    /** The kind of packets */
+    capture_link link_{capture_link::payload};
+
+    /** Makes room for n more bytes in the map */
+    result<> reserve(size_t n);
+
+    // Non-copyable
+    capture_writer(const capture_writer&) = delete;
+    capture_writer& operator=(const capture_writer&) = delete;
+
+public:
+    /** The default amount to grow the file at a time */
+    static constexpr size_t DFLT_CHUNK_SIZE = 4 * 1024 * 1024;
+    /** The default snapshot length, which keeps any packet whole */
+    static constexpr size_t DFLT_SNAP_LEN = 256 * 1024;
+
+    /**
+     * Creates a writer that isn't open.
+     */
+    capture_writer() = default;
+    /**
+     * Creates a new capture file, replacing any file with the same name.
+     * @param path The name of the file.
+     * @param link The kind of packets that will be written.
+     * @param snapLen The most bytes to keep from each packet.
+     * @param chunkSize The amount to grow the file at a time.
+     * @throws std::system_error if the file can't be created.
+     */
+    capture_writer(
+        const std::string& path, capture_link link, size_t snapLen = DFLT_SNAP_LEN,
+        size_t chunkSize = DFLT_CHUNK_SIZE
+    );
+    /**
+     * Creates a new capture file, replacing any file with the same name.
+     * @param path The name of the file.
+     * @param link The kind of packets that will be written.
+     * @param ec Gets the error code on failure. It's left untouched on
+     *  		 success.
+     */
+    capture_writer(const std::string& path, capture_link link, error_code& ec) noexcept;
+    /**
+     * Destructor closes the file.
+     */
+    ~capture_writer() { close(); }
+    /**
+     * Creates a new capture file, replacing any file with the same name.
+     * Any file that was open is closed first.
+     * @param path The name of the file.
+     * @param link The kind of packets that will be written.
+     * @param snapLen The most bytes to keep from each packet.
+     * @param chunkSize The amount to grow the file at a time.
+     * @return The error code on failure.
+     */
+    result<> open(
+        const std::string& path, capture_link link, size_t snapLen = DFLT_SNAP_LEN,
+        size_t chunkSize = DFLT_CHUNK_SIZE
+    ) noexcept;
+    /**
+     * Determines if the file is open.
+     * @return @em true if the file is open.
+     */
+    bool is_open() const noexcept { return base_ != nullptr; }
+    /**
+     * Gets the kind of packets in the capture.
+     * @return The kind of packets in the capture.
+     */
+    capture_link link() const noexcept { return link_; }
+    /**
+     * Adds a packet to the capture.
+     * @param data The packet.
+     * @param n The size of the packet.
+     * @param time The time the packet was received, since the epoch. If
+     *  		   zero, the current time is used.
+     * @return The error code on failure.
+     */
+    result<> write(const void* data, size_t n, nanoseconds time = nanoseconds{0}) noexcept;
+    /**
+     * Adds a packet to the capture, stamped with its kernel receive time.
+     * @param data The packet.
+     * @param n The size of the packet.
+     * @param ts The timestamp from the receive. The current time is used
+     *  		 if it has no software timestamp.
+     * @return The error code on failure.
+     */
+    result<> write(const void* data, size_t n, const socket::packet_timestamp& ts) noexcept {
+        return write(data, n, ts.software);
+    }
+    /**
+     * Adds a batch of packets to the capture, as returned from
+     * @ref datagram_socket::recv_many().
+     * @param bufs The buffers that got the packets.
+     * @param lens The length of each packet.
+     * @param n The number of packets.
+     * @param ts An array of @em n timestamps, or null to use the current
+     *  		 time for all of them.
+     * @return The number of packets written. This is less than @em n only
+     *  	   if the file couldn't be grown, in which case the error is
+     *  	   returned if nothing was written.
+     */
+    result<size_t> write_many(
+        const iovec* bufs, const size_t* lens, size_t n,
+        const socket::packet_timestamp* ts = nullptr
+    ) noexcept;
+    /**
+     * Gets the number of bytes in the capture.
+     * @return The number of bytes in the capture.
+     */
+    size_t size() const noexcept { return size_; }
+    /**
+     * Gets the number of packets in the capture.
+     * @return The number of packets in the capture.
+     */
+    size_t count() const noexcept { return count_; }
+    /**
+     * Starts writing the captured data to disk, without waiting for it.
+     * @return The error code on failure.
+     */
+    result<> flush() noexcept;
+    /**
+     * Closes the file, cutting it to the size of the data.
+     * @return The error code on failure.
+     */
+    result<> close() noexcept;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reads the packets from a pcapng capture file.
+ *
+ * The whole file is memory-mapped, and the packets are read in place,
+ * without any copying. This reads the captures made by a
+ * @ref capture_writer, and those from most other tools, like Wireshark or
+ * tcpdump, in either byte order.
+ *
+ * This is only available on POSIX systems.
+ */
+class capture_reader
+{
+    /** A capture interface, as described in the file */
+    struct iface
+    {
+        /** The kind of packets */
+        capture_link link;
+        /** The timestamp resolution option */
+        uint8_t tsresol;
+    };
+
+    /** The mapped file */
+    const char* base_{nullptr};
+    /** The size of the file */
+    size_t size_{0};
+    /** The offset of the next block */
+    size_t pos_{0};
+    /** Whether the current section is in the other byte order */
+    bool swap_{false};
+    /** The interfaces in the current section */
+    std::vector<iface> ifaces_;
+    /** A SocketCAN frame, converted back to host byte order */
+    char frame_[72];
+
+    /** Reads a 16-bit value from the file */
+    uint16_t get16(size_t off) const noexcept;
+    /** Reads a 32-bit value from the file */
+    uint32_t get32(size_t off) const noexcept;
+    /** Reads the headers up to the next packet */
+    result<> read_headers() noexcept;
+
+    // Non-copyable
+    capture_reader(const capture_reader&) = delete;
+    capture_reader& operator=(const capture_reader&) = delete;
+
+public:
+    /**
+     * Creates a reader that isn't open.
+     */
+    capture_reader() = default;
+    /**
+     * Opens a capture file.
+     * @param path The name of the file.
+     * @throws std::system_error if the file can't be opened.
+     */
+    explicit capture_reader(const std::string& path);
+    /**
+     * Opens a capture file.
+     * @param path The name of the file.
+     * @param ec Gets the error code on failure. It's left untouched on
+     *  		 success.
+     */
+    capture_reader(const std::string& path, error_code& ec) noexcept;
+    /**
+     * Destructor closes the file.
+     */
+    ~capture_reader() { close(); }
+    /**
+     * Opens a capture file.
+     * Any file that was open is closed first.
+     * @param path The name of the file.
+     * @return The error code on failure, or @ref errc::bad_message if it
+     *  	   isn't a pcapng file.
+     */
+    result<> open(const std::string& path) noexcept;
+    /**
+     * Determines if the file is open.
+     * @return @em true if the file is open.
+     */
+    bool is_open() const noexcept { return base_ != nullptr; }
+    /**
+     * Gets the kind of packets on the first interface of the capture.
+     * This is the kind of all the packets in a capture from a
+     * @ref capture_writer.
+     * @return The kind of packets in the capture.
+     */
+    capture_link link() const noexcept {
+        return ifaces_.empty() ? capture_link::payload : ifaces_[0].link;
+    }
+    /**
+     * Reads the next packet.
+     * The data stays valid until the reader is closed, except that of a
+     * SocketCAN frame, which is only valid until the next read. The file
+     * stores the frame's ID in network byte order, so it's converted into
+     * a buffer in the reader.
+     * @param rec Gets the packet.
+     * @return @em true if a packet was read, @em false at the end of the
+     *  	   file, or @ref errc::bad_message if the file is corrupt.
+     */
+    result<bool> next(capture_record& rec) noexcept;
+    /**
+     * Goes back to the first packet.
+     */
+    void rewind() noexcept;
+    /**
+     * Closes the file.
+     */
+    void close() noexcept;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Replays the packets from a capture out of a socket.
+ *
+ * The packets are sent in batches, with the batched sends of the sockets,
+ * to reproduce the load that was captured. By default they're sent with
+ * their original timing, but the replay can be sped up or slowed down,
+ * long idle gaps can be cut short, or the packets can be sent as fast as
+ * the socket takes them.
+ *
+ * Each batch starts with the next packet that's due, and takes any
+ * others that are due by then. So with the original timing, bursts go out
+ * together, and quiet periods send one packet at a time.
+ *
+ * This is only available on POSIX systems.
+ */
+class capture_replayer
+{
+public:
+    /**
+     * A function that sends a batch of packets, like
+     * @ref datagram_socket::send_many().
+     */
+    using sink_type = std::function<result<size_t>(const iovec* bufs, size_t n)>;
+
+    /** The default number of packets to send at a time */
+    static constexpr size_t DFLT_BATCH_SIZE = 32;
+
+private:
+    /** The capture */
+    capture_reader& rdr_;
+    /** The speed of the replay */
+    double speed_{1.0};
+    /** The longest gap to keep between packets, or zero to keep them all */
+    nanoseconds maxGap_{0};
+    /** The most packets to send at a time */
+    size_t batchSize_;
+    /** A copy of the packets that aren't stable in the reader */
+    std::vector<char> stage_;
+
+    // Non-copyable
+    capture_replayer(const capture_replayer&) = delete;
+    capture_replayer& operator=(const capture_replayer&) = delete;
+
+public:
+    /**
+     * Creates a replayer for a capture.
+     * @param rdr The capture. It must outlive the replayer.
+     * @param batchSize The most packets to send at a time.
+     */
+    explicit capture_replayer(capture_reader& rdr, size_t batchSize = DFLT_BATCH_SIZE)
+        : rdr_{rdr}, batchSize_{batchSize ? batchSize : 1} {}
+    /**
+     * Sets the speed of the replay.
+     * @param speed How much faster than real time to send the packets,
+     *  			like 2.0 for twice as fast. Zero or less sends them as
+     *  			fast as possible.
+     */
+    void speed(double speed) noexcept { speed_ = speed; }
+    /**
+     * Gets the speed of the replay.
+     * @return How much faster than real time the packets are sent, or zero
+     *  	   or less if they're sent as fast as possible.
+     */
+    double speed() const noexcept { return speed_; }
+    /**
+     * Cuts short the long gaps between packets.
+     * This is applied before the speed.
+     * @param gap The longest gap to keep, or zero to keep them all.
+     */
+    void max_gap(nanoseconds gap) noexcept { maxGap_ = gap; }
+    /**
+     * Sends the rest of the packets in the capture to a function.
+     * @param sink The function that sends each batch.
+     * @return The number of packets sent, or the first error from the
+     *  	   capture or the sink.
+     */
+    result<size_t> run(const sink_type& sink);
+    /**
+     * Sends the rest of the packets in the capture out of a connected
+     * datagram socket.
+     * @param sock The socket.
+     * @return The number of packets sent, or the first error.
+     */
+    result<size_t> run(datagram_socket& sock) {
+        return run([&sock](const iovec* bufs, size_t n) { return sock.send_many(bufs, n); });
+    }
+    /**
+     * Sends the rest of the packets in the capture out of a raw socket,
+     * such as a connected raw IP socket or a bound CAN socket. On Linux,
+     * each batch is sent with a single system call.
+     * @param sock The socket.
+     * @return The number of packets sent, or the first error.
+     */
+    result<size_t> run(raw_socket& sock);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_capture_h
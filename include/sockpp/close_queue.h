@@ -0,0 +1,168 @@
+/**
+ * @file close_queue.h
+ *
+ * Deferred, batched closing of socket handles.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_close_queue_h
+#define __sockpp_close_queue_h
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "sockpp/socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A queue of socket handles waiting to be closed.
+ *
+ * Destroying a socket closes its handle right away, which is a system call
+ * per socket, and can block in the kernel if the socket is set to linger
+ * with unsent data. A server with a lot of connection churn can instead
+ * hand its finished sockets to a close queue, which closes them later, in
+ * a batch.
+ *
+ * The queue runs in one of two modes. By default, the handles are held
+ * until the owner calls @ref flush(), typically once per iteration of its
+ * event loop, such as from the @ref reactor::on_tick() handler. In the
+ * background mode, the queue has its own thread that closes handles soon
+ * after they arrive, so that a slow close never stalls the event loop.
+ * Either way, anything left in the queue is closed when it's destroyed.
+ *
+ * A socket passed to @ref defer() gives up its handle, in the same way as
+ * @ref socket::release(), so the socket object is left closed and the
+ * queue becomes the sole owner of the handle. Each handle is closed
+ * exactly once, by the queue. The caller must remove the socket from any
+ * poller or reactor before deferring it, since the kernel can reuse the
+ * handle number as soon as it is actually closed.
+ *
+ * On Linux, the handles can also be taken out of the queue with
+ * @ref take(), and closed with asynchronous io_uring operations.
+ *
+ * Deferring and flushing are thread safe.
+ */
+class close_queue
+{
+    /** Lock for the pending handles */
+    mutable std::mutex lock_;
+    /** Signals the background thread that there's work to do */
+    std::condition_variable cv_;
+    /** The handles waiting to be closed */
+    std::vector<socket_t> pending_;
+    /** The total number of handles closed by the queue */
+    size_t nclosed_{0};
+    /** Whether the background thread should exit */
+    bool quit_{false};
+    /** The background thread, if any */
+    std::thread thr_;
+
+    // Non-copyable
+    close_queue(const close_queue&) = delete;
+    close_queue& operator=(const close_queue&) = delete;
+
+    /** Closes a batch of handles and counts them */
+    size_t close_all(const std::vector<socket_t>& handles);
+    /** The background thread function */
+    void run();
+
+public:
+    /**
+     * Creates a close queue.
+     * @param background Whether to close the handles on a background
+     *  				 thread. If @em false, they are held until @ref
+     *  				 flush() is called.
+     */
+    explicit close_queue(bool background = false);
+    /**
+     * Destructor closes any handles still in the queue, and stops the
+     * background thread, if any.
+     */
+    ~close_queue();
+    /**
+     * Determines if the queue closes handles on a background thread.
+     */
+    bool background() const { return thr_.joinable(); }
+    /**
+     * Takes the handle from a socket and queues it to be closed.
+     * On return, the socket no longer owns a handle.
+     * @param sock The socket to close.
+     */
+    void defer(socket&& sock) { defer(sock.release()); }
+    /**
+     * Queues a socket handle to be closed.
+     * The queue takes ownership of the handle. An invalid handle is
+     * ignored.
+     * @param h The handle to close.
+     */
+    void defer(socket_t h);
+    /**
+     * Closes all the handles in the queue, on the calling thread.
+     * @return The number of handles closed.
+     */
+    size_t flush();
+    /**
+     * Removes all the handles from the queue without closing them.
+     * The caller takes over ownership of the handles, as with @ref
+     * socket::release(), and must close each of them.
+     * @return The handles that were in the queue.
+     */
+    std::vector<socket_t> take();
+    /**
+     * Gets the number of handles waiting to be closed.
+     */
+    size_t pending() const;
+    /**
+     * Gets the total number of handles that the queue closed.
+     */
+    size_t closed() const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_close_queue_h
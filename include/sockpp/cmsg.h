@@ -0,0 +1,315 @@
+/**
+ * @file cmsg.h
+ *
+ * Fixed-capacity builder and parser for socket ancillary (control) data.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_cmsg_h
+#define __sockpp_cmsg_h
+
+#include <cstring>
+
+#include "sockpp/platform.h"
+
+#if !defined(_WIN32)
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A buffer for building the ancillary data to send with a message.
+ *
+ * This holds the control messages in a fixed-size array, so it can be
+ * placed on the stack and never allocates from the heap. The capacity is
+ * in bytes, and should account for the header and padding of each
+ * message, as given by the system's CMSG_SPACE() macro.
+ *
+ * @tparam N The capacity of the buffer, in bytes.
+ */
+template <size_t N>
+class cmsg_buffer
+{
+    /** The storage for the control messages */
+    alignas(cmsghdr) char buf_[N]{};
+    /** The number of bytes currently in use */
+    size_t len_{0};
+    /** The message flags from the last receive into the buffer */
+    int msgFlags_{0};
+
+public:
+    /**
+     * Creates an empty buffer.
+     */
+    cmsg_buffer() noexcept = default;
+    /**
+     * Gets a pointer to the start of the control data.
+     * @return A pointer to the start of the control data.
+     */
+    void* data() noexcept { return buf_; }
+    /**
+     * Gets a pointer to the start of the control data.
+     * @return A pointer to the start of the control data.
+     */
+    const void* data() const noexcept { return buf_; }
+    /**
+     * Gets the number of bytes of control data in the buffer.
+     * @return The number of bytes of control data in the buffer.
+     */
+    size_t size() const noexcept { return len_; }
+    /**
+     * Gets the total capacity of the buffer, in bytes.
+     * @return The total capacity of the buffer, in bytes.
+     */
+    static constexpr size_t capacity() noexcept { return N; }
+    /**
+     * Determines if the buffer has no control messages.
+     * @return @em true if the buffer is empty.
+     */
+    bool empty() const noexcept { return len_ == 0; }
+    /**
+     * Removes all of the control messages from the buffer.
+     */
+    void clear() noexcept {
+        len_ = 0;
+        msgFlags_ = 0;
+    }
+    /**
+     * Marks the amount of control data that was received into the
+     * buffer. This is called by socket::recv_msg().
+     * @param n The number of bytes of control data received.
+     * @param msgFlags The flags for the received message.
+     */
+    void received(size_t n, int msgFlags) noexcept {
+        len_ = (n < N) ? n : N;
+        msgFlags_ = msgFlags;
+    }
+    /**
+     * Gets the flags for the message that was last received into the
+     * buffer, such as `MSG_TRUNC` or `MSG_CTRUNC`.
+     * @return The flags for the received message.
+     */
+    int msg_flags() const noexcept { return msgFlags_; }
+    /**
+     * Appends a control message to the buffer.
+     * @param level The protocol level of the message (SOL_SOCKET, etc).
+     * @param type The protocol-specific type of the message.
+     * @param data The payload of the message.
+     * @param n The size of the payload, in bytes.
+     * @return @em true if the message was added, @em false if there was
+     *  	   not enough room for it.
+     */
+    bool add(int level, int type, const void* data, size_t n) noexcept {
+        size_t sz = CMSG_SPACE(n);
+        if (len_ + sz > N)
+            return false;
+
+        auto hdr = reinterpret_cast<cmsghdr*>(buf_ + len_);
+        std::memset(hdr, 0, sz);
+        hdr->cmsg_level = level;
+        hdr->cmsg_type = type;
+        hdr->cmsg_len = CMSG_LEN(n);
+        std::memcpy(CMSG_DATA(hdr), data, n);
+        len_ += sz;
+        return true;
+    }
+    /**
+     * Appends a control message with a trivially-copyable payload.
+     * @param level The protocol level of the message (SOL_SOCKET, etc).
+     * @param type The protocol-specific type of the message.
+     * @param val The payload of the message.
+     * @return @em true if the message was added, @em false if there was
+     *  	   not enough room for it.
+     */
+    template <typename T>
+    bool add(int level, int type, const T& val) noexcept {
+        return add(level, type, &val, sizeof(T));
+    }
+    /**
+     * Appends a set of file descriptors to pass to the peer of a UNIX
+     * domain socket (`SCM_RIGHTS`).
+     * @param fds The file descriptors.
+     * @param n The number of descriptors.
+     * @return @em true if the message was added, @em false if there was
+     *  	   not enough room for it.
+     */
+    bool add_fds(const int* fds, size_t n) noexcept {
+        return add(SOL_SOCKET, SCM_RIGHTS, fds, n * sizeof(int));
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A read-only view of the ancillary data received with a message.
+ *
+ * This walks the control messages in a received message header without
+ * copying them. The payloads are copied out on request, since the data in
+ * the control buffer is not necessarily aligned for the payload type.
+ */
+class cmsg_reader
+{
+    /** A message header for the control data (only) */
+    msghdr msg_{};
+
+public:
+    /**
+     * Creates a reader for the control data in a received message.
+     * @param msg The message header, as filled in by recvmsg().
+     */
+    explicit cmsg_reader(const msghdr& msg) noexcept
+        : cmsg_reader{msg.msg_control, size_t(msg.msg_controllen), msg.msg_flags} {}
+    /**
+     * Creates a reader for a buffer of control data.
+     * @param ctrl The control data.
+     * @param n The size of the control data, in bytes.
+     * @param msgFlags The flags for the received message.
+     */
+    cmsg_reader(const void* ctrl, size_t n, int msgFlags = 0) noexcept {
+        msg_.msg_control = const_cast<void*>(ctrl);
+        msg_.msg_controllen = n;
+        msg_.msg_flags = msgFlags;
+    }
+    /**
+     * Creates a reader for the control data received into a buffer.
+     * @param buf The buffer, as filled in by socket::recv_msg().
+     */
+    template <size_t N>
+    explicit cmsg_reader(const cmsg_buffer<N>& buf) noexcept
+        : cmsg_reader{buf.data(), buf.size(), buf.msg_flags()} {}
+    /**
+     * Gets the first control message.
+     * @return The first control message, or @em nullptr if there are none.
+     */
+    const cmsghdr* first() const noexcept { return CMSG_FIRSTHDR(&msg_); }
+    /**
+     * Gets the control message that follows another.
+     * @param cmsg A control message in this buffer.
+     * @return The next control message, or @em nullptr if there are no
+     *  	   more.
+     */
+    const cmsghdr* next(const cmsghdr* cmsg) const noexcept {
+        return CMSG_NXTHDR(const_cast<msghdr*>(&msg_), const_cast<cmsghdr*>(cmsg));
+    }
+    /**
+     * Determines if the control data was truncated because the buffer
+     * supplied to recvmsg() was too small.
+     * @return @em true if the control data was truncated.
+     */
+    bool truncated() const noexcept { return (msg_.msg_flags & MSG_CTRUNC) != 0; }
+    /**
+     * Finds the first control message with the specified level and type.
+     * @param level The protocol level of the message (SOL_SOCKET, etc).
+     * @param type The protocol-specific type of the message.
+     * @return A pointer to the message, or @em nullptr if not found.
+     */
+    const cmsghdr* find(int level, int type) const noexcept {
+        for (auto cmsg = first(); cmsg; cmsg = next(cmsg)) {
+            if (cmsg->cmsg_level == level && cmsg->cmsg_type == type)
+                return cmsg;
+        }
+        return nullptr;
+    }
+    /**
+     * Gets the size of the payload of a control message.
+     * @param cmsg A control message.
+     * @return The size of the payload, in bytes.
+     */
+    static size_t payload_size(const cmsghdr* cmsg) noexcept {
+        return size_t(cmsg->cmsg_len) - CMSG_LEN(0);
+    }
+    /**
+     * Gets the payload of the first control message with the specified
+     * level and type.
+     * @param level The protocol level of the message (SOL_SOCKET, etc).
+     * @param type The protocol-specific type of the message.
+     * @param val Gets the payload of the message, if found.
+     * @return @em true if the message was found and its payload was large
+     *  	   enough to fill the value, @em false otherwise.
+     */
+    template <typename T>
+    bool get(int level, int type, T& val) const noexcept {
+        auto cmsg = find(level, type);
+        if (!cmsg || payload_size(cmsg) < sizeof(T))
+            return false;
+        std::memcpy(&val, CMSG_DATA(cmsg), sizeof(T));
+        return true;
+    }
+    /**
+     * Gets the file descriptors passed by the peer of a UNIX domain
+     * socket (`SCM_RIGHTS`).
+     *
+     * The received descriptors are open in this process, so any that
+     * don't fit in the array are closed, rather than leaked.
+     * @param fds Array to get the file descriptors.
+     * @param n The maximum number of descriptors to get.
+     * @return The number of descriptors placed in the array.
+     */
+    size_t get_fds(int* fds, size_t n) const noexcept {
+        size_t nfd = 0;
+        for (auto cmsg = first(); cmsg; cmsg = next(cmsg)) {
+            if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+                continue;
+
+            auto p = reinterpret_cast<const char*>(CMSG_DATA(cmsg));
+            size_t cnt = payload_size(cmsg) / sizeof(int);
+
+            for (size_t i = 0; i < cnt; ++i) {
+                int fd;
+                std::memcpy(&fd, p + i * sizeof(int), sizeof(int));
+                if (nfd < n)
+                    fds[nfd++] = fd;
+                else
+                    ::close(fd);
+            }
+        }
+        return nfd;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // !_WIN32
+
+#endif  // __sockpp_cmsg_h
@@ -0,0 +1,449 @@
+/**
+ * @file connection_pool.h
+ *
+ * A pool of reusable client connections to a set of servers.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_connection_pool_h
+#define __sockpp_connection_pool_h
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "sockpp/tcp_connector.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A pool of client connections, kept open for reuse, to any number of
+ * servers.
+ *
+ * A connection is checked out with @ref acquire(), which returns a
+ * @ref lease on it. When the lease is destroyed, the connection goes back
+ * to the pool to be reused by the next request for the same server. If
+ * there's no idle connection for the server, a new one is made.
+ *
+ * The idle connections for each server are kept most-recently-used first,
+ * so the busy connections stay warm and the extras age out. Before one is
+ * handed out, it's checked with a non-blocking peek
+ * (@ref stream_socket::is_idle_alive()), and dropped if the server closed
+ * it in the meantime.
+ *
+ * The pool limits the number of connections to each server, counting the
+ * ones leased out, and the number it keeps idle. Idle connections past
+ * the idle timeout are closed by @ref evict_idle(), which the application
+ * should call periodically, such as from a @ref timer_wheel timer or a
+ * housekeeping thread.
+ *
+ * The pool is thread safe. The servers are spread over a number of
+ * shards, each with its own lock, so threads using different servers
+ * rarely contend. No lock is held while connecting, peeking, or closing.
+ *
+ * The pool must outlive all of its leases.
+ *
+ * @tparam CONNECTOR The type of connector, like @ref tcp_connector. Its
+ *  				 address type needs a std::hash.
+ */
+template <typename CONNECTOR = tcp_connector>
+class connection_pool
+{
+public:
+    /** The type of connection in the pool */
+    using connector_t = CONNECTOR;
+    /** The type of address of the servers */
+    using addr_t = typename CONNECTOR::addr_t;
+    /** The clock used for the idle timeouts */
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * The limits and timeouts for the pool.
+     */
+    struct options
+    {
+        /** The most connections to a single server, idle or leased */
+        size_t max_per_host = 64;
+        /** The most idle connections kept for a single server */
+        size_t max_idle_per_host = 16;
+        /** How long a connection can be idle before it's evicted */
+        milliseconds idle_timeout{60000};
+        /** The time allowed to make a new connection */
+        milliseconds connect_timeout{5000};
+        /** The number of independently-locked shards */
+        size_t shards = 16;
+    };
+
+    /**
+     * A connection checked out from the pool.
+     *
+     * This is move-only. When it's destroyed or released, the connection
+     * is returned to the pool, unless it was discarded or closed.
+     */
+    class lease
+    {
+        /** The pool, or null if the lease is empty */
+        connection_pool* pool_{nullptr};
+        /** The server address */
+        addr_t addr_{};
+        /** The connection */
+        connector_t conn_{};
+        /** Whether the connection can go back to the pool */
+        bool reuse_{true};
+
+        friend class connection_pool;
+
+        lease(connection_pool* pool, const addr_t& addr, connector_t&& conn)
+            : pool_{pool}, addr_{addr}, conn_{std::move(conn)} {}
+
+    public:
+        /**
+         * Creates an empty lease.
+         */
+        lease() = default;
+        /**
+         * Move constructor.
+         * @param other The lease to move into this one.
+         */
+        lease(lease&& other)
+            : pool_{other.pool_},
+              addr_{other.addr_},
+              conn_{std::move(other.conn_)},
+              reuse_{other.reuse_} {
+            other.pool_ = nullptr;
+        }
+        /**
+         * Returns the connection to the pool.
+         */
+        ~lease() { release(); }
+        /**
+         * Move assignment.
+         * Any connection already held is returned to the pool first.
+         * @param rhs The lease to move into this one.
+         * @return A reference to this object.
+         */
+        lease& operator=(lease&& rhs) {
+            if (&rhs != this) {
+                release();
+                pool_ = rhs.pool_;
+                addr_ = rhs.addr_;
+                conn_ = std::move(rhs.conn_);
+                reuse_ = rhs.reuse_;
+                rhs.pool_ = nullptr;
+            }
+            return *this;
+        }
+        /**
+         * Determines if the lease holds a connection.
+         * @return @em true if the lease holds a connection.
+         */
+        explicit operator bool() const { return pool_ != nullptr; }
+        /**
+         * Gets the address of the server.
+         * @return The address of the server.
+         */
+        const addr_t& address() const { return addr_; }
+        /**
+         * Gets the connection.
+         * @return A reference to the connection.
+         */
+        connector_t& get() { return conn_; }
+        /**
+         * Gets the connection.
+         * @return A reference to the connection.
+         */
+        connector_t& operator*() { return conn_; }
+        /**
+         * Accesses the connection.
+         * @return A pointer to the connection.
+         */
+        connector_t* operator->() { return &conn_; }
+        /**
+         * Marks the connection so that it won't be returned to the pool.
+         * This should be used when the connection is left in an unknown
+         * state, like after a protocol error or a timeout.
+         */
+        void discard() { reuse_ = false; }
+        /**
+         * Returns the connection to the pool now, leaving the lease empty.
+         */
+        void release() {
+            if (pool_) {
+                pool_->give_back(addr_, conn_, reuse_ && conn_.is_open());
+                pool_ = nullptr;
+                if (conn_.is_open())
+                    conn_.close();
+            }
+        }
+    };
+
+private:
+    /** A connection waiting to be reused */
+    struct idle_conn
+    {
+        connector_t conn;
+        clock::time_point since;
+    };
+
+    /** The connections to one server */
+    struct endpoint
+    {
+        /** The idle connections, oldest first */
+        std::vector<idle_conn> idle;
+        /** The number of connections, idle or leased */
+        size_t nlive{0};
+    };
+
+    /** A group of servers under a single lock */
+    struct shard
+    {
+        std::mutex mtx;
+        std::unordered_map<addr_t, endpoint> eps;
+    };
+
+    /** The limits and timeouts */
+    options opts_;
+    /** The shards */
+    std::vector<std::unique_ptr<shard>> shards_;
+
+    // Non-copyable
+    connection_pool(const connection_pool&) = delete;
+    connection_pool& operator=(const connection_pool&) = delete;
+
+    /** Gets the shard for a server */
+    shard& shard_for(const addr_t& addr) {
+        return *shards_[std::hash<addr_t>{}(addr) % shards_.size()];
+    }
+
+    /** Releases a reserved connection slot for a server */
+    void drop(const addr_t& addr) {
+        auto& sh = shard_for(addr);
+        std::lock_guard<std::mutex> lk{sh.mtx};
+        --sh.eps[addr].nlive;
+    }
+
+    /**
+     * Takes back a connection. If it's reused, it's moved out of @a conn,
+     * otherwise the caller closes it.
+     */
+    void give_back(const addr_t& addr, connector_t& conn, bool reuse) {
+        auto& sh = shard_for(addr);
+        std::lock_guard<std::mutex> lk{sh.mtx};
+        auto& ep = sh.eps[addr];
+
+        if (reuse && ep.idle.size() < opts_.max_idle_per_host)
+            ep.idle.push_back(idle_conn{std::move(conn), clock::now()});
+        else
+            --ep.nlive;
+    }
+
+public:
+    /**
+     * Creates a connection pool.
+     * @param opts The limits and timeouts for the pool.
+     */
+    explicit connection_pool(const options& opts = options{}) : opts_{opts} {
+        auto n = std::max<size_t>(opts_.shards, 1);
+        for (size_t i = 0; i < n; ++i) shards_.push_back(std::make_unique<shard>());
+    }
+    /**
+     * Gets the limits and timeouts for the pool.
+     * @return The limits and timeouts for the pool.
+     */
+    const options& opts() const { return opts_; }
+    /**
+     * Checks out a connection to a server.
+     *
+     * This reuses the most recently returned idle connection to the
+     * server that's still alive, or makes a new one.
+     *
+     * @param addr The address of the server.
+     * @return A lease on the connection, or the error code on failure.
+     *  	   This is `errc::resource_unavailable_try_again` if the
+     *  	   server already has the maximum number of connections.
+     */
+    result<lease> acquire(const addr_t& addr) {
+        auto& sh = shard_for(addr);
+
+        while (true) {
+            connector_t conn;
+            {
+                std::lock_guard<std::mutex> lk{sh.mtx};
+                auto& ep = sh.eps[addr];
+
+                if (ep.idle.empty()) {
+                    if (ep.nlive >= opts_.max_per_host)
+                        return errc::resource_unavailable_try_again;
+                    ++ep.nlive;
+                    break;
+                }
+
+                conn = std::move(ep.idle.back().conn);
+                ep.idle.pop_back();
+            }
+
+            if (conn.is_idle_alive())
+                return lease{this, addr, std::move(conn)};
+
+            conn.close();
+            drop(addr);
+        }
+
+        // A new connection, in the slot reserved above
+        connector_t conn;
+        if (auto res = conn.connect(addr, opts_.connect_timeout); !res) {
+            drop(addr);
+            return res.error();
+        }
+        return lease{this, addr, std::move(conn)};
+    }
+    /**
+     * Opens idle connections to servers ahead of time.
+     *
+     * This connects to all the servers in parallel with non-blocking
+     * connects, and waits up to the connect timeout for them. Each server
+     * gets up to @a n idle connections, within the pool's limits.
+     *
+     * @param addrs The addresses of the servers.
+     * @param n The number of idle connections for each server.
+     * @return The number of connections that were made.
+     */
+    size_t prewarm(const std::vector<addr_t>& addrs, size_t n) {
+        std::vector<addr_t> targets;
+
+        for (const auto& addr : addrs) {
+            auto& sh = shard_for(addr);
+            std::lock_guard<std::mutex> lk{sh.mtx};
+            auto& ep = sh.eps[addr];
+
+            auto nroom = std::min(
+                opts_.max_per_host - std::min(ep.nlive, opts_.max_per_host),
+                opts_.max_idle_per_host - std::min(ep.idle.size(), opts_.max_idle_per_host)
+            );
+            auto k = std::min(n, nroom);
+            ep.nlive += k;
+            targets.insert(targets.end(), k, addr);
+        }
+
+        auto conns = connector_t::connect_many(targets, opts_.connect_timeout);
+
+        size_t nconn = 0;
+        for (size_t i = 0; i < conns.size(); ++i) {
+            if (conns[i]) {
+                auto conn = conns[i].release();
+                give_back(targets[i], conn, true);
+                ++nconn;
+            }
+            else {
+                drop(targets[i]);
+            }
+        }
+        return nconn;
+    }
+    /**
+     * Closes the idle connections that have been idle too long.
+     * @param now The current time.
+     * @return The number of connections that were closed.
+     */
+    size_t evict_idle(clock::time_point now = clock::now()) {
+        std::vector<connector_t> victims;
+
+        for (auto& psh : shards_) {
+            std::lock_guard<std::mutex> lk{psh->mtx};
+
+            for (auto it = psh->eps.begin(); it != psh->eps.end();) {
+                auto& ep = it->second;
+
+                // The oldest are at the front
+                auto end = std::find_if(ep.idle.begin(), ep.idle.end(), [&](const idle_conn& ic) {
+                    return now - ic.since < opts_.idle_timeout;
+                });
+
+                for (auto ic = ep.idle.begin(); ic != end; ++ic)
+                    victims.push_back(std::move(ic->conn));
+
+                ep.nlive -= size_t(end - ep.idle.begin());
+                ep.idle.erase(ep.idle.begin(), end);
+
+                if (ep.nlive == 0)
+                    it = psh->eps.erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        // The connections close here, outside the locks
+        return victims.size();
+    }
+    /**
+     * Gets the number of idle connections to a server.
+     * @param addr The address of the server.
+     * @return The number of idle connections to the server.
+     */
+    size_t idle_count(const addr_t& addr) {
+        auto& sh = shard_for(addr);
+        std::lock_guard<std::mutex> lk{sh.mtx};
+        auto it = sh.eps.find(addr);
+        return (it == sh.eps.end()) ? 0 : it->second.idle.size();
+    }
+    /**
+     * Gets the number of connections to a server, idle or leased.
+     * @param addr The address of the server.
+     * @return The number of connections to the server.
+     */
+    size_t live_count(const addr_t& addr) {
+        auto& sh = shard_for(addr);
+        std::lock_guard<std::mutex> lk{sh.mtx};
+        auto it = sh.eps.find(addr);
+        return (it == sh.eps.end()) ? 0 : it->second.nlive;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_connection_pool_h
@@ -47,7 +47,12 @@
 #ifndef __sockpp_connector_h
 #define __sockpp_connector_h
 
+#include <utility>
+#include <vector>
+
+#include "sockpp/resolver.h"
 #include "sockpp/sock_address.h"
+#include "sockpp/socket_options.h"
 #include "sockpp/stream_socket.h"
 #include "sockpp/types.h"
 
@@ -66,14 +71,59 @@ class connector : public stream_socket
     /** The base class */
     using base = stream_socket;
 
+    /** The options applied to each new socket, before it connects */
+    socket_options opts_;
+    /** The flags used to create each new socket */
+    int flags_ = 0;
+    /** The protocol used to create each new socket */
+    int protocol_ = 0;
+    /** A handle opened ahead of time that has not yet been connected */
+    socket_t fresh_ = INVALID_SOCKET;
+    /** The address family of the fresh handle */
+    sa_family_t freshFamily_ = AF_UNSPEC;
+
     // Non-copyable
     connector(const connector&) = delete;
     connector& operator=(const connector&) = delete;
 
-    /** Recreate the socket with a new handle, closing any old one. */
-    result<> recreate(const sock_address& addr);
+    /**
+     * Recreate the socket with a new handle, closing any old one.
+     * @param family The address family for the new socket.
+     * @param flags Creation flags to use in addition to the ones set for
+     *  			the connector.
+     */
+    result<> recreate(sa_family_t family, int flags = 0);
+    /**
+     * Gets the socket ready to connect to the address.
+     * This uses the handle from @ref open() if it's still unconnected and
+     * of the right family, otherwise it creates a new one.
+     * @param addr The address that will be connected.
+     * @param flags Creation flags to use in addition to the ones set for
+     *  			the connector.
+     */
+    result<> prepare(const sock_address& addr, int flags = 0);
+
+protected:
+    /**
+     * Connects a number of sockets in parallel, with a single deadline.
+     * @param conns Array of pointers to the connectors.
+     * @param addrs Array of pointers to the address for each connector.
+     * @param errs Array to get the error code for each connection
+     * @param n The number of connections
+     * @param timeout The time allowed for all the connections to complete.
+     */
+    static void connect_many(
+        connector* const* conns, const sock_address* const* addrs, error_code* errs,
+        size_t n, microseconds timeout
+    );
 
 public:
+    /**
+     * The default delay between starting connection attempts when racing
+     * a list of addresses, as recommended by RFC 8305.
+     */
+    static constexpr milliseconds DFLT_ATTEMPT_DELAY = milliseconds(250);
+
     /**
      * Creates an unconnected connector.
      */
@@ -151,7 +201,13 @@ public:
      * Creates a connector by moving the other connector to this one.
      * @param conn Another connector.
      */
-    connector(connector&& conn) noexcept : base(std::move(conn)) {}
+    connector(connector&& conn) noexcept
+        : base(std::move(conn)),
+          opts_{std::move(conn.opts_)},
+          flags_{conn.flags_},
+          protocol_{conn.protocol_},
+          fresh_{std::exchange(conn.fresh_, INVALID_SOCKET)},
+          freshFamily_{conn.freshFamily_} {}
     /**
      * Move assignment.
      * @param rhs The other connector to move into this one.
@@ -159,12 +215,79 @@ public:
      */
     connector& operator=(connector&& rhs) noexcept {
         base::operator=(std::move(rhs));
+        opts_ = std::move(rhs.opts_);
+        flags_ = rhs.flags_;
+        protocol_ = rhs.protocol_;
+        std::swap(fresh_, rhs.fresh_);
+        std::swap(freshFamily_, rhs.freshFamily_);
         return *this;
     }
+    /**
+     * Gets the options that are applied to each new socket created by
+     * the connector, before it connects.
+     *
+     * Setting the buffer sizes here, rather than after the connect,
+     * allows the window scale to be negotiated for them. If an option
+     * can't be set, the connect fails with that error.
+     * @return A reference to the socket options.
+     */
+    socket_options& options() noexcept { return opts_; }
+    /**
+     * Gets the options that are applied to each new socket created by
+     * the connector.
+     * @return A reference to the socket options.
+     */
+    const socket_options& options() const noexcept { return opts_; }
+    /**
+     * Sets the flags used to create each new socket for the connector.
+     *
+     * The flags are applied as the socket is created, where the system
+     * supports it, so a connector used with a @ref reactor can have its
+     * sockets born in non-blocking mode. With @ref NON_BLOCKING, a plain
+     * @ref connect() returns `errc::operation_in_progress` if the
+     * connection can't complete immediately, and the timed connects leave
+     * the socket in non-blocking mode.
+     * @param flags Any combination of @ref NON_BLOCKING and
+     *  			@ref CLOSE_ON_EXEC.
+     */
+    void create_flags(int flags) noexcept { flags_ = flags; }
+    /**
+     * Gets the flags used to create each new socket for the connector.
+     * @return The creation flags.
+     */
+    int create_flags() const noexcept { return flags_; }
+    /**
+     * Sets the protocol used to create each new socket for the connector.
+     * The default of zero uses the standard stream protocol for the
+     * address family, like TCP for IP addresses. A
+     * @ref connector_tmpl sets this for its socket type.
+     * @param protocol The protocol, like `IPPROTO_MPTCP`.
+     */
+    void create_protocol(int protocol) noexcept { protocol_ = protocol; }
+    /**
+     * Gets the protocol used to create each new socket for the connector.
+     * @return The protocol, or zero for the default one.
+     */
+    int create_protocol() const noexcept { return protocol_; }
+    /**
+     * Opens a new, unconnected socket for the connector.
+     *
+     * The socket is created with the @ref create_flags() and has the
+     * @ref options() applied. It can then be configured further, or bound
+     * to a local address, and the next connect to an address of the same
+     * family uses it rather than creating a new socket. Once a connect
+     * has been tried on it, a reconnect needs a new socket, which only
+     * gets the @ref options(), so settings that should last across
+     * reconnects belong there.
+     * @param family The address family of the server.
+     * @return The error code on failure.
+     */
+    result<> open(sa_family_t family);
     /**
      * Attempts to connect to the specified server.
      * If the socket is currently connected, this will close the current
-     * connection and open the new one.
+     * connection and open the new one. A socket from @ref open() that
+     * hasn't been connected yet is used as-is.
      * @param addr The remote server address.
      * @return The error code on failure.
      */
@@ -193,23 +316,192 @@ public:
     result<> connect(const sock_address& addr, const duration<Rep, Period>& relTime) {
         return connect(addr, microseconds(relTime));
     }
+    /**
+     * Starts a connection to the specified server, without waiting for it
+     * to complete.
+     *
+     * The socket is put into non-blocking mode and left that way. If the
+     * connection can't complete immediately, the application should wait
+     * for the socket to become writable, such as with a @ref poller or
+     * @ref reactor, then call @ref finish_connect() to get the outcome.
+     *
+     * If the socket is currently connected, this will close the current
+     * connection and start the new one.
+     * @param addr The remote server address.
+     * @return @em true if the connection completed immediately, @em false
+     *  	   if it is in progress, or the error code on failure.
+     */
+    result<bool> connect_async(const sock_address& addr);
+    /**
+     * Connects to the specified server, sending the first block of data
+     * along with the connection request, using TCP Fast Open.
+     *
+     * If the client has a Fast Open cookie from an earlier connection to
+     * the server, the data goes out in the SYN, and the server can start
+     * on the request a full round trip sooner. Otherwise the cookie is
+     * requested, and the data goes out after the handshake, as usual.
+     *
+     * This uses `MSG_FASTOPEN` on Linux and `connectx()` on macOS. On
+     * other systems, or when Fast Open is disabled for clients, it falls
+     * back to a normal connect followed by a write. The server needs to
+     * have Fast Open enabled with @ref acceptor::fastopen(). Since the
+     * data might be seen twice by the server if the SYN is retransmitted,
+     * it should only be used for idempotent requests.
+     *
+     * If the socket is currently connected, this will close the current
+     * connection and open the new one.
+     * @param addr The remote server address.
+     * @param buf The data to send.
+     * @param n The number of bytes to send.
+     * @return The number of bytes sent on success, or the error code on
+     *  	   failure.
+     */
+    result<size_t> connect_with_data(const sock_address& addr, const void* buf, size_t n);
+    /**
+     * Connects to the specified server, sending the first block of data
+     * along with the connection request, using TCP Fast Open.
+     * See @ref connect_with_data(const sock_address&, const void*, size_t)
+     * @param addr The remote server address.
+     * @param s The data to send.
+     * @return The number of bytes sent on success, or the error code on
+     *  	   failure.
+     */
+    result<size_t> connect_with_data(const sock_address& addr, const string& s) {
+        return connect_with_data(addr, s.data(), s.size());
+    }
+    /**
+     * Resolves a host name to all of its addresses, for a stream
+     * connection to the specified port.
+     *
+     * This does an uncached lookup with @ref resolver::lookup(). The
+     * addresses are ordered for a "Happy Eyeballs" connection race
+     * (RFC 8305): in the order preferred by the system resolver, but
+     * interleaved so that the address families alternate, starting with
+     * the family of the most preferred address.
+     * @param host The host name or numeric address.
+     * @param port The port number in native/host byte order.
+     * @param family The address family to look up. The default,
+     *  			 AF_UNSPEC, gets both IPv4 and IPv6 addresses.
+     * @return The list of addresses, or the error code on failure.
+     */
+    static result<std::vector<sock_address_any>> resolve(
+        const string& host, in_port_t port, int family = AF_UNSPEC
+    );
+    /**
+     * Connects to the first server that responds from a list of
+     * addresses, using the "Happy Eyeballs" algorithm (RFC 8305).
+     *
+     * The connection attempts are started in order, each one a short
+     * delay after the previous, or immediately if the previous one
+     * failed. Attempts that are still in progress keep running alongside
+     * the new ones. The first one to connect is kept as this socket, and
+     * the rest are closed. This hides the latency of an unresponsive
+     * address, or an address family that is not routable, behind the
+     * attempt delay rather than a full connect timeout.
+     *
+     * The addresses can be of any family. On success, the socket is left
+     * in blocking mode, unless the connector's @ref create_flags() ask for
+     * non-blocking.
+     * @param addrs The list of server addresses, in order of preference.
+     * @param timeout The time allowed for the whole race. Zero means
+     *  			  never time out.
+     * @param attemptDelay The delay before starting the next attempt while
+     *  				   the previous ones are still in progress.
+     * @return The error code on failure. If all the attempts fail, this
+     *  	   is the error from the last one to fail.
+     */
+    result<> connect_race(
+        const std::vector<sock_address_any>& addrs, microseconds timeout = microseconds(0),
+        milliseconds attemptDelay = DFLT_ATTEMPT_DELAY
+    );
+    /**
+     * Resolves a host name to all of its addresses and connects to the
+     * first one that responds, using the "Happy Eyeballs" algorithm.
+     * @param host The host name or numeric address.
+     * @param port The port number in native/host byte order.
+     * @param timeout The time allowed for the whole race. Zero means
+     *  			  never time out.
+     * @param attemptDelay The delay before starting the next attempt while
+     *  				   the previous ones are still in progress.
+     * @return The error code on failure.
+     */
+    result<> connect_race(
+        const string& host, in_port_t port, microseconds timeout = microseconds(0),
+        milliseconds attemptDelay = DFLT_ATTEMPT_DELAY
+    ) {
+        auto res = resolve(host, port);
+        if (!res)
+            return res.error();
+        return connect_race(res.value(), timeout, attemptDelay);
+    }
+    /**
+     * Resolves a host name to all of its addresses, using the cache of a
+     * resolver, and connects to the first one that responds, using the
+     * "Happy Eyeballs" algorithm.
+     * @param host The host name or numeric address.
+     * @param port The port number in native/host byte order.
+     * @param rslv The resolver to use for the lookup.
+     * @param timeout The time allowed for the whole race. Zero means
+     *  			  never time out.
+     * @param attemptDelay The delay before starting the next attempt while
+     *  				   the previous ones are still in progress.
+     * @return The error code on failure.
+     */
+    result<> connect_race(
+        const string& host, in_port_t port, resolver& rslv,
+        microseconds timeout = microseconds(0), milliseconds attemptDelay = DFLT_ATTEMPT_DELAY
+    ) {
+        auto res = rslv.resolve(host, port);
+        if (!res)
+            return res.error();
+        return connect_race(res.value(), timeout, attemptDelay);
+    }
+    /**
+     * Gets the outcome of a connection started with @ref connect_async().
+     * This should be called once the socket is reported as writable.
+     * @return The error code if the connection failed, or
+     *  	   `errc::operation_in_progress` if it has not yet completed.
+     */
+    result<> finish_connect();
 };
 
 /////////////////////////////////////////////////////////////////////////////
 
 /**
  * Class to create a client TCP connection.
+ *
+ * The connector keeps a copy of the address it connected to if the
+ * stream socket type does. See @ref stream_socket_tmpl.
  */
-template <typename STREAM_SOCK, typename ADDR = typename STREAM_SOCK::addr_t>
-class connector_tmpl : public connector
+template <
+    typename STREAM_SOCK, typename ADDR = typename STREAM_SOCK::addr_t,
+    bool CACHE_PEER = STREAM_SOCK::CACHES_PEER>
+class connector_tmpl : public connector, private detail::peer_cache<ADDR, CACHE_PEER>
 {
     /** The base class */
     using base = connector;
+    /** The storage for the peer address */
+    using peer_cache = detail::peer_cache<ADDR, CACHE_PEER>;
 
     // Non-copyable
     connector_tmpl(const connector_tmpl&) = delete;
     connector_tmpl& operator=(const connector_tmpl&) = delete;
 
+    /**
+     * Keeps the peer address if the last connect succeeded, otherwise
+     * forgets any previous one.
+     * @param addr The address that was connected.
+     * @param ok Whether the connect succeeded.
+     */
+    void set_peer(const sock_address& addr, bool ok) {
+        if constexpr (CACHE_PEER) {
+            if (ok)
+                peer_cache::cache_peer(ADDR(addr));
+            else
+                peer_cache::forget_peer();
+        }
+    }
+
 public:
     /** The type of streaming socket from the acceptor. */
     using stream_sock_t = STREAM_SOCK;
@@ -219,21 +511,28 @@ public:
     /**
      * Creates an unconnected connector.
      */
-    connector_tmpl() noexcept {}
+    connector_tmpl() noexcept { create_protocol(STREAM_SOCK::PROTOCOL); }
     /**
      * Creates the connector and attempts to connect to the specified
      * address.
      * @param addr The remote server address.
      * @throws std::system_error on failure.
      */
-    connector_tmpl(const addr_t& addr) : base(addr) {}
+    connector_tmpl(const addr_t& addr) {
+        create_protocol(STREAM_SOCK::PROTOCOL);
+        if (auto res = connect(addr); !res)
+            throw std::system_error{res.error()};
+    }
     /**
      * Creates the connector and attempts to connect to the specified
      * address.
      * @param addr The remote server address.
      * @param ec The error code on failure.
      */
-    connector_tmpl(const addr_t& addr, error_code& ec) noexcept : base(addr, ec) {}
+    connector_tmpl(const addr_t& addr, error_code& ec) noexcept {
+        create_protocol(STREAM_SOCK::PROTOCOL);
+        ec = connect(addr).error();
+    }
     /**
      * Creates the connector and attempts to connect to the specified
      * server, with a timeout.
@@ -242,8 +541,11 @@ public:
      * @throws std::system_error on failure
      */
     template <class Rep, class Period>
-    connector_tmpl(const addr_t& addr, const duration<Rep, Period>& relTime)
-        : base(addr, relTime) {}
+    connector_tmpl(const addr_t& addr, const duration<Rep, Period>& relTime) {
+        create_protocol(STREAM_SOCK::PROTOCOL);
+        if (auto res = connect(addr, relTime); !res)
+            throw std::system_error{res.error()};
+    }
     /**
      * Creates the connector and attempts to connect to the specified
      * server, with a timeout.
@@ -254,23 +556,34 @@ public:
     template <class Rep, class Period>
     connector_tmpl(
         const addr_t& addr, const duration<Rep, Period>& relTime, error_code& ec
-    ) noexcept
-        : base(addr, relTime, ec) {}
+    ) noexcept {
+        create_protocol(STREAM_SOCK::PROTOCOL);
+        ec = connect(addr, relTime).error();
+    }
     /**
      * Move constructor.
      * Creates a connector by moving the other connector to this one.
      * @param rhs Another connector.
      */
-    connector_tmpl(connector_tmpl&& rhs) : base(std::move(rhs)) {}
+    connector_tmpl(connector_tmpl&& rhs) : base(std::move(rhs)), peer_cache(rhs) {
+        rhs.forget_peer();
+    }
     /**
      * Move assignment.
      * @param rhs The other connector to move into this one.
      * @return A reference to this object.
      */
     connector_tmpl& operator=(connector_tmpl&& rhs) {
-        base::operator=(std::move(rhs));
+        if (&rhs != this) {
+            base::operator=(std::move(rhs));
+            peer_cache::operator=(rhs);
+            rhs.forget_peer();
+        }
         return *this;
     }
+    using socket::address;
+    using socket::peer_address;
+
     /**
      * Gets the local address to which the socket is bound.
      * @return The local address to which the socket is bound.
@@ -278,13 +591,40 @@ public:
     addr_t address() const { return addr_t(base::address()); }
     /**
      * Gets the address of the remote peer, if this socket is connected.
+     *
+     * If the connector caches the peer address and was connected to a
+     * known address, that address is returned without a system call.
      * @return The address of the remote peer, if this socket is connected.
      */
-    addr_t peer_address() const { return addr_t(base::peer_address()); }
+    addr_t peer_address() const {
+        if (auto p = peer_cache::cached_peer(); p && is_open())
+            return *p;
+        return addr_t(base::peer_address());
+    }
+    /**
+     * Determines if the peer address was captured when the socket was
+     * connected, so would be returned by @ref peer_address() without a
+     * system call. This is always @em false for a type that doesn't
+     * cache the peer address.
+     * @return @em true if the peer address is cached.
+     */
+    bool has_cached_peer_address() const noexcept {
+        return peer_cache::cached_peer() != nullptr;
+    }
+    using base::open;
+
+    /**
+     * Opens a new, unconnected socket for the connector, for addresses of
+     * this connector's family.
+     * See @ref connector::open().
+     * @return The error code on failure.
+     */
+    result<> open() { return base::open(addr_t::ADDRESS_FAMILY); }
     /**
      * Binds the socket to the specified address.
      * This call is optional for a client connector, though it is rarely
-     * used.
+     * used. It needs to be done after @ref open(), so that the next
+     * connect keeps the socket.
      * @param addr The address to which we get bound.
      * @return @em true on success, @em false on error
      */
@@ -296,7 +636,11 @@ public:
      * @param addr The remote server address.
      * @return @em true on success, @em false on error
      */
-    result<> connect(const addr_t& addr) { return base::connect(addr); }
+    result<> connect(const addr_t& addr) {
+        auto res = base::connect(addr);
+        set_peer(addr, bool(res));
+        return res;
+    }
     /**
      * Attempts to connect to the specified server, with a timeout.
      * If the socket is currently connected, this will close the current
@@ -311,7 +655,9 @@ public:
     result<> connect(
         const sock_address& addr, const std::chrono::duration<Rep, Period>& relTime
     ) {
-        return base::connect(addr, std::chrono::microseconds(relTime));
+        auto res = base::connect(addr, std::chrono::microseconds(relTime));
+        set_peer(addr, bool(res));
+        return res;
     }
     /**
      * Attempts to connect to the server at the specified port.
@@ -355,6 +701,124 @@ public:
             return res;
         return none{};
     }
+    /**
+     * Attempts to connect to the server at the specified port, resolving
+     * the host name with the cache of a resolver.
+     *
+     * All the addresses of the host in the connector's family are tried,
+     * as with @ref connect_race(), until one connects.
+     * @param saddr The name of the host.
+     * @param port The port number in native/host byte order.
+     * @param rslv The resolver to use for the lookup.
+     * @param timeout The time allowed to connect. Zero means never.
+     * @return The result of the operation, with an error code on failure.
+     */
+    result<> connect(
+        const string& saddr, in_port_t port, resolver& rslv,
+        microseconds timeout = microseconds(0)
+    ) {
+        peer_cache::forget_peer();
+        auto res = rslv.resolve(saddr, port, addr_t::ADDRESS_FAMILY);
+        if (!res)
+            return res.error();
+        return base::connect_race(res.value(), timeout);
+    }
+    /**
+     * Connects to the first of a number of servers that responds, using
+     * the "Happy Eyeballs" algorithm.
+     * See @ref connector::connect_race().
+     * @param args The arguments for the base connect_race().
+     * @return The error code on failure.
+     */
+    template <typename... Args>
+    result<> connect_race(Args&&... args) {
+        peer_cache::forget_peer();
+        return base::connect_race(std::forward<Args>(args)...);
+    }
+    /**
+     * Starts a connection to the specified server, without waiting for it
+     * to complete.
+     * @param addr The remote server address.
+     * @return @em true if the connection completed immediately, @em false
+     *  	   if it is in progress, or the error code on failure.
+     */
+    result<bool> connect_async(const addr_t& addr) {
+        auto res = base::connect_async(addr);
+        set_peer(addr, res && res.value());
+        return res;
+    }
+    /**
+     * Connects to the specified server, sending the first block of data
+     * along with the connection request, using TCP Fast Open.
+     * See @ref connector::connect_with_data().
+     * @param addr The remote server address.
+     * @param buf The data to send.
+     * @param n The number of bytes to send.
+     * @return The number of bytes sent on success, or the error code on
+     *  	   failure.
+     */
+    result<size_t> connect_with_data(const addr_t& addr, const void* buf, size_t n) {
+        auto res = base::connect_with_data(addr, buf, n);
+        set_peer(addr, bool(res));
+        return res;
+    }
+    /**
+     * Connects to the specified server, sending the first block of data
+     * along with the connection request, using TCP Fast Open.
+     * @param addr The remote server address.
+     * @param s The data to send.
+     * @return The number of bytes sent on success, or the error code on
+     *  	   failure.
+     */
+    result<size_t> connect_with_data(const addr_t& addr, const string& s) {
+        return connect_with_data(addr, s.data(), s.size());
+    }
+    /**
+     * Connects to a number of servers in parallel, with a single deadline
+     * for all of them.
+     *
+     * All the connections are started at once, then the calling thread
+     * waits for them to complete, up to the timeout. Any connection that
+     * has not completed by then fails with `errc::timed_out`. The
+     * sockets that connect are returned in blocking mode, unless their
+     * @ref create_flags() ask for non-blocking.
+     * @param addrs The addresses of the servers.
+     * @param timeout The time allowed for all the connections.
+     * @return A result for each address, in the same order, each holding
+     *  	   either a connected socket or the error for that connection.
+     */
+    template <class Rep, class Period>
+    static std::vector<result<connector_tmpl>> connect_many(
+        const std::vector<addr_t>& addrs, const duration<Rep, Period>& timeout
+    ) {
+        size_t n = addrs.size();
+
+        std::vector<connector_tmpl> conns(n);
+        std::vector<connector*> pconns(n);
+        std::vector<const sock_address*> paddrs(n);
+        std::vector<error_code> errs(n);
+
+        for (size_t i = 0; i < n; ++i) {
+            pconns[i] = &conns[i];
+            paddrs[i] = &addrs[i];
+        }
+
+        base::connect_many(
+            pconns.data(), paddrs.data(), errs.data(), n, microseconds(timeout)
+        );
+
+        std::vector<result<connector_tmpl>> ret;
+        ret.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (errs[i])
+                ret.emplace_back(errs[i]);
+            else {
+                conns[i].set_peer(addrs[i], true);
+                ret.emplace_back(std::move(conns[i]));
+            }
+        }
+        return ret;
+    }
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,806 @@
+/**
+ * @file coro.h
+ *
+ * C++20 coroutine tasks and awaitable socket operations on top of the reactor.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_coro_h
+#define __sockpp_coro_h
+
+#if !defined(__cpp_impl_coroutine) && !defined(__cpp_coroutines)
+    #error "sockpp/coro.h requires a C++20 compiler with coroutine support"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include "sockpp/acceptor.h"
+#include "sockpp/reactor.h"
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The parts of a task's promise that don't depend on the return type.
+ */
+struct task_promise_base
+{
+    /** The coroutine awaiting this one, if any */
+    std::coroutine_handle<> cont_{};
+    /** An exception that escaped the coroutine */
+    std::exception_ptr exc_{};
+    /** Whether the task was detached, and so owns its own frame */
+    bool detached_{false};
+
+    /**
+     * On completion, transfers control to the awaiting coroutine, if
+     * there is one. A detached task destroys its own frame.
+     */
+    struct final_awaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            auto& p = h.promise();
+            if (p.cont_)
+                return p.cont_;
+            if (p.detached_)
+                h.destroy();
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /** Tasks are lazy, and only start running when awaited or detached. */
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        // There's no one to report this to
+        if (detached_)
+            std::terminate();
+        exc_ = std::current_exception();
+    }
+
+    void rethrow_if_exception() const {
+        if (exc_)
+            std::rethrow_exception(exc_);
+    }
+};
+
+/**
+ * The promise for a task that returns a value.
+ */
+template <typename T>
+struct task_promise : task_promise_base
+{
+    /** The value returned by the coroutine */
+    std::optional<T> val_;
+
+    task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& val) {
+        val_.emplace(std::forward<U>(val));
+    }
+
+    T take() {
+        rethrow_if_exception();
+        return std::move(*val_);
+    }
+};
+
+/**
+ * The promise for a task that doesn't return a value.
+ */
+template <>
+struct task_promise<void> : task_promise_base
+{
+    task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void take() { rethrow_if_exception(); }
+};
+
+/**
+ * A pending I/O operation on a socket.
+ * This is the part of each awaiter that the readiness handler sees. It
+ * lives in the awaiting coroutine's frame, so there is no allocation per
+ * operation.
+ */
+struct async_op
+{
+    /** Attempts the operation, returning @em true when it's complete */
+    bool (*perform)(async_op*) noexcept {nullptr};
+    /** The coroutine to resume when the operation completes */
+    std::coroutine_handle<> h{};
+};
+
+}  // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A lazily-started coroutine that produces a value of type `T`.
+ *
+ * A task doesn't run until it is awaited with `co_await` from another
+ * coroutine, run to completion with @ref block_on(), or started in the
+ * background with @ref spawn(). When awaited, control is transferred
+ * directly to the task, and back to the awaiting coroutine when the task
+ * completes, so there is no recursion through the event loop.
+ *
+ * An exception that escapes the coroutine is rethrown to the awaiter. If
+ * the task was spawned, there's no one to receive it, and the program is
+ * terminated, as with an exception that escapes a thread.
+ *
+ * Objects of this class are moveable, but not copyable.
+ */
+template <typename T>
+class task
+{
+public:
+    /** The coroutine promise type */
+    using promise_type = detail::task_promise<T>;
+
+private:
+    /** The coroutine frame */
+    std::coroutine_handle<promise_type> h_{};
+
+    friend promise_type;
+
+    explicit task(std::coroutine_handle<promise_type> h) noexcept : h_{h} {}
+
+    // Non-copyable
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+public:
+    /**
+     * Move constructor.
+     * @param other The task to move into this one.
+     */
+    task(task&& other) noexcept : h_{std::exchange(other.h_, {})} {}
+    /**
+     * Destroys the coroutine frame, if the task still owns it.
+     */
+    ~task() {
+        if (h_)
+            h_.destroy();
+    }
+    /**
+     * Move assignment.
+     * @param rhs The task to move into this one.
+     * @return A reference to this object.
+     */
+    task& operator=(task&& rhs) noexcept {
+        if (&rhs != this) {
+            if (h_)
+                h_.destroy();
+            h_ = std::exchange(rhs.h_, {});
+        }
+        return *this;
+    }
+    /**
+     * Determines if the task has run to completion.
+     * @return @em true if the task is complete, or is empty.
+     */
+    bool done() const noexcept { return !h_ || h_.done(); }
+    /**
+     * Starts the task running in the background.
+     * The task owns its own frame, and destroys it when it completes.
+     * This object is left empty.
+     */
+    void detach() {
+        auto h = std::exchange(h_, {});
+        h.promise().detached_ = true;
+        h.resume();
+    }
+    /**
+     * Starts the task running, while this object keeps the frame.
+     * This is for use by code driving the event loop, to get the result
+     * once @ref done() is true.
+     */
+    void start() { h_.resume(); }
+    /**
+     * Gets the result of a completed task.
+     * @return The value returned by the coroutine.
+     * @throws Any exception that escaped the coroutine.
+     */
+    T get() { return h_.promise().take(); }
+
+    /** @cond Awaiter interface */
+    bool await_ready() const noexcept { return done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> cont) noexcept {
+        h_.promise().cont_ = cont;
+        return h_;
+    }
+
+    T await_resume() { return get(); }
+    /** @endcond */
+};
+
+namespace detail {
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>{std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>{std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+/**
+ * Starts a task running in the background.
+ * The task runs until it first has to wait, then continues from the
+ * reactor as its sockets become ready. Its frame is destroyed when it
+ * completes.
+ * @param t The task to start.
+ */
+template <typename T>
+void spawn(task<T> t) {
+    t.detach();
+}
+
+/**
+ * Runs a task to completion, driving the reactor as needed.
+ * @param rctr The reactor on which the task's sockets are registered.
+ * @param t The task to run.
+ * @return The value returned by the task.
+ * @throws std::system_error if the reactor fails.
+ * @throws std::logic_error if the task is waiting, but there are no
+ *  	   sockets in the reactor that could wake it.
+ */
+template <typename T>
+T block_on(reactor& rctr, task<T> t) {
+    t.start();
+    while (!t.done()) {
+        if (rctr.empty())
+            throw std::logic_error("Task is waiting on an empty reactor");
+        if (auto res = rctr.run_once(); !res)
+            throw std::system_error{res.error()};
+    }
+    return t.get();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The registration of a socket with a reactor, on behalf of the
+ * coroutines waiting on it.
+ *
+ * A socket can have one pending read-type operation and one pending
+ * write-type operation at a time. The socket is added to the reactor the
+ * first time an operation has to wait, and stays registered, so that an
+ * operation that waits on the same events as the previous one doesn't
+ * need any system calls to set up. The interest set is only reduced when
+ * the socket reports an event that no one is waiting for.
+ *
+ * This is not moveable, since the reactor holds a pointer to it, and must
+ * not be destroyed while an operation is pending.
+ */
+class async_io
+{
+    /** The reactor that dispatches the events */
+    reactor& rctr_;
+    /** The socket */
+    const socket& sock_;
+    /** The handle that was registered, if any */
+    socket_t handle_{INVALID_SOCKET};
+    /** The events registered with the reactor */
+    uint32_t events_{0};
+    /** The pending read-type operation */
+    detail::async_op* reader_{nullptr};
+    /** The pending write-type operation */
+    detail::async_op* writer_{nullptr};
+
+    async_io(const async_io&) = delete;
+    async_io& operator=(const async_io&) = delete;
+
+    uint32_t wanted() const noexcept {
+        return (reader_ ? poller::READABLE : 0) | (writer_ ? poller::WRITABLE : 0);
+    }
+
+    result<> update() {
+        auto want = wanted();
+        if (handle_ != sock_.handle())
+            unregister();
+
+        if (handle_ == INVALID_SOCKET) {
+            auto res = rctr_.add(sock_.handle(), want, [this](uint32_t ev) { on_ready(ev); });
+            if (!res)
+                return res;
+            handle_ = sock_.handle();
+        }
+        else if ((events_ | want) != events_) {
+            if (auto res = rctr_.modify(handle_, events_ | want); !res)
+                return res;
+        }
+        events_ |= want;
+        return none{};
+    }
+
+    void on_ready(uint32_t ev) {
+        bool err = (ev & (poller::HANGUP | poller::ERRORS)) != 0;
+        std::coroutine_handle<> rh, wh;
+
+        if (reader_ && (err || (ev & poller::READABLE)) && reader_->perform(reader_)) {
+            rh = reader_->h;
+            reader_ = nullptr;
+        }
+        if (writer_ && (err || (ev & poller::WRITABLE)) && writer_->perform(writer_)) {
+            wh = writer_->h;
+            writer_ = nullptr;
+        }
+
+        // No one was waiting for this, so stop listening for it. With a
+        // level-triggered poller it would otherwise keep firing. A hangup
+        // can't be masked, so the socket is removed until it's needed.
+        if (!rh && !wh) {
+            auto want = wanted();
+            if (want == 0)
+                unregister();
+            else if (want != events_ && rctr_.modify(handle_, want))
+                events_ = want;
+        }
+
+        // Resume last: either coroutine might destroy this object.
+        if (rh)
+            rh.resume();
+        if (wh)
+            wh.resume();
+    }
+
+public:
+    /**
+     * Creates the registration for a socket.
+     * @param rctr The reactor to dispatch events.
+     * @param sock The socket. This must outlive the registration.
+     */
+    async_io(reactor& rctr, const socket& sock) noexcept : rctr_{rctr}, sock_{sock} {}
+    /**
+     * Removes the socket from the reactor, if it was registered.
+     */
+    ~async_io() { unregister(); }
+    /**
+     * Gets the reactor.
+     * @return The reactor that dispatches events for the socket.
+     */
+    reactor& get_reactor() noexcept { return rctr_; }
+    /**
+     * Removes the socket from the reactor.
+     * This must be done before the socket is closed or recreated, and
+     * while no operation is pending.
+     */
+    void unregister() noexcept {
+        if (handle_ != INVALID_SOCKET) {
+            (void)rctr_.remove(handle_);
+            handle_ = INVALID_SOCKET;
+            events_ = 0;
+        }
+    }
+    /**
+     * Parks an operation until the socket is ready for it.
+     * @param op The operation.
+     * @param write Whether the operation waits for the socket to be
+     *  			writable, rather than readable.
+     * @return The error code if the socket can't be monitored.
+     */
+    result<> wait(detail::async_op* op, bool write) {
+        auto& slot = write ? writer_ : reader_;
+        if (slot)
+            return errc::device_or_resource_busy;
+
+        slot = op;
+        auto res = update();
+        if (!res)
+            slot = nullptr;
+        return res;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Base for the awaiters of socket operations.
+ *
+ * The derived class, `OP`, supplies `try_complete()`, which attempts the
+ * operation and returns @em true when it is done (successfully or not),
+ * `fail()` to record an error, and `await_resume()` to produce the result.
+ * The operation is tried once before suspending, so if the socket is
+ * already ready, the coroutine doesn't suspend at all.
+ */
+template <typename OP>
+class async_awaiter : protected detail::async_op
+{
+    /** The registration for the socket */
+    async_io& io_;
+    /** Whether the operation waits for the socket to be writable */
+    bool write_;
+
+    static bool do_perform(detail::async_op* op) noexcept {
+        return static_cast<OP*>(static_cast<async_awaiter*>(op))->try_complete();
+    }
+
+protected:
+    async_awaiter(async_io& io, bool write) noexcept : io_{io}, write_{write} {
+        perform = &do_perform;
+    }
+
+public:
+    /** @cond Awaiter interface */
+    bool await_ready() noexcept { return static_cast<OP*>(this)->try_complete(); }
+
+    bool await_suspend(std::coroutine_handle<> h) {
+        this->h = h;
+        if (auto res = io_.wait(this, write_); !res) {
+            static_cast<OP*>(this)->fail(res.error());
+            return false;
+        }
+        return true;
+    }
+    /** @endcond */
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A socket with awaitable I/O operations, for use in coroutines.
+ *
+ * This owns the socket, places it in non-blocking mode, and registers it
+ * with a reactor as needed. Each operation returns an awaitable that
+ * produces the same `result<T>` as the corresponding blocking call, so a
+ * coroutine can be written as straight-line code, like a thread:
+ *
+ * @code
+ * task<> run_echo(reactor& rctr, tcp_socket sock) {
+ *     async_socket<tcp_socket> s{rctr, std::move(sock)};
+ *     char buf[512];
+ *     result<size_t> res;
+ *     while ((res = co_await s.read(buf, sizeof(buf))) && res.value() > 0) {
+ *         if (!co_await s.write_n(buf, res.value()))
+ *             break;
+ *     }
+ * }
+ * @endcode
+ *
+ * The operations available depend on the type of socket: `read()` and
+ * `write()` for streams, `accept()` for acceptors, and `connect()` for
+ * connectors. At most one read-type (read, accept) and one write-type
+ * (write, connect) operation can be pending at a time.
+ *
+ * Apart from the coroutine frames themselves, operations don't allocate
+ * memory. The awaiter for each operation lives in the awaiting frame.
+ *
+ * This object can't be moved while the socket is registered, and must
+ * not be destroyed while any operation is pending.
+ */
+template <typename SOCK>
+class async_socket
+{
+    /** The socket */
+    SOCK sock_;
+    /** The registration with the reactor */
+    async_io io_;
+
+    async_socket(const async_socket&) = delete;
+    async_socket& operator=(const async_socket&) = delete;
+
+public:
+    /** The type of socket */
+    using socket_type = SOCK;
+
+    /**
+     * Creates an async socket from a regular one.
+     * The socket is placed in non-blocking mode, if it's open.
+     * @param rctr The reactor to dispatch events for the socket.
+     * @param sock The socket.
+     */
+    async_socket(reactor& rctr, SOCK&& sock) : sock_{std::move(sock)}, io_{rctr, sock_} {
+        if (sock_)
+            (void)sock_.set_non_blocking();
+    }
+    /**
+     * Creates an async socket around an unopened socket, such as a
+     * connector.
+     * @param rctr The reactor to dispatch events for the socket.
+     */
+    explicit async_socket(reactor& rctr) : io_{rctr, sock_} {}
+    /**
+     * Gets the underlying socket.
+     * @return A reference to the underlying socket.
+     */
+    SOCK& sock() noexcept { return sock_; }
+    /**
+     * Gets the underlying socket.
+     * @return A reference to the underlying socket.
+     */
+    const SOCK& sock() const noexcept { return sock_; }
+    /**
+     * Gets the reactor.
+     * @return The reactor that dispatches events for the socket.
+     */
+    reactor& get_reactor() noexcept { return io_.get_reactor(); }
+    /**
+     * Determines if the socket is open.
+     * @return @em true if the socket is open.
+     */
+    explicit operator bool() const noexcept { return bool(sock_); }
+    /**
+     * Removes the socket from the reactor and closes it.
+     * @return The error code on failure.
+     */
+    result<> close() {
+        io_.unregister();
+        return sock_.close();
+    }
+
+    // ----- Stream operations -----
+
+    /**
+     * Awaitable that reads some bytes from the stream.
+     */
+    class read_awaiter : public async_awaiter<read_awaiter>
+    {
+        friend class async_awaiter<read_awaiter>;
+
+        SOCK& sock_;
+        void* buf_;
+        size_t n_;
+        result<size_t> res_;
+
+        read_awaiter(async_io& io, SOCK& sock, void* buf, size_t n) noexcept
+            : async_awaiter<read_awaiter>{io, false}, sock_{sock}, buf_{buf}, n_{n} {}
+
+        friend class async_socket;
+
+        bool try_complete() noexcept {
+            res_ = sock_.read(buf_, n_);
+            return !res_.is_would_block();
+        }
+        void fail(const error_code& ec) noexcept { res_ = ec; }
+
+    public:
+        result<size_t> await_resume() noexcept { return std::move(res_); }
+    };
+
+    /**
+     * Awaitable that writes some, or all, of a buffer to the stream.
+     */
+    class write_awaiter : public async_awaiter<write_awaiter>
+    {
+        friend class async_awaiter<write_awaiter>;
+
+        SOCK& sock_;
+        const char* buf_;
+        size_t n_;
+        size_t nx_{0};
+        bool all_;
+        result<size_t> res_;
+
+        write_awaiter(async_io& io, SOCK& sock, const void* buf, size_t n, bool all) noexcept
+            : async_awaiter<write_awaiter>{io, true},
+              sock_{sock},
+              buf_{static_cast<const char*>(buf)},
+              n_{n},
+              all_{all} {}
+
+        friend class async_socket;
+
+        bool try_complete() noexcept {
+            do {
+                auto res = sock_.write(buf_ + nx_, n_ - nx_);
+                if (res.is_would_block())
+                    return false;
+                if (!res) {
+                    res_ = res.error();
+                    return true;
+                }
+                nx_ += res.value();
+            } while (all_ && nx_ < n_);
+
+            res_ = nx_;
+            return true;
+        }
+        void fail(const error_code& ec) noexcept { res_ = ec; }
+
+    public:
+        result<size_t> await_resume() noexcept { return std::move(res_); }
+    };
+
+    /**
+     * Reads some bytes from the stream, waiting until at least one is
+     * available.
+     * @param buf Buffer to receive the data.
+     * @param n The maximum number of bytes to read.
+     * @return An awaitable that produces the number of bytes read, zero
+     *  	   if the peer closed the connection, or the error code.
+     */
+    read_awaiter read(void* buf, size_t n) noexcept { return {io_, sock_, buf, n}; }
+    /**
+     * Writes some bytes to the stream, waiting until the socket can
+     * accept at least one.
+     * @param buf The data to write.
+     * @param n The number of bytes to write.
+     * @return An awaitable that produces the number of bytes written, or
+     *  	   the error code.
+     */
+    write_awaiter write(const void* buf, size_t n) noexcept {
+        return {io_, sock_, buf, n, false};
+    }
+    /**
+     * Writes the whole buffer to the stream, waiting as often as needed.
+     * @param buf The data to write.
+     * @param n The number of bytes to write.
+     * @return An awaitable that produces the number of bytes written,
+     *  	   which is @em n on success, or the error code.
+     */
+    write_awaiter write_n(const void* buf, size_t n) noexcept {
+        return {io_, sock_, buf, n, true};
+    }
+
+    // ----- Acceptor operations -----
+
+    /**
+     * Awaitable that accepts an incoming connection.
+     * The new socket is in non-blocking mode.
+     */
+    template <typename ACC = SOCK>
+    class accept_awaiter : public async_awaiter<accept_awaiter<ACC>>
+    {
+        friend class async_awaiter<accept_awaiter>;
+
+        using stream_sock_t = typename ACC::stream_sock_t;
+        using addr_t = typename ACC::addr_t;
+
+        ACC& acc_;
+        addr_t* peer_;
+        std::optional<result<stream_sock_t>> res_;
+
+        accept_awaiter(async_io& io, ACC& acc, addr_t* peer) noexcept
+            : async_awaiter<accept_awaiter>{io, false}, acc_{acc}, peer_{peer} {}
+
+        friend class async_socket;
+
+        bool try_complete() noexcept {
+            while (true) {
+                auto res = acc_.accept(peer_, acceptor::NON_BLOCKING);
+                if (res == errc::interrupted || res == errc::connection_aborted)
+                    continue;
+                if (res.is_would_block())
+                    return false;
+                res_.emplace(std::move(res));
+                return true;
+            }
+        }
+        void fail(const error_code& ec) noexcept { res_.emplace(ec); }
+
+    public:
+        result<stream_sock_t> await_resume() noexcept { return std::move(*res_); }
+    };
+
+    /**
+     * Accepts an incoming connection, waiting until one arrives.
+     * @param peer Pointer to an address to get the address of the client,
+     *  		   or null if it's not needed.
+     * @return An awaitable that produces the new, non-blocking, socket or
+     *  	   the error code.
+     */
+    template <typename ACC = SOCK>
+    accept_awaiter<ACC> accept(typename ACC::addr_t* peer = nullptr) noexcept {
+        return {io_, sock_, peer};
+    }
+
+    // ----- Connector operations -----
+
+    /**
+     * Awaitable that connects to a server.
+     */
+    template <typename CONN = SOCK>
+    class connect_awaiter : public async_awaiter<connect_awaiter<CONN>>
+    {
+        friend class async_awaiter<connect_awaiter>;
+
+        CONN& conn_;
+        std::optional<result<>> res_;
+
+        connect_awaiter(async_io& io, CONN& conn) noexcept
+            : async_awaiter<connect_awaiter>{io, true}, conn_{conn} {}
+
+        friend class async_socket;
+
+        bool try_complete() noexcept {
+            auto res = conn_.finish_connect();
+            if (res == errc::operation_in_progress)
+                return false;
+            res_.emplace(std::move(res));
+            return true;
+        }
+        void fail(const error_code& ec) noexcept { res_.emplace(ec); }
+
+    public:
+        bool await_ready() noexcept { return res_.has_value(); }
+        result<> await_resume() noexcept { return std::move(*res_); }
+    };
+
+    /**
+     * Connects to a server, waiting until the connection completes.
+     * Any previous connection is closed.
+     * @param addr The address of the server.
+     * @return An awaitable that produces the error code on failure.
+     */
+    template <typename CONN = SOCK>
+    connect_awaiter<CONN> connect(const typename CONN::addr_t& addr) {
+        // The connect creates a new socket, so the old handle must go.
+        io_.unregister();
+
+        connect_awaiter<CONN> aw{io_, sock_};
+        if (auto res = sock_.connect_async(addr); !res)
+            aw.res_.emplace(res.error());
+        else if (res.value())
+            aw.res_.emplace(none{});
+        return aw;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_coro_h
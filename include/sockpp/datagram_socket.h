@@ -71,11 +71,87 @@ class datagram_socket : public socket
 protected:
     /**
      * Creates a datagram socket.
+     * @param domain The communications domain (address family).
+     * @param protocol The particular protocol to be used with the socket.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return An OS handle to a datagram socket.
      */
-    static result<socket_t> create_handle(int domain, int protocol = 0) {
-        return check_socket(socket_t(::socket(domain, COMM_TYPE, protocol)));
+    static result<socket_t> create_handle(int domain, int protocol = 0, int flags = 0) {
+        return base::create_handle(domain, COMM_TYPE, protocol, flags);
     }
+    /**
+     * Receives a batch of messages on the socket.
+     * This uses recvmmsg() where available, and otherwise loops over
+     * individual receives.
+     * @param bufs The array of buffers, one per message.
+     * @param lens Array to receive the length of each message.
+     * @param n The number of buffers (the maximum number of messages).
+     * @param flags The option bit flags. See recv(2).
+     * @param addrs The raw address of the first of an array of address
+     *  			objects to receive the source addresses, or @em nullptr
+     *  			if they are not wanted.
+     * @param addrStride The distance, in bytes, between the addresses.
+     * @param addrLen The size of each address.
+     * @return The number of messages received, or the error code on
+     *         failure.
+     */
+    result<size_t> recv_mmsg(
+        const iovec* bufs, size_t* lens, size_t n, int flags, sockaddr* addrs,
+        size_t addrStride, socklen_t addrLen
+    );
+    /**
+     * Sends a batch of messages from the socket.
+     * This uses sendmmsg() where available, and otherwise loops over
+     * individual sends.
+     * @param bufs The array of buffers, one per message.
+     * @param n The number of messages to send.
+     * @param flags The option bit flags. See send(2).
+     * @param addrs The raw address of the first of an array of destination
+     *  			addresses, or @em nullptr for a connected socket.
+     * @param addrStride The distance, in bytes, between the addresses. If
+     *  				 zero, all the messages go to the first address.
+     * @param addrLen The size of each address.
+     * @return The number of messages sent, or the error code on failure.
+     */
+    result<size_t> send_mmsg(
+        const iovec* bufs, size_t n, int flags, const sockaddr* addrs, size_t addrStride,
+        socklen_t addrLen
+    );
+
+    /** The multicast options that have both an IPv4 and an IPv6 flavor. */
+    enum class mcast_opt { hops, loop, iface, all };
+
+    /**
+     * Joins or leaves a multicast group, optionally restricted to a single
+     * source (source-specific multicast).
+     * The protocol level is taken from the family of the group address.
+     * @param join @em true to join the group, @em false to leave it.
+     * @param grp The multicast group address. The port is ignored.
+     * @param src The source to accept, or @em nullptr for any source.
+     * @param ifindex The index of the interface, or zero to let the
+     *  			  system choose.
+     * @return The error code on failure.
+     */
+    result<> mcast_membership(
+        bool join, const sock_address& grp, const sock_address* src, unsigned ifindex
+    );
+    /**
+     * Sets one of the multicast options for the address family.
+     * @param fam The address family, AF_INET or AF_INET6.
+     * @param opt The option to set.
+     * @param val The value for the option.
+     * @return The error code on failure.
+     */
+    result<> mcast_option(sa_family_t fam, mcast_opt opt, int val);
+    /**
+     * Gets the value of one of the multicast options for the address
+     * family.
+     * @param fam The address family, AF_INET or AF_INET6.
+     * @param opt The option to get. The interface can't be read back.
+     * @return The value of the option, or the error code on failure.
+     */
+    result<int> mcast_option(sa_family_t fam, mcast_opt opt) const;
 
 public:
     /** The socket 'type' for communications semantics. */
@@ -125,9 +201,11 @@ public:
     /**
      * Opens the datagram sockets and binds it to the address.
      * @param addr The address to bind the socket
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return The error code, on failure.
      */
-    result<> open(const sock_address& addr) noexcept;
+    result<> open(const sock_address& addr, int flags = 0) noexcept;
     /**
      * Creates a new datagram socket that refers to this one.
      * This creates a new object with an independent lifetime, but refers
@@ -154,6 +232,127 @@ public:
     result<> connect(const sock_address& addr) {
         return check_res_none(::connect(handle(), addr.sockaddr_ptr(), addr.size()));
     }
+
+    // ----- Batched I/O -----
+
+    /**
+     * Receives a batch of messages on a connected socket.
+     * On a blocking socket this waits for at least one message to arrive,
+     * then takes any others that are immediately available, up to the
+     * number of buffers.
+     * @param bufs The array of buffers, one per message.
+     * @param lens Array to receive the length of each message.
+     * @param n The number of buffers (the maximum number of messages).
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of messages received, or the error code on
+     *         failure.
+     */
+    result<size_t> recv_many(const iovec* bufs, size_t* lens, size_t n, int flags = 0) {
+        return recv_mmsg(bufs, lens, n, flags, nullptr, 0, 0);
+    }
+    /**
+     * Sends a batch of messages to the connected peer.
+     * @param bufs The array of buffers, one per message.
+     * @param n The number of messages to send.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of messages sent, which may be less than @em n,
+     *         or the error code on failure.
+     */
+    result<size_t> send_many(const iovec* bufs, size_t n, int flags = 0) {
+        return send_mmsg(bufs, n, flags, nullptr, 0, 0);
+    }
+
+#if defined(__linux__)
+    // ----- UDP segmentation offload -----
+
+    /**
+     * Sets the default segment size for UDP generic segmentation offload
+     * (GSO).
+     * When set, each buffer written to the socket is split by the kernel
+     * (or the NIC) into datagrams of this size, with the last one possibly
+     * shorter.
+     * @param segSize The segment size. Zero disables segmentation.
+     * @return The error code on failure.
+     */
+    result<> set_gso_segment(uint16_t segSize);
+    /**
+     * Enables or disables UDP generic receive offload (GRO).
+     * When enabled, the kernel may coalesce consecutive datagrams from the
+     * same flow into a single "super-packet". Use @ref recv_segments() or
+     * @ref recv_segments_from() to learn the size of the segments.
+     * @param on Whether to enable or disable GRO.
+     * @return The error code on failure.
+     */
+    result<> set_gro(bool on = true);
+    /**
+     * Sends a buffer as a train of equal-sized datagrams to the specified
+     * address, using UDP GSO.
+     * The whole buffer is passed to the kernel in a single call and split
+     * into datagrams of the segment size.
+     * @param buf The data to send.
+     * @param n The number of bytes in the data buffer.
+     * @param segSize The size of each datagram.
+     * @param addr The remote destination of the data.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of bytes sent on success or, the error code on
+     *         failure.
+     */
+    result<size_t> send_segments_to(
+        const void* buf, size_t n, uint16_t segSize, const sock_address& addr, int flags = 0
+    ) {
+        return send_gso(buf, n, segSize, flags, addr.sockaddr_ptr(), addr.size());
+    }
+    /**
+     * Sends a buffer as a train of equal-sized datagrams to the connected
+     * peer, using UDP GSO.
+     * @param buf The data to send.
+     * @param n The number of bytes in the data buffer.
+     * @param segSize The size of each datagram.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of bytes sent on success or, the error code on
+     *         failure.
+     */
+    result<size_t> send_segments(const void* buf, size_t n, uint16_t segSize, int flags = 0) {
+        return send_gso(buf, n, segSize, flags, nullptr, 0);
+    }
+    /**
+     * Receives a possibly-coalesced message on a socket with GRO enabled.
+     * @param buf Buffer to get the incoming data. This should be large
+     *  		  enough for a full super-packet (up to 64kB).
+     * @param n The number of bytes to read.
+     * @param segSize Gets the size of the individual datagrams in the
+     *  			  buffer. If the message was not coalesced, this is
+     *  			  the size of the whole message.
+     * @param srcAddr Receives the address of the peer that sent the
+     *  			  message
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_segments_from(
+        void* buf, size_t n, size_t* segSize, sock_address* srcAddr = nullptr, int flags = 0
+    );
+    /**
+     * Receives a possibly-coalesced message on a socket with GRO enabled.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @param segSize Gets the size of the individual datagrams in the
+     *  			  buffer.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_segments(void* buf, size_t n, size_t* segSize, int flags = 0) {
+        return recv_segments_from(buf, n, segSize, nullptr, flags);
+    }
+
+private:
+    /**
+     * Sends a GSO buffer with the segment size in the control data.
+     */
+    result<size_t> send_gso(
+        const void* buf, size_t n, uint16_t segSize, int flags, const sockaddr* addr,
+        socklen_t addrLen
+    );
+#endif
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -163,6 +362,13 @@ public:
  *
  * Datagram sockets are normally connectionless, where each packet is
  * individually routed and delivered.
+ *
+ * The IP flavors (@ref udp_socket and @ref udp6_socket) can also join
+ * multicast groups. To spread a set of feeds over several cores, give
+ * each core its own socket bound to the shared port, join just that
+ * core's groups on it, and turn off @ref multicast_all() so that the
+ * kernel doesn't deliver every group to every socket. Each socket can
+ * then drain its feeds with @ref recv_many().
  */
 template <typename ADDR>
 class datagram_socket_tmpl : public datagram_socket
@@ -214,6 +420,28 @@ public:
         base::operator=(std::move(rhs));
         return *this;
     }
+    /**
+     * Creates an unbound datagram socket with the specified options.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return The socket, or the error code on failure.
+     */
+    static result<datagram_socket_tmpl> create(int flags = 0) {
+        if (auto res = create_handle(ADDRESS_FAMILY, 0, flags); !res)
+            return res.error();
+        else {
+            datagram_socket_tmpl sock{res.value()};
+            return sock;
+        }
+    }
+    /**
+     * Opens the datagram socket and binds it to the address.
+     * @param addr The address to bind the socket
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return The error code, on failure.
+     */
+    result<> open(const ADDR& addr, int flags = 0) noexcept { return base::open(addr, flags); }
     /**
      * Creates a pair of connected stream sockets.
      *
@@ -237,6 +465,9 @@ public:
             );
         }
     }
+    using socket::address;
+    using socket::peer_address;
+
     /**
      * Gets the local address to which the socket is bound.
      * @return The local address to which the socket is bound.
@@ -331,6 +562,291 @@ public:
     result<size_t> recv_from(void* buf, size_t n, ADDR* srcAddr = nullptr) {
         return base::recv_from(buf, n, srcAddr);
     }
+
+#if !defined(_WIN32)
+    // ----- Messages with ancillary data -----
+
+    /**
+     * Sends a message with ancillary data to the specified address.
+     * @param iov The buffers for the data of the message.
+     * @param n The number of buffers.
+     * @param ctrl The control messages to send with the data.
+     * @param addr The remote destination of the message.
+     * @param flags The option bit flags. See sendmsg(2).
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> send_msg_to(
+        const iovec* iov, size_t n, const cmsg_buffer<N>& ctrl, const ADDR& addr,
+        int flags = 0
+    ) {
+        return base::send_msg_to(iov, n, ctrl, addr, flags);
+    }
+    /**
+     * Receives a message on the socket, along with its ancillary data,
+     * and the address of the sender.
+     * @param iov The buffers to get the data of the message.
+     * @param n The number of buffers.
+     * @param ctrl Gets the control messages received with the data.
+     * @param srcAddr Receives the address of the peer that sent the
+     *  			  message, if not null.
+     * @param flags The option bit flags. See recvmsg(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> recv_msg(
+        iovec* iov, size_t n, cmsg_buffer<N>& ctrl, ADDR* srcAddr = nullptr, int flags = 0
+    ) {
+        return base::recv_msg(iov, n, ctrl, srcAddr, flags);
+    }
+#endif
+
+    // ----- Batched I/O -----
+
+    /**
+     * Receives a batch of messages on the socket.
+     * On a blocking socket this waits for at least one message to arrive,
+     * then takes any others that are immediately available, up to the
+     * number of buffers.
+     * @param bufs The array of buffers, one per message.
+     * @param lens Array to receive the length of each message.
+     * @param n The number of buffers (the maximum number of messages).
+     * @param srcAddrs Array to receive the address of the sender of each
+     *  			   message, or @em nullptr if they are not wanted.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of messages received, or the error code on
+     *         failure.
+     */
+    result<size_t> recv_many(
+        const iovec* bufs, size_t* lens, size_t n, ADDR* srcAddrs = nullptr, int flags = 0
+    ) {
+        if (!srcAddrs)
+            return base::recv_mmsg(bufs, lens, n, flags, nullptr, 0, 0);
+        return base::recv_mmsg(
+            bufs, lens, n, flags, srcAddrs->sockaddr_ptr(), sizeof(ADDR), srcAddrs->size()
+        );
+    }
+    /**
+     * Sends a batch of messages, each to its own destination.
+     * @param bufs The array of buffers, one per message.
+     * @param n The number of messages to send.
+     * @param destAddrs The array of destination addresses, one per
+     *  				message. If @em nullptr, the messages are sent to the
+     *  				connected peer.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of messages sent, which may be less than @em n,
+     *         or the error code on failure.
+     */
+    result<size_t> send_many(const iovec* bufs, size_t n, const ADDR* destAddrs, int flags = 0) {
+        if (!destAddrs)
+            return base::send_many(bufs, n, flags);
+        return base::send_mmsg(
+            bufs, n, flags, destAddrs->sockaddr_ptr(), sizeof(ADDR), destAddrs->size()
+        );
+    }
+    /**
+     * Sends a batch of messages, all to the same destination.
+     * @param bufs The array of buffers, one per message.
+     * @param n The number of messages to send.
+     * @param destAddr The destination address for all the messages.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of messages sent, which may be less than @em n,
+     *         or the error code on failure.
+     */
+    result<size_t> send_many(const iovec* bufs, size_t n, const ADDR& destAddr, int flags = 0) {
+        return base::send_mmsg(bufs, n, flags, destAddr.sockaddr_ptr(), 0, destAddr.size());
+    }
+    /**
+     * Sends a batch of messages to the connected peer.
+     * @param bufs The array of buffers, one per message.
+     * @param n The number of messages to send.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of messages sent, which may be less than @em n,
+     *         or the error code on failure.
+     */
+    result<size_t> send_many(const iovec* bufs, size_t n, int flags = 0) {
+        return base::send_many(bufs, n, flags);
+    }
+
+    // ----- Multicast -----
+
+    /**
+     * Joins a multicast group.
+     * The socket should be bound to the group's port (usually with
+     * `SO_REUSEADDR` so that other sockets can share it).
+     * @param grp The multicast group address. The port is ignored.
+     * @param ifindex The index of the interface on which to join, or zero
+     *  			  to let the system choose from the routing table.
+     * @return The error code on failure.
+     */
+    result<> join_group(const ADDR& grp, unsigned ifindex = 0) {
+        return base::mcast_membership(true, grp, nullptr, ifindex);
+    }
+    /**
+     * Leaves a multicast group.
+     * @param grp The multicast group address.
+     * @param ifindex The index of the interface used to join the group.
+     * @return The error code on failure.
+     */
+    result<> leave_group(const ADDR& grp, unsigned ifindex = 0) {
+        return base::mcast_membership(false, grp, nullptr, ifindex);
+    }
+    /**
+     * Joins a source-specific multicast group, accepting only the traffic
+     * to the group from a single source.
+     * This can be called several times to accept more sources for the
+     * same group.
+     * @param grp The multicast group address.
+     * @param src The address of the source to accept.
+     * @param ifindex The index of the interface on which to join, or zero
+     *  			  to let the system choose.
+     * @return The error code on failure.
+     */
+    result<> join_source_group(const ADDR& grp, const ADDR& src, unsigned ifindex = 0) {
+        return base::mcast_membership(true, grp, &src, ifindex);
+    }
+    /**
+     * Stops accepting traffic to a source-specific multicast group from
+     * one source.
+     * @param grp The multicast group address.
+     * @param src The address of the source.
+     * @param ifindex The index of the interface used to join the group.
+     * @return The error code on failure.
+     */
+    result<> leave_source_group(const ADDR& grp, const ADDR& src, unsigned ifindex = 0) {
+        return base::mcast_membership(false, grp, &src, ifindex);
+    }
+    /**
+     * Sets the time-to-live (IPv4) or hop limit (IPv6) for outgoing
+     * multicast packets.
+     * @param ttl The number of hops, 0-255. The default is 1, which keeps
+     *  		  the packets on the local network.
+     * @return The error code on failure.
+     */
+    result<> multicast_ttl(unsigned ttl) {
+        return base::mcast_option(ADDRESS_FAMILY, mcast_opt::hops, int(ttl));
+    }
+    /**
+     * Gets the time-to-live (IPv4) or hop limit (IPv6) for outgoing
+     * multicast packets.
+     * @return The number of hops, or the error code on failure.
+     */
+    result<unsigned> multicast_ttl() const {
+        auto res = base::mcast_option(ADDRESS_FAMILY, mcast_opt::hops);
+        if (!res)
+            return res.error();
+        return unsigned(res.value());
+    }
+    /**
+     * Sets whether outgoing multicast packets are looped back to the
+     * sockets on this host that joined the group.
+     * @param on Whether to loop back outgoing packets.
+     * @return The error code on failure.
+     */
+    result<> multicast_loop(bool on) {
+        return base::mcast_option(ADDRESS_FAMILY, mcast_opt::loop, int(on));
+    }
+    /**
+     * Determines whether outgoing multicast packets are looped back to
+     * this host.
+     * @return @em true if packets are looped back, or the error code on
+     *  	   failure.
+     */
+    result<bool> multicast_loop() const {
+        auto res = base::mcast_option(ADDRESS_FAMILY, mcast_opt::loop);
+        if (!res)
+            return res.error();
+        return res.value() != 0;
+    }
+    /**
+     * Sets the interface used to send multicast packets.
+     * @param ifindex The index of the interface, or zero to use the
+     *  			  routing table.
+     * @return The error code on failure.
+     */
+    result<> multicast_interface(unsigned ifindex) {
+        return base::mcast_option(ADDRESS_FAMILY, mcast_opt::iface, int(ifindex));
+    }
+    /**
+     * Sets whether the socket receives the traffic for every group joined
+     * by any socket on the host that matches its bound address and port
+     * (`IP_MULTICAST_ALL`/`IPV6_MULTICAST_ALL`).
+     *
+     * This is on by default in Linux, which is rarely what's wanted when
+     * several sockets bind the same port to ingest different groups:
+     * without turning it off, each socket would get a copy of every feed.
+     * This is only available on Linux.
+     * @param on Whether to receive the traffic for all the joined groups.
+     * @return The error code on failure.
+     */
+    result<> multicast_all(bool on) {
+        return base::mcast_option(ADDRESS_FAMILY, mcast_opt::all, int(on));
+    }
+    /**
+     * Determines whether the socket receives the traffic for all the
+     * groups joined on the host.
+     * This is only available on Linux.
+     * @return The value of the option, or the error code on failure.
+     */
+    result<bool> multicast_all() const {
+        auto res = base::mcast_option(ADDRESS_FAMILY, mcast_opt::all);
+        if (!res)
+            return res.error();
+        return res.value() != 0;
+    }
+
+#if defined(__linux__)
+    // ----- UDP segmentation offload -----
+
+    /**
+     * Sends a buffer as a train of equal-sized datagrams to the specified
+     * address, using UDP GSO.
+     * @param buf The data to send.
+     * @param n The number of bytes in the data buffer.
+     * @param segSize The size of each datagram.
+     * @param addr The remote destination of the data.
+     * @param flags The option bit flags. See send(2).
+     * @return The number of bytes sent on success or, the error code on
+     *         failure.
+     */
+    result<size_t> send_segments_to(
+        const void* buf, size_t n, uint16_t segSize, const ADDR& addr, int flags = 0
+    ) {
+        return base::send_segments_to(buf, n, segSize, addr, flags);
+    }
+    /**
+     * Receives a possibly-coalesced message on a socket with GRO enabled.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @param segSize Gets the size of the individual datagrams in the
+     *  			  buffer.
+     * @param srcAddr Receives the address of the peer that sent the
+     *  			  message
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_segments_from(
+        void* buf, size_t n, size_t* segSize, ADDR* srcAddr = nullptr, int flags = 0
+    ) {
+        return base::recv_segments_from(buf, n, segSize, srcAddr, flags);
+    }
+    /**
+     * Receives a message on the socket, along with its kernel timestamps.
+     * See socket::enable_timestamps().
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @param ts Gets the timestamps of the message.
+     * @param srcAddr Receives the address of the peer that sent the
+     *  			  message, if not null.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_from(
+        void* buf, size_t n, packet_timestamp& ts, ADDR* srcAddr = nullptr, int flags = 0
+    ) {
+        return base::recv_from(buf, n, ts, srcAddr, flags);
+    }
+#endif
 };
 
 /////////////////////////////////////////////////////////////////////////////
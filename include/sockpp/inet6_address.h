@@ -47,9 +47,11 @@
 #ifndef __sockpp_inet6_addr_h
 #define __sockpp_inet6_addr_h
 
+#include <charconv>
 #include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "sockpp/platform.h"
 #include "sockpp/result.h"
@@ -76,6 +78,9 @@ public:
     /** The address family for this type of address */
     static constexpr sa_family_t ADDRESS_FAMILY = AF_INET6;
 
+    /** The maximum length of the string form, "[address]:port" */
+    static constexpr size_t MAX_STR_LEN = INET6_ADDRSTRLEN + 8;
+
     /**
      * Constructs an empty address.
      * The address is initialized to all zeroes.
@@ -166,6 +171,24 @@ public:
      * @param port The port number in native/host byte order.
      */
     static result<inet6_address> create(const string& saddr, in_port_t port);
+    /**
+     * Parses a numeric IPv6 address, like "fe80::1".
+     * This never does a host name lookup and doesn't allocate memory.
+     * @param str The string to parse.
+     * @return The IPv6 address, or `errc::invalid_argument` if the string
+     *  	   is not a valid address.
+     */
+    static result<in6_addr> parse_address(std::string_view str) noexcept;
+    /**
+     * Parses a numeric address with an optional port, in the form
+     * "[address]:port", like the output of @ref to_string(). A bare
+     * address, without brackets or port, is also accepted.
+     * This never does a host name lookup and doesn't allocate memory.
+     * @param str The string to parse.
+     * @return The address, with a port of zero if none was given, or
+     *  	   `errc::invalid_argument` if the string is not valid.
+     */
+    static result<inet6_address> parse(std::string_view str) noexcept;
     /**
      * Gets 128-bit IPv6 address.
      * The address is usually stored in network byte order.
@@ -224,6 +247,17 @@ public:
      *  	   '[address]:port'
      */
     string to_string() const;
+    /**
+     * Writes the address into a character buffer, in the same form as
+     * @ref to_string(), without allocating memory.
+     * The output is not NUL-terminated. A buffer of @ref MAX_STR_LEN
+     * characters is always large enough.
+     * @param first Pointer to the start of the buffer.
+     * @param last Pointer past the end of the buffer.
+     * @return The pointer past the last character written, and an error
+     *  	   of `std::errc::value_too_large` if the buffer was too small.
+     */
+    std::to_chars_result to_chars(char* first, char* last) const noexcept;
 };
 
 // --------------------------------------------------------------------------
@@ -260,7 +294,44 @@ inline bool operator!=(const in6_addr& lhs, const in6_addr& rhs) {
     return !operator==(lhs, rhs);
 }
 
+/**
+ * Orders two IPv6 addresses by address, then port, then scope.
+ * @param lhs An IPv6 address
+ * @param rhs An IPv6 address
+ * @return @em true if `lhs` orders before `rhs`.
+ */
+inline bool operator<(const inet6_address& lhs, const inet6_address& rhs) {
+    auto l = lhs.sockaddr_in6_ptr(), r = rhs.sockaddr_in6_ptr();
+    if (int cmp = std::memcmp(&l->sin6_addr, &r->sin6_addr, sizeof(in6_addr)); cmp != 0)
+        return cmp < 0;
+    if (lhs.port() != rhs.port())
+        return lhs.port() < rhs.port();
+    return l->sin6_scope_id < r->sin6_scope_id;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
 
+namespace std {
+
+/**
+ * Hash function for an IPv6 address, covering the address, port, and
+ * scope.
+ */
+template <>
+struct hash<sockpp::inet6_address>
+{
+    size_t operator()(const sockpp::inet6_address& addr) const noexcept {
+        auto sin6 = addr.sockaddr_in6_ptr();
+        uint64_t a, b;
+        std::memcpy(&a, &sin6->sin6_addr, 8);
+        std::memcpy(&b, reinterpret_cast<const uint8_t*>(&sin6->sin6_addr) + 8, 8);
+
+        uint64_t v = (uint64_t(sin6->sin6_port) << 32) | uint64_t(sin6->sin6_scope_id);
+        return size_t(sockpp::hash_mix(sockpp::hash_mix(a ^ v) ^ b));
+    }
+};
+
+}  // namespace std
+
 #endif  // __sockpp_inet6_addr_h
@@ -48,9 +48,11 @@
 #define __sockpp_inet_addr_h
 
 #include <algorithm>
+#include <charconv>
 #include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "sockpp/result.h"
 #include "sockpp/sock_address.h"
@@ -77,6 +79,9 @@ public:
     /** The address family for this type of address */
     static constexpr sa_family_t ADDRESS_FAMILY = AF_INET;
 
+    /** The maximum length of the string form, "ddd.ddd.ddd.ddd:ppppp" */
+    static constexpr size_t MAX_STR_LEN = 21;
+
     /**
      * Constructs an empty address.
      * The address is initialized to all zeroes.
@@ -156,6 +161,26 @@ public:
      * @return The internet address in network byte order.
      */
     static result<in_addr_t> resolve_name(const string& saddr) noexcept;
+    /**
+     * Parses a numeric IPv4 address in dotted-decimal notation, like
+     * "192.168.1.1".
+     * This never does a host name lookup and doesn't allocate memory.
+     * Only the full, four-part form is accepted, without leading zeros.
+     * @param str The string to parse.
+     * @return The internet address in network byte order, or
+     *  	   `errc::invalid_argument` if the string is not a valid
+     *  	   address.
+     */
+    static result<in_addr_t> parse_address(std::string_view str) noexcept;
+    /**
+     * Parses a numeric address with an optional port, in the form
+     * "address[:port]", like the output of @ref to_string().
+     * This never does a host name lookup and doesn't allocate memory.
+     * @param str The string to parse.
+     * @return The address, with a port of zero if none was given, or
+     *  	   `errc::invalid_argument` if the string is not valid.
+     */
+    static result<inet_address> parse(std::string_view str) noexcept;
     /**
      * Gets the 32-bit internet address.
      * @return The internet address in the local host's byte order.
@@ -214,6 +239,17 @@ public:
      *  	   'address:port'
      */
     string to_string() const;
+    /**
+     * Writes the address into a character buffer, in the same form as
+     * @ref to_string(), without allocating memory.
+     * The output is not NUL-terminated. A buffer of @ref MAX_STR_LEN
+     * characters is always large enough.
+     * @param first Pointer to the start of the buffer.
+     * @param last Pointer past the end of the buffer.
+     * @return The pointer past the last character written, and an error
+     *  	   of `std::errc::value_too_large` if the buffer was too small.
+     */
+    std::to_chars_result to_chars(char* first, char* last) const noexcept;
 };
 
 // --------------------------------------------------------------------------
@@ -228,7 +264,37 @@ public:
  */
 std::ostream& operator<<(std::ostream& os, const inet_address& addr);
 
+/**
+ * Orders two IPv4 addresses by address, then port.
+ * @param lhs An IPv4 address
+ * @param rhs An IPv4 address
+ * @return @em true if `lhs` orders before `rhs`.
+ */
+inline bool operator<(const inet_address& lhs, const inet_address& rhs) {
+    auto la = lhs.address(), ra = rhs.address();
+    return (la != ra) ? (la < ra) : (lhs.port() < rhs.port());
+}
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
 
+namespace std {
+
+/**
+ * Hash function for an IPv4 address, covering the family, address, and
+ * port.
+ */
+template <>
+struct hash<sockpp::inet_address>
+{
+    size_t operator()(const sockpp::inet_address& addr) const noexcept {
+        auto sin = addr.sockaddr_in_ptr();
+        uint64_t v = (uint64_t(sin->sin_family) << 48) | (uint64_t(sin->sin_port) << 32) |
+                     uint64_t(sin->sin_addr.s_addr);
+        return size_t(sockpp::hash_mix(v));
+    }
+};
+
+}  // namespace std
+
 #endif  // __sockpp_inet_addr_h
@@ -0,0 +1,323 @@
+/**
+ * @file inet_any_address.h
+ *
+ * A compact socket address that holds either an IPv4 or IPv6 address.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_inet_any_address_h
+#define __sockpp_inet_any_address_h
+
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "sockpp/inet6_address.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/result.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A compact address that can hold either an IPv4 or IPv6 address.
+ *
+ * A generic @ref sock_address_any holds a full `sockaddr_storage`, which
+ * is 128 bytes on most systems, even though an IP peer only ever needs 16
+ * or 28 of them. This class holds just the union of `sockaddr_in` and
+ * `sockaddr_in6`, and is a plain value with no virtual table, so it is no
+ * bigger than the largest of those, making it suitable to keep in a
+ * per-connection struct.
+ *
+ * Since it is not derived from @ref sock_address, it can't be handed to
+ * functions that take a generic address, but it can be filled directly by
+ * @ref acceptor::accept(), @ref socket::address(), and
+ * @ref socket::peer_address(), and converted to the specific address
+ * types when needed.
+ */
+class inet_any_address
+{
+    /** Storage for an IPv4 or IPv6 address */
+    union {
+        sockaddr sa;
+        sockaddr_in in;
+        sockaddr_in6 in6;
+    } addr_{};
+
+public:
+    /** The maximum size of the address, in bytes */
+    static constexpr socklen_t MAX_SZ = socklen_t(sizeof(sockaddr_in6));
+
+    /** The maximum length of the string form of the address */
+    static constexpr size_t MAX_STR_LEN = inet6_address::MAX_STR_LEN;
+
+    /**
+     * Constructs an empty address.
+     * The family is AF_UNSPEC until an address is assigned.
+     */
+    inet_any_address() noexcept = default;
+    /**
+     * Constructs the address from an IPv4 address.
+     * @param addr The IPv4 address.
+     */
+    inet_any_address(const inet_address& addr) noexcept {
+        addr_.in = *addr.sockaddr_in_ptr();
+    }
+    /**
+     * Constructs the address from an IPv6 address.
+     * @param addr The IPv6 address.
+     */
+    inet_any_address(const inet6_address& addr) noexcept {
+        addr_.in6 = *addr.sockaddr_in6_ptr();
+    }
+    /**
+     * Creates the address from a generic socket address.
+     * @param addr An IPv4 or IPv6 address.
+     * @return The address, or `errc::address_family_not_supported` if the
+     *  	   address is not an IPv4 or IPv6 address.
+     */
+    static result<inet_any_address> create(const sock_address& addr) noexcept {
+        inet_any_address any;
+        if (!any.assign(addr.sockaddr_ptr(), addr.size()))
+            return errc::address_family_not_supported;
+        return any;
+    }
+    /**
+     * Sets the address from a raw C address struct.
+     * If the address is not a complete IPv4 or IPv6 address, this is left
+     * unset.
+     * @param addr Pointer to the address.
+     * @param len The length of the address, in bytes.
+     * @return @em true if the address was IPv4 or IPv6 and was set, @em
+     *  	   false otherwise.
+     */
+    bool assign(const sockaddr* addr, socklen_t len) noexcept {
+        addr_ = {};
+        if (!addr)
+            return false;
+
+        if (addr->sa_family == AF_INET && len >= socklen_t(sizeof(sockaddr_in)))
+            std::memcpy(&addr_.in, addr, sizeof(sockaddr_in));
+        else if (addr->sa_family == AF_INET6 && len >= socklen_t(sizeof(sockaddr_in6)))
+            std::memcpy(&addr_.in6, addr, sizeof(sockaddr_in6));
+        else
+            return false;
+        return true;
+    }
+    /**
+     * Clears the address, making it unset.
+     */
+    void clear() noexcept { addr_ = {}; }
+    /**
+     * Gets the network family of the address.
+     * @return The network family: AF_INET, AF_INET6, or AF_UNSPEC if the
+     *  	   address is not set.
+     */
+    sa_family_t family() const noexcept { return addr_.sa.sa_family; }
+    /**
+     * Determines if this is an IPv4 address.
+     * @return @em true if this is an IPv4 address.
+     */
+    bool is_v4() const noexcept { return family() == AF_INET; }
+    /**
+     * Determines if this is an IPv6 address.
+     * @return @em true if this is an IPv6 address.
+     */
+    bool is_v6() const noexcept { return family() == AF_INET6; }
+    /**
+     * Determines if the address has been set.
+     * @return @em true if the address holds an IPv4 or IPv6 address.
+     */
+    bool is_set() const noexcept { return is_v4() || is_v6(); }
+    /**
+     * Determines if the address has been set.
+     * @return @em true if the address holds an IPv4 or IPv6 address.
+     */
+    explicit operator bool() const noexcept { return is_set(); }
+    /**
+     * Gets the size of the address.
+     * @return The size of the `sockaddr_in` or `sockaddr_in6` for the
+     *  	   address, or zero if it is not set.
+     */
+    socklen_t size() const noexcept {
+        return is_v4() ? socklen_t(sizeof(sockaddr_in)) : (is_v6() ? MAX_SZ : 0);
+    }
+    /**
+     * Gets a pointer to this object cast to a @em sockaddr.
+     * @return A pointer to this object cast to a @em sockaddr.
+     */
+    const sockaddr* sockaddr_ptr() const noexcept { return &addr_.sa; }
+    /**
+     * Gets a pointer to this object cast to a @em sockaddr.
+     * @return A pointer to this object cast to a @em sockaddr.
+     */
+    sockaddr* sockaddr_ptr() noexcept { return &addr_.sa; }
+    /**
+     * Gets the port number.
+     * @return The port number in native/host byte order, or zero if the
+     *  	   address is not set.
+     */
+    in_port_t port() const noexcept {
+        if (is_v4())
+            return ntohs(addr_.in.sin_port);
+        return is_v6() ? ntohs(addr_.in6.sin6_port) : 0;
+    }
+    /**
+     * Gets the address as an IPv4 address.
+     * @return The IPv4 address, or an unset address if this is not IPv4.
+     */
+    inet_address to_inet() const noexcept {
+        return is_v4() ? inet_address{addr_.in} : inet_address{};
+    }
+    /**
+     * Gets the address as an IPv6 address.
+     * @return The IPv6 address, or an unset address if this is not IPv6.
+     */
+    inet6_address to_inet6() const noexcept {
+        return is_v6() ? inet6_address{addr_.in6} : inet6_address{};
+    }
+    /**
+     * Gets the address as a generic socket address.
+     * @return The address as a generic socket address.
+     */
+    sock_address_any to_sock_address_any() const {
+        return sock_address_any{sockaddr_ptr(), size()};
+    }
+    /**
+     * Writes a printable string for the address into a character buffer.
+     * This uses the same format as @ref inet_address or @ref inet6_address,
+     * and produces nothing if the address is not set.
+     * The output is not NUL-terminated. A buffer of @ref MAX_STR_LEN
+     * characters is always large enough.
+     * @param first Pointer to the start of the buffer.
+     * @param last Pointer to one past the end of the buffer.
+     * @return The end of the written string, or an error if the buffer
+     *  	   was too small.
+     */
+    std::to_chars_result to_chars(char* first, char* last) const noexcept {
+        if (is_v4())
+            return to_inet().to_chars(first, last);
+        if (is_v6())
+            return to_inet6().to_chars(first, last);
+        return {first, std::errc{}};
+    }
+    /**
+     * Gets a printable string for the address.
+     * @return A string representation of the address.
+     */
+    std::string to_string() const {
+        char buf[MAX_STR_LEN];
+        auto res = to_chars(buf, buf + MAX_STR_LEN);
+        return std::string(buf, res.ptr);
+    }
+};
+
+static_assert(sizeof(inet_any_address) <= 32, "inet_any_address should be compact");
+
+// --------------------------------------------------------------------------
+
+/**
+ * Determines if the two objects refer to the same address.
+ * @param lhs An address
+ * @param rhs An address
+ * @return @em true if `lhs` and `rhs` refer to the same address.
+ */
+inline bool operator==(const inet_any_address& lhs, const inet_any_address& rhs) noexcept {
+    return lhs.size() == rhs.size() &&
+           std::memcmp(lhs.sockaddr_ptr(), rhs.sockaddr_ptr(), lhs.size()) == 0;
+}
+
+/**
+ * Determines if the two objects refer to different addresses.
+ * @param lhs An address
+ * @param rhs An address
+ * @return @em true if `lhs` and `rhs` refer to different addresses.
+ */
+inline bool operator!=(const inet_any_address& lhs, const inet_any_address& rhs) noexcept {
+    return !operator==(lhs, rhs);
+}
+
+/**
+ * Orders two addresses, with the same ordering as @ref sock_address.
+ * @param lhs An address
+ * @param rhs An address
+ * @return @em true if `lhs` orders before `rhs`.
+ */
+inline bool operator<(const inet_any_address& lhs, const inet_any_address& rhs) noexcept {
+    if (lhs.size() != rhs.size())
+        return lhs.size() < rhs.size();
+    return std::memcmp(lhs.sockaddr_ptr(), rhs.sockaddr_ptr(), lhs.size()) < 0;
+}
+
+/**
+ * Stream inserter for the address.
+ * @param os The output stream
+ * @param addr The address
+ * @return A reference to the output stream.
+ */
+inline std::ostream& operator<<(std::ostream& os, const inet_any_address& addr) {
+    char buf[inet_any_address::MAX_STR_LEN];
+    auto res = addr.to_chars(buf, buf + sizeof(buf));
+    return os.write(buf, res.ptr - buf);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+namespace std {
+
+/**
+ * Hash function for a compact IP address.
+ */
+template <>
+struct hash<sockpp::inet_any_address>
+{
+    size_t operator()(const sockpp::inet_any_address& addr) const noexcept {
+        return size_t(sockpp::hash_bytes(addr.sockaddr_ptr(), addr.size()));
+    }
+};
+
+}  // namespace std
+
+#endif  // __sockpp_inet_any_address_h
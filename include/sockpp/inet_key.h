@@ -0,0 +1,242 @@
+/**
+ * @file inet_key.h
+ *
+ * A compact, normalized key for IPv4 and IPv6 addresses, for use in hash
+ * tables and sorted containers.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_inet_key_h
+#define __sockpp_inet_key_h
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#include "sockpp/inet6_address.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/result.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A compact key for an IPv4 or IPv6 address and port.
+ *
+ * This is an 18-byte value holding a 16-byte IPv6 address and a 2-byte
+ * port, both in network byte order. An IPv4 address is stored in the
+ * IPv4-mapped IPv6 form (::ffff:a.b.c.d), so the same peer gets the same
+ * key whether it connected over an IPv4 or a dual-stack IPv6 socket.
+ *
+ * A key has no alignment requirement, so a table with a large number of
+ * peers can be kept much smaller than one storing full socket address
+ * structs. Keys are equality comparable, ordered (by address, then
+ * port), and hashable with `std::hash`.
+ *
+ * The IPv6 flow info and scope ID are not part of the key.
+ */
+class inet_key
+{
+    /** The IPv6 address, or IPv4-mapped address, in network byte order */
+    uint8_t addr_[16]{};
+    /** The port in network byte order */
+    uint8_t port_[2]{};
+
+    /** The prefix of an IPv4-mapped IPv6 address */
+    static constexpr uint8_t V4_PREFIX[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+
+public:
+    /** The size of a key, in bytes */
+    static constexpr size_t SIZE = 18;
+
+    /**
+     * Creates an empty key, for the unspecified address "::" and port 0.
+     */
+    inet_key() noexcept = default;
+    /**
+     * Creates a key for an IPv4 address.
+     * @param addr The IPv4 address.
+     */
+    inet_key(const inet_address& addr) noexcept {
+        auto sin = addr.sockaddr_in_ptr();
+        std::memcpy(addr_, V4_PREFIX, sizeof(V4_PREFIX));
+        std::memcpy(addr_ + 12, &sin->sin_addr, 4);
+        std::memcpy(port_, &sin->sin_port, 2);
+    }
+    /**
+     * Creates a key for an IPv6 address.
+     * @param addr The IPv6 address.
+     */
+    inet_key(const inet6_address& addr) noexcept {
+        auto sin6 = addr.sockaddr_in6_ptr();
+        std::memcpy(addr_, &sin6->sin6_addr, 16);
+        std::memcpy(port_, &sin6->sin6_port, 2);
+    }
+    /**
+     * Creates a key for a generic socket address.
+     * @param addr An IPv4 or IPv6 address.
+     * @return The key, or `errc::address_family_not_supported` if the
+     *  	   address is not an IPv4 or IPv6 address.
+     */
+    static result<inet_key> create(const sock_address& addr) noexcept {
+        switch (addr.family()) {
+            case AF_INET:
+                return inet_key{inet_address{addr}};
+            case AF_INET6:
+                return inet_key{inet6_address{addr}};
+            default:
+                return errc::address_family_not_supported;
+        }
+    }
+    /**
+     * Determines if the key is for an IPv4 address.
+     * @return @em true if the key holds an IPv4-mapped address.
+     */
+    bool is_v4() const noexcept {
+        return std::memcmp(addr_, V4_PREFIX, sizeof(V4_PREFIX)) == 0;
+    }
+    /**
+     * Gets the port number.
+     * @return The port number in native/host byte order.
+     */
+    in_port_t port() const noexcept {
+        return in_port_t((unsigned(port_[0]) << 8) | unsigned(port_[1]));
+    }
+    /**
+     * Gets a pointer to the raw bytes of the key.
+     * @return A pointer to the @ref SIZE bytes of the key.
+     */
+    const uint8_t* data() const noexcept { return addr_; }
+    /**
+     * Gets the IPv4 address for the key.
+     * This is only meaningful if @ref is_v4() is true.
+     * @return The IPv4 address.
+     */
+    inet_address to_inet() const noexcept {
+        uint32_t a;
+        std::memcpy(&a, addr_ + 12, 4);
+        return inet_address{ntohl(a), port()};
+    }
+    /**
+     * Gets the IPv6 address for the key.
+     * An IPv4 key gives the IPv4-mapped IPv6 address.
+     * @return The IPv6 address.
+     */
+    inet6_address to_inet6() const noexcept {
+        in6_addr a;
+        std::memcpy(&a, addr_, 16);
+        return inet6_address{a, port()};
+    }
+    /**
+     * Gets a hash value for the key.
+     * @return A hash value for the key.
+     */
+    size_t hash() const noexcept {
+        uint64_t a, b;
+        std::memcpy(&a, addr_, 8);
+        std::memcpy(&b, addr_ + 8, 8);
+        uint64_t p = (uint64_t(port_[0]) << 8) | uint64_t(port_[1]);
+        return size_t(hash_mix(hash_mix(a ^ p) ^ b));
+    }
+    /**
+     * Compares two keys, by address, then port.
+     * @param rhs The other key.
+     * @return A negative value if this key orders before `rhs`, zero if
+     *  	   they are the same, and a positive value otherwise.
+     */
+    int compare(const inet_key& rhs) const noexcept {
+        return std::memcmp(addr_, rhs.addr_, SIZE);
+    }
+};
+
+static_assert(sizeof(inet_key) == inet_key::SIZE, "inet_key must be packed");
+
+// --------------------------------------------------------------------------
+
+/** Determines if two keys are the same */
+inline bool operator==(const inet_key& lhs, const inet_key& rhs) noexcept {
+    return lhs.compare(rhs) == 0;
+}
+
+/** Determines if two keys are different */
+inline bool operator!=(const inet_key& lhs, const inet_key& rhs) noexcept {
+    return lhs.compare(rhs) != 0;
+}
+
+/** Determines if one key orders before another */
+inline bool operator<(const inet_key& lhs, const inet_key& rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+/** Determines if one key orders before, or is the same as, another */
+inline bool operator<=(const inet_key& lhs, const inet_key& rhs) noexcept {
+    return lhs.compare(rhs) <= 0;
+}
+
+/** Determines if one key orders after another */
+inline bool operator>(const inet_key& lhs, const inet_key& rhs) noexcept {
+    return lhs.compare(rhs) > 0;
+}
+
+/** Determines if one key orders after, or is the same as, another */
+inline bool operator>=(const inet_key& lhs, const inet_key& rhs) noexcept {
+    return lhs.compare(rhs) >= 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+namespace std {
+
+/**
+ * Hash function for an address key.
+ */
+template <>
+struct hash<sockpp::inet_key>
+{
+    size_t operator()(const sockpp::inet_key& key) const noexcept { return key.hash(); }
+};
+
+}  // namespace std
+
+#endif  // __sockpp_inet_key_h
@@ -0,0 +1,437 @@
+/**
+ * @file io_context.h
+ *
+ * Event loops with cross-thread task queues, and a pool of them, one per core.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_io_context_h
+#define __sockpp_io_context_h
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sockpp/notifier.h"
+#include "sockpp/reactor.h"
+#include "sockpp/socket_stats.h"
+
+namespace sockpp {
+
+class io_context_pool;
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An event loop that runs a reactor on its own thread, and accepts work
+ * from other threads.
+ *
+ * The reactor itself is single-threaded. Everything that touches it,
+ * and the sockets registered with it, must be done on the loop's thread.
+ * Other threads hand work to the loop with @ref post(), which places a
+ * function on a lock-free queue and wakes the loop if it's waiting for
+ * I/O. That is how, for example, data is written to a connection owned by
+ * another loop, without sharing (or duplicating) its socket.
+ *
+ * Work that can run on any loop is given to a context with @ref submit().
+ * When a context is part of an @ref io_context_pool, an idle loop can
+ * take submitted work from a busy one.
+ *
+ * Functions that are posted or submitted can be move-only, such as a
+ * lambda that holds a socket. Each one costs a single allocation.
+ */
+class io_context
+{
+    /** A queued function */
+    struct task_base
+    {
+        task_base* next{nullptr};
+        virtual ~task_base() {}
+        virtual void run() = 0;
+    };
+
+    template <typename F>
+    struct task_impl : task_base
+    {
+        F fn;
+        explicit task_impl(F&& f) : fn{std::move(f)} {}
+        void run() override { fn(); }
+    };
+
+    template <typename F>
+    static task_base* make_task(F&& fn) {
+        return new task_impl<std::decay_t<F>>{std::decay_t<F>{std::forward<F>(fn)}};
+    }
+
+    /** The reactor that runs the loop's sockets */
+    reactor rctr_;
+    /** The pool that owns this context, if any */
+    io_context_pool* pool_{nullptr};
+
+    /**
+     * The functions posted to this loop, as a lock-free stack. The loop
+     * takes the whole stack at once, and reverses it to run in order.
+     */
+    std::atomic<task_base*> posted_{nullptr};
+
+    /** Lock for the submitted work, which other loops can steal */
+    mutable std::mutex workMtx_;
+    /** Submitted work that can run on any loop */
+    std::deque<task_base*> work_;
+
+    /** Wakes the loop when work arrives from another thread */
+    notifier wake_;
+    /** Whether the loop is waiting for I/O with nothing else to do */
+    std::atomic<bool> idle_{false};
+    /** Whether the loop should stop */
+    std::atomic<bool> stopped_{false};
+    /** The number of sockets registered with the reactor */
+    std::atomic<size_t> load_{0};
+    /** The thread running the loop */
+    std::atomic<std::thread::id> owner_{};
+    /** The CPU that the loop's thread is pinned to, or -1 */
+    int cpu_{-1};
+
+    friend class io_context_pool;
+
+    // Non-copyable
+    io_context(const io_context&) = delete;
+    io_context& operator=(const io_context&) = delete;
+
+    /** Registers the wakeup handle with the reactor */
+    result<> add_wakeup();
+    /** Pushes a function onto the posted stack, and wakes the loop */
+    void push_posted(task_base* t);
+    /** Adds a function to the submitted work, and wakes a loop */
+    void push_work(task_base* t);
+    /** Takes one function from the submitted work, if there is any */
+    task_base* pop_work();
+    /** Runs all of the posted functions */
+    bool run_posted();
+    /** Runs one piece of submitted work, stealing it if need be */
+    bool run_work();
+    /** Determines if anything is queued for this loop */
+    bool has_work() const;
+
+public:
+    /**
+     * Creates an event loop.
+     * @throws std::system_error if the OS resources can't be created.
+     */
+    io_context();
+    /**
+     * Creates an event loop.
+     * @param ec Gets the error code on failure.
+     */
+    explicit io_context(error_code& ec) noexcept;
+    /**
+     * Destroys the loop, discarding any functions that didn't run.
+     * The loop must not be running.
+     */
+    ~io_context();
+    /**
+     * Gets the loop's reactor.
+     * This should only be used from the loop's own thread.
+     * @return The loop's reactor.
+     */
+    reactor& get_reactor() noexcept { return rctr_; }
+    /**
+     * Runs a function on the loop's thread.
+     * Functions posted from one thread run in the order they were posted.
+     * This can be called from any thread.
+     * @param fn The function to run. It is called with no arguments.
+     */
+    template <typename F>
+    void post(F&& fn) {
+        push_posted(make_task(std::forward<F>(fn)));
+    }
+    /**
+     * Runs a function on the loop, or on any other loop in its pool that
+     * is idle.
+     * This can be called from any thread.
+     * @param fn The function to run. It is called with no arguments.
+     */
+    template <typename F>
+    void submit(F&& fn) {
+        push_work(make_task(std::forward<F>(fn)));
+    }
+    /**
+     * Wakes the loop if it's waiting for I/O.
+     * This can be called from any thread.
+     */
+    void wake() noexcept;
+    /**
+     * Runs the event loop on the calling thread until @ref stop() is
+     * called.
+     * Unlike @ref reactor::run(), this doesn't return when there are no
+     * sockets, since work can arrive from other threads. A stop that was
+     * requested before the loop started still holds, so this returns
+     * right away. Call @ref restart() to run the loop again after a stop.
+     * @return The error code if the loop exited due to an error.
+     */
+    result<> run();
+    /**
+     * Requests that the event loop stop.
+     * This can be called from any thread.
+     */
+    void stop() noexcept;
+    /**
+     * Clears a stop request, so that the loop can be run again.
+     * This must not be called while the loop is running.
+     */
+    void restart() noexcept { stopped_ = false; }
+    /**
+     * Determines if the loop was requested to stop.
+     * @return @em true if the loop was requested to stop.
+     */
+    bool stopped() const noexcept { return stopped_; }
+    /**
+     * Gets the load on the loop, as the number of sockets registered with
+     * its reactor. This is updated on each pass of the loop, and can be
+     * read from any thread.
+     * @return The number of sockets registered with the loop.
+     */
+    size_t load() const noexcept { return load_.load(std::memory_order_relaxed); }
+    /**
+     * Determines if the calling thread is the one running the loop.
+     * @return @em true if called from within the loop.
+     */
+    bool running_in_this_thread() const noexcept {
+        return owner_.load() == std::this_thread::get_id();
+    }
+    /**
+     * Gets the CPU that the loop's thread is pinned to.
+     * @return The CPU number, or -1 if the thread isn't pinned.
+     */
+    int cpu() const noexcept { return cpu_; }
+    /**
+     * Gets the latency histograms recorded on the loop's thread.
+     * This can be called from any thread, while the loop is running.
+     * They're empty unless the library is built with `SOCKPP_WITH_STATS`.
+     * @return The latency histograms for the loop.
+     */
+    latency_stats latency() const { return latency_stats::snapshot(owner_.load()); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A pool of event loops, each running on its own thread.
+ *
+ * This is the usual way to spread a large number of connections across
+ * the cores of a machine. A server typically accepts connections on one
+ * thread (or on each loop, with an @ref acceptor_group) and hands each
+ * one to a loop chosen with @ref next() (round-robin) or
+ * @ref least_loaded(), by posting a function that registers it with that
+ * loop's reactor. From then on, the connection is owned by that loop.
+ *
+ * A connection can also be handed to the loop chosen by the pool's
+ * @ref placement policy, with @ref place(). On Linux, when the loops are
+ * pinned to CPUs, the @ref placement::incoming_cpu policy hands each
+ * connection to the loop running on the CPU that received its packets,
+ * so that the kernel's receive processing, the application, and the
+ * socket's memory all stay on one core. This pairs well with an
+ * @ref acceptor_group that steers connections by CPU.
+ *
+ * Work given to the pool with @ref submit() isn't tied to a loop; it is
+ * queued on one, round-robin, and idle loops steal it from the busy ones.
+ */
+class io_context_pool
+{
+public:
+    /**
+     * The ways that @ref place() can choose a loop for a connection.
+     *
+     * The policies that use the socket's receive information fall back to
+     * round-robin when it isn't available, as on systems other than Linux,
+     * or before the socket has received anything.
+     */
+    enum class placement {
+        /** Each connection goes to the next loop in turn */
+        round_robin,
+        /** Each connection goes to the loop with the fewest sockets */
+        least_loaded,
+        /**
+         * Each connection goes to the loop for the CPU that received it
+         * (`SO_INCOMING_CPU`). Loop @em i handles CPU @em i, modulo the
+         * size of the pool, which is exact when the pool was started with
+         * the loops pinned and has a loop for each CPU.
+         */
+        incoming_cpu,
+        /**
+         * Connections received on the same device queue (`SO_INCOMING_NAPI_ID`)
+         * all go to the same loop. This keeps the connections from each
+         * queue together when the loops aren't pinned.
+         */
+        napi_id
+    };
+
+private:
+    /** The event loops */
+    std::vector<std::unique_ptr<io_context>> ctxs_;
+    /** The threads running the loops */
+    std::vector<std::thread> threads_;
+    /** The next loop for round-robin assignment */
+    std::atomic<size_t> next_{0};
+    /** How place() chooses a loop */
+    placement placement_{placement::round_robin};
+
+    friend class io_context;
+
+    // Non-copyable
+    io_context_pool(const io_context_pool&) = delete;
+    io_context_pool& operator=(const io_context_pool&) = delete;
+
+    /** Finds a loop, other than `self`, that is idle, or null if none. */
+    io_context* find_idle(const io_context* self) const;
+    /** Steals one piece of submitted work from a loop other than `self`. */
+    io_context::task_base* steal(const io_context* self);
+
+public:
+    /**
+     * Gets the default number of loops for a pool.
+     * This is the number of hardware threads on the host.
+     * @return The default number of loops for a pool.
+     */
+    static size_t default_size() noexcept {
+        auto n = std::thread::hardware_concurrency();
+        return n ? size_t(n) : size_t(1);
+    }
+    /**
+     * Creates a pool of event loops. The loops are not started.
+     * @param n The number of loops.
+     * @throws std::system_error if the OS resources can't be created.
+     */
+    explicit io_context_pool(size_t n = default_size());
+    /**
+     * Stops the loops and waits for the threads to exit.
+     */
+    ~io_context_pool();
+    /**
+     * Starts a thread to run each of the loops.
+     * Any earlier stop request is cleared first, so a pool that was
+     * stopped and joined can be started again.
+     * @param pinToCpus Whether to pin the thread for loop @em i to CPU
+     *  				@em i. Pinning is best effort, and is only done on
+     *  				Linux.
+     */
+    void start(bool pinToCpus = false);
+    /**
+     * Requests that all of the loops stop.
+     */
+    void stop() noexcept;
+    /**
+     * Waits for all of the loop threads to exit.
+     */
+    void join();
+    /**
+     * Gets the number of loops in the pool.
+     * @return The number of loops in the pool.
+     */
+    size_t size() const noexcept { return ctxs_.size(); }
+    /**
+     * Gets a loop by index.
+     * @param i The index of the loop, less than @ref size().
+     * @return A reference to the loop.
+     */
+    io_context& operator[](size_t i) noexcept { return *ctxs_[i]; }
+    /**
+     * Gets the next loop, in round-robin order.
+     * @return A reference to a loop.
+     */
+    io_context& next() noexcept {
+        return *ctxs_[next_.fetch_add(1, std::memory_order_relaxed) % ctxs_.size()];
+    }
+    /**
+     * Gets the loop with the fewest sockets registered.
+     * @return A reference to a loop.
+     */
+    io_context& least_loaded() noexcept;
+    /**
+     * Gets the loop for a CPU.
+     * @param cpu The CPU number. If it's negative, the next loop in
+     *  		  round-robin order is returned.
+     * @return A reference to the loop that handles the CPU.
+     */
+    io_context& for_cpu(int cpu) noexcept {
+        return (cpu < 0) ? next() : *ctxs_[size_t(cpu) % ctxs_.size()];
+    }
+    /**
+     * Gets the policy that @ref place() uses to choose a loop.
+     * @return The placement policy.
+     */
+    placement placement_policy() const noexcept { return placement_; }
+    /**
+     * Sets the policy that @ref place() uses to choose a loop.
+     * This should be set before connections are placed.
+     * @param p The placement policy.
+     */
+    void placement_policy(placement p) noexcept { placement_ = p; }
+    /**
+     * Chooses the loop to handle a connection, according to the placement
+     * policy.
+     * This is typically called right after a connection is accepted, and
+     * the socket is then posted to the loop.
+     * @param sock The connected socket.
+     * @return A reference to the loop that should handle the socket.
+     */
+    io_context& place(const socket& sock) noexcept;
+    /**
+     * Runs a function on whichever loop gets to it first.
+     * This can be called from any thread.
+     * @param fn The function to run. It is called with no arguments.
+     */
+    template <typename F>
+    void submit(F&& fn) {
+        next().submit(std::forward<F>(fn));
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_io_context_h
@@ -0,0 +1,161 @@
+/**
+ * @file iovec_array.h
+ *
+ * Fixed-capacity, inline array of I/O vectors for scatter/gather I/O.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_iovec_array_h
+#define __sockpp_iovec_array_h
+
+#include <string>
+
+#include "sockpp/platform.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A fixed-capacity array of I/O vectors, held inline.
+ *
+ * This is a simple way to build up the list of memory ranges for a
+ * scatter/gather read or write, such as a header followed by a payload,
+ * without any heap allocation. It can live on the stack, and is passed to
+ * the socket I/O calls that take a pointer and count of iovec's.
+ *
+ * The array only refers to the memory ranges; it does not own them.
+ *
+ * @tparam N The maximum number of ranges in the array.
+ */
+template <size_t N>
+class iovec_array
+{
+    /** The ranges */
+    iovec vec_[N];
+    /** The number of ranges currently in use */
+    size_t n_{0};
+
+public:
+    /**
+     * Creates an empty array.
+     */
+    iovec_array() noexcept = default;
+    /**
+     * Gets a pointer to the first range.
+     * @return A pointer to the first range.
+     */
+    const iovec* data() const noexcept { return vec_; }
+    /**
+     * Gets the number of ranges in the array.
+     * @return The number of ranges in the array.
+     */
+    size_t size() const noexcept { return n_; }
+    /**
+     * Gets the maximum number of ranges in the array.
+     * @return The maximum number of ranges in the array.
+     */
+    static constexpr size_t capacity() noexcept { return N; }
+    /**
+     * Determines if there are no ranges in the array.
+     * @return @em true if the array is empty.
+     */
+    bool empty() const noexcept { return n_ == 0; }
+    /**
+     * Determines if the array is at capacity.
+     * @return @em true if no more ranges can be added.
+     */
+    bool full() const noexcept { return n_ == N; }
+    /**
+     * Removes all the ranges from the array.
+     */
+    void clear() noexcept { n_ = 0; }
+    /**
+     * Gets a range from the array.
+     * @param i The index of the range. This is not range-checked.
+     * @return A reference to the range.
+     */
+    const iovec& operator[](size_t i) const noexcept { return vec_[i]; }
+    /**
+     * Gets the total number of bytes in all the ranges.
+     * @return The total number of bytes in all the ranges.
+     */
+    size_t total_size() const noexcept {
+        size_t sz = 0;
+        for (size_t i = 0; i < n_; ++i) sz += vec_[i].iov_len;
+        return sz;
+    }
+    /**
+     * Adds a memory range to the end of the array.
+     * @param buf Pointer to the start of the range.
+     * @param n The number of bytes in the range.
+     * @return @em true if the range was added, @em false if the array was
+     *  	   already full.
+     */
+    bool push_back(const void* buf, size_t n) noexcept {
+        if (n_ == N)
+            return false;
+        vec_[n_++] = iovec{const_cast<void*>(buf), n};
+        return true;
+    }
+    /**
+     * Adds the contents of a string to the end of the array.
+     * The string must outlive the I/O operation.
+     * @param s The string.
+     * @return @em true if the range was added, @em false if the array was
+     *  	   already full.
+     */
+    bool push_back(const string& s) noexcept { return push_back(s.data(), s.size()); }
+    /**
+     * Adds an existing I/O vector to the end of the array.
+     * @param v The I/O vector.
+     * @return @em true if the range was added, @em false if the array was
+     *  	   already full.
+     */
+    bool push_back(const iovec& v) noexcept { return push_back(v.iov_base, v.iov_len); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_iovec_array_h
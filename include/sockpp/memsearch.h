@@ -0,0 +1,142 @@
+/**
+ * @file memsearch.h
+ *
+ * Vectorized searches for bytes and byte sequences in memory.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_memsearch_h
+#define __sockpp_memsearch_h
+
+#include <cstddef>
+#include <string_view>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The instruction sets that can be used to search memory.
+ *
+ * The x86 kernels are all built into the library on x86-64, and the best
+ * one that the CPU supports is picked the first time a search is done.
+ * NEON is part of the base 64-bit ARM architecture, so it's always used
+ * there. The generic kernel is plain memchr() and memcmp(), and is used on
+ * other CPUs, or when the library is built without SOCKPP_WITH_SIMD.
+ */
+enum class search_kernel { generic, sse2, avx2, neon };
+
+/**
+ * Gets a readable name for a search kernel, like "avx2".
+ * @param k The kernel.
+ * @return The name of the kernel.
+ */
+const char* to_string(search_kernel k);
+
+/**
+ * Determines if a search kernel can be used on this CPU.
+ * @param k The kernel.
+ * @return @em true if the kernel is built into the library and supported
+ *  	   by the CPU.
+ */
+bool search_kernel_supported(search_kernel k);
+
+/**
+ * Gets the kernel that the default searches use.
+ * This is the fastest one supported by the CPU. With glibc, a search for
+ * a single byte uses its memchr(), which is vectorized already.
+ * @return The kernel used by the default searches.
+ */
+search_kernel default_search_kernel();
+
+/**
+ * Finds the first occurrence of a byte value in memory, like memchr().
+ * @param p Pointer to the memory to search.
+ * @param n The number of bytes to search.
+ * @param c The byte value to find.
+ * @return A pointer to the first matching byte, or @em nullptr if it isn't
+ *  	   found.
+ */
+const char* find_byte(const char* p, size_t n, char c);
+
+/**
+ * Finds the first occurrence of a byte value in memory using a specific
+ * kernel.
+ * This is meant for testing and benchmarks. If the kernel isn't
+ * supported, the generic one is used.
+ * @param k The kernel to use.
+ * @param p Pointer to the memory to search.
+ * @param n The number of bytes to search.
+ * @param c The byte value to find.
+ * @return A pointer to the first matching byte, or @em nullptr if it isn't
+ *  	   found.
+ */
+const char* find_byte(search_kernel k, const char* p, size_t n, char c);
+
+/**
+ * Finds the first occurrence of a byte sequence in memory.
+ * @param p Pointer to the memory to search.
+ * @param n The number of bytes to search.
+ * @param pat The sequence to find. An empty sequence matches at @a p.
+ * @return A pointer to the start of the first match, or @em nullptr if it
+ *  	   isn't found.
+ */
+const char* find_seq(const char* p, size_t n, std::string_view pat);
+
+/**
+ * Finds the first occurrence of a byte sequence in memory using a specific
+ * kernel.
+ * This is meant for testing and benchmarks. If the kernel isn't
+ * supported, the generic one is used.
+ * @param k The kernel to use.
+ * @param p Pointer to the memory to search.
+ * @param n The number of bytes to search.
+ * @param pat The sequence to find. An empty sequence matches at @a p.
+ * @return A pointer to the start of the first match, or @em nullptr if it
+ *  	   isn't found.
+ */
+const char* find_seq(search_kernel k, const char* p, size_t n, std::string_view pat);
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_memsearch_h
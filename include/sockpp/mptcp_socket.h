@@ -0,0 +1,88 @@
+/**
+ * @file mptcp_socket.h
+ *
+ * Multipath TCP (MPTCP) stream sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_mptcp_socket_h
+#define __sockpp_mptcp_socket_h
+
+#include "sockpp/inet6_address.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/stream_socket.h"
+
+// Some C libraries lag behind the kernel's protocol numbers.
+#if defined(__linux__) && !defined(IPPROTO_MPTCP)
+    #define IPPROTO_MPTCP 262
+#endif
+
+#if defined(IPPROTO_MPTCP)
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * IPv4 streaming Multipath TCP socket.
+ *
+ * MPTCP lets a connection use several network paths at once, such as
+ * Wi-Fi and cellular, to add up their bandwidth and survive the loss of
+ * one of them. To the application it looks just like TCP. If the peer
+ * doesn't support MPTCP, the connection quietly falls back to plain TCP.
+ *
+ * This is only available on Linux (5.6 or later). If the kernel doesn't
+ * have MPTCP, or it's disabled (`net.mptcp.enabled`), creating the socket
+ * fails with `errc::protocol_not_supported`, and the application can fall
+ * back to a @ref tcp_socket.
+ */
+using mptcp_socket = stream_socket_tmpl<inet_address, IPPROTO_MPTCP>;
+
+/** IPv6 streaming Multipath TCP socket. See @ref mptcp_socket. */
+using mptcp6_socket = stream_socket_tmpl<inet6_address, IPPROTO_MPTCP>;
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // IPPROTO_MPTCP
+
+#endif  // __sockpp_mptcp_socket_h
@@ -0,0 +1,161 @@
+/**
+ * @file notifier.h
+ *
+ * A handle that other threads can signal to wake an event loop.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_notifier_h
+#define __sockpp_notifier_h
+
+#include <atomic>
+
+#if defined(_WIN32)
+    #include "sockpp/datagram_socket.h"
+#else
+    #include "sockpp/socket.h"
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A handle that any thread can signal to wake a thread waiting in a poller
+ * or reactor.
+ *
+ * The notifier has a readable handle that is registered with a poller or
+ * reactor like a socket. When another thread calls @ref notify(), the
+ * handle becomes readable, and the event loop calls @ref reset() to clear
+ * it before doing whatever work it was woken for.
+ *
+ * Notifications are coalesced. Once the notifier is signalled, further
+ * calls to @ref notify() do nothing until it is reset, so a burst of posts
+ * from other threads costs a single system call and a single wakeup.
+ * Since the flag is cleared before the handle is drained, a notification
+ * that arrives while the loop is resetting signals it again, rather than
+ * being lost.
+ *
+ * The handle is an eventfd on Linux, and a non-blocking pipe on other
+ * Unix-like systems. On Windows, where pipes can't be polled, it is a
+ * loopback UDP socket that is connected to itself.
+ *
+ * This can be used with a poller or reactor directly. An @ref io_context
+ * has one of its own, for @ref io_context::post().
+ */
+class notifier
+{
+#if defined(__linux__)
+    /** The eventfd */
+    int fd_{-1};
+#elif !defined(_WIN32)
+    /** The read and write ends of the pipe */
+    int fds_[2]{-1, -1};
+#else
+    /** The loopback UDP socket, connected to itself */
+    datagram_socket sock_;
+#endif
+    /** Whether the notifier is signalled, and not yet reset */
+    std::atomic<bool> pending_{false};
+
+    /** Creates the OS handle(s) */
+    result<> open();
+    /** Closes the OS handle(s) */
+    void close() noexcept;
+
+    // Non-copyable
+    notifier(const notifier&) = delete;
+    notifier& operator=(const notifier&) = delete;
+
+public:
+    /**
+     * Creates a notifier.
+     * @throws std::system_error if the OS handle can't be created.
+     */
+    notifier();
+    /**
+     * Creates a notifier.
+     * @param ec Gets the error code on failure. It's left untouched on
+     *  		 success.
+     */
+    explicit notifier(error_code& ec) noexcept;
+    /**
+     * Destroys the notifier, closing the handle.
+     * It must be removed from any poller or reactor first.
+     */
+    ~notifier();
+    /**
+     * Determines if the notifier has a valid OS handle.
+     * @return @em true if the notifier has a valid OS handle.
+     */
+    bool is_open() const noexcept { return handle() != INVALID_SOCKET; }
+    /**
+     * Gets the handle to register with a poller or reactor for
+     * readability.
+     * @return The OS handle.
+     */
+    socket_t handle() const noexcept;
+    /**
+     * Signals the notifier, waking a thread that is waiting for the handle
+     * to be readable.
+     * This can be called from any thread. If the notifier is already
+     * signalled, it does nothing.
+     */
+    void notify() noexcept;
+    /**
+     * Clears the notifier, so that the handle isn't readable.
+     * This is called by the thread that was woken, before it does the work
+     * that it was woken for.
+     * @return @em true if the notifier had been signalled.
+     */
+    bool reset() noexcept;
+    /**
+     * Determines if the notifier is signalled, and not yet reset.
+     * @return @em true if the notifier is signalled.
+     */
+    bool pending() const noexcept { return pending_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_notifier_h
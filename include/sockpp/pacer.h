@@ -0,0 +1,215 @@
+/**
+ * @file pacer.h
+ *
+ * A token bucket that paces the data sent on sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_pacer_h
+#define __sockpp_pacer_h
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "sockpp/platform.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A token bucket that limits the rate at which data is sent.
+ *
+ * The bucket fills with credit at a steady number of bytes per second, up
+ * to a burst size, and each byte sent takes one byte of credit. This lets
+ * a bulk transfer share a link with latency-sensitive traffic: the data
+ * leaves in bursts no larger than the bucket, spread out over time, rather
+ * than filling the queues in the kernel and the network all at once.
+ *
+ * The pacer never sleeps. A send is allowed as much as the bucket holds
+ * at that moment, which can be nothing. The application then asks for
+ * the @ref delay() until the rest can go, and waits for it in its event
+ * loop, such as with a @ref timer_wheel or the timeout of a
+ * @ref reactor. It's used through the paced
+ * @ref stream_socket::write_n(const void*, size_t, pacer&) and by
+ * attaching it to a @ref write_queue, or it can be called directly to
+ * pace any kind of sends.
+ *
+ * The time that sends are held back is tracked by each pacer, and added
+ * to the process-wide @ref socket_stats when the library is built to
+ * collect them.
+ *
+ * On Linux, the kernel can also pace a socket by itself; see
+ * @ref socket::max_pacing_rate(). That's usually better when it's
+ * available, since it spaces out the individual packets. A pacer works
+ * on any platform, and can share one budget over several sockets.
+ *
+ * A pacer isn't thread safe. It should be used by the thread that does
+ * the sends that it paces.
+ */
+class pacer
+{
+public:
+    /** The clock used to refill the bucket */
+    using clock = std::chrono::steady_clock;
+    /** A point in time on the pacer's clock */
+    using time_point = clock::time_point;
+
+    /** The default burst, as the amount of time at the full rate */
+    static constexpr milliseconds DFLT_BURST_TIME{10};
+    /** The smallest default burst, so that full packets can be sent */
+    static constexpr size_t MIN_BURST = 16 * 1024;
+
+private:
+    /** The rate, in bytes per second. Zero means unlimited. */
+    uint64_t rate_;
+    /** The most credit the bucket can hold */
+    size_t burst_;
+    /** The credit in the bucket, in bytes */
+    int64_t tokens_;
+    /** The last time the bucket was refilled */
+    time_point last_;
+    /** Whether a send is being held back */
+    bool throttled_{false};
+    /** When the current hold started */
+    time_point throttledSince_;
+    /** The total time sends have been held back */
+    nanoseconds throttledTime_{0};
+
+    /**
+     * Adds the credit that's built up since the last refill.
+     * @param now The current time.
+     */
+    void refill(time_point now) noexcept;
+    /**
+     * Notes whether a send of the wanted size can go now, to track the
+     * time that sends are held back.
+     * @param held Whether some of the send must wait.
+     * @param now The current time.
+     */
+    void note_throttle(bool held, time_point now) noexcept;
+
+public:
+    /**
+     * Creates a pacer with the given rate.
+     * The bucket starts out full.
+     * @param bytesPerSec The rate, in bytes per second. Zero means
+     *  				  unlimited.
+     * @param burst The most that can be sent at once. Zero picks a
+     *  			default of @ref DFLT_BURST_TIME at the full rate, but
+     *  			no less than @ref MIN_BURST.
+     */
+    explicit pacer(uint64_t bytesPerSec, size_t burst = 0);
+    /**
+     * Gets the rate.
+     * @return The rate, in bytes per second. Zero means unlimited.
+     */
+    uint64_t rate() const { return rate_; }
+    /**
+     * Changes the rate.
+     * The credit already in the bucket is kept, up to the new burst size.
+     * @param bytesPerSec The rate, in bytes per second. Zero means
+     *  				  unlimited.
+     * @param burst The most that can be sent at once. Zero picks the
+     *  			default for the rate.
+     */
+    void rate(uint64_t bytesPerSec, size_t burst = 0);
+    /**
+     * Gets the burst size.
+     * @return The most that can be sent at once.
+     */
+    size_t burst() const { return burst_; }
+    /**
+     * Gets the total time that sends have been held back.
+     * A hold is counted once it ends, when a send is fully allowed again.
+     * @return The total time that sends have been held back.
+     */
+    nanoseconds throttled_time() const { return throttledTime_; }
+    /**
+     * Determines if a send is currently being held back.
+     * @return @em true if the last request couldn't be fully allowed.
+     */
+    bool throttled() const { return throttled_; }
+    /**
+     * Gets how much of a send could go now, without using any credit.
+     * When this is less than @a n, the pacer considers the send to be held
+     * back until a later call allows all of it. Follow it with
+     * @ref consume() for the amount that was actually sent.
+     * @param n The size of the send.
+     * @param now The current time.
+     * @return The number of bytes that can be sent now, up to @a n.
+     */
+    size_t allow(size_t n, time_point now = clock::now()) noexcept;
+    /**
+     * Takes credit from the bucket for data that was sent.
+     * @param n The number of bytes sent.
+     */
+    void consume(size_t n) noexcept;
+    /**
+     * Gets how much of a send could go now, and takes the credit for it.
+     * @param n The size of the send.
+     * @param now The current time.
+     * @return The number of bytes that can be sent now, up to @a n.
+     */
+    size_t take(size_t n, time_point now = clock::now()) noexcept {
+        n = allow(n, now);
+        consume(n);
+        return n;
+    }
+    /**
+     * Gets the time until a send can go.
+     * Since a send can't take more than the burst size at once, this is
+     * the time until the smaller of @a n and the burst size is allowed.
+     * @param n The size of the send.
+     * @param now The current time.
+     * @return The time until the send can go, which is zero if it can go
+     *  	   now.
+     */
+    nanoseconds delay(size_t n, time_point now = clock::now()) noexcept;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_pacer_h
@@ -0,0 +1,233 @@
+/**
+ * @file packet_address.h
+ *
+ * Class for a Linux packet (AF_PACKET) socket address.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_packet_addr_h
+#define __sockpp_packet_addr_h
+
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "sockpp/platform.h"
+#include "sockpp/result.h"
+#include "sockpp/sock_address.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Class that represents a Linux link-layer (AF_PACKET) address.
+ *
+ * This is a network interface and a link-layer protocol, like ETH_P_IP, or
+ * ETH_P_ALL for all packets. When it's received with a packet, it also
+ * has the hardware address of the sender, and the type of the packet
+ * (host, broadcast, outgoing, etc).
+ *
+ * The protocol is kept in host byte order by this class.
+ */
+class packet_address : public sock_address
+{
+    /** The underlying C struct for link-layer addresses */
+    sockaddr_ll addr_{};
+
+    /** The size of the underlying address struct, in bytes */
+    static constexpr size_t SZ = sizeof(sockaddr_ll);
+
+public:
+    /** The address family for this type of address */
+    static constexpr sa_family_t ADDRESS_FAMILY = AF_PACKET;
+
+    /** Iface to use to indicate binding to all interfaces */
+    static const unsigned ALL_IFACE = 0;
+
+    /**
+     * Constructs an empty address.
+     * The address is initialized to all zeroes.
+     */
+    packet_address() noexcept {}
+    /**
+     * Constructs an address for the interface with the specified index.
+     * @param idx The interface index to use.
+     * @param protocol The link-layer protocol, in host byte order.
+     */
+    explicit packet_address(unsigned idx, uint16_t protocol = ETH_P_ALL) noexcept;
+    /**
+     * Constructs an address for the specified network interface.
+     * @param iface The name of the interface, like "eth0".
+     * @param protocol The link-layer protocol, in host byte order.
+     * @throw system_error on failure
+     */
+    packet_address(const string& iface, uint16_t protocol = ETH_P_ALL);
+    /**
+     * Constructs the address by copying the specified structure.
+     * @param addr The other address. This must be an AF_PACKET address to
+     *  		   be a valid link-layer address.
+     */
+    packet_address(const sock_address& addr) noexcept {
+        std::memcpy(&addr_, addr.sockaddr_ptr(), std::min(size_t(addr.size()), SZ));
+    }
+    /**
+     * Constructs the address by copying the specified structure.
+     * @param addr The other address.
+     */
+    packet_address(const sockaddr_ll& addr) noexcept : addr_(addr) {}
+    /**
+     * Constructs the address by copying the specified address.
+     * @param addr The other address.
+     */
+    packet_address(const packet_address& addr) noexcept : addr_(addr.addr_) {}
+    /**
+     * Copies the specified address.
+     * @param rhs The other address.
+     * @return A reference to this object.
+     */
+    packet_address& operator=(const packet_address& rhs) = default;
+    /**
+     * Attempts to get the address for the specified network interface.
+     * @param iface The name of the interface, like "eth0".
+     * @param protocol The link-layer protocol, in host byte order.
+     * @return A result with the address, if successful, or an error code
+     *  	   on failure.
+     */
+    static result<packet_address> create(const string& iface, uint16_t protocol = ETH_P_ALL);
+    /**
+     * Gets the name of the network interface for this address.
+     * @return The name of the interface, or an error code on failure.
+     */
+    result<string> get_iface() const noexcept;
+    /**
+     * Get the name of the network interface for this address.
+     * If the name can not be found or there's an error, returns "unknown".
+     * @return The name of the interface for this address.
+     */
+    string iface() const noexcept;
+    /**
+     * Gets the index of the network interface for this address.
+     * @return The index of the network interface for this address.
+     */
+    int index() const noexcept { return addr_.sll_ifindex; }
+    /**
+     * Gets the link-layer protocol.
+     * @return The link-layer protocol, in host byte order.
+     */
+    uint16_t protocol() const noexcept { return ntohs(addr_.sll_protocol); }
+    /**
+     * Gets the ARP hardware type of the interface, like ARPHRD_ETHER.
+     * This is only set for addresses received with a packet.
+     * @return The ARP hardware type.
+     */
+    uint16_t hatype() const noexcept { return addr_.sll_hatype; }
+    /**
+     * Gets the type of packet, like PACKET_HOST or PACKET_OUTGOING.
+     * This is only set for addresses received with a packet.
+     * @return The packet type.
+     */
+    uint8_t pkttype() const noexcept { return addr_.sll_pkttype; }
+    /**
+     * Gets the hardware (MAC) address.
+     * @return A pointer to the hardware address bytes.
+     */
+    const uint8_t* hw_addr() const noexcept { return addr_.sll_addr; }
+    /**
+     * Gets the length of the hardware address.
+     * @return The length of the hardware address, in bytes.
+     */
+    size_t hw_addr_len() const noexcept { return addr_.sll_halen; }
+    /**
+     * Gets the size of the address structure.
+     * @return The size of the address structure.
+     */
+    socklen_t size() const override { return socklen_t(SZ); }
+    /**
+     * Gets a pointer to this object cast to a const @em sockaddr.
+     * @return A pointer to this object cast to a const @em sockaddr.
+     */
+    const sockaddr* sockaddr_ptr() const override {
+        return reinterpret_cast<const sockaddr*>(&addr_);
+    }
+    /**
+     * Gets a pointer to this object cast to a @em sockaddr.
+     * @return A pointer to this object cast to a @em sockaddr.
+     */
+    sockaddr* sockaddr_ptr() override { return reinterpret_cast<sockaddr*>(&addr_); }
+    /**
+     * Gets a const pointer to this object cast to a @em sockaddr_ll.
+     * @return const sockaddr_ll pointer to this object.
+     */
+    const sockaddr_ll* sockaddr_ll_ptr() const { return &addr_; }
+    /**
+     * Gets a pointer to this object cast to a @em sockaddr_ll.
+     * @return sockaddr_ll pointer to this object.
+     */
+    sockaddr_ll* sockaddr_ll_ptr() noexcept { return &addr_; }
+    /**
+     * Gets a printable string for the address.
+     * @return A string representation of the address in the form
+     *  	   "packet:<iface>"
+     */
+    string to_string() const noexcept { return string("packet:") + iface(); }
+};
+
+// --------------------------------------------------------------------------
+
+/**
+ * Stream inserter for the address.
+ * @param os The output stream
+ * @param addr The address
+ * @return A reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const packet_address& addr);
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_packet_addr_h
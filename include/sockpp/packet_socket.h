@@ -0,0 +1,423 @@
+/**
+ * @file packet_socket.h
+ *
+ * Class for Linux link-layer packet (AF_PACKET) sockets, with optional
+ * memory-mapped rings.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_packet_socket_h
+#define __sockpp_packet_socket_h
+
+#include <linux/if_packet.h>
+
+#include "sockpp/packet_address.h"
+#include "sockpp/raw_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The sizes of the memory-mapped rings for a packet socket.
+ *
+ * The receive ring is made up of blocks, each of which holds a number of
+ * variable-sized packets. The transmit ring is made up of fixed-sized
+ * frames, each of which holds one packet. A ring with no blocks or frames
+ * isn't created.
+ */
+struct packet_ring_params
+{
+    /** The size of each block. This must be a multiple of the page size. */
+    size_t block_size{1 << 20};
+    /** The number of blocks in the receive ring */
+    size_t rx_blocks{64};
+    /** How long the kernel can hold on to a receive block that isn't full */
+    milliseconds retire_timeout{10};
+    /**
+     * The size of each transmit frame. This must divide evenly into the
+     * block size.
+     */
+    size_t tx_frame_size{1 << 11};
+    /** The number of frames in the transmit ring */
+    size_t tx_frames{0};
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Linux link-layer packet (AF_PACKET) socket.
+ *
+ * This sends and receives whole link-layer frames, like Ethernet frames,
+ * on a network interface. It can be used with the normal raw socket I/O
+ * calls, one packet at a time, but at high packet rates it's meant to be
+ * used with memory-mapped rings that are shared with the kernel:
+ *
+ * @li The receive ring is a TPACKET_V3 ring of blocks. The kernel fills
+ * a block with packets and hands it over, and the application consumes
+ * the whole block with @ref read(), without any system calls while there
+ * are blocks waiting.
+ *
+ * @li The transmit ring is a ring of frames. The application copies
+ * packets into it with @ref tx_queue(), and then sends the whole batch
+ * with a single call to @ref tx_flush().
+ *
+ * To spread the load over a number of threads, each thread can open its
+ * own socket and put them all into the same @ref fanout() group. The
+ * kernel then picks a socket for each packet, such as by flow hash, so
+ * that the packets of a flow always go to the same thread.
+ *
+ * Opening a packet socket requires the CAP_NET_RAW capability. Packet
+ * sockets, and their rings, are not thread-safe. Each should be owned by
+ * a single thread.
+ */
+class packet_socket : public raw_socket_tmpl<packet_address>
+{
+    /** The base class */
+    using base = raw_socket_tmpl<packet_address>;
+
+    /** The mapping for both rings */
+    char* ring_{nullptr};
+    /** The size of the whole mapping */
+    size_t ringSize_{0};
+
+    /** The size of each receive block */
+    size_t blockSize_{0};
+    /** The number of receive blocks */
+    size_t nBlocks_{0};
+    /** The receive block to be consumed next */
+    size_t curBlock_{0};
+
+    /** The start of the transmit ring */
+    char* tx_{nullptr};
+    /** The size of each transmit frame */
+    size_t frameSize_{0};
+    /** The number of transmit frames */
+    size_t nFrames_{0};
+    /** The transmit frame to be filled next */
+    size_t curFrame_{0};
+
+    /** Gets the descriptor of the receive block at the specified index */
+    tpacket_block_desc* block(size_t i) const {
+        return reinterpret_cast<tpacket_block_desc*>(ring_ + i * blockSize_);
+    }
+    /** Gets the header of the transmit frame at the specified index */
+    tpacket3_hdr* frame(size_t i) const {
+        return reinterpret_cast<tpacket3_hdr*>(tx_ + i * frameSize_);
+    }
+    /**
+     * Waits for the kernel to hand over the next receive block.
+     * @return The block, nullptr on a timeout, or an error code.
+     */
+    result<tpacket_block_desc*> wait_block(milliseconds timeout);
+    /** Returns the current block to the kernel, and moves to the next one */
+    void release_block() noexcept;
+    /** Sets up and maps the rings */
+    result<> map_rings(const packet_ring_params& params) noexcept;
+    /** Unmaps the rings */
+    void unmap() noexcept;
+
+    // Non-copyable
+    packet_socket(const packet_socket&) = delete;
+    packet_socket& operator=(const packet_socket&) = delete;
+
+public:
+    /**
+     * A view of a packet in the receive ring.
+     * This is only valid until the block that holds it is released back
+     * to the kernel.
+     */
+    class packet
+    {
+        /** The ring header for the packet */
+        const tpacket3_hdr* hdr_;
+
+    public:
+        /**
+         * Creates a view of the packet with the ring header.
+         * @param hdr The ring header of the packet.
+         */
+        explicit packet(const tpacket3_hdr* hdr) : hdr_{hdr} {}
+        /**
+         * Gets the ring header for the packet.
+         * @return The ring header for the packet.
+         */
+        const tpacket3_hdr* header() const { return hdr_; }
+        /**
+         * Gets the link-layer data of the packet.
+         * @return A pointer to the start of the packet data.
+         */
+        const uint8_t* data() const {
+            return reinterpret_cast<const uint8_t*>(hdr_) + hdr_->tp_mac;
+        }
+        /**
+         * Gets the number of bytes of the packet that were captured.
+         * @return The number of bytes of data for the packet.
+         */
+        size_t size() const { return hdr_->tp_snaplen; }
+        /**
+         * Gets the original length of the packet on the wire.
+         * This can be larger than @ref size() if the packet was cut.
+         * @return The original length of the packet.
+         */
+        size_t wire_size() const { return hdr_->tp_len; }
+        /**
+         * Gets the receive timestamp.
+         * @return The time the packet was received, since the epoch.
+         */
+        nanoseconds timestamp() const {
+            return nanoseconds{seconds{hdr_->tp_sec}} + nanoseconds{hdr_->tp_nsec};
+        }
+        /**
+         * Gets the flow hash of the packet, as computed by the kernel or
+         * the NIC.
+         * @return The flow hash of the packet.
+         */
+        uint32_t rxhash() const { return hdr_->hv1.tp_rxhash; }
+        /**
+         * Gets the link-layer address information for the packet.
+         * @return The address of the sender, with the interface and packet
+         *  	   type.
+         */
+        const sockaddr_ll& link_addr() const {
+            return *reinterpret_cast<const sockaddr_ll*>(
+                reinterpret_cast<const char*>(hdr_) + TPACKET_ALIGN(sizeof(tpacket3_hdr))
+            );
+        }
+        /**
+         * Determines if this is a packet sent by this host.
+         * @return @em true if this is an outgoing packet.
+         */
+        bool outgoing() const { return link_addr().sll_pkttype == PACKET_OUTGOING; }
+    };
+
+    /**
+     * Creates an unopened packet socket.
+     */
+    packet_socket() noexcept {}
+    /**
+     * Creates a packet socket from an existing OS socket handle and claims
+     * ownership of the handle.
+     * @param handle A socket handle from the operating system.
+     */
+    explicit packet_socket(socket_t handle) noexcept : base(handle) {}
+    /**
+     * Creates a packet socket and binds it to the interface and protocol
+     * in the address.
+     * @param addr The address of the interface and protocol.
+     * @throws std::system_error on failure
+     */
+    explicit packet_socket(const packet_address& addr) {
+        if (auto res = open(addr); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates a packet socket with memory-mapped rings, and binds it to
+     * the interface and protocol in the address.
+     * @param addr The address of the interface and protocol.
+     * @param params The sizes of the rings.
+     * @throws std::system_error on failure
+     */
+    packet_socket(const packet_address& addr, const packet_ring_params& params) {
+        if (auto res = open(addr, params); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates a packet socket and binds it to the interface and protocol
+     * in the address.
+     * @param addr The address of the interface and protocol.
+     * @param ec The error code, on failure
+     */
+    packet_socket(const packet_address& addr, error_code& ec) noexcept {
+        ec = open(addr).error();
+    }
+    /**
+     * Creates a packet socket with memory-mapped rings, and binds it to
+     * the interface and protocol in the address.
+     * @param addr The address of the interface and protocol.
+     * @param params The sizes of the rings.
+     * @param ec The error code, on failure
+     */
+    packet_socket(
+        const packet_address& addr, const packet_ring_params& params, error_code& ec
+    ) noexcept {
+        ec = open(addr, params).error();
+    }
+    /**
+     * Move constructor.
+     * @param other The other socket to move to this one
+     */
+    packet_socket(packet_socket&& other) noexcept;
+    /**
+     * Destructor unmaps the rings and closes the socket.
+     */
+    ~packet_socket() { unmap(); }
+    /**
+     * Move assignment.
+     * @param rhs The other socket to move into this one.
+     * @return A reference to this object.
+     */
+    packet_socket& operator=(packet_socket&& rhs) noexcept;
+    /**
+     * Creates an unbound packet socket.
+     * @param protocol The link-layer protocol, in host byte order.
+     * @return A packet socket, or the error code on failure.
+     */
+    static result<packet_socket> create(uint16_t protocol = ETH_P_ALL);
+    /**
+     * Opens the socket and binds it to the interface and protocol in the
+     * address.
+     * @param addr The address of the interface and protocol.
+     * @return The error code, on failure.
+     */
+    result<> open(const packet_address& addr) noexcept;
+    /**
+     * Opens the socket with memory-mapped rings, and binds it to the
+     * interface and protocol in the address.
+     * The rings are set up before the socket is bound, so that all the
+     * packets go to the ring.
+     * @param addr The address of the interface and protocol.
+     * @param params The sizes of the rings.
+     * @return The error code, on failure.
+     */
+    result<> open(const packet_address& addr, const packet_ring_params& params) noexcept;
+    /**
+     * Closes the socket and unmaps the rings.
+     * @return The error code, on failure.
+     */
+    result<> close() override;
+    /**
+     * Determines if the socket has a receive ring.
+     * @return @em true if the socket has a receive ring.
+     */
+    bool has_rx_ring() const { return nBlocks_ != 0; }
+    /**
+     * Determines if the socket has a transmit ring.
+     * @return @em true if the socket has a transmit ring.
+     */
+    bool has_tx_ring() const { return nFrames_ != 0; }
+    /**
+     * Adds the socket to a fanout group.
+     *
+     * All the sockets in the group must be bound to the same interface and
+     * protocol, and have the same mode. The kernel then spreads the
+     * packets over the sockets in the group.
+     *
+     * @param groupID The ID of the group. This is shared by all the
+     *  			  sockets in the group, in the same network namespace.
+     * @param mode How to choose the socket for each packet, like
+     *  		   PACKET_FANOUT_HASH to keep each flow on the same socket,
+     *  		   or PACKET_FANOUT_CPU.
+     * @param flags Additional flags, like PACKET_FANOUT_FLAG_DEFRAG.
+     * @return The error code, on failure.
+     */
+    result<> fanout(uint16_t groupID, uint16_t mode = PACKET_FANOUT_HASH, uint16_t flags = 0);
+    /**
+     * Consumes the next block of packets from the receive ring.
+     *
+     * This waits for a block, calls the function for each packet in it,
+     * and then hands the block back to the kernel.
+     *
+     * @param fn The function to call, like `fn(const packet& pkt)`
+     * @param timeout The maximum time to wait for a block. A negative
+     *  			  value waits forever.
+     * @return The number of packets in the block, zero on a timeout, or
+     *  	   the error code on failure.
+     */
+    template <typename Func>
+    result<size_t> read(Func&& fn, milliseconds timeout = milliseconds{-1}) {
+        auto res = wait_block(timeout);
+        if (!res || !res.value())
+            return res ? result<size_t>{size_t(0)} : result<size_t>{res.error()};
+
+        // Give the block back, even if the callback throws
+        struct releaser
+        {
+            packet_socket* sock;
+            ~releaser() { sock->release_block(); }
+        } rel{this};
+
+        auto& bh = res.value()->hdr.bh1;
+        auto* p = reinterpret_cast<const char*>(res.value()) + bh.offset_to_first_pkt;
+
+        for (uint32_t i = 0; i < bh.num_pkts; ++i) {
+            auto hdr = reinterpret_cast<const tpacket3_hdr*>(p);
+            fn(packet{hdr});
+            p += hdr->tp_next_offset;
+        }
+        return size_t(bh.num_pkts);
+    }
+    /**
+     * Gets the most data that fits in one frame of the transmit ring.
+     * @return The maximum size of a packet that can be queued.
+     */
+    size_t tx_max_size() const;
+    /**
+     * Copies a packet into the next frame of the transmit ring.
+     * The packet isn't sent until the next call to @ref tx_flush().
+     * @param buf The link-layer packet to send.
+     * @param n The size of the packet.
+     * @return The error code on failure. This is
+     *  	   `errc::no_buffer_space` if the ring is full.
+     */
+    result<> tx_queue(const void* buf, size_t n);
+    /**
+     * Tells the kernel to send all the packets queued in the transmit
+     * ring.
+     * @param wait Whether to wait until all the packets have been sent.
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> tx_flush(bool wait = false);
+    /**
+     * Gets and resets the receive statistics from the kernel.
+     * @return The number of packets received and dropped since the last
+     *  	   call, or the error code on failure.
+     */
+    result<tpacket_stats_v3> stats() const {
+        return get_option<tpacket_stats_v3>(SOL_PACKET, PACKET_STATISTICS);
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_packet_socket_h
@@ -88,6 +88,9 @@ typedef long suseconds_t;  // signed # of microseconds in timeval
     #define SHUT_WR SD_SEND
     #define SHUT_RDWR SD_BOTH
 
+    // Windows never raises SIGPIPE
+    #define MSG_NOSIGNAL 0
+
 struct iovec
 {
     void* iov_base;
@@ -108,6 +111,12 @@ struct iovec
     #include <signal.h>
 
     #include <cerrno>
+
+    // Where a send can't be told not to raise SIGPIPE, like on macOS, the
+    // library's sockets are created with SO_NOSIGPIPE instead.
+    #if !defined(MSG_NOSIGNAL)
+        #define MSG_NOSIGNAL 0
+    #endif
 #endif
 
 #endif
@@ -0,0 +1,250 @@
+/**
+ * @file poller.h
+ *
+ * Socket readiness notification using the best mechanism available on the
+ * platform (epoll, kqueue, or poll).
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_poller_h
+#define __sockpp_poller_h
+
+#include <cstdint>
+#include <vector>
+
+#include "sockpp/socket.h"
+
+#if defined(__linux__)
+    #define SOCKPP_POLLER_EPOLL
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || \
+    defined(__OpenBSD__) || defined(__DragonFly__)
+    #define SOCKPP_POLLER_KQUEUE
+#else
+    #define SOCKPP_POLLER_POLL
+    #if !defined(_WIN32)
+        #include <poll.h>
+    #endif
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A set of socket handles that are monitored for I/O readiness.
+ *
+ * This is a thin, portable wrapper around the system readiness mechanism:
+ * epoll on Linux, kqueue on the BSD's and macOS, and WSAPoll() on Windows
+ * (with plain poll() for any other POSIX system).
+ *
+ * Sockets are registered by handle. The poller does not take ownership of
+ * the handles, so the application must remove a socket before closing
+ * it. Notification is level-triggered: as long as a socket remains
+ * readable or writable, each call to @ref wait() will report it.
+ *
+ * Objects of this class are moveable, but not copyable. A poller is not
+ * thread-safe; it is expected to be used by a single event-loop thread.
+ */
+class poller
+{
+public:
+    /** The socket is ready for reading (or accepting) */
+    static constexpr uint32_t READABLE = 0x01;
+    /** The socket is ready for writing (or a connect has completed) */
+    static constexpr uint32_t WRITABLE = 0x02;
+    /** The peer closed the connection */
+    static constexpr uint32_t HANGUP = 0x04;
+    /** An error is pending on the socket */
+    static constexpr uint32_t ERRORS = 0x08;
+
+    /** The default capacity for the buffer of returned events */
+    static constexpr size_t DFLT_MAX_EVENTS = 256;
+
+    /**
+     * An I/O readiness event for a single socket.
+     */
+    struct event
+    {
+        /** The handle of the socket that is ready. */
+        socket_t handle;
+        /** The readiness flags (READABLE, WRITABLE, etc) for the socket. */
+        uint32_t events;
+
+        /** Determines if the READABLE flag is set */
+        bool readable() const { return (events & READABLE) != 0; }
+        /** Determines if the WRITABLE flag is set */
+        bool writable() const { return (events & WRITABLE) != 0; }
+        /** Determines if the HANGUP flag is set */
+        bool hangup() const { return (events & HANGUP) != 0; }
+        /** Determines if the ERRORS flag is set */
+        bool error() const { return (events & ERRORS) != 0; }
+    };
+
+private:
+#if defined(SOCKPP_POLLER_EPOLL) || defined(SOCKPP_POLLER_KQUEUE)
+    /** The epoll or kqueue handle */
+    int handle_{-1};
+#else
+    #if defined(_WIN32)
+    /** The array of descriptors passed to WSAPoll */
+    std::vector<WSAPOLLFD> fds_;
+    #else
+    /** The array of descriptors passed to poll() */
+    std::vector<pollfd> fds_;
+    #endif
+    /** Finds the index of the handle in the fds_ array. */
+    size_t find(socket_t h) const;
+#endif
+    /** The number of registered sockets */
+    size_t n_{0};
+
+    // Non-copyable
+    poller(const poller&) = delete;
+    poller& operator=(const poller&) = delete;
+
+public:
+    /**
+     * Creates a poller.
+     * @throws std::system_error if the OS object can't be created.
+     */
+    poller();
+    /**
+     * Creates a poller.
+     * @param ec Gets the error code on failure.
+     */
+    explicit poller(error_code& ec) noexcept;
+    /**
+     * Move constructor.
+     * @param other The poller to move into this one.
+     */
+    poller(poller&& other) noexcept;
+    /**
+     * Destructor frees the OS object.
+     */
+    ~poller();
+    /**
+     * Move assignment.
+     * @param rhs The other poller to move into this one.
+     * @return A reference to this object.
+     */
+    poller& operator=(poller&& rhs) noexcept;
+    /**
+     * Gets the number of sockets currently registered with the poller.
+     * @return The number of sockets currently registered with the poller.
+     */
+    size_t size() const { return n_; }
+    /**
+     * Determines if there are no sockets registered with the poller.
+     * @return @em true if no sockets are registered.
+     */
+    bool empty() const { return n_ == 0; }
+    /**
+     * Starts monitoring a socket for readiness.
+     * @param h The handle of the socket to monitor.
+     * @param events The set of events to monitor (READABLE, WRITABLE).
+     * @return The error code on failure.
+     */
+    result<> add(socket_t h, uint32_t events);
+    /**
+     * Starts monitoring a socket for readiness.
+     * @param sock The socket to monitor.
+     * @param events The set of events to monitor (READABLE, WRITABLE).
+     * @return The error code on failure.
+     */
+    result<> add(const socket& sock, uint32_t events) { return add(sock.handle(), events); }
+    /**
+     * Changes the set of events being monitored for a socket.
+     * @param h The handle of a registered socket.
+     * @param events The new set of events to monitor.
+     * @return The error code on failure.
+     */
+    result<> modify(socket_t h, uint32_t events);
+    /**
+     * Changes the set of events being monitored for a socket.
+     * @param sock A registered socket.
+     * @param events The new set of events to monitor.
+     * @return The error code on failure.
+     */
+    result<> modify(const socket& sock, uint32_t events) {
+        return modify(sock.handle(), events);
+    }
+    /**
+     * Stops monitoring a socket.
+     * This should be called before the socket is closed.
+     * @param h The handle of a registered socket.
+     * @return The error code on failure.
+     */
+    result<> remove(socket_t h);
+    /**
+     * Stops monitoring a socket.
+     * This should be called before the socket is closed.
+     * @param sock A registered socket.
+     * @return The error code on failure.
+     */
+    result<> remove(const socket& sock) { return remove(sock.handle()); }
+    /**
+     * Waits for any of the registered sockets to become ready.
+     * @param evts Array to receive the ready events.
+     * @param maxEvts The maximum number of events to retrieve.
+     * @param timeout The maximum time to wait. A negative value waits
+     *  			  forever, and zero returns immediately.
+     * @return The number of events placed into the array, which can be
+     *         zero if the wait timed out, or an error code on failure.
+     */
+    result<size_t> wait(event* evts, size_t maxEvts, milliseconds timeout);
+    /**
+     * Waits for any of the registered sockets to become ready.
+     * The vector is resized to hold the events that are ready, up to its
+     * current capacity (or @ref DFLT_MAX_EVENTS if it has none).
+     * @param evts Vector to receive the ready events.
+     * @param timeout The maximum time to wait. A negative value waits
+     *  			  forever, and zero returns immediately.
+     * @return The number of events placed into the vector, or an error
+     *         code on failure.
+     */
+    result<size_t> wait(std::vector<event>& evts, milliseconds timeout);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_poller_h
@@ -0,0 +1,272 @@
+/**
+ * @file protocol_sniffer.h
+ *
+ * Dispatches new connections by sniffing their first bytes.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_protocol_sniffer_h
+#define __sockpp_protocol_sniffer_h
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "sockpp/acceptor.h"
+#include "sockpp/reactor.h"
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Serves several protocols on one port, by looking at the first bytes of
+ * each new connection and handing it to the handler for its protocol.
+ *
+ * The sniffer peeks at the data with `MSG_PEEK`, so nothing is consumed,
+ * and the handler gets the socket untouched, to read from the start as if
+ * it had accepted the connection itself. The protocols are recognized by
+ * matchers, which are tried in the order they were added. Each looks at
+ * the data received so far, and says whether it matches, doesn't match,
+ * or needs more data to tell. The first one to match gets the connection.
+ * If none can match, or the connection doesn't send enough to decide
+ * before its deadline, it goes to the fallback handler, if there is one,
+ * or is closed.
+ *
+ * The sniffer is driven by a @ref reactor. It can take the connections
+ * from an acceptor that it watches, or be given sockets that the
+ * application accepted. While it waits for more data on a connection, it
+ * raises the socket's receive low-water mark, so that the reactor doesn't
+ * wake for it again until more has arrived. On Linux, the listener can
+ * also be set with @ref acceptor::defer_accept(), so that a connection
+ * isn't even accepted until its first data is in.
+ *
+ * The deadlines are checked by @ref expire(), which the application calls
+ * regularly, such as from the reactor's tick handler:
+ *
+ *     rx.on_tick([&] { sniffer.expire(); });
+ *     rx.run_once(sniffer.next_timeout());
+ *
+ * The handlers are called on the reactor's thread, so one that does real
+ * work would post the socket to a pool of worker threads.
+ */
+class protocol_sniffer
+{
+public:
+    /** The clock for the deadlines */
+    using clock = std::chrono::steady_clock;
+
+    /** The result of a matcher */
+    enum class match {
+        /** The data isn't from this protocol */
+        no,
+        /** The data is from this protocol */
+        yes,
+        /** More data is needed to tell */
+        more
+    };
+
+    /** A function that checks the first bytes of a connection */
+    using matcher_type = std::function<match(std::string_view data)>;
+    /** A function that takes a connection */
+    using handler_type = std::function<void(stream_socket sock)>;
+
+    /** The default number of bytes that can be peeked */
+    static constexpr size_t DFLT_PEEK_SIZE = 16;
+
+private:
+    /** A protocol that can be matched */
+    struct route
+    {
+        /** Checks the data */
+        matcher_type matcher;
+        /** Takes the matching connections */
+        handler_type handler;
+    };
+
+    /** A connection waiting to be matched */
+    struct entry
+    {
+        /** The connection */
+        stream_socket sock;
+        /** When to give up on it */
+        clock::time_point deadline;
+        /** Whether it was in non-blocking mode when it was added */
+        bool nonBlocking;
+        /** Whether its receive low-water mark was raised */
+        bool lowat{false};
+    };
+
+    /** The reactor */
+    reactor& rx_;
+    /** The most bytes to peek */
+    size_t peekSize_;
+    /** The time a connection has to send enough to be matched */
+    milliseconds timeout_;
+    /** The protocols, in the order they're tried */
+    std::vector<route> routes_;
+    /** Takes the connections that don't match */
+    handler_type fallback_;
+    /** The connections waiting to be matched */
+    std::unordered_map<socket_t, entry> pending_;
+    /** The listeners being watched */
+    std::vector<acceptor*> listeners_;
+    /** The buffer for peeking */
+    std::vector<char> buf_;
+
+    /** Starts sniffing a connection */
+    result<> watch(stream_socket sock, bool nonBlocking);
+    /** Peeks at a connection and dispatches it, if it can be matched */
+    void on_ready(socket_t h);
+    /** Accepts everything waiting on a listener */
+    void on_accept(acceptor& acc);
+    /** Removes a connection and hands it to a handler, or closes it */
+    void dispatch(socket_t h, const handler_type& handler);
+
+    // Non-copyable
+    protocol_sniffer(const protocol_sniffer&) = delete;
+    protocol_sniffer& operator=(const protocol_sniffer&) = delete;
+
+public:
+    /**
+     * Creates a sniffer driven by a reactor.
+     * @param rx The reactor. It must outlive the sniffer.
+     * @param timeout The time a new connection has to send enough data to
+     *  			  tell its protocol.
+     * @param peekSize The most bytes to look at. A connection that still
+     *  			   isn't matched when this many have arrived goes to the
+     *  			   fallback handler.
+     */
+    explicit protocol_sniffer(
+        reactor& rx, milliseconds timeout = milliseconds{2000},
+        size_t peekSize = DFLT_PEEK_SIZE
+    );
+    /**
+     * Destructor stops watching the listeners, and closes any connections
+     * that are still waiting.
+     */
+    ~protocol_sniffer();
+    /**
+     * Adds a protocol.
+     * The matchers are tried in the order they were added.
+     * @param matcher The function that recognizes the protocol.
+     * @param handler The function that takes its connections.
+     */
+    void add(matcher_type matcher, handler_type handler);
+    /**
+     * Sets the handler for connections that don't match any protocol.
+     * Without one, they're closed.
+     * @param handler The function that takes the connections.
+     */
+    void set_fallback(handler_type handler) { fallback_ = std::move(handler); }
+    /**
+     * Watches a listener, and sniffs each connection it accepts.
+     * The listener is put into non-blocking mode. It must be removed with
+     * @ref detach() before it is closed or destroyed. The connections are
+     * handed over in blocking mode, as they would be from a plain
+     * accept().
+     * @param acc The listener.
+     * @return The error code on failure.
+     */
+    result<> attach(acceptor& acc);
+    /**
+     * Stops watching a listener.
+     * @param acc The listener.
+     */
+    void detach(acceptor& acc);
+    /**
+     * Adds a new connection to be sniffed.
+     * It's handed to a handler as soon as its protocol is known, back in
+     * the blocking mode it had when it was added.
+     * @param sock The connection.
+     * @return The error code if it couldn't be added to the reactor, in
+     *  	   which case the connection is closed.
+     */
+    result<> add_connection(stream_socket sock);
+    /**
+     * Hands the connections that are past their deadline to the fallback
+     * handler.
+     * @param now The current time.
+     * @return The number of connections that timed out.
+     */
+    size_t expire(clock::time_point now = clock::now());
+    /**
+     * Gets the time until the next deadline, to use as the timeout for
+     * the reactor.
+     * @return The time until the next deadline, or -1 if there are no
+     *  	   connections waiting.
+     */
+    milliseconds next_timeout() const;
+    /**
+     * Gets the number of connections waiting to be matched.
+     * @return The number of connections waiting to be matched.
+     */
+    size_t pending() const noexcept { return pending_.size(); }
+
+    /**
+     * Gets a matcher for data that starts with a fixed string, like a
+     * magic number.
+     * @param prefix The bytes that start the protocol.
+     * @return A matcher for the prefix.
+     */
+    static matcher_type prefix(std::string prefix);
+    /**
+     * Gets a matcher for TLS: a handshake record from SSL 3.0 or later.
+     * @return A matcher for TLS.
+     */
+    static matcher_type tls();
+    /**
+     * Gets a matcher for plain HTTP/1.x requests, by their method, and the
+     * HTTP/2 prior-knowledge preface.
+     * @return A matcher for HTTP.
+     */
+    static matcher_type http();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_protocol_sniffer_h
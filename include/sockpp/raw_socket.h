@@ -68,11 +68,15 @@ class raw_socket : public socket
 protected:
     /**
      * Creates a raw socket.
+     * @param domain The communications domain (address family).
+     * @param protocol The particular protocol to be used with the socket.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return An OS handle to a raw socket on success, or an error code on
      *         failure.
      */
-    static result<socket_t> create_handle(int domain, int protocol = 0) {
-        return check_socket(socket_t(::socket(domain, COMM_TYPE, protocol)));
+    static result<socket_t> create_handle(int domain, int protocol = 0, int flags = 0) {
+        return base::create_handle(domain, COMM_TYPE, protocol, flags);
     }
 
 public:
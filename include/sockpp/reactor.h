@@ -0,0 +1,241 @@
+/**
+ * @file reactor.h
+ *
+ * Single-threaded, event-driven dispatcher for socket I/O readiness.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_reactor_h
+#define __sockpp_reactor_h
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "sockpp/poller.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An event loop that dispatches socket readiness to handler functions.
+ *
+ * The reactor allows a single thread to service a large number of
+ * non-blocking sockets, such as the `stream_socket` connections and the
+ * `acceptor` of a server. Each socket is registered with the set of events
+ * that are of interest and a handler that is called with the ready events
+ * whenever the socket becomes ready.
+ *
+ * Like the @ref poller on which it is built, the reactor does not own the
+ * sockets. The application must keep them alive while registered, and
+ * @ref remove() them before closing. It is safe to add or remove sockets
+ * from within a handler, including the handler's own socket.
+ *
+ * The sockets should normally be placed into non-blocking mode, and the
+ * handlers should read or write until the operation would block.
+ */
+class reactor
+{
+public:
+    /** The type of the function called when a socket is ready */
+    using handler_type = std::function<void(uint32_t events)>;
+    /** The type of the function called at the end of each loop iteration */
+    using tick_handler_type = std::function<void()>;
+
+private:
+    /** A registered socket */
+    struct entry
+    {
+        /** The events of interest */
+        uint32_t events;
+        /** The handler for the socket */
+        handler_type handler;
+    };
+
+    /** The OS readiness mechanism */
+    poller poller_;
+    /** The handlers, by socket handle */
+    std::unordered_map<socket_t, std::shared_ptr<entry>> handlers_;
+    /** The function called after each dispatch */
+    tick_handler_type tickHandler_;
+    /** Buffer for ready events */
+    std::vector<poller::event> evts_;
+    /** Whether the loop should stop */
+    std::atomic<bool> stopped_{false};
+
+    // Non-copyable
+    reactor(const reactor&) = delete;
+    reactor& operator=(const reactor&) = delete;
+
+public:
+    /**
+     * Creates a reactor.
+     * @throws std::system_error if the OS resources can't be created.
+     */
+    reactor();
+    /**
+     * Creates a reactor.
+     * @param ec Gets the error code on failure.
+     */
+    explicit reactor(error_code& ec) noexcept;
+    /**
+     * Gets the number of sockets registered with the reactor.
+     * @return The number of sockets registered with the reactor.
+     */
+    size_t size() const { return handlers_.size(); }
+    /**
+     * Determines if there are no sockets registered with the reactor.
+     * @return @em true if no sockets are registered.
+     */
+    bool empty() const { return handlers_.empty(); }
+    /**
+     * Determines if the socket handle is registered with the reactor.
+     * @param h A socket handle.
+     * @return @em true if the handle is registered.
+     */
+    bool contains(socket_t h) const { return handlers_.count(h) != 0; }
+    /**
+     * Calls a function with the handle of each registered socket.
+     *
+     * This is useful to sample or inspect all the connections serviced by
+     * the reactor, such as getting the @ref stream_socket::tcp_info() for
+     * each one. The function must not add or remove sockets.
+     *
+     * @param fn The function, taking a `socket_t` handle.
+     */
+    template <typename F>
+    void for_each_handle(F&& fn) const {
+        for (const auto& ent : handlers_) fn(ent.first);
+    }
+    /**
+     * Registers a socket with the reactor.
+     * @param h The socket handle.
+     * @param events The events of interest (poller::READABLE, etc).
+     * @param handler The function to call when the socket is ready.
+     * @return The error code on failure.
+     */
+    result<> add(socket_t h, uint32_t events, handler_type handler);
+    /**
+     * Registers a socket with the reactor.
+     * @param sock The socket.
+     * @param events The events of interest (poller::READABLE, etc).
+     * @param handler The function to call when the socket is ready.
+     * @return The error code on failure.
+     */
+    result<> add(const socket& sock, uint32_t events, handler_type handler) {
+        return add(sock.handle(), events, std::move(handler));
+    }
+    /**
+     * Changes the events of interest for a registered socket.
+     * @param h The socket handle.
+     * @param events The new set of events of interest.
+     * @return The error code on failure.
+     */
+    result<> modify(socket_t h, uint32_t events);
+    /**
+     * Changes the events of interest for a registered socket.
+     * @param sock The socket.
+     * @param events The new set of events of interest.
+     * @return The error code on failure.
+     */
+    result<> modify(const socket& sock, uint32_t events) {
+        return modify(sock.handle(), events);
+    }
+    /**
+     * Removes a socket from the reactor.
+     * This must be called before the socket is closed.
+     * @param h The socket handle.
+     * @return The error code on failure.
+     */
+    result<> remove(socket_t h);
+    /**
+     * Removes a socket from the reactor.
+     * This must be called before the socket is closed.
+     * @param sock The socket.
+     * @return The error code on failure.
+     */
+    result<> remove(const socket& sock) { return remove(sock.handle()); }
+    /**
+     * Sets a function to call at the end of each iteration of the loop.
+     *
+     * This is called after all the ready events from a wait have been
+     * dispatched, before waiting again. It's the place for work that
+     * should be batched across the handlers, such as flushing the
+     * @ref write_queue of each connection that had data queued.
+     *
+     * @param fn The function to call, or an empty function for none.
+     */
+    void on_tick(tick_handler_type fn) { tickHandler_ = std::move(fn); }
+    /**
+     * Waits for sockets to become ready, and dispatches the events to
+     * their handlers.
+     * @param timeout The maximum amount of time to wait for an event. A
+     *  			  negative value waits forever.
+     * @return The number of events dispatched on success, or an error code
+     *         on failure.
+     */
+    result<size_t> run_once(milliseconds timeout = milliseconds{-1});
+    /**
+     * Runs the event loop until @ref stop() is called or there are no more
+     * sockets registered.
+     * @return The error code if the loop exited due to an error.
+     */
+    result<> run();
+    /**
+     * Requests that the event loop stop.
+     * The loop exits after the current dispatch completes.
+     */
+    void stop() { stopped_ = true; }
+    /**
+     * Determines if the reactor was requested to stop.
+     * @return @em true if the reactor was requested to stop.
+     */
+    bool stopped() const { return stopped_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_reactor_h
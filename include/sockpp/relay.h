@@ -0,0 +1,238 @@
+/**
+ * @file relay.h
+ *
+ * A bidirectional relay that moves data between two stream sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_relay_h
+#define __sockpp_relay_h
+
+#include <cstdint>
+#include <functional>
+
+#include "sockpp/buffer_pool.h"
+#include "sockpp/reactor.h"
+#include "sockpp/stream_socket.h"
+
+#if defined(__linux__)
+    #include "sockpp/splice_pipe.h"
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Moves data in both directions between two stream sockets, as the core of
+ * a layer-4 proxy or port forwarder.
+ *
+ * On Linux, each direction has a @ref splice_pipe, so the data goes from
+ * one socket to the other without being copied into user space.
+ * Elsewhere, or if a pipe can't be created, the data is copied through a
+ * buffer that's taken from a @ref buffer_pool only while there's data in
+ * flight, so an idle relay doesn't hold any memory for it.
+ *
+ * When one side reaches the end of its stream, the relay half-closes the
+ * other with `shutdown(SHUT_WR)`, once everything before it has been
+ * delivered. The relay is done when both directions have ended this way.
+ * Any error on either socket ends the relay right away.
+ *
+ * The relay is normally driven by a @ref reactor, so that a single thread
+ * can serve thousands of them. Each direction stops reading its source
+ * while the destination is backed up, so a slow side throttles the
+ * other, rather than the relay buffering without bound. The sockets are
+ * put into non-blocking mode.
+ *
+ * Like the reactor, the relay refers to the sockets but doesn't own them.
+ * They must outlive the relay, or at least its time in the reactor, and
+ * the application closes them once it's done. Splicing to a peer that has
+ * gone away fails with `errc::broken_pipe`, like any other write, rather
+ * than raising `SIGPIPE`.
+ */
+class relay
+{
+public:
+    /** The function called when the relay is done, with any error */
+    using done_handler = std::function<void(relay&, error_code)>;
+
+private:
+    /** The state of one direction of the relay */
+    struct direction
+    {
+        /** The socket to read */
+        stream_socket* src;
+        /** The socket to write */
+        stream_socket* dst;
+#if defined(__linux__)
+        /** The pipe for splicing, if it could be created */
+        splice_pipe pipe;
+#endif
+        /** The buffer for copying, while it holds data */
+        pooled_buffer buf;
+        /** The offset of the next byte to write from the buffer */
+        size_t off{0};
+        /** The number of bytes delivered to the destination */
+        uint64_t nbytes{0};
+        /** Whether the source reached the end of its stream */
+        bool eof{false};
+        /** Whether the destination was half-closed */
+        bool closed{false};
+
+        direction(stream_socket& s, stream_socket& d);
+
+        /** Whether there's data waiting for the destination */
+        bool pending() const noexcept;
+        /** Moves as much data as possible without blocking */
+        result<> pump(buffer_pool& pool);
+        /** Moves data through the pipe */
+        result<> splice();
+        /** Moves data through a buffer */
+        result<> copy(buffer_pool& pool);
+    };
+
+    /** Data from the first socket to the second */
+    direction ab_;
+    /** Data from the second socket to the first */
+    direction ba_;
+    /** The pool for copy buffers */
+    buffer_pool& pool_;
+    /** The reactor driving the relay, if any */
+    reactor* rx_{nullptr};
+    /** Called once the relay is done */
+    done_handler onDone_;
+
+    /** The events of interest for one of the sockets */
+    uint32_t interest(const direction& out, const direction& in) const noexcept;
+    /** Handles readiness of either socket in the reactor */
+    void on_ready();
+
+    /** Gets the pool used when none is given. */
+    static buffer_pool& default_pool();
+
+    // Non-copyable
+    relay(const relay&) = delete;
+    relay& operator=(const relay&) = delete;
+
+public:
+    /**
+     * Creates a relay between two connected sockets.
+     * Any copy buffers come from a pool shared by the whole process.
+     * @param a The first socket.
+     * @param b The second socket.
+     */
+    relay(stream_socket& a, stream_socket& b) : relay(a, b, default_pool()) {}
+    /**
+     * Creates a relay between two connected sockets.
+     * @param a The first socket.
+     * @param b The second socket.
+     * @param pool The pool for the copy buffers. It must outlive the
+     *  		   relay.
+     */
+    relay(stream_socket& a, stream_socket& b, buffer_pool& pool);
+    /**
+     * Destructor removes the sockets from the reactor, if they're still
+     * registered.
+     */
+    ~relay() { detach(); }
+    /**
+     * Determines if the data is being spliced in the kernel, rather than
+     * copied through user space.
+     * @return @em true if both directions use splice().
+     */
+    bool is_spliced() const noexcept;
+    /**
+     * Gets the number of bytes delivered from the first socket to the
+     * second.
+     * @return The number of bytes delivered from the first socket.
+     */
+    uint64_t bytes_a_to_b() const noexcept { return ab_.nbytes; }
+    /**
+     * Gets the number of bytes delivered from the second socket to the
+     * first.
+     * @return The number of bytes delivered from the second socket.
+     */
+    uint64_t bytes_b_to_a() const noexcept { return ba_.nbytes; }
+    /**
+     * Determines if both directions have reached the end of their
+     * streams and been delivered.
+     * @return @em true if the relay is done.
+     */
+    bool done() const noexcept { return ab_.closed && ba_.closed; }
+    /**
+     * Moves as much data as possible in both directions without
+     * blocking.
+     * This is what the reactor calls when either socket is ready. It
+     * can also be used with some other event loop.
+     * @return @em true if the relay is done, or the error code on
+     *  	   failure.
+     */
+    result<bool> pump();
+    /**
+     * Starts the relay in a reactor.
+     *
+     * The sockets are put into non-blocking mode and added to the
+     * reactor, which then moves the data as they become ready. When the
+     * relay is done, or fails, the sockets are removed from the reactor
+     * and the handler is called. The handler may destroy the relay.
+     * @param rx The reactor to drive the relay.
+     * @param onDone The function to call when the relay is done.
+     * @return The error code on failure.
+     */
+    result<> attach(reactor& rx, done_handler onDone = nullptr);
+    /**
+     * Removes the sockets from the reactor, stopping the relay without
+     * calling the done handler.
+     */
+    void detach();
+    /**
+     * Runs the relay to completion in the calling thread.
+     * This uses a private reactor for just this relay.
+     * @return The error code on failure.
+     */
+    result<> run();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_relay_h
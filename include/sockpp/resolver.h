@@ -0,0 +1,261 @@
+/**
+ * @file resolver.h
+ *
+ * Host name resolution with a shared, thread-safe cache and a pool of
+ * background threads for non-blocking lookups.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_resolver_h
+#define __sockpp_resolver_h
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "sockpp/result.h"
+#include "sockpp/sock_address.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A host name resolver with a cache.
+ *
+ * This wraps the system resolver, `getaddrinfo()`, which blocks the
+ * calling thread, possibly for a long time if the name servers are slow.
+ * The resolver adds two things:
+ *
+ * - A thread-safe cache of lookups. Successful lookups are kept for a
+ *   fixed time-to-live, and failed ones ("negative" results) for a
+ *   shorter time so that a name that doesn't resolve is not asked for
+ *   again on every reconnect attempt. The system resolver doesn't report
+ *   the TTL of the DNS records, so these are configured for the resolver.
+ *
+ * - A small pool of background threads to do lookups, so that the
+ *   application can request an address without blocking. Concurrent
+ *   requests for the same name share a single lookup.
+ *
+ * Lookups return all of the addresses for a host, not just the first,
+ * ordered by @ref lookup().
+ *
+ * A single, process-wide instance is available from @ref global(), but
+ * an application can create as many as it likes.
+ */
+class resolver
+{
+public:
+    /** A list of resolved addresses */
+    using addr_list = std::vector<sock_address_any>;
+    /** The result of a lookup */
+    using result_type = result<addr_list>;
+    /** A function to get the result of an asynchronous lookup */
+    using handler = std::function<void(result_type)>;
+
+    /** The default time to keep a successful lookup */
+    static constexpr seconds DFLT_TTL = seconds(60);
+    /** The default time to keep a failed lookup */
+    static constexpr seconds DFLT_NEGATIVE_TTL = seconds(5);
+    /** The default number of background threads */
+    static constexpr size_t DFLT_NUM_THREADS = 2;
+    /** The default maximum number of cached names */
+    static constexpr size_t DFLT_MAX_ENTRIES = 1024;
+
+private:
+    /** The key for a lookup: the address family and host name */
+    using key_type = std::pair<int, std::string>;
+    /** The clock for cache expiry */
+    using clock = std::chrono::steady_clock;
+
+    /** A cached lookup */
+    struct entry
+    {
+        /** The addresses, with a port of zero */
+        addr_list addrs;
+        /** The error if the lookup failed */
+        error_code err;
+        /** When the entry expires */
+        clock::time_point expiry;
+    };
+
+    /** The time to keep successful lookups */
+    seconds ttl_;
+    /** The time to keep failed lookups */
+    seconds negTtl_;
+    /** The maximum number of cached names */
+    size_t maxEntries_;
+    /** The maximum number of worker threads */
+    size_t nThreads_;
+
+    /** Lock for all the shared state */
+    mutable std::mutex mtx_;
+    /** Signals the worker threads that there's work, or to quit */
+    std::condition_variable cv_;
+    /** The cache */
+    std::map<key_type, entry> cache_;
+    /** Lookups in progress, with the port and handler for each request */
+    std::map<key_type, std::vector<std::pair<in_port_t, handler>>> inFlight_;
+    /** The lookups waiting for a worker */
+    std::deque<key_type> queue_;
+    /** The worker threads */
+    std::vector<std::thread> threads_;
+    /** The number of workers waiting for a lookup */
+    size_t nIdle_{0};
+    /** Set when the resolver is being destroyed */
+    bool quit_{false};
+
+    /** The worker thread function */
+    void run();
+    /** Queues a lookup for the workers, with the lock held. */
+    void enqueue(const key_type& key, in_port_t port, handler h);
+    /** Finds an unexpired entry, with the lock held. */
+    const entry* find(const key_type& key) const;
+    /** Adds a lookup to the cache, with the lock held. */
+    void store(const key_type& key, const result_type& res);
+    /** Makes a result from a cached entry for a specific port. */
+    static result_type make_result(const entry& e, in_port_t port);
+
+    // Non-copyable
+    resolver(const resolver&) = delete;
+    resolver& operator=(const resolver&) = delete;
+
+public:
+    /**
+     * Creates a resolver.
+     * The background threads are started with the first asynchronous
+     * request.
+     * @param nThreads The number of background threads for lookups.
+     * @param ttl The time to keep a successful lookup in the cache.
+     * @param negTtl The time to keep a failed lookup in the cache.
+     * @param maxEntries The maximum number of names in the cache.
+     */
+    explicit resolver(
+        size_t nThreads = DFLT_NUM_THREADS, seconds ttl = DFLT_TTL,
+        seconds negTtl = DFLT_NEGATIVE_TTL, size_t maxEntries = DFLT_MAX_ENTRIES
+    );
+    /**
+     * Destroys the resolver.
+     * This waits for any lookups in progress to complete. Requests that
+     * have not been started are completed with `errc::operation_canceled`.
+     */
+    ~resolver();
+    /**
+     * Gets a process-wide, shared resolver, with the default settings.
+     * @return A reference to the shared resolver.
+     */
+    static resolver& global();
+    /**
+     * Looks up a host name with the system resolver, bypassing any cache.
+     *
+     * The addresses are in the order preferred by the system, but
+     * interleaved so that the address families alternate, starting with
+     * the family of the most preferred address, as is suitable for a
+     * "Happy Eyeballs" connection race (RFC 8305). Duplicates are removed.
+     * @param host The host name or numeric address.
+     * @param port The port number in native/host byte order.
+     * @param family The address family to look up. The default,
+     *  			 AF_UNSPEC, gets both IPv4 and IPv6 addresses.
+     * @return The list of addresses, or the error code on failure.
+     */
+    static result_type lookup(const string& host, in_port_t port, int family = AF_UNSPEC);
+    /**
+     * Resolves a host name, using the cache, blocking the calling thread
+     * if the name needs to be looked up.
+     * @param host The host name or numeric address.
+     * @param port The port number in native/host byte order.
+     * @param family The address family to look up.
+     * @return The list of addresses, or the error code on failure.
+     */
+    result_type resolve(const string& host, in_port_t port, int family = AF_UNSPEC);
+    /**
+     * Resolves a host name from the cache, without blocking.
+     *
+     * If the name isn't in the cache, a lookup is started in the
+     * background, and `errc::operation_would_block` is returned. The
+     * caller can try again later.
+     * @param host The host name or numeric address.
+     * @param port The port number in native/host byte order.
+     * @param family The address family to look up.
+     * @return The list of addresses, the error code from a failed lookup,
+     *  	   or `errc::operation_would_block` if the name is not yet
+     *  	   known.
+     */
+    result_type try_resolve(const string& host, in_port_t port, int family = AF_UNSPEC);
+    /**
+     * Resolves a host name without blocking, delivering the result to a
+     * handler.
+     *
+     * If the name is in the cache, the handler is called immediately, on
+     * the calling thread. Otherwise it's called from one of the resolver's
+     * threads when the lookup completes. The handler should not block.
+     * @param host The host name or numeric address.
+     * @param port The port number in native/host byte order.
+     * @param h The handler for the result.
+     * @param family The address family to look up.
+     */
+    void resolve_async(
+        const string& host, in_port_t port, handler h, int family = AF_UNSPEC
+    );
+    /**
+     * Gets the number of names in the cache, including any that have
+     * expired but not yet been removed.
+     * @return The number of names in the cache.
+     */
+    size_t cache_size() const;
+    /**
+     * Removes all the names from the cache.
+     */
+    void clear_cache();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_resolver_h
@@ -42,6 +42,7 @@
 #define __sockpp_result_h
 
 #include <iostream>
+#include <type_traits>
 
 #include "sockpp/error.h"
 #include "sockpp/platform.h"
@@ -70,18 +71,111 @@ inline std::ostream& operator<<(std::ostream& os, const none&) {
 
 /////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/**
+ * Determines whether a result for type T can use the compact storage.
+ *
+ * This is any type that can be copied with memcpy and have a default to
+ * report when the operation failed, such as the integer counts and
+ * handles returned from most socket calls.
+ */
+template <typename T>
+constexpr bool is_compact_result_v =
+    std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value;
+
+/**
+ * The general storage for a result.
+ *
+ * The value and the error code are kept side-by-side. When the error code
+ * indicates a failure, the value is left at the default for the type.
+ */
+template <typename T, bool = is_compact_result_v<T>>
+class result_storage
+{
+    /** The return value of an operation, if successful */
+    T val_{};
+    /** The error returned from an operation, if failed */
+    error_code err_{};
+
+public:
+    result_storage() = default;
+    result_storage(const T& val) : val_{val} {}
+    result_storage(T&& val) : val_{std::move(val)} {}
+    result_storage(const error_code& err) : err_{err} {}
+
+    int code() const noexcept { return err_.value(); }
+    const error_category& category() const noexcept { return err_.category(); }
+    error_code error() const noexcept { return err_; }
+
+    const T& value() const noexcept { return val_; }
+    T&& release() noexcept { return std::move(val_); }
+};
+
+/**
+ * The compact storage for a result of a trivially-copyable type.
+ *
+ * The success value shares space with the error category, and only the
+ * integer part of the error code is kept on its own. That makes a
+ * `result<size_t>` the size of two pointers, which the common ABI's can
+ * return in a pair of registers, and no `std::error_code` is built until
+ * one is actually requested.
+ */
+template <typename T>
+class result_storage<T, true>
+{
+    union {
+        /** The return value of an operation, if successful */
+        T val_;
+        /** The error category, if failed */
+        const error_category* cat_;
+    };
+    /** The platform error number, or zero on success */
+    int code_{0};
+
+    /** The value reported from a failed operation */
+    inline static const T dflt_{};
+
+public:
+    result_storage() noexcept : val_{} {}
+    result_storage(const T& val) noexcept : val_{val} {}
+    result_storage(const error_code& err) noexcept : val_{}, code_{err.value()} {
+        if (code_)
+            cat_ = &err.category();
+    }
+
+    int code() const noexcept { return code_; }
+    const error_category& category() const noexcept {
+        return code_ ? *cat_ : std::system_category();
+    }
+    error_code error() const noexcept {
+        return code_ ? error_code{code_, *cat_} : error_code{};
+    }
+
+    const T& value() const noexcept { return code_ ? dflt_ : val_; }
+    T release() noexcept { return value(); }
+};
+
+}  // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////
+
 /**
  * A result type that can contain a value of any type on successful
  * completion of an operation, or a std::error_code on failure.
  *
  * Objects can contain a value of type T on an operation's success, or a
- * standard `error_code` on failure. As an implementation detail, the class
- * isn't implemented with a union or variant, but rather both types are
- * available. When the error code indicates "success" (where it has an
- * internal value of zero), then the result value is considered valid. If
- * the code contains an error, that takes precedence and the result value is
- * set to the default for that type - zero for an int, empty for a string,
- * etc.
+ * standard `error_code` on failure. When the error code indicates
+ * "success" (where it has an internal value of zero), then the result
+ * value is considered valid. If the code contains an error, that takes
+ * precedence and the result value is reported as the default for that
+ * type - zero for an int, empty for a string, etc.
+ *
+ * As an implementation detail, a result for a trivially-copyable type,
+ * like the `size_t` returned from a read or write, keeps the value and
+ * the error in the same space, and holds just the integer error number
+ * and category until an `error_code` is requested. Other types, like
+ * sockets or strings, keep both the value and error code side-by-side.
  *
  * The result can act as a boolean - @em true for a successful result, @em
  * false for an error/failure.
@@ -100,23 +194,9 @@ inline std::ostream& operator<<(std::ostream& os, const none&) {
 template <typename T = none>
 class result
 {
-    /** The return value of an operation, if successful */
-    T val_{};
-    /** The error returned from an operation, if failed */
-    error_code err_{};
+    /** The value or error */
+    detail::result_storage<T> store_;
 
-    /**
-     * Private helper constructor to build a result.
-     * @param val The value
-     * @param err The error
-     */
-    result(const T& val, const error_code& err) : val_{val}, err_{err} {}
-    /**
-     * Private helper constructor to build a result.
-     * @param val The value
-     * @param err The error
-     */
-    result(T&& val, const error_code& err) : val_{std::move(val)}, err_{err} {}
     /**
      * OS-specific means to retrieve the last error from an operation.
      * This should be called after a failed system call to get the cause of
@@ -144,33 +224,28 @@ public:
      * Construct a success result with the specified value.
      * @param val The success value
      */
-    result(const T& val) : val_{val} {}
+    result(const T& val) : store_{val} {}
     /**
      * Construct a success result with the specified value.
      * @param val The success value
      */
-    result(T&& val) : val_{std::move(val)} {}
+    result(T&& val) : store_{std::move(val)} {}
     /**
      * Creates a failed result from a portable error condition.
      * @param err The error
      */
-    result(errc err) : err_{std::make_error_code(err)} {}
+    result(errc err) : store_{std::make_error_code(err)} {}
     /**
      * Creates a failed result from a portable error condition.
      * @param err The error
      */
-    result(const error_code& err) : err_{err} {}
-    /**
-     * Creates a failed result from a portable error condition.
-     * @param err The error
-     */
-    result(error_code&& err) : err_{std::move(err)} {}
+    result(const error_code& err) : store_{err} {}
     /**
      * Creates a failed result from an error code.
      * @param err The error code from an operation.
      * @return The result of an unsucessful operation.
      */
-    static result from_error(const error_code& err) { return result{T{}, err}; }
+    static result from_error(const error_code& err) { return result{err}; }
     /**
      * Creates a failed result from an platform-specific integer error code
      * and an optional category.
@@ -179,7 +254,7 @@ public:
      * @return The result of an unsuccessful operation.
      */
     static result from_error(int ec, const error_category& ecat = std::system_category()) {
-        return result{T{}, {ec, ecat}};
+        return result{error_code{ec, ecat}};
     }
     /**
      * Creates an unsuccesful result from a portable error condition.
@@ -209,7 +284,48 @@ public:
      * @return @em true if the result is from a failed operation, @em false
      *  	   if the operation succeeded.
      */
-    bool is_error() const { return bool(err_); }
+    bool is_error() const { return store_.code() != 0; }
+    /**
+     * Determines if the result failed with a specific portable error.
+     *
+     * This is equivalent to `error() == err`, but for errors from the
+     * system or generic categories, which are the ones that come from the
+     * socket calls, it's a simple integer comparison that doesn't need to
+     * build an error code or call into the category. It's meant for the
+     * checks in a tight I/O loop, like retrying after `errc::interrupted`.
+     *
+     * @param err The portable error condition.
+     * @return @em true if the result holds the specified error.
+     */
+    bool is_error(errc err) const noexcept {
+        int ec = store_.code();
+        if (ec == 0)
+            return int(err) == 0;
+
+        const auto& cat = store_.category();
+#if !defined(_WIN32)
+        // On POSIX the errno values are the portable errc values
+        if (cat == std::system_category())
+            return ec == int(err);
+#endif
+        if (cat == std::generic_category())
+            return ec == int(err);
+        return store_.error() == err;
+    }
+    /**
+     * Determines if the result failed only because a non-blocking
+     * operation would have blocked.
+     *
+     * This checks for both `errc::operation_would_block` and
+     * `errc::resource_unavailable_try_again`, since they are different
+     * errors on some platforms.
+     *
+     * @return @em true if the operation would have blocked.
+     */
+    bool is_would_block() const noexcept {
+        return is_error(errc::operation_would_block) ||
+               is_error(errc::resource_unavailable_try_again);
+    }
     /**
      * Determines if the result represents a successful operation.
      *
@@ -217,7 +333,7 @@ public:
      * @return @em true if the result is from a successful operation, @em
      *  	   false if the operation failed.
      */
-    bool is_ok() const { return !bool(err_); }
+    bool is_ok() const { return store_.code() == 0; }
     /**
      * Determines if the result represents a successful operation.
      *
@@ -226,7 +342,7 @@ public:
      * @return @em true if the result is from a successful operation, @em
      *  	   false if the operation failed.
      */
-    explicit operator bool() const { return !bool(err_); }
+    explicit operator bool() const { return store_.code() == 0; }
     /**
      * Gets the value from a successful operation.
      *
@@ -234,7 +350,7 @@ public:
      * the default value for type T.
      * @return A const reference to the success value.
      */
-    const T& value() const { return val_; };
+    const T& value() const { return store_.value(); };
     /**
      * Gets the value if the result is a success, otherwise throws a system
      * error exception corresponding to the internal error code if it hold
@@ -243,9 +359,9 @@ public:
      * @throws std::system_error if the result is an error
      */
     const T& value_or_throw() const {
-        if (err_)
-            throw std::system_error{err_};
-        return val_;
+        if (is_error())
+            throw std::system_error{store_.error()};
+        return store_.value();
     }
     /**
      * Releases the value from this result.
@@ -256,11 +372,14 @@ public:
      * that only implements move semantics (such as a socket), or if the
      * caller would rather not copy the object.
      *
+     * For trivially-copyable types, this simply returns a copy of the
+     * value.
+     *
      * The result should not be used after releasing the value.
      *
      * @return The success value.
      */
-    T&& release() { return std::move(val_); }
+    decltype(auto) release() { return store_.release(); }
     /**
      * Releases the value if the result is a success, otherwise throws a
      * system error exception corresponding to the internal error code if it
@@ -268,28 +387,28 @@ public:
      *
      * The result should not be used after releasing the value.
      *
-     * @return A const reference to the success value.
+     * @return The success value.
      * @throws std::system_error if the result is an error
      */
-    T&& release_or_throw() {
-        if (err_)
-            throw std::system_error{err_};
-        return std::move(val_);
+    decltype(auto) release_or_throw() {
+        if (is_error())
+            throw std::system_error{store_.error()};
+        return store_.release();
     }
     /**
      * Gets the error code from a failed operation.
      *
      * This is only valid if the operation failed. If not, it returns the
      * default error code which should have a value of zero (success).
-     * @return A const reference to the error code.
+     * @return The error code.
      */
-    const error_code& error() const { return err_; }
+    error_code error() const { return store_.error(); }
     /**
      * Gets the message corresponding to the current error.
      * Equivalent to `error().message()`
      * @return The message corresponding to the current error.
      */
-    std::string error_message() const { return err_.message(); }
+    std::string error_message() const { return store_.error().message(); }
 };
 
 /**
@@ -442,7 +561,7 @@ bool operator==(const error_code& err, const result<T>& res) noexcept {
  */
 template <typename T>
 bool operator==(const result<T>& res, const errc& err) noexcept {
-    return res.error() == err;
+    return res.is_error(err);
 }
 
 /**
@@ -455,7 +574,7 @@ bool operator==(const result<T>& res, const errc& err) noexcept {
  */
 template <typename T>
 bool operator==(const errc& err, const result<T>& res) noexcept {
-    return err == res.error();
+    return res.is_error(err);
 }
 
 /**
@@ -494,7 +613,7 @@ bool operator!=(const error_code& err, const result<T>& res) noexcept {
  */
 template <typename T>
 bool operator!=(const result<T>& res, const errc& err) noexcept {
-    return res.error() != err;
+    return !res.is_error(err);
 }
 
 /**
@@ -507,7 +626,7 @@ bool operator!=(const result<T>& res, const errc& err) noexcept {
  */
 template <typename T>
 bool operator!=(const errc& err, const result<T>& res) noexcept {
-    return res.error() != err;
+    return !res.is_error(err);
 }
 
 #if 0
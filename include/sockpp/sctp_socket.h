@@ -0,0 +1,302 @@
+/**
+ * @file sctp_socket.h
+ *
+ * Multi-stream SCTP sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_sctp_socket_h
+#define __sockpp_sctp_socket_h
+
+#include "sockpp/cmsg.h"
+#include "sockpp/inet6_address.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/stream_socket.h"
+
+#if defined(__linux__)
+    #include <linux/sctp.h>
+#elif !defined(_WIN32)
+    #include <netinet/sctp.h>
+#endif
+
+#if !defined(_WIN32)
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The delivery information for an SCTP message.
+ *
+ * This is given when sending a message, to pick the stream it goes out
+ * on, and is filled in when receiving one.
+ */
+struct sctp_msg_info
+{
+    /** The stream that carries the message */
+    uint16_t stream{0};
+    /**
+     * The payload protocol identifier. This is passed to the peer as-is,
+     * and by convention is in network byte order.
+     */
+    uint32_t ppid{0};
+    /** Whether the message is delivered as soon as it arrives, out of order */
+    bool unordered{false};
+    /**
+     * On receive, whether this is the end of the message. A message too
+     * large for the buffer is read in pieces, and this is only set on the
+     * last one.
+     */
+    bool complete{true};
+};
+
+/**
+ * A one-to-one style SCTP socket, with messages on multiple streams.
+ *
+ * An SCTP association carries a number of independent streams. Messages
+ * are delivered in order within each stream, but a message lost on one
+ * stream doesn't hold up the others, which avoids the head-of-line
+ * blocking of sending several logical channels over one TCP connection.
+ * Unlike TCP, SCTP also keeps message boundaries.
+ *
+ * The socket can be used as a plain stream socket, which sends and
+ * receives on stream zero. The @ref send() and @ref recv() overloads that
+ * take an @ref sctp_msg_info choose the stream, and tell which stream a
+ * message came in on, once @ref recv_info() is enabled.
+ *
+ * The number of streams is negotiated when the association is set up.
+ * The Linux default is 10 outbound streams; to ask for a different
+ * number, call @ref init_streams() on the connector or acceptor before it
+ * connects or listens.
+ *
+ * A connector for SCTP is a plain @ref connector, so once it's connected
+ * it's moved into an SCTP socket to use the streams:
+ *
+ *     sctp_connector conn{addr};
+ *     sctp_socket sock{std::move(conn)};
+ *
+ * SCTP is only available where the kernel supports it. Otherwise creating
+ * a socket fails with `errc::protocol_not_supported`.
+ *
+ * @tparam ADDR The type of address for the socket.
+ */
+template <typename ADDR>
+class sctp_socket_tmpl : public stream_socket_tmpl<ADDR, IPPROTO_SCTP>
+{
+    /** The base class */
+    using base = stream_socket_tmpl<ADDR, IPPROTO_SCTP>;
+
+public:
+    /** The type of network address used with this socket. */
+    using addr_t = ADDR;
+
+    /**
+     * Creates an unconnected SCTP socket.
+     */
+    sctp_socket_tmpl() {}
+    /**
+     * Creates an SCTP socket from an existing OS socket handle and claims
+     * ownership of the handle.
+     * @param handle A socket handle from the operating system.
+     */
+    explicit sctp_socket_tmpl(socket_t handle) : base(handle) {}
+    /**
+     * Creates an SCTP socket by moving another socket into this one, such
+     * as a connected @ref sctp_connector.
+     * @param sock Another stream socket.
+     */
+    sctp_socket_tmpl(stream_socket&& sock) : base(std::move(sock)) {}
+    /**
+     * Creates an SCTP socket by moving another socket into this one, and
+     * keeps the address of the remote peer.
+     * @param sock Another stream socket.
+     * @param peerAddr The address of the remote peer.
+     */
+    sctp_socket_tmpl(stream_socket&& sock, const addr_t& peerAddr)
+        : base(std::move(sock), peerAddr) {}
+    /**
+     * Move constructor.
+     * @param sock Another SCTP socket.
+     */
+    sctp_socket_tmpl(sctp_socket_tmpl&& sock) : base(std::move(sock)) {}
+    /**
+     * Move assignment.
+     * @param rhs The other socket to move into this one.
+     * @return A reference to this object.
+     */
+    sctp_socket_tmpl& operator=(sctp_socket_tmpl&& rhs) {
+        base::operator=(std::move(rhs));
+        return *this;
+    }
+    /**
+     * Sets the number of streams to ask for when an association is set
+     * up.
+     * This must be done before the socket connects, or on a listener
+     * before it starts listening, so it takes any socket, like a
+     * connector that has been opened with @ref connector::open().
+     * @param sock The SCTP socket.
+     * @param nOut The number of outbound streams.
+     * @param maxIn The most inbound streams to accept from the peer. Zero
+     *  			leaves the system default.
+     * @return The error code on failure.
+     */
+    static result<> init_streams(socket& sock, uint16_t nOut, uint16_t maxIn = 0) {
+        sctp_initmsg init{};
+        init.sinit_num_ostreams = nOut;
+        init.sinit_max_instreams = maxIn;
+        return sock.set_option(IPPROTO_SCTP, SCTP_INITMSG, init);
+    }
+    /**
+     * Gets the number of inbound streams of the association.
+     * @return The number of streams the peer can send on, or the error
+     *  	   code on failure.
+     */
+    result<uint16_t> in_streams() const {
+        auto res = this->template get_option<sctp_status>(IPPROTO_SCTP, SCTP_STATUS);
+        if (!res)
+            return res.error();
+        return uint16_t(res.value().sstat_instrms);
+    }
+    /**
+     * Gets the number of outbound streams of the association.
+     * @return The number of streams this side can send on, or the error
+     *  	   code on failure.
+     */
+    result<uint16_t> out_streams() const {
+        auto res = this->template get_option<sctp_status>(IPPROTO_SCTP, SCTP_STATUS);
+        if (!res)
+            return res.error();
+        return uint16_t(res.value().sstat_outstrms);
+    }
+    /**
+     * Determines if messages are sent without delay (`SCTP_NODELAY`).
+     * This is the SCTP equivalent of turning off Nagle's algorithm.
+     * @return Whether the delay is off, or the error code on failure.
+     */
+    result<bool> nodelay() const {
+        return this->template get_option<bool>(IPPROTO_SCTP, SCTP_NODELAY);
+    }
+    /**
+     * Sets whether messages are sent without delay (`SCTP_NODELAY`).
+     * @param on Whether to turn the delay off.
+     * @return The error code on failure.
+     */
+    result<> nodelay(bool on) { return this->set_option(IPPROTO_SCTP, SCTP_NODELAY, on); }
+    /**
+     * Sets whether the delivery information is received with each
+     * message (`SCTP_RECVRCVINFO`).
+     * This must be on for @ref recv() to report the stream of each
+     * message.
+     * @param on Whether to receive the information.
+     * @return The error code on failure.
+     */
+    result<> recv_info(bool on = true) {
+        return this->set_option(IPPROTO_SCTP, SCTP_RECVRCVINFO, int(on));
+    }
+
+    using base::recv;
+    using base::send;
+
+    /**
+     * Sends a message on a specific stream.
+     * @param buf The data to send.
+     * @param n The number of bytes to send.
+     * @param info The stream and delivery options for the message.
+     * @param flags The option bit flags. See sendmsg(2).
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> send(
+        const void* buf, size_t n, const sctp_msg_info& info, int flags = 0
+    ) {
+        sctp_sndinfo snd{};
+        snd.snd_sid = info.stream;
+        snd.snd_ppid = info.ppid;
+        snd.snd_flags = info.unordered ? SCTP_UNORDERED : 0;
+
+        cmsg_buffer<CMSG_SPACE(sizeof(sctp_sndinfo))> ctrl;
+        ctrl.add(IPPROTO_SCTP, SCTP_SNDINFO, snd);
+
+        iovec iov{const_cast<void*>(buf), n};
+        return this->send_msg(&iov, 1, ctrl, flags);
+    }
+    /**
+     * Receives a message, and tells which stream it came in on.
+     * The stream and protocol identifier are only filled in when
+     * @ref recv_info() is on; otherwise they're left at zero.
+     * @param buf The buffer for the data.
+     * @param n The size of the buffer.
+     * @param info Gets the delivery information for the message.
+     * @param flags The option bit flags. See recvmsg(2).
+     * @return The number of bytes received, or the error code on failure.
+     */
+    result<size_t> recv(void* buf, size_t n, sctp_msg_info& info, int flags = 0) {
+        cmsg_buffer<CMSG_SPACE(sizeof(sctp_rcvinfo))> ctrl;
+        iovec iov{buf, n};
+
+        auto res = this->recv_msg(&iov, 1, ctrl, nullptr, flags);
+        if (!res)
+            return res;
+
+        info = sctp_msg_info{};
+        sctp_rcvinfo rcv{};
+        if (cmsg_reader{ctrl}.get(IPPROTO_SCTP, SCTP_RCVINFO, rcv)) {
+            info.stream = rcv.rcv_sid;
+            info.ppid = rcv.rcv_ppid;
+            info.unordered = (rcv.rcv_flags & SCTP_UNORDERED) != 0;
+        }
+        info.complete = (ctrl.msg_flags() & MSG_EOR) != 0;
+        return res;
+    }
+};
+
+/** IPv4 one-to-one SCTP socket */
+using sctp_socket = sctp_socket_tmpl<inet_address>;
+
+/** IPv6 one-to-one SCTP socket */
+using sctp6_socket = sctp_socket_tmpl<inet6_address>;
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // !_WIN32
+
+#endif  // __sockpp_sctp_socket_h
@@ -0,0 +1,271 @@
+/**
+ * @file send_queue.h
+ *
+ * A lock-free, multi-producer queue of data to send on a stream socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_send_queue_h
+#define __sockpp_send_queue_h
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "sockpp/buffer_pool.h"
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A lock-free queue of outgoing data for a stream socket, which many
+ * threads can write, and a single thread sends.
+ *
+ * This is for a connection that has many producers, such as a subscriber
+ * in a pub/sub fanout, which would otherwise need a mutex around every
+ * write. Producers push messages from any thread without taking a lock,
+ * and without blocking behind a slow peer. The thread that owns the
+ * connection, typically its event loop, sends everything queued with
+ * gather writes by calling @ref flush().
+ *
+ * The messages are held in buffers from a @ref buffer_pool, and each
+ * buffer carries its own queue node in a small header at its front, so
+ * queueing a message does no heap allocation. A message larger than a
+ * buffer is copied into a chain of buffers, which is pushed as a unit so
+ * that it can't be interleaved with messages from other threads.
+ * Producers can also fill a @ref message directly, avoiding any copy.
+ *
+ * The queue is intrusive, wait-free for producers, and is the classic
+ * design by Dmitry Vyukov. Messages from a single producer are sent in
+ * the order they were pushed.
+ *
+ * Since the queue doesn't wake the reactor itself, @ref push()
+ * reports when a message goes onto an empty queue, so that the producer
+ * can signal the event loop by some means of its own, such as a
+ * @ref notifier registered with the reactor.
+ *
+ * The pool must outlive the queue. Its buffers must be larger than
+ * @ref HEADER_SIZE, and their size a multiple of the fundamental
+ * alignment, `alignof(std::max_align_t)`, so that each one can hold an
+ * aligned node at its front.
+ */
+class send_queue
+{
+    /** A queue node, at the front of each pooled buffer */
+    struct node
+    {
+        /** The next node in the lock-free queue */
+        std::atomic<node*> next{nullptr};
+        /** The next node in the consumer's list of nodes to send */
+        node* lnext{nullptr};
+        /** The buffer that holds this node */
+        pooled_buffer buf;
+        /** The offset of the unsent data */
+        size_t off{0};
+        /** The end of the data */
+        size_t len{0};
+    };
+
+public:
+    /** The space reserved for the queue node in each buffer */
+    static constexpr size_t HEADER_SIZE =
+        (sizeof(node) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    /**
+     * A message being built in a pooled buffer.
+     *
+     * This lets a producer write its data straight into the memory that
+     * will be queued, then push it with no copy.
+     */
+    class message
+    {
+        /** The pooled buffer, including the node header */
+        pooled_buffer buf_;
+
+        friend class send_queue;
+
+        explicit message(pooled_buffer&& buf) : buf_{std::move(buf)} {
+            buf_.resize(HEADER_SIZE);
+        }
+
+    public:
+        /**
+         * Creates an empty message with no buffer.
+         */
+        message() = default;
+        /**
+         * Determines if the message has a buffer.
+         */
+        explicit operator bool() const { return bool(buf_); }
+        /**
+         * Gets a pointer to the payload area of the message.
+         */
+        uint8_t* data() { return buf_.data() + HEADER_SIZE; }
+        /**
+         * Gets the size of the payload.
+         */
+        size_t size() const { return buf_ ? buf_.size() - HEADER_SIZE : 0; }
+        /**
+         * Gets the maximum size of the payload.
+         */
+        size_t capacity() const { return buf_ ? buf_.capacity() - HEADER_SIZE : 0; }
+        /**
+         * Sets the size of the payload.
+         * @param n The number of bytes. This is clamped to the capacity.
+         */
+        void resize(size_t n) { buf_.resize(n + HEADER_SIZE); }
+    };
+
+private:
+    /** The pool that supplies the buffers */
+    buffer_pool& pool_;
+    /** The placeholder node that keeps the queue from ever being empty */
+    node stub_;
+    /** The most recently pushed node, where producers add */
+    alignas(64) std::atomic<node*> tail_;
+    /** The number of bytes queued, but not yet sent */
+    std::atomic<size_t> size_{0};
+    /** The oldest node in the queue, owned by the consumer */
+    alignas(64) node* head_;
+    /** The first of the nodes taken from the queue, but not yet sent */
+    node* sendHead_{nullptr};
+    /** The last of the nodes taken from the queue, but not yet sent */
+    node* sendTail_{nullptr};
+
+    // Non-copyable
+    send_queue(const send_queue&) = delete;
+    send_queue& operator=(const send_queue&) = delete;
+
+    /** Checks that the pool's buffers can hold the queue nodes */
+    static result<> check_pool(const buffer_pool& pool) noexcept;
+    /** Creates a node in a buffer from the pool */
+    node* make_node(pooled_buffer&& buf, size_t len);
+    /** Frees a node, returning its buffer to the pool */
+    static void free_node(node* n) noexcept;
+    /** Pushes a pre-linked chain of nodes onto the queue */
+    bool push_chain(node* first, node* last, size_t nbytes);
+    /** Takes the oldest node from the queue, if one is available */
+    node* pop() noexcept;
+    /** Moves all the available nodes to the send list */
+    void collect() noexcept;
+
+public:
+    /**
+     * Creates a send queue.
+     * @param pool The pool that supplies the buffers for the messages.
+     * @throws std::system_error with `errc::invalid_argument` if the
+     *  	   pool's buffers can't hold the queue nodes.
+     */
+    explicit send_queue(buffer_pool& pool);
+    /**
+     * Creates a send queue.
+     * @param pool The pool that supplies the buffers for the messages.
+     * @param ec Gets `errc::invalid_argument` if the pool's buffers can't
+     *  		 hold the queue nodes, in which case the queue must not be
+     *  		 used. It's left untouched on success.
+     */
+    send_queue(buffer_pool& pool, error_code& ec) noexcept;
+    /**
+     * Destructor returns any unsent buffers to the pool.
+     * There must be no producers still pushing when the queue is
+     * destroyed.
+     */
+    ~send_queue();
+    /**
+     * Gets a buffer from the pool for a producer to fill.
+     * @return An empty message, with the capacity of a pool buffer less
+     *  	   the header.
+     */
+    message make_message() { return message{pool_.get()}; }
+    /**
+     * Pushes a message onto the queue.
+     * This can be called from any thread.
+     * @param msg The message. On return, it no longer has a buffer.
+     * @return @em true if the queue was empty, and the consumer might need
+     *  	   to be woken.
+     */
+    bool push(message&& msg);
+    /**
+     * Copies data into pooled buffers and pushes it onto the queue.
+     * This can be called from any thread.
+     * @param data The data to send.
+     * @param n The number of bytes.
+     * @return @em true if the queue was empty, and the consumer might need
+     *  	   to be woken.
+     */
+    bool push(const void* data, size_t n);
+    /**
+     * Copies a string into pooled buffers and pushes it onto the queue.
+     * This can be called from any thread.
+     * @param s The string to send.
+     * @return @em true if the queue was empty, and the consumer might need
+     *  	   to be woken.
+     */
+    bool push(const std::string& s) { return push(s.data(), s.size()); }
+    /**
+     * Sends as much of the queued data as possible.
+     * This must only be called from the thread that owns the connection.
+     * This also sends any data pushed while it runs. On a non-blocking
+     * socket, it sends until the socket would block, and leaves the rest
+     * queued. Producers don't signal while anything is queued, so the
+     * caller must flush again when the socket is writable.
+     * @param sock The socket to write.
+     * @return The number of bytes sent, or an error code on failure.
+     */
+    result<size_t> flush(stream_socket& sock);
+    /**
+     * Gets the number of bytes queued, but not yet sent.
+     * With producers running, this is only a snapshot.
+     */
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+    /**
+     * Determines if there is nothing waiting to be sent.
+     */
+    bool empty() const { return size() == 0; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_send_queue_h
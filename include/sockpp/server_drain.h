@@ -0,0 +1,219 @@
+/**
+ * @file server_drain.h
+ *
+ * Graceful shutdown of a server's listeners and connections.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_server_drain_h
+#define __sockpp_server_drain_h
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include "sockpp/acceptor.h"
+#include "sockpp/acceptor_group.h"
+#include "sockpp/reactor.h"
+#include "sockpp/stream_socket.h"
+
+#if !defined(_WIN32)
+    #include "sockpp/unix_stream_socket.h"
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Drains a reactor-based server for a graceful shutdown or restart.
+ *
+ * The server tells the drain about its listeners and connections as it
+ * runs, and whether each connection has a request in flight. To shut
+ * down, it calls @ref start() and then @ref run(), which:
+ *
+ * @li Stops accepting. The listeners are removed from the reactor and
+ *  	closed, unless they were first handed to a successor process with
+ *  	@ref hand_off().
+ * @li Half-closes each idle connection with `shutdown(SHUT_WR)`, so the
+ *  	client sees a clean end of stream and closes its side. A busy
+ *  	connection is half-closed as soon as it's marked idle.
+ * @li Runs the reactor, so the in-flight requests finish and the
+ *  	server's handlers read each connection to its end and close it.
+ * @li At the deadline, resets whatever connections are left.
+ *
+ * A connection that is closed while the peer still has unread data on
+ * it is reset, so the handlers should read until the end of stream
+ * before closing. Done that way, the only resets are for connections
+ * that outlast the deadline.
+ *
+ * The drain refers to the sockets, but doesn't own them. The server must
+ * call @ref remove_connection() before it closes a connection.
+ */
+class server_drain
+{
+public:
+    /** The clock for the deadline */
+    using clock = std::chrono::steady_clock;
+
+private:
+    /** The state of a connection */
+    struct conn_state
+    {
+        /** Whether a request is in flight */
+        bool busy{false};
+        /** Whether it's been half-closed */
+        bool halfClosed{false};
+    };
+
+    /** The reactor running the server */
+    reactor& rx_;
+    /** The listeners */
+    std::vector<acceptor*> listeners_;
+    /** The connections */
+    std::unordered_map<stream_socket*, conn_state> conns_;
+    /** Whether the drain has started */
+    bool draining_{false};
+    /** When to give up and reset the remaining connections */
+    clock::time_point deadline_{};
+
+    /** Half-closes a connection, if it hasn't been already */
+    void half_close(stream_socket* sock, conn_state& st);
+
+    // Non-copyable
+    server_drain(const server_drain&) = delete;
+    server_drain& operator=(const server_drain&) = delete;
+
+public:
+    /**
+     * Creates a drain for a server run by a reactor.
+     * @param rx The reactor running the server.
+     */
+    explicit server_drain(reactor& rx) : rx_{rx} {}
+    /**
+     * Adds a listener to stop when the drain starts.
+     * @param acc The listener.
+     */
+    void add_listener(acceptor& acc) { listeners_.push_back(&acc); }
+    /**
+     * Adds all the listeners in a group.
+     * @param grp The group of listeners.
+     */
+    template <typename ACCEPTOR>
+    void add_listeners(acceptor_group<ACCEPTOR>& grp) {
+        for (auto& acc : grp) add_listener(acc);
+    }
+    /**
+     * Adds a connection to the drain.
+     * If the drain has already started, an idle connection is half-closed
+     * right away.
+     * @param sock The connection.
+     * @param busy Whether a request is in flight on the connection.
+     */
+    void add_connection(stream_socket& sock, bool busy = false);
+    /**
+     * Removes a connection from the drain.
+     * This must be called before the connection is closed.
+     * @param sock The connection.
+     */
+    void remove_connection(stream_socket& sock) { conns_.erase(&sock); }
+    /**
+     * Marks whether a connection has a request in flight.
+     * Once the drain has started, a connection is half-closed when it's
+     * marked idle, so the server should only do that after the response
+     * has been completely written.
+     * @param sock The connection.
+     * @param busy Whether a request is in flight on the connection.
+     */
+    void set_busy(stream_socket& sock, bool busy);
+    /**
+     * Gets the number of connections still open.
+     * @return The number of connections still open.
+     */
+    size_t size() const { return conns_.size(); }
+    /**
+     * Determines if the drain has started.
+     * @return @em true if the drain has started.
+     */
+    bool draining() const { return draining_; }
+#if !defined(_WIN32)
+    /**
+     * Hands the listeners off to a successor process.
+     *
+     * Each listener is removed from the reactor and sent over the
+     * UNIX-domain socket, in the order they were added. The new process
+     * picks them up with `recv_socket()` and keeps accepting, so no
+     * connection attempt is refused during a restart. Each listener that
+     * is sent is closed here.
+     *
+     * @param successor A connection to the successor process.
+     * @return The error code on failure. Any listeners not yet sent are
+     *  	   left open, and are closed by @ref start().
+     */
+    result<> hand_off(unix_stream_socket& successor);
+#endif
+    /**
+     * Starts draining the server.
+     * This stops accepting and half-closes the idle connections.
+     * @param timeout The time allowed for the connections to close.
+     */
+    void start(milliseconds timeout);
+    /**
+     * Runs the reactor until all the connections are closed, or the
+     * deadline passes, and then resets any connections that are left.
+     * This starts the drain with no time allowed, if it wasn't started.
+     * @return The number of connections that were reset, or the error
+     *  	   code if the reactor failed.
+     */
+    result<size_t> run();
+    /**
+     * Resets all the remaining connections, right away.
+     * Each is removed from the reactor, then closed with a reset.
+     * @return The number of connections that were reset.
+     */
+    size_t abort_all();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_server_drain_h
@@ -0,0 +1,305 @@
+/**
+ * @file shared_socket.h
+ *
+ * Separate, shared read and write halves of a stream socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_shared_socket_h
+#define __sockpp_shared_socket_h
+
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+template <typename STREAM_SOCK>
+class read_half;
+
+template <typename STREAM_SOCK>
+class write_half;
+
+/**
+ * A reference-counted handle to a stream socket that is shared between
+ * its read and write halves.
+ *
+ * This is the common base of @ref read_half and @ref write_half, which
+ * are created together by @ref split(). Each half refers to the same
+ * socket object, so a connection can be read by one thread and written by
+ * another without duplicating its handle with @ref socket::clone(). The
+ * socket is closed once, when the last half referring to it is destroyed.
+ *
+ * One thread may use the read half while another uses the write half.
+ * Each half, itself, should only be used by one thread at a time.
+ *
+ * @tparam STREAM_SOCK The type of the shared stream socket.
+ */
+template <typename STREAM_SOCK = stream_socket>
+class shared_socket
+{
+public:
+    /** The type of the shared socket */
+    using socket_type = STREAM_SOCK;
+
+protected:
+    /** The shared socket */
+    std::shared_ptr<socket_type> sock_;
+
+    template <typename S>
+    friend result<S> reunite(read_half<S>& rd, write_half<S>& wr);
+
+public:
+    /**
+     * Creates a handle that doesn't refer to a socket.
+     */
+    shared_socket() = default;
+    /**
+     * Creates a handle to a shared socket.
+     * @param sock The shared socket.
+     */
+    explicit shared_socket(std::shared_ptr<socket_type> sock) : sock_{std::move(sock)} {}
+    /**
+     * Determines if the handle refers to an open socket.
+     */
+    bool is_open() const { return sock_ && sock_->is_open(); }
+    /**
+     * Determines if the handle refers to an open socket.
+     */
+    explicit operator bool() const { return is_open(); }
+    /**
+     * Gets the OS handle of the shared socket.
+     * @return The OS handle, or INVALID_SOCKET if there isn't a socket.
+     */
+    socket_t handle() const { return sock_ ? sock_->handle() : INVALID_SOCKET; }
+    /**
+     * Gets the number of halves that refer to the socket.
+     */
+    long use_count() const { return sock_.use_count(); }
+    /**
+     * Determines if this and another handle refer to the same socket.
+     * @param other Another handle.
+     * @return @em true if both refer to the same socket.
+     */
+    bool same_socket(const shared_socket& other) const {
+        return sock_ && sock_ == other.sock_;
+    }
+    /**
+     * Gets the local address of the socket.
+     */
+    auto address() const { return sock_->address(); }
+    /**
+     * Gets the address of the remote peer.
+     */
+    auto peer_address() const { return sock_->peer_address(); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The read half of a shared stream socket.
+ * @tparam STREAM_SOCK The type of the shared stream socket.
+ * @sa split()
+ */
+template <typename STREAM_SOCK = stream_socket>
+class read_half : public shared_socket<STREAM_SOCK>
+{
+    using base = shared_socket<STREAM_SOCK>;
+    using base::sock_;
+
+public:
+    using base::base;
+
+    /**
+     * Reads from the socket.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to try to read.
+     * @return The number of bytes read on success, or an error code on
+     *  	   failure. Zero indicates the peer closed its side.
+     */
+    result<size_t> read(void* buf, size_t n) { return sock_->read(buf, n); }
+    /**
+     * Reads from the socket into a buffer taken from a pool.
+     * @param pool The pool from which to take the buffer.
+     * @return The buffer with the data, or an error code on failure.
+     */
+    result<pooled_buffer> read(buffer_pool& pool) { return sock_->read(pool); }
+    /**
+     * Best effort attempt to read the requested number of bytes.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @return The number of bytes read, or an error code on failure.
+     */
+    result<size_t> read_n(void* buf, size_t n) { return sock_->read_n(buf, n); }
+    /**
+     * Scatter read from the socket into the I/O vectors.
+     * @param ranges The buffers to fill.
+     * @param n The number of buffers.
+     * @return The number of bytes read, or an error code on failure.
+     */
+    result<size_t> read(const iovec* ranges, size_t n) { return sock_->read(ranges, n); }
+    /**
+     * Sets a timeout for read operations.
+     * @param to The timeout. Zero means wait forever.
+     * @return The error code on failure.
+     */
+    template <class Rep, class Period>
+    result<> read_timeout(const duration<Rep, Period>& to) {
+        return sock_->read_timeout(to);
+    }
+    /**
+     * Shuts down the read side of the connection.
+     * @return The error code on failure.
+     */
+    result<> shutdown() { return sock_->shutdown(SHUT_RD); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The write half of a shared stream socket.
+ * @tparam STREAM_SOCK The type of the shared stream socket.
+ * @sa split()
+ */
+template <typename STREAM_SOCK = stream_socket>
+class write_half : public shared_socket<STREAM_SOCK>
+{
+    using base = shared_socket<STREAM_SOCK>;
+    using base::sock_;
+
+public:
+    using base::base;
+
+    /**
+     * Writes to the socket.
+     * @param buf The data to write.
+     * @param n The number of bytes to try to write.
+     * @return The number of bytes written, or an error code on failure.
+     */
+    result<size_t> write(const void* buf, size_t n) { return sock_->write(buf, n); }
+    /**
+     * Best effort attempt to write the whole buffer.
+     * @param buf The data to write.
+     * @param n The number of bytes to write.
+     * @return The number of bytes written, or an error code on failure.
+     */
+    result<size_t> write_n(const void* buf, size_t n) { return sock_->write_n(buf, n); }
+    /**
+     * Best effort attempt to write a whole string.
+     * @param s The string to write.
+     * @return The number of bytes written, or an error code on failure.
+     */
+    result<size_t> write(const std::string& s) { return sock_->write(s); }
+    /**
+     * Gather write to the socket from the I/O vectors.
+     * @param ranges The buffers to send.
+     * @param n The number of buffers.
+     * @return The number of bytes written, or an error code on failure.
+     */
+    result<size_t> write(const iovec* ranges, size_t n) { return sock_->write(ranges, n); }
+    /**
+     * Sets a timeout for write operations.
+     * @param to The timeout. Zero means wait forever.
+     * @return The error code on failure.
+     */
+    template <class Rep, class Period>
+    result<> write_timeout(const duration<Rep, Period>& to) {
+        return sock_->write_timeout(to);
+    }
+    /**
+     * Shuts down the write side of the connection.
+     * The peer sees the end of the stream once it has read everything
+     * sent before this.
+     * @return The error code on failure.
+     */
+    result<> shutdown() { return sock_->shutdown(SHUT_WR); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Splits a stream socket into separate read and write halves.
+ *
+ * The socket is moved into shared storage, and both halves refer to it.
+ * It is closed when both halves have been destroyed.
+ *
+ * @param sock The socket to split.
+ * @return The read and write halves of the socket.
+ */
+template <typename STREAM_SOCK>
+std::tuple<read_half<STREAM_SOCK>, write_half<STREAM_SOCK>> split(STREAM_SOCK&& sock) {
+    auto p = std::make_shared<STREAM_SOCK>(std::move(sock));
+    return std::make_tuple(read_half<STREAM_SOCK>{p}, write_half<STREAM_SOCK>{p});
+}
+
+/**
+ * Puts the two halves of a split socket back together.
+ *
+ * On success, both halves are left empty, and the socket is returned.
+ *
+ * @param rd The read half.
+ * @param wr The write half.
+ * @return The socket, or `errc::invalid_argument` if the halves don't
+ *  	   come from the same socket, or other copies of them still exist.
+ */
+template <typename STREAM_SOCK>
+result<STREAM_SOCK> reunite(read_half<STREAM_SOCK>& rd, write_half<STREAM_SOCK>& wr) {
+    if (!rd.same_socket(wr) || rd.use_count() != 2)
+        return errc::invalid_argument;
+
+    auto& rp = static_cast<shared_socket<STREAM_SOCK>&>(rd).sock_;
+    auto& wp = static_cast<shared_socket<STREAM_SOCK>&>(wr).sock_;
+
+    STREAM_SOCK sock{std::move(*rp)};
+    rp.reset();
+    wp.reset();
+    return sock;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_shared_socket_h
@@ -0,0 +1,255 @@
+/**
+ * @file shm_channel.h
+ *
+ * A shared-memory byte channel between processes on the same host.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_shm_channel_h
+#define __sockpp_shm_channel_h
+
+#include <atomic>
+
+#include "sockpp/unix_stream_socket.h"
+
+namespace sockpp {
+
+namespace detail {
+struct shm_ring;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A bidirectional byte channel between two processes on the same host,
+ * through shared memory.
+ *
+ * A Unix-domain stream socket is used only to set up the channel. One
+ * side calls @ref create(), which makes a shared memory region and a pair
+ * of event descriptors and passes them to the peer over the socket. The
+ * other side calls @ref attach() to receive them. From then on, data
+ * moves through a single-producer, single-consumer ring buffer in each
+ * direction, with no system calls or kernel copies while the peer keeps
+ * up. A side only blocks in the kernel when its ring is empty (for a
+ * read) or full (for a write), after spinning for a short time.
+ *
+ * The channel has the same read/write interface as a stream socket, and
+ * the same semantics: it is a byte stream without message boundaries. A
+ * read returns zero once the peer has closed the channel and all of its
+ * data has been consumed. The socket is kept open for the life of the
+ * channel so that the death of the peer process is detected as well.
+ *
+ * Each side of the channel can be used by one reader thread and one
+ * writer thread at a time. This is only available on Linux.
+ */
+class shm_channel
+{
+    /** The socket used to set up the channel, and to watch the peer */
+    unix_stream_socket sock_;
+    /** The shared memory mapping */
+    void* map_{nullptr};
+    /** The size of the mapping, in bytes */
+    size_t mapSize_{0};
+    /** The capacity of each ring, in bytes */
+    size_t cap_{0};
+    /** Which side of the channel this is: 0 for the creator, 1 if attached */
+    int side_{0};
+    /**
+     * The event descriptors used as doorbells. The first pair wakes our
+     * reader and writer, and the second pair wakes those of the peer.
+     */
+    int doorbell_[4]{-1, -1, -1, -1};
+    /** The number of times to poll the ring before blocking */
+    unsigned spin_{DFLT_SPIN_COUNT};
+    /** Whether the peer is known to be gone */
+    std::atomic<bool> peerGone_{false};
+
+    // Non-copyable
+    shm_channel(const shm_channel&) = delete;
+    shm_channel& operator=(const shm_channel&) = delete;
+
+    /** Maps the channel from the shared memory descriptor */
+    result<> map(int memFd, size_t cap, int side);
+    /** Gets the control block for the ring that we write */
+    detail::shm_ring& tx() const;
+    /** Gets the control block for the ring that we read */
+    detail::shm_ring& rx() const;
+    /** Gets the data area of a ring for a side */
+    char* data(int side) const;
+    /** Marks a peer that corrupted the shared ring indexes as gone */
+    error_code bad_peer();
+    /** Determines if the peer has closed the channel */
+    bool peer_closed() const;
+    /** Rings one of the doorbells */
+    void signal(int i) const;
+    /** Blocks until one of our doorbells rings or the peer goes away */
+    result<> wait(int i);
+
+public:
+    /** The default capacity of each ring, in bytes */
+    static constexpr size_t DFLT_CAPACITY = 1024 * 1024;
+    /** The default number of times to poll the ring before blocking */
+    static constexpr unsigned DFLT_SPIN_COUNT = 2000;
+
+    /**
+     * Creates a closed channel.
+     */
+    shm_channel() noexcept {}
+    /**
+     * Move constructor.
+     * @param other The channel to move into this one.
+     */
+    shm_channel(shm_channel&& other) noexcept;
+    /**
+     * Destructor closes the channel.
+     */
+    ~shm_channel();
+    /**
+     * Move assignment.
+     * @param rhs The other channel to move into this one.
+     * @return A reference to this object.
+     */
+    shm_channel& operator=(shm_channel&& rhs) noexcept;
+    /**
+     * Creates a new channel and offers it to the peer over a connected
+     * socket.
+     * The peer should call @ref attach() with the other end of the
+     * socket. Data can be written as soon as this returns, even before
+     * the peer has attached.
+     * @param sock A connected Unix-domain stream socket. The channel
+     *  		   takes ownership of it.
+     * @param capacity The capacity of the ring in each direction. This is
+     *  			   rounded up to a power of two.
+     * @return The channel on success, or the error code on failure.
+     */
+    static result<shm_channel> create(
+        unix_stream_socket&& sock, size_t capacity = DFLT_CAPACITY
+    );
+    /**
+     * Attaches to a channel that the peer is offering over a connected
+     * socket.
+     * @param sock A connected Unix-domain stream socket. The channel
+     *  		   takes ownership of it.
+     * @return The channel on success, or the error code on failure. This
+     *  	   fails with `errc::bad_message` if the peer didn't send a
+     *  	   valid channel, including memory that isn't sealed against
+     *  	   shrinking.
+     */
+    static result<shm_channel> attach(unix_stream_socket&& sock);
+    /**
+     * Determines if the channel is open.
+     * @return @em true if the channel is open.
+     */
+    bool is_open() const { return map_ != nullptr; }
+    /**
+     * Determines if the channel is open.
+     * @return @em true if the channel is open.
+     */
+    explicit operator bool() const { return is_open(); }
+    /**
+     * Gets the capacity of the ring in each direction.
+     * @return The capacity of each ring, in bytes.
+     */
+    size_t capacity() const { return cap_; }
+    /**
+     * Sets the number of times to poll the ring for data or space before
+     * blocking.
+     * Spinning keeps the latency low when the peer is busy on another
+     * core, at the cost of some CPU time. Zero blocks right away.
+     * @param n The spin count.
+     */
+    void spin_count(unsigned n) { spin_ = n; }
+    /**
+     * Reads from the channel.
+     * This blocks until there is at least one byte to read.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to try to read.
+     * @return The number of bytes read, zero if the peer closed the
+     *  	   channel, or the error code on failure. This fails with
+     *  	   `errc::bad_message` if the peer corrupted the ring, and the
+     *  	   peer is then treated as gone.
+     */
+    result<size_t> read(void* buf, size_t n);
+    /**
+     * Best effort attempt to read the specified number of bytes.
+     * This will make repeated read attempts until all the bytes are read
+     * in or the peer closes the channel.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to try to read.
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> read_n(void* buf, size_t n);
+    /**
+     * Writes to the channel.
+     * This blocks until there is room in the ring for at least one byte.
+     * @param buf The buffer to write.
+     * @param n The number of bytes in the buffer.
+     * @return The number of bytes written, or the error code on failure.
+     *  	   This fails with `errc::broken_pipe` if the peer has closed
+     *  	   the channel, or with `errc::bad_message` if the peer
+     *  	   corrupted the ring.
+     */
+    result<size_t> write(const void* buf, size_t n);
+    /**
+     * Best effort attempt to write the whole buffer to the channel.
+     * @param buf The buffer to write.
+     * @param n The number of bytes in the buffer.
+     * @return The number of bytes written, or the error code on failure.
+     */
+    result<size_t> write_n(const void* buf, size_t n);
+    /**
+     * Best effort attempt to write a string to the channel.
+     * @param s The string to write.
+     * @return The number of bytes written, or the error code on failure.
+     */
+    result<size_t> write(const string& s) { return write_n(s.data(), s.size()); }
+    /**
+     * Closes the channel.
+     * The peer can still read any data that was already written.
+     */
+    void close();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_shm_channel_h
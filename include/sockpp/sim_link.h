@@ -0,0 +1,370 @@
+/**
+ * @file sim_link.h
+ *
+ * An in-process simulated network link for deterministic tests.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_sim_link_h
+#define __sockpp_sim_link_h
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include "sockpp/datagram_socket.h"
+#include "sockpp/stream_socket.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An in-process network link with simulated latency, bandwidth, loss, and
+ * reordering, for deterministic tests and benchmarks of protocol code.
+ *
+ * The application gets an ordinary pair of connected sockets, so the code
+ * under test uses the same read/write or send/recv calls, and can be
+ * registered with a @ref reactor or @ref io_context, as with a real
+ * connection. Behind each of them, the link holds the other end of a
+ * local socket pair, and moves the data between them itself.
+ *
+ * The link runs on a virtual clock that only moves when it's told to, by
+ * @ref advance() or @ref run_until(). Everything that was written by then
+ * enters the link at the current virtual time, and is delivered to the
+ * other side at the time computed from the link's parameters. Loss and
+ * reordering come from a seeded generator, so a test gets exactly the same
+ * timing and the same losses on every run, however loaded the machine is.
+ *
+ * A stream link is reliable and in order, like TCP. Its data is carried
+ * in segments of up to @ref params::mtu bytes, and a "lost" segment is
+ * delivered late, after @ref params::retransmit, holding up everything
+ * behind it. A datagram link really loses and reorders the datagrams. In
+ * either case, the link holds up to @ref params::queueLimit bytes in
+ * flight in each direction. Beyond that, a stream link stops reading, so
+ * that the sender sees backpressure, and a datagram link drops the
+ * datagrams, like a router with a full queue.
+ *
+ * The link's own reads and writes aren't counted in the @ref socket_stats.
+ * Like the reactor, it isn't thread safe. The application must not block
+ * on one of the sockets while waiting for the link, since the link only
+ * moves data when it's run from the same thread.
+ */
+class sim_link
+{
+public:
+    /** The parameters of the link. They apply to each direction. */
+    struct params
+    {
+        /** The one-way delay of the link */
+        nanoseconds latency{0};
+        /** The bandwidth, in bytes per second, or zero for unlimited */
+        uint64_t bandwidth{0};
+        /** The probability that a segment or datagram is lost, 0-1 */
+        double loss{0.0};
+        /** The probability that a datagram is held back, 0-1 */
+        double reorder{0.0};
+        /** The time that a reordered datagram is held back */
+        nanoseconds reorderDelay{milliseconds{1}};
+        /** The extra delay for a lost stream segment */
+        nanoseconds retransmit{milliseconds{200}};
+        /** The largest stream segment */
+        size_t mtu{1500};
+        /** The most bytes that can be in flight in each direction */
+        size_t queueLimit{1024 * 1024};
+        /** The seed for the loss and reordering generator */
+        uint64_t seed{1};
+    };
+
+    /** The counters for one direction of the link */
+    struct counters
+    {
+        /** The number of segments or datagrams delivered */
+        uint64_t packets{0};
+        /** The number of bytes delivered */
+        uint64_t bytes{0};
+        /** The number of datagrams lost or dropped */
+        uint64_t dropped{0};
+        /** The number of stream segments delivered late, as if lost */
+        uint64_t retransmits{0};
+        /** The number of datagrams that were held back */
+        uint64_t reordered{0};
+    };
+
+private:
+    /** A segment or datagram in flight */
+    struct packet
+    {
+        /** The payload */
+        std::string data;
+        /** Whether this marks the end of the stream */
+        bool eof{false};
+    };
+
+    /** The state of one direction of the link */
+    struct direction
+    {
+        /** The socket that the link reads */
+        socket* src;
+        /** The socket that the link writes */
+        socket* dst;
+        /** The packets in flight, in order of delivery time */
+        std::map<std::tuple<nanoseconds, uint64_t>, packet> q;
+        /** The number of bytes in flight */
+        size_t queued{0};
+        /** The offset of the next byte to write of the first packet */
+        size_t off{0};
+        /** The time that the link will be done sending the last packet */
+        nanoseconds busyUntil{0};
+        /** The delivery time of the last packet in the stream */
+        nanoseconds lastDue{0};
+        /** Whether the source reached the end of its stream */
+        bool eof{false};
+        /** Whether the destination can't take any more for now */
+        bool blocked{false};
+        /** Whether the destination went away */
+        bool closed{false};
+        /** The counters */
+        counters cnt;
+
+        direction(socket& s, socket& d) : src{&s}, dst{&d} {}
+    };
+
+    /** The parameters */
+    params params_;
+    /** The socket type, SOCK_STREAM or SOCK_DGRAM */
+    int type_;
+    /** The current virtual time */
+    nanoseconds now_{0};
+    /** The state of the generator */
+    uint64_t rng_;
+    /** The number of packets that entered the link, to order ties */
+    uint64_t seq_{0};
+    /** The link's end of the pair with the first socket */
+    socket ia_;
+    /** The link's end of the pair with the second socket */
+    socket ib_;
+    /** Data from the first socket to the second */
+    direction ab_;
+    /** Data from the second socket to the first */
+    direction ba_;
+
+    /** Gets a random number in the range [0, 1) */
+    double random() noexcept;
+    /** Reads what's waiting in the source of a direction */
+    void ingest(direction& d);
+    /** Adds a packet to a direction */
+    void enqueue(direction& d, std::string&& data, bool eof);
+    /** Writes the packets that are due to the destination */
+    void deliver(direction& d);
+    /** Runs the link until nothing more is due by time @a t */
+    void step(nanoseconds t);
+
+    // Non-copyable
+    sim_link(const sim_link&) = delete;
+    sim_link& operator=(const sim_link&) = delete;
+
+protected:
+    /**
+     * Creates a link that isn't open yet.
+     * @param p The parameters of the link.
+     * @param type The socket type, SOCK_STREAM or SOCK_DGRAM.
+     */
+    sim_link(const params& p, int type);
+    /**
+     * Creates the socket pairs for the link.
+     * @return The sockets for the application, on success.
+     */
+    result<std::tuple<socket, socket>> open();
+
+public:
+    /**
+     * Gets the parameters of the link.
+     * @return The parameters of the link.
+     */
+    const params& get_params() const noexcept { return params_; }
+    /**
+     * Gets the current virtual time.
+     * This starts at zero when the link is created.
+     * @return The current virtual time.
+     */
+    nanoseconds now() const noexcept { return now_; }
+    /**
+     * Runs the link forward by the specified amount of time.
+     * @param dt The amount of virtual time to run.
+     */
+    void advance(nanoseconds dt) { run_until(now_ + dt); }
+    /**
+     * Runs the link forward to the specified time, delivering everything
+     * that's due by then.
+     * @param t The virtual time to run to. If this is earlier than the
+     *  		current time, the link just delivers what is due now.
+     */
+    void run_until(nanoseconds t);
+    /**
+     * Runs the link until everything in flight is delivered, or can't be
+     * delivered because the receiver isn't reading.
+     * @return The virtual time when the link stopped.
+     */
+    nanoseconds run();
+    /**
+     * Gets the time of the next delivery.
+     * This only knows about data that has already entered the link.
+     * @return The virtual time of the next delivery, or nothing if the
+     *  	   link is idle.
+     */
+    std::optional<nanoseconds> next_event() const noexcept;
+    /**
+     * Determines if there's nothing in flight in either direction.
+     * @return @em true if the link is idle.
+     */
+    bool idle() const noexcept { return ab_.q.empty() && ba_.q.empty(); }
+    /**
+     * Gets the counters for the data from the first socket to the second.
+     * @return The counters for the first direction.
+     */
+    const counters& a_to_b() const noexcept { return ab_.cnt; }
+    /**
+     * Gets the counters for the data from the second socket to the first.
+     * @return The counters for the second direction.
+     */
+    const counters& b_to_a() const noexcept { return ba_.cnt; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A simulated stream connection, which behaves like TCP.
+ *
+ *     sockpp::sim_link::params p;
+ *     p.latency = 10ms;
+ *     p.bandwidth = 1'000'000;
+ *
+ *     sockpp::sim_stream_link link{p};
+ *     link.first().write(std::string{"Hello"});
+ *     link.advance(10ms);
+ */
+class sim_stream_link : public sim_link
+{
+    /** The first socket for the application */
+    stream_socket a_;
+    /** The second socket for the application */
+    stream_socket b_;
+
+    /** Takes the application's sockets after opening the link */
+    result<> init();
+
+public:
+    /**
+     * Creates a stream link.
+     * @param p The parameters of the link.
+     * @throws std::system_error if the sockets can't be created.
+     */
+    explicit sim_stream_link(const params& p = params{});
+    /**
+     * Creates a stream link.
+     * @param p The parameters of the link.
+     * @param ec Gets the error code on failure. It's left untouched on
+     *  		 success.
+     */
+    sim_stream_link(const params& p, error_code& ec) noexcept;
+    /**
+     * Gets the socket at the first end of the link.
+     * @return The socket at the first end of the link.
+     */
+    stream_socket& first() noexcept { return a_; }
+    /**
+     * Gets the socket at the second end of the link.
+     * @return The socket at the second end of the link.
+     */
+    stream_socket& second() noexcept { return b_; }
+};
+
+/**
+ * A simulated datagram link, which behaves like UDP.
+ *
+ * The sockets are connected to each other, so they're used with send()
+ * and recv(). Each datagram is delivered whole, or not at all.
+ */
+class sim_dgram_link : public sim_link
+{
+    /** The first socket for the application */
+    datagram_socket a_;
+    /** The second socket for the application */
+    datagram_socket b_;
+
+    /** Takes the application's sockets after opening the link */
+    result<> init();
+
+public:
+    /**
+     * Creates a datagram link.
+     * @param p The parameters of the link.
+     * @throws std::system_error if the sockets can't be created.
+     */
+    explicit sim_dgram_link(const params& p = params{});
+    /**
+     * Creates a datagram link.
+     * @param p The parameters of the link.
+     * @param ec Gets the error code on failure. It's left untouched on
+     *  		 success.
+     */
+    sim_dgram_link(const params& p, error_code& ec) noexcept;
+    /**
+     * Gets the socket at the first end of the link.
+     * @return The socket at the first end of the link.
+     */
+    datagram_socket& first() noexcept { return a_; }
+    /**
+     * Gets the socket at the second end of the link.
+     * @return The socket at the second end of the link.
+     */
+    datagram_socket& second() noexcept { return b_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_sim_link_h
@@ -48,6 +48,7 @@
 #define __sockpp_sock_address_h
 
 #include <cstring>
+#include <functional>
 #include <stdexcept>
 
 #include "sockpp/error.h"
@@ -239,7 +240,77 @@ inline bool operator!=(const sock_address& lhs, const sock_address& rhs) {
     return !operator==(lhs, rhs);
 }
 
+/**
+ * Orders two socket addresses.
+ * This is a cheap, arbitrary ordering, suitable for sorted containers: by
+ * size, then by the raw bytes of the address. It is consistent with
+ * equality, but is not necessarily the natural order for any family.
+ * @param lhs A socket address
+ * @param rhs A socket address
+ * @return @em true if `lhs` orders before `rhs`.
+ */
+inline bool operator<(const sock_address& lhs, const sock_address& rhs) {
+    if (lhs.size() != rhs.size())
+        return lhs.size() < rhs.size();
+    return std::memcmp(lhs.sockaddr_ptr(), rhs.sockaddr_ptr(), lhs.size()) < 0;
+}
+
+// --------------------------------------------------------------------------
+
+/**
+ * Mixes the bits of a 64-bit value for use as a hash.
+ * This is the finalizer from SplitMix64, which spreads every input bit
+ * across the whole output, as an open-addressing hash table needs.
+ * @param x The value to mix.
+ * @return The mixed value.
+ */
+constexpr uint64_t hash_mix(uint64_t x) noexcept {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * Computes a hash value for a block of memory.
+ * @param p Pointer to the memory.
+ * @param n The number of bytes.
+ * @return A hash of the bytes.
+ */
+inline uint64_t hash_bytes(const void* p, size_t n) noexcept {
+    auto b = static_cast<const uint8_t*>(p);
+    uint64_t h = n;
+
+    for (; n >= 8; b += 8, n -= 8) {
+        uint64_t v;
+        std::memcpy(&v, b, 8);
+        h = hash_mix(h ^ v);
+    }
+
+    uint64_t v = 0;
+    std::memcpy(&v, b, n);
+    return hash_mix(h ^ v);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
 
+namespace std {
+
+/**
+ * Hash function for a generic socket address.
+ * This hashes the raw bytes of the address, consistent with equality.
+ */
+template <>
+struct hash<sockpp::sock_address_any>
+{
+    size_t operator()(const sockpp::sock_address_any& addr) const noexcept {
+        return size_t(sockpp::hash_bytes(addr.sockaddr_ptr(), addr.size()));
+    }
+};
+
+}  // namespace std
+
 #endif  // __sockpp_sock_address_h
@@ -51,6 +51,8 @@
 #include <string>
 #include <tuple>
 
+#include "sockpp/cmsg.h"
+#include "sockpp/inet_any_address.h"
 #include "sockpp/result.h"
 #include "sockpp/sock_address.h"
 #include "sockpp/types.h"
@@ -114,8 +116,7 @@ inline std::chrono::system_clock::time_point to_timepoint(const timeval& tv) {
  * classes in the library are used.
  *
  * This is only required on some platforms, particularly Windows, but is
- * harmless on other platforms. On some, such as POSIX, the initializer sets
- * optional parameters for the library, and the destructor does nothing.
+ * harmless on other platforms. On POSIX systems, it does nothing.
  */
 class socket_initializer
 {
@@ -154,8 +155,11 @@ public:
  *
  * This is primarily required for Win32, to startup the WinSock DLL.
  *
- * On Unix-style platforms it disables SIGPIPE signals. Errors are handled
- * by functon return values and exceptions.
+ * On Unix-style platforms it does nothing. The process's handling of
+ * SIGPIPE is left alone. Instead, the library's own writes don't raise the
+ * signal: they pass MSG_NOSIGNAL, or on systems that don't have it, like
+ * macOS, the sockets are created with SO_NOSIGPIPE. A write to a broken
+ * connection just fails with @em errc::broken_pipe.
  */
 void initialize();
 
@@ -171,6 +175,11 @@ void initialize();
  * handle and will close it when the object is destroyed.
  *
  * Objects of this class are not copyable, but they are moveable.
+ *
+ * The socket classes are polymorphic, so each object carries a vtable
+ * pointer along with its handle. Where that overhead matters, such as for
+ * very large numbers of connections, see @ref socket_view and @ref
+ * unique_socket, which are the size of the handle alone.
  */
 class socket
 {
@@ -234,6 +243,12 @@ protected:
 public:
     /** A pair of base sockets */
     using socket_pair = std::tuple<socket, socket>;
+
+    /** Flag to create or accept a socket in non-blocking mode */
+    static constexpr int NON_BLOCKING = 0x01;
+    /** Flag to create or accept a socket with close-on-exec set */
+    static constexpr int CLOSE_ON_EXEC = 0x02;
+
     /**
      * Creates an unconnected (invalid) socket
      */
@@ -265,13 +280,18 @@ public:
      * @param type The communication semantics for the sockets (SOCK_STREAM,
      *  		   SOCK_DGRAM, etc).
      * @param protocol The particular protocol to be used with the sockets
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     *  			Where the system supports it, these are applied
+     *  			atomically when the socket is created, with
+     *  			`SOCK_NONBLOCK` and `SOCK_CLOEXEC`.
      *
      * @return An OS socket handle with the requested communications
      *  	   characteristics, or error code on failure.
      */
-    static result<socket_t> create_handle(int domain, int type, int protocol = 0) noexcept {
-        return check_socket(socket_t(::socket(domain, type, protocol)));
-    }
+    static result<socket_t> create_handle(
+        int domain, int type, int protocol = 0, int flags = 0
+    ) noexcept;
     /**
      * Creates a socket with the specified communications characterics.
      * Not that this is not normally how a socket is creates in the sockpp
@@ -286,10 +306,14 @@ public:
      * @param type The communication semantics for the sockets (SOCK_STREAM,
      *  		   SOCK_DGRAM, etc).
      * @param protocol The particular protocol to be used with the sockets
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      *
      * @return A socket with the requested communications characteristics.
      */
-    static result<socket> create(int domain, int type, int protocol = 0) noexcept;
+    static result<socket> create(
+        int domain, int type, int protocol = 0, int flags = 0
+    ) noexcept;
     /**
      * Determines if the socket is open (valid).
      * @return @em true if the socket is open, @em false otherwise.
@@ -396,6 +420,24 @@ public:
      * @return The address of the remote peer, if this socket is connected.
      */
     sock_address_any peer_address() const;
+    /**
+     * Gets the local address to which the socket is bound, placing it
+     * directly into a compact IP address.
+     * @param addr Gets the local address.
+     * @return The error code on failure. If the socket is not bound to an
+     *  	   IPv4 or IPv6 address, this is
+     *  	   `errc::address_family_not_supported`.
+     */
+    result<> address(inet_any_address& addr) const noexcept;
+    /**
+     * Gets the address of the remote peer, placing it directly into a
+     * compact IP address.
+     * @param addr Gets the address of the remote peer.
+     * @return The error code on failure. If the peer does not have an
+     *  	   IPv4 or IPv6 address, this is
+     *  	   `errc::address_family_not_supported`.
+     */
+    result<> peer_address(inet_any_address& addr) const noexcept;
     /**
      * Gets the value of a socket option.
      *
@@ -507,17 +549,23 @@ public:
      * When in non-blocking mode, a call that is not immediately ready to
      * complete (read, write, accept, etc) will return immediately with the
      * error EWOULDBLOCK.
+     *
+     * The mode belongs to the open file description, so it's shared with
+     * any duplicates of the handle, like those from @ref clone(). The
+     * change is always made with a single system call.
+     *
      * @param on Whether to turn non-blocking mode on or off.
      * @return @em true on success, @em false on failure.
      */
     virtual result<> set_non_blocking(bool on = true);
 
-#if !defined(_WIN32)
     /**
-     * Determines if the socket is non-blocking
+     * Determines if the socket is non-blocking.
+     * This asks the OS each time, so it sees a change made through a
+     * duplicate of the handle or a @ref socket_view. It's always @em false
+     * on Windows, which can't query the mode.
      */
     virtual bool is_non_blocking() const;
-#endif
     /**
      * Gets the value of the `SO_REUSEADDR` option on the socket.
      * @return The value of the `SO_REUSEADDR` option on the socket on
@@ -550,6 +598,24 @@ public:
      */
     result<> reuse_port(bool on) noexcept { return set_option(SOL_SOCKET, SO_REUSEPORT, on); }
 #endif
+    /**
+     * Sets the `SO_LINGER` option on the socket.
+     *
+     * With linger on, close() blocks until the unsent data is delivered,
+     * or the timeout expires. With a zero timeout, close() discards any
+     * unsent data and resets the connection.
+     * @param on Whether to linger on close.
+     * @param timeout The most time to linger.
+     * @return An error code on failure.
+     */
+    result<> linger(bool on, seconds timeout = seconds{0}) noexcept;
+    /**
+     * Closes the socket abruptly, resetting the connection.
+     * This discards any unsent data and sends a RST to the peer instead of
+     * the normal FIN, so the socket doesn't linger in TIME_WAIT.
+     * @return An error code on failure.
+     */
+    result<> abort();
     /**
      * Gets the value of the `SO_RCVBUF` option on the socket.
      * This is the size of the OS receive buffer for the socket.
@@ -584,6 +650,152 @@ public:
     result<> send_buffer_size(unsigned int sz) noexcept {
         return set_option<unsigned int>(SOL_SOCKET, SO_SNDBUF, sz);
     }
+    /**
+     * Gets the value of the `SO_RCVLOWAT` option on the socket.
+     * This is the minimum amount of received data that makes the socket
+     * readable.
+     * @return The receive low-water mark, in bytes.
+     */
+    result<int> recv_lowat() const noexcept { return get_option<int>(SOL_SOCKET, SO_RCVLOWAT); }
+    /**
+     * Sets the value of the `SO_RCVLOWAT` option on the socket.
+     *
+     * A poller won't report the socket as readable, and a blocking read
+     * won't return, until at least this much data has been received, or
+     * the connection is closed. A read still returns no more than the
+     * buffer holds. Linux caps the value at half the maximum receive
+     * buffer size, so the socket can't wait forever.
+     *
+     * @param n The receive low-water mark, in bytes. The default is 1.
+     * @return The error code on failure.
+     */
+    result<> recv_lowat(int n) noexcept { return set_option<int>(SOL_SOCKET, SO_RCVLOWAT, n); }
+#if defined(__linux__)
+    /**
+     * Gets the value of the `SO_ZEROCOPY` option on the socket.
+     * @return Whether zero-copy sends are allowed on the socket.
+     */
+    result<bool> zerocopy() const noexcept { return get_option<bool>(SOL_SOCKET, SO_ZEROCOPY); }
+    /**
+     * Sets the value of the `SO_ZEROCOPY` option on the socket.
+     *
+     * This allows the application to send with the `MSG_ZEROCOPY` flag,
+     * in which case the kernel transmits directly from the user's buffer
+     * rather than copying it. The buffer must then be left untouched until
+     * the kernel reports that it's done with it. See
+     * @ref zerocopy_completions(). Datagram sockets can use the flag with
+     * send() and send_to(); stream sockets have
+     * stream_socket::write_zerocopy().
+     *
+     * @param on The desired value of the `SO_ZEROCOPY` option
+     * @return An error code on failure.
+     */
+    result<> zerocopy(bool on) noexcept { return set_option(SOL_SOCKET, SO_ZEROCOPY, on); }
+#endif
+    /**
+     * Gets the value of the `SO_BUSY_POLL` option on the socket.
+     * This is only available on Linux.
+     * @return The busy-poll time, or an error code on failure.
+     */
+    result<microseconds> busy_poll() const noexcept;
+    /**
+     * Sets the value of the `SO_BUSY_POLL` option on the socket.
+     *
+     * A blocking read on the socket spins on the device receive queue for
+     * up to this long before sleeping, trading CPU time for lower latency.
+     * Raising the value above the system setting (`net.core.busy_read`)
+     * requires the `CAP_NET_ADMIN` capability. This is only available on
+     * Linux.
+     * @param t The time to busy-poll. Zero disables it.
+     * @return An error code on failure.
+     */
+    result<> busy_poll(microseconds t) noexcept;
+    /**
+     * Gets the value of the `SO_PREFER_BUSY_POLL` option on the socket.
+     * This is only available on Linux.
+     * @return Whether busy polling is preferred, or an error code on
+     *  	   failure.
+     */
+    result<bool> prefer_busy_poll() const noexcept;
+    /**
+     * Sets the value of the `SO_PREFER_BUSY_POLL` option on the socket.
+     *
+     * This asks the kernel to leave the device queue to the busy-polling
+     * application, rather than also servicing it from interrupts, while
+     * the application keeps polling. This is only available on Linux
+     * (5.11 or later).
+     * @param on Whether to prefer busy polling.
+     * @return An error code on failure.
+     */
+    result<> prefer_busy_poll(bool on) noexcept;
+    /**
+     * Gets the value of the `SO_BUSY_POLL_BUDGET` option on the socket.
+     * This is only available on Linux.
+     * @return The number of packets processed per busy poll, or an error
+     *  	   code on failure.
+     */
+    result<unsigned> busy_poll_budget() const noexcept;
+    /**
+     * Sets the value of the `SO_BUSY_POLL_BUDGET` option, the number of
+     * packets the kernel processes in each busy poll of the device.
+     * Raising it above the default requires the `CAP_NET_ADMIN`
+     * capability. This is only available on Linux (5.11 or later).
+     * @param n The number of packets per busy poll.
+     * @return An error code on failure.
+     */
+    result<> busy_poll_budget(unsigned n) noexcept;
+    /**
+     * Gets the value of the `SO_MAX_PACING_RATE` option on the socket.
+     * This is only available on Linux.
+     * @return The pacing rate, in bytes per second, or an error code on
+     *  	   failure. The rate is all ones when there's no limit.
+     */
+    result<uint64_t> max_pacing_rate() const noexcept;
+    /**
+     * Sets the value of the `SO_MAX_PACING_RATE` option, the highest rate
+     * at which the kernel sends data from the socket.
+     *
+     * TCP sockets are paced by the TCP stack itself. Other sockets, like
+     * UDP, are only paced when the outgoing interface uses the fair queue
+     * (`fq`) queueing discipline, which spaces out each socket's packets.
+     * This is only available on Linux. For a portable limit, done in user
+     * space, see @ref pacer.
+     * @param bytesPerSec The pacing rate, in bytes per second. A value of
+     *  				  all ones removes the limit.
+     * @return An error code on failure.
+     */
+    result<> max_pacing_rate(uint64_t bytesPerSec) noexcept;
+    /**
+     * Gets the value of the `SO_INCOMING_CPU` option on the socket.
+     *
+     * For a connected socket, this is the CPU that processed the most
+     * recent packet received for it. Handling the socket on a thread
+     * pinned to that CPU keeps the kernel's receive processing, the
+     * application, and the socket's memory on the same core. This is only
+     * available on Linux.
+     * @return The CPU number, which is -1 if nothing was received yet, or
+     *  	   an error code on failure.
+     */
+    result<int> incoming_cpu() const noexcept;
+    /**
+     * Sets the value of the `SO_INCOMING_CPU` option on the socket.
+     * For a listening socket in a `SO_REUSEPORT` group, this tells the
+     * kernel to prefer it for connections received on that CPU. This is
+     * only available on Linux.
+     * @param cpu The CPU number.
+     * @return An error code on failure.
+     */
+    result<> incoming_cpu(int cpu) noexcept;
+    /**
+     * Gets the value of the `SO_INCOMING_NAPI_ID` option on the socket.
+     * This identifies the device receive queue that the most recent packet
+     * for the socket came in on. Sockets with the same ID are received by
+     * the same queue, and so by the same CPU when the queue's interrupt is
+     * bound to one. This is only available on Linux.
+     * @return The NAPI ID, which is zero if it isn't known (as on the
+     *  	   loopback device), or an error code on failure.
+     */
+    result<unsigned> napi_id() const noexcept;
     /**
      * Shuts down all or part of the full-duplex connection.
      * @param how Which part of the connection should be shut:
@@ -612,18 +824,7 @@ public:
      * @return The number of bytes sent on success or, the error code on
      *         failure.
      */
-    result<size_t> send_to(const void* buf, size_t n, int flags, const sock_address& addr) {
-#if defined(_WIN32)
-        auto cbuf = reinterpret_cast<const char*>(buf);
-        return check_res<size_t>(
-            ::sendto(handle(), cbuf, int(n), flags, addr.sockaddr_ptr(), addr.size())
-        );
-#else
-        return check_res<ssize_t, size_t>(
-            ::sendto(handle(), buf, n, flags, addr.sockaddr_ptr(), addr.size())
-        );
-#endif
-    }
+    result<size_t> send_to(const void* buf, size_t n, int flags, const sock_address& addr);
     /**
      * Sends a message to another socket.
      * @param buf The data to send.
@@ -651,15 +852,7 @@ public:
      * @param flags The option bit flags. See send(2).
      * @return @em zero on success, @em -1 on failure.
      */
-    result<size_t> send(const void* buf, size_t n, int flags = 0) {
-#if defined(_WIN32)
-        return check_res<ssize_t, size_t>(
-            ::send(handle(), reinterpret_cast<const char*>(buf), int(n), flags)
-        );
-#else
-        return check_res<ssize_t, size_t>(::send(handle(), buf, n, flags));
-#endif
-    }
+    result<size_t> send(const void* buf, size_t n, int flags = 0);
     /**
      * Sends a string to the socket at the default address.
      * The socket should be connected before calling this
@@ -698,15 +891,277 @@ public:
      * @param flags The option bit flags. See send(2).
      * @return The number of bytes read or @em -1 on error.
      */
-    result<size_t> recv(void* buf, size_t n, int flags = 0) {
-#if defined(_WIN32)
-        return check_res<ssize_t, size_t>(
-            ::recv(handle(), reinterpret_cast<char*>(buf), int(n), flags)
-        );
-#else
-        return check_res<ssize_t, size_t>(::recv(handle(), buf, n, flags));
+    result<size_t> recv(void* buf, size_t n, int flags = 0);
+
+#if !defined(_WIN32)
+    // ----- Messages with ancillary data -----
+
+    /**
+     * Sends a message on the socket using a complete message header.
+     * This is a thin wrapper around `sendmsg()`.
+     * @param msg The message header.
+     * @param flags The option bit flags. See sendmsg(2).
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> send_msg(const msghdr& msg, int flags = 0);
+    /**
+     * Sends a message with ancillary data to the connected peer.
+     * @param iov The buffers for the data of the message.
+     * @param n The number of buffers.
+     * @param ctrl The control messages to send with the data.
+     * @param flags The option bit flags. See sendmsg(2).
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> send_msg(
+        const iovec* iov, size_t n, const cmsg_buffer<N>& ctrl, int flags = 0
+    ) {
+        msghdr msg{};
+        msg.msg_iov = const_cast<iovec*>(iov);
+        msg.msg_iovlen = n;
+        if (!ctrl.empty()) {
+            msg.msg_control = const_cast<void*>(ctrl.data());
+            msg.msg_controllen = ctrl.size();
+        }
+        return send_msg(msg, flags);
+    }
+    /**
+     * Sends a message with ancillary data to the specified address.
+     * @param iov The buffers for the data of the message.
+     * @param n The number of buffers.
+     * @param ctrl The control messages to send with the data.
+     * @param addr The remote destination of the message.
+     * @param flags The option bit flags. See sendmsg(2).
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> send_msg_to(
+        const iovec* iov, size_t n, const cmsg_buffer<N>& ctrl, const sock_address& addr,
+        int flags = 0
+    ) {
+        msghdr msg{};
+        msg.msg_name = const_cast<sockaddr*>(addr.sockaddr_ptr());
+        msg.msg_namelen = addr.size();
+        msg.msg_iov = const_cast<iovec*>(iov);
+        msg.msg_iovlen = n;
+        if (!ctrl.empty()) {
+            msg.msg_control = const_cast<void*>(ctrl.data());
+            msg.msg_controllen = ctrl.size();
+        }
+        return send_msg(msg, flags);
+    }
+    /**
+     * Receives a message on the socket using a complete message header.
+     * This is a thin wrapper around `recvmsg()`.
+     * @param msg The message header. On return, the lengths and flags are
+     *  		  updated as by recvmsg().
+     * @param flags The option bit flags. See recvmsg(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_msg(msghdr& msg, int flags = 0);
+    /**
+     * Receives a message on the socket, along with its ancillary data.
+     *
+     * The control buffer is filled with whatever control messages arrive
+     * with the data, which can then be parsed with a @ref cmsg_reader.
+     * Nothing is allocated from the heap.
+     * @param iov The buffers to get the data of the message.
+     * @param n The number of buffers.
+     * @param ctrl Gets the control messages received with the data.
+     * @param srcAddr Receives the address of the peer that sent the
+     *  			  message, if not null.
+     * @param flags The option bit flags. See recvmsg(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> recv_msg(
+        iovec* iov, size_t n, cmsg_buffer<N>& ctrl, sock_address* srcAddr = nullptr,
+        int flags = 0
+    ) {
+        msghdr msg{};
+        if (srcAddr) {
+            msg.msg_name = srcAddr->sockaddr_ptr();
+            msg.msg_namelen = srcAddr->size();
+        }
+        msg.msg_iov = iov;
+        msg.msg_iovlen = n;
+        msg.msg_control = ctrl.data();
+        msg.msg_controllen = ctrl.capacity();
+
+        auto res = recv_msg(msg, flags);
+        ctrl.received(res ? size_t(msg.msg_controllen) : 0, msg.msg_flags);
+        return res;
+    }
 #endif
+
+#if defined(__linux__)
+    // ----- Zero-copy completions -----
+
+    /**
+     * A notification that the kernel is done with the buffers from a range
+     * of zero-copy sends.
+     *
+     * Each successful call to send with the `MSG_ZEROCOPY` flag is given a
+     * sequence number, starting at zero for each socket and incremented by
+     * one for every call, regardless of how many bytes were sent. A
+     * completion covers the inclusive range of sequence numbers @em lo to
+     * @em hi.
+     */
+    struct zerocopy_completion
+    {
+        /** The first send in the range */
+        uint32_t lo;
+        /** The last send in the range */
+        uint32_t hi;
+        /**
+         * Whether the kernel gave up and copied the data anyway. When this
+         * happens regularly (such as over the loopback), zero-copy is
+         * just adding overhead.
+         */
+        bool copied;
+
+        /**
+         * Determines if the specified send is part of this completion.
+         * @param seq The sequence number of a send.
+         * @return @em true if the send is in the range of this completion.
+         */
+        bool contains(uint32_t seq) const {
+            // Use serial-number arithmetic, in case the counter wrapped
+            return int32_t(seq - lo) >= 0 && int32_t(hi - seq) >= 0;
+        }
+    };
+    /**
+     * Reads any zero-copy completions that are waiting on the error queue
+     * of the socket.
+     * This never blocks. The socket becomes readable with an error
+     * (poller::ERRORS) when completions are waiting.
+     * Any other messages on the error queue are discarded.
+     * @param comps Array to receive the completions.
+     * @param n The maximum number of completions to read.
+     * @return The number of completions read, which may be zero, or the
+     *         error code on failure.
+     */
+    result<size_t> zerocopy_completions(zerocopy_completion* comps, size_t n);
+
+    // ----- Kernel timestamps -----
+
+    /** Timestamp received packets in software, as they arrive */
+    static constexpr unsigned TIMESTAMP_RX_SOFTWARE = 0x01;
+    /** Report hardware timestamps of received packets, from the NIC */
+    static constexpr unsigned TIMESTAMP_RX_HARDWARE = 0x02;
+    /** Timestamp sent packets in software, as they leave the stack */
+    static constexpr unsigned TIMESTAMP_TX_SOFTWARE = 0x04;
+    /** Report hardware timestamps of sent packets, from the NIC */
+    static constexpr unsigned TIMESTAMP_TX_HARDWARE = 0x08;
+
+    /**
+     * The kernel timestamps for a single packet.
+     */
+    struct packet_timestamp
+    {
+        /** The software timestamp, on the system (realtime) clock */
+        nanoseconds software{0};
+        /** The raw hardware timestamp, on the clock of the NIC */
+        nanoseconds hardware{0};
+        /**
+         * For a transmit timestamp, the number of the send that it
+         * belongs to. This counts the sends on a datagram socket, and
+         * the bytes on a stream socket, starting from zero when
+         * timestamps are enabled.
+         */
+        uint32_t id{0};
+
+        /**
+         * Determines if there is a software timestamp.
+         * @return @em true if there is a software timestamp.
+         */
+        bool has_software() const noexcept { return software.count() != 0; }
+        /**
+         * Determines if there is a hardware timestamp.
+         * @return @em true if there is a hardware timestamp.
+         */
+        bool has_hardware() const noexcept { return hardware.count() != 0; }
+        /**
+         * Gets the software timestamp as a system time point.
+         * @return The software timestamp as a system time point.
+         */
+        std::chrono::system_clock::time_point time() const {
+            using namespace std::chrono;
+            return system_clock::time_point{duration_cast<system_clock::duration>(software)};
+        }
+    };
+    /**
+     * Enables kernel timestamps for the packets on the socket, using the
+     * `SO_TIMESTAMPING` option.
+     *
+     * The receive timestamps are returned with the data by
+     * @ref recv_from(void*, size_t, packet_timestamp&, sock_address*, int).
+     * The transmit timestamps are queued on the error queue of the socket
+     * and read with @ref tx_timestamps(). Hardware timestamps also need
+     * to be turned on for the network interface (`SIOCSHWTSTAMP`) which
+     * requires privileges.
+     * @param flags A combination of the `TIMESTAMP_` flags. Zero turns
+     *  			off timestamps.
+     * @return The error code on failure.
+     */
+    result<> enable_timestamps(unsigned flags = TIMESTAMP_RX_SOFTWARE);
+    /**
+     * Receives a message on the socket, along with its kernel timestamps.
+     *
+     * This gets the timestamps from the control data of the single
+     * `recvmsg()` call that reads the data, so it needs no extra system
+     * call. Timestamps must first be turned on with
+     * @ref enable_timestamps(), although the older `SO_TIMESTAMPNS` and
+     * `SO_TIMESTAMP` options are also recognized.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @param ts Gets the timestamps of the message. Any that are not
+     *  		 available are left at zero.
+     * @param srcAddr Receives the address of the peer that sent the
+     *  			  message, if not null.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv_from(
+        void* buf, size_t n, packet_timestamp& ts, sock_address* srcAddr = nullptr,
+        int flags = 0
+    );
+    /**
+     * Receives a message on the socket, along with its kernel timestamps.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @param ts Gets the timestamps of the message.
+     * @param flags The option bit flags. See recv(2).
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> recv(void* buf, size_t n, packet_timestamp& ts, int flags = 0) {
+        return recv_from(buf, n, ts, nullptr, flags);
     }
+    /**
+     * Reads any transmit timestamps that are waiting on the error queue
+     * of the socket.
+     * This never blocks. The socket becomes readable with an error
+     * (poller::ERRORS) when timestamps are waiting. Any other messages on
+     * the error queue are discarded, so this shouldn't be mixed with
+     * @ref zerocopy_completions() on the same socket.
+     * @param ts Array to receive the timestamps.
+     * @param n The maximum number of timestamps to read.
+     * @return The number of timestamps read, which may be zero, or the
+     *         error code on failure.
+     */
+    result<size_t> tx_timestamps(packet_timestamp* ts, size_t n);
+
+protected:
+    /**
+     * Gets the timestamps from a control message, if it holds any.
+     * This is for derived classes that read their own control data, as
+     * with batched receives.
+     * @param cmsg A control message from a received packet.
+     * @param ts Gets the timestamps.
+     * @return @em true if the message held timestamps, @em false if not.
+     */
+    static bool get_timestamps(const cmsghdr* cmsg, packet_timestamp& ts) noexcept;
+#endif
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,218 @@
+/**
+ * @file socket_options.h
+ *
+ * A profile of socket options applied as sockets are created.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_socket_options_h
+#define __sockpp_socket_options_h
+
+#include <vector>
+
+#include "sockpp/result.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+class socket;
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A set of integer socket options to apply to each new socket.
+ *
+ * A profile can be attached to an acceptor or connector, which then
+ * applies it whenever it creates a socket. For an acceptor, the options
+ * that the system copies from a listener to its accepted sockets are set
+ * just once, on the listener, and only the rest are set on each new
+ * connection. On Linux nearly everything is inherited, so a profile of
+ * buffer sizes, `TCP_NODELAY`, and keepalive settings costs nothing per
+ * connection.
+ *
+ * Each option keeps the error from the last time it was applied, so the
+ * application can see which ones the system rejected. Because of that, a
+ * profile is not thread-safe while being applied.
+ */
+class socket_options
+{
+public:
+    /**
+     * A single integer socket option.
+     */
+    struct option
+    {
+        /** The protocol level, such as SOL_SOCKET or IPPROTO_TCP */
+        int level;
+        /** The option name, such as SO_RCVBUF */
+        int name;
+        /** The value for the option */
+        int value;
+        /** Whether accepted sockets inherit the option from the listener */
+        bool inherited;
+        /** The error from the last time the option was applied */
+        error_code err;
+    };
+
+private:
+    /** The options, in the order they are applied */
+    std::vector<option> opts_;
+
+    /**
+     * Applies the options to a socket.
+     * @param sock The socket.
+     * @param inherited Apply the options that are inherited from a
+     *  				listener (or not).
+     * @param all Apply all the options, ignoring @em inherited.
+     * @return The first error, if any.
+     */
+    result<> apply(socket& sock, bool inherited, bool all) noexcept;
+
+public:
+    /**
+     * Creates an empty set of options.
+     */
+    socket_options() = default;
+    /**
+     * Determines if an accepted socket inherits an option from the
+     * listener on this platform.
+     * @param level The protocol level.
+     * @param name The option name.
+     * @return @em true if the option is inherited.
+     */
+    static bool is_inherited(int level, int name) noexcept;
+    /**
+     * Adds an option to the set, or replaces the value if the option is
+     * already in it.
+     * @param level The protocol level, such as SOL_SOCKET or IPPROTO_TCP.
+     * @param name The option name.
+     * @param val The value for the option.
+     * @return A reference to this object.
+     */
+    socket_options& set(int level, int name, int val);
+    /**
+     * Adds the `TCP_NODELAY` option to the set.
+     * @param on Whether to disable Nagle's algorithm.
+     * @return A reference to this object.
+     */
+    socket_options& nodelay(bool on = true) { return set(IPPROTO_TCP, TCP_NODELAY, int(on)); }
+    /**
+     * Adds the `SO_KEEPALIVE` option to the set.
+     * @param on Whether to enable keepalive probes.
+     * @return A reference to this object.
+     */
+    socket_options& keepalive(bool on = true) {
+        return set(SOL_SOCKET, SO_KEEPALIVE, int(on));
+    }
+    /**
+     * Adds the `SO_RCVBUF` option to the set.
+     * @param sz The size of the OS receive buffer.
+     * @return A reference to this object.
+     */
+    socket_options& recv_buffer_size(unsigned sz) {
+        return set(SOL_SOCKET, SO_RCVBUF, int(sz));
+    }
+    /**
+     * Adds the `SO_SNDBUF` option to the set.
+     * @param sz The size of the OS send buffer.
+     * @return A reference to this object.
+     */
+    socket_options& send_buffer_size(unsigned sz) {
+        return set(SOL_SOCKET, SO_SNDBUF, int(sz));
+    }
+    /**
+     * Gets the number of options in the set.
+     * @return The number of options in the set.
+     */
+    size_t size() const noexcept { return opts_.size(); }
+    /**
+     * Determines if the set is empty.
+     * @return @em true if there are no options in the set.
+     */
+    bool empty() const noexcept { return opts_.empty(); }
+    /**
+     * Removes all the options from the set.
+     */
+    void clear() noexcept { opts_.clear(); }
+    /**
+     * Gets an iterator to the first option.
+     * @return An iterator to the first option.
+     */
+    std::vector<option>::const_iterator begin() const noexcept { return opts_.begin(); }
+    /**
+     * Gets an iterator past the last option.
+     * @return An iterator past the last option.
+     */
+    std::vector<option>::const_iterator end() const noexcept { return opts_.end(); }
+    /**
+     * Gets the number of options that failed the last time they were
+     * applied.
+     * @return The number of options that failed.
+     */
+    size_t failed() const noexcept;
+    /**
+     * Applies all the options to a socket.
+     * @param sock The socket.
+     * @return The first error, if any. The remaining options are still
+     *         applied.
+     */
+    result<> apply(socket& sock) noexcept { return apply(sock, false, true); }
+    /**
+     * Applies the options that are inherited by accepted sockets to a
+     * listener.
+     * @param sock The listening socket.
+     * @return The first error, if any.
+     */
+    result<> apply_listener(socket& sock) noexcept { return apply(sock, true, false); }
+    /**
+     * Applies the options that aren't inherited from the listener to a
+     * newly accepted socket.
+     * @param sock The accepted socket.
+     * @return The first error, if any.
+     */
+    result<> apply_accepted(socket& sock) noexcept { return apply(sock, false, false); }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_socket_options_h
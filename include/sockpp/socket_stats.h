@@ -0,0 +1,375 @@
+/**
+ * @file socket_stats.h
+ *
+ * Process-wide I/O counters for sockets, for monitoring and diagnostics.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_socket_stats_h
+#define __sockpp_socket_stats_h
+
+#include <array>
+#include <cstdint>
+#include <thread>
+
+#include "sockpp/error.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A snapshot of the I/O counters for all the sockets in the process.
+ *
+ * When the library is built with the `SOCKPP_WITH_STATS` option, each
+ * send and receive system call made through a socket is counted: the
+ * number of calls, the bytes moved, and the failures, broken down by the
+ * error. The time that sends are held back by a @ref pacer is also
+ * tracked. This is meant to answer questions like whether a slow service is
+ * spinning on short writes, or being hit with signals, without having to
+ * trace it.
+ *
+ * The counters are kept in a slot for each thread, which is only ever
+ * written by that thread, so there's no contention between threads that
+ * are doing I/O. A snapshot adds up the slots of all the threads, plus
+ * the totals from any threads that have exited.
+ *
+ * The counters only ever increase. To get the activity over an interval,
+ * as a metrics exporter would, subtract one snapshot from a later one.
+ *
+ * Without the build option, the library does no counting, and every
+ * snapshot is all zeros.
+ */
+struct socket_stats
+{
+    /**
+     * The highest error number tracked individually. Errors with larger
+     * values are all counted together in the last slot.
+     */
+    static constexpr size_t MAX_ERRNO = 255;
+
+    /** The number of bytes received */
+    uint64_t bytesIn{0};
+    /** The number of bytes sent */
+    uint64_t bytesOut{0};
+    /** The number of send and receive system calls */
+    uint64_t syscalls{0};
+    /** Calls that failed because a non-blocking socket wasn't ready */
+    uint64_t wouldBlock{0};
+    /** Calls that were interrupted by a signal (and typically retried) */
+    uint64_t interrupted{0};
+    /** Sends that transferred fewer bytes than were requested */
+    uint64_t partialWrites{0};
+    /** The total number of failed calls, for any reason */
+    uint64_t errors{0};
+    /** The number of times a @ref pacer held back sends */
+    uint64_t throttles{0};
+    /** The total time that pacers held back sends, in nanoseconds */
+    uint64_t throttleNanos{0};
+    /** The number of failed calls for each platform error number */
+    std::array<uint64_t, MAX_ERRNO + 1> errnoCounts{};
+
+    /**
+     * Determines if the library was built to collect the counters.
+     * @return @em true if the library counts socket I/O, @em false if
+     *  	   the counters are always zero.
+     */
+    static bool enabled() noexcept;
+    /**
+     * Gets the current totals of the counters over all the threads.
+     * @return The current totals for the process.
+     */
+    static socket_stats snapshot();
+    /**
+     * Gets the number of failed calls for a specific error.
+     * This assumes the platform error numbers are the portable ones, as
+     * they are on POSIX systems.
+     * @param err The error
+     * @return The number of calls that failed with that error.
+     */
+    uint64_t errors_for(errc err) const noexcept { return errors_for(int(err)); }
+    /**
+     * Gets the number of failed calls for a specific platform error
+     * number.
+     * @param ec The platform-specific error number.
+     * @return The number of calls that failed with that error.
+     */
+    uint64_t errors_for(int ec) const noexcept {
+        return (ec >= 0 && size_t(ec) < MAX_ERRNO) ? errnoCounts[size_t(ec)] : 0;
+    }
+    /**
+     * Adds the counters from another snapshot to these.
+     * @param rhs The other counters.
+     * @return A reference to this object.
+     */
+    socket_stats& operator+=(const socket_stats& rhs) noexcept;
+    /**
+     * Subtracts an earlier snapshot, to get the activity in between.
+     * @param rhs The earlier snapshot.
+     * @return A reference to this object.
+     */
+    socket_stats& operator-=(const socket_stats& rhs) noexcept;
+};
+
+/**
+ * Gets the activity between two snapshots.
+ * @param lhs The later snapshot.
+ * @param rhs The earlier snapshot.
+ * @return The difference between the snapshots.
+ */
+inline socket_stats operator-(socket_stats lhs, const socket_stats& rhs) noexcept {
+    return lhs -= rhs;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A histogram of latencies, with a fixed relative precision.
+ *
+ * This is laid out like an HDR histogram. Each power of two range of
+ * values is split into @ref SUB_BUCKETS linear buckets, so that any value
+ * is recorded within about 6% of its actual value, from nanoseconds up to
+ * about 18 minutes. Larger values are counted in the last bucket. The
+ * buckets are fixed, so histograms can be added and subtracted like the
+ * other counters, and a percentile can be read from any combination of
+ * them.
+ */
+struct latency_histogram
+{
+    /** The number of bits of precision within each power of two */
+    static constexpr unsigned SUB_BITS = 4;
+    /** The number of linear buckets within each power of two */
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+    /** The number of bits in the largest value tracked, in nanoseconds */
+    static constexpr unsigned MAX_BITS = 40;
+    /** The total number of buckets */
+    static constexpr size_t N_BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+    /** The number of values recorded in each bucket */
+    std::array<uint64_t, N_BUCKETS> counts{};
+    /** The sum of all the values recorded, in nanoseconds */
+    uint64_t totalNanos{0};
+
+    /**
+     * Gets the bucket that a value goes into.
+     * @param ns The value, in nanoseconds.
+     * @return The index of the bucket.
+     */
+    static size_t bucket_index(uint64_t ns) noexcept;
+    /**
+     * Gets the smallest value that goes into a bucket.
+     * @param i The index of the bucket.
+     * @return The smallest value for the bucket, in nanoseconds.
+     */
+    static uint64_t bucket_lower(size_t i) noexcept;
+    /**
+     * Gets the largest value that goes into a bucket.
+     * @param i The index of the bucket.
+     * @return The largest value for the bucket, in nanoseconds.
+     */
+    static uint64_t bucket_upper(size_t i) noexcept;
+    /**
+     * Records a value.
+     * @param t The value. Negative values are recorded as zero.
+     */
+    void record(nanoseconds t) noexcept;
+    /**
+     * Gets the number of values recorded.
+     * @return The number of values recorded.
+     */
+    uint64_t count() const noexcept;
+    /**
+     * Determines if no values were recorded.
+     * @return @em true if the histogram is empty.
+     */
+    bool empty() const noexcept { return count() == 0; }
+    /**
+     * Gets the mean of the values recorded.
+     * @return The mean value, or zero if the histogram is empty.
+     */
+    nanoseconds mean() const noexcept;
+    /**
+     * Gets the smallest value recorded, to the precision of the histogram.
+     * @return The lower bound of the lowest bucket in use, or zero if the
+     *  	   histogram is empty.
+     */
+    nanoseconds lowest() const noexcept;
+    /**
+     * Gets the largest value recorded, to the precision of the histogram.
+     * @return The upper bound of the highest bucket in use, or zero if the
+     *  	   histogram is empty.
+     */
+    nanoseconds highest() const noexcept;
+    /**
+     * Gets the value at a percentile.
+     * @param pct The percentile, from 0 to 100, like 99.9
+     * @return The upper bound of the bucket holding the value at the
+     *  	   percentile, or zero if the histogram is empty.
+     */
+    nanoseconds percentile(double pct) const noexcept;
+    /**
+     * Adds the counts from another histogram to these.
+     * @param rhs The other histogram.
+     * @return A reference to this object.
+     */
+    latency_histogram& operator+=(const latency_histogram& rhs) noexcept;
+    /**
+     * Subtracts an earlier snapshot, to get the values recorded in
+     * between.
+     * @param rhs The earlier snapshot.
+     * @return A reference to this object.
+     */
+    latency_histogram& operator-=(const latency_histogram& rhs) noexcept;
+};
+
+/**
+ * The operations that the library times.
+ */
+enum class latency_op : unsigned {
+    /** A blocking or timed connect, from start to finish */
+    connect,
+    /**
+     * From accepting a connection to the first data from the peer. The
+     * library doesn't know when that is, so this is recorded by the
+     * application with @ref latency_stats::record().
+     */
+    first_byte,
+    /** A complete write_n() on a stream socket */
+    write_n,
+    /** A name lookup by the resolver, which missed its cache */
+    resolve
+};
+
+/**
+ * Snapshots of the latency histograms for the operations that the library
+ * times.
+ *
+ * These are collected with the I/O counters, when the library is built
+ * with the `SOCKPP_WITH_STATS` option, and in the same way: each thread
+ * records into histograms of its own, without locks or contention, and a
+ * snapshot adds them up. Since an event loop runs on a single thread, the
+ * histograms for one loop can be read on their own with
+ * @ref snapshot(std::thread::id), or with io_context::latency(). The
+ * times are taken from `std::chrono::steady_clock`, which is read from the
+ * vDSO on Linux, without a system call.
+ *
+ * Without the build option, nothing is timed, and every snapshot is
+ * empty.
+ */
+struct latency_stats
+{
+    /** The number of operations that are timed */
+    static constexpr size_t N_OPS = size_t(latency_op::resolve) + 1;
+
+    /** The histograms, indexed by operation */
+    std::array<latency_histogram, N_OPS> ops{};
+
+    /**
+     * Gets the histogram for an operation.
+     * @param op The operation.
+     * @return The histogram for the operation.
+     */
+    latency_histogram& operator[](latency_op op) noexcept { return ops[size_t(op)]; }
+    /**
+     * Gets the histogram for an operation.
+     * @param op The operation.
+     * @return The histogram for the operation.
+     */
+    const latency_histogram& operator[](latency_op op) const noexcept {
+        return ops[size_t(op)];
+    }
+    /**
+     * Determines if the library was built to collect the histograms.
+     * @return @em true if the library times operations.
+     */
+    static bool enabled() noexcept { return socket_stats::enabled(); }
+    /**
+     * Gets the histograms for the whole process, including any threads
+     * that have exited.
+     * @return The histograms for the process.
+     */
+    static latency_stats snapshot();
+    /**
+     * Gets the histograms for a single thread, such as an event loop.
+     * @param thr The thread.
+     * @return The histograms for the thread, which are empty if it never
+     *  	   recorded anything or has exited.
+     */
+    static latency_stats snapshot(std::thread::id thr);
+    /**
+     * Records a latency for an operation, in the calling thread's
+     * histograms.
+     * This does nothing unless the library is built to collect them.
+     * @param op The operation.
+     * @param t The time the operation took.
+     */
+    static void record(latency_op op, nanoseconds t) noexcept;
+    /**
+     * Adds the histograms from another snapshot to these.
+     * @param rhs The other histograms.
+     * @return A reference to this object.
+     */
+    latency_stats& operator+=(const latency_stats& rhs) noexcept;
+    /**
+     * Subtracts an earlier snapshot, to get the values recorded in
+     * between.
+     * @param rhs The earlier snapshot.
+     * @return A reference to this object.
+     */
+    latency_stats& operator-=(const latency_stats& rhs) noexcept;
+};
+
+/**
+ * Gets the latencies recorded between two snapshots.
+ * @param lhs The later snapshot.
+ * @param rhs The earlier snapshot.
+ * @return The difference between the snapshots.
+ */
+inline latency_stats operator-(latency_stats lhs, const latency_stats& rhs) noexcept {
+    return lhs -= rhs;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_socket_stats_h
@@ -0,0 +1,315 @@
+/**
+ * @file socket_view.h
+ *
+ * Lightweight, non-virtual socket handle types.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_socket_view_h
+#define __sockpp_socket_view_h
+
+#include "sockpp/socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A non-owning view of a socket handle.
+ *
+ * This is a plain value type, the size of a socket handle, with no
+ * virtual functions. It's meant for code that keeps large numbers of
+ * sockets, such as a server holding a handle for each of 100k
+ * connections, where the vtable pointer and cached state of a full socket
+ * object add up, and for hot paths that shouldn't go through virtual
+ * dispatch.
+ *
+ * The view has the basic operations that are common to all sockets, and
+ * the reads and writes of a stream socket. The @ref socket classes
+ * implement these same operations by calling through a view of their
+ * handle, so the two behave identically. A view can be made from any
+ * socket object, and remains valid for as long as that socket keeps its
+ * handle.
+ *
+ * Use @ref unique_socket to own the handle.
+ */
+class socket_view
+{
+protected:
+    /** The OS socket handle */
+    socket_t handle_{INVALID_SOCKET};
+
+public:
+    /**
+     * Creates a view that doesn't refer to a socket.
+     */
+    constexpr socket_view() noexcept = default;
+    /**
+     * Creates a view of a socket handle.
+     * @param h The OS socket handle.
+     */
+    constexpr explicit socket_view(socket_t h) noexcept : handle_{h} {}
+    /**
+     * Creates a view of the handle of a socket object.
+     * @param sock The socket.
+     */
+    socket_view(const socket& sock) noexcept : handle_{sock.handle()} {}
+    /**
+     * Gets the OS socket handle.
+     */
+    constexpr socket_t handle() const noexcept { return handle_; }
+    /**
+     * Determines if the view refers to a handle.
+     */
+    constexpr bool is_open() const noexcept { return handle_ != INVALID_SOCKET; }
+    /**
+     * Determines if the view refers to a handle.
+     */
+    constexpr explicit operator bool() const noexcept { return is_open(); }
+    /**
+     * Gets the address family of the socket, from its local address.
+     * @return The address family, or AF_UNSPEC on error.
+     */
+    sa_family_t family() const noexcept;
+    /**
+     * Gets the local address to which the socket is bound.
+     * @return The local address, or an empty address on error.
+     */
+    sock_address_any address() const;
+    /**
+     * Gets the address of the remote peer, if the socket is connected.
+     * @return The peer's address, or an empty address on error.
+     */
+    sock_address_any peer_address() const;
+    /**
+     * Gets the value of a socket option.
+     * @param level The protocol level at which the option resides.
+     * @param optname The option.
+     * @param optval Buffer to get the value.
+     * @param optlen On input, the size of the buffer. On output, the size
+     *  			 of the value.
+     * @return The error code on failure.
+     */
+    result<> get_option(int level, int optname, void* optval, socklen_t* optlen)
+        const noexcept;
+    /**
+     * Gets the value of a socket option.
+     * @param level The protocol level at which the option resides.
+     * @param optname The option.
+     * @return The value of the option, or the error code on failure.
+     */
+    template <typename T>
+    result<T> get_option(int level, int optname) const noexcept {
+        T val{};
+        socklen_t len = sizeof(T);
+        if (auto res = get_option(level, optname, &val, &len); !res)
+            return res.error();
+        return val;
+    }
+    /**
+     * Sets the value of a socket option.
+     * @param level The protocol level at which the option resides.
+     * @param optname The option.
+     * @param optval Buffer with the value.
+     * @param optlen The size of the value.
+     * @return The error code on failure.
+     */
+    result<> set_option(int level, int optname, const void* optval, socklen_t optlen)
+        const noexcept;
+    /**
+     * Sets the value of a socket option.
+     * @param level The protocol level at which the option resides.
+     * @param optname The option.
+     * @param val The value.
+     * @return The error code on failure.
+     */
+    template <typename T>
+    result<> set_option(int level, int optname, const T& val) const noexcept {
+        return set_option(level, optname, &val, socklen_t(sizeof(T)));
+    }
+    /**
+     * Places the socket into or out of non-blocking mode.
+     * The mode is shared with the socket that owns the handle.
+     * @param on Whether to turn non-blocking mode on or off.
+     * @return The error code on failure.
+     */
+    result<> set_non_blocking(bool on = true) const;
+    /**
+     * Determines if the socket is in non-blocking mode.
+     * This is always @em false on Windows, which can't query the mode.
+     */
+    bool is_non_blocking() const;
+    /**
+     * Shuts down all or part of a full-duplex connection.
+     * @param how Which part of the connection to shut down.
+     * @return The error code on failure.
+     */
+    result<> shutdown(int how = SHUT_RDWR) const;
+    /**
+     * Reads from a stream socket.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to try to read.
+     * @return The number of bytes read, or an error code on failure.
+     */
+    result<size_t> read(void* buf, size_t n) const;
+    /**
+     * Scatter read from a stream socket.
+     * @param ranges The buffers to fill.
+     * @param n The number of buffers.
+     * @return The number of bytes read, or an error code on failure.
+     */
+    result<size_t> read(const iovec* ranges, size_t n) const;
+    /**
+     * Writes to a stream socket.
+     * @param buf The data to write.
+     * @param n The number of bytes to try to write.
+     * @return The number of bytes written, or an error code on failure.
+     */
+    result<size_t> write(const void* buf, size_t n) const;
+    /**
+     * Gather write to a stream socket.
+     * @param ranges The buffers to send.
+     * @param n The number of buffers.
+     * @return The number of bytes written, or an error code on failure.
+     */
+    result<size_t> write(const iovec* ranges, size_t n) const;
+};
+
+/**
+ * Determines if two views refer to the same handle.
+ */
+constexpr bool operator==(socket_view lhs, socket_view rhs) noexcept {
+    return lhs.handle() == rhs.handle();
+}
+
+/**
+ * Determines if two views refer to different handles.
+ */
+constexpr bool operator!=(socket_view lhs, socket_view rhs) noexcept {
+    return lhs.handle() != rhs.handle();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An owned socket handle, with no virtual functions.
+ *
+ * This is a move-only handle that closes the socket when it's destroyed,
+ * like @ref socket, but is the size of the handle itself. All of the
+ * operations of a @ref socket_view can be used on it.
+ *
+ * It converts to and from the full socket classes by passing the handle
+ * along: a socket can be moved into a unique_socket, and the handle can
+ * be released to create any socket type, like:
+ *
+ *     std::vector<sockpp::unique_socket> conns;
+ *     conns.emplace_back(acc.accept().release());
+ *     ...
+ *     sockpp::tcp_socket sock{conns.back().release()};
+ */
+class unique_socket : public socket_view
+{
+    // Non-copyable
+    unique_socket(const unique_socket&) = delete;
+    unique_socket& operator=(const unique_socket&) = delete;
+
+public:
+    /**
+     * Creates a handle that doesn't own a socket.
+     */
+    unique_socket() noexcept = default;
+    /**
+     * Takes ownership of a socket handle.
+     * @param h The OS socket handle.
+     */
+    explicit unique_socket(socket_t h) noexcept : socket_view{h} {}
+    /**
+     * Takes ownership of the handle of a socket object.
+     * The socket object is left without a handle.
+     * @param sock The socket.
+     */
+    unique_socket(socket&& sock) noexcept : socket_view{sock.release()} {}
+    /**
+     * Move constructor.
+     * @param other The handle to move into this one.
+     */
+    unique_socket(unique_socket&& other) noexcept : socket_view{other.release()} {}
+    /**
+     * Destructor closes the socket.
+     */
+    ~unique_socket() { close(); }
+    /**
+     * Move assignment.
+     * Any socket currently owned by this object is closed.
+     * @param rhs The other handle to move into this one.
+     * @return A reference to this object.
+     */
+    unique_socket& operator=(unique_socket&& rhs) noexcept {
+        if (&rhs != this)
+            reset(rhs.release());
+        return *this;
+    }
+    /**
+     * Releases ownership of the handle, without closing it.
+     * @return The OS socket handle.
+     */
+    socket_t release() noexcept {
+        socket_t h = handle_;
+        handle_ = INVALID_SOCKET;
+        return h;
+    }
+    /**
+     * Replaces the handle, closing the one currently owned, if any.
+     * @param h The new OS socket handle.
+     */
+    void reset(socket_t h = INVALID_SOCKET) noexcept;
+    /**
+     * Closes the socket.
+     * @return The error code on failure.
+     */
+    result<> close() noexcept;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_socket_view_h
@@ -0,0 +1,235 @@
+/**
+ * @file spin_reader.h
+ *
+ * Low-latency socket receive that spins before falling back to a poller.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_spin_reader_h
+#define __sockpp_spin_reader_h
+
+#include <cstdint>
+#include <functional>
+
+#include "sockpp/socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The tuning parameters for a @ref spin_reader.
+ *
+ * All of the kernel options are opt-in: a zero (or @em false) value leaves
+ * the socket's current setting alone.
+ */
+struct spin_params
+{
+    /**
+     * The time to spin in user space, retrying a non-blocking read, before
+     * giving up and reporting that the read would block. Zero makes just a
+     * single non-blocking attempt.
+     */
+    microseconds spin_time{20};
+    /**
+     * The time the kernel should busy-poll the device queue on a blocking
+     * read (`SO_BUSY_POLL`).
+     */
+    microseconds busy_poll{0};
+    /** Whether to set `SO_PREFER_BUSY_POLL` on the socket. */
+    bool prefer_busy_poll{false};
+    /** The number of packets per kernel busy poll (`SO_BUSY_POLL_BUDGET`). */
+    unsigned busy_poll_budget{0};
+    /**
+     * The CPU to pin the reading thread to, on its first read. A negative
+     * value leaves the thread where the scheduler put it.
+     */
+    int cpu{-1};
+    /**
+     * An optional hook to pin the reading thread to the CPU. If this is not
+     * set, @ref spin_reader::pin_thread() is used.
+     */
+    std::function<result<>(int cpu)> pin;
+};
+
+/**
+ * Counters for how well the spin is paying off on a socket.
+ */
+struct spin_stats
+{
+    /** The number of read attempts */
+    uint64_t reads{0};
+    /** Reads satisfied by the first, non-blocking, attempt */
+    uint64_t immediate{0};
+    /** Reads that found data while spinning */
+    uint64_t spinHits{0};
+    /** Reads that spun for the whole budget and found nothing */
+    uint64_t spinMisses{0};
+    /** The total number of retries made while spinning */
+    uint64_t spinTries{0};
+
+    /**
+     * Gets the fraction of reads that had to spin and found data before
+     * the time ran out.
+     * @return The spin hit ratio, in the range [0, 1], or zero if no read
+     *  	   needed to spin.
+     */
+    double hit_ratio() const {
+        auto n = spinHits + spinMisses;
+        return n ? double(spinHits) / double(n) : 0.0;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A low-latency receive mode for a datagram or stream socket.
+ *
+ * The reader makes a non-blocking read on the socket, and if nothing is
+ * there, keeps retrying in a tight loop for a short, bounded time. Data
+ * that arrives within that window is picked up without a trip through
+ * the scheduler and the poller. If the spin runs out, the read fails with
+ * `errc::resource_unavailable_try_again`, and the application falls back
+ * to waiting on its @ref poller or @ref reactor as usual.
+ *
+ * This trades CPU time for latency, and only makes sense when the reading
+ * thread has a core to itself. The counters in @ref stats() show how
+ * often the spin actually found data, to help tune the spin time for each
+ * socket.
+ *
+ * The reader refers to the socket, but does not own it. It tracks
+ * statistics without locking, and so should be used from one thread.
+ */
+class spin_reader
+{
+    /** The socket being read */
+    socket& sock_;
+    /** The tuning parameters */
+    spin_params params_;
+    /** The usage counters */
+    spin_stats stats_;
+    /** Whether the reading thread was pinned */
+    bool pinned_{false};
+
+    /** Pins the calling thread, once, if requested. */
+    void pin_once();
+
+public:
+    /**
+     * Creates a reader for the socket.
+     * This does not change any options on the socket. Call @ref enable()
+     * to apply the kernel busy-poll settings.
+     * @param sock The socket to read. It must outlive the reader.
+     * @param params The tuning parameters.
+     */
+    explicit spin_reader(socket& sock, spin_params params = spin_params{})
+        : sock_{sock}, params_{std::move(params)} {}
+    /**
+     * Applies the kernel busy-poll options from the parameters to the
+     * socket.
+     * Each requested option is attempted, even if an earlier one fails.
+     * @return The error from the first option that failed, if any.
+     */
+    result<> enable();
+    /**
+     * Gets the socket being read.
+     * @return A reference to the socket being read.
+     */
+    socket& sock() { return sock_; }
+    /**
+     * Gets the tuning parameters.
+     * @return The tuning parameters.
+     */
+    const spin_params& params() const { return params_; }
+    /**
+     * Sets the time to spin in user space on each read.
+     * @param t The time to spin.
+     */
+    void spin_time(microseconds t) { params_.spin_time = t; }
+    /**
+     * Reads from the socket, spinning for a short time if no data is ready.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @param flags Additional flags for the receive.
+     * @return The number of bytes read, or
+     *  	   `errc::resource_unavailable_try_again` if nothing arrived
+     *  	   within the spin time.
+     */
+    result<size_t> recv(void* buf, size_t n, int flags = 0) {
+        return recv_from(buf, n, nullptr, flags);
+    }
+    /**
+     * Reads a message from the socket, spinning for a short time if no
+     * data is ready.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to read.
+     * @param srcAddr Receives the address of the peer that sent the
+     *  			  message, if not null.
+     * @param flags Additional flags for the receive.
+     * @return The number of bytes read, or
+     *  	   `errc::resource_unavailable_try_again` if nothing arrived
+     *  	   within the spin time.
+     */
+    result<size_t> recv_from(void* buf, size_t n, sock_address* srcAddr, int flags = 0);
+    /**
+     * Gets the usage counters.
+     * @return The usage counters.
+     */
+    const spin_stats& stats() const { return stats_; }
+    /**
+     * Resets the usage counters to zero.
+     */
+    void reset_stats() { stats_ = spin_stats{}; }
+    /**
+     * Pins the calling thread to a single CPU.
+     * @param cpu The CPU number.
+     * @return An error code on failure. This is
+     *  	   `errc::operation_not_supported` on platforms without thread
+     *  	   affinity.
+     */
+    static result<> pin_thread(int cpu);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_spin_reader_h
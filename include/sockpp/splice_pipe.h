@@ -0,0 +1,163 @@
+/**
+ * @file splice_pipe.h
+ *
+ * Zero-copy relay of data between sockets using a Linux kernel pipe and
+ * splice().
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_splice_pipe_h
+#define __sockpp_splice_pipe_h
+
+#include "sockpp/socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A kernel pipe used to move data from one socket to another with
+ * splice(), without ever copying it into user space.
+ *
+ * This is a building block for proxies and relays. Each call to
+ * @ref relay() moves a chunk of data from the source socket into the
+ * pipe, and from the pipe out to the destination. If the destination
+ * can't take all the data (i.e. it's non-blocking and its send buffer is
+ * full), the remainder stays in the pipe and is sent first on the next
+ * call, or by an explicit @ref flush().
+ *
+ * A pipe should be used for a single direction of a single connection,
+ * since any data pending in it belongs to that destination. The sockets
+ * may be blocking or non-blocking; the pipe itself never blocks.
+ *
+ * This is only available on Linux.
+ */
+class splice_pipe
+{
+    /** The read end of the pipe */
+    int rd_{-1};
+    /** The write end of the pipe */
+    int wr_{-1};
+    /** The number of bytes sitting in the pipe */
+    size_t pending_{0};
+
+    // Non-copyable
+    splice_pipe(const splice_pipe&) = delete;
+    splice_pipe& operator=(const splice_pipe&) = delete;
+
+public:
+    /** The default maximum number of bytes to move in each relay */
+    static constexpr size_t DFLT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * Creates the pipe.
+     * @throws std::system_error on failure.
+     */
+    splice_pipe();
+    /**
+     * Creates the pipe.
+     * @param ec Gets the error code on failure.
+     */
+    explicit splice_pipe(error_code& ec) noexcept;
+    /**
+     * Move constructor.
+     * @param other The pipe to move into this one.
+     */
+    splice_pipe(splice_pipe&& other) noexcept;
+    /**
+     * Destructor closes the pipe.
+     * Any data still pending in the pipe is lost.
+     */
+    ~splice_pipe();
+    /**
+     * Move assignment.
+     * @param rhs The other pipe to move into this one.
+     * @return A reference to this object.
+     */
+    splice_pipe& operator=(splice_pipe&& rhs) noexcept;
+    /**
+     * Determines if the pipe is open.
+     * @return @em true if the pipe is open.
+     */
+    bool is_open() const { return rd_ >= 0; }
+    /**
+     * Gets the number of bytes in the pipe waiting to go to the
+     * destination.
+     * @return The number of bytes in the pipe.
+     */
+    size_t pending() const { return pending_; }
+    /**
+     * Sets the capacity of the kernel pipe.
+     * A larger pipe lets each relay move more data.
+     * @param sz The requested size, in bytes.
+     * @return The actual capacity set by the kernel, or the error code on
+     *         failure.
+     */
+    result<size_t> set_capacity(size_t sz);
+    /**
+     * Moves data from the source socket to the destination.
+     * Any data already pending in the pipe is sent first.
+     * @param src The socket to read.
+     * @param dst The socket to write.
+     * @param n The maximum number of bytes to take from the source.
+     * @return The number of bytes delivered to the destination on this
+     *         call, or the error code on failure. A zero means that the
+     *         source has reached end-of-stream and the pipe is empty. If
+     *         nothing could be delivered because either socket would
+     *         block, this returns @ref errc::operation_would_block. In
+     *         that case, if @ref pending() is non-zero, the caller should
+     *         wait for the destination to become writable.
+     */
+    result<size_t> relay(const socket& src, const socket& dst, size_t n = DFLT_CHUNK_SIZE);
+    /**
+     * Sends as much pending data from the pipe to the destination as it
+     * will take.
+     * @param dst The socket to write.
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> flush(const socket& dst);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_splice_pipe_h
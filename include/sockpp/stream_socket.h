@@ -49,11 +49,17 @@
 
 #include <vector>
 
+#include "sockpp/buffer_pool.h"
+#include "sockpp/iovec_array.h"
 #include "sockpp/socket.h"
+#include "sockpp/tcp_info.h"
+#include "sockpp/tcp_options.h"
 #include "types.h"
 
 namespace sockpp {
 
+class pacer;
+
 /////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -72,15 +78,29 @@ protected:
 
     /**
      * Creates a streaming socket.
+     * @param domain The communications domain (address family).
+     * @param protocol The particular protocol to be used with the socket.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return An OS handle to a stream socket.
      */
-    static result<socket_t> create_handle(int domain, int protocol = 0) {
-        return base::create_handle(domain, COMM_TYPE, protocol);
+    static result<socket_t> create_handle(int domain, int protocol = 0, int flags = 0) {
+        return base::create_handle(domain, COMM_TYPE, protocol, flags);
     }
 
 public:
     /** The socket 'type' for communications semantics. */
     static constexpr int COMM_TYPE = SOCK_STREAM;
+    /** The protocol used to create sockets of this type (zero for the default) */
+    static constexpr int PROTOCOL = 0;
+
+#if defined(_WIN32)
+    /** The type of an OS file handle, as used by send_file() */
+    using file_handle_t = HANDLE;
+#else
+    /** The type of an OS file handle, as used by send_file() */
+    using file_handle_t = int;
+#endif
     /**
      * Creates an unconnected streaming socket.
      */
@@ -108,11 +128,13 @@ public:
      * @param domain The communications domain for the sockets (i.e. the
      *  			 address family)
      * @param protocol The particular protocol to be used with the sockets
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      *
      * @return A stream socket with the requested communications
      *  	   characteristics.
      */
-    static result<stream_socket> create(int domain, int protocol = 0);
+    static result<stream_socket> create(int domain, int protocol = 0, int flags = 0);
     /**
      * Move assignment.
      * @param rhs The other socket to move into this one.
@@ -150,6 +172,145 @@ public:
      *         successful, an error code on failure.
      */
     result<> nodelay(bool on) noexcept { return set_option(IPPROTO_TCP, TCP_NODELAY, on); }
+    /**
+     * Gets the value of the `TCP_CORK` option on the socket (`TCP_NOPUSH`
+     * on the BSD's and macOS).
+     * @return Whether partial frames are being held back, or an error code
+     *         on failure.
+     */
+    result<bool> cork() const noexcept;
+    /**
+     * Sets the value of the `TCP_CORK` option on the socket (`TCP_NOPUSH`
+     * on the BSD's and macOS).
+     *
+     * While corked, the kernel only sends full-sized segments, so that a
+     * response built from several writes goes out in as few packets as
+     * possible. Uncorking sends whatever is left. This is not available on
+     * Windows.
+     * @param on Whether to hold back partial frames.
+     * @return An error code on failure.
+     */
+    result<> cork(bool on) noexcept;
+    /**
+     * Gets the value of the `TCP_QUICKACK` option on the socket.
+     * This is only available on Linux.
+     * @return Whether quick ACK mode is on, or an error code on failure.
+     */
+    result<bool> quickack() const noexcept;
+    /**
+     * Sets the value of the `TCP_QUICKACK` option on the socket.
+     *
+     * This sends ACKs immediately rather than delaying them. The kernel
+     * can drop back out of quick ACK mode on its own, so an application
+     * that always wants it typically sets it again after each read. This
+     * is only available on Linux.
+     * @param on Whether to send ACKs immediately.
+     * @return An error code on failure.
+     */
+    result<> quickack(bool on) noexcept;
+    /**
+     * Gets the value of the `TCP_NOTSENT_LOWAT` option on the socket.
+     * @return The limit of unsent data, in bytes, or an error code on
+     *         failure.
+     */
+    result<unsigned> notsent_lowat() const noexcept;
+    /**
+     * Sets the value of the `TCP_NOTSENT_LOWAT` option on the socket.
+     *
+     * This limits the amount of data that has been written to the socket,
+     * but not yet sent, before it stops reporting as writable. It keeps
+     * the send queue short so that new data isn't stuck behind a large
+     * backlog. This is available on Linux and macOS.
+     * @param n The limit of unsent data, in bytes.
+     * @return An error code on failure.
+     */
+    result<> notsent_lowat(unsigned n) noexcept;
+    /**
+     * Sets the `TCP_FASTOPEN_CONNECT` option on the socket.
+     *
+     * This must be set before the connect. The connect then returns
+     * immediately, and the first write goes out in the SYN, saving a round
+     * trip for servers that have TCP Fast Open enabled. This is only
+     * available on Linux.
+     * @param on Whether to attempt a Fast Open on connect.
+     * @return An error code on failure.
+     */
+    result<> fastopen_connect(bool on) noexcept;
+    /**
+     * Gets the name of the congestion control algorithm for the socket.
+     * This is available on Linux and FreeBSD.
+     * @return The name of the algorithm, or an error code on failure.
+     */
+    result<string> congestion() const;
+    /**
+     * Sets the congestion control algorithm for the socket.
+     * This is available on Linux and FreeBSD.
+     * @param name The name of the algorithm, such as "cubic" or "bbr".
+     * @return An error code on failure.
+     */
+    result<> congestion(const string& name) noexcept;
+    /**
+     * Gets the time that sent data can remain unacknowledged.
+     * @return The timeout, or an error code on failure.
+     */
+    result<milliseconds> user_timeout() const noexcept;
+    /**
+     * Sets the time that sent data can remain unacknowledged before the
+     * connection is dropped.
+     *
+     * This is `TCP_USER_TIMEOUT` on Linux. Windows (`TCP_MAXRT`) and macOS
+     * (`TCP_RXT_CONNDROPTIME`) only have a resolution of seconds.
+     * @param to The timeout. Zero uses the system default.
+     * @return An error code on failure.
+     */
+    result<> user_timeout(milliseconds to) noexcept;
+    /**
+     * Gets the value of the `SO_KEEPALIVE` option on the socket.
+     * @return Whether keepalive probes are enabled, or an error code on
+     *         failure.
+     */
+    result<bool> keepalive() const noexcept {
+        return get_option<bool>(SOL_SOCKET, SO_KEEPALIVE);
+    }
+    /**
+     * Sets the value of the `SO_KEEPALIVE` option on the socket.
+     * @param on Whether to enable keepalive probes.
+     * @return An error code on failure.
+     */
+    result<> keepalive(bool on) noexcept { return set_option(SOL_SOCKET, SO_KEEPALIVE, on); }
+    /**
+     * Enables keepalive probes on the socket with the specified timing.
+     * @param ka The keepalive parameters. Any left at zero keep the
+     *  		 system default.
+     * @return An error code on failure.
+     */
+    result<> keepalive(const tcp_keepalive& ka) noexcept;
+    /**
+     * Applies a set of TCP options to the socket.
+     *
+     * Options that aren't available on the platform are skipped, so the
+     * same profile can be used everywhere.
+     * @param prof The options to apply.
+     * @return The first error from an option that could not be set. The
+     *         remaining options are still applied.
+     */
+    result<> apply(const tcp_profile& prof) noexcept;
+    /**
+     * Gets a snapshot of the kernel's state for the TCP connection, like
+     * the round-trip time, congestion window, and delivery rate.
+     * This is only valid for a TCP socket.
+     * @return The state of the connection, or an error code on failure.
+     */
+    result<tcp_info_snapshot> tcp_info() const noexcept { return tcp_info(handle()); }
+    /**
+     * Gets a snapshot of the kernel's state for a TCP connection.
+     * This can be used to sample a set of connections by handle, such as
+     * all the ones registered with a reactor, without needing the socket
+     * objects.
+     * @param h The handle of a TCP socket.
+     * @return The state of the connection, or an error code on failure.
+     */
+    static result<tcp_info_snapshot> tcp_info(socket_t h) noexcept;
     /**
      * Reads from the socket.
      * @param buf Buffer to get the incoming data.
@@ -157,22 +318,96 @@ public:
      * @return The number of bytes read on success, or @em -1 on error.
      */
     virtual result<size_t> read(void* buf, size_t n);
+    /**
+     * Reads from the socket into a buffer taken from a pool.
+     * This is meant to be called once the socket is known to be readable,
+     * so that the buffer is only held while there is data in it.
+     * @param pool The pool from which to take the buffer.
+     * @return A buffer holding the data that was read, or the error code
+     *  	   on failure. The buffer is empty if the peer closed the
+     *  	   connection.
+     */
+    result<pooled_buffer> read(buffer_pool& pool);
     /**
      * Best effort attempts to read the specified number of bytes.
-     * This will make repeated read attempts until all the bytes are read in
-     * or until an error occurs.
+     * This will make repeated read attempts until all the bytes are read in,
+     * the peer closes the connection, or an error occurs.
      * @param buf Buffer to get the incoming data.
      * @param n The number of bytes to try to read.
-     * @return The number of bytes read on success, or @em -1 on error. If
-     *  	   successful, the number of bytes read should always be 'n'.
+     * @return The number of bytes read on success, or @em -1 on error. This
+     *  	   is less than 'n' only if the stream ended first, and zero if
+     *  	   it had already ended.
      */
     virtual result<size_t> read_n(void* buf, size_t n);
+    /**
+     * Reads discontiguous memory ranges from the socket.
+     * @param ranges The array of memory ranges to fill
+     * @param n The number of ranges in the array.
+     * @return The number of bytes read, or the error code on failure.
+     */
+    virtual result<size_t> read(const iovec* ranges, size_t n);
     /**
      * Reads discontiguous memory ranges from the socket.
      * @param ranges The vector of memory ranges to fill
      * @return The number of bytes read, or @em -1 on error.
      */
-    result<size_t> read(const std::vector<iovec>& ranges);
+    result<size_t> read(const std::vector<iovec>& ranges) {
+        return read(ranges.data(), ranges.size());
+    }
+    /**
+     * Reads discontiguous memory ranges from the socket.
+     * @param ranges The array of memory ranges to fill
+     * @return The number of bytes read, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> read(const iovec_array<N>& ranges) {
+        return read(ranges.data(), ranges.size());
+    }
+    /**
+     * Best effort attempt to fill all of the discontiguous memory ranges
+     * from the socket.
+     * This repeatedly calls the scatter read(), advancing through the
+     * ranges as they fill, until all of them are full, the connection is
+     * closed, or an error occurs. The array of ranges is not modified.
+     * @param ranges The array of memory ranges to fill
+     * @param n The number of ranges in the array.
+     * @return The number of bytes read, or the error code on failure. On
+     *  	   success this is the total size of the ranges, unless the
+     *  	   peer closed the connection first.
+     */
+    result<size_t> read_n(const iovec* ranges, size_t n);
+    /**
+     * Best effort attempt to fill all of the discontiguous memory ranges
+     * from the socket.
+     * @param ranges The vector of memory ranges to fill
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> read_n(const std::vector<iovec>& ranges) {
+        return read_n(ranges.data(), ranges.size());
+    }
+    /**
+     * Best effort attempt to fill all of the discontiguous memory ranges
+     * from the socket.
+     * @param ranges The array of memory ranges to fill
+     * @return The number of bytes read, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> read_n(const iovec_array<N>& ranges) {
+        return read_n(ranges.data(), ranges.size());
+    }
+    /**
+     * Checks, without blocking, whether an idle connection is still
+     * usable.
+     *
+     * This peeks at the socket for a single byte. A connection that is
+     * open with nothing to read is alive. One that the peer has closed,
+     * that has an error pending, or that has unexpected data waiting is
+     * not, and shouldn't be reused. This is meant as a cheap check on a
+     * pooled connection before handing it out.
+     *
+     * @return @em true if the connection is open with nothing to read.
+     */
+    bool is_idle_alive();
     /**
      * Set a timeout for read operations.
      * Sets the timeout that the device uses for read operations. Not all
@@ -207,6 +442,24 @@ public:
      *  	   the number of bytes written should always be 'n'.
      */
     virtual result<size_t> write_n(const void* buf, size_t n);
+    /**
+     * Writes as much of the buffer as a pacer allows right now.
+     *
+     * This never waits for the pacer. It writes up to the amount that the
+     * pacer allows, taking the credit for what's sent. When the pacer has
+     * no credit it fails with `errc::operation_would_block`, just like a
+     * non-blocking socket that's full, and the application can wait for
+     * @ref pacer::delay() before writing the rest. On a non-blocking
+     * socket, a write that's cut short by the socket returns the number of
+     * bytes sent so far.
+     *
+     * @param buf The buffer to write
+     * @param n The number of bytes in the buffer.
+     * @param pc The pacer that limits the rate.
+     * @return The number of bytes written, which can be less than @a n,
+     *  	   or the error code on failure.
+     */
+    result<size_t> write_n(const void* buf, size_t n, pacer& pc);
     /**
      * Best effort attempt to write a string to the socket.
      * @param s The string to write.
@@ -215,12 +468,63 @@ public:
      *  	   the string.
      */
     virtual result<size_t> write(const string& s) { return write_n(s.data(), s.size()); }
+    /**
+     * Writes discontiguous memory ranges to the socket.
+     * This is a single gather write, which might not write all the data.
+     * @param ranges The array of memory ranges to write
+     * @param n The number of ranges in the array.
+     * @return The number of bytes written, or the error code on failure.
+     */
+    virtual result<size_t> write(const iovec* ranges, size_t n);
     /**
      * Writes discontiguous memory ranges to the socket.
      * @param ranges The vector of memory ranges to write
      * @return The number of bytes written, or @em -1 on error.
      */
-    virtual result<size_t> write(const std::vector<iovec>& ranges);
+    virtual result<size_t> write(const std::vector<iovec>& ranges) {
+        return write(ranges.data(), ranges.size());
+    }
+    /**
+     * Writes discontiguous memory ranges to the socket.
+     * @param ranges The array of memory ranges to write
+     * @return The number of bytes written, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> write(const iovec_array<N>& ranges) {
+        return write(ranges.data(), ranges.size());
+    }
+    /**
+     * Best effort attempt to write all of the discontiguous memory ranges
+     * to the socket.
+     * This repeatedly calls the gather write(), advancing through the
+     * ranges as they are sent, until all the data is written or an error
+     * occurs. In the common case this is a single system call. The array
+     * of ranges is not modified.
+     * @param ranges The array of memory ranges to write
+     * @param n The number of ranges in the array.
+     * @return The number of bytes written, or the error code on failure.
+     *  	   On success this is the total size of the ranges.
+     */
+    result<size_t> write_n(const iovec* ranges, size_t n);
+    /**
+     * Best effort attempt to write all of the discontiguous memory ranges
+     * to the socket.
+     * @param ranges The vector of memory ranges to write
+     * @return The number of bytes written, or the error code on failure.
+     */
+    result<size_t> write_n(const std::vector<iovec>& ranges) {
+        return write_n(ranges.data(), ranges.size());
+    }
+    /**
+     * Best effort attempt to write all of the discontiguous memory ranges
+     * to the socket.
+     * @param ranges The array of memory ranges to write
+     * @return The number of bytes written, or the error code on failure.
+     */
+    template <size_t N>
+    result<size_t> write_n(const iovec_array<N>& ranges) {
+        return write_n(ranges.data(), ranges.size());
+    }
     /**
      * Set a timeout for write operations.
      * Sets the timout that the device uses for write operations. Not all
@@ -240,8 +544,93 @@ public:
     result<> write_timeout(const duration<Rep, Period>& to) {
         return write_timeout(std::chrono::duration_cast<microseconds>(to));
     }
+    /**
+     * Sends part of a file out the socket, without copying the data
+     * through user space.
+     *
+     * This uses sendfile() on Linux, the BSD's and macOS, and
+     * TransmitFile() on Windows. Other systems fall back to reading the
+     * file into a buffer and writing it to the socket.
+     *
+     * Like a write(), this may send less than the requested number of
+     * bytes, particularly on a non-blocking socket. The caller should
+     * advance the offset by the number of bytes sent and try again for
+     * the rest. The file position is not used or modified (except on
+     * Windows, where it is used to mark the offset).
+     *
+     * sendfile() can't be told not to raise SIGPIPE, so the signal is
+     * blocked on the calling thread for the call. A peer that has gone
+     * away gives @em errc::broken_pipe, as with the other writes.
+     *
+     * @param fd The handle of the file to send.
+     * @param offset The offset into the file at which to start.
+     * @param count The number of bytes to send.
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    virtual result<size_t> send_file(file_handle_t fd, uint64_t offset, size_t count);
+#if defined(__linux__)
+    /**
+     * Writes a buffer to the socket without the kernel copying it.
+     *
+     * The socket must have the zero-copy option set. The kernel pins the
+     * pages of the buffer and transmits directly from them, so the buffer
+     * must not be modified or freed until a completion for this write is
+     * read with @ref zerocopy_completions(). Each successful call, even a
+     * partial write, uses up one completion sequence number.
+     *
+     * This is only worthwhile for large writes, typically over 10kB.
+     *
+     * @param buf The buffer to write.
+     * @param n The number of bytes in the buffer.
+     * @return The number of bytes written, or the error code on failure.
+     *  	   If the kernel can't pin any more pages, this fails with
+     *  	   errc::no_buffer_space.
+     */
+    result<size_t> write_zerocopy(const void* buf, size_t n) {
+        return socket::send(buf, n, MSG_ZEROCOPY);
+    }
+#endif
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/**
+ * Storage for the peer address of a socket that doesn't keep one.
+ * This is empty, so that it adds nothing to the size of the socket.
+ */
+template <typename ADDR, bool ENABLED>
+class peer_cache
+{
+protected:
+    const ADDR* cached_peer() const noexcept { return nullptr; }
+    void cache_peer(const ADDR&) noexcept {}
+    void forget_peer() noexcept {}
+};
+
+/**
+ * Storage for the peer address of a socket that keeps one.
+ */
+template <typename ADDR>
+class peer_cache<ADDR, true>
+{
+    /** The peer address, if it was captured */
+    ADDR addr_{};
+    /** Whether the peer address was captured */
+    bool valid_{false};
+
+protected:
+    const ADDR* cached_peer() const noexcept { return valid_ ? &addr_ : nullptr; }
+    void cache_peer(const ADDR& addr) noexcept {
+        addr_ = addr;
+        valid_ = true;
+    }
+    void forget_peer() noexcept { valid_ = false; }
 };
 
+}  // namespace detail
+
 /////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -250,16 +639,38 @@ public:
  * with the address type for a specific family. This doesn't add any
  * runtime functionality, but has compile-time checks that address types
  * aren't accidentally being mixed for an object.
+ *
+ * The protocol parameter is for stream protocols other than the default
+ * for the family, like MPTCP or SCTP. The connectors and acceptors for
+ * the socket type create their sockets with it.
+ *
+ * A socket can also keep a copy of its peer address, when it's known at
+ * accept or connect time, so that @ref peer_address() doesn't need a
+ * system call. This is off by default, since the copy makes every socket
+ * larger by the size of an address. Sockets that keep it are made with
+ * the @em CACHE_PEER parameter, like @ref cached_tcp_socket, and their
+ * connectors and acceptors with that socket type.
+ *
+ * @tparam ADDR The type of address for the socket.
+ * @tparam PROTO The protocol used to create the socket, or zero for the
+ *  			 default stream protocol of the address family.
+ * @tparam CACHE_PEER Whether the socket keeps a copy of its peer address.
  */
-template <typename ADDR>
-class stream_socket_tmpl : public stream_socket
+template <typename ADDR, int PROTO = 0, bool CACHE_PEER = false>
+class stream_socket_tmpl : public stream_socket, private detail::peer_cache<ADDR, CACHE_PEER>
 {
     /** The base class */
     using base = stream_socket;
+    /** The storage for the peer address */
+    using peer_cache = detail::peer_cache<ADDR, CACHE_PEER>;
 
 public:
     /** The address family for this type of address */
     static constexpr sa_family_t ADDRESS_FAMILY = ADDR::ADDRESS_FAMILY;
+    /** The protocol used to create sockets of this type */
+    static constexpr int PROTOCOL = PROTO;
+    /** Whether sockets of this type keep a copy of their peer address */
+    static constexpr bool CACHES_PEER = CACHE_PEER;
     /** The type of network address used with this socket. */
     using addr_t = ADDR;
     /** A pair of stream sockets */
@@ -281,27 +692,52 @@ public:
      * @param sock Another stream socket.
      */
     stream_socket_tmpl(stream_socket&& sock) : base(std::move(sock)) {}
+    /**
+     * Creates a stream socket by moving the other socket to this one, with
+     * the address of the remote peer.
+     *
+     * This is used when the peer address is already known, as it is when
+     * a connection is accepted. If this type caches the peer address, it
+     * keeps the copy, so that @ref peer_address() doesn't need to ask the
+     * OS for it. Otherwise the address is ignored.
+     * @param sock Another stream socket.
+     * @param peerAddr The address of the remote peer.
+     */
+    stream_socket_tmpl(stream_socket&& sock, const addr_t& peerAddr) : base(std::move(sock)) {
+        peer_cache::cache_peer(peerAddr);
+    }
     /**
      * Creates a stream socket by copying the socket handle from the
      * specified socket object and transfers ownership of the socket.
      */
-    stream_socket_tmpl(stream_socket_tmpl&& sock) : base(std::move(sock)) {}
+    stream_socket_tmpl(stream_socket_tmpl&& sock) : base(std::move(sock)), peer_cache(sock) {
+        sock.forget_peer();
+    }
     /**
      * Move assignment.
      * @param rhs The other socket to move into this one.
      * @return A reference to this object.
      */
     stream_socket_tmpl& operator=(stream_socket_tmpl&& rhs) {
-        base::operator=(std::move(rhs));
+        if (&rhs != this) {
+            base::operator=(std::move(rhs));
+            peer_cache::operator=(rhs);
+            rhs.forget_peer();
+        }
         return *this;
     }
     /**
      * Cretates a stream socket.
      * @param protocol The particular protocol to be used with the sockets
-     * @return A stream socket
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return A stream socket, or the error code on failure.
      */
-    stream_socket_tmpl create(int protocol = 0) {
-        return stream_socket_tmpl(std::move(base::create(ADDRESS_FAMILY, protocol)));
+    static result<stream_socket_tmpl> create(int protocol = PROTOCOL, int flags = 0) {
+        if (auto res = base::create(ADDRESS_FAMILY, protocol, flags); !res)
+            return res.error();
+        else
+            return stream_socket_tmpl{res.release()};
     }
     /**
      * Creates a pair of connected stream sockets.
@@ -326,6 +762,9 @@ public:
             );
         }
     }
+    using socket::address;
+    using socket::peer_address;
+
     /**
      * Gets the local address to which the socket is bound.
      * @return The local address to which the socket is bound.
@@ -335,7 +774,157 @@ public:
      * Gets the address of the remote peer, if this socket is connected.
      * @return The address of the remote peer, if this socket is connected.
      */
-    addr_t peer_address() const { return addr_t(socket::peer_address()); }
+    addr_t peer_address() const {
+        if (auto p = peer_cache::cached_peer(); p && is_open())
+            return *p;
+        return addr_t(socket::peer_address());
+    }
+    /**
+     * Determines if the peer address was captured when the socket was
+     * connected, so would be returned by @ref peer_address() without a
+     * system call. This is always @em false for a type that doesn't
+     * cache the peer address.
+     * @return @em true if the peer address is cached.
+     */
+    bool has_cached_peer_address() const noexcept {
+        return peer_cache::cached_peer() != nullptr;
+    }
+    /**
+     * Captures the address of the remote peer, so that later calls to
+     * @ref peer_address() don't need a system call.
+     * This is only useful if the socket was not created with the peer
+     * address, and is only available for a type that caches it.
+     * @return The error code on failure.
+     */
+    result<> cache_peer_address() {
+        static_assert(CACHE_PEER, "This socket type doesn't cache the peer address");
+
+        addr_t addr;
+        auto len = addr.size();
+
+        auto ret = ::getpeername(handle(), addr.sockaddr_ptr(), &len);
+        if (auto res = check_res_none(ret); !res)
+            return res;
+
+        peer_cache::cache_peer(addr);
+        return none{};
+    }
+
+#if !defined(_WIN32)
+    // ----- Descriptor passing (UNIX-domain sockets only) -----
+
+    /** The maximum number of descriptors passed in a single message */
+    static constexpr size_t MAX_FDS = 16;
+
+    /**
+     * Sends a set of open file descriptors to the peer process, along
+     * with some data (`SCM_RIGHTS`).
+     *
+     * The peer gets new descriptors that refer to the same open files or
+     * sockets. The local descriptors remain open, and are still owned by
+     * the caller.
+     *
+     * This is only available for UNIX-domain sockets.
+     * @param fds The file descriptors to send.
+     * @param nfd The number of descriptors, up to @ref MAX_FDS.
+     * @param buf The data to send with the descriptors. On a stream
+     *  		  socket, there must be at least one byte.
+     * @param n The number of bytes of data.
+     * @return The number of bytes of data sent, or the error code on
+     *         failure.
+     */
+    template <typename A = ADDR, std::enable_if_t<A::ADDRESS_FAMILY == AF_UNIX, int> = 0>
+    result<size_t> send_fds(const int* fds, size_t nfd, const void* buf, size_t n) {
+        if (nfd > MAX_FDS || n == 0)
+            return errc::invalid_argument;
+
+        cmsg_buffer<CMSG_SPACE(MAX_FDS * sizeof(int))> ctrl;
+        ctrl.add_fds(fds, nfd);
+
+        iovec iov{const_cast<void*>(buf), n};
+        return send_msg(&iov, 1, ctrl);
+    }
+    /**
+     * Receives a set of file descriptors from the peer process, along
+     * with some data.
+     *
+     * The received descriptors are owned by the caller, and are opened
+     * with close-on-exec where the system allows. Any that don't fit in
+     * the array are closed.
+     *
+     * This is only available for UNIX-domain sockets.
+     * @param fds Array to get the received descriptors.
+     * @param nfd On input, the capacity of the array. On output, the
+     *  		  number of descriptors received.
+     * @param buf Buffer to get the data.
+     * @param n The size of the buffer.
+     * @return The number of bytes of data received, or the error code on
+     *         failure.
+     */
+    template <typename A = ADDR, std::enable_if_t<A::ADDRESS_FAMILY == AF_UNIX, int> = 0>
+    result<size_t> recv_fds(int* fds, size_t& nfd, void* buf, size_t n) {
+        cmsg_buffer<CMSG_SPACE(MAX_FDS * sizeof(int))> ctrl;
+        iovec iov{buf, n};
+
+        int flags = 0;
+    #if defined(MSG_CMSG_CLOEXEC)
+        flags |= MSG_CMSG_CLOEXEC;
+    #endif
+        auto res = recv_msg(&iov, 1, ctrl, nullptr, flags);
+        nfd = res ? cmsg_reader{ctrl}.get_fds(fds, nfd) : 0;
+        return res;
+    }
+    /**
+     * Hands a socket off to the peer process, transferring ownership.
+     *
+     * This can pass an accepted connection to a worker process, or a
+     * listening acceptor to a new instance of a server during a restart,
+     * without dropping the connection or the listen backlog. On success
+     * the local socket is closed, so that the peer is the only owner;
+     * on failure, it is left untouched.
+     *
+     * This is only available for UNIX-domain sockets.
+     * @param sock The socket to hand off.
+     * @return The error code on failure.
+     */
+    template <typename SOCK, typename A = ADDR,
+              std::enable_if_t<A::ADDRESS_FAMILY == AF_UNIX, int> = 0>
+    result<> send_socket(SOCK&& sock) {
+        int fd = int(sock.handle());
+        const char tag = 0;
+
+        if (auto res = send_fds(&fd, 1, &tag, 1); !res)
+            return res.error();
+
+        sock.close();
+        return none{};
+    }
+    /**
+     * Receives a socket handed off by the peer process with
+     * @ref send_socket(), taking ownership of it.
+     *
+     * This is only available for UNIX-domain sockets.
+     * @tparam SOCK The type of socket, such as `tcp_socket` or
+     *  			`tcp_acceptor`. It must be constructible from a
+     *  			socket handle.
+     * @return The socket, or the error code on failure. If the peer closed
+     *         the connection, this fails with `errc::connection_reset`.
+     */
+    template <typename SOCK, typename A = ADDR,
+              std::enable_if_t<A::ADDRESS_FAMILY == AF_UNIX, int> = 0>
+    result<SOCK> recv_socket() {
+        int fd = -1;
+        size_t nfd = 1;
+        char tag;
+
+        auto res = recv_fds(&fd, nfd, &tag, 1);
+        if (!res)
+            return res.error();
+        if (nfd == 0)
+            return (res.value() == 0) ? errc::connection_reset : errc::bad_message;
+        return SOCK{socket_t(fd)};
+    }
+#endif
 };
 
 /////////////////////////////////////////////////////////////////////////////
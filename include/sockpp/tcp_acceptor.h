@@ -61,6 +61,11 @@ namespace sockpp {
 
 using tcp_acceptor = acceptor_tmpl<tcp_socket>;
 
+/// TCP acceptor whose sockets keep a copy of the client address, when
+/// it's requested at accept time.
+
+using cached_tcp_acceptor = acceptor_tmpl<cached_tcp_socket>;
+
 /////////////////////////////////////////////////////////////////////////////
 };  // namespace sockpp
 
@@ -57,6 +57,9 @@ namespace sockpp {
 /** IPv4 active, connector (client) socket. */
 using tcp_connector = connector_tmpl<tcp_socket>;
 
+/** IPv4 connector that keeps a copy of the address it connected to. */
+using cached_tcp_connector = connector_tmpl<cached_tcp_socket>;
+
 /////////////////////////////////////////////////////////////////////////////
 };  // namespace sockpp
 
@@ -0,0 +1,108 @@
+/**
+ * @file tcp_info.h
+ *
+ * A portable snapshot of the kernel's state for a TCP connection.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_tcp_info_h
+#define __sockpp_tcp_info_h
+
+#include <cstdint>
+
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A snapshot of the kernel's view of a TCP connection.
+ *
+ * This is the portable subset of what's reported by `TCP_INFO` on Linux,
+ * `TCP_CONNECTION_INFO` on macOS, and `SIO_TCP_INFO` on Windows, the same
+ * information that tools like `ss -ti` display. It's a cheap, single
+ * system call to get, so a server can sample it for each of its
+ * connections to export per-connection latency and throughput metrics.
+ *
+ * The sizes are normalized to bytes and the times to microseconds. Any
+ * value that the platform (or the running kernel version) doesn't report
+ * is left at zero.
+ */
+struct tcp_info_snapshot
+{
+    /** The smoothed round-trip time */
+    microseconds rtt{0};
+    /** The variation in the round-trip time */
+    microseconds rttVar{0};
+    /** The minimum round-trip time seen on the connection */
+    microseconds minRtt{0};
+    /** The congestion window, in bytes */
+    uint64_t sndCwnd{0};
+    /** The maximum segment size for sending */
+    uint32_t sndMss{0};
+    /** The number of consecutive, unrecovered retransmission timeouts */
+    uint32_t retransmits{0};
+    /** The total number of segments retransmitted on the connection */
+    uint64_t totalRetrans{0};
+    /** The current pacing rate, in bytes/sec */
+    uint64_t pacingRate{0};
+    /** The most recent estimate of the delivery rate, in bytes/sec */
+    uint64_t deliveryRate{0};
+    /** The number of bytes sent, and acknowledged by the peer */
+    uint64_t bytesAcked{0};
+    /** The number of bytes received from the peer */
+    uint64_t bytesReceived{0};
+    /** The number of bytes retransmitted */
+    uint64_t bytesRetrans{0};
+    /** The time spent busy sending data */
+    microseconds busyTime{0};
+    /** The time that sending was limited by the peer's receive window */
+    microseconds rwndLimited{0};
+    /** The time that sending was limited by the local send buffer */
+    microseconds sndbufLimited{0};
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_tcp_info_h
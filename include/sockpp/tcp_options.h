@@ -0,0 +1,121 @@
+/**
+ * @file tcp_options.h
+ *
+ * Portable settings for tuning the latency and liveness of TCP connections.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_tcp_options_h
+#define __sockpp_tcp_options_h
+
+#include <optional>
+#include <string>
+
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The parameters for TCP keepalive probes.
+ *
+ * Any value left at zero keeps the system default for that parameter.
+ */
+struct tcp_keepalive
+{
+    /** The idle time on the connection before the first probe is sent */
+    seconds idle{0};
+    /** The time between unanswered probes */
+    seconds interval{0};
+    /** The number of unanswered probes before the connection is dropped */
+    int count{0};
+};
+
+/**
+ * A set of TCP options that can be applied to a socket with a single call.
+ *
+ * Only the options that are set are applied; the rest are left as they
+ * are. This can be applied to a connected socket, or to an acceptor,
+ * in which case most systems pass the options on to the sockets that it
+ * accepts.
+ *
+ * @sa stream_socket::apply()
+ * @sa acceptor::apply()
+ */
+struct tcp_profile
+{
+    /** Disables Nagle's algorithm (`TCP_NODELAY`) */
+    std::optional<bool> nodelay;
+    /** Sends ACKs immediately rather than delaying them (`TCP_QUICKACK`) */
+    std::optional<bool> quickack;
+    /** The limit of unsent data held in the kernel (`TCP_NOTSENT_LOWAT`) */
+    std::optional<unsigned> notsentLowat;
+    /** The time that sent data can go unacknowledged (`TCP_USER_TIMEOUT`) */
+    std::optional<milliseconds> userTimeout;
+    /** Enables keepalive probes with the specified timing */
+    std::optional<tcp_keepalive> keepalive;
+    /** The congestion control algorithm, such as "cubic" or "bbr" */
+    std::optional<std::string> congestion;
+    /** The time to busy-poll the device queue on a blocking read */
+    std::optional<microseconds> busyPoll;
+
+    /**
+     * Gets a profile for request/response traffic that wants the lowest
+     * latency: no Nagle delay, no delayed ACKs, and a small amount of
+     * data queued in the kernel so that writes aren't stuck behind
+     * stale data.
+     * @return A profile for low-latency connections.
+     */
+    static tcp_profile low_latency() {
+        tcp_profile prof;
+        prof.nodelay = true;
+        prof.quickack = true;
+        prof.notsentLowat = 16 * 1024;
+        return prof;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_tcp_options_h
@@ -57,6 +57,9 @@ namespace sockpp {
 /** IPv4 streaming TCP socket */
 using tcp_socket = stream_socket_tmpl<inet_address>;
 
+/** IPv4 streaming TCP socket that keeps a copy of its peer address */
+using cached_tcp_socket = stream_socket_tmpl<inet_address, 0, true>;
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
 
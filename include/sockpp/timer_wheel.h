@@ -0,0 +1,287 @@
+/**
+ * @file timer_wheel.h
+ *
+ * A hierarchical timing wheel for connection deadlines in an event loop.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_timer_wheel_h
+#define __sockpp_timer_wheel_h
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include "sockpp/platform.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A hierarchical timing wheel.
+ *
+ * This keeps deadlines for a large number of connections, such as idle,
+ * request, and connect timeouts, for a single event loop. Scheduling,
+ * cancelling, and firing a timer are all constant time, and no memory is
+ * allocated: each @ref timer is a node embedded in the object that owns
+ * it, typically the connection.
+ *
+ * Time is counted in ticks of a fixed resolution. The wheel has five
+ * levels of 64 slots. The first level holds the timers due in the next 64
+ * ticks, and each level up covers 64 times the span of the one below it.
+ * As time advances, the timers in a higher slot are spread out into the
+ * level below, until they reach the first level and fire. With the
+ * default 1ms tick, the wheel spans about 12 days; a later deadline is
+ * re-scheduled on the way.
+ *
+ * Pushing a timer's deadline later, as an idle timeout does on every
+ * read, just records the new deadline. When the timer reaches its old
+ * slot, it's moved to the new one instead of firing. So re-arming 100k
+ * keepalive timers doesn't move any of them around.
+ *
+ * The wheel doesn't have a thread of its own. It's driven by the event
+ * loop, which waits no longer than @ref next_timeout() for I/O and then
+ * calls @ref advance() to fire the timers that are due:
+ *
+ * @code
+ * while (!rx.stopped()) {
+ *     rx.run_once(wheel.next_timeout());
+ *     wheel.advance();
+ * }
+ * @endcode
+ *
+ * Timers fire from advance(), on the loop's thread. A callback can
+ * schedule or cancel any timer, including its own. Neither the wheel nor
+ * its timers are thread safe.
+ */
+class timer_wheel
+{
+public:
+    /** The clock for the timers */
+    using clock = std::chrono::steady_clock;
+    /** A point in time on the timer clock */
+    using time_point = clock::time_point;
+
+    /**
+     * A timer that can be scheduled on a wheel.
+     *
+     * The timer is a node in one of the wheel's lists, so it can't be
+     * copied or moved. It is removed from the wheel when destroyed.
+     */
+    class timer
+    {
+        /** The function called when the timer expires */
+        std::function<void()> cb_;
+        /** The wheel that the timer is scheduled on */
+        timer_wheel* wheel_{nullptr};
+        /** The head of the list that holds the timer, if scheduled */
+        timer** slot_{nullptr};
+        /** The previous timer in the list */
+        timer* prev_{nullptr};
+        /** The next timer in the list */
+        timer* next_{nullptr};
+        /** The tick at which the timer expires */
+        uint64_t expires_{0};
+
+        friend class timer_wheel;
+
+        // Non-copyable and non-movable
+        timer(const timer&) = delete;
+        timer& operator=(const timer&) = delete;
+
+    public:
+        /**
+         * Creates a timer with no callback.
+         */
+        timer() = default;
+        /**
+         * Creates a timer.
+         * @param cb The function to call when the timer expires.
+         */
+        explicit timer(std::function<void()> cb) : cb_{std::move(cb)} {}
+        /**
+         * Destroys the timer, removing it from the wheel.
+         */
+        ~timer() { cancel(); }
+        /**
+         * Sets the function to call when the timer expires.
+         * @param cb The function to call when the timer expires.
+         */
+        void set_callback(std::function<void()> cb) { cb_ = std::move(cb); }
+        /**
+         * Determines if the timer is scheduled on a wheel.
+         * @return @em true if the timer is scheduled.
+         */
+        bool scheduled() const { return slot_ != nullptr; }
+        /**
+         * Removes the timer from its wheel, if it's scheduled.
+         */
+        void cancel() {
+            if (wheel_)
+                wheel_->cancel(*this);
+        }
+    };
+
+    /** The number of slots in each level */
+    static constexpr unsigned SLOT_BITS = 6, SLOTS = 1u << SLOT_BITS;
+    /** The number of levels */
+    static constexpr unsigned LEVELS = 5;
+
+private:
+    /** The length of a tick */
+    clock::duration res_;
+    /** The time of tick zero */
+    time_point start_;
+    /** The current tick; every slot up to this has been processed */
+    uint64_t now_{0};
+    /** The number of scheduled timers */
+    size_t n_{0};
+    /** The lists of timers, by level and slot */
+    timer* slots_[LEVELS][SLOTS]{};
+    /** A bit for each occupied slot, by level */
+    uint64_t occupied_[LEVELS]{};
+
+    /** Gets the tick at or after a point in time */
+    uint64_t to_tick(time_point tp) const;
+    /** Adds a timer to the list for its expiry */
+    void link(timer& t);
+    /** Removes a timer from its list */
+    void unlink(timer& t);
+    /** Moves the timers in a higher-level slot down */
+    void cascade(unsigned level, unsigned slot);
+    /** Schedules a timer to expire at a tick */
+    void schedule_tick(timer& t, uint64_t tick);
+
+    // Non-copyable
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+public:
+    /**
+     * Creates a timer wheel.
+     * @param resolution The length of a tick. Timers fire up to one tick
+     *  				 late.
+     */
+    explicit timer_wheel(milliseconds resolution = milliseconds{1});
+    /**
+     * Destroys the wheel, cancelling any timers still on it.
+     */
+    ~timer_wheel();
+    /**
+     * Gets the length of a tick.
+     * @return The length of a tick.
+     */
+    clock::duration resolution() const { return res_; }
+    /**
+     * Gets the number of scheduled timers.
+     * @return The number of scheduled timers.
+     */
+    size_t size() const { return n_; }
+    /**
+     * Determines if there are no scheduled timers.
+     * @return @em true if no timers are scheduled.
+     */
+    bool empty() const { return n_ == 0; }
+    /**
+     * Gets the time of the wheel.
+     * This is the time of the current tick, as of the last advance().
+     * @return The time of the wheel.
+     */
+    time_point now() const { return start_ + res_ * now_; }
+    /**
+     * Schedules a timer to expire after a delay.
+     *
+     * The delay is counted from the time of the wheel, which was the time
+     * of the last advance(), so this doesn't read the clock. If the timer
+     * is already scheduled, and the new deadline is later, this only
+     * records the new deadline, which is the cheap way to re-arm an idle
+     * timeout.
+     *
+     * @param t The timer.
+     * @param after The delay.
+     */
+    template <class Rep, class Period>
+    void schedule(timer& t, const duration<Rep, Period>& after) {
+        auto d = std::chrono::duration_cast<clock::duration>(after);
+        auto nticks = (d.count() <= 0) ? 0 : (d + res_ - clock::duration{1}) / res_;
+        schedule_tick(t, now_ + uint64_t(nticks));
+    }
+    /**
+     * Schedules a timer to expire at a specific time.
+     * @param t The timer.
+     * @param tp The time at which the timer should expire.
+     */
+    void schedule_at(timer& t, time_point tp) { schedule_tick(t, to_tick(tp)); }
+    /**
+     * Removes a timer from the wheel, if it's scheduled.
+     * @param t The timer.
+     */
+    void cancel(timer& t);
+    /**
+     * Fires all the timers that are due.
+     * @param tp The current time.
+     * @return The number of timers that fired.
+     */
+    size_t advance(time_point tp);
+    /**
+     * Fires all the timers that are due as of now.
+     * @return The number of timers that fired.
+     */
+    size_t advance() { return advance(clock::now()); }
+    /**
+     * Gets how long the event loop can wait before it must call advance().
+     *
+     * This is the time until the next tick that might have a timer to
+     * fire. It can be early, but never late.
+     *
+     * @return The time to wait, or a negative value if no timers are
+     *  	   scheduled, which means to wait indefinitely.
+     */
+    milliseconds next_timeout() const;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_timer_wheel_h
@@ -0,0 +1,134 @@
+/**
+ * @file tls_acceptor.h
+ *
+ * Server side of TLS secure connections.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_tls_acceptor_h
+#define __sockpp_tls_acceptor_h
+
+#include "sockpp/acceptor.h"
+#include "sockpp/tls_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A server that accepts TLS connections.
+ *
+ * This is a regular @ref acceptor which wraps each incoming connection in
+ * a TLS session from a server @ref tls_context that it references but does
+ * not own. The context must have a certificate and key.
+ *
+ * A blocking accept() does the handshake before returning the socket,
+ * which means that a slow or malicious client can stall it. Servers that
+ * need to guard against that should accept with @ref NON_BLOCKING, and
+ * drive @ref tls_socket::handshake() from their event loop.
+ */
+class tls_acceptor : public acceptor
+{
+    /** The base class */
+    using base = acceptor;
+
+    /** The context for new connections */
+    tls_context* ctx_;
+
+    // Non-copyable
+    tls_acceptor(const tls_acceptor&) = delete;
+    tls_acceptor& operator=(const tls_acceptor&) = delete;
+
+public:
+    /**
+     * Creates an unopened acceptor.
+     * @param ctx The server context to use for connections.
+     */
+    explicit tls_acceptor(tls_context& ctx) noexcept : ctx_{&ctx} {}
+    /**
+     * Creates an acceptor and starts it listening on the specified
+     * address.
+     * @param ctx The server context to use for connections.
+     * @param addr The address to which this server should be bound.
+     * @param queSize The listener queue size.
+     * @throws std::system_error on failure.
+     */
+    tls_acceptor(tls_context& ctx, const sock_address& addr, int queSize = DFLT_QUE_SIZE)
+        : base(addr, queSize), ctx_{&ctx} {}
+    /**
+     * Creates an acceptor and starts it listening on the specified
+     * address.
+     * @param ctx The server context to use for connections.
+     * @param addr The address to which this server should be bound.
+     * @param queSize The listener queue size.
+     * @param ec Gets the error code on failure.
+     */
+    tls_acceptor(
+        tls_context& ctx, const sock_address& addr, int queSize, error_code& ec
+    ) noexcept
+        : base(addr, queSize, ec), ctx_{&ctx} {}
+    /**
+     * Move constructor.
+     * @param other The acceptor to move into this one.
+     */
+    tls_acceptor(tls_acceptor&& other) noexcept
+        : base(std::move(other)), ctx_{other.ctx_} {}
+    /**
+     * Gets the context used for connections.
+     * @return The context used for connections.
+     */
+    tls_context& context() { return *ctx_; }
+    /**
+     * Accepts an incoming connection and wraps it in a TLS session.
+     * For a blocking socket, this also does the handshake.
+     * @param clientAddr Gets the address of the client, if not null.
+     * @param flags Options for the new socket, like @ref NON_BLOCKING. A
+     *  			non-blocking socket is returned before the handshake.
+     * @return The secure socket, or the error code on failure.
+     */
+    result<tls_socket> accept(sock_address* clientAddr = nullptr, int flags = 0);
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_tls_acceptor_h
@@ -0,0 +1,158 @@
+/**
+ * @file tls_connector.h
+ *
+ * Client side of a TLS secure connection.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_tls_connector_h
+#define __sockpp_tls_connector_h
+
+#include "sockpp/connector.h"
+#include "sockpp/tls_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A client that makes TLS connections to a server.
+ *
+ * This makes a TCP (or other stream) connection with a @ref connector, and
+ * then does the TLS handshake over it, using a client @ref tls_context,
+ * which the connector references but does not own. Once connected, this
+ * is an ordinary @ref tls_socket.
+ *
+ * When a context allows session resumption, reconnecting to the same
+ * server offers the session from the last connection, so the handshake
+ * can skip the certificate exchange and key agreement.
+ */
+class tls_connector : public tls_socket
+{
+    /** The base class */
+    using base = tls_socket;
+
+    /** The context for new connections */
+    tls_context* ctx_;
+
+    // Non-copyable
+    tls_connector(const tls_connector&) = delete;
+    tls_connector& operator=(const tls_connector&) = delete;
+
+public:
+    /**
+     * Creates an unconnected connector.
+     * @param ctx The client context to use for connections.
+     */
+    explicit tls_connector(tls_context& ctx) noexcept : ctx_{&ctx} {}
+    /**
+     * Creates a connector and connects to the server.
+     * @param ctx The client context to use for connections.
+     * @param addr The remote server address.
+     * @param peerName The name of the server, which is sent to it (as SNI)
+     *  			   and checked against its certificate. This can be
+     *  			   empty to skip the name check.
+     * @throws std::system_error on failure.
+     */
+    tls_connector(
+        tls_context& ctx, const sock_address& addr, const string& peerName = string{}
+    )
+        : ctx_{&ctx} {
+        if (auto res = connect(addr, peerName); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates a connector and connects to the server.
+     * @param ctx The client context to use for connections.
+     * @param addr The remote server address.
+     * @param peerName The name of the server. This can be empty.
+     * @param ec Gets the error code on failure.
+     */
+    tls_connector(
+        tls_context& ctx, const sock_address& addr, const string& peerName, error_code& ec
+    ) noexcept
+        : ctx_{&ctx} {
+        ec = connect(addr, peerName).error();
+    }
+    /**
+     * Move constructor.
+     * @param other The connector to move into this one.
+     */
+    tls_connector(tls_connector&& other) noexcept
+        : base(std::move(other)), ctx_{other.ctx_} {}
+    /**
+     * Move assignment.
+     * @param rhs The connector to move into this one.
+     * @return A reference to this object.
+     */
+    tls_connector& operator=(tls_connector&& rhs) noexcept {
+        base::operator=(std::move(rhs));
+        ctx_ = rhs.ctx_;
+        return *this;
+    }
+    /**
+     * Gets the context used for connections.
+     * @return The context used for connections.
+     */
+    tls_context& context() { return *ctx_; }
+    /**
+     * Connects to the server and does the TLS handshake.
+     * If the socket is currently connected, this will close the current
+     * connection and open the new one.
+     * @param addr The remote server address.
+     * @param peerName The name of the server, which is sent to it (as SNI)
+     *  			   and checked against its certificate. This can be
+     *  			   empty to skip the name check.
+     * @param timeout The time to allow for the TCP connection. Zero means
+     *  			  never time out.
+     * @return The error code on failure.
+     */
+    result<> connect(
+        const sock_address& addr, const string& peerName = string{},
+        microseconds timeout = microseconds{0}
+    );
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_tls_connector_h
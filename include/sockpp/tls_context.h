@@ -0,0 +1,270 @@
+/**
+ * @file tls_context.h
+ *
+ * Configuration and shared state for TLS secure sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_tls_context_h
+#define __sockpp_tls_context_h
+
+#include <memory>
+#include <string>
+
+#include "sockpp/error.h"
+#include "sockpp/result.h"
+#include "sockpp/types.h"
+
+// The TLS library types, which are opaque to applications.
+struct ssl_ctx_st;
+struct ssl_st;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Gets the error category for errors reported by the TLS library, such as
+ * a failed certificate verification or a protocol violation by the peer.
+ * @return The error category for TLS library errors.
+ */
+const error_category& tls_category() noexcept;
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The configuration for a set of TLS sockets.
+ *
+ * A context holds the certificates, keys, trust anchors, and options for
+ * one side of the TLS connections: either client or server. It is meant
+ * to be set up once and then shared by every socket that is created for
+ * that role. The context must outlive all the sockets created from it.
+ *
+ * A context also keeps the state that lets connections resume earlier
+ * sessions, which skips the public-key part of the handshake. A client
+ * context caches the last session for each server it connected to, and
+ * offers it on the next connection to that server. A server context
+ * issues session tickets that it can decrypt on a later connection. This
+ * can cut the CPU cost of a reconnect storm by an order of magnitude.
+ *
+ * Once configured, a context can be used from multiple threads at once.
+ * The configuration functions themselves are not thread-safe.
+ *
+ * This is currently implemented with OpenSSL.
+ */
+class tls_context
+{
+public:
+    /** Which side of the connections the context is for */
+    enum role_t { CLIENT, SERVER };
+
+    /** The default maximum number of sessions cached by a client */
+    static constexpr size_t DFLT_SESSION_CACHE_SIZE = 1024;
+
+private:
+    /** The library context */
+    ssl_ctx_st* ctx_{nullptr};
+    /** The role for the sockets */
+    role_t role_{CLIENT};
+
+    /** Shared state, which has a fixed address for the library callbacks */
+    struct state;
+    std::unique_ptr<state> state_;
+
+    /** Sockets can look up and resume previous sessions */
+    friend class tls_socket;
+
+    /** Offers a previous session, if there is one, for a new connection */
+    void resume_session(ssl_st* ssl);
+
+    // Non-copyable
+    tls_context(const tls_context&) = delete;
+    tls_context& operator=(const tls_context&) = delete;
+
+public:
+    /**
+     * Creates a context for the specified role.
+     * A client context verifies the server certificate against the
+     * system's default trust store. A server context needs to be given a
+     * certificate and key before it can accept connections.
+     * @param role Whether the context is for clients or servers.
+     * @throws std::system_error on failure.
+     */
+    explicit tls_context(role_t role = CLIENT);
+    /**
+     * Creates a context for the specified role.
+     * @param role Whether the context is for clients or servers.
+     * @param ec Gets the error code on failure.
+     */
+    tls_context(role_t role, error_code& ec) noexcept;
+    /**
+     * Move constructor.
+     * @param other The context to move into this one.
+     */
+    tls_context(tls_context&& other) noexcept;
+    /**
+     * Destructor frees the library context and any cached sessions.
+     */
+    ~tls_context();
+    /**
+     * Move assignment.
+     * @param rhs The context to move into this one.
+     * @return A reference to this object.
+     */
+    tls_context& operator=(tls_context&& rhs) noexcept;
+    /**
+     * Determines if the context is valid.
+     * @return @em true if the context is valid.
+     */
+    explicit operator bool() const { return ctx_ != nullptr; }
+    /**
+     * Gets the role of the context.
+     * @return The role of the context.
+     */
+    role_t role() const { return role_; }
+    /**
+     * Determines if this is a client context.
+     * @return @em true if this is a client context.
+     */
+    bool is_client() const { return role_ == CLIENT; }
+    /**
+     * Gets the underlying library context.
+     * This can be used to set any options that aren't covered by this
+     * class.
+     * @return The OpenSSL `SSL_CTX` for the context.
+     */
+    ssl_ctx_st* native_handle() { return ctx_; }
+    /**
+     * Loads the trusted CA certificates from a PEM file.
+     * @param path The path to the file.
+     * @return The error code on failure.
+     */
+    result<> ca_file(const string& path);
+    /**
+     * Loads the trusted CA certificates from a directory of hashed
+     * PEM files.
+     * @param dir The path to the directory.
+     * @return The error code on failure.
+     */
+    result<> ca_path(const string& dir);
+    /**
+     * Adds the trusted CA certificates from PEM data in memory.
+     * @param pem One or more PEM-encoded certificates.
+     * @return The error code on failure.
+     */
+    result<> ca_pem(const string& pem);
+    /**
+     * Loads the certificate (and any chain) from a PEM file.
+     * @param path The path to the file.
+     * @return The error code on failure.
+     */
+    result<> cert_file(const string& path);
+    /**
+     * Sets the certificate (and any chain) from PEM data in memory.
+     * @param pem The PEM-encoded certificate, followed by any
+     *  		  intermediate certificates.
+     * @return The error code on failure.
+     */
+    result<> cert_pem(const string& pem);
+    /**
+     * Loads the private key from a PEM file.
+     * This should be called after the certificate is loaded, so that the
+     * two can be checked against each other.
+     * @param path The path to the file.
+     * @return The error code on failure.
+     */
+    result<> key_file(const string& path);
+    /**
+     * Sets the private key from PEM data in memory.
+     * @param pem The PEM-encoded private key.
+     * @return The error code on failure.
+     */
+    result<> key_pem(const string& pem);
+    /**
+     * Sets whether the peer certificate must be valid.
+     * This is on by default for clients and off for servers. Turning it on
+     * for a server requires clients to present a certificate (mutual
+     * TLS).
+     * @param on Whether to verify the peer.
+     */
+    void verify_peer(bool on);
+    /**
+     * Asks the library to hand the symmetric encryption of established
+     * connections to the kernel (kTLS), where available.
+     *
+     * When the kernel takes over, the data is encrypted and framed as it's
+     * written to the socket, so @ref tls_socket::send_file() can send file
+     * data directly from the page cache. Connections silently fall back to
+     * user-space encryption if the kernel, the library, or the negotiated
+     * cipher doesn't support it. See @ref tls_socket::ktls_send().
+     * @param on Whether to use kernel TLS.
+     * @return `errc::operation_not_supported` if the TLS library was built
+     *  	   without kTLS.
+     */
+    result<> ktls(bool on = true);
+    /**
+     * Sets whether connections can resume earlier sessions.
+     * This is on by default.
+     * @param on Whether to allow session resumption.
+     */
+    void session_resumption(bool on);
+    /**
+     * Sets the maximum number of sessions that a client context caches.
+     * The oldest sessions are dropped first.
+     * @param n The maximum number of cached sessions.
+     */
+    void session_cache_size(size_t n);
+    /**
+     * Gets the number of sessions currently cached by a client context.
+     * @return The number of cached sessions.
+     */
+    size_t cached_sessions() const;
+    /**
+     * Removes all the cached sessions.
+     */
+    void flush_sessions();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_tls_context_h
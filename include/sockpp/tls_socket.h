@@ -0,0 +1,281 @@
+/**
+ * @file tls_socket.h
+ *
+ * A secure, TLS-encrypted stream socket.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_tls_socket_h
+#define __sockpp_tls_socket_h
+
+#include <string>
+
+#include "sockpp/stream_socket.h"
+#include "sockpp/tls_context.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A stream socket that encrypts the data with TLS.
+ *
+ * This wraps a connected stream socket with a TLS session, and replaces
+ * the stream read and write functions with ones that go through the
+ * session. Since @ref read_n() and @ref write_n() are built on those, the
+ * whole stream interface works the same as for a plain socket. The raw
+ * socket functions, like @ref socket::send() and @ref socket::recv(),
+ * bypass the encryption and should not be used.
+ *
+ * The handshake is done when the socket is created by a
+ * @ref tls_connector or @ref tls_acceptor, unless the underlying socket
+ * is non-blocking. In that case @ref handshake() must be called whenever
+ * the socket is ready, until it succeeds. On a non-blocking socket, any
+ * operation can fail with `errc::resource_unavailable_try_again` if the
+ * TLS session needs to read or write, in which case the application
+ * should wait for the socket to be readable or writable, and try again.
+ *
+ * If the connection was handed to kernel TLS (kTLS), the encryption
+ * happens inside the kernel, and functions like @ref send_file() go
+ * directly to it.
+ *
+ * The writes are done by OpenSSL, which can't pass MSG_NOSIGNAL, so
+ * `SIGPIPE` is blocked on the calling thread around each call that might
+ * write. A peer that has gone away gives an error, not the signal.
+ */
+class tls_socket : public stream_socket
+{
+    /** The base class */
+    using base = stream_socket;
+
+    /** The TLS session */
+    ssl_st* ssl_{nullptr};
+
+    /** Frees the TLS session, without notifying the peer. */
+    void free_session() noexcept;
+    /** Gets the error for a failed library call. */
+    error_code last_tls_error(int ret) const;
+
+    // Non-copyable
+    tls_socket(const tls_socket&) = delete;
+    tls_socket& operator=(const tls_socket&) = delete;
+
+protected:
+    /**
+     * Wraps a connected socket with a new TLS session, without doing the
+     * handshake.
+     * @param ctx The context for the session.
+     * @param sock The connected socket.
+     * @param peerName For a client, the name of the server, used for SNI
+     *  			   and to verify its certificate. This can be empty.
+     * @return The error code on failure.
+     */
+    result<> attach(tls_context& ctx, stream_socket&& sock, const string& peerName);
+
+public:
+    // The rest of the stream interface builds on the overrides below
+    using base::read;
+    using base::write;
+
+    /**
+     * Creates an unconnected TLS socket.
+     */
+    tls_socket() noexcept {}
+    /**
+     * Wraps a connected socket in a TLS session.
+     * This does not do the handshake.
+     * @param ctx The context for the session.
+     * @param sock The connected socket.
+     * @param peerName For a client, the name of the server, used for SNI
+     *  			   and to verify its certificate. This can be empty.
+     * @throws std::system_error on failure.
+     */
+    tls_socket(tls_context& ctx, stream_socket&& sock, const string& peerName = string{});
+    /**
+     * Wraps a connected socket in a TLS session.
+     * This does not do the handshake.
+     * @param ctx The context for the session.
+     * @param sock The connected socket.
+     * @param peerName For a client, the name of the server. This can be
+     *  			   empty.
+     * @param ec Gets the error code on failure.
+     */
+    tls_socket(
+        tls_context& ctx, stream_socket&& sock, const string& peerName, error_code& ec
+    ) noexcept {
+        ec = attach(ctx, std::move(sock), peerName).error();
+    }
+    /**
+     * Move constructor.
+     * @param other The socket to move into this one.
+     */
+    tls_socket(tls_socket&& other) noexcept : base(std::move(other)), ssl_{other.ssl_} {
+        other.ssl_ = nullptr;
+    }
+    /**
+     * Destructor frees the TLS session and closes the socket.
+     */
+    ~tls_socket() override;
+    /**
+     * Move assignment.
+     * @param rhs The socket to move into this one.
+     * @return A reference to this object.
+     */
+    tls_socket& operator=(tls_socket&& rhs) noexcept;
+    /**
+     * Gets the underlying TLS session.
+     * @return The OpenSSL `SSL` object for the connection.
+     */
+    ssl_st* native_handle() { return ssl_; }
+    /**
+     * Performs, or continues, the TLS handshake.
+     * @return The error code on failure, which for a non-blocking socket
+     *  	   can be `errc::resource_unavailable_try_again`.
+     */
+    result<> handshake();
+    /**
+     * Determines if the handshake has completed.
+     * @return @em true if the handshake has completed.
+     */
+    bool is_established() const;
+    /**
+     * Determines if the connection resumed an earlier session, skipping
+     * the full handshake.
+     * @return @em true if the session was resumed.
+     */
+    bool session_reused() const;
+    /**
+     * Determines if the kernel is encrypting the outgoing data (kTLS).
+     * @return @em true if kernel TLS is in use for sending.
+     */
+    bool ktls_send() const;
+    /**
+     * Determines if the kernel is decrypting the incoming data (kTLS).
+     * @return @em true if kernel TLS is in use for receiving.
+     */
+    bool ktls_recv() const;
+    /**
+     * Gets the name of the negotiated protocol version, like "TLSv1.3".
+     * @return The name of the protocol version.
+     */
+    string protocol() const;
+    /**
+     * Gets the name of the negotiated cipher suite.
+     * @return The name of the cipher suite.
+     */
+    string cipher() const;
+    /**
+     * Reads decrypted data from the connection.
+     * @param buf Buffer to get the incoming data.
+     * @param n The number of bytes to try to read.
+     * @return The number of bytes read, zero if the peer closed the
+     *  	   session, or the error code on failure.
+     */
+    result<size_t> read(void* buf, size_t n) override;
+    /**
+     * Reads decrypted data into discontiguous memory ranges.
+     * @param ranges The array of memory ranges to fill
+     * @param n The number of ranges in the array.
+     * @return The number of bytes read, or the error code on failure.
+     */
+    result<size_t> read(const iovec* ranges, size_t n) override;
+    /**
+     * Encrypts and writes data to the connection.
+     * @param buf The buffer to write
+     * @param n The number of bytes in the buffer.
+     * @return The number of bytes written, or the error code on failure.
+     */
+    result<size_t> write(const void* buf, size_t n) override;
+    /**
+     * Encrypts and writes discontiguous memory ranges to the connection.
+     * Small ranges are coalesced, so that they go out in a single TLS
+     * record, rather than one per range.
+     * @param ranges The array of memory ranges to write
+     * @param n The number of ranges in the array.
+     * @return The number of bytes written, or the error code on failure.
+     */
+    result<size_t> write(const iovec* ranges, size_t n) override;
+    /**
+     * Sends part of a file over the connection.
+     * When the kernel is encrypting the connection, this goes straight
+     * from the page cache to the socket, as with a plain socket. Otherwise
+     * the file is read into a buffer and written through the TLS session.
+     * @param fd The handle of the file to send.
+     * @param offset The offset into the file at which to start.
+     * @param count The number of bytes to send.
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> send_file(file_handle_t fd, uint64_t offset, size_t count) override;
+#if defined(__linux__)
+    /**
+     * Writes a buffer to the socket without the kernel copying it.
+     * This is only possible when the kernel is encrypting the connection
+     * (see @ref ktls_send()), and the kernel may still refuse it for the
+     * negotiated cipher.
+     * @param buf The buffer to write.
+     * @param n The number of bytes in the buffer.
+     * @return The number of bytes written, or the error code on failure.
+     *  	   This is `errc::operation_not_supported` when the session is
+     *  	   encrypted in user space.
+     */
+    result<size_t> write_zerocopy(const void* buf, size_t n);
+#endif
+    /**
+     * Sends a TLS close notification to the peer, leaving the socket
+     * open.
+     * This lets the peer know that the data it received wasn't
+     * truncated.
+     * @return The error code on failure.
+     */
+    result<> shutdown_tls();
+    /**
+     * Notifies the peer, then frees the TLS session and closes the
+     * socket.
+     * @return The error code on failure.
+     */
+    result<> close() override;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_tls_socket_h
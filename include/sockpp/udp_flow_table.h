@@ -0,0 +1,373 @@
+/**
+ * @file udp_flow_table.h
+ *
+ * A table of connected UDP sockets, one per busy peer of a server.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_udp_flow_table_h
+#define __sockpp_udp_flow_table_h
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+#include "sockpp/inet_key.h"
+#include "sockpp/udp_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A bounded table of connected UDP sockets for the busiest peers of a UDP
+ * server.
+ *
+ * A server that answers every peer from a single socket with
+ * `recv_from()` and `send_to()` makes the kernel look up the route for
+ * every reply. For a peer that keeps sending, it's cheaper to give it a
+ * socket of its own: bound to the server's address with `SO_REUSEPORT`,
+ * and connected to the peer. The kernel then delivers that peer's
+ * datagrams straight to the connected socket, and caches the route for
+ * replies, which are sent with a plain `send()`.
+ *
+ * The server calls @ref note() for each datagram that arrives on its
+ * main socket. Once a peer has sent @ref options::hot_packets of them, it
+ * gets a flow socket, which is returned for the reply, and which the
+ * server should add to its poller or @ref reactor, such as from the
+ * @ref on_open() handler.
+ *
+ * The table is kept in least-recently-used order. When it's full, the
+ * least recently used peer is dropped to make room for a new one, and
+ * peers that have been idle longer than the timeout are dropped by
+ * @ref evict_idle(), which the server should call periodically. A flow
+ * socket is handed to the @ref on_close() handler before it's closed, so
+ * that it can be removed from the poller. Any datagrams still queued on it
+ * are lost, which is allowed for UDP.
+ *
+ * The main socket must also have `SO_REUSEPORT`, and can be opened with
+ * @ref open_listener(). On systems without `SO_REUSEPORT`,
+ * `SO_REUSEADDR` is used instead, but whether the connected sockets then
+ * get their peer's datagrams is up to the system.
+ *
+ * The table is not thread safe, and is meant to be used by the thread
+ * that services the main socket.
+ *
+ * @tparam DGRAM_SOCK The type of UDP socket, like @ref udp_socket or
+ *  				  @ref udp6_socket.
+ */
+template <typename DGRAM_SOCK = udp_socket>
+class udp_flow_table
+{
+public:
+    /** The type of socket for each flow */
+    using sock_t = DGRAM_SOCK;
+    /** The type of address of the peers */
+    using addr_t = typename DGRAM_SOCK::addr_t;
+    /** The clock used for the idle timeouts */
+    using clock = std::chrono::steady_clock;
+    /** The function called when a flow socket is opened or closed */
+    using flow_handler = std::function<void(sock_t& sock, const addr_t& peer)>;
+
+    /**
+     * The limits and timeouts for the table.
+     */
+    struct options
+    {
+        /** The most peers tracked at once, with or without a socket */
+        size_t max_flows = 1024;
+        /** The number of datagrams from a peer before it gets a socket */
+        unsigned hot_packets = 8;
+        /** How long a peer can be idle before it's dropped */
+        milliseconds idle_timeout{30000};
+        /** Creation flags for the flow sockets, like NON_BLOCKING */
+        int create_flags = socket::NON_BLOCKING | socket::CLOSE_ON_EXEC;
+    };
+
+private:
+    /** A peer being tracked */
+    struct flow
+    {
+        /** The peer address */
+        addr_t peer;
+        /** The connected socket, once the peer is hot */
+        sock_t sock{INVALID_SOCKET};
+        /** The number of datagrams seen from the peer */
+        unsigned npackets{0};
+        /** When the peer was last heard from */
+        clock::time_point lastUsed;
+    };
+
+    /** The flows, most recently used first */
+    using flow_list = std::list<flow>;
+
+    /** The local address of the server */
+    addr_t localAddr_;
+    /** The limits and timeouts */
+    options opts_;
+    /** The flows, most recently used first */
+    flow_list flows_;
+    /** The flows by peer */
+    std::unordered_map<inet_key, typename flow_list::iterator> index_;
+    /** The number of flows with a socket */
+    size_t nsockets_{0};
+    /** Called when a flow socket is opened */
+    flow_handler onOpen_;
+    /** Called before a flow socket is closed */
+    flow_handler onClose_;
+
+    /** Sets the reuse option that lets sockets share the server's address */
+    static result<> set_reuse(sock_t& sock) {
+#if !defined(_WIN32) && !defined(__CYGWIN__)
+        return sock.reuse_port(true);
+#else
+        return sock.reuse_address(true);
+#endif
+    }
+
+    /** Opens a socket connected to the peer */
+    result<sock_t> open_flow(const addr_t& peer) {
+        auto res = sock_t::create(opts_.create_flags);
+        if (!res)
+            return res.error();
+
+        auto sock = res.release();
+        if (auto r = set_reuse(sock); !r)
+            return r.error();
+        if (auto r = sock.bind(localAddr_); !r)
+            return r.error();
+        if (auto r = sock.connect(peer); !r)
+            return r.error();
+        return sock;
+    }
+
+    /** Removes a flow, closing its socket */
+    void drop(typename flow_list::iterator it) {
+        if (it->sock.is_open()) {
+            if (onClose_)
+                onClose_(it->sock, it->peer);
+            --nsockets_;
+        }
+        index_.erase(inet_key{it->peer});
+        flows_.erase(it);
+    }
+
+    // Non-copyable
+    udp_flow_table(const udp_flow_table&) = delete;
+    udp_flow_table& operator=(const udp_flow_table&) = delete;
+
+public:
+    /**
+     * Creates a flow table for a server.
+     * @param localAddr The address of the server's main socket. This must
+     *  				be a specific address and port, since the flow
+     *  				sockets are bound to it.
+     * @param opts The limits and timeouts for the table.
+     */
+    explicit udp_flow_table(const addr_t& localAddr, const options& opts = options{})
+        : localAddr_{localAddr}, opts_{opts} {
+        index_.reserve(opts_.max_flows);
+    }
+    /**
+     * Destructor closes all the flow sockets, calling the close handler
+     * for each.
+     */
+    ~udp_flow_table() { clear(); }
+    /**
+     * Opens a main server socket that can share its address with the flow
+     * sockets.
+     * @param addr The address for the server.
+     * @param flags Creation flags for the socket.
+     * @return The bound socket, or the error code on failure.
+     */
+    static result<sock_t> open_listener(const addr_t& addr, int flags = 0) {
+        auto res = sock_t::create(flags);
+        if (!res)
+            return res.error();
+
+        auto sock = res.release();
+        if (auto r = set_reuse(sock); !r)
+            return r.error();
+        if (auto r = sock.bind(addr); !r)
+            return r.error();
+        return sock;
+    }
+    /**
+     * Gets the options for the table.
+     * @return The options for the table.
+     */
+    const options& get_options() const noexcept { return opts_; }
+    /**
+     * Sets the function called when a peer gets a flow socket, such as to
+     * add the socket to a reactor.
+     * @param fn The handler.
+     */
+    void on_open(flow_handler fn) { onOpen_ = std::move(fn); }
+    /**
+     * Sets the function called before a flow socket is closed, such as to
+     * remove the socket from a reactor.
+     * @param fn The handler.
+     */
+    void on_close(flow_handler fn) { onClose_ = std::move(fn); }
+    /**
+     * Records a datagram that arrived on the main socket from a peer.
+     *
+     * This moves the peer to the front of the table, adding it if it's
+     * new, and opens a flow socket for it once it's hot. If the socket
+     * can't be opened, the peer keeps being served from the main socket
+     * and the attempt is made again on its next datagram.
+     * @param peer The address of the peer.
+     * @param now The current time.
+     * @return The socket to reply on, or @em nullptr if the reply should
+     *  	   go out on the main socket with `send_to()`.
+     */
+    sock_t* note(const addr_t& peer, clock::time_point now = clock::now()) {
+        inet_key key{peer};
+        typename flow_list::iterator it;
+
+        if (auto idx = index_.find(key); idx != index_.end()) {
+            it = idx->second;
+            flows_.splice(flows_.begin(), flows_, it);
+        }
+        else {
+            if (opts_.max_flows == 0)
+                return nullptr;
+            if (flows_.size() >= opts_.max_flows)
+                drop(std::prev(flows_.end()));
+
+            flows_.push_front(flow{peer});
+            it = flows_.begin();
+            index_.emplace(key, it);
+        }
+
+        it->lastUsed = now;
+        if (it->sock.is_open())
+            return &it->sock;
+
+        if (++it->npackets < opts_.hot_packets)
+            return nullptr;
+
+        auto res = open_flow(peer);
+        if (!res)
+            return nullptr;
+
+        it->sock = res.release();
+        ++nsockets_;
+        if (onOpen_)
+            onOpen_(it->sock, it->peer);
+        return &it->sock;
+    }
+    /**
+     * Gets the flow socket for a peer, if it has one.
+     * This doesn't count as activity from the peer.
+     * @param peer The address of the peer.
+     * @return The flow socket, or @em nullptr if the peer doesn't have
+     *  	   one.
+     */
+    sock_t* find(const addr_t& peer) {
+        auto idx = index_.find(inet_key{peer});
+        if (idx == index_.end() || !idx->second->sock.is_open())
+            return nullptr;
+        return &idx->second->sock;
+    }
+    /**
+     * Marks activity on a flow socket, such as a datagram received on it,
+     * so that it isn't evicted as idle.
+     * @param peer The address of the peer.
+     * @param now The current time.
+     */
+    void touch(const addr_t& peer, clock::time_point now = clock::now()) {
+        if (auto idx = index_.find(inet_key{peer}); idx != index_.end()) {
+            idx->second->lastUsed = now;
+            flows_.splice(flows_.begin(), flows_, idx->second);
+        }
+    }
+    /**
+     * Stops tracking a peer, closing its flow socket, if any.
+     * @param peer The address of the peer.
+     * @return @em true if the peer was in the table.
+     */
+    bool remove(const addr_t& peer) {
+        auto idx = index_.find(inet_key{peer});
+        if (idx == index_.end())
+            return false;
+        drop(idx->second);
+        return true;
+    }
+    /**
+     * Drops the peers that have been idle longer than the timeout.
+     * @param now The current time.
+     * @return The number of peers dropped.
+     */
+    size_t evict_idle(clock::time_point now = clock::now()) {
+        size_t n = 0;
+        // The least recently used are at the back
+        while (!flows_.empty() && now - flows_.back().lastUsed >= opts_.idle_timeout) {
+            drop(std::prev(flows_.end()));
+            ++n;
+        }
+        return n;
+    }
+    /**
+     * Drops all the peers, closing their flow sockets.
+     */
+    void clear() {
+        while (!flows_.empty())
+            drop(std::prev(flows_.end()));
+    }
+    /**
+     * Gets the number of peers being tracked.
+     * @return The number of peers being tracked.
+     */
+    size_t size() const noexcept { return flows_.size(); }
+    /**
+     * Gets the number of peers with a flow socket.
+     * @return The number of flow sockets.
+     */
+    size_t socket_count() const noexcept { return nsockets_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_udp_flow_table_h
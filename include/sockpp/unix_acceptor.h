@@ -73,6 +73,12 @@ public:
      * Creates an unconnected acceptor.
      */
     unix_acceptor() {}
+    /**
+     * Creates an acceptor from an existing OS socket handle and claims
+     * ownership of the handle.
+     * @param handle A socket handle from the operating system.
+     */
+    explicit unix_acceptor(socket_t handle) noexcept : base(handle) {}
     /**
      * Creates a acceptor and starts it listening on the specified address.
      * @param addr The TCP address on which to listen.
@@ -105,21 +111,27 @@ public:
      * Opens the acceptor socket and binds it to the specified address.
      * @param addr The address to which this server should be bound.
      * @param queSize The listener queue size.
+     * @param flags Options for the listening socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return @em true on success, @em false on error
      */
-    result<> open(const unix_address& addr, int queSize = DFLT_QUE_SIZE) {
-        return base::open(addr, queSize);
+    result<> open(const unix_address& addr, int queSize = DFLT_QUE_SIZE, int flags = 0) {
+        return base::open(addr, queSize, 0, flags);
     }
     /**
      * Accepts an incoming UNIX connection and gets the address of the
      * client.
+     * @param clientAddr Pointer to the variable that will get the
+     *  				 address of a client when it connects.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
      * @return A unix_socket to the client.
      */
-    result<unix_socket> accept() noexcept {
-        if (auto res = base::accept(); res)
-            return unix_socket{res.release()};
-        else
+    result<unix_socket> accept(unix_address* clientAddr = nullptr, int flags = 0) noexcept {
+        auto res = base::accept(clientAddr, flags);
+        if (!res)
             return res.error();
+        return unix_socket{res.release()};
     }
 };
 
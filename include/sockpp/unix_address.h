@@ -48,6 +48,8 @@
 
 #include <sys/un.h>
 
+#include <charconv>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <string>
@@ -64,6 +66,15 @@ namespace sockpp {
 /**
  * Class that represents a UNIX domain address.
  * This inherits from the UNIX form of a socket address, @em sockaddr_un.
+ *
+ * On Linux, the address can also be in the abstract namespace. An
+ * abstract address is a path that starts with a NUL character, and is
+ * just a name, with no file created for it in the filesystem. It goes
+ * away as soon as the last socket using it is closed, so a server never
+ * has to clean up a stale socket file before it can restart. For these,
+ * the name runs up to the next NUL character, if any, and the size of the
+ * address covers only that name, to interoperate with other applications.
+ * Names with embedded NUL characters are not supported.
  */
 class unix_address : public sock_address
 {
@@ -73,6 +84,16 @@ class unix_address : public sock_address
     /** The size of the underlying address struct, in bytes */
     static constexpr size_t SZ = sizeof(sockaddr_un);
 
+    /**
+     * Gets the length of the path, including the leading NUL of an
+     * abstract name.
+     */
+    size_t path_len() const noexcept {
+        if (is_abstract())
+            return 1 + strnlen(addr_.sun_path + 1, MAX_PATH_NAME - 1);
+        return strnlen(addr_.sun_path, MAX_PATH_NAME);
+    }
+
 public:
     /** The address family for this type of address */
     static constexpr sa_family_t ADDRESS_FAMILY = AF_UNIX;
@@ -80,6 +101,12 @@ public:
     /** The max length of the file path */
     static constexpr size_t MAX_PATH_NAME = sizeof(sockaddr_un::sun_path);
 
+    /** The character that shows an abstract address in string form */
+    static constexpr char ABSTRACT_PREFIX = '@';
+
+    /** The maximum length of the string form, "unix:<path>" */
+    static constexpr size_t MAX_STR_LEN = MAX_PATH_NAME + 5;
+
     /**
      * Constructs an empty address.
      * The address is initialized to all zeroes.
@@ -87,6 +114,8 @@ public:
     unix_address() = default;
     /**
      * Constructs an address given the specified path.
+     * On Linux, a path that starts with a NUL character is a name in the
+     * abstract namespace.
      * @param path The path to the socket file.
      * @throw system_error if the path is invalid (too long, etc)
      */
@@ -123,6 +152,12 @@ public:
      * @param addr The other address
      */
     unix_address(const unix_address& addr) : addr_(addr.addr_) {}
+    /**
+     * Copies another address to this one.
+     * @param rhs The other address
+     * @return A reference to this object.
+     */
+    unix_address& operator=(const unix_address& rhs) = default;
     /**
      * Checks if the address is set to some value.
      * This doesn't attempt to determine if the address is valid, simply
@@ -130,15 +165,31 @@ public:
      * @return @em true if the address has been set, @em false otherwise.
      */
     bool is_set() const noexcept override {
-        return addr_.sun_family == ADDRESS_FAMILY && addr_.sun_path[0] != '\0';
+        return addr_.sun_family == ADDRESS_FAMILY &&
+               (addr_.sun_path[0] != '\0' || is_abstract());
+    }
+    /**
+     * Determines if this is an address in the Linux abstract namespace.
+     * This is always @em false on other systems.
+     * @return @em true if this is a named, abstract address.
+     */
+    bool is_abstract() const noexcept {
+#if defined(__linux__)
+        return addr_.sun_family == ADDRESS_FAMILY && addr_.sun_path[0] == '\0' &&
+               addr_.sun_path[1] != '\0';
+#else
+        return false;
+#endif
     }
     /**
      * Gets the path to which this address refers.
+     * For an abstract address, this is the name with a leading NUL
+     * character, which can be used to construct the same address again.
      * @return The path to which this address refers.
      */
     string path() const {
         // Remember, if len==MAX, there's no NUL terminator
-        return string(addr_.sun_path, strnlen(addr_.sun_path, MAX_PATH_NAME));
+        return string(addr_.sun_path, path_len());
     }
     /**
      * Gets the size of the address structure.
@@ -148,7 +199,11 @@ public:
      * to use this call.
      * @return The size of the address structure.
      */
-    socklen_t size() const override { return socklen_t(SZ); }
+    socklen_t size() const override {
+        if (is_abstract())
+            return socklen_t(offsetof(sockaddr_un, sun_path) + path_len());
+        return socklen_t(SZ);
+    }
     /**
      * Creates an address from the specified path.
      *
@@ -157,6 +212,16 @@ public:
      *  	   failure.
      */
     static result<unix_address> create(const string& path);
+    /**
+     * Creates an address in the Linux abstract namespace.
+     * @param name The name for the address, without the leading NUL
+     *  		   character.
+     * @return A result with the address on success, or an error code on
+     *  	   failure. This fails with `errc::invalid_argument` if the name
+     *  	   is empty or too long, and with `errc::operation_not_supported`
+     *  	   on systems other than Linux.
+     */
+    static result<unix_address> create_abstract(const string& name);
     /**
      * Gets a pointer to this object cast to a const @em sockaddr.
      * @return A pointer to this object cast to a const @em sockaddr.
@@ -182,9 +247,24 @@ public:
     /**
      * Gets a printable string for the address.
      * @return A string representation of the address in the form
-     *  	   "unix:<path>"
+     *  	   "unix:<path>", or "unix:@<name>" for an abstract address.
+     */
+    string to_string() const {
+        char buf[MAX_STR_LEN];
+        auto res = to_chars(buf, buf + sizeof(buf));
+        return string(buf, res.ptr);
+    }
+    /**
+     * Writes the address into a character buffer, in the same form as
+     * @ref to_string(), without allocating memory.
+     * The output is not NUL-terminated. A buffer of @ref MAX_STR_LEN
+     * characters is always large enough.
+     * @param first Pointer to the start of the buffer.
+     * @param last Pointer past the end of the buffer.
+     * @return The pointer past the last character written, and an error
+     *  	   of `std::errc::value_too_large` if the buffer was too small.
      */
-    string to_string() const { return string("unix:") + path(); }
+    std::to_chars_result to_chars(char* first, char* last) const noexcept;
 };
 
 // --------------------------------------------------------------------------
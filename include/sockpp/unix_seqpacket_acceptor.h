@@ -0,0 +1,141 @@
+/**
+ * @file unix_seqpacket_acceptor.h
+ *
+ * Class for a Unix-domain sequenced-packet server.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_unix_seqpacket_acceptor_h
+#define __sockpp_unix_seqpacket_acceptor_h
+
+#include "sockpp/acceptor.h"
+#include "sockpp/unix_seqpacket_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Class for creating a Unix-domain sequenced-packet server.
+ * Objects of this class bind and listen on Unix-domain addresses for
+ * connections, and each call to accept returns a @ref
+ * unix_seqpacket_socket for the new connection.
+ */
+class unix_seqpacket_acceptor : public acceptor
+{
+    /** The base class */
+    using base = acceptor;
+
+    // Non-copyable
+    unix_seqpacket_acceptor(const unix_seqpacket_acceptor&) = delete;
+    unix_seqpacket_acceptor& operator=(const unix_seqpacket_acceptor&) = delete;
+
+public:
+    /**
+     * Creates an unconnected acceptor.
+     */
+    unix_seqpacket_acceptor() {}
+    /**
+     * Creates an acceptor from an existing OS socket handle and claims
+     * ownership of the handle.
+     * @param handle A socket handle from the operating system.
+     */
+    explicit unix_seqpacket_acceptor(socket_t handle) noexcept : base(handle) {}
+    /**
+     * Creates a acceptor and starts it listening on the specified address.
+     * @param addr The address on which to listen.
+     * @param queSize The listener queue size.
+     * @throws std::system_error on failure
+     */
+    unix_seqpacket_acceptor(const unix_address& addr, int queSize = DFLT_QUE_SIZE) {
+        if (auto res = open(addr, queSize); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates a acceptor and starts it listening on the specified address.
+     * @param addr The address on which to listen.
+     * @param queSize The listener queue size.
+     * @param ec Gets the error code on failure
+     */
+    unix_seqpacket_acceptor(const unix_address& addr, int queSize, error_code& ec) noexcept {
+        ec = open(addr, queSize).error();
+    }
+    /**
+     * Gets the local address to which we are bound.
+     * @return The local address to which we are bound.
+     */
+    unix_address address() const { return unix_address(base::address()); }
+    /**
+     * Opens the acceptor socket and binds it to the specified address.
+     * @param addr The address to which this server should be bound.
+     * @param queSize The listener queue size.
+     * @param flags Options for the listening socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return The error code on failure.
+     */
+    result<> open(
+        const unix_address& addr, int queSize = DFLT_QUE_SIZE, int flags = 0
+    ) noexcept {
+        return do_open(addr, unix_seqpacket_socket::COMM_TYPE, queSize, 0, flags);
+    }
+    /**
+     * Accepts an incoming connection and gets the address of the client.
+     * @param clientAddr Pointer to the variable that will get the
+     *  				 address of a client when it connects.
+     * @param flags Options for the new socket. This can be any
+     *  			combination of @ref NON_BLOCKING and @ref CLOSE_ON_EXEC.
+     * @return A socket to the client.
+     */
+    result<unix_seqpacket_socket> accept(
+        unix_address* clientAddr = nullptr, int flags = 0
+    ) noexcept {
+        auto res = base::accept(clientAddr, flags);
+        if (!res)
+            return res.error();
+        return unix_seqpacket_socket{res.release().release()};
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_unix_seqpacket_acceptor_h
@@ -0,0 +1,232 @@
+/**
+ * @file unix_seqpacket_socket.h
+ *
+ * Classes for Unix-domain sequenced-packet sockets.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_unix_seqpacket_socket_h
+#define __sockpp_unix_seqpacket_socket_h
+
+#include <tuple>
+
+#include "sockpp/unix_stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Unix-domain sequenced-packet socket.
+ *
+ * This is a connection-oriented socket, like a stream, but the system
+ * keeps the boundaries of the messages. Each write is delivered as a
+ * single message, and each read gets exactly one message, so local
+ * protocols don't need any length framing of their own.
+ *
+ * Since a read never returns more than one message, @ref read_n() and
+ * @ref write_n() don't make much sense for this type of socket. A read
+ * with a buffer that is too small for the message silently discards the
+ * rest of it. Use @ref read_message() to treat that as an error.
+ *
+ * This is available on Linux and the BSD's, but not on macOS.
+ */
+class unix_seqpacket_socket : public unix_stream_socket
+{
+    /** The base class */
+    using base = unix_stream_socket;
+
+public:
+    /** The socket 'type' for communications semantics. */
+    static constexpr int COMM_TYPE = SOCK_SEQPACKET;
+
+    /** A pair of sequenced-packet sockets */
+    using socket_pair = std::tuple<unix_seqpacket_socket, unix_seqpacket_socket>;
+
+    /**
+     * Creates an unconnected socket.
+     */
+    unix_seqpacket_socket() {}
+    /**
+     * Creates a socket from an existing OS socket handle and claims
+     * ownership of the handle.
+     * @param handle A socket handle from the operating system.
+     */
+    explicit unix_seqpacket_socket(socket_t handle) : base(handle) {}
+    /**
+     * Move constructor.
+     * @param sock Another socket.
+     */
+    unix_seqpacket_socket(unix_seqpacket_socket&& sock) : base(std::move(sock)) {}
+    /**
+     * Move assignment.
+     * @param rhs The other socket to move into this one.
+     * @return A reference to this object.
+     */
+    unix_seqpacket_socket& operator=(unix_seqpacket_socket&& rhs) {
+        base::operator=(std::move(rhs));
+        return *this;
+    }
+    /**
+     * Creates an unconnected sequenced-packet socket.
+     * @return The socket on success, or the error code on failure.
+     */
+    static result<unix_seqpacket_socket> create() {
+        if (auto res = socket::create_handle(ADDRESS_FAMILY, COMM_TYPE); !res)
+            return res.error();
+        else
+            return unix_seqpacket_socket{res.value()};
+    }
+    /**
+     * Creates a pair of connected sequenced-packet sockets.
+     * @return A pair (std::tuple) of sockets on success, or the error code
+     *  	   on failure.
+     */
+    static result<socket_pair> pair() {
+        if (auto res = socket::pair(ADDRESS_FAMILY, COMM_TYPE); !res) {
+            return res.error();
+        }
+        else {
+            auto [s1, s2] = res.release();
+            return std::make_tuple<unix_seqpacket_socket, unix_seqpacket_socket>(
+                unix_seqpacket_socket{s1.release()}, unix_seqpacket_socket{s2.release()}
+            );
+        }
+    }
+    /**
+     * Reads a single message from the socket, failing if it doesn't fit
+     * into the buffer.
+     * @param buf Buffer to get the incoming message.
+     * @param n The number of bytes in the buffer.
+     * @param flags The flags for the receive.
+     * @return The number of bytes in the message, zero if the peer closed
+     *  	   the connection, or the error code on failure. This fails with
+     *  	   `errc::message_size` if the message was truncated, in which
+     *  	   case the rest of it is lost.
+     */
+    result<size_t> read_message(void* buf, size_t n, int flags = 0) {
+        iovec iov{buf, n};
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        auto res = recv_msg(msg, flags);
+        if (res && (msg.msg_flags & MSG_TRUNC))
+            return errc::message_size;
+        return res;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Unix-domain sequenced-packet connector.
+ * This is a sequenced-packet socket that initiates a connection to a
+ * server, such as a @ref unix_seqpacket_acceptor.
+ */
+class unix_seqpacket_connector : public unix_seqpacket_socket
+{
+    /** The base class */
+    using base = unix_seqpacket_socket;
+
+public:
+    /**
+     * Creates an unconnected connector.
+     */
+    unix_seqpacket_connector() {}
+    /**
+     * Creates the connector and attempts to connect to the specified
+     * address.
+     * @param addr The remote server address.
+     * @throws std::system_error on failure
+     */
+    unix_seqpacket_connector(const unix_address& addr) {
+        if (auto res = connect(addr); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates the connector and attempts to connect to the specified
+     * address.
+     * @param addr The remote server address.
+     * @param ec The error code on failure.
+     */
+    unix_seqpacket_connector(const unix_address& addr, error_code& ec) noexcept {
+        ec = connect(addr).error();
+    }
+    /**
+     * Move constructor.
+     * @param conn Another connector.
+     */
+    unix_seqpacket_connector(unix_seqpacket_connector&& conn) : base(std::move(conn)) {}
+    /**
+     * Move assignment.
+     * @param rhs The other connector to move into this one.
+     * @return A reference to this object.
+     */
+    unix_seqpacket_connector& operator=(unix_seqpacket_connector&& rhs) {
+        base::operator=(std::move(rhs));
+        return *this;
+    }
+    /**
+     * Connects to the server at the specified address.
+     * Any previous connection is closed and a new socket is created.
+     * @param addr The remote server address.
+     * @return The error code on failure.
+     */
+    result<> connect(const unix_address& addr) noexcept {
+        auto res = socket::create_handle(ADDRESS_FAMILY, COMM_TYPE);
+        if (!res)
+            return res.error();
+
+        stream_socket sock{res.value()};
+        if (::connect(sock.handle(), addr.sockaddr_ptr(), addr.size()) < 0)
+            return result<>::from_last_error();
+
+        base::operator=(base{sock.release()});
+        return none{};
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_unix_seqpacket_socket_h
@@ -0,0 +1,432 @@
+/**
+ * @file uring.h
+ *
+ * Linux io_uring completion engine for batched socket I/O.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_uring_h
+#define __sockpp_uring_h
+
+#include <linux/io_uring.h>
+
+#include <cstdint>
+
+#include "sockpp/acceptor.h"
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An io_uring submission/completion queue pair for asynchronous socket I/O.
+ *
+ * This is an opt-in, Linux-only alternative to making one system call per
+ * read, write, or accept. Operations are queued into the submission ring
+ * with the "prep" functions (@ref recv(), @ref send(), @ref accept(),
+ * @ref connect(), etc), which do not enter the kernel. They are then
+ * submitted as a batch with @ref submit() or @ref wait(), and their
+ * completions reaped in batches.
+ *
+ * Each operation is tagged with a 64-bit user value that is returned in
+ * its completion. The caller must keep any buffers and addresses passed to
+ * an operation valid until its completion is reaped.
+ *
+ * The multishot variants of accept and receive post a completion for every
+ * new connection or incoming message from a single submission. Multishot
+ * receives take their buffers from a @ref uring_buffer_ring registered
+ * with the ring.
+ *
+ * The ring is implemented directly on top of the kernel system calls, so
+ * it has no dependency on liburing. It's not thread-safe. It should be
+ * owned by a single event-loop thread.
+ */
+class uring
+{
+public:
+    /** The default number of submission queue entries */
+    static constexpr unsigned DFLT_ENTRIES = 256;
+
+    /**
+     * The completion of an operation.
+     */
+    struct completion
+    {
+        /** The user value from the submitted operation */
+        uint64_t user_data;
+        /** The result. Non-negative on success, or a negated errno */
+        int32_t res;
+        /** The completion flags (IORING_CQE_F_...) */
+        uint32_t flags;
+
+        /**
+         * Determines if more completions will follow for a multishot
+         * operation.
+         */
+        bool more() const { return (flags & IORING_CQE_F_MORE) != 0; }
+        /**
+         * Determines if a buffer was selected from a buffer ring.
+         */
+        bool has_buffer() const { return (flags & IORING_CQE_F_BUFFER) != 0; }
+        /**
+         * Gets the ID of the selected buffer, if @ref has_buffer() is
+         * true.
+         */
+        uint16_t buffer_id() const { return uint16_t(flags >> IORING_CQE_BUFFER_SHIFT); }
+        /**
+         * Gets the result of the operation as a sockpp result.
+         * @return The non-negative value of the operation on success, or
+         *  	   an error code on failure.
+         */
+        result<size_t> get() const {
+            if (res < 0)
+                return result<size_t>::from_error(-res);
+            return size_t(res);
+        }
+    };
+
+private:
+    /** The ring file descriptor */
+    int fd_{-1};
+    /** The features reported by the kernel */
+    uint32_t features_{0};
+
+    /** The mapped submission queue ring */
+    void* sq_ptr_{nullptr};
+    /** The size of the submission queue ring mapping */
+    size_t sq_sz_{0};
+    /** The mapped completion queue ring (possibly the same as the SQ) */
+    void* cq_ptr_{nullptr};
+    /** The size of the completion queue ring mapping */
+    size_t cq_sz_{0};
+    /** The mapped array of submission queue entries */
+    io_uring_sqe* sqes_{nullptr};
+    /** The size of the SQE array mapping */
+    size_t sqes_sz_{0};
+
+    // Pointers into the submission ring
+    unsigned *sq_head_{nullptr}, *sq_tail_{nullptr}, *sq_array_{nullptr};
+    unsigned sq_mask_{0}, sq_entries_{0};
+    /** The local, not yet published, submission tail */
+    unsigned sq_local_tail_{0};
+    /** The number of entries prepared but not yet submitted */
+    unsigned sq_pending_{0};
+
+    // Pointers into the completion ring
+    unsigned *cq_head_{nullptr}, *cq_tail_{nullptr};
+    unsigned cq_mask_{0};
+    io_uring_cqe* cqes_{nullptr};
+
+    // Non-copyable
+    uring(const uring&) = delete;
+    uring& operator=(const uring&) = delete;
+
+    /** Sets up the ring */
+    error_code init(unsigned entries) noexcept;
+    /** Unmaps the rings and closes the file descriptor */
+    void cleanup() noexcept;
+    /**
+     * Gets the next free submission queue entry, cleared to zero.
+     * If the queue is full, this submits the pending entries first.
+     */
+    result<io_uring_sqe*> get_sqe() noexcept;
+    /** Calls io_uring_enter() */
+    result<size_t> enter(unsigned toSubmit, unsigned minComplete, milliseconds timeout);
+
+public:
+    /**
+     * Creates a ring with the requested number of submission entries.
+     * @param entries The size of the submission queue. The kernel rounds
+     *  			  this up to a power of two.
+     * @throws std::system_error on failure.
+     */
+    explicit uring(unsigned entries = DFLT_ENTRIES);
+    /**
+     * Creates a ring with the requested number of submission entries.
+     * @param entries The size of the submission queue.
+     * @param ec Gets the error code on failure.
+     */
+    uring(unsigned entries, error_code& ec) noexcept;
+    /**
+     * Destructor releases the ring.
+     * Any operations still in flight are cancelled by the kernel.
+     */
+    ~uring();
+    /**
+     * Determines if the ring was successfully created.
+     */
+    bool is_open() const { return fd_ >= 0; }
+    /**
+     * Gets the ring's file descriptor.
+     */
+    int handle() const { return fd_; }
+    /**
+     * Gets the feature flags (IORING_FEAT_...) reported by the kernel.
+     */
+    uint32_t features() const { return features_; }
+    /**
+     * Gets the number of operations prepared, but not yet submitted.
+     */
+    unsigned pending() const { return sq_pending_; }
+
+    // ----- Operations -----
+
+    /**
+     * Queues a receive on a socket.
+     * @param sock The socket to read.
+     * @param buf The buffer to receive the data.
+     * @param n The size of the buffer.
+     * @param userData The user value for the completion.
+     * @param flags The recv(2) flags.
+     * @return The error code on failure.
+     */
+    result<> recv(const socket& sock, void* buf, size_t n, uint64_t userData, int flags = 0);
+    /**
+     * Queues a receive on a socket, taking the buffer from a registered
+     * buffer ring. The completion reports the ID of the buffer used.
+     * @param sock The socket to read.
+     * @param bufGroup The group ID of the buffer ring.
+     * @param userData The user value for the completion.
+     * @param multishot Whether the receive should remain armed,
+     *  				producing a completion for each incoming chunk of
+     *  				data.
+     * @return The error code on failure.
+     */
+    result<> recv_select(
+        const socket& sock, uint16_t bufGroup, uint64_t userData, bool multishot = true
+    );
+    /**
+     * Queues a send on a socket.
+     * @param sock The socket to write.
+     * @param buf The buffer with the data to send.
+     * @param n The number of bytes to send.
+     * @param userData The user value for the completion.
+     * @param flags The send(2) flags.
+     * @return The error code on failure.
+     */
+    result<> send(
+        const socket& sock, const void* buf, size_t n, uint64_t userData, int flags = 0
+    );
+    /**
+     * Queues an accept on a listening socket.
+     * The completion value is the handle of the new socket.
+     * @param acc The acceptor.
+     * @param userData The user value for the completion.
+     * @param addr Optional address to receive the peer address. This must
+     *  		   remain valid until the completion is reaped.
+     * @param len If an address is given, this must be initialized to its
+     *  		  size, and must remain valid until completion.
+     * @return The error code on failure.
+     */
+    result<> accept(
+        const acceptor& acc, uint64_t userData, sock_address* addr = nullptr,
+        socklen_t* len = nullptr
+    );
+    /**
+     * Queues a multishot accept on a listening socket.
+     * This produces a completion for each new connection, with the handle
+     * of the new socket, until it is cancelled or fails.
+     * @param acc The acceptor.
+     * @param userData The user value for the completions.
+     * @return The error code on failure.
+     */
+    result<> accept_multishot(const acceptor& acc, uint64_t userData);
+    /**
+     * Queues a connect on a socket.
+     * @param sock An open, unconnected socket.
+     * @param addr The address of the server. This must remain valid until
+     *  		   the completion is reaped.
+     * @param userData The user value for the completion.
+     * @return The error code on failure.
+     */
+    result<> connect(const socket& sock, const sock_address& addr, uint64_t userData);
+    /**
+     * Queues an asynchronous close of a socket handle.
+     * The ring takes ownership of the handle, which is closed by the
+     * kernel when the operation runs. This is useful for closing the
+     * handles taken from a @ref close_queue as a single batch.
+     * @param h The handle to close.
+     * @param userData The user value for the completion.
+     * @return The error code on failure. On failure, the handle is still
+     *  	   owned by the caller.
+     */
+    result<> close(socket_t h, uint64_t userData);
+    /**
+     * Queues an asynchronous close of a socket.
+     * On success, the socket's handle is released to the ring, and the
+     * socket object is left closed.
+     * @param sock The socket to close.
+     * @param userData The user value for the completion.
+     * @return The error code on failure.
+     */
+    result<> close(socket&& sock, uint64_t userData) {
+        auto res = close(sock.handle(), userData);
+        if (res)
+            sock.release();
+        return res;
+    }
+    /**
+     * Queues a request to cancel a previously submitted operation.
+     * @param target The user value of the operation to cancel.
+     * @param userData The user value for this cancel operation.
+     * @return The error code on failure.
+     */
+    result<> cancel(uint64_t target, uint64_t userData = 0);
+
+    // ----- Submission and completion -----
+
+    /**
+     * Submits all of the prepared operations to the kernel.
+     * @return The number of operations submitted, or an error code on
+     *  	   failure.
+     */
+    result<size_t> submit();
+    /**
+     * Retrieves any available completions without blocking.
+     * @param evts Array to receive the completions.
+     * @param maxEvts The maximum number of completions to retrieve.
+     * @return The number of completions retrieved.
+     */
+    size_t reap(completion* evts, size_t maxEvts) noexcept;
+    /**
+     * Submits all of the prepared operations and waits for completions.
+     * @param evts Array to receive the completions.
+     * @param maxEvts The maximum number of completions to retrieve.
+     * @param timeout The maximum amount of time to wait for at least one
+     *  			  completion. A negative value waits forever.
+     * If completions are already waiting, they are returned without
+     * blocking. A failure to submit in that case is reported by the next
+     * call.
+     * @return The number of completions retrieved, which will be zero on
+     *  	   a timeout, or an error code on failure.
+     */
+    result<size_t> wait(
+        completion* evts, size_t maxEvts, milliseconds timeout = milliseconds{-1}
+    );
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A ring of provided buffers registered with an io_uring.
+ *
+ * Receive operations that select a buffer from the group take one from the
+ * ring when data arrives, rather than the application having to dedicate
+ * a buffer to each pending read. Once the application is done with the
+ * data, it gives the buffer back with @ref recycle().
+ */
+class uring_buffer_ring
+{
+    /** The ring with which the buffers are registered */
+    uring* ring_{nullptr};
+    /** The group ID for the buffers */
+    uint16_t bgid_{0};
+    /** The number of buffers (a power of two) */
+    unsigned nbuf_{0};
+    /** The size of each buffer */
+    size_t bufSz_{0};
+    /** The shared ring structure */
+    io_uring_buf_ring* br_{nullptr};
+    /** The size of the ring mapping */
+    size_t brSz_{0};
+    /** The memory for the buffers */
+    uint8_t* mem_{nullptr};
+    /** The size of the buffer memory mapping */
+    size_t memSz_{0};
+    /** The local tail, published on commit */
+    uint16_t tail_{0};
+
+    // Non-copyable
+    uring_buffer_ring(const uring_buffer_ring&) = delete;
+    uring_buffer_ring& operator=(const uring_buffer_ring&) = delete;
+
+    /** Adds a buffer to the ring, without publishing it. */
+    void add(uint16_t bid) noexcept;
+    /** Publishes the buffers that were added */
+    void commit() noexcept;
+
+public:
+    /**
+     * Creates a buffer ring and registers it with an io_uring.
+     * @param ring The io_uring.
+     * @param bgid The buffer group ID used to select from this ring.
+     * @param nbuf The number of buffers. This must be a power of two, no
+     *  		   greater than 32768.
+     * @param bufSz The size of each buffer.
+     * @param ec Gets the error code on failure.
+     */
+    uring_buffer_ring(
+        uring& ring, uint16_t bgid, unsigned nbuf, size_t bufSz, error_code& ec
+    ) noexcept;
+    /**
+     * Destructor unregisters the ring and frees the buffers.
+     */
+    ~uring_buffer_ring();
+    /**
+     * Gets the buffer group ID.
+     */
+    uint16_t group_id() const { return bgid_; }
+    /**
+     * Gets the size of each buffer.
+     */
+    size_t buffer_size() const { return bufSz_; }
+    /**
+     * Gets a pointer to the buffer with the specified ID.
+     * @param bid The buffer ID, normally taken from a completion.
+     * @return A pointer to the buffer.
+     */
+    uint8_t* buffer(uint16_t bid) const { return mem_ + size_t(bid) * bufSz_; }
+    /**
+     * Returns a buffer to the ring so that it can be used again.
+     * @param bid The buffer ID.
+     */
+    void recycle(uint16_t bid) noexcept {
+        add(bid);
+        commit();
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_uring_h
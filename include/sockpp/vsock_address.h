@@ -0,0 +1,228 @@
+/**
+ * @file vsock_address.h
+ *
+ * Address class for Linux VM sockets (AF_VSOCK).
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_vsock_address_h
+#define __sockpp_vsock_address_h
+
+// <linux/vm_sockets.h> needs the socket types to be defined first.
+#include <sys/socket.h>
+//
+#include <linux/vm_sockets.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "sockpp/platform.h"
+#include "sockpp/result.h"
+#include "sockpp/sock_address.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Class that represents a Linux VM socket (vsock) address.
+ * This inherits from the VM form of a socket address, @em sockaddr_vm.
+ *
+ * A vsock address is a context ID (CID), which identifies a virtual
+ * machine or the host, and a 32-bit port. The host is always
+ * @ref HOST_CID, and each guest gets its own CID from the hypervisor. VM
+ * sockets go directly through the hypervisor's virtio transport, so they
+ * don't need a network interface or IP configuration in the guest, and
+ * are much cheaper than a virtual network device.
+ */
+class vsock_address : public sock_address
+{
+    /** The underlying C struct for vsock addresses */
+    sockaddr_vm addr_{};
+
+    /** The size of the underlying address struct, in bytes */
+    static constexpr size_t SZ = sizeof(sockaddr_vm);
+
+public:
+    /** The address family for this type of address */
+    static constexpr sa_family_t ADDRESS_FAMILY = AF_VSOCK;
+
+    /** The CID to bind to, to accept connections from any VM or the host */
+    static constexpr uint32_t ANY_CID = VMADDR_CID_ANY;
+    /** The CID for the hypervisor */
+    static constexpr uint32_t HYPERVISOR_CID = 0;
+    /** The CID for local communication (loopback) within a machine */
+    static constexpr uint32_t LOCAL_CID = 1;
+    /** The CID of the host, as seen from a guest */
+    static constexpr uint32_t HOST_CID = 2;
+    /** The port to bind to, to get any free port */
+    static constexpr uint32_t ANY_PORT = VMADDR_PORT_ANY;
+
+    /**
+     * Constructs an empty address.
+     * The address is initialized to all zeroes.
+     */
+    vsock_address() = default;
+    /**
+     * Constructs an address for any CID with the specified port.
+     * This is normally used to bind a server.
+     * @param port The port.
+     */
+    explicit vsock_address(uint32_t port) noexcept : vsock_address(ANY_CID, port) {}
+    /**
+     * Constructs an address from a CID and port.
+     * @param cid The context ID of the VM or host.
+     * @param port The port.
+     */
+    vsock_address(uint32_t cid, uint32_t port) noexcept {
+        addr_.svm_family = ADDRESS_FAMILY;
+        addr_.svm_cid = cid;
+        addr_.svm_port = port;
+    }
+    /**
+     * Constructs the address by copying the specified structure.
+     * @param addr The generic address. This must be an AF_VSOCK address to
+     *  		   be a valid vsock address.
+     */
+    explicit vsock_address(const sockaddr& addr) noexcept {
+        std::memcpy(&addr_, &addr, sizeof(sockaddr));
+    }
+    /**
+     * Constructs the address by copying the specified structure.
+     * @param addr The other address. This must be an AF_VSOCK address to
+     *  		   be a valid vsock address.
+     */
+    vsock_address(const sock_address& addr) noexcept {
+        std::memcpy(&addr_, addr.sockaddr_ptr(), SZ);
+    }
+    /**
+     * Constructs the address by copying the specified structure.
+     * @param addr The other address.
+     */
+    vsock_address(const sockaddr_vm& addr) noexcept : addr_(addr) {}
+    /**
+     * Constructs the address by copying the specified address.
+     * @param addr The other address.
+     */
+    vsock_address(const vsock_address& addr) noexcept : addr_(addr.addr_) {}
+    /**
+     * Copies another address to this one.
+     * @param rhs The other address
+     * @return A reference to this object.
+     */
+    vsock_address& operator=(const vsock_address& rhs) = default;
+    /**
+     * Gets the CID of the machine that the application is running on.
+     * In a guest, this is the CID assigned to it by the hypervisor.
+     * @return The local CID on success, or an error code on failure, such
+     *  	   as when the vsock driver isn't loaded.
+     */
+    static result<uint32_t> local_cid();
+    /**
+     * Checks if the address is set to some value.
+     * This doesn't attempt to determine if the address is valid, simply
+     * that it's a vsock-family address.
+     * @return @em true if the address has been set, @em false otherwise.
+     */
+    bool is_set() const noexcept override { return addr_.svm_family == ADDRESS_FAMILY; }
+    /**
+     * Gets the context ID (CID).
+     * @return The context ID.
+     */
+    uint32_t cid() const noexcept { return addr_.svm_cid; }
+    /**
+     * Gets the port.
+     * @return The port.
+     */
+    uint32_t port() const noexcept { return addr_.svm_port; }
+    /**
+     * Gets the size of the address structure.
+     * @return The size of the address structure.
+     */
+    socklen_t size() const override { return socklen_t(SZ); }
+    /**
+     * Gets a pointer to this object cast to a const @em sockaddr.
+     * @return A pointer to this object cast to a const @em sockaddr.
+     */
+    const sockaddr* sockaddr_ptr() const override {
+        return reinterpret_cast<const sockaddr*>(&addr_);
+    }
+    /**
+     * Gets a pointer to this object cast to a @em sockaddr.
+     * @return A pointer to this object cast to a @em sockaddr.
+     */
+    sockaddr* sockaddr_ptr() override { return reinterpret_cast<sockaddr*>(&addr_); }
+    /**
+     * Gets a const pointer to this object cast to a @em sockaddr_vm.
+     * @return const sockaddr_vm pointer to this object.
+     */
+    const sockaddr_vm* sockaddr_vm_ptr() const noexcept { return &addr_; }
+    /**
+     * Gets a pointer to this object cast to a @em sockaddr_vm.
+     * @return sockaddr_vm pointer to this object.
+     */
+    sockaddr_vm* sockaddr_vm_ptr() noexcept { return &addr_; }
+    /**
+     * Gets a printable string for the address.
+     * @return A string representation of the address in the form
+     *  	   "vsock:<cid>:<port>". The "any" values are shown as -1.
+     */
+    string to_string() const;
+};
+
+// --------------------------------------------------------------------------
+
+/**
+ * Stream inserter for the address.
+ * @param os The output stream
+ * @param addr The address
+ * @return A reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const vsock_address& addr);
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_vsock_address_h
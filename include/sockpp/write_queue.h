@@ -0,0 +1,309 @@
+/**
+ * @file write_queue.h
+ *
+ * An outbound queue for a stream socket that coalesces small writes.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_write_queue_h
+#define __sockpp_write_queue_h
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "sockpp/buffer_pool.h"
+#include "sockpp/pacer.h"
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A queue of outgoing data for a stream socket, which is sent with gather
+ * writes.
+ *
+ * Each message pushed onto the queue is held until the next flush, which
+ * sends everything queued with as few `writev()` calls as possible. This
+ * turns many small writes into one system call, and, with Nagle's
+ * algorithm off, into full-sized packets. Small messages are copied into
+ * a shared chunk as they're pushed, so that they take up a single I/O
+ * vector. Larger ones are queued in place: an owned string is moved in,
+ * and a ref-counted or pooled buffer is held until it's sent.
+ *
+ * The queue flushes itself when the amount of data passes a threshold.
+ * Otherwise the application flushes it, typically once per iteration of
+ * its event loop, such as from the @ref reactor::on_tick() handler.
+ *
+ * To keep memory bounded when the peer is slow, the queue has high and
+ * low watermarks. Once the queued data reaches the high mark, the queue
+ * is @em paused: pushes fail with `errc::no_buffer_space` until flushes
+ * bring it back down to the low mark. An optional callback is told each
+ * time the queue pauses and resumes, so producers can stop and start.
+ *
+ * On a non-blocking socket, a flush sends what it can and leaves the rest
+ * queued. The application should then wait for the socket to be writable
+ * and flush again.
+ *
+ * A @ref pacer can be attached to limit the rate at which the queue is
+ * sent. A flush then sends only as much as the pacer allows, and the
+ * application flushes again after the pacer's @ref pacer::delay(), as
+ * given by @ref flush_delay().
+ *
+ * The queue refers to the socket, but does not own it. It isn't thread
+ * safe; all the producers must run on the thread that owns the queue.
+ */
+class write_queue
+{
+public:
+    /** The default amount of queued data that triggers a flush */
+    static constexpr size_t DFLT_FLUSH_THRESHOLD = 64 * 1024;
+    /** The default amount of queued data that pauses the queue */
+    static constexpr size_t DFLT_HIGH_WATERMARK = 1024 * 1024;
+    /** The default amount of queued data that resumes the queue */
+    static constexpr size_t DFLT_LOW_WATERMARK = 256 * 1024;
+    /** Messages up to this size are copied into a shared chunk */
+    static constexpr size_t COPY_THRESHOLD = 512;
+    /** The size of the chunks that hold copied messages */
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+    /**
+     * The type of function called when the queue pauses or resumes.
+     * The argument is @em true when the queue pauses, and @em false when
+     * it resumes.
+     */
+    using backpressure_handler = std::function<void(bool paused)>;
+
+private:
+    /** A contiguous block of queued data */
+    struct segment
+    {
+        /** Holds the memory, if it isn't owned by `str` */
+        std::shared_ptr<const void> keep;
+        /** Owned data, and the chunk for copied messages */
+        std::string str;
+        /** The start of the unsent data */
+        const char* data{nullptr};
+        /** The number of unsent bytes */
+        size_t len{0};
+        /** Whether more small messages can be copied onto the end */
+        bool open{false};
+    };
+
+    /** The socket being written */
+    stream_socket& sock_;
+    /** The queued data, oldest first */
+    std::deque<segment> segs_;
+    /** The total number of queued bytes */
+    size_t size_{0};
+    /** The amount of data that triggers a flush */
+    size_t flushThreshold_;
+    /** The amount of data that pauses the queue */
+    size_t highMark_;
+    /** The amount of data that resumes the queue */
+    size_t lowMark_;
+    /** Whether the queue is paused */
+    bool paused_{false};
+    /** Called when the queue pauses or resumes */
+    backpressure_handler handler_;
+    /** Limits the rate of the flushes, if set */
+    pacer* pacer_{nullptr};
+
+    /**
+     * Adds a segment that refers to memory owned elsewhere.
+     */
+    result<> push_segment(std::shared_ptr<const void> keep, const void* buf, size_t n);
+    /**
+     * Accounts for newly-queued data, and flushes if past the threshold.
+     */
+    result<> queued(size_t n);
+    /**
+     * Pauses or resumes the queue, if the size crossed a watermark.
+     */
+    void update_pause();
+
+    // Non-copyable
+    write_queue(const write_queue&) = delete;
+    write_queue& operator=(const write_queue&) = delete;
+
+public:
+    /**
+     * Creates an outbound queue for a socket.
+     * @param sock The socket to write. It must outlive the queue.
+     * @param flushThreshold The amount of queued data that triggers a
+     *  					 flush.
+     * @param highMark The amount of queued data that pauses the queue.
+     * @param lowMark The amount of queued data that resumes the queue.
+     */
+    explicit write_queue(
+        stream_socket& sock, size_t flushThreshold = DFLT_FLUSH_THRESHOLD,
+        size_t highMark = DFLT_HIGH_WATERMARK, size_t lowMark = DFLT_LOW_WATERMARK
+    );
+    /**
+     * Gets the socket being written.
+     * @return A reference to the socket being written.
+     */
+    stream_socket& sock() { return sock_; }
+    /**
+     * Gets the number of bytes waiting to be sent.
+     * @return The number of bytes waiting to be sent.
+     */
+    size_t size() const { return size_; }
+    /**
+     * Determines if there is no data waiting to be sent.
+     * @return @em true if there is no data waiting to be sent.
+     */
+    bool empty() const { return size_ == 0; }
+    /**
+     * Gets the number of I/O vectors that the queued data occupies.
+     * @return The number of I/O vectors that the queued data occupies.
+     */
+    size_t segments() const { return segs_.size(); }
+    /**
+     * Determines if the queue is paused, and won't take more data.
+     * @return @em true if the queue is paused.
+     */
+    bool paused() const { return paused_; }
+    /**
+     * Gets the amount of queued data that pauses the queue.
+     * @return The amount of queued data that pauses the queue.
+     */
+    size_t high_watermark() const { return highMark_; }
+    /**
+     * Gets the amount of queued data that resumes the queue.
+     * @return The amount of queued data that resumes the queue.
+     */
+    size_t low_watermark() const { return lowMark_; }
+    /**
+     * Sets a function to call when the queue pauses or resumes.
+     * @param fn The function, or an empty function for none.
+     */
+    void on_backpressure(backpressure_handler fn) { handler_ = std::move(fn); }
+    /**
+     * Sets a pacer to limit the rate at which the queue is sent.
+     * @param pc The pacer, which must outlive the queue, or @em nullptr to
+     *  		 send at full speed.
+     */
+    void set_pacer(pacer* pc) { pacer_ = pc; }
+    /**
+     * Gets the pacer that limits the rate at which the queue is sent.
+     * @return The pacer, or @em nullptr if there isn't one.
+     */
+    pacer* get_pacer() const { return pacer_; }
+    /**
+     * Gets the time until the pacer allows the next flush to send
+     * something.
+     * @return The time to wait before flushing. This is zero if there's no
+     *  	   pacer, or nothing is queued.
+     */
+    nanoseconds flush_delay() const {
+        return (pacer_ && size_ != 0) ? pacer_->delay(size_) : nanoseconds{0};
+    }
+    /**
+     * Queues a copy of a message.
+     * @param buf The message.
+     * @param n The size of the message.
+     * @return The error code on failure. This is `errc::no_buffer_space`
+     *  	   if the queue is paused, or an error from the socket if the
+     *  	   push triggered a flush that failed.
+     */
+    result<> push(const void* buf, size_t n);
+    /**
+     * Queues a message, taking ownership of it.
+     * @param s The message.
+     * @return The error code on failure.
+     */
+    result<> push(std::string&& s);
+    /**
+     * Queues a copy of a message.
+     * @param s The message.
+     * @return The error code on failure.
+     */
+    result<> push(const std::string& s) { return push(s.data(), s.size()); }
+    /**
+     * Queues a message in memory that's shared with the caller.
+     * The memory is kept alive until it has been sent.
+     * @param keep A reference to the owner of the memory.
+     * @param buf The start of the message.
+     * @param n The size of the message.
+     * @return The error code on failure.
+     */
+    result<> push(std::shared_ptr<const void> keep, const void* buf, size_t n);
+    /**
+     * Queues a message held in a ref-counted string.
+     * @param s The message.
+     * @return The error code on failure.
+     */
+    result<> push(std::shared_ptr<const std::string> s) {
+        auto p = s->data();
+        auto n = s->size();
+        return push(std::move(s), p, n);
+    }
+    /**
+     * Queues a message in a buffer from a pool.
+     * The buffer returns to the pool once it's been sent.
+     * @param buf The message.
+     * @return The error code on failure.
+     */
+    result<> push(pooled_buffer&& buf);
+    /**
+     * Sends as much of the queued data as the socket will take.
+     *
+     * This keeps writing until the queue is empty, the socket would block,
+     * or the pacer, if there is one, runs out of credit. A would-block is
+     * not an error.
+     *
+     * @return The number of bytes sent, or the error code on failure.
+     */
+    result<size_t> flush();
+    /**
+     * Discards all the queued data.
+     */
+    void clear();
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_write_queue_h
@@ -0,0 +1,428 @@
+/**
+ * @file xdp_socket.h
+ *
+ * Class for Linux AF_XDP sockets, for kernel-bypass packet I/O.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_xdp_socket_h
+#define __sockpp_xdp_socket_h
+
+#include <linux/if_xdp.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sockpp/socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The sizes of the memory and rings for an AF_XDP socket.
+ */
+struct xdp_params
+{
+    /** The size of each frame in the UMEM. Normally 2048 or 4096. */
+    uint32_t frame_size{4096};
+    /** The number of frames in the UMEM, shared by receive and transmit */
+    uint32_t frame_count{4096};
+    /** The number of entries in each ring. This must be a power of two. */
+    uint32_t ring_size{2048};
+    /** The space reserved in front of each received packet */
+    uint32_t headroom{0};
+    /**
+     * The bind flags, like XDP_COPY or XDP_ZEROCOPY to force a mode. The
+     * default lets the kernel pick, and only wakes it up when it asks.
+     */
+    uint16_t bind_flags{XDP_USE_NEED_WAKEUP};
+};
+
+namespace detail {
+
+/**
+ * One of the single-producer, single-consumer rings that an AF_XDP socket
+ * shares with the kernel.
+ *
+ * The fill and transmit rings are produced by the application. The
+ * receive and completion rings are consumed by it. The indexes are free
+ * running, and kept in local copies, so that the shared ones are only
+ * touched once per batch.
+ */
+struct xdp_ring
+{
+    /** The shared producer index */
+    uint32_t* producer{nullptr};
+    /** The shared consumer index */
+    uint32_t* consumer{nullptr};
+    /** The shared ring flags, like XDP_RING_NEED_WAKEUP */
+    uint32_t* flags{nullptr};
+    /** The array of ring entries */
+    void* entries{nullptr};
+    /** The number of entries, less one */
+    uint32_t mask{0};
+    /** The number of entries */
+    uint32_t size{0};
+    /** The local producer index */
+    uint32_t cached_prod{0};
+    /** The local consumer index */
+    uint32_t cached_cons{0};
+    /** The ring mapping */
+    void* map{nullptr};
+    /** The size of the ring mapping */
+    size_t map_size{0};
+
+    /** Gets the entry at the free-running index */
+    template <typename T>
+    T& at(uint32_t idx) const {
+        return static_cast<T*>(entries)[idx & mask];
+    }
+    /**
+     * Consumer: claims up to @a n filled entries, starting at @a idx.
+     * @return The number of entries claimed.
+     */
+    uint32_t peek(uint32_t n, uint32_t& idx) noexcept {
+        uint32_t avail = cached_prod - cached_cons;
+        if (avail == 0) {
+            cached_prod = __atomic_load_n(producer, __ATOMIC_ACQUIRE);
+            avail = cached_prod - cached_cons;
+        }
+        if (n > avail)
+            n = avail;
+        idx = cached_cons;
+        cached_cons += n;
+        return n;
+    }
+    /** Consumer: gives the claimed entries back to the producer */
+    void release() noexcept { __atomic_store_n(consumer, cached_cons, __ATOMIC_RELEASE); }
+    /**
+     * Producer: claims @a n free entries, starting at @a idx.
+     * @return @a n, or zero if there isn't that much room.
+     */
+    uint32_t reserve(uint32_t n, uint32_t& idx) noexcept {
+        if (cached_cons + size - cached_prod < n) {
+            cached_cons = __atomic_load_n(consumer, __ATOMIC_ACQUIRE);
+            if (cached_cons + size - cached_prod < n)
+                return 0;
+        }
+        idx = cached_prod;
+        cached_prod += n;
+        return n;
+    }
+    /** Producer: publishes the reserved entries to the consumer */
+    void submit() noexcept { __atomic_store_n(producer, cached_prod, __ATOMIC_RELEASE); }
+    /** Determines if the kernel asked to be woken up for this ring */
+    bool needs_wakeup() const noexcept {
+        return (__atomic_load_n(flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP) != 0;
+    }
+};
+
+}  // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A view of a packet in the memory shared with the kernel.
+ * The data is only valid for the duration of the receive callback.
+ */
+class xdp_frame
+{
+    /** The packet data */
+    uint8_t* data_;
+    /** The size of the packet */
+    size_t len_;
+
+public:
+    /**
+     * Creates a view of a packet.
+     * @param data The packet data.
+     * @param len The size of the packet.
+     */
+    xdp_frame(uint8_t* data, size_t len) : data_{data}, len_{len} {}
+    /**
+     * Gets the packet data. It can be modified in place.
+     * @return A pointer to the start of the link-layer packet.
+     */
+    uint8_t* data() const { return data_; }
+    /**
+     * Gets the size of the packet.
+     * @return The size of the packet, in bytes.
+     */
+    size_t size() const { return len_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Linux AF_XDP socket, for kernel-bypass packet I/O.
+ *
+ * An XDP socket is bound to a single queue of a network interface. Packets
+ * are moved in and out through a region of user memory, the UMEM, that is
+ * shared with the kernel and possibly the NIC, and four rings:
+ *
+ * @li The fill ring gives empty UMEM frames to the kernel for receiving.
+ * @li The receive ring hands back frames holding the received packets.
+ * @li The transmit ring passes frames with packets to send.
+ * @li The completion ring returns frames once they've been sent.
+ *
+ * This class manages all of that. Received packets are read in batches
+ * with @ref recv(), as views into the UMEM, and their frames are given
+ * straight back to the fill ring. Outgoing packets are copied into free
+ * frames with @ref tx_queue() and sent as a batch by @ref tx_flush().
+ *
+ * The kernel only delivers the packets that an XDP program attached to
+ * the interface redirects into the socket, through an XSKMAP. Loading the
+ * program is left to the application, which then registers the socket in
+ * its map with @ref register_in_map(). Any packets that aren't redirected
+ * go up the normal network stack, so the regular @ref udp_socket and
+ * @ref datagram_socket API's remain available for the rest of the traffic,
+ * or as a fallback where XDP isn't available.
+ *
+ * Opening an XDP socket requires the CAP_NET_RAW capability. It's not
+ * thread-safe. Use one socket per queue, each owned by a single thread.
+ */
+class xdp_socket : public socket
+{
+    /** The base class */
+    using base = socket;
+
+    /** The shared packet memory */
+    uint8_t* umem_{nullptr};
+    /** The size of the shared memory */
+    size_t umemSize_{0};
+    /** The size of each frame */
+    uint32_t frameSize_{0};
+    /** The interface queue to which the socket is bound */
+    uint32_t queue_{0};
+    /** Whether the kernel only needs a wakeup when it asks for one */
+    bool needWakeup_{false};
+
+    /** The rings */
+    detail::xdp_ring fill_, comp_, rx_, tx_;
+
+    /** The frames that are free for transmitting */
+    std::vector<uint64_t> txFree_;
+    /** The number of packets queued, but not yet published */
+    uint32_t txPending_{0};
+
+    /**
+     * Waits for received packets.
+     * @return @em true if packets are ready, @em false on a timeout.
+     */
+    result<bool> wait_rx(milliseconds timeout);
+    /** Gives received frames back to the fill ring */
+    void recycle(uint32_t idx, uint32_t n) noexcept;
+    /** Moves the sent frames from the completion ring to the free list */
+    void reclaim() noexcept;
+    /** Maps one of the rings */
+    error_code map_ring(
+        detail::xdp_ring& ring, const xdp_ring_offset& off, uint32_t n, size_t entrySize,
+        off_t pgoff
+    ) noexcept;
+    /** Unmaps the rings and the shared memory */
+    void unmap() noexcept;
+
+    // Non-copyable
+    xdp_socket(const xdp_socket&) = delete;
+    xdp_socket& operator=(const xdp_socket&) = delete;
+
+public:
+    /** The default maximum number of packets to read in a batch */
+    static constexpr size_t DFLT_BATCH = 64;
+
+    /**
+     * Creates an unopened XDP socket.
+     */
+    xdp_socket() noexcept {}
+    /**
+     * Creates an XDP socket bound to a queue of a network interface.
+     * @param iface The name of the network interface.
+     * @param queue The queue of the interface.
+     * @param params The sizes of the memory and rings.
+     * @throws std::system_error on failure
+     */
+    xdp_socket(const string& iface, uint32_t queue, const xdp_params& params = xdp_params{}) {
+        if (auto res = open(iface, queue, params); !res)
+            throw std::system_error{res.error()};
+    }
+    /**
+     * Creates an XDP socket bound to a queue of a network interface.
+     * @param iface The name of the network interface.
+     * @param queue The queue of the interface.
+     * @param params The sizes of the memory and rings.
+     * @param ec The error code, on failure
+     */
+    xdp_socket(
+        const string& iface, uint32_t queue, const xdp_params& params, error_code& ec
+    ) noexcept {
+        ec = open(iface, queue, params).error();
+    }
+    /**
+     * Move constructor.
+     * @param other The other socket to move to this one
+     */
+    xdp_socket(xdp_socket&& other) noexcept;
+    /**
+     * Destructor unmaps the shared memory and closes the socket.
+     */
+    ~xdp_socket() { close(); }
+    /**
+     * Move assignment.
+     * @param rhs The other socket to move into this one.
+     * @return A reference to this object.
+     */
+    xdp_socket& operator=(xdp_socket&& rhs) noexcept;
+    /**
+     * Opens the socket and binds it to a queue of a network interface.
+     * @param iface The name of the network interface.
+     * @param queue The queue of the interface.
+     * @param params The sizes of the memory and rings.
+     * @return The error code, on failure.
+     */
+    result<> open(
+        const string& iface, uint32_t queue, const xdp_params& params = xdp_params{}
+    ) noexcept;
+    /**
+     * Closes the socket and unmaps the shared memory.
+     * @return The error code, on failure.
+     */
+    result<> close() override;
+    /**
+     * Gets the interface queue to which the socket is bound.
+     * @return The interface queue to which the socket is bound.
+     */
+    uint32_t queue_id() const { return queue_; }
+    /**
+     * Adds the socket to an XSKMAP, so that an XDP program can redirect
+     * packets to it.
+     * @param mapFd The file descriptor for the BPF map.
+     * @param key The key for the socket in the map. This is normally the
+     *  		  queue ID, which is what the usual XDP programs use.
+     * @return The error code, on failure.
+     */
+    result<> register_in_map(int mapFd, uint32_t key) noexcept;
+    /**
+     * Adds the socket to an XSKMAP, keyed by its queue ID.
+     * @param mapFd The file descriptor for the BPF map.
+     * @return The error code, on failure.
+     */
+    result<> register_in_map(int mapFd) noexcept { return register_in_map(mapFd, queue_); }
+    /**
+     * Reads a batch of received packets.
+     *
+     * This calls the function for each packet, and then gives all their
+     * frames back to the kernel for receiving.
+     *
+     * @param fn The function to call, like `fn(const xdp_frame& frame)`
+     * @param timeout The maximum time to wait for packets. A negative
+     *  			  value waits forever, and zero doesn't wait.
+     * @param maxFrames The maximum number of packets to read.
+     * @return The number of packets read, which is zero on a timeout, or
+     *  	   the error code on failure.
+     */
+    template <typename Func>
+    result<size_t> recv(
+        Func&& fn, milliseconds timeout = milliseconds{-1}, size_t maxFrames = DFLT_BATCH
+    ) {
+        if (!umem_)
+            return errc::bad_file_descriptor;
+
+        uint32_t idx, n = rx_.peek(uint32_t(maxFrames), idx);
+        if (n == 0) {
+            auto res = wait_rx(timeout);
+            if (!res || !res.value())
+                return res ? result<size_t>{size_t(0)} : result<size_t>{res.error()};
+            n = rx_.peek(uint32_t(maxFrames), idx);
+        }
+
+        // Give the frames back, even if the callback throws
+        struct recycler
+        {
+            xdp_socket* sock;
+            uint32_t idx, n;
+            ~recycler() { sock->recycle(idx, n); }
+        } rec{this, idx, n};
+
+        for (uint32_t i = 0; i < n; ++i) {
+            const auto& desc = rx_.at<xdp_desc>(idx + i);
+            const xdp_frame frame{umem_ + desc.addr, desc.len};
+            fn(frame);
+        }
+        return size_t(n);
+    }
+    /**
+     * Gets the most data that fits in one frame.
+     * @return The maximum size of a packet that can be sent.
+     */
+    size_t tx_max_size() const { return frameSize_; }
+    /**
+     * Copies a packet into a free frame, and queues it for sending.
+     * The packet isn't sent until the next call to @ref tx_flush().
+     * @param buf The link-layer packet to send.
+     * @param n The size of the packet.
+     * @return The error code on failure. This is
+     *  	   `errc::no_buffer_space` if there are no free frames.
+     */
+    result<> tx_queue(const void* buf, size_t n);
+    /**
+     * Publishes the queued packets to the kernel, and wakes it up to send
+     * them, if necessary.
+     * @return The number of packets published, or the error code on
+     *  	   failure.
+     */
+    result<size_t> tx_flush();
+    /**
+     * Gets the statistics for the socket, like the number of packets that
+     * were dropped for lack of fill frames.
+     * @return The socket statistics, or the error code on failure.
+     */
+    result<xdp_statistics> stats() const {
+        return get_option<xdp_statistics>(SOL_XDP, XDP_STATISTICS);
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_xdp_socket_h
@@ -0,0 +1,198 @@
+/**
+ * @file zerocopy_reader.h
+ *
+ * Zero-copy TCP receive, with the data mapped into user space.
+ *
+ * @author Frank Pagliughi
+ * @author SoRo Systems, Inc.
+ * @author www.sorosys.com
+ *
+ * @date October 2026
+ */
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_zerocopy_reader_h
+#define __sockpp_zerocopy_reader_h
+
+#include <memory>
+#include <string_view>
+
+#include "sockpp/stream_socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Receives data from a TCP socket by mapping the kernel's pages into user
+ * space, rather than copying them.
+ *
+ * This uses `TCP_ZEROCOPY_RECEIVE`. The reader maps a window of the
+ * socket into memory, and each @ref read() asks the kernel to place the
+ * pages of received data in it. Only whole pages of payload can be
+ * mapped, so the data is returned as a @ref chunk of two read-only
+ * views: the pages that were mapped, followed by any remainder, which is
+ * copied into a buffer the reader owns. For bulk transfers, with a large
+ * MTU or hardware header splitting, nearly all the data is mapped, which
+ * saves the cost of copying it at high rates.
+ *
+ * The views in a chunk are only valid until the next call to
+ * @ref read() or @ref release(), when the pages go back to the kernel.
+ * The application must be done with the data, or copy what it needs to
+ * keep, before reading again.
+ *
+ * When zero-copy receive isn't available, the reader falls back to
+ * plain reads into its buffer, so it can always be used. The socket can
+ * be blocking or non-blocking; a read that finds no data waits, or
+ * fails with `errc::operation_would_block`, just like a normal read.
+ *
+ * The reader refers to the socket, but does not own it. This is only
+ * available on Linux (4.18 or later).
+ */
+class zerocopy_reader
+{
+public:
+    /** The default size of the mapped receive window */
+    static constexpr size_t DFLT_WINDOW_SIZE = 2 * 1024 * 1024;
+    /** The default size of the buffer for data that isn't mapped */
+    static constexpr size_t DFLT_COPY_SIZE = 64 * 1024;
+
+    /**
+     * The data from one read.
+     * The mapped data comes first in the stream, then the copied data.
+     */
+    struct chunk
+    {
+        /** The data in pages mapped from the kernel */
+        std::string_view mapped;
+        /** The data copied into the reader's buffer */
+        std::string_view copied;
+
+        /**
+         * Gets the total amount of data in the chunk.
+         * @return The total amount of data in the chunk.
+         */
+        size_t size() const { return mapped.size() + copied.size(); }
+        /**
+         * Determines if the chunk has no data, which means the peer closed
+         * the connection.
+         * @return @em true if the chunk has no data.
+         */
+        bool empty() const { return size() == 0; }
+    };
+
+private:
+    /** The socket being read */
+    stream_socket& sock_;
+    /** The mapped receive window, or null if zero-copy isn't available */
+    char* map_{nullptr};
+    /** The size of the receive window */
+    size_t windowSize_{0};
+    /** The amount of data mapped in the window by the last read */
+    size_t mapped_{0};
+    /** The buffer for data that isn't mapped */
+    std::unique_ptr<char[]> copyBuf_;
+    /** The size of the copy buffer */
+    size_t copySize_;
+
+    /** Unmaps the receive window, to fall back to copying */
+    void unmap() noexcept;
+
+    // Non-copyable
+    zerocopy_reader(const zerocopy_reader&) = delete;
+    zerocopy_reader& operator=(const zerocopy_reader&) = delete;
+
+public:
+    /**
+     * Creates a reader for a TCP socket.
+     * If the receive window can't be mapped, the reader copies all the
+     * data.
+     * @param sock The socket to read. It must outlive the reader.
+     * @param windowSize The size of the mapped window. This is rounded up
+     *  				 to a whole number of pages, and limits the data
+     *  				 mapped by each read.
+     * @param copySize The size of the buffer for data that isn't mapped.
+     */
+    explicit zerocopy_reader(
+        stream_socket& sock, size_t windowSize = DFLT_WINDOW_SIZE,
+        size_t copySize = DFLT_COPY_SIZE
+    );
+    /**
+     * Destroys the reader, returning any mapped pages to the kernel.
+     */
+    ~zerocopy_reader();
+    /**
+     * Gets the socket being read.
+     * @return A reference to the socket being read.
+     */
+    stream_socket& sock() { return sock_; }
+    /**
+     * Determines if the data can be mapped, rather than copied.
+     * This is @em false if zero-copy receive isn't supported for the
+     * socket, in which case every read copies.
+     * @return @em true if the reader maps the data.
+     */
+    bool is_mapped() const { return map_ != nullptr; }
+    /**
+     * Gets the size of the mapped receive window.
+     * @return The size of the window, or zero if the reader doesn't map
+     *  	   the data.
+     */
+    size_t window_size() const { return windowSize_; }
+    /**
+     * Reads the next chunk of data.
+     *
+     * This gives back the pages from the previous read, then maps as
+     * much of the received data as it can. If the data at the front of
+     * the stream can't be mapped, up to a buffer's worth of it is copied
+     * instead. If nothing has been received, this waits like a normal
+     * read on a blocking socket.
+     * @return The chunk of data, which is empty at the end of the
+     *  	   stream, or the error code on failure.
+     */
+    result<chunk> read();
+    /**
+     * Gives the pages from the last read back to the kernel, without
+     * waiting for the next read.
+     * This invalidates the views from the last read.
+     */
+    void release() noexcept;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
+
+#endif  // __sockpp_zerocopy_reader_h
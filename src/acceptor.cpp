@@ -38,17 +38,36 @@
 
 #include <cstring>
 
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || \
+    defined(__OpenBSD__) || defined(__DragonFly__)
+    #define SOCKPP_HAVE_ACCEPT4
+#endif
+
+#if defined(__linux__)
+    #include <linux/filter.h>
+#endif
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+#endif
+
+#include "trace.h"
+
 using namespace std;
 
 namespace sockpp {
 
 /////////////////////////////////////////////////////////////////////////////
 
-result<acceptor> acceptor::create(int domain) noexcept {
-    if (auto res = create_handle(domain); !res)
+result<acceptor> acceptor::create(
+    int domain, int flags /*=0*/, int protocol /*=0*/
+) noexcept {
+    if (auto res = create_handle(domain, stream_socket::COMM_TYPE, flags, protocol); !res)
         return res.error();
-    else
-        return acceptor(res.value());
+    else {
+        acceptor acc(res.value());
+        return acc;
+    }
 }
 
 // --------------------------------------------------------------------------
@@ -60,16 +79,32 @@ result<acceptor> acceptor::create(int domain) noexcept {
 // without doing anything.
 
 result<> acceptor::open(
-    const sock_address& addr, int queSize /*=DFLT_QUE_SIZE*/, int reuse /*=0*/
+    const sock_address& addr, int queSize /*=DFLT_QUE_SIZE*/, int reuse /*=0*/,
+    int flags /*=0*/, int protocol /*=0*/
+) noexcept {
+    return do_open(addr, stream_socket::COMM_TYPE, queSize, reuse, flags, protocol);
+}
+
+result<> acceptor::do_open(
+    const sock_address& addr, int type, int queSize, int reuse, int flags /*=0*/,
+    int protocol /*=0*/
 ) noexcept {
     // TODO: Should we fail if we're bound to a different address?
     if (is_open())
         return none{};
 
-    if (auto res = create_handle(addr.family()); !res)
+    if (auto res = create_handle(addr.family(), type, flags, protocol); !res)
         return res.error();
-    else
+    else {
         reset(res.value());
+    }
+
+    // Buffer sizes, in particular, need to be set before listening so that
+    // the window scale is negotiated for them.
+    if (auto res = opts_.apply_listener(*this); !res) {
+        close();
+        return res;
+    }
 
     if (auto res = bind(addr, reuse); !res) {
         close();
@@ -86,15 +121,105 @@ result<> acceptor::open(
 
 // --------------------------------------------------------------------------
 
-result<stream_socket> acceptor::accept(sock_address* clientAddr /*=nullptr*/) noexcept {
+result<stream_socket> acceptor::do_accept(sockaddr* p, socklen_t* plen, int flags) noexcept {
+#if defined(SOCKPP_HAVE_ACCEPT4)
+    int aflags = 0;
+    if (flags & NON_BLOCKING)
+        aflags |= SOCK_NONBLOCK;
+    if (flags & CLOSE_ON_EXEC)
+        aflags |= SOCK_CLOEXEC;
+
+    SOCKPP_TRACE1(accept__entry, handle());
+    auto res = check_socket(::accept4(handle(), p, plen, aflags));
+    SOCKPP_TRACE2(accept__return, handle(), res ? int64_t(res.value()) : detail::trace_err(res));
+    if (!res)
+        return res.error();
+
+    stream_socket sock{res.value()};
+#else
+    SOCKPP_TRACE1(accept__entry, handle());
+    auto res = check_socket(::accept(handle(), p, plen));
+    SOCKPP_TRACE2(accept__return, handle(), res ? int64_t(res.value()) : detail::trace_err(res));
+    if (!res)
+        return res.error();
+
+    stream_socket sock{res.value()};
+
+    if (flags & NON_BLOCKING) {
+        if (auto nbres = sock.set_non_blocking(); !nbres)
+            return nbres.error();
+    }
+    #if !defined(_WIN32)
+    if (flags & CLOSE_ON_EXEC) {
+        if (::fcntl(sock.handle(), F_SETFD, FD_CLOEXEC) < 0)
+            return result<stream_socket>::from_last_error();
+    }
+    #endif
+#endif
+
+#if defined(SO_NOSIGPIPE)
+    sock.set_option(SOL_SOCKET, SO_NOSIGPIPE, 1);
+#endif
+
+    if (!opts_.empty())
+        opts_.apply_accepted(sock);
+    return sock;
+}
+
+// --------------------------------------------------------------------------
+
+result<stream_socket> acceptor::accept(
+    sock_address* clientAddr /*=nullptr*/, int flags /*=0*/
+) noexcept {
     sockaddr* p = clientAddr ? clientAddr->sockaddr_ptr() : nullptr;
     socklen_t len = clientAddr ? clientAddr->size() : 0;
+    return do_accept(p, clientAddr ? &len : nullptr, flags);
+}
 
-    if (auto res = check_socket(::accept(handle(), p, clientAddr ? &len : nullptr)); !res)
-        return res.error();
-    else
-        return stream_socket{res.value()};
+// --------------------------------------------------------------------------
+// Accepts into a compact address. The peer is read into a local buffer
+// that is just big enough for an IPv6 address; anything that isn't IPv4
+// or IPv6 leaves the address unset.
+
+result<stream_socket> acceptor::accept(
+    inet_any_address& clientAddr, int flags /*=0*/
+) noexcept {
+    sockaddr_in6 buf{};
+    socklen_t len = sizeof(buf);
+    auto p = reinterpret_cast<sockaddr*>(&buf);
+
+    auto res = do_accept(p, &len, flags);
+    if (!res || !clientAddr.assign(p, len))
+        clientAddr.clear();
+    return res;
 }
 
+
+// --------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+// The filter returns the index of the socket in the reuseport group which
+// should get the connection: the current CPU modulo the group size.
+
+result<> acceptor::attach_reuseport_cpu_filter(unsigned nGroup) noexcept {
+    if (nGroup == 0)
+        return errc::invalid_argument;
+
+    sock_filter code[] = {
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, uint32_t(SKF_AD_OFF + SKF_AD_CPU)},
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, nGroup},
+        {BPF_RET | BPF_A, 0, 0, 0},
+    };
+
+    sock_fprog prog{};
+    prog.len = uint16_t(sizeof(code) / sizeof(code[0]));
+    prog.filter = code;
+
+    return set_option(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, prog);
+}
+
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
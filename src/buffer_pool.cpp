@@ -0,0 +1,206 @@
+// buffer_pool.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/buffer_pool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+// The shared state of the pool.
+
+struct buffer_pool::core
+{
+    size_t chunkSz;
+    size_t slabChunks;
+
+    std::mutex mtx;
+    std::vector<std::unique_ptr<uint8_t[]>> slabs;
+    std::vector<uint8_t*> freeList;
+    size_t nchunks{0};
+
+    core(size_t chunkSize, size_t nslab) : chunkSz{chunkSize}, slabChunks{nslab} {}
+
+    // Moves up to 'n' free chunks into 'out', growing the pool if needed.
+    void take(std::vector<uint8_t*>& out, size_t n) {
+        std::lock_guard<std::mutex> lk{mtx};
+
+        if (freeList.empty()) {
+            std::unique_ptr<uint8_t[]> slab{new uint8_t[chunkSz * slabChunks]};
+            nchunks += slabChunks;
+            // Make sure a later give() never needs to allocate.
+            freeList.reserve(nchunks);
+            for (size_t i = 0; i < slabChunks; ++i)
+                freeList.push_back(slab.get() + i * chunkSz);
+            slabs.push_back(std::move(slab));
+        }
+
+        n = std::min(n, freeList.size());
+        out.insert(out.end(), freeList.end() - n, freeList.end());
+        freeList.resize(freeList.size() - n);
+    }
+
+    // Returns chunks to the shared list.
+    void give(uint8_t* const* p, size_t n) noexcept {
+        std::lock_guard<std::mutex> lk{mtx};
+        freeList.insert(freeList.end(), p, p + n);
+    }
+};
+
+// --------------------------------------------------------------------------
+// The per-thread caches of free chunks, one for each pool that the thread
+// has used. A cache only refers weakly to its pool, so a pool can be
+// destroyed while other threads still have (now stale) caches for it.
+
+namespace {
+
+struct thread_cache
+{
+    struct entry
+    {
+        std::weak_ptr<buffer_pool::core> pool;
+        const buffer_pool::core* id;
+        std::vector<uint8_t*> chunks;
+    };
+
+    std::vector<entry> entries;
+
+    // Finds, or creates, the cache for the specified pool.
+    entry& get(const std::shared_ptr<buffer_pool::core>& pool) {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->pool.expired()) {
+                it = entries.erase(it);
+                continue;
+            }
+            if (it->id == pool.get())
+                return *it;
+            ++it;
+        }
+
+        entry e{pool, pool.get(), {}};
+        // Room for one extra, so a release never needs to allocate.
+        e.chunks.reserve(buffer_pool::THREAD_CACHE_SIZE + 1);
+        entries.push_back(std::move(e));
+        return entries.back();
+    }
+
+    // Returns all cached chunks to their pools when the thread exits.
+    ~thread_cache();
+};
+
+thread_local thread_cache tcache;
+
+// Set once the thread's cache is gone, for any buffers released later
+// while the thread is shutting down.
+thread_local bool tcacheDone = false;
+
+thread_cache::~thread_cache() {
+    for (auto& e : entries) {
+        if (auto pool = e.pool.lock())
+            pool->give(e.chunks.data(), e.chunks.size());
+    }
+    tcacheDone = true;
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//								buffer_pool
+/////////////////////////////////////////////////////////////////////////////
+
+buffer_pool::buffer_pool(
+    size_t chunkSize /*=DFLT_CHUNK_SIZE*/, size_t slabChunks /*=DFLT_SLAB_CHUNKS*/
+)
+    : chunkSz_{std::max<size_t>(chunkSize, 1)},
+      core_{std::make_shared<core>(chunkSz_, std::max<size_t>(slabChunks, 1))} {}
+
+buffer_pool::~buffer_pool() {}
+
+// --------------------------------------------------------------------------
+
+pooled_buffer buffer_pool::get() {
+    if (tcacheDone) {
+        std::vector<uint8_t*> v;
+        core_->take(v, 1);
+        return pooled_buffer{this, v.back()};
+    }
+
+    auto& e = tcache.get(core_);
+    if (e.chunks.empty())
+        core_->take(e.chunks, THREAD_CACHE_SIZE / 2);
+
+    auto p = e.chunks.back();
+    e.chunks.pop_back();
+    return pooled_buffer{this, p};
+}
+
+// --------------------------------------------------------------------------
+
+void buffer_pool::release(uint8_t* p) noexcept {
+    if (tcacheDone) {
+        core_->give(&p, 1);
+        return;
+    }
+
+    try {
+        auto& e = tcache.get(core_);
+        e.chunks.push_back(p);
+
+        // Spill half the cache back to the shared list if it's over full.
+        if (e.chunks.size() > THREAD_CACHE_SIZE) {
+            size_t n = THREAD_CACHE_SIZE / 2;
+            core_->give(e.chunks.data() + e.chunks.size() - n, n);
+            e.chunks.resize(e.chunks.size() - n);
+        }
+    }
+    catch (...) {
+        // Couldn't create a cache for this thread
+        core_->give(&p, 1);
+    }
+}
+
+// --------------------------------------------------------------------------
+
+size_t buffer_pool::capacity() const noexcept {
+    std::lock_guard<std::mutex> lk{core_->mtx};
+    return core_->nchunks;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,219 @@
+// buffered_stream.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/buffered_stream.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "sockpp/memsearch.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+buffered_stream::buffered_stream(
+    stream_socket& sock, size_t bufSize /*=DFLT_BUFFER_SIZE*/,
+    size_t maxSize /*=DFLT_MAX_SIZE*/
+)
+    : sock_{sock}, buf_(std::max<size_t>(bufSize, 1)), maxSize_{std::max(maxSize, bufSize)} {}
+
+// --------------------------------------------------------------------------
+
+void buffered_stream::frame_lowat(bool on) {
+    if (!on)
+        set_lowat(1);
+    frameLowat_ = on;
+}
+
+void buffered_stream::set_lowat(size_t n) {
+    if (n == lowat_)
+        return;
+
+    auto lowat = int(std::min<size_t>(n, INT_MAX));
+    if (sock_.recv_lowat(lowat))
+        lowat_ = n;
+    else
+        frameLowat_ = false;
+}
+
+// --------------------------------------------------------------------------
+// The unread data is moved to the front of the buffer only when there's no
+// room after it, so each byte is moved at most once per message, and the
+// buffer only grows when a single message doesn't fit.
+
+result<size_t> buffered_stream::fill() {
+    if (eof_)
+        return (beg_ == end_) ? errc::not_connected : errc::connection_reset;
+
+    if (beg_ == end_)
+        beg_ = end_ = 0;
+
+    if (end_ == buf_.size()) {
+        if (beg_ > 0) {
+            std::memmove(buf_.data(), buf_.data() + beg_, end_ - beg_);
+            end_ -= beg_;
+            beg_ = 0;
+        }
+        else if (buf_.size() < maxSize_) {
+            buf_.resize(std::min(2 * buf_.size(), maxSize_));
+        }
+        else {
+            return errc::message_size;
+        }
+    }
+
+    auto res = sock_.read(buf_.data() + end_, buf_.size() - end_);
+    if (!res)
+        return res;
+
+    if (res.value() == 0) {
+        eof_ = true;
+        return (beg_ == end_) ? errc::not_connected : errc::connection_reset;
+    }
+
+    end_ += res.value();
+    return res;
+}
+
+// --------------------------------------------------------------------------
+
+result<std::string_view> buffered_stream::read_until(std::string_view delim) {
+    if (delim.empty())
+        return errc::invalid_argument;
+
+    // Where to resume the search after a refill, relative to beg_, so that
+    // nothing is scanned twice, except for a delimiter split between reads
+    size_t from = 0;
+
+    while (true) {
+        auto p = buf_.data() + beg_;
+        if (auto q = find_seq(p + from, available() - from, delim); q) {
+            auto sv = take(size_t(q - p));
+            beg_ += delim.size();
+            return sv;
+        }
+
+        auto n = available();
+        from = (n >= delim.size()) ? (n - delim.size() + 1) : 0;
+
+        if (auto res = fill(); !res)
+            return res.error();
+    }
+}
+
+result<std::string_view> buffered_stream::read_line() {
+    auto res = read_until('\n');
+    if (!res)
+        return res;
+
+    auto sv = res.value();
+    if (!sv.empty() && sv.back() == '\r')
+        sv.remove_suffix(1);
+    return sv;
+}
+
+result<std::string_view> buffered_stream::read_exact(size_t n) {
+    if (n > maxSize_)
+        return errc::message_size;
+
+    while (available() < n) {
+        if (auto res = fill(); !res)
+            return res.error();
+    }
+    return take(n);
+}
+
+result<std::string_view> buffered_stream::read_frame(size_t hdrSize, endian order) {
+    while (available() < hdrSize) {
+        if (auto res = fill(); !res)
+            return res.error();
+    }
+
+    auto p = reinterpret_cast<const uint8_t*>(buf_.data() + beg_);
+    size_t len = 0;
+
+    if (order == endian::big) {
+        for (size_t i = 0; i < hdrSize; ++i) len = (len << 8) | p[i];
+    }
+    else {
+        for (size_t i = hdrSize; i > 0; --i) len = (len << 8) | p[i - 1];
+    }
+
+    if (hdrSize + len > maxSize_)
+        return errc::message_size;
+
+    // Leave the header in place until the whole frame is in, so that a
+    // would-block can be retried. If the socket waits for the rest of the
+    // frame, the low-water mark stays up across a would-block, so that the
+    // next readiness is for the whole frame.
+    while (available() < hdrSize + len) {
+        if (frameLowat_)
+            set_lowat(hdrSize + len - available());
+
+        if (auto res = fill(); !res)
+            return res.error();
+    }
+
+    if (lowat_ != 1)
+        set_lowat(1);
+
+    beg_ += hdrSize;
+    return take(len);
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> buffered_stream::read(void* buf, size_t n) {
+    if (auto nbuf = available(); nbuf > 0) {
+        n = std::min(n, nbuf);
+        std::memcpy(buf, buf_.data() + beg_, n);
+        beg_ += n;
+        return n;
+    }
+
+    if (eof_)
+        return 0;
+
+    auto res = sock_.read(buf, n);
+    if (res && res.value() == 0)
+        eof_ = true;
+    return res;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
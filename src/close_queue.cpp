@@ -0,0 +1,129 @@
+// close_queue.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/close_queue.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+close_queue::close_queue(bool background /*=false*/) {
+    if (background)
+        thr_ = std::thread(&close_queue::run, this);
+}
+
+close_queue::~close_queue() {
+    if (thr_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lk{lock_};
+            quit_ = true;
+        }
+        cv_.notify_one();
+        thr_.join();
+    }
+    flush();
+}
+
+// --------------------------------------------------------------------------
+
+size_t close_queue::close_all(const std::vector<socket_t>& handles) {
+    for (auto h : handles) socket{h}.close();
+
+    std::lock_guard<std::mutex> lk{lock_};
+    nclosed_ += handles.size();
+    return handles.size();
+}
+
+// --------------------------------------------------------------------------
+// The background thread waits for handles, and closes each batch outside
+// the lock, so that producers are never stalled behind a slow close.
+
+void close_queue::run() {
+    std::vector<socket_t> batch;
+    std::unique_lock<std::mutex> lk{lock_};
+
+    while (true) {
+        cv_.wait(lk, [this] { return quit_ || !pending_.empty(); });
+        if (pending_.empty())
+            break;
+
+        batch.swap(pending_);
+        lk.unlock();
+        close_all(batch);
+        batch.clear();
+        lk.lock();
+    }
+}
+
+// --------------------------------------------------------------------------
+
+void close_queue::defer(socket_t h) {
+    if (h == INVALID_SOCKET)
+        return;
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lk{lock_};
+        wake = pending_.empty();
+        pending_.push_back(h);
+    }
+    if (wake && thr_.joinable())
+        cv_.notify_one();
+}
+
+size_t close_queue::flush() { return close_all(take()); }
+
+std::vector<socket_t> close_queue::take() {
+    std::vector<socket_t> handles;
+    std::lock_guard<std::mutex> lk{lock_};
+    handles.swap(pending_);
+    return handles;
+}
+
+// --------------------------------------------------------------------------
+
+size_t close_queue::pending() const {
+    std::lock_guard<std::mutex> lk{lock_};
+    return pending_.size();
+}
+
+size_t close_queue::closed() const {
+    std::lock_guard<std::mutex> lk{lock_};
+    return nclosed_;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
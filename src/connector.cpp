@@ -36,6 +36,13 @@
 
 #include "sockpp/connector.h"
 
+#include <algorithm>
+#include <map>
+
+#include "sockpp/poller.h"
+#include "stats.h"
+#include "trace.h"
+
 #include <cerrno>
 #if !defined(_WIN32)
     #include <sys/poll.h>
@@ -50,23 +57,66 @@ namespace sockpp {
 
 /////////////////////////////////////////////////////////////////////////////
 
-result<> connector::recreate(const sock_address& addr) {
-    if (auto res = create_handle(addr.family()); !res)
+result<> connector::recreate(sa_family_t family, int flags /*=0*/) {
+    flags |= flags_;
+    if (auto res = create_handle(family, protocol_, flags); !res)
         return res.error();
     else {
         // This will close the old connection, if any.
         reset(res.value());
+
+        if (auto optRes = opts_.apply(*this); !optRes) {
+            close();
+            return optRes;
+        }
         return none{};
     }
 }
 
+// --------------------------------------------------------------------------
+// A fresh handle is only good for one connect attempt. After that, TCP
+// needs a new socket, even if the attempt failed.
+
+result<> connector::prepare(const sock_address& addr, int flags /*=0*/) {
+    auto h = std::exchange(fresh_, INVALID_SOCKET);
+
+    if (h == INVALID_SOCKET || h != handle() || freshFamily_ != addr.family())
+        return recreate(addr.family(), flags);
+
+    if ((flags & NON_BLOCKING) && !is_non_blocking()) {
+        if (auto res = set_non_blocking(true); !res) {
+            close();
+            return res;
+        }
+    }
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<> connector::open(sa_family_t family) {
+    fresh_ = INVALID_SOCKET;
+    if (auto res = recreate(family); !res)
+        return res;
+
+    fresh_ = handle();
+    freshFamily_ = family;
+    return none{};
+}
+
 /////////////////////////////////////////////////////////////////////////////
 
 result<none> connector::connect(const sock_address& addr) {
-    if (auto res = recreate(addr); !res)
+    if (auto res = prepare(addr); !res)
         return res;
 
-    return check_res_none(::connect(handle(), addr.sockaddr_ptr(), addr.size()));
+    SOCKPP_TRACE2(connect__start, handle(), 0);
+    auto t0 = detail::stats_now();
+    auto res = check_res_none(::connect(handle(), addr.sockaddr_ptr(), addr.size()));
+    SOCKPP_TRACE2(connect__done, handle(), detail::trace_err(res));
+    if (res)
+        detail::stats_latency_since(latency_op::connect, t0);
+    return res;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -75,19 +125,14 @@ result<> connector::connect(const sock_address& addr, microseconds timeout) {
     if (timeout.count() <= 0)
         return connect(addr);
 
-    if (auto res = recreate(addr); !res)
+    // The socket is created non-blocking for the connect
+    if (auto res = prepare(addr, NON_BLOCKING); !res)
         return res;
 
-    bool non_blocking =
-#if defined(_WIN32)
-        false;
-#else
-        is_non_blocking();
-#endif
-
-    if (!non_blocking)
-        set_non_blocking(true);
+    bool non_blocking = (flags_ & NON_BLOCKING) != 0;
 
+    SOCKPP_TRACE2(connect__start, handle(), timeout.count());
+    auto t0 = detail::stats_now();
     result<int> res = check_res(::connect(handle(), addr.sockaddr_ptr(), addr.size()));
 
     if (!res) {
@@ -119,17 +164,22 @@ result<> connector::connect(const sock_address& addr, microseconds timeout) {
                         res = result<int>::from_error(err);
                 }
                 else {
+                    SOCKPP_TRACE2(connect__timeout, handle(), timeout.count());
                     res = errc::timed_out;
                 }
             }
         }
 
         if (!res) {
+            SOCKPP_TRACE2(connect__done, handle(), detail::trace_err(res));
             close();
             return res.error();
         }
     }
 
+    SOCKPP_TRACE2(connect__done, handle(), 0);
+    detail::stats_latency_since(latency_op::connect, t0);
+
     // Restore blocking mode for socket, if needed.
     if (!non_blocking)
         set_non_blocking(false);
@@ -137,5 +187,293 @@ result<> connector::connect(const sock_address& addr, microseconds timeout) {
     return none{};
 }
 
+/////////////////////////////////////////////////////////////////////////////
+
+result<bool> connector::connect_async(const sock_address& addr) {
+    if (auto res = prepare(addr, NON_BLOCKING); !res)
+        return res.error();
+
+    SOCKPP_TRACE2(connect__start, handle(), 0);
+    if (::connect(handle(), addr.sockaddr_ptr(), addr.size()) == 0) {
+        SOCKPP_TRACE2(connect__done, handle(), 0);
+        return true;
+    }
+
+    auto err = result<>::last_error();
+    if (err == errc::operation_in_progress || err == errc::operation_would_block)
+        return false;
+
+    SOCKPP_TRACE2(connect__done, handle(), -int64_t(err.value()));
+    close();
+    return err;
+}
+
+// --------------------------------------------------------------------------
+// With Fast Open, the connect is implied by the first send. If that isn't
+// available, this is just a regular connect and write.
+
+result<size_t> connector::connect_with_data(
+    const sock_address& addr, const void* buf, size_t n
+) {
+    if (auto res = prepare(addr); !res)
+        return res.error();
+
+#if defined(MSG_FASTOPEN)
+    auto ret = ::sendto(
+        handle(), buf, n, MSG_FASTOPEN | MSG_NOSIGNAL, addr.sockaddr_ptr(), addr.size()
+    );
+    detail::stats_send(ret, n);
+
+    if (ret >= 0)
+        return size_t(ret);
+
+    // The kernel refuses if Fast Open is disabled for clients
+    // (net.ipv4.tcp_fastopen), leaving the socket ready for a normal
+    // connect.
+    auto err = result<>::last_error();
+    if (err != errc::operation_not_supported) {
+        close();
+        return err;
+    }
+#elif defined(__APPLE__) && defined(CONNECT_DATA_IDEMPOTENT)
+    sa_endpoints_t ep{};
+    ep.sae_dstaddr = addr.sockaddr_ptr();
+    ep.sae_dstaddrlen = addr.size();
+
+    iovec iov{const_cast<void*>(buf), n};
+    size_t len = 0;
+
+    if (::connectx(
+            handle(), &ep, SAE_ASSOCID_ANY, CONNECT_DATA_IDEMPOTENT, &iov, 1, &len, nullptr
+        ) < 0) {
+        auto err = result<>::last_error();
+        close();
+        return err;
+    }
+    detail::stats_send(ssize_t(len), n);
+    return len;
+#endif
+
+    if (auto res = check_res_none(::connect(handle(), addr.sockaddr_ptr(), addr.size()));
+        !res) {
+        close();
+        return res.error();
+    }
+    return write(buf, n);
+}
+
+// --------------------------------------------------------------------------
+// Once a non-blocking connect has finished, success or failure is reported
+// in SO_ERROR. But that's also zero while the connect is still pending, so
+// in that case check whether there's a peer yet.
+
+result<> connector::finish_connect() {
+    int err = 0;
+    if (auto res = get_option(SOL_SOCKET, SO_ERROR, &err); !res)
+        return res;
+
+    if (err != 0) {
+        SOCKPP_TRACE2(connect__done, handle(), -int64_t(err));
+        return result<>::from_error(err);
+    }
+
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+
+    if (::getpeername(handle(), reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+        auto ec = result<>::last_error();
+        if (ec == errc::not_connected)
+            return errc::operation_in_progress;
+        SOCKPP_TRACE2(connect__done, handle(), -int64_t(ec.value()));
+        return ec;
+    }
+
+    SOCKPP_TRACE2(connect__done, handle(), 0);
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+void connector::connect_many(
+    connector* const* conns, const sock_address* const* addrs, error_code* errs, size_t n,
+    microseconds timeout
+) {
+    auto deadline = steady_clock::now() + timeout;
+
+    error_code ec;
+    poller pl{ec};
+
+    std::map<socket_t, size_t> pending;
+
+    for (size_t i = 0; i < n; ++i) {
+        auto res = conns[i]->connect_async(*addrs[i]);
+        if (!res)
+            errs[i] = res.error();
+        else if (res.value())
+            errs[i] = error_code{};
+        else if (ec)
+            errs[i] = ec;
+        else if (auto addRes = pl.add(*conns[i], poller::WRITABLE); !addRes)
+            errs[i] = addRes.error();
+        else
+            pending[conns[i]->handle()] = i;
+    }
+
+    std::vector<poller::event> evts;
+    evts.reserve(poller::DFLT_MAX_EVENTS);
+
+    while (!pending.empty()) {
+        auto now = steady_clock::now();
+        if (now >= deadline)
+            break;
+
+        // Round up, so that we don't spin on a sub-millisecond remainder
+        auto ms = duration_cast<milliseconds>(deadline - now) + milliseconds(1);
+        auto res = pl.wait(evts, ms);
+
+        if (!res) {
+            if (res == errc::interrupted)
+                continue;
+            break;
+        }
+
+        for (const auto& evt : evts) {
+            auto it = pending.find(evt.handle);
+            if (it == pending.end())
+                continue;
+
+            auto i = it->second;
+            auto finRes = conns[i]->finish_connect();
+            if (finRes == errc::operation_in_progress)
+                continue;
+
+            errs[i] = finRes.error();
+            pl.remove(evt.handle);
+            pending.erase(it);
+        }
+    }
+
+    for (const auto& [h, i] : pending) {
+        errs[i] = make_error_code(errc::timed_out);
+        pl.remove(h);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (errs[i])
+            conns[i]->close();
+        else if (!(conns[i]->flags_ & NON_BLOCKING))
+            conns[i]->set_non_blocking(false);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Happy Eyeballs
+
+result<std::vector<sock_address_any>> connector::resolve(
+    const string& host, in_port_t port, int family /*=AF_UNSPEC*/
+) {
+    return resolver::lookup(host, port, family);
+}
+
+// --------------------------------------------------------------------------
+
+result<> connector::connect_race(
+    const std::vector<sock_address_any>& addrs, microseconds timeout /*=0*/,
+    milliseconds attemptDelay /*=DFLT_ATTEMPT_DELAY*/
+) {
+    using clock = steady_clock;
+
+    if (addrs.empty())
+        return errc::invalid_argument;
+
+    auto now = clock::now();
+    auto deadline = (timeout.count() > 0) ? (now + timeout) : clock::time_point::max();
+
+    error_code ec;
+    poller pl{ec};
+    if (ec)
+        return ec;
+
+    // The attempts in flight, by handle
+    std::map<socket_t, connector> pending;
+
+    error_code lastErr = make_error_code(errc::timed_out);
+    size_t next = 0;
+    auto nextStart = now;
+
+    while (true) {
+        now = clock::now();
+
+        // Start the next attempt, if it's time
+        if (next < addrs.size() && (now >= nextStart || pending.empty())) {
+            connector conn;
+            conn.opts_ = opts_;
+            conn.flags_ = flags_;
+            auto res = conn.connect_async(addrs[next++]);
+
+            if (!res) {
+                lastErr = res.error();
+                continue;
+            }
+            if (res.value()) {
+                *this = std::move(conn);
+                set_non_blocking((flags_ & NON_BLOCKING) != 0);
+                return none{};
+            }
+            if (auto addRes = pl.add(conn, poller::WRITABLE); !addRes) {
+                lastErr = addRes.error();
+                continue;
+            }
+
+            auto h = conn.handle();
+            pending.emplace(h, std::move(conn));
+            nextStart = now + attemptDelay;
+            continue;
+        }
+
+        if (pending.empty())
+            return lastErr;
+
+        if (now >= deadline)
+            return errc::timed_out;
+
+        // Wait until the next attempt is due, or the deadline
+        auto until = (next < addrs.size()) ? std::min(nextStart, deadline) : deadline;
+        auto ms = (until == clock::time_point::max())
+                      ? milliseconds(-1)
+                      : duration_cast<milliseconds>(until - now) + milliseconds(1);
+
+        std::vector<poller::event> evts;
+        if (auto res = pl.wait(evts, ms); !res) {
+            if (res == errc::interrupted)
+                continue;
+            return res.error();
+        }
+
+        for (const auto& evt : evts) {
+            auto it = pending.find(evt.handle);
+            if (it == pending.end())
+                continue;
+
+            auto res = it->second.finish_connect();
+            if (res == errc::operation_in_progress)
+                continue;
+
+            pl.remove(evt.handle);
+
+            if (res) {
+                *this = std::move(it->second);
+                set_non_blocking((flags_ & NON_BLOCKING) != 0);
+                return none{};
+            }
+
+            // A failure starts the next attempt right away.
+            lastErr = res.error();
+            pending.erase(it);
+            nextStart = now;
+        }
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
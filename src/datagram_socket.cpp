@@ -37,8 +37,16 @@
 #include "sockpp/datagram_socket.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "sockpp/error.h"
+#include "stats.h"
+
+#if defined(__linux__)
+    #include <netinet/udp.h>
+
+    #include "sockpp/cmsg.h"
+#endif
 
 using namespace std::chrono;
 
@@ -48,9 +56,9 @@ namespace sockpp {
 //								datagram_socket
 /////////////////////////////////////////////////////////////////////////////
 
-result<> datagram_socket::open(const sock_address& addr) noexcept {
+result<> datagram_socket::open(const sock_address& addr, int flags /*=0*/) noexcept {
     auto domain = addr.family();
-    if (auto createRes = create_handle(domain); !createRes) {
+    if (auto createRes = create_handle(domain, 0, flags); !createRes) {
         return createRes.error();
     }
     else {
@@ -63,5 +71,391 @@ result<> datagram_socket::open(const sock_address& addr) noexcept {
     return none{};
 }
 
+// --------------------------------------------------------------------------
+// Batched I/O
+//
+// On Linux the messages are moved with recvmmsg/sendmmsg, using a fixed
+// array of headers on the stack, so larger batches are done in chunks.
+// Elsewhere we just loop over the individual calls.
+
+#if defined(__linux__)
+
+namespace {
+constexpr size_t MMSG_CHUNK = 64;
+}
+
+result<size_t> datagram_socket::recv_mmsg(
+    const iovec* bufs, size_t* lens, size_t n, int flags, sockaddr* addrs,
+    size_t addrStride, socklen_t addrLen
+) {
+    mmsghdr msgs[MMSG_CHUNK];
+    size_t nrecv = 0;
+
+    while (nrecv < n) {
+        size_t nchunk = std::min(n - nrecv, MMSG_CHUNK);
+        std::memset(msgs, 0, nchunk * sizeof(mmsghdr));
+
+        for (size_t i = 0; i < nchunk; ++i) {
+            auto& hdr = msgs[i].msg_hdr;
+            hdr.msg_iov = const_cast<iovec*>(&bufs[nrecv + i]);
+            hdr.msg_iovlen = 1;
+            if (addrs) {
+                hdr.msg_name = reinterpret_cast<char*>(addrs) + (nrecv + i) * addrStride;
+                hdr.msg_namelen = addrLen;
+            }
+        }
+
+        // Only the first chunk is allowed to block, and only until a
+        // single message arrives. After that, take what's there.
+        int fl = flags | ((nrecv == 0) ? MSG_WAITFORONE : MSG_DONTWAIT);
+        int ret = ::recvmmsg(handle(), msgs, unsigned(nchunk), fl, nullptr);
+        detail::stats_recv_batch(ret, msgs);
+
+        if (ret < 0) {
+            if (nrecv != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+
+        for (int i = 0; i < ret; ++i) lens[nrecv + i] = size_t(msgs[i].msg_len);
+
+        nrecv += size_t(ret);
+        if (size_t(ret) < nchunk)
+            break;
+    }
+    return nrecv;
+}
+
+result<size_t> datagram_socket::send_mmsg(
+    const iovec* bufs, size_t n, int flags, const sockaddr* addrs, size_t addrStride,
+    socklen_t addrLen
+) {
+    mmsghdr msgs[MMSG_CHUNK];
+    size_t nsent = 0;
+
+    while (nsent < n) {
+        size_t nchunk = std::min(n - nsent, MMSG_CHUNK);
+        std::memset(msgs, 0, nchunk * sizeof(mmsghdr));
+
+        for (size_t i = 0; i < nchunk; ++i) {
+            auto& hdr = msgs[i].msg_hdr;
+            hdr.msg_iov = const_cast<iovec*>(&bufs[nsent + i]);
+            hdr.msg_iovlen = 1;
+            if (addrs) {
+                auto p = reinterpret_cast<const char*>(addrs) + (nsent + i) * addrStride;
+                hdr.msg_name = const_cast<char*>(p);
+                hdr.msg_namelen = addrLen;
+            }
+        }
+
+        int ret = ::sendmmsg(handle(), msgs, unsigned(nchunk), flags | MSG_NOSIGNAL);
+        detail::stats_send_batch(ret, msgs, nchunk);
+
+        if (ret < 0) {
+            if (nsent != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+
+        nsent += size_t(ret);
+        if (size_t(ret) < nchunk)
+            break;
+    }
+    return nsent;
+}
+
+#else
+
+result<size_t> datagram_socket::recv_mmsg(
+    const iovec* bufs, size_t* lens, size_t n, int flags, sockaddr* addrs,
+    size_t addrStride, socklen_t addrLen
+) {
+    size_t nrecv = 0;
+
+    while (nrecv < n) {
+        sockaddr* p = nullptr;
+        socklen_t len = 0;
+        if (addrs) {
+            p = reinterpret_cast<sockaddr*>(
+                reinterpret_cast<char*>(addrs) + nrecv * addrStride
+            );
+            len = addrLen;
+        }
+
+    #if defined(_WIN32)
+        // There's no per-call non-blocking flag on Windows, so after the
+        // first message, only continue if there's more data waiting.
+        if (nrecv != 0) {
+            u_long avail = 0;
+            if (::ioctlsocket(handle(), FIONREAD, &avail) != 0 || avail == 0)
+                break;
+        }
+        auto buf = reinterpret_cast<char*>(bufs[nrecv].iov_base);
+        ssize_t ret = ::recvfrom(handle(), buf, int(bufs[nrecv].iov_len), flags, p, &len);
+    #else
+        int fl = (nrecv == 0) ? flags : (flags | MSG_DONTWAIT);
+        ssize_t ret = ::recvfrom(handle(), bufs[nrecv].iov_base, bufs[nrecv].iov_len, fl, p, &len);
+    #endif
+        detail::stats_recv(ret);
+        auto res = check_res<ssize_t, size_t>(ret);
+
+        if (!res) {
+            if (nrecv != 0)
+                break;
+            return res;
+        }
+        lens[nrecv++] = res.value();
+    }
+    return nrecv;
+}
+
+result<size_t> datagram_socket::send_mmsg(
+    const iovec* bufs, size_t n, int flags, const sockaddr* addrs, size_t addrStride,
+    socklen_t addrLen
+) {
+    size_t nsent = 0;
+
+    while (nsent < n) {
+        const sockaddr* p = nullptr;
+        socklen_t len = 0;
+        if (addrs) {
+            p = reinterpret_cast<const sockaddr*>(
+                reinterpret_cast<const char*>(addrs) + nsent * addrStride
+            );
+            len = addrLen;
+        }
+
+    #if defined(_WIN32)
+        auto buf = reinterpret_cast<const char*>(bufs[nsent].iov_base);
+        ssize_t ret =
+            ::sendto(handle(), buf, int(bufs[nsent].iov_len), flags | MSG_NOSIGNAL, p, len);
+    #else
+        ssize_t ret = ::sendto(
+            handle(), bufs[nsent].iov_base, bufs[nsent].iov_len, flags | MSG_NOSIGNAL, p, len
+        );
+    #endif
+        detail::stats_send(ret, bufs[nsent].iov_len);
+        auto res = check_res<ssize_t, size_t>(ret);
+
+        if (!res) {
+            if (nsent != 0)
+                break;
+            return res;
+        }
+        ++nsent;
+    }
+    return nsent;
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+// Multicast
+//
+// Group membership uses the protocol-independent (RFC 3678) requests, which
+// take a full socket address for the group and source, and an interface
+// index, for both IPv4 and IPv6.
+
+result<> datagram_socket::mcast_membership(
+    bool join, const sock_address& grp, const sock_address* src, unsigned ifindex
+) {
+#if defined(MCAST_JOIN_GROUP)
+    int level;
+    switch (grp.family()) {
+        case AF_INET:
+            level = IPPROTO_IP;
+            break;
+        case AF_INET6:
+            level = IPPROTO_IPV6;
+            break;
+        default:
+            return errc::address_family_not_supported;
+    }
+
+    if (src && src->family() != grp.family())
+        return errc::invalid_argument;
+
+    if (!src) {
+        group_req req{};
+        req.gr_interface = ifindex;
+        std::memcpy(&req.gr_group, grp.sockaddr_ptr(), grp.size());
+        return set_option(level, join ? MCAST_JOIN_GROUP : MCAST_LEAVE_GROUP, req);
+    }
+
+    group_source_req req{};
+    req.gsr_interface = ifindex;
+    std::memcpy(&req.gsr_group, grp.sockaddr_ptr(), grp.size());
+    std::memcpy(&req.gsr_source, src->sockaddr_ptr(), src->size());
+    return set_option(
+        level, join ? MCAST_JOIN_SOURCE_GROUP : MCAST_LEAVE_SOURCE_GROUP, req
+    );
+#else
+    (void)join;
+    (void)grp;
+    (void)src;
+    (void)ifindex;
+    return errc::operation_not_supported;
+#endif
+}
+
+// Linux has had IPV6_MULTICAST_ALL since 4.20, which is newer than some
+// C libraries.
+#if defined(__linux__) && !defined(IPV6_MULTICAST_ALL)
+    #define IPV6_MULTICAST_ALL 29
+#endif
+
+// The BSD's (and macOS) want an unsigned char for the IPv4 TTL and loop
+// options, while everyone else uses an int.
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || \
+    defined(__OpenBSD__) || defined(__DragonFly__)
+using ip_mcast_byte_t = unsigned char;
+#else
+using ip_mcast_byte_t = int;
+#endif
+
+result<> datagram_socket::mcast_option(sa_family_t fam, mcast_opt opt, int val) {
+    if (fam == AF_INET) {
+        switch (opt) {
+            case mcast_opt::hops:
+                return set_option(IPPROTO_IP, IP_MULTICAST_TTL, ip_mcast_byte_t(val));
+            case mcast_opt::loop:
+                return set_option(IPPROTO_IP, IP_MULTICAST_LOOP, ip_mcast_byte_t(val));
+            case mcast_opt::iface: {
+#if defined(__linux__)
+                ip_mreqn req{};
+                req.imr_ifindex = val;
+                return set_option(IPPROTO_IP, IP_MULTICAST_IF, req);
+#elif defined(IP_MULTICAST_IFINDEX)
+                return set_option(IPPROTO_IP, IP_MULTICAST_IFINDEX, val);
+#elif defined(_WIN32)
+                // Windows takes an index in network byte order
+                return set_option(IPPROTO_IP, IP_MULTICAST_IF, DWORD(htonl(u_long(val))));
+#else
+                return errc::operation_not_supported;
+#endif
+            }
+            case mcast_opt::all:
+#if defined(IP_MULTICAST_ALL)
+                return set_option(IPPROTO_IP, IP_MULTICAST_ALL, val);
+#else
+                return errc::operation_not_supported;
+#endif
+        }
+    }
+    else if (fam == AF_INET6) {
+        switch (opt) {
+            case mcast_opt::hops:
+                return set_option(IPPROTO_IPV6, IPV6_MULTICAST_HOPS, val);
+            case mcast_opt::loop:
+                return set_option(IPPROTO_IPV6, IPV6_MULTICAST_LOOP, unsigned(val));
+            case mcast_opt::iface:
+                return set_option(IPPROTO_IPV6, IPV6_MULTICAST_IF, unsigned(val));
+            case mcast_opt::all:
+#if defined(IPV6_MULTICAST_ALL)
+                return set_option(IPPROTO_IPV6, IPV6_MULTICAST_ALL, val);
+#else
+                return errc::operation_not_supported;
+#endif
+        }
+    }
+    return errc::address_family_not_supported;
+}
+
+result<int> datagram_socket::mcast_option(sa_family_t fam, mcast_opt opt) const {
+    if (fam == AF_INET) {
+        switch (opt) {
+            case mcast_opt::hops: {
+                auto res = get_option<ip_mcast_byte_t>(IPPROTO_IP, IP_MULTICAST_TTL);
+                return res ? result<int>{int(res.value())} : result<int>{res.error()};
+            }
+            case mcast_opt::loop: {
+                auto res = get_option<ip_mcast_byte_t>(IPPROTO_IP, IP_MULTICAST_LOOP);
+                return res ? result<int>{int(res.value())} : result<int>{res.error()};
+            }
+            case mcast_opt::iface:
+                return errc::operation_not_supported;
+            case mcast_opt::all:
+#if defined(IP_MULTICAST_ALL)
+                return get_option<int>(IPPROTO_IP, IP_MULTICAST_ALL);
+#else
+                return errc::operation_not_supported;
+#endif
+        }
+    }
+    else if (fam == AF_INET6) {
+        switch (opt) {
+            case mcast_opt::hops:
+                return get_option<int>(IPPROTO_IPV6, IPV6_MULTICAST_HOPS);
+            case mcast_opt::loop: {
+                auto res = get_option<unsigned>(IPPROTO_IPV6, IPV6_MULTICAST_LOOP);
+                return res ? result<int>{int(res.value())} : result<int>{res.error()};
+            }
+            case mcast_opt::iface:
+                return errc::operation_not_supported;
+            case mcast_opt::all:
+#if defined(IPV6_MULTICAST_ALL)
+                return get_option<int>(IPPROTO_IPV6, IPV6_MULTICAST_ALL);
+#else
+                return errc::operation_not_supported;
+#endif
+        }
+    }
+    return errc::address_family_not_supported;
+}
+
+// --------------------------------------------------------------------------
+// UDP segmentation offload (Linux)
+
+#if defined(__linux__)
+
+result<> datagram_socket::set_gso_segment(uint16_t segSize) {
+    return set_option(SOL_UDP, UDP_SEGMENT, int(segSize));
+}
+
+result<> datagram_socket::set_gro(bool on /*=true*/) {
+    return set_option(SOL_UDP, UDP_GRO, on);
+}
+
+result<size_t> datagram_socket::send_gso(
+    const void* buf, size_t n, uint16_t segSize, int flags, const sockaddr* addr,
+    socklen_t addrLen
+) {
+    iovec iov{const_cast<void*>(buf), n};
+
+    cmsg_buffer<CMSG_SPACE(sizeof(uint16_t))> ctrl;
+    ctrl.add(SOL_UDP, UDP_SEGMENT, segSize);
+
+    msghdr msg{};
+    msg.msg_name = const_cast<sockaddr*>(addr);
+    msg.msg_namelen = addrLen;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl.data();
+    msg.msg_controllen = ctrl.size();
+
+    return send_msg(msg, flags);
+}
+
+result<size_t> datagram_socket::recv_segments_from(
+    void* buf, size_t n, size_t* segSize, sock_address* srcAddr /*=nullptr*/,
+    int flags /*=0*/
+) {
+    iovec iov{buf, n};
+
+    // Room for the GRO segment size, plus any other option that the
+    // application may have turned on for the socket.
+    cmsg_buffer<CMSG_SPACE(sizeof(int)) + 128> ctrl;
+
+    auto res = recv_msg(&iov, 1, ctrl, srcAddr, flags);
+
+    if (res && segSize) {
+        int gso = 0;
+        *segSize = cmsg_reader{ctrl}.get(SOL_UDP, UDP_GRO, gso) ? size_t(gso) : res.value();
+    }
+    return res;
+}
+
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
@@ -75,12 +75,60 @@ inet6_address::inet6_address(const string& saddr, in_port_t port, error_code& ec
 
 // --------------------------------------------------------------------------
 
-result<in6_addr> inet6_address::resolve_name(const string& saddr) noexcept {
-#if !defined(_WIN32)
+// inet_pton() needs a NUL-terminated string, so the address is copied to
+// the stack.
+
+result<in6_addr> inet6_address::parse_address(std::string_view str) noexcept {
+    char buf[INET6_ADDRSTRLEN];
+    if (str.empty() || str.size() >= sizeof(buf))
+        return errc::invalid_argument;
+
+    std::memcpy(buf, str.data(), str.size());
+    buf[str.size()] = '\0';
+
     in6_addr ia;
-    if (::inet_pton(ADDRESS_FAMILY, saddr.c_str(), &ia) == 1)
-        return ia;
-#endif
+    if (::inet_pton(ADDRESS_FAMILY, buf, &ia) != 1)
+        return errc::invalid_argument;
+    return ia;
+}
+
+// --------------------------------------------------------------------------
+
+result<inet6_address> inet6_address::parse(std::string_view str) noexcept {
+    in_port_t port = 0;
+
+    if (!str.empty() && str.front() == '[') {
+        auto pos = str.find(']');
+        if (pos == std::string_view::npos)
+            return errc::invalid_argument;
+
+        auto rest = str.substr(pos + 1);
+        if (!rest.empty()) {
+            if (rest.size() < 2 || rest.front() != ':')
+                return errc::invalid_argument;
+
+            unsigned n = 0;
+            auto end = rest.data() + rest.size();
+            auto [p, ec] = std::from_chars(rest.data() + 1, end, n);
+            if (ec != std::errc{} || p != end || n > 0xFFFF)
+                return errc::invalid_argument;
+            port = in_port_t(n);
+        }
+        str = str.substr(1, pos - 1);
+    }
+
+    auto res = parse_address(str);
+    if (!res)
+        return res.error();
+
+    return inet6_address{res.value(), port};
+}
+
+// --------------------------------------------------------------------------
+
+result<in6_addr> inet6_address::resolve_name(const string& saddr) noexcept {
+    if (auto res = parse_address(saddr); res)
+        return res;
 
     addrinfo *res, hints = addrinfo{};
     hints.ai_family = ADDRESS_FAMILY;
@@ -110,7 +158,7 @@ result<in6_addr> inet6_address::resolve_name(const string& saddr) noexcept {
 // --------------------------------------------------------------------------
 
 result<inet6_address> inet6_address::create(const string& saddr, in_port_t port) {
-    auto res = resolve_name(saddr.c_str());
+    auto res = resolve_name(saddr);
     if (!res)
         return res.error();
 
@@ -127,20 +175,39 @@ result<inet6_address> inet6_address::create(const string& saddr, in_port_t port)
 // --------------------------------------------------------------------------
 
 string inet6_address::to_string() const {
+    char buf[MAX_STR_LEN];
+    auto res = to_chars(buf, buf + sizeof(buf));
+    return string(buf, res.ptr);
+}
+
+// --------------------------------------------------------------------------
+
+std::to_chars_result inet6_address::to_chars(char* first, char* last) const noexcept {
     char buf[INET6_ADDRSTRLEN];
     auto str = inet_ntop(AF_INET6, (void*)&(addr_.sin6_addr), buf, INET6_ADDRSTRLEN);
-    return string("[") + string(str ? str : "<unknown>") +
-           "]:" + std::to_string(unsigned(port()));
+    if (!str)
+        str = "<unknown>";
+
+    size_t n = std::strlen(str);
+    if (size_t(last - first) < n + 3)
+        return {last, std::errc::value_too_large};
+
+    char* p = first;
+    *p++ = '[';
+    std::memcpy(p, str, n);
+    p += n;
+    *p++ = ']';
+    *p++ = ':';
+
+    return std::to_chars(p, last, unsigned(port()));
 }
 
 /////////////////////////////////////////////////////////////////////////////
 
 ostream& operator<<(ostream& os, const inet6_address& addr) {
-    char buf[INET6_ADDRSTRLEN];
-    auto str = inet_ntop(
-        AF_INET6, (void*)&(addr.sockaddr_in6_ptr()->sin6_addr), buf, INET6_ADDRSTRLEN
-    );
-    os << "[" << (str ? str : "<unknown>") << "]:" << unsigned(addr.port());
+    char buf[inet6_address::MAX_STR_LEN];
+    auto res = addr.to_chars(buf, buf + sizeof(buf));
+    os.write(buf, res.ptr - buf);
     return os;
 }
 
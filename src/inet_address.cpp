@@ -73,12 +73,62 @@ inet_address::inet_address(const string& saddr, in_port_t port, error_code& ec)
 
 // --------------------------------------------------------------------------
 
+result<in_addr_t> inet_address::parse_address(std::string_view str) noexcept {
+    const char *p = str.data(), *end = p + str.size();
+    uint32_t addr = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        if (i > 0) {
+            if (p == end || *p != '.')
+                return errc::invalid_argument;
+            ++p;
+        }
+
+        unsigned octet = 0;
+        auto [q, ec] = std::from_chars(p, end, octet);
+        if (ec != std::errc{} || octet > 255 || (q - p > 1 && *p == '0'))
+            return errc::invalid_argument;
+
+        addr = (addr << 8) | octet;
+        p = q;
+    }
+
+    if (p != end)
+        return errc::invalid_argument;
+
+    return in_addr_t(htonl(addr));
+}
+
+// --------------------------------------------------------------------------
+
+result<inet_address> inet_address::parse(std::string_view str) noexcept {
+    auto pos = str.find(':');
+    in_port_t port = 0;
+
+    if (pos != std::string_view::npos) {
+        auto sport = str.substr(pos + 1);
+        unsigned n = 0;
+        auto [p, ec] = std::from_chars(sport.data(), sport.data() + sport.size(), n);
+        if (sport.empty() || ec != std::errc{} || p != sport.data() + sport.size() ||
+            n > 0xFFFF)
+            return errc::invalid_argument;
+
+        port = in_port_t(n);
+        str = str.substr(0, pos);
+    }
+
+    auto res = parse_address(str);
+    if (!res)
+        return res.error();
+
+    return inet_address{ntohl(res.value()), port};
+}
+
+// --------------------------------------------------------------------------
+
 result<in_addr_t> inet_address::resolve_name(const std::string& saddr) noexcept {
-#if !defined(_WIN32)
-    in_addr ia;
-    if (::inet_pton(ADDRESS_FAMILY, saddr.c_str(), &ia) == 1)
-        return ia.s_addr;
-#endif
+    if (auto res = parse_address(saddr); res)
+        return res;
 
     addrinfo *res, hints = addrinfo{};
     hints.ai_family = ADDRESS_FAMILY;
@@ -108,7 +158,7 @@ result<in_addr_t> inet_address::resolve_name(const std::string& saddr) noexcept
 // --------------------------------------------------------------------------
 
 result<inet_address> inet_address::create(const std::string& saddr, in_port_t port) noexcept {
-    auto res = resolve_name(saddr.c_str());
+    auto res = resolve_name(saddr);
     if (!res)
         return res.error();
 
@@ -125,18 +175,43 @@ result<inet_address> inet_address::create(const std::string& saddr, in_port_t po
 // --------------------------------------------------------------------------
 
 string inet_address::to_string() const {
-    char buf[INET_ADDRSTRLEN];
-    auto str = inet_ntop(AF_INET, (void*)&(addr_.sin_addr), buf, INET_ADDRSTRLEN);
-    return std::string(str ? str : "<unknown>") + ":" + std::to_string(unsigned(port()));
+    char buf[MAX_STR_LEN];
+    auto res = to_chars(buf, buf + sizeof(buf));
+    return string(buf, res.ptr);
+}
+
+// --------------------------------------------------------------------------
+
+std::to_chars_result inet_address::to_chars(char* first, char* last) const noexcept {
+    auto addr = address();
+    char* p = first;
+
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        if (shift != 24) {
+            if (p == last)
+                return {last, std::errc::value_too_large};
+            *p++ = '.';
+        }
+
+        auto res = std::to_chars(p, last, (addr >> shift) & 0xFF);
+        if (res.ec != std::errc{})
+            return res;
+        p = res.ptr;
+    }
+
+    if (p == last)
+        return {last, std::errc::value_too_large};
+    *p++ = ':';
+
+    return std::to_chars(p, last, unsigned(port()));
 }
 
 /////////////////////////////////////////////////////////////////////////////
 
 ostream& operator<<(ostream& os, const inet_address& addr) {
-    char buf[INET_ADDRSTRLEN];
-    auto str =
-        inet_ntop(AF_INET, (void*)&(addr.sockaddr_in_ptr()->sin_addr), buf, INET_ADDRSTRLEN);
-    os << (str ? str : "<unknown>") << ":" << unsigned(addr.port());
+    char buf[inet_address::MAX_STR_LEN];
+    auto res = addr.to_chars(buf, buf + sizeof(buf));
+    os.write(buf, res.ptr - buf);
     return os;
 }
 
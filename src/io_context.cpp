@@ -0,0 +1,308 @@
+// io_context.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/io_context.h"
+
+#include <algorithm>
+
+#include "sockpp/spin_reader.h"
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+//                              io_context
+/////////////////////////////////////////////////////////////////////////////
+
+io_context::io_context() {
+    if (auto res = add_wakeup(); !res)
+        throw std::system_error{res.error()};
+}
+
+io_context::io_context(error_code& ec) noexcept : rctr_{ec}, wake_{ec} {
+    if (!ec)
+        ec = add_wakeup().error();
+}
+
+io_context::~io_context() {
+    for (auto t = posted_.exchange(nullptr); t;) {
+        auto next = t->next;
+        delete t;
+        t = next;
+    }
+    for (auto t : work_) delete t;
+
+    if (wake_.is_open())
+        (void)rctr_.remove(wake_.handle());
+}
+
+// --------------------------------------------------------------------------
+
+result<> io_context::add_wakeup() {
+    return rctr_.add(wake_.handle(), poller::READABLE, [this](uint32_t) { wake_.reset(); });
+}
+
+void io_context::wake() noexcept { wake_.notify(); }
+
+// --------------------------------------------------------------------------
+// Task queues
+
+void io_context::push_posted(task_base* t) {
+    auto head = posted_.load(std::memory_order_relaxed);
+    do {
+        t->next = head;
+    } while (!posted_.compare_exchange_weak(
+        head, t, std::memory_order_release, std::memory_order_relaxed
+    ));
+    wake();
+}
+
+bool io_context::run_posted() {
+    auto t = posted_.exchange(nullptr, std::memory_order_acquire);
+    if (!t)
+        return false;
+
+    // The stack comes out newest-first. Reverse it to run in order.
+    task_base* fifo = nullptr;
+    while (t) {
+        auto next = t->next;
+        t->next = fifo;
+        fifo = t;
+        t = next;
+    }
+
+    while (fifo) {
+        std::unique_ptr<task_base> cur{fifo};
+        fifo = fifo->next;
+        cur->run();
+    }
+    return true;
+}
+
+void io_context::push_work(task_base* t) {
+    {
+        std::lock_guard<std::mutex> lk{workMtx_};
+        work_.push_back(t);
+    }
+    wake();
+
+    // If this loop is busy, let an idle one know there's work to steal.
+    if (pool_ && !idle_) {
+        if (auto other = pool_->find_idle(this); other)
+            other->wake();
+    }
+}
+
+io_context::task_base* io_context::pop_work() {
+    std::lock_guard<std::mutex> lk{workMtx_};
+    if (work_.empty())
+        return nullptr;
+    auto t = work_.front();
+    work_.pop_front();
+    return t;
+}
+
+bool io_context::run_work() {
+    auto t = pop_work();
+    if (!t && pool_)
+        t = pool_->steal(this);
+    if (!t)
+        return false;
+
+    std::unique_ptr<task_base>{t}->run();
+    return true;
+}
+
+bool io_context::has_work() const {
+    if (posted_.load(std::memory_order_acquire))
+        return true;
+    std::lock_guard<std::mutex> lk{workMtx_};
+    return !work_.empty();
+}
+
+// --------------------------------------------------------------------------
+// The loop runs the queued functions, then polls for I/O. It only blocks
+// in the poll when there's nothing left to run, and marks itself idle
+// first, then checks the queues once more, so that work which arrived in
+// between isn't left waiting.
+
+result<> io_context::run() {
+    owner_ = std::this_thread::get_id();
+
+    while (!stopped_) {
+        bool busy = run_posted();
+        busy = run_work() || busy;
+
+        auto timeout = milliseconds(0);
+        if (!busy) {
+            idle_ = true;
+            if (!has_work() && !stopped_)
+                timeout = milliseconds(-1);
+        }
+
+        auto res = rctr_.run_once(timeout);
+        idle_ = false;
+        load_.store(rctr_.size() - 1, std::memory_order_relaxed);
+
+        if (!res) {
+            owner_ = std::thread::id{};
+            return res.error();
+        }
+    }
+
+    owner_ = std::thread::id{};
+    return none{};
+}
+
+void io_context::stop() noexcept {
+    stopped_ = true;
+    wake();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//                            io_context_pool
+/////////////////////////////////////////////////////////////////////////////
+
+io_context_pool::io_context_pool(size_t n /*=default_size()*/) {
+    ctxs_.reserve(std::max<size_t>(n, 1));
+    for (size_t i = 0; i < std::max<size_t>(n, 1); ++i) {
+        ctxs_.push_back(std::make_unique<io_context>());
+        ctxs_.back()->pool_ = this;
+    }
+}
+
+io_context_pool::~io_context_pool() {
+    stop();
+    join();
+}
+
+// The CPU is recorded before the thread starts, so that connections can be
+// placed right away. A failure to pin doesn't stop the loop.
+
+void io_context_pool::start(bool pinToCpus /*=false*/) {
+    size_t ncpu = std::thread::hardware_concurrency();
+
+    for (size_t i = 0; i < ctxs_.size(); ++i) {
+        auto p = ctxs_[i].get();
+        p->restart();
+#if defined(__linux__)
+        if (pinToCpus && i < ncpu)
+            p->cpu_ = int(i);
+#else
+        (void)pinToCpus;
+        (void)ncpu;
+#endif
+        threads_.emplace_back([p] {
+            if (p->cpu_ >= 0)
+                (void)spin_reader::pin_thread(p->cpu_);
+            (void)p->run();
+        });
+    }
+}
+
+void io_context_pool::stop() noexcept {
+    for (auto& ctx : ctxs_) ctx->stop();
+}
+
+void io_context_pool::join() {
+    for (auto& thr : threads_) {
+        if (thr.joinable())
+            thr.join();
+    }
+    threads_.clear();
+}
+
+io_context& io_context_pool::least_loaded() noexcept {
+    auto it = std::min_element(ctxs_.begin(), ctxs_.end(), [](const auto& a, const auto& b) {
+        return a->load() < b->load();
+    });
+    return **it;
+}
+
+io_context& io_context_pool::place(const socket& sock) noexcept {
+    switch (placement_) {
+        case placement::least_loaded:
+            return least_loaded();
+
+        case placement::incoming_cpu:
+            if (auto res = sock.incoming_cpu(); res && res.value() >= 0)
+                return for_cpu(res.value());
+            break;
+
+        case placement::napi_id:
+            if (auto res = sock.napi_id(); res && res.value() != 0)
+                return *ctxs_[res.value() % ctxs_.size()];
+            break;
+
+        default:
+            break;
+    }
+    return next();
+}
+
+io_context* io_context_pool::find_idle(const io_context* self) const {
+    for (const auto& ctx : ctxs_) {
+        if (ctx.get() != self && ctx->idle_)
+            return ctx.get();
+    }
+    return nullptr;
+}
+
+// Victims are tried in order starting after the thief, so that the loops
+// don't all pile onto the first one.
+
+io_context::task_base* io_context_pool::steal(const io_context* self) {
+    size_t n = ctxs_.size(), i0 = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (ctxs_[i].get() == self)
+            i0 = i;
+    }
+
+    for (size_t i = 1; i < n; ++i) {
+        auto victim = ctxs_[(i0 + i) % n].get();
+        std::unique_lock<std::mutex> lk{victim->workMtx_, std::try_to_lock};
+        if (lk && !victim->work_.empty()) {
+            auto t = victim->work_.back();
+            victim->work_.pop_back();
+            return t;
+        }
+    }
+    return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,257 @@
+// can_bcm_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/can_bcm_socket.h"
+
+#include <type_traits>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+// The frames go to the kernel as arrays of the C structs.
+static_assert(sizeof(can_frame) == sizeof(::can_frame), "can_frame size mismatch");
+static_assert(sizeof(canfd_frame) == sizeof(::canfd_frame), "canfd_frame size mismatch");
+
+namespace {
+
+bcm_timeval to_bcm_timeval(microseconds us) {
+    auto tv = to_timeval(us);
+    return bcm_timeval{long(tv.tv_sec), long(tv.tv_usec)};
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+result<> can_bcm_socket::open(const can_address& addr) noexcept {
+    if (auto createRes = create_handle(PROTOCOL_FAMILY, COMM_TYPE, CAN_BCM); !createRes) {
+        return createRes.error();
+    }
+    else {
+        reset(createRes.value());
+        auto ret = ::connect(handle(), addr.sockaddr_ptr(), addr.size());
+        if (auto res = check_res_none(ret); !res) {
+            close();
+            return res;
+        }
+    }
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+// The broadcast manager wants each operation in a single write, with the
+// frames right after the head. The head is gathered with the frames, so
+// they don't need to be copied into one buffer.
+
+template <typename FRAME>
+result<> can_bcm_socket::send_op(bcm_msg_head& head, const FRAME* frames, size_t n) {
+    head.nframes = uint32_t(n);
+    if constexpr (std::is_same_v<FRAME, canfd_frame>)
+        head.flags |= CAN_FD_FRAME;
+
+    iovec iov[2]{
+        {&head, sizeof(head)}, {const_cast<FRAME*>(frames), n * sizeof(FRAME)}
+    };
+
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = (n != 0) ? 2 : 1;
+
+    if (auto res = send_msg(msg); !res)
+        return res.error();
+    return none{};
+}
+
+template <typename FRAME>
+result<size_t> can_bcm_socket::recv_op(bcm_msg_head& head, FRAME* frames, size_t n) {
+    iovec iov[2]{{&head, sizeof(head)}, {frames, n * sizeof(FRAME)}};
+
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    auto res = recv_msg(msg);
+    if (!res)
+        return res;
+    if (res.value() < sizeof(head))
+        return errc::bad_message;
+
+    size_t nframes = (res.value() - sizeof(head)) / sizeof(FRAME);
+
+    // The frames of an FD job are all FD frames
+    if constexpr (std::is_same_v<FRAME, canfd_frame>) {
+        for (size_t i = 0; i < nframes; ++i) frames[i].flags |= CANFD_FDF;
+    }
+    return nframes;
+}
+
+// --------------------------------------------------------------------------
+
+template <typename FRAME>
+result<> can_bcm_socket::tx_setup_op(
+    const FRAME* frames, size_t n, microseconds interval, uint32_t count,
+    microseconds initInterval, uint32_t flags
+) {
+    if (!frames || n == 0)
+        return errc::invalid_argument;
+
+    bcm_msg_head head{};
+    head.opcode = TX_SETUP;
+    head.flags = flags | SETTIMER | STARTTIMER;
+    head.count = count;
+    head.ival1 = to_bcm_timeval(initInterval);
+    head.ival2 = to_bcm_timeval(interval);
+    head.can_id = frames[0].can_id;
+
+    return send_op(head, frames, n);
+}
+
+result<> can_bcm_socket::tx_setup(
+    const can_frame* frames, size_t n, microseconds interval, uint32_t count /*=0*/,
+    microseconds initInterval /*=0*/, uint32_t flags /*=0*/
+) {
+    return tx_setup_op(frames, n, interval, count, initInterval, flags);
+}
+
+result<> can_bcm_socket::tx_setup(
+    const canfd_frame* frames, size_t n, microseconds interval, uint32_t count /*=0*/,
+    microseconds initInterval /*=0*/, uint32_t flags /*=0*/
+) {
+    return tx_setup_op(frames, n, interval, count, initInterval, flags);
+}
+
+// Without SETTIMER, a setup for an existing job just replaces its frames.
+
+result<> can_bcm_socket::tx_update(const can_frame& frame) {
+    bcm_msg_head head{};
+    head.opcode = TX_SETUP;
+    head.can_id = frame.can_id;
+    return send_op(head, &frame, 1);
+}
+
+result<> can_bcm_socket::tx_update(const canfd_frame& frame) {
+    bcm_msg_head head{};
+    head.opcode = TX_SETUP;
+    head.can_id = frame.can_id;
+    return send_op(head, &frame, 1);
+}
+
+result<> can_bcm_socket::tx_delete(canid_t canID, bool fd /*=false*/) {
+    bcm_msg_head head{};
+    head.opcode = TX_DELETE;
+    head.flags = fd ? CAN_FD_FRAME : 0;
+    head.can_id = canID;
+    return send_op(head, static_cast<const can_frame*>(nullptr), 0);
+}
+
+result<> can_bcm_socket::tx_send(const can_frame& frame) {
+    bcm_msg_head head{};
+    head.opcode = TX_SEND;
+    head.can_id = frame.can_id;
+    return send_op(head, &frame, 1);
+}
+
+result<> can_bcm_socket::tx_send(const canfd_frame& frame) {
+    bcm_msg_head head{};
+    head.opcode = TX_SEND;
+    head.can_id = frame.can_id;
+    return send_op(head, &frame, 1);
+}
+
+// --------------------------------------------------------------------------
+
+template <typename FRAME>
+result<> can_bcm_socket::rx_setup_op(
+    canid_t canID, const FRAME* masks, size_t n, microseconds timeout,
+    microseconds throttle, uint32_t flags
+) {
+    bcm_msg_head head{};
+    head.opcode = RX_SETUP;
+    head.flags = flags;
+    head.can_id = canID;
+
+    if (!masks || n == 0) {
+        head.flags |= RX_FILTER_ID;
+        n = 0;
+    }
+
+    if (timeout.count() != 0 || throttle.count() != 0) {
+        head.flags |= SETTIMER | STARTTIMER;
+        head.ival1 = to_bcm_timeval(timeout);
+        head.ival2 = to_bcm_timeval(throttle);
+    }
+
+    return send_op(head, masks, n);
+}
+
+result<> can_bcm_socket::rx_setup(
+    canid_t canID, const can_frame* masks, size_t n, microseconds timeout /*=0*/,
+    microseconds throttle /*=0*/, uint32_t flags /*=0*/
+) {
+    return rx_setup_op(canID, masks, n, timeout, throttle, flags);
+}
+
+result<> can_bcm_socket::rx_setup(
+    canid_t canID, const canfd_frame* masks, size_t n, microseconds timeout /*=0*/,
+    microseconds throttle /*=0*/, uint32_t flags /*=0*/
+) {
+    return rx_setup_op(canID, masks, n, timeout, throttle, flags);
+}
+
+result<> can_bcm_socket::rx_delete(canid_t canID, bool fd /*=false*/) {
+    bcm_msg_head head{};
+    head.opcode = RX_DELETE;
+    head.flags = fd ? CAN_FD_FRAME : 0;
+    head.can_id = canID;
+    return send_op(head, static_cast<const can_frame*>(nullptr), 0);
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> can_bcm_socket::recv(bcm_msg_head& head, can_frame* frames, size_t n) {
+    return recv_op(head, frames, n);
+}
+
+result<size_t> can_bcm_socket::recv(bcm_msg_head& head, canfd_frame* frames, size_t n) {
+    return recv_op(head, frames, n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
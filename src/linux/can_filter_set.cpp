@@ -0,0 +1,247 @@
+// can_filter_set.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/can_filter_set.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+// The filters are found with a Quine-McCluskey style reduction. Each ID
+// range is split into aligned, power-of-two blocks, which are terms with
+// some number of low "don't care" bits. Terms with the same don't-care
+// bits that differ in exactly one other bit are merged, repeatedly, until
+// nothing else can be merged. What's left are the prime terms, and a
+// greedy pass picks enough of them to cover the original blocks.
+
+namespace {
+
+// A set of ID's as a value and the mask of bits that don't matter.
+struct term
+{
+    canid_t val;
+    canid_t dc;
+
+    bool operator<(const term& rhs) const {
+        return (dc < rhs.dc) || (dc == rhs.dc && val < rhs.val);
+    }
+    bool covers(const term& t) const {
+        return (t.dc & ~dc) == 0 && (t.val & ~dc) == (val & ~dc);
+    }
+};
+
+using range = pair<canid_t, canid_t>;
+
+// Sorts the ranges and joins any that overlap or touch.
+vector<range> merge_ranges(vector<range> v) {
+    sort(v.begin(), v.end());
+
+    vector<range> merged;
+    for (const auto& r : v) {
+        if (!merged.empty() && uint64_t(r.first) <= uint64_t(merged.back().second) + 1)
+            merged.back().second = max(merged.back().second, r.second);
+        else
+            merged.push_back(r);
+    }
+    return merged;
+}
+
+// Splits the ranges into aligned power-of-two blocks.
+set<term> to_blocks(const vector<range>& ranges) {
+    set<term> blocks;
+    for (const auto& r : ranges) {
+        uint64_t lo = r.first, hi = r.second;
+        while (lo <= hi) {
+            uint64_t sz = (lo == 0) ? (uint64_t(1) << 32) : (lo & (~lo + 1));
+            while (lo + sz - 1 > hi) sz >>= 1;
+            blocks.insert(term{canid_t(lo), canid_t(sz - 1)});
+            lo += sz;
+        }
+    }
+    return blocks;
+}
+
+// Finds the prime terms by merging adjacent terms until none are left.
+vector<term> find_primes(set<term> terms, canid_t idMask) {
+    vector<term> primes;
+
+    while (!terms.empty()) {
+        set<term> next, used;
+        for (const auto& t : terms) {
+            for (canid_t bit = 1; bit && bit <= idMask; bit <<= 1) {
+                if ((t.dc & bit) || (t.val & bit))
+                    continue;
+                term mate{t.val | bit, t.dc};
+                if (terms.count(mate)) {
+                    next.insert(term{t.val, t.dc | bit});
+                    used.insert(t);
+                    used.insert(mate);
+                }
+            }
+        }
+        for (const auto& t : terms) {
+            if (!used.count(t))
+                primes.push_back(t);
+        }
+        terms = std::move(next);
+    }
+    return primes;
+}
+
+// Picks primes to cover all the blocks: the essential ones first, then
+// whichever covers the most blocks that are still uncovered.
+vector<term> select_cover(const vector<term>& primes, const set<term>& blockSet) {
+    vector<term> blocks(blockSet.begin(), blockSet.end());
+    size_t nb = blocks.size(), np = primes.size();
+
+    vector<vector<size_t>> covered(np);
+    vector<size_t> ncover(nb, 0), only(nb, 0);
+
+    for (size_t p = 0; p < np; ++p) {
+        for (size_t b = 0; b < nb; ++b) {
+            if (primes[p].covers(blocks[b])) {
+                covered[p].push_back(b);
+                ++ncover[b];
+                only[b] = p;
+            }
+        }
+    }
+
+    vector<bool> done(nb, false), taken(np, false);
+    vector<term> cover;
+    size_t nleft = nb;
+
+    auto take = [&](size_t p) {
+        taken[p] = true;
+        cover.push_back(primes[p]);
+        for (auto b : covered[p]) {
+            if (!done[b]) {
+                done[b] = true;
+                --nleft;
+            }
+        }
+    };
+
+    for (size_t b = 0; b < nb; ++b) {
+        if (ncover[b] == 1 && !taken[only[b]])
+            take(only[b]);
+    }
+
+    while (nleft > 0) {
+        size_t best = np, bestN = 0;
+        for (size_t p = 0; p < np; ++p) {
+            if (taken[p])
+                continue;
+            size_t n = count_if(covered[p].begin(), covered[p].end(), [&](size_t b) {
+                return !done[b];
+            });
+            if (n > bestN) {
+                best = p;
+                bestN = n;
+            }
+        }
+        take(best);
+    }
+    return cover;
+}
+
+// Compiles one group of ID's into filters.
+void compile_ranges(
+    vector<can_filter>& filters, const vector<range>& ranges, canid_t idMask, canid_t flag
+) {
+    if (ranges.empty())
+        return;
+
+    auto blocks = to_blocks(merge_ranges(ranges));
+    auto cover = select_cover(find_primes(blocks, idMask), blocks);
+
+    // The EFF flag is always in the mask, so that a standard filter
+    // doesn't accept extended frames and vice versa.
+    for (const auto& t : cover)
+        filters.push_back(can_filter{t.val | flag, (~t.dc & idMask) | CAN_EFF_FLAG});
+}
+
+bool in_ranges(const vector<range>& ranges, canid_t id) {
+    return any_of(ranges.begin(), ranges.end(), [id](const range& r) {
+        return r.first <= id && id <= r.second;
+    });
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+can_filter_set::can_filter_set(std::initializer_list<canid_t> ids) {
+    for (auto id : ids) add(id);
+}
+
+can_filter_set& can_filter_set::add(canid_t first, canid_t last) {
+    if (first & CAN_EFF_FLAG) {
+        first &= CAN_EFF_MASK;
+        last &= CAN_EFF_MASK;
+        if (first <= last)
+            eff_.emplace_back(first, last);
+    }
+    else {
+        first &= CAN_SFF_MASK;
+        last &= CAN_SFF_MASK;
+        if (first <= last)
+            sff_.emplace_back(first, last);
+    }
+    return *this;
+}
+
+bool can_filter_set::contains(canid_t id) const {
+    if (id & CAN_EFF_FLAG)
+        return in_ranges(eff_, id & CAN_EFF_MASK);
+    return in_ranges(sff_, id & CAN_SFF_MASK);
+}
+
+vector<can_filter> can_filter_set::compile() const {
+    vector<can_filter> filters;
+    compile_ranges(filters, sff_, CAN_SFF_MASK, 0);
+    compile_ranges(filters, eff_, CAN_EFF_MASK, CAN_EFF_FLAG);
+    return filters;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,80 @@
+// can_ring_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/can_ring_socket.h"
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+result<> can_ring_socket::open(
+    const can_address& addr, size_t blockSize, size_t nBlocks, milliseconds retireTimeout
+) noexcept {
+    if (nBlocks == 0)
+        return errc::invalid_argument;
+
+    packet_ring_params params;
+    params.block_size = blockSize;
+    params.rx_blocks = nBlocks;
+    params.retire_timeout = retireTimeout;
+
+    return base::open(packet_address{unsigned(addr.index())}, params);
+}
+
+// --------------------------------------------------------------------------
+
+bool can_ring_socket::get_frame(const packet& pkt, canfd_frame& frame) noexcept {
+    // The local sends come back around as received frames, so just report
+    // them the one time.
+    if (pkt.outgoing())
+        return false;
+
+    if (pkt.size() == CANFD_MTU) {
+        frame = canfd_frame{*reinterpret_cast<const ::canfd_frame*>(pkt.data())};
+        frame.flags |= CANFD_FDF;
+        return true;
+    }
+    if (pkt.size() == CAN_MTU) {
+        frame = canfd_frame{*reinterpret_cast<const ::can_frame*>(pkt.data())};
+        return true;
+    }
+    return false;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
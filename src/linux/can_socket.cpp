@@ -36,10 +36,16 @@
 
 #include "sockpp/can_socket.h"
 
+#include <linux/errqueue.h>
 #include <linux/sockios.h>
 #include <sys/ioctl.h>
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 #include "sockpp/socket.h"
+#include "../stats.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -48,8 +54,8 @@ namespace sockpp {
 
 /////////////////////////////////////////////////////////////////////////////
 
-result<> can_socket::open(const can_address& addr) noexcept {
-    if (auto createRes = create_handle(SOCK_RAW, CAN_RAW); !createRes) {
+result<> can_socket::open(const can_address& addr, int flags /*=0*/) noexcept {
+    if (auto createRes = create_handle(SOCK_RAW, CAN_RAW, flags); !createRes) {
         return createRes.error();
     }
     else {
@@ -78,6 +84,142 @@ double can_socket::last_frame_timestamp() {
     return double(tv.tv_sec) + 1.0e-6 * tv.tv_usec;
 }
 
+// --------------------------------------------------------------------------
+// Batched I/O
+//
+// Like the datagram sockets, this uses a fixed array of headers on the
+// stack, so larger batches are done in chunks. Each frame gets its own
+// control buffer, for its timestamps.
+
+namespace {
+
+constexpr size_t MMSG_CHUNK = 64;
+
+// Room for the timestamps, plus any other option that the
+// application may have turned on for the socket.
+constexpr size_t CTRL_SIZE = CMSG_SPACE(sizeof(scm_timestamping)) + 64;
+
+// The number of bytes that a frame takes on the socket
+size_t frame_size(const can_frame&) { return CAN_MTU; }
+size_t frame_size(const canfd_frame& frame) { return frame.mtu(); }
+
+// The size of the buffer to read a frame
+constexpr size_t frame_capacity(const can_frame*) { return CAN_MTU; }
+constexpr size_t frame_capacity(const canfd_frame*) { return CANFD_MTU; }
+
+}  // namespace
+
+template <typename FRAME>
+result<size_t> can_socket::recv_frames(
+    FRAME* frames, size_t n, packet_timestamp* ts, int flags
+) {
+    mmsghdr msgs[MMSG_CHUNK];
+    iovec iovs[MMSG_CHUNK];
+    alignas(cmsghdr) char ctrl[MMSG_CHUNK][CTRL_SIZE];
+    size_t nrecv = 0;
+
+    while (nrecv < n) {
+        size_t nchunk = std::min(n - nrecv, MMSG_CHUNK);
+        std::memset(msgs, 0, nchunk * sizeof(mmsghdr));
+
+        for (size_t i = 0; i < nchunk; ++i) {
+            iovs[i] = iovec{&frames[nrecv + i], frame_capacity(frames)};
+            auto& hdr = msgs[i].msg_hdr;
+            hdr.msg_iov = &iovs[i];
+            hdr.msg_iovlen = 1;
+            if (ts) {
+                hdr.msg_control = ctrl[i];
+                hdr.msg_controllen = CTRL_SIZE;
+            }
+        }
+
+        // Only the first chunk is allowed to block, and only until a
+        // single frame arrives. After that, take what's there.
+        int fl = flags | ((nrecv == 0) ? MSG_WAITFORONE : MSG_DONTWAIT);
+        int ret = ::recvmmsg(handle(), msgs, unsigned(nchunk), fl, nullptr);
+        detail::stats_recv_batch(ret, msgs);
+
+        if (ret < 0) {
+            if (nrecv != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+
+        for (int i = 0; i < ret; ++i) {
+            if constexpr (std::is_same_v<FRAME, canfd_frame>)
+                mark_fd(&frames[nrecv + i], size_t(msgs[i].msg_len));
+
+            if (ts) {
+                auto& pts = ts[nrecv + i];
+                pts = packet_timestamp{};
+                cmsg_reader rdr{msgs[i].msg_hdr};
+                for (auto cmsg = rdr.first(); cmsg; cmsg = rdr.next(cmsg))
+                    get_timestamps(cmsg, pts);
+            }
+        }
+
+        nrecv += size_t(ret);
+        if (size_t(ret) < nchunk)
+            break;
+    }
+    return nrecv;
+}
+
+template <typename FRAME>
+result<size_t> can_socket::send_frames(const FRAME* frames, size_t n, int flags) {
+    mmsghdr msgs[MMSG_CHUNK];
+    iovec iovs[MMSG_CHUNK];
+    size_t nsent = 0;
+
+    while (nsent < n) {
+        size_t nchunk = std::min(n - nsent, MMSG_CHUNK);
+        std::memset(msgs, 0, nchunk * sizeof(mmsghdr));
+
+        for (size_t i = 0; i < nchunk; ++i) {
+            auto& frame = frames[nsent + i];
+            iovs[i] = iovec{const_cast<FRAME*>(&frame), frame_size(frame)};
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int ret = ::sendmmsg(handle(), msgs, unsigned(nchunk), flags);
+        detail::stats_send_batch(ret, msgs, nchunk);
+
+        if (ret < 0) {
+            if (nsent != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+
+        nsent += size_t(ret);
+        if (size_t(ret) < nchunk)
+            break;
+    }
+    return nsent;
+}
+
+result<size_t> can_socket::recv_many(
+    can_frame* frames, size_t n, packet_timestamp* ts /*=nullptr*/, int flags /*=0*/
+) {
+    return recv_frames(frames, n, ts, flags);
+}
+
+result<size_t> can_socket::recv_many(
+    canfd_frame* frames, size_t n, packet_timestamp* ts /*=nullptr*/, int flags /*=0*/
+) {
+    return recv_frames(frames, n, ts, flags);
+}
+
+result<size_t> can_socket::send_many(const can_frame* frames, size_t n, int flags /*=0*/) {
+    return send_frames(frames, n, flags);
+}
+
+result<size_t> can_socket::send_many(
+    const canfd_frame* frames, size_t n, int flags /*=0*/
+) {
+    return send_frames(frames, n, flags);
+}
+
 // --------------------------------------------------------------------------
 
 #if 0
@@ -0,0 +1,112 @@
+// packet_address.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/packet_address.h"
+
+#include <net/if.h>
+
+#include "sockpp/socket.h"
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+constexpr sa_family_t packet_address::ADDRESS_FAMILY;
+
+// --------------------------------------------------------------------------
+
+packet_address::packet_address(unsigned idx, uint16_t protocol /*=ETH_P_ALL*/) noexcept {
+    addr_.sll_family = ADDRESS_FAMILY;
+    addr_.sll_protocol = htons(protocol);
+    addr_.sll_ifindex = int(idx);
+}
+
+packet_address::packet_address(const string& iface, uint16_t protocol /*=ETH_P_ALL*/) {
+    unsigned idx = ::if_nametoindex(iface.c_str());
+
+    if (idx == 0)
+        throw system_error{result<>::last_error()};
+
+    addr_.sll_family = ADDRESS_FAMILY;
+    addr_.sll_protocol = htons(protocol);
+    addr_.sll_ifindex = int(idx);
+}
+
+result<packet_address> packet_address::create(
+    const string& iface, uint16_t protocol /*=ETH_P_ALL*/
+) {
+    unsigned idx = ::if_nametoindex(iface.c_str());
+
+    if (idx == 0)
+        return result<packet_address>::from_last_error();
+
+    return packet_address{idx, protocol};
+}
+
+// --------------------------------------------------------------------------
+
+result<string> packet_address::get_iface() const noexcept {
+    if (addr_.sll_family == AF_UNSPEC)
+        return string{};
+
+    if (addr_.sll_ifindex == 0)
+        return string{"any"};
+
+    char buf[IF_NAMESIZE];
+    const char* iface = if_indextoname(unsigned(addr_.sll_ifindex), buf);
+
+    if (!iface)
+        return result<string>::from_last_error();
+
+    return string{iface};
+}
+
+string packet_address::iface() const noexcept {
+    auto res = get_iface();
+    return res ? res.value() : string{"unknown"};
+}
+
+// --------------------------------------------------------------------------
+
+ostream& operator<<(ostream& os, const packet_address& addr) {
+    os << "packet:" << addr.iface();
+    return os;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,317 @@
+// packet_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/packet_socket.h"
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Where the data goes in a transmit frame, when the kernel isn't told of
+// an offset.
+constexpr size_t TX_DATA_OFF = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+packet_socket::packet_socket(packet_socket&& other) noexcept
+    : base(std::move(other)),
+      ring_{other.ring_},
+      ringSize_{other.ringSize_},
+      blockSize_{other.blockSize_},
+      nBlocks_{other.nBlocks_},
+      curBlock_{other.curBlock_},
+      tx_{other.tx_},
+      frameSize_{other.frameSize_},
+      nFrames_{other.nFrames_},
+      curFrame_{other.curFrame_} {
+    other.ring_ = other.tx_ = nullptr;
+    other.ringSize_ = 0;
+    other.blockSize_ = other.nBlocks_ = other.curBlock_ = 0;
+    other.frameSize_ = other.nFrames_ = other.curFrame_ = 0;
+}
+
+packet_socket& packet_socket::operator=(packet_socket&& rhs) noexcept {
+    if (&rhs != this) {
+        unmap();
+        base::operator=(std::move(rhs));
+
+        std::swap(ring_, rhs.ring_);
+        std::swap(ringSize_, rhs.ringSize_);
+        std::swap(blockSize_, rhs.blockSize_);
+        std::swap(nBlocks_, rhs.nBlocks_);
+        std::swap(curBlock_, rhs.curBlock_);
+        std::swap(tx_, rhs.tx_);
+        std::swap(frameSize_, rhs.frameSize_);
+        std::swap(nFrames_, rhs.nFrames_);
+        std::swap(curFrame_, rhs.curFrame_);
+    }
+    return *this;
+}
+
+// --------------------------------------------------------------------------
+
+result<packet_socket> packet_socket::create(uint16_t protocol /*=ETH_P_ALL*/) {
+    if (auto res = create_handle(AF_PACKET, htons(protocol)); !res)
+        return res.error();
+    else
+        return packet_socket{res.value()};
+}
+
+result<> packet_socket::open(const packet_address& addr) noexcept {
+    return open(addr, packet_ring_params{0, 0, milliseconds{0}, 0, 0});
+}
+
+result<> packet_socket::open(
+    const packet_address& addr, const packet_ring_params& params
+) noexcept {
+    close();
+
+    auto createRes = create_handle(AF_PACKET, htons(addr.protocol()));
+    if (!createRes)
+        return createRes.error();
+    reset(createRes.value());
+
+    if (params.rx_blocks != 0 || params.tx_frames != 0) {
+        if (auto res = map_rings(params); !res) {
+            close();
+            return res;
+        }
+    }
+
+    if (auto res = bind(addr); !res) {
+        close();
+        return res;
+    }
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<> packet_socket::map_rings(const packet_ring_params& params) noexcept {
+    const size_t PAGE_SZ = size_t(::getpagesize());
+
+    size_t blockSize = params.block_size;
+    if (blockSize == 0 || blockSize % PAGE_SZ != 0)
+        return errc::invalid_argument;
+
+    if (params.tx_frames != 0) {
+        size_t frameSize = params.tx_frame_size;
+        if (frameSize <= TX_DATA_OFF || frameSize % TPACKET_ALIGNMENT != 0 ||
+            blockSize % frameSize != 0)
+            return errc::invalid_argument;
+    }
+
+    if (auto res = set_option(SOL_PACKET, PACKET_VERSION, int(TPACKET_V3)); !res)
+        return res;
+
+    size_t rxSize = 0, txSize = 0;
+
+    if (params.rx_blocks != 0) {
+        // With V3, the packets are packed into the blocks, so the frame
+        // size only matters to the kernel's sanity checks.
+        const unsigned FRAME_SIZE = TPACKET_ALIGNMENT << 7;
+
+        tpacket_req3 req{};
+        req.tp_block_size = unsigned(blockSize);
+        req.tp_block_nr = unsigned(params.rx_blocks);
+        req.tp_frame_size = FRAME_SIZE;
+        req.tp_frame_nr = unsigned(blockSize / FRAME_SIZE * params.rx_blocks);
+        req.tp_retire_blk_tov = unsigned(params.retire_timeout.count());
+        req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+
+        if (auto res = set_option(SOL_PACKET, PACKET_RX_RING, req); !res)
+            return res;
+        rxSize = blockSize * params.rx_blocks;
+    }
+
+    if (params.tx_frames != 0) {
+        size_t perBlock = blockSize / params.tx_frame_size,
+               nBlocks = (params.tx_frames + perBlock - 1) / perBlock;
+
+        tpacket_req3 req{};
+        req.tp_block_size = unsigned(blockSize);
+        req.tp_block_nr = unsigned(nBlocks);
+        req.tp_frame_size = unsigned(params.tx_frame_size);
+        req.tp_frame_nr = unsigned(perBlock * nBlocks);
+
+        if (auto res = set_option(SOL_PACKET, PACKET_TX_RING, req); !res)
+            return res;
+        txSize = blockSize * nBlocks;
+        nFrames_ = perBlock * nBlocks;
+        frameSize_ = params.tx_frame_size;
+    }
+
+    // Both rings are in one mapping, receive first.
+    ringSize_ = rxSize + txSize;
+    void* p = ::mmap(
+        nullptr, ringSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, handle(), 0
+    );
+    if (p == MAP_FAILED) {
+        // Locking the pages might be beyond our limits. Try without.
+        p = ::mmap(nullptr, ringSize_, PROT_READ | PROT_WRITE, MAP_SHARED, handle(), 0);
+        if (p == MAP_FAILED) {
+            auto ec = result<>::last_error();
+            unmap();
+            return ec;
+        }
+    }
+
+    ring_ = static_cast<char*>(p);
+    if (rxSize != 0) {
+        blockSize_ = blockSize;
+        nBlocks_ = params.rx_blocks;
+    }
+    if (txSize != 0)
+        tx_ = ring_ + rxSize;
+
+    return none{};
+}
+
+void packet_socket::unmap() noexcept {
+    if (ring_)
+        ::munmap(ring_, ringSize_);
+
+    ring_ = tx_ = nullptr;
+    ringSize_ = 0;
+    blockSize_ = nBlocks_ = curBlock_ = 0;
+    frameSize_ = nFrames_ = curFrame_ = 0;
+}
+
+result<> packet_socket::close() {
+    unmap();
+    return base::close();
+}
+
+// --------------------------------------------------------------------------
+
+result<> packet_socket::fanout(
+    uint16_t groupID, uint16_t mode /*=PACKET_FANOUT_HASH*/, uint16_t flags /*=0*/
+) {
+    int val = int(groupID) | (int(mode | flags) << 16);
+    return set_option(SOL_PACKET, PACKET_FANOUT, val);
+}
+
+// --------------------------------------------------------------------------
+
+result<tpacket_block_desc*> packet_socket::wait_block(milliseconds timeout) {
+    if (nBlocks_ == 0)
+        return errc::bad_file_descriptor;
+
+    auto status = &block(curBlock_)->hdr.bh1.block_status;
+
+    pollfd pfd{handle(), POLLIN | POLLERR, 0};
+    int ms = timeout.count() < 0 ? -1 : int(timeout.count());
+
+    while ((__atomic_load_n(status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+        int n = ::poll(&pfd, 1, ms);
+        if (n < 0)
+            return result<tpacket_block_desc*>::from_last_error();
+        if (n == 0)
+            return nullptr;
+    }
+    return block(curBlock_);
+}
+
+void packet_socket::release_block() noexcept {
+    auto status = &block(curBlock_)->hdr.bh1.block_status;
+    __atomic_store_n(status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    curBlock_ = (curBlock_ + 1) % nBlocks_;
+}
+
+// --------------------------------------------------------------------------
+
+size_t packet_socket::tx_max_size() const {
+    return (frameSize_ > TX_DATA_OFF) ? (frameSize_ - TX_DATA_OFF) : 0;
+}
+
+result<> packet_socket::tx_queue(const void* buf, size_t n) {
+    if (nFrames_ == 0)
+        return errc::bad_file_descriptor;
+
+    if (n > tx_max_size())
+        return errc::message_size;
+
+    auto hdr = frame(curFrame_);
+    auto status = __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE);
+
+    // A frame that the kernel rejected is reported as an error, but is
+    // then free to use again.
+    if (status == TP_STATUS_WRONG_FORMAT) {
+        __atomic_store_n(&hdr->tp_status, TP_STATUS_AVAILABLE, __ATOMIC_RELEASE);
+        return errc::invalid_argument;
+    }
+    if (status != TP_STATUS_AVAILABLE)
+        return errc::no_buffer_space;
+
+    std::memcpy(reinterpret_cast<char*>(hdr) + TX_DATA_OFF, buf, n);
+    hdr->tp_len = uint32_t(n);
+    hdr->tp_snaplen = uint32_t(n);
+    hdr->tp_next_offset = 0;
+
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+    curFrame_ = (curFrame_ + 1) % nFrames_;
+    return none{};
+}
+
+result<size_t> packet_socket::tx_flush(bool wait /*=false*/) {
+    if (nFrames_ == 0)
+        return errc::bad_file_descriptor;
+
+    auto n = ::send(handle(), nullptr, 0, wait ? 0 : MSG_DONTWAIT);
+    if (n < 0) {
+        // Some frames are still in flight. They'll be sent.
+        auto ec = result<>::last_error();
+        if (ec == errc::resource_unavailable_try_again)
+            return size_t(0);
+        return ec;
+    }
+    return size_t(n);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,517 @@
+// shm_channel.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/shm_channel.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// The control block for one direction of the channel. The indexes are
+// free-running byte counts, reduced modulo the capacity to find the
+// offset into the data. Each is kept on its own cache line, so that the
+// producer and consumer don't contend for it.
+
+struct shm_ring
+{
+    /** The total number of bytes written. Updated by the producer. */
+    alignas(64) std::atomic<uint64_t> head;
+    /** The total number of bytes read. Updated by the consumer. */
+    alignas(64) std::atomic<uint64_t> tail;
+    /** Set by the consumer when it is about to block on an empty ring */
+    alignas(64) std::atomic<uint32_t> readerWaiting;
+    /** Set by the producer when it is about to block on a full ring */
+    std::atomic<uint32_t> writerWaiting;
+    /** Set when the producer side of the channel is closed */
+    std::atomic<uint32_t> closed;
+};
+
+}  // namespace detail
+
+namespace {
+
+// "SKPP" - identifies the shared memory region and the offer message.
+constexpr uint32_t SHM_MAGIC = 0x534B5050;
+constexpr uint32_t SHM_VERSION = 1;
+
+// The smallest ring, and the space reserved for the header
+constexpr size_t MIN_CAPACITY = 4096;
+constexpr size_t HDR_SIZE = 4096;
+
+// The doorbells for our reader and writer, and for the peer's.
+constexpr int RD_BELL = 0, WR_BELL = 1, PEER_RD_BELL = 2, PEER_WR_BELL = 3;
+
+// The number of descriptors passed to the peer: the memory, then the
+// read and writer doorbells for each side.
+constexpr size_t N_FDS = 5;
+
+// The layout at the start of the shared memory. rings[i] is the one
+// written by side i.
+struct shm_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    detail::shm_ring rings[2];
+};
+
+static_assert(sizeof(shm_header) <= HDR_SIZE, "shm_channel header is too large");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "need lock-free atomics");
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+void close_fds(int* fds, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (fds[i] >= 0) {
+            ::close(fds[i]);
+            fds[i] = -1;
+        }
+    }
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+shm_channel::shm_channel(shm_channel&& other) noexcept
+    : sock_{std::move(other.sock_)},
+      map_{other.map_},
+      mapSize_{other.mapSize_},
+      cap_{other.cap_},
+      side_{other.side_},
+      spin_{other.spin_},
+      peerGone_{other.peerGone_.load()} {
+    std::copy(other.doorbell_, other.doorbell_ + 4, doorbell_);
+    std::fill(other.doorbell_, other.doorbell_ + 4, -1);
+    other.map_ = nullptr;
+    other.mapSize_ = other.cap_ = 0;
+}
+
+shm_channel::~shm_channel() { close(); }
+
+shm_channel& shm_channel::operator=(shm_channel&& rhs) noexcept {
+    if (&rhs != this) {
+        close();
+        sock_ = std::move(rhs.sock_);
+        std::swap(map_, rhs.map_);
+        std::swap(mapSize_, rhs.mapSize_);
+        std::swap(cap_, rhs.cap_);
+        std::swap(side_, rhs.side_);
+        std::swap(doorbell_, rhs.doorbell_);
+        spin_ = rhs.spin_;
+        peerGone_ = rhs.peerGone_.load();
+    }
+    return *this;
+}
+
+// --------------------------------------------------------------------------
+
+result<> shm_channel::map(int memFd, size_t cap, int side) {
+    size_t sz = HDR_SIZE + 2 * cap;
+    void* p = ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+    if (p == MAP_FAILED)
+        return result<>::from_last_error();
+
+    map_ = p;
+    mapSize_ = sz;
+    cap_ = cap;
+    side_ = side;
+    return none{};
+}
+
+detail::shm_ring& shm_channel::tx() const {
+    return static_cast<shm_header*>(map_)->rings[side_];
+}
+
+detail::shm_ring& shm_channel::rx() const {
+    return static_cast<shm_header*>(map_)->rings[1 - side_];
+}
+
+char* shm_channel::data(int side) const {
+    return static_cast<char*>(map_) + HDR_SIZE + size_t(side) * cap_;
+}
+
+// The ring indexes are in memory that the peer can write, so they can't be
+// trusted to stay in range. A peer that breaks them is treated as gone.
+
+error_code shm_channel::bad_peer() {
+    peerGone_ = true;
+    return std::make_error_code(errc::bad_message);
+}
+
+bool shm_channel::peer_closed() const {
+    return rx().closed.load(std::memory_order_acquire) != 0 || peerGone_;
+}
+
+void shm_channel::signal(int i) const {
+    uint64_t one = 1;
+    // This can only fail if the counter would overflow, which means the
+    // peer is already well signaled.
+    (void)!::write(doorbell_[i], &one, sizeof(one));
+}
+
+// Nothing more is sent over the socket once the channel is set up, so any
+// event on it means that the peer closed it or died.
+
+result<> shm_channel::wait(int i) {
+    pollfd pfds[2]{};
+    pfds[0].fd = doorbell_[i];
+    pfds[0].events = POLLIN;
+    pfds[1].fd = sock_.handle();
+    pfds[1].events = POLLIN;
+
+    if (::poll(pfds, 2, -1) < 0) {
+        if (errno == EINTR)
+            return none{};
+        return result<>::from_last_error();
+    }
+
+    if (pfds[0].revents & POLLIN) {
+        uint64_t n;
+        (void)!::read(doorbell_[i], &n, sizeof(n));
+    }
+    if (pfds[1].revents != 0)
+        peerGone_ = true;
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<shm_channel> shm_channel::create(
+    unix_stream_socket&& sock, size_t capacity /*=DFLT_CAPACITY*/
+) {
+    size_t cap = MIN_CAPACITY;
+    while (cap < capacity)
+        cap <<= 1;
+
+    shm_channel chan;
+    chan.sock_ = std::move(sock);
+
+    int fds[N_FDS]{-1, -1, -1, -1, -1};
+
+    // The memory is sealed at its size, so the peer can't shrink it out
+    // from under us and cause a fault.
+    fds[0] = ::memfd_create("sockpp-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fds[0] < 0)
+        return result<shm_channel>::from_last_error();
+
+    if (::ftruncate(fds[0], off_t(HDR_SIZE + 2 * cap)) < 0 ||
+        ::fcntl(fds[0], F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+        auto err = result<>::last_error();
+        close_fds(fds, N_FDS);
+        return err;
+    }
+
+    for (size_t i = 1; i < N_FDS; ++i) {
+        if ((fds[i] = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0) {
+            auto err = result<>::last_error();
+            close_fds(fds, N_FDS);
+            return err;
+        }
+    }
+
+    if (auto res = chan.map(fds[0], cap, 0); !res) {
+        close_fds(fds, N_FDS);
+        return res.error();
+    }
+
+    // The memory is zero-filled, which is the initial state of the rings.
+    auto hdr = new (chan.map_) shm_header;
+    hdr->magic = SHM_MAGIC;
+    hdr->version = SHM_VERSION;
+    hdr->capacity = cap;
+
+    auto res = chan.sock_.send_fds(fds, N_FDS, &SHM_MAGIC, sizeof(SHM_MAGIC));
+
+    // The mapping and the sent copies keep the memory alive.
+    ::close(fds[0]);
+    std::copy(fds + 1, fds + N_FDS, chan.doorbell_);
+
+    if (!res)
+        return res.error();
+    return chan;
+}
+
+// --------------------------------------------------------------------------
+
+result<shm_channel> shm_channel::attach(unix_stream_socket&& sock) {
+    shm_channel chan;
+    chan.sock_ = std::move(sock);
+
+    int fds[N_FDS]{-1, -1, -1, -1, -1};
+    size_t nfd = N_FDS;
+    uint32_t magic = 0;
+
+    auto res = chan.sock_.recv_fds(fds, nfd, &magic, sizeof(magic));
+    if (!res)
+        return res.error();
+    if (res.value() == 0)
+        return errc::connection_reset;
+
+    if (nfd != N_FDS || res.value() != sizeof(magic) || magic != SHM_MAGIC) {
+        close_fds(fds, nfd);
+        return errc::bad_message;
+    }
+
+    // We're side 1, so the doorbells of side 0 belong to the peer.
+    chan.doorbell_[RD_BELL] = fds[3];
+    chan.doorbell_[WR_BELL] = fds[4];
+    chan.doorbell_[PEER_RD_BELL] = fds[1];
+    chan.doorbell_[PEER_WR_BELL] = fds[2];
+
+    // Check the header before trusting it to size the mapping.
+    struct
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+    } hdr{};
+
+    // The memory must be sealed against shrinking, or the peer could
+    // truncate it and fault us on our next access.
+    struct stat st{};
+    int seals = ::fcntl(fds[0], F_GET_SEALS);
+    bool ok = seals >= 0 && (seals & F_SEAL_SHRINK) != 0 && ::fstat(fds[0], &st) == 0 &&
+              ::pread(fds[0], &hdr, sizeof(hdr), 0) == ssize_t(sizeof(hdr)) &&
+              hdr.magic == SHM_MAGIC && hdr.version == SHM_VERSION &&
+              hdr.capacity >= MIN_CAPACITY && (hdr.capacity & (hdr.capacity - 1)) == 0 &&
+              uint64_t(st.st_size) >= HDR_SIZE + 2 * hdr.capacity;
+
+    if (!ok) {
+        ::close(fds[0]);
+        return errc::bad_message;
+    }
+
+    auto mres = chan.map(fds[0], size_t(hdr.capacity), 1);
+    ::close(fds[0]);
+    if (!mres)
+        return mres.error();
+    return chan;
+}
+
+// --------------------------------------------------------------------------
+// The consumer publishes its new tail, then checks if the producer is
+// waiting for space. The producer sets its waiting flag, then checks the
+// tail again before blocking. The fences on each side make sure that at
+// least one of them sees the other's update, so a wakeup is never lost.
+
+result<size_t> shm_channel::read(void* buf, size_t n) {
+    if (!is_open())
+        return errc::bad_file_descriptor;
+    if (n == 0)
+        return size_t(0);
+
+    auto& r = rx();
+    const char* src = data(1 - side_);
+    uint64_t tail = r.tail.load(std::memory_order_relaxed);
+
+    for (unsigned i = 0;; ++i) {
+        uint64_t head = r.head.load(std::memory_order_acquire);
+
+        if (head - tail > cap_)
+            return bad_peer();
+
+        if (head != tail) {
+            size_t nx = std::min(n, size_t(head - tail)),
+                   off = size_t(tail & (cap_ - 1)), n1 = std::min(nx, cap_ - off);
+
+            std::memcpy(buf, src + off, n1);
+            std::memcpy(static_cast<char*>(buf) + n1, src, nx - n1);
+
+            r.tail.store(tail + nx, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (r.writerWaiting.load(std::memory_order_relaxed) &&
+                r.writerWaiting.exchange(0))
+                signal(PEER_WR_BELL);
+            return nx;
+        }
+
+        // The peer may have written more just before it closed.
+        if (peer_closed()) {
+            if (r.head.load(std::memory_order_acquire) != tail)
+                continue;
+            return size_t(0);
+        }
+
+        if (i < spin_) {
+            cpu_relax();
+            continue;
+        }
+
+        r.readerWaiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (r.head.load(std::memory_order_relaxed) == tail && !peer_closed()) {
+            if (auto res = wait(RD_BELL); !res) {
+                r.readerWaiting.store(0);
+                return res.error();
+            }
+        }
+        r.readerWaiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> shm_channel::read_n(void* buf, size_t n) {
+    uint8_t* b = reinterpret_cast<uint8_t*>(buf);
+    size_t nx = 0;
+
+    while (nx < n) {
+        auto res = read(b + nx, n - nx);
+        if (!res)
+            return res.error();
+
+        // The peer closed the channel
+        if (res.value() == 0)
+            break;
+
+        nx += res.value();
+    }
+
+    return nx;
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> shm_channel::write(const void* buf, size_t n) {
+    if (!is_open())
+        return errc::bad_file_descriptor;
+    if (n == 0)
+        return size_t(0);
+
+    auto& r = tx();
+    char* dst = data(side_);
+    uint64_t head = r.head.load(std::memory_order_relaxed);
+
+    for (unsigned i = 0;; ++i) {
+        if (peer_closed())
+            return errc::broken_pipe;
+
+        uint64_t tail = r.tail.load(std::memory_order_acquire);
+        if (head - tail > cap_)
+            return bad_peer();
+
+        size_t space = cap_ - size_t(head - tail);
+
+        if (space != 0) {
+            size_t nx = std::min(n, space), off = size_t(head & (cap_ - 1)),
+                   n1 = std::min(nx, cap_ - off);
+
+            std::memcpy(dst + off, buf, n1);
+            std::memcpy(dst, static_cast<const char*>(buf) + n1, nx - n1);
+
+            r.head.store(head + nx, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (r.readerWaiting.load(std::memory_order_relaxed) &&
+                r.readerWaiting.exchange(0))
+                signal(PEER_RD_BELL);
+            return nx;
+        }
+
+        if (i < spin_) {
+            cpu_relax();
+            continue;
+        }
+
+        r.writerWaiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (r.tail.load(std::memory_order_relaxed) == tail && !peer_closed()) {
+            if (auto res = wait(WR_BELL); !res) {
+                r.writerWaiting.store(0);
+                return res.error();
+            }
+        }
+        r.writerWaiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> shm_channel::write_n(const void* buf, size_t n) {
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(buf);
+    size_t nx = 0;
+
+    while (nx < n) {
+        auto res = write(b + nx, n - nx);
+        if (!res)
+            return res.error();
+        nx += res.value();
+    }
+
+    return nx;
+}
+
+// --------------------------------------------------------------------------
+
+void shm_channel::close() {
+    if (map_) {
+        // Let the peer drain what's left, then see the end of the stream.
+        tx().closed.store(1, std::memory_order_release);
+        signal(PEER_RD_BELL);
+        signal(PEER_WR_BELL);
+
+        ::munmap(map_, mapSize_);
+        map_ = nullptr;
+        mapSize_ = cap_ = 0;
+    }
+    close_fds(doorbell_, 4);
+    sock_.close();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,170 @@
+// splice_pipe.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/splice_pipe.h"
+
+#include <fcntl.h>
+
+#include "../sigpipe.h"
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+splice_pipe::splice_pipe() {
+    error_code ec;
+    *this = splice_pipe{ec};
+    if (ec)
+        throw std::system_error{ec};
+}
+
+splice_pipe::splice_pipe(error_code& ec) noexcept {
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC | O_NONBLOCK) < 0) {
+        ec = result<>::last_error();
+        return;
+    }
+    rd_ = fds[0];
+    wr_ = fds[1];
+    ec = error_code{};
+}
+
+splice_pipe::splice_pipe(splice_pipe&& other) noexcept
+    : rd_{other.rd_}, wr_{other.wr_}, pending_{other.pending_} {
+    other.rd_ = other.wr_ = -1;
+    other.pending_ = 0;
+}
+
+splice_pipe::~splice_pipe() {
+    if (rd_ >= 0)
+        ::close(rd_);
+    if (wr_ >= 0)
+        ::close(wr_);
+}
+
+splice_pipe& splice_pipe::operator=(splice_pipe&& rhs) noexcept {
+    if (&rhs != this) {
+        std::swap(rd_, rhs.rd_);
+        std::swap(wr_, rhs.wr_);
+        std::swap(pending_, rhs.pending_);
+    }
+    return *this;
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> splice_pipe::set_capacity(size_t sz) {
+    int ret = ::fcntl(wr_, F_SETPIPE_SZ, int(sz));
+    if (ret < 0)
+        return result<size_t>::from_last_error();
+    return size_t(ret);
+}
+
+// --------------------------------------------------------------------------
+
+// Note that the pipe itself is non-blocking, but the splice flag to make it
+// so is not used, since on some kernels it would also make the socket
+// side non-blocking. The sockets should keep their own settings.
+
+result<size_t> splice_pipe::flush(const socket& dst) {
+    size_t nsent = 0;
+
+    // splice() has no flag to keep it from raising SIGPIPE
+    detail::sigpipe_guard guard;
+
+    while (pending_ > 0) {
+        auto ret = ::splice(rd_, nullptr, dst.handle(), nullptr, pending_, SPLICE_F_MOVE);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            if (nsent != 0 && errno == EAGAIN)
+                break;
+            return result<size_t>::from_last_error();
+        }
+        pending_ -= size_t(ret);
+        nsent += size_t(ret);
+    }
+    return nsent;
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> splice_pipe::relay(
+    const socket& src, const socket& dst, size_t n /*=DFLT_CHUNK_SIZE*/
+) {
+    size_t nsent = 0;
+
+    // Get rid of anything left over from last time, first.
+    if (pending_ > 0) {
+        auto res = flush(dst);
+        if (!res)
+            return res;
+        nsent = res.value();
+        if (pending_ > 0)
+            return nsent;
+    }
+
+    ssize_t ret;
+    do {
+        ret = ::splice(src.handle(), nullptr, wr_, nullptr, n, SPLICE_F_MOVE);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret < 0) {
+        if (nsent != 0 && errno == EAGAIN)
+            return nsent;
+        return result<size_t>::from_last_error();
+    }
+
+    // End of stream from the source
+    if (ret == 0)
+        return nsent;
+
+    pending_ += size_t(ret);
+
+    auto res = flush(dst);
+    if (!res) {
+        // The data is safe in the pipe until the destination is ready.
+        if (res == errc::operation_would_block)
+            return nsent ? result<size_t>{nsent} : res;
+        return res;
+    }
+    return nsent + res.value();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,518 @@
+// uring.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <cstring>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+// The raw io_uring system calls. These are used directly so as not to
+// require liburing.
+
+namespace {
+
+inline int sys_io_uring_setup(unsigned entries, io_uring_params* p) {
+    return int(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+inline int sys_io_uring_enter(
+    int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, const void* arg,
+    size_t argSz
+) {
+    return int(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSz));
+}
+
+inline int sys_io_uring_register(int fd, unsigned op, const void* arg, unsigned nargs) {
+    return int(::syscall(__NR_io_uring_register, fd, op, arg, nargs));
+}
+
+template <typename T>
+inline T load_acquire(const T* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+inline void store_release(T* p, T val) {
+    __atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+inline T* offset_ptr(void* base, uint32_t off) {
+    return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + off);
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//									uring
+/////////////////////////////////////////////////////////////////////////////
+
+uring::uring(unsigned entries /*=DFLT_ENTRIES*/) {
+    if (auto ec = init(entries); ec)
+        throw std::system_error{ec};
+}
+
+uring::uring(unsigned entries, error_code& ec) noexcept { ec = init(entries); }
+
+uring::~uring() { cleanup(); }
+
+// --------------------------------------------------------------------------
+
+error_code uring::init(unsigned entries) noexcept {
+    io_uring_params p{};
+
+    if ((fd_ = sys_io_uring_setup(entries, &p)) < 0)
+        return result<>::last_error();
+
+    features_ = p.features;
+
+    sq_sz_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_sz_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+    // Newer kernels can map both rings with a single call.
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single)
+        sq_sz_ = cq_sz_ = std::max(sq_sz_, cq_sz_);
+
+    sq_ptr_ = ::mmap(
+        nullptr, sq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+        IORING_OFF_SQ_RING
+    );
+    if (sq_ptr_ == MAP_FAILED) {
+        sq_ptr_ = nullptr;
+        auto ec = result<>::last_error();
+        cleanup();
+        return ec;
+    }
+
+    if (single) {
+        cq_ptr_ = sq_ptr_;
+    }
+    else {
+        cq_ptr_ = ::mmap(
+            nullptr, cq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+            IORING_OFF_CQ_RING
+        );
+        if (cq_ptr_ == MAP_FAILED) {
+            cq_ptr_ = nullptr;
+            auto ec = result<>::last_error();
+            cleanup();
+            return ec;
+        }
+    }
+
+    sqes_sz_ = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(
+        nullptr, sqes_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+        IORING_OFF_SQES
+    );
+    if (sqes == MAP_FAILED) {
+        auto ec = result<>::last_error();
+        cleanup();
+        return ec;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sq_head_ = offset_ptr<unsigned>(sq_ptr_, p.sq_off.head);
+    sq_tail_ = offset_ptr<unsigned>(sq_ptr_, p.sq_off.tail);
+    sq_array_ = offset_ptr<unsigned>(sq_ptr_, p.sq_off.array);
+    sq_mask_ = *offset_ptr<unsigned>(sq_ptr_, p.sq_off.ring_mask);
+    sq_entries_ = *offset_ptr<unsigned>(sq_ptr_, p.sq_off.ring_entries);
+    sq_local_tail_ = *sq_tail_;
+
+    cq_head_ = offset_ptr<unsigned>(cq_ptr_, p.cq_off.head);
+    cq_tail_ = offset_ptr<unsigned>(cq_ptr_, p.cq_off.tail);
+    cq_mask_ = *offset_ptr<unsigned>(cq_ptr_, p.cq_off.ring_mask);
+    cqes_ = offset_ptr<io_uring_cqe>(cq_ptr_, p.cq_off.cqes);
+
+    return error_code{};
+}
+
+// --------------------------------------------------------------------------
+
+void uring::cleanup() noexcept {
+    if (sqes_) {
+        ::munmap(sqes_, sqes_sz_);
+        sqes_ = nullptr;
+    }
+    if (cq_ptr_ && cq_ptr_ != sq_ptr_)
+        ::munmap(cq_ptr_, cq_sz_);
+    cq_ptr_ = nullptr;
+
+    if (sq_ptr_) {
+        ::munmap(sq_ptr_, sq_sz_);
+        sq_ptr_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+// --------------------------------------------------------------------------
+
+result<io_uring_sqe*> uring::get_sqe() noexcept {
+    if (fd_ < 0)
+        return errc::bad_file_descriptor;
+
+    if (sq_local_tail_ - load_acquire(sq_head_) >= sq_entries_) {
+        // The queue is full. Push what we have to the kernel to make room.
+        if (auto res = submit(); !res)
+            return res.error();
+        if (sq_local_tail_ - load_acquire(sq_head_) >= sq_entries_)
+            return errc::resource_unavailable_try_again;
+    }
+
+    unsigned idx = sq_local_tail_ & sq_mask_;
+    auto sqe = &sqes_[idx];
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+
+    sq_array_[idx] = idx;
+    ++sq_local_tail_;
+    ++sq_pending_;
+    return sqe;
+}
+
+// --------------------------------------------------------------------------
+
+result<> uring::recv(
+    const socket& sock, void* buf, size_t n, uint64_t userData, int flags /*=0*/
+) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = sock.handle();
+    sqe->addr = uint64_t(uintptr_t(buf));
+    sqe->len = uint32_t(n);
+    sqe->msg_flags = uint32_t(flags);
+    sqe->user_data = userData;
+    return none{};
+}
+
+result<> uring::recv_select(
+    const socket& sock, uint16_t bufGroup, uint64_t userData, bool multishot /*=true*/
+) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = sock.handle();
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = bufGroup;
+    if (multishot)
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->user_data = userData;
+    return none{};
+}
+
+result<> uring::send(
+    const socket& sock, const void* buf, size_t n, uint64_t userData, int flags /*=0*/
+) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = sock.handle();
+    sqe->addr = uint64_t(uintptr_t(buf));
+    sqe->len = uint32_t(n);
+    sqe->msg_flags = uint32_t(flags | MSG_NOSIGNAL);
+    sqe->user_data = userData;
+    return none{};
+}
+
+result<> uring::accept(
+    const acceptor& acc, uint64_t userData, sock_address* addr /*=nullptr*/,
+    socklen_t* len /*=nullptr*/
+) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = acc.handle();
+    if (addr && len) {
+        sqe->addr = uint64_t(uintptr_t(addr->sockaddr_ptr()));
+        sqe->addr2 = uint64_t(uintptr_t(len));
+    }
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = userData;
+    return none{};
+}
+
+result<> uring::accept_multishot(const acceptor& acc, uint64_t userData) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = acc.handle();
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = userData;
+    return none{};
+}
+
+result<> uring::connect(const socket& sock, const sock_address& addr, uint64_t userData) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_CONNECT;
+    sqe->fd = sock.handle();
+    sqe->addr = uint64_t(uintptr_t(addr.sockaddr_ptr()));
+    sqe->off = uint64_t(addr.size());
+    sqe->user_data = userData;
+    return none{};
+}
+
+result<> uring::close(socket_t h, uint64_t userData) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_CLOSE;
+    sqe->fd = h;
+    sqe->user_data = userData;
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<> uring::cancel(uint64_t target, uint64_t userData /*=0*/) {
+    auto res = get_sqe();
+    if (!res)
+        return res.error();
+
+    auto sqe = res.value();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = userData;
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> uring::enter(unsigned toSubmit, unsigned minComplete, milliseconds timeout) {
+    unsigned flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+    const void* arg = nullptr;
+    size_t argSz = 0;
+
+    __kernel_timespec ts{};
+    io_uring_getevents_arg evArg{};
+
+    if (minComplete && timeout.count() >= 0) {
+        if (!(features_ & IORING_FEAT_EXT_ARG))
+            return errc::operation_not_supported;
+
+        auto sec = duration_cast<seconds>(timeout);
+        ts.tv_sec = sec.count();
+        ts.tv_nsec = duration_cast<nanoseconds>(timeout - sec).count();
+
+        evArg.ts = uint64_t(uintptr_t(&ts));
+        arg = &evArg;
+        argSz = sizeof(evArg);
+        flags |= IORING_ENTER_EXT_ARG;
+    }
+
+    int ret = sys_io_uring_enter(fd_, toSubmit, minComplete, flags, arg, argSz);
+    if (ret < 0)
+        return result<size_t>::from_last_error();
+    return size_t(ret);
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> uring::submit() {
+    if (sq_pending_ == 0)
+        return 0;
+
+    store_release(sq_tail_, sq_local_tail_);
+
+    auto res = enter(sq_pending_, 0, milliseconds{-1});
+    if (res)
+        sq_pending_ -= unsigned(res.value());
+    return res;
+}
+
+// --------------------------------------------------------------------------
+
+size_t uring::reap(completion* evts, size_t maxEvts) noexcept {
+    if (fd_ < 0)
+        return 0;
+
+    unsigned head = *cq_head_, tail = load_acquire(cq_tail_);
+    size_t n = 0;
+
+    while (head != tail && n < maxEvts) {
+        const auto& cqe = cqes_[head & cq_mask_];
+        evts[n++] = completion{cqe.user_data, cqe.res, cqe.flags};
+        ++head;
+    }
+
+    store_release(cq_head_, head);
+    return n;
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> uring::wait(
+    completion* evts, size_t maxEvts, milliseconds timeout /*=milliseconds{-1}*/
+) {
+    if (fd_ < 0)
+        return errc::bad_file_descriptor;
+
+    // Take what's there already, if anything, and push out any new work.
+    // The reaped completions are gone from the ring, so they have to be
+    // returned even if the submit fails. The work is still pending in
+    // that case, and the error comes back on the next call.
+    if (auto n = reap(evts, maxEvts); n != 0) {
+        (void)submit();
+        return n;
+    }
+
+    store_release(sq_tail_, sq_local_tail_);
+    auto res = enter(sq_pending_, timeout.count() == 0 ? 0 : 1, timeout);
+
+    if (!res) {
+        // The kernel reports an expired wait as ETIME
+        if (res == errc::stream_timeout || res == errc::interrupted)
+            return 0;
+        return res;
+    }
+
+    sq_pending_ -= unsigned(std::min<size_t>(res.value(), sq_pending_));
+    return reap(evts, maxEvts);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//							uring_buffer_ring
+/////////////////////////////////////////////////////////////////////////////
+
+uring_buffer_ring::uring_buffer_ring(
+    uring& ring, uint16_t bgid, unsigned nbuf, size_t bufSz, error_code& ec
+) noexcept
+    : ring_{&ring}, bgid_{bgid}, nbuf_{nbuf}, bufSz_{bufSz} {
+    if (nbuf == 0 || nbuf > 32768 || (nbuf & (nbuf - 1)) != 0 || bufSz == 0) {
+        ec = std::make_error_code(errc::invalid_argument);
+        return;
+    }
+
+    brSz_ = nbuf * sizeof(io_uring_buf);
+    void* p = ::mmap(
+        nullptr, brSz_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0
+    );
+    if (p == MAP_FAILED) {
+        ec = result<>::last_error();
+        return;
+    }
+    br_ = static_cast<io_uring_buf_ring*>(p);
+
+    memSz_ = nbuf * bufSz;
+    p = ::mmap(nullptr, memSz_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (p == MAP_FAILED) {
+        ec = result<>::last_error();
+        ::munmap(br_, brSz_);
+        br_ = nullptr;
+        return;
+    }
+    mem_ = static_cast<uint8_t*>(p);
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = uint64_t(uintptr_t(br_));
+    reg.ring_entries = nbuf;
+    reg.bgid = bgid;
+
+    if (sys_io_uring_register(ring.handle(), IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        ec = result<>::last_error();
+        ::munmap(mem_, memSz_);
+        ::munmap(br_, brSz_);
+        mem_ = nullptr;
+        br_ = nullptr;
+        return;
+    }
+
+    for (unsigned i = 0; i < nbuf; ++i) add(uint16_t(i));
+    commit();
+    ec = error_code{};
+}
+
+uring_buffer_ring::~uring_buffer_ring() {
+    if (br_) {
+        io_uring_buf_reg reg{};
+        reg.bgid = bgid_;
+        sys_io_uring_register(ring_->handle(), IORING_UNREGISTER_PBUF_RING, &reg, 1);
+        ::munmap(br_, brSz_);
+    }
+    if (mem_)
+        ::munmap(mem_, memSz_);
+}
+
+// --------------------------------------------------------------------------
+
+void uring_buffer_ring::add(uint16_t bid) noexcept {
+    // The entries are indexed from the start of the ring, rather than
+    // through 'br_->bufs', since some versions of the kernel header declare
+    // the flexible array in a way that puts it at the wrong offset in C++.
+    auto& buf = reinterpret_cast<io_uring_buf*>(br_)[tail_ & (nbuf_ - 1)];
+    buf.addr = uint64_t(uintptr_t(buffer(bid)));
+    buf.len = uint32_t(bufSz_);
+    buf.bid = bid;
+    ++tail_;
+}
+
+void uring_buffer_ring::commit() noexcept { store_release(&br_->tail, tail_); }
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
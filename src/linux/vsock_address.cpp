@@ -0,0 +1,86 @@
+// vsock_address.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/vsock_address.h"
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+constexpr sa_family_t vsock_address::ADDRESS_FAMILY;
+
+// --------------------------------------------------------------------------
+
+result<uint32_t> vsock_address::local_cid() {
+    int fd = ::open("/dev/vsock", O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return result<uint32_t>::from_last_error();
+
+    unsigned cid = 0;
+    int ret = ::ioctl(fd, IOCTL_VM_SOCKETS_GET_LOCAL_CID, &cid);
+    auto err = (ret < 0) ? result<>::last_error() : error_code{};
+    ::close(fd);
+
+    if (err)
+        return err;
+    return uint32_t(cid);
+}
+
+// --------------------------------------------------------------------------
+// The "any" values are all ones, which read better as -1.
+
+string vsock_address::to_string() const {
+    auto val = [](uint32_t v) {
+        return (v == uint32_t(-1)) ? string{"-1"} : std::to_string(v);
+    };
+    return "vsock:" + val(cid()) + ":" + val(port());
+}
+
+// --------------------------------------------------------------------------
+
+ostream& operator<<(ostream& os, const vsock_address& addr) {
+    os << addr.to_string();
+    return os;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,370 @@
+// xdp_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/xdp_socket.h"
+
+#include <linux/bpf.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+xdp_socket::xdp_socket(xdp_socket&& other) noexcept
+    : base(std::move(other)),
+      umem_{other.umem_},
+      umemSize_{other.umemSize_},
+      frameSize_{other.frameSize_},
+      queue_{other.queue_},
+      needWakeup_{other.needWakeup_},
+      fill_{other.fill_},
+      comp_{other.comp_},
+      rx_{other.rx_},
+      tx_{other.tx_},
+      txFree_{std::move(other.txFree_)},
+      txPending_{other.txPending_} {
+    other.umem_ = nullptr;
+    other.umemSize_ = 0;
+    other.fill_ = other.comp_ = other.rx_ = other.tx_ = detail::xdp_ring{};
+    other.txPending_ = 0;
+}
+
+xdp_socket& xdp_socket::operator=(xdp_socket&& rhs) noexcept {
+    if (&rhs != this) {
+        unmap();
+        base::operator=(std::move(rhs));
+
+        std::swap(umem_, rhs.umem_);
+        std::swap(umemSize_, rhs.umemSize_);
+        std::swap(frameSize_, rhs.frameSize_);
+        std::swap(queue_, rhs.queue_);
+        std::swap(needWakeup_, rhs.needWakeup_);
+        std::swap(fill_, rhs.fill_);
+        std::swap(comp_, rhs.comp_);
+        std::swap(rx_, rhs.rx_);
+        std::swap(tx_, rhs.tx_);
+        std::swap(txFree_, rhs.txFree_);
+        std::swap(txPending_, rhs.txPending_);
+    }
+    return *this;
+}
+
+// --------------------------------------------------------------------------
+
+error_code xdp_socket::map_ring(
+    detail::xdp_ring& ring, const xdp_ring_offset& off, uint32_t n, size_t entrySize,
+    off_t pgoff
+) noexcept {
+    size_t sz = off.desc + n * entrySize;
+    void* p = ::mmap(
+        nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle(), pgoff
+    );
+    if (p == MAP_FAILED)
+        return result<>::last_error();
+
+    auto base = static_cast<char*>(p);
+
+    ring.map = p;
+    ring.map_size = sz;
+    ring.producer = reinterpret_cast<uint32_t*>(base + off.producer);
+    ring.consumer = reinterpret_cast<uint32_t*>(base + off.consumer);
+    ring.flags = reinterpret_cast<uint32_t*>(base + off.flags);
+    ring.entries = base + off.desc;
+    ring.size = n;
+    ring.mask = n - 1;
+    ring.cached_prod = *ring.producer;
+    ring.cached_cons = *ring.consumer;
+    return error_code{};
+}
+
+result<> xdp_socket::open(
+    const string& iface, uint32_t queue, const xdp_params& params
+) noexcept {
+    close();
+
+    uint32_t n = params.ring_size;
+    if (n == 0 || (n & (n - 1)) != 0 || params.frame_count < 2 ||
+        params.frame_size < 2048 || params.headroom >= params.frame_size)
+        return errc::invalid_argument;
+
+    unsigned idx = ::if_nametoindex(iface.c_str());
+    if (idx == 0)
+        return result<>::last_error();
+
+    auto createRes = create_handle(AF_XDP, SOCK_RAW, 0);
+    if (!createRes)
+        return createRes.error();
+    reset(createRes.value());
+
+    auto fail = [this](error_code ec) -> result<> {
+        close();
+        return ec;
+    };
+
+    // The shared packet memory
+    umemSize_ = size_t(params.frame_size) * params.frame_count;
+    const int UMEM_FLAGS = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+    void* p = ::mmap(nullptr, umemSize_, PROT_READ | PROT_WRITE, UMEM_FLAGS, -1, 0);
+    if (p == MAP_FAILED) {
+        umemSize_ = 0;
+        return fail(result<>::last_error());
+    }
+    umem_ = static_cast<uint8_t*>(p);
+    frameSize_ = params.frame_size;
+    queue_ = queue;
+    needWakeup_ = (params.bind_flags & XDP_USE_NEED_WAKEUP) != 0;
+
+    xdp_umem_reg reg{};
+    reg.addr = uint64_t(uintptr_t(umem_));
+    reg.len = umemSize_;
+    reg.chunk_size = params.frame_size;
+    reg.headroom = params.headroom;
+
+    if (auto res = set_option(SOL_XDP, XDP_UMEM_REG, reg); !res)
+        return fail(res.error());
+
+    const int RING_OPTS[] = {
+        XDP_UMEM_FILL_RING, XDP_UMEM_COMPLETION_RING, XDP_RX_RING, XDP_TX_RING
+    };
+    for (auto opt : RING_OPTS) {
+        if (auto res = set_option(SOL_XDP, opt, n); !res)
+            return fail(res.error());
+    }
+
+    auto offRes = get_option<xdp_mmap_offsets>(SOL_XDP, XDP_MMAP_OFFSETS);
+    if (!offRes)
+        return fail(offRes.error());
+    auto off = offRes.value();
+
+    error_code ec;
+    if ((ec = map_ring(fill_, off.fr, n, sizeof(uint64_t), XDP_UMEM_PGOFF_FILL_RING)) ||
+        (ec = map_ring(
+             comp_, off.cr, n, sizeof(uint64_t), off_t(XDP_UMEM_PGOFF_COMPLETION_RING)
+         )) ||
+        (ec = map_ring(rx_, off.rx, n, sizeof(xdp_desc), XDP_PGOFF_RX_RING)) ||
+        (ec = map_ring(tx_, off.tx, n, sizeof(xdp_desc), XDP_PGOFF_TX_RING)))
+        return fail(ec);
+
+    // Split the frames between receive and transmit. Neither side gets
+    // more than a ring's worth, so that the fill and completion rings can
+    // always take back all their frames.
+    uint32_t nRx = std::min(params.frame_count / 2, n),
+             nTx = std::min(params.frame_count - nRx, n);
+
+    uint32_t i = 0;
+    if (fill_.reserve(nRx, i) != nRx)
+        return fail(make_error_code(errc::no_buffer_space));
+    for (uint32_t j = 0; j < nRx; ++j) fill_.at<uint64_t>(i + j) = uint64_t(j) * frameSize_;
+    fill_.submit();
+
+    txFree_.clear();
+    txFree_.reserve(nTx);
+    for (uint32_t j = 0; j < nTx; ++j) txFree_.push_back(uint64_t(nRx + j) * frameSize_);
+
+    sockaddr_xdp sxdp{};
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_flags = params.bind_flags;
+    sxdp.sxdp_ifindex = idx;
+    sxdp.sxdp_queue_id = queue;
+
+    if (::bind(handle(), reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)) < 0)
+        return fail(result<>::last_error());
+
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+void xdp_socket::unmap() noexcept {
+    for (auto ring : {&fill_, &comp_, &rx_, &tx_}) {
+        if (ring->map)
+            ::munmap(ring->map, ring->map_size);
+        *ring = detail::xdp_ring{};
+    }
+    if (umem_)
+        ::munmap(umem_, umemSize_);
+
+    umem_ = nullptr;
+    umemSize_ = 0;
+    frameSize_ = 0;
+    txFree_.clear();
+    txPending_ = 0;
+}
+
+result<> xdp_socket::close() {
+    // The socket has to go before the memory that it uses
+    auto res = base::close();
+    unmap();
+    return res;
+}
+
+// --------------------------------------------------------------------------
+
+result<> xdp_socket::register_in_map(int mapFd, uint32_t key) noexcept {
+    uint32_t fd = uint32_t(handle());
+
+    bpf_attr attr{};
+    attr.map_fd = uint32_t(mapFd);
+    attr.key = uint64_t(uintptr_t(&key));
+    attr.value = uint64_t(uintptr_t(&fd));
+    attr.flags = BPF_ANY;
+
+    if (::syscall(__NR_bpf, BPF_MAP_UPDATE_ELEM, &attr, sizeof(attr)) < 0)
+        return result<>::from_last_error();
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<bool> xdp_socket::wait_rx(milliseconds timeout) {
+    if (timeout.count() == 0) {
+        // Even when not waiting, the kernel may need a kick to start
+        // using the fill ring again.
+        if (fill_.needs_wakeup())
+            ::recvfrom(handle(), nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+        return false;
+    }
+
+    pollfd pfd{handle(), POLLIN, 0};
+    int ms = timeout.count() < 0 ? -1 : int(timeout.count());
+
+    int n = ::poll(&pfd, 1, ms);
+    if (n < 0)
+        return result<bool>::from_last_error();
+    return n > 0;
+}
+
+void xdp_socket::recycle(uint32_t idx, uint32_t n) noexcept {
+    if (n == 0)
+        return;
+
+    // There's always room, since there are no more receive frames than
+    // fill ring entries. If that ever failed, the frames would drop out of
+    // circulation rather than overwrite entries the kernel hasn't taken.
+    uint32_t fi = 0;
+    if (fill_.reserve(n, fi) != n) {
+        rx_.release();
+        return;
+    }
+
+    uint64_t mask = ~uint64_t(frameSize_ - 1);
+    for (uint32_t i = 0; i < n; ++i)
+        fill_.at<uint64_t>(fi + i) = rx_.at<xdp_desc>(idx + i).addr & mask;
+
+    fill_.submit();
+    rx_.release();
+
+    if (fill_.needs_wakeup())
+        ::recvfrom(handle(), nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+}
+
+// --------------------------------------------------------------------------
+
+void xdp_socket::reclaim() noexcept {
+    uint32_t idx, n = comp_.peek(comp_.size, idx);
+    if (n == 0)
+        return;
+
+    for (uint32_t i = 0; i < n; ++i) txFree_.push_back(comp_.at<uint64_t>(idx + i));
+    comp_.release();
+}
+
+result<> xdp_socket::tx_queue(const void* buf, size_t n) {
+    if (!umem_)
+        return errc::bad_file_descriptor;
+
+    if (n > frameSize_)
+        return errc::message_size;
+
+    if (txFree_.empty()) {
+        reclaim();
+        if (txFree_.empty())
+            return errc::no_buffer_space;
+    }
+
+    uint32_t idx;
+    if (tx_.reserve(1, idx) == 0)
+        return errc::no_buffer_space;
+
+    uint64_t addr = txFree_.back();
+    txFree_.pop_back();
+
+    std::memcpy(umem_ + addr, buf, n);
+
+    auto& desc = tx_.at<xdp_desc>(idx);
+    desc.addr = addr;
+    desc.len = uint32_t(n);
+    desc.options = 0;
+
+    ++txPending_;
+    return none{};
+}
+
+result<size_t> xdp_socket::tx_flush() {
+    if (!umem_)
+        return errc::bad_file_descriptor;
+
+    size_t n = txPending_;
+    txPending_ = 0;
+    tx_.submit();
+
+    // Unless it says otherwise, the kernel needs a kick to send. These
+    // errors just mean it's busy, and will get to the packets.
+    if (!needWakeup_ || tx_.needs_wakeup()) {
+        if (::sendto(handle(), nullptr, 0, MSG_DONTWAIT, nullptr, 0) < 0) {
+            auto ec = result<>::last_error();
+            if (ec != errc::resource_unavailable_try_again &&
+                ec != errc::device_or_resource_busy && ec != errc::no_buffer_space &&
+                ec != errc::network_down)
+                return ec;
+        }
+    }
+
+    reclaim();
+    return n;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
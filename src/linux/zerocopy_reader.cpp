@@ -0,0 +1,159 @@
+// zerocopy_reader.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/zerocopy_reader.h"
+
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include "stats.h"
+
+namespace sockpp {
+
+namespace {
+
+#if !defined(TCP_ZEROCOPY_RECEIVE)
+    #define TCP_ZEROCOPY_RECEIVE 35
+#endif
+
+// The leading part of the kernel's struct tcp_zerocopy_receive, which is
+// all that the oldest kernels with the option accept.
+struct zc_receive
+{
+    uint64_t address;
+    uint32_t length;
+    uint32_t recvSkipHint;
+};
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+zerocopy_reader::zerocopy_reader(
+    stream_socket& sock, size_t windowSize /*=DFLT_WINDOW_SIZE*/,
+    size_t copySize /*=DFLT_COPY_SIZE*/
+)
+    : sock_{sock},
+      copyBuf_{new char[std::max<size_t>(copySize, 1)]},
+      copySize_{std::max<size_t>(copySize, 1)} {
+    auto pg = size_t(::sysconf(_SC_PAGESIZE));
+    auto sz = std::max(((windowSize + pg - 1) / pg) * pg, pg);
+
+    // The mapping fails for sockets that don't support it.
+    void* p = ::mmap(nullptr, sz, PROT_READ, MAP_SHARED, sock.handle(), 0);
+    if (p != MAP_FAILED) {
+        map_ = static_cast<char*>(p);
+        windowSize_ = sz;
+    }
+}
+
+zerocopy_reader::~zerocopy_reader() { unmap(); }
+
+void zerocopy_reader::unmap() noexcept {
+    if (map_) {
+        ::munmap(map_, windowSize_);
+        map_ = nullptr;
+        windowSize_ = 0;
+        mapped_ = 0;
+    }
+}
+
+void zerocopy_reader::release() noexcept {
+    if (map_ && mapped_ != 0)
+        ::madvise(map_, mapped_, MADV_DONTNEED);
+    mapped_ = 0;
+}
+
+// --------------------------------------------------------------------------
+
+// The pages from the last read are dropped first, so that the kernel can
+// map new ones in their place without having to zap the range itself.
+// Data that can't be mapped is copied only up to the kernel's skip hint,
+// so that the next read starts on data that can be. If nothing was mapped
+// or hinted, a normal read waits for data, or reports EOF or an error.
+
+result<zerocopy_reader::chunk> zerocopy_reader::read() {
+    chunk ch;
+    size_t ncopy = copySize_;
+
+    if (map_) {
+        release();
+
+        zc_receive zc{};
+        zc.address = reinterpret_cast<uintptr_t>(map_);
+        zc.length = uint32_t(std::min<size_t>(windowSize_, UINT32_MAX));
+        socklen_t len = sizeof(zc);
+
+        auto res = sock_.get_option(IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &len);
+        if (!res) {
+            // The socket doesn't support it, so copy from now on. Other
+            // failures, like data at the front that can't be mapped, are
+            // left to the copying read, which reports any real error.
+            if (res == errc::invalid_argument || res == errc::operation_not_supported ||
+                res == errc::no_protocol_option)
+                unmap();
+        }
+        else {
+            mapped_ = zc.length;
+            if (zc.length != 0)
+                detail::stats_recv(ssize_t(zc.length));
+
+            ch.mapped = std::string_view{map_, mapped_};
+            if (zc.recvSkipHint != 0)
+                ncopy = std::min<size_t>(ncopy, zc.recvSkipHint);
+            else if (zc.length != 0)
+                return ch;
+        }
+    }
+
+    auto res = sock_.read(copyBuf_.get(), ncopy);
+    if (!res) {
+        // Don't lose the mapped data to a copy that would block
+        if (!ch.mapped.empty())
+            return ch;
+        return res.error();
+    }
+
+    ch.copied = std::string_view{copyBuf_.get(), res.value()};
+    return ch;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
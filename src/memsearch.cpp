@@ -0,0 +1,434 @@
+// memsearch.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+// The sequence search compares the first and last bytes of the pattern
+// against a whole vector of starting positions at once, and only checks
+// the bytes in between with memcmp() for the positions where both match.
+// For short delimiters like "\r\n" that filter is nearly exact.
+//
+// No kernel reads outside the caller's memory. Anything shorter than a
+// vector goes to the generic kernel, and the end of a byte search is
+// covered by one last vector that overlaps the previous one.
+
+#include "sockpp/memsearch.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(SOCKPP_WITH_SIMD)
+    #if defined(__x86_64__) || defined(_M_X64)
+        #define SOCKPP_SIMD_X86
+        #include <immintrin.h>
+        #if defined(_MSC_VER)
+            #include <intrin.h>
+        #endif
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #define SOCKPP_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+    #define SOCKPP_TARGET_AVX2
+#else
+    #define SOCKPP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace sockpp {
+
+namespace {
+
+using find_byte_fn = const char* (*)(const char*, size_t, char);
+using find_seq_fn = const char* (*)(const char*, size_t, const char*, size_t);
+
+// The kernels for one instruction set
+struct kernel_ops
+{
+    find_byte_fn find_byte;
+    find_seq_fn find_seq;
+};
+
+#if defined(SOCKPP_SIMD_X86) || defined(SOCKPP_SIMD_NEON)
+// Index of the lowest set bit. The value must not be zero.
+inline unsigned ctz(uint64_t x) {
+    #if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return unsigned(i);
+    #else
+    return unsigned(__builtin_ctzll(x));
+    #endif
+}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// Generic
+
+const char* generic_find_byte(const char* p, size_t n, char c) {
+    return static_cast<const char*>(std::memchr(p, c, n));
+}
+
+// Requires 2 <= m <= n
+const char* generic_find_seq(const char* p, size_t n, const char* pat, size_t m) {
+    const char* last = p + (n - m);
+
+    while (p <= last) {
+        p = static_cast<const char*>(std::memchr(p, pat[0], size_t(last - p) + 1));
+        if (!p)
+            return nullptr;
+        if (std::memcmp(p + 1, pat + 1, m - 1) == 0)
+            return p;
+        ++p;
+    }
+    return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// SSE2 and AVX2
+
+#if defined(SOCKPP_SIMD_X86)
+
+inline unsigned sse2_eq(const char* p, __m128i v) {
+    auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(x, v)));
+}
+
+const char* sse2_find_byte(const char* p, size_t n, char c) {
+    constexpr size_t W = 16;
+    if (n < W)
+        return generic_find_byte(p, n, c);
+
+    const char *s = p, *end = p + n;
+    const auto v = _mm_set1_epi8(c);
+
+    // Four vectors at a time, with a single test for any match
+    for (; size_t(end - s) >= 4 * W; s += 4 * W) {
+        auto x0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)), v);
+        auto x1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + W)), v);
+        auto x2 =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * W)), v);
+        auto x3 =
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * W)), v);
+        auto any = _mm_or_si128(_mm_or_si128(x0, x1), _mm_or_si128(x2, x3));
+        if (_mm_movemask_epi8(any))
+            break;
+    }
+
+    for (; size_t(end - s) >= W; s += W) {
+        if (auto m = sse2_eq(s, v); m)
+            return s + ctz(m);
+    }
+
+    if (s < end) {
+        s = end - W;
+        if (auto m = sse2_eq(s, v); m)
+            return s + ctz(m);
+    }
+    return nullptr;
+}
+
+const char* sse2_find_seq(const char* p, size_t n, const char* pat, size_t m) {
+    constexpr size_t W = 16;
+    size_t nstart = n - m + 1, i = 0;
+
+    if (nstart >= W) {
+        const auto first = _mm_set1_epi8(pat[0]), last = _mm_set1_epi8(pat[m - 1]);
+
+        for (; nstart - i >= W; i += W) {
+            auto mask = sse2_eq(p + i, first) & sse2_eq(p + i + m - 1, last);
+            while (mask) {
+                auto k = i + ctz(mask);
+                if (std::memcmp(p + k + 1, pat + 1, m - 2) == 0)
+                    return p + k;
+                mask &= mask - 1;
+            }
+        }
+    }
+    return (i < nstart) ? generic_find_seq(p + i, n - i, pat, m) : nullptr;
+}
+
+SOCKPP_TARGET_AVX2 inline unsigned avx2_eq(const char* p, __m256i v) {
+    auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, v)));
+}
+
+SOCKPP_TARGET_AVX2 const char* avx2_find_byte(const char* p, size_t n, char c) {
+    constexpr size_t W = 32;
+    if (n < W)
+        return sse2_find_byte(p, n, c);
+
+    const char *s = p, *end = p + n;
+    const auto v = _mm256_set1_epi8(c);
+
+    for (; size_t(end - s) >= 4 * W; s += 4 * W) {
+        auto x0 =
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)), v);
+        auto x1 =
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + W)), v);
+        auto x2 = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 2 * W)), v
+        );
+        auto x3 = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 3 * W)), v
+        );
+        auto any = _mm256_or_si256(_mm256_or_si256(x0, x1), _mm256_or_si256(x2, x3));
+        if (_mm256_movemask_epi8(any))
+            break;
+    }
+
+    for (; size_t(end - s) >= W; s += W) {
+        if (auto m = avx2_eq(s, v); m)
+            return s + ctz(m);
+    }
+
+    if (s < end) {
+        s = end - W;
+        if (auto m = avx2_eq(s, v); m)
+            return s + ctz(m);
+    }
+    return nullptr;
+}
+
+SOCKPP_TARGET_AVX2 const char* avx2_find_seq(
+    const char* p, size_t n, const char* pat, size_t m
+) {
+    constexpr size_t W = 32;
+    size_t nstart = n - m + 1, i = 0;
+
+    if (nstart >= W) {
+        const auto first = _mm256_set1_epi8(pat[0]), last = _mm256_set1_epi8(pat[m - 1]);
+
+        for (; nstart - i >= W; i += W) {
+            auto mask = avx2_eq(p + i, first) & avx2_eq(p + i + m - 1, last);
+            while (mask) {
+                auto k = i + ctz(mask);
+                if (std::memcmp(p + k + 1, pat + 1, m - 2) == 0)
+                    return p + k;
+                mask &= mask - 1;
+            }
+        }
+    }
+    return (i < nstart) ? sse2_find_seq(p + i, n - i, pat, m) : nullptr;
+}
+
+bool cpu_has_avx2() {
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // The CPU must have AVX2, and the OS must save the YMM registers
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+    #else
+    return __builtin_cpu_supports("avx2") != 0;
+    #endif
+}
+
+#endif  // SOCKPP_SIMD_X86
+
+/////////////////////////////////////////////////////////////////////////////
+// NEON
+
+#if defined(SOCKPP_SIMD_NEON)
+
+// Narrows a byte compare to a 64-bit mask with four bits per byte.
+inline uint64_t neon_eq(const char* p, uint8x16_t v) {
+    auto x = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p)), v);
+    auto nib = vshrn_n_u16(vreinterpretq_u16_u8(x), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nib), 0);
+}
+
+const char* neon_find_byte(const char* p, size_t n, char c) {
+    constexpr size_t W = 16;
+    if (n < W)
+        return generic_find_byte(p, n, c);
+
+    const char *s = p, *end = p + n;
+    const auto v = vdupq_n_u8(uint8_t(c));
+
+    for (; size_t(end - s) >= W; s += W) {
+        if (auto m = neon_eq(s, v); m)
+            return s + (ctz(m) >> 2);
+    }
+
+    if (s < end) {
+        s = end - W;
+        if (auto m = neon_eq(s, v); m)
+            return s + (ctz(m) >> 2);
+    }
+    return nullptr;
+}
+
+const char* neon_find_seq(const char* p, size_t n, const char* pat, size_t m) {
+    constexpr size_t W = 16;
+    size_t nstart = n - m + 1, i = 0;
+
+    if (nstart >= W) {
+        const auto first = vdupq_n_u8(uint8_t(pat[0])), last = vdupq_n_u8(uint8_t(pat[m - 1]));
+
+        for (; nstart - i >= W; i += W) {
+            // Keep one bit of each nibble, so each clear is one position
+            auto mask =
+                neon_eq(p + i, first) & neon_eq(p + i + m - 1, last) & 0x8888888888888888ULL;
+            while (mask) {
+                auto k = i + (ctz(mask) >> 2);
+                if (std::memcmp(p + k + 1, pat + 1, m - 2) == 0)
+                    return p + k;
+                mask &= mask - 1;
+            }
+        }
+    }
+    return (i < nstart) ? generic_find_seq(p + i, n - i, pat, m) : nullptr;
+}
+
+#endif  // SOCKPP_SIMD_NEON
+
+/////////////////////////////////////////////////////////////////////////////
+// Dispatch
+
+const kernel_ops GENERIC_OPS{generic_find_byte, generic_find_seq};
+
+const kernel_ops& ops_for(search_kernel k) {
+    switch (k) {
+#if defined(SOCKPP_SIMD_X86)
+        case search_kernel::sse2: {
+            static const kernel_ops ops{sse2_find_byte, sse2_find_seq};
+            return ops;
+        }
+        case search_kernel::avx2:
+            if (cpu_has_avx2()) {
+                static const kernel_ops ops{avx2_find_byte, avx2_find_seq};
+                return ops;
+            }
+            break;
+#endif
+#if defined(SOCKPP_SIMD_NEON)
+        case search_kernel::neon: {
+            static const kernel_ops ops{neon_find_byte, neon_find_seq};
+            return ops;
+        }
+#endif
+        default:
+            break;
+    }
+    return GENERIC_OPS;
+}
+
+// The kernels used by the default searches, picked on first use.
+// The glibc memchr() is already vectorized, with its own dispatch up to
+// AVX-512, and is as fast as anything here, so it's kept for single bytes.
+const kernel_ops& default_ops() {
+    static const kernel_ops ops{
+#if defined(__GLIBC__)
+        generic_find_byte,
+#else
+        ops_for(default_search_kernel()).find_byte,
+#endif
+        ops_for(default_search_kernel()).find_seq
+    };
+    return ops;
+}
+
+const char* find_seq(const kernel_ops& ops, const char* p, size_t n, std::string_view pat) {
+    auto m = pat.size();
+    if (m == 0)
+        return p;
+    if (m > n)
+        return nullptr;
+    if (m == 1)
+        return ops.find_byte(p, n, pat[0]);
+    return ops.find_seq(p, n, pat.data(), m);
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+const char* to_string(search_kernel k) {
+    switch (k) {
+        case search_kernel::sse2:
+            return "sse2";
+        case search_kernel::avx2:
+            return "avx2";
+        case search_kernel::neon:
+            return "neon";
+        default:
+            return "generic";
+    }
+}
+
+bool search_kernel_supported(search_kernel k) {
+    return k == search_kernel::generic || &ops_for(k) != &GENERIC_OPS;
+}
+
+search_kernel default_search_kernel() {
+#if defined(SOCKPP_SIMD_X86)
+    return cpu_has_avx2() ? search_kernel::avx2 : search_kernel::sse2;
+#elif defined(SOCKPP_SIMD_NEON)
+    return search_kernel::neon;
+#else
+    return search_kernel::generic;
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+const char* find_byte(const char* p, size_t n, char c) {
+    return default_ops().find_byte(p, n, c);
+}
+
+const char* find_byte(search_kernel k, const char* p, size_t n, char c) {
+    return ops_for(k).find_byte(p, n, c);
+}
+
+const char* find_seq(const char* p, size_t n, std::string_view pat) {
+    return find_seq(default_ops(), p, n, pat);
+}
+
+const char* find_seq(search_kernel k, const char* p, size_t n, std::string_view pat) {
+    return find_seq(ops_for(k), p, n, pat);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
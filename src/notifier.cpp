@@ -0,0 +1,190 @@
+// notifier.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/notifier.h"
+
+#if defined(__linux__)
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+#elif !defined(_WIN32)
+    #include <fcntl.h>
+    #include <unistd.h>
+#else
+    #include "sockpp/inet_address.h"
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+notifier::notifier() {
+    if (auto res = open(); !res) {
+        close();
+        throw std::system_error{res.error()};
+    }
+}
+
+notifier::notifier(error_code& ec) noexcept {
+    if (auto res = open(); !res) {
+        close();
+        ec = res.error();
+    }
+}
+
+notifier::~notifier() { close(); }
+
+// --------------------------------------------------------------------------
+// An eventfd is a single handle and a counter, so it's the cheapest
+// option. A kqueue EVFILT_USER event would be cheaper still on the BSDs,
+// but it isn't a handle that can be registered with a poller, so a pipe is
+// used there instead.
+
+#if defined(__linux__)
+
+result<> notifier::open() {
+    fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return (fd_ < 0) ? result<>::from_last_error() : none{};
+}
+
+void notifier::close() noexcept {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+socket_t notifier::handle() const noexcept { return fd_; }
+
+void notifier::notify() noexcept {
+    if (pending_.exchange(true))
+        return;
+
+    uint64_t val = 1;
+    (void)!::write(fd_, &val, sizeof(val));
+}
+
+bool notifier::reset() noexcept {
+    // Clear the flag first, so a notification that arrives while draining
+    // signals the handle again, rather than being missed.
+    bool was = pending_.exchange(false);
+
+    uint64_t val;
+    (void)!::read(fd_, &val, sizeof(val));
+    return was;
+}
+
+#elif !defined(_WIN32)
+
+result<> notifier::open() {
+    if (::pipe(fds_) < 0)
+        return result<>::from_last_error();
+
+    for (auto fd : fds_) {
+        if (::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK) < 0 ||
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC) < 0)
+            return result<>::from_last_error();
+    }
+    return none{};
+}
+
+void notifier::close() noexcept {
+    for (auto& fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+socket_t notifier::handle() const noexcept { return fds_[0]; }
+
+void notifier::notify() noexcept {
+    if (pending_.exchange(true))
+        return;
+
+    char c = 0;
+    (void)!::write(fds_[1], &c, 1);
+}
+
+bool notifier::reset() noexcept {
+    bool was = pending_.exchange(false);
+
+    char buf[64];
+    while (::read(fds_[0], buf, sizeof(buf)) > 0)
+        ;
+    return was;
+}
+
+#else
+
+result<> notifier::open() {
+    auto sres = socket::create(AF_INET, SOCK_DGRAM);
+    if (!sres)
+        return sres.error();
+
+    sock_ = datagram_socket{sres.release().release()};
+    if (auto res = sock_.bind(inet_address{INADDR_LOOPBACK, 0}); !res)
+        return res;
+    if (auto res = sock_.connect(sock_.address()); !res)
+        return res;
+    return sock_.set_non_blocking();
+}
+
+void notifier::close() noexcept { (void)sock_.close(); }
+
+socket_t notifier::handle() const noexcept { return sock_.handle(); }
+
+void notifier::notify() noexcept {
+    if (pending_.exchange(true))
+        return;
+
+    char c = 0;
+    (void)sock_.send(&c, 1);
+}
+
+bool notifier::reset() noexcept {
+    bool was = pending_.exchange(false);
+
+    char buf[64];
+    while (sock_.recv(buf, sizeof(buf)))
+        ;
+    return was;
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
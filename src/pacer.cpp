@@ -0,0 +1,152 @@
+// pacer.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/pacer.h"
+
+#include <algorithm>
+
+#include "stats.h"
+
+namespace sockpp {
+
+// The number of nanoseconds in a second
+static constexpr uint64_t NANOS_PER_SEC = 1000000000;
+
+// The default burst for a rate.
+static size_t default_burst(uint64_t rate) {
+    auto n = rate / (1000 / uint64_t(pacer::DFLT_BURST_TIME.count()));
+    return size_t(std::max<uint64_t>(n, pacer::MIN_BURST));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+pacer::pacer(uint64_t bytesPerSec, size_t burst /*=0*/)
+    : rate_{bytesPerSec},
+      burst_{burst ? burst : default_burst(bytesPerSec)},
+      tokens_{int64_t(burst_)},
+      last_{clock::now()} {}
+
+void pacer::rate(uint64_t bytesPerSec, size_t burst /*=0*/) {
+    auto now = clock::now();
+    refill(now);
+    if (bytesPerSec == 0)
+        note_throttle(false, now);
+    rate_ = bytesPerSec;
+    burst_ = burst ? burst : default_burst(bytesPerSec);
+    tokens_ = std::min(tokens_, int64_t(burst_));
+}
+
+// --------------------------------------------------------------------------
+
+// The credit is kept in whole bytes. The refill time only moves ahead by
+// the time it took to earn them, so the fractions aren't lost.
+void pacer::refill(time_point now) noexcept {
+    if (now <= last_)
+        return;
+
+    if (rate_ == 0) {
+        last_ = now;
+        return;
+    }
+
+    auto need = int64_t(burst_) - tokens_;
+    auto dt = std::chrono::duration_cast<nanoseconds>(now - last_).count();
+
+    if (need <= 0 || uint64_t(dt) >= uint64_t(need) * NANOS_PER_SEC / rate_) {
+        tokens_ = std::max(tokens_, int64_t(burst_));
+        last_ = now;
+        return;
+    }
+
+    auto credit = uint64_t(dt) * rate_ / NANOS_PER_SEC;
+    tokens_ += int64_t(credit);
+    last_ += nanoseconds{int64_t(credit * NANOS_PER_SEC / rate_)};
+}
+
+void pacer::note_throttle(bool held, time_point now) noexcept {
+    if (held) {
+        if (!throttled_) {
+            throttled_ = true;
+            throttledSince_ = now;
+        }
+    }
+    else if (throttled_) {
+        throttled_ = false;
+        auto dt = std::chrono::duration_cast<nanoseconds>(now - throttledSince_);
+        throttledTime_ += dt;
+        detail::stats_throttle(dt);
+    }
+}
+
+// --------------------------------------------------------------------------
+
+size_t pacer::allow(size_t n, time_point now /*=clock::now()*/) noexcept {
+    if (rate_ == 0)
+        return n;
+
+    refill(now);
+    auto avail = tokens_ > 0 ? size_t(tokens_) : size_t(0);
+    auto k = std::min(n, avail);
+    note_throttle(k < n, now);
+    return k;
+}
+
+void pacer::consume(size_t n) noexcept {
+    if (rate_ != 0)
+        tokens_ -= int64_t(n);
+}
+
+nanoseconds pacer::delay(size_t n, time_point now /*=clock::now()*/) noexcept {
+    if (rate_ == 0)
+        return nanoseconds{0};
+
+    refill(now);
+    auto want = int64_t(std::min(n, burst_));
+    if (tokens_ >= want)
+        return nanoseconds{0};
+
+    // The time to earn the missing bytes, less the time already toward
+    // the next one, rounded up.
+    auto need = uint64_t(want - tokens_);
+    auto t = (need * NANOS_PER_SEC + rate_ - 1) / rate_;
+    auto dt = (now > last_)
+                  ? uint64_t(std::chrono::duration_cast<nanoseconds>(now - last_).count())
+                  : uint64_t(0);
+    return nanoseconds{int64_t(t > dt ? t - dt : 0)};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
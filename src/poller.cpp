@@ -0,0 +1,367 @@
+// poller.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/poller.h"
+
+#include <algorithm>
+
+#if defined(SOCKPP_POLLER_EPOLL)
+    #include <sys/epoll.h>
+#elif defined(SOCKPP_POLLER_KQUEUE)
+    #include <sys/event.h>
+    #include <sys/types.h>
+#endif
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(SOCKPP_POLLER_EPOLL)
+
+namespace {
+
+// Converts sockpp poller flags to epoll flags
+uint32_t to_epoll(uint32_t events) {
+    uint32_t ev = EPOLLRDHUP;
+    if (events & poller::READABLE)
+        ev |= EPOLLIN;
+    if (events & poller::WRITABLE)
+        ev |= EPOLLOUT;
+    return ev;
+}
+
+// Converts epoll flags to sockpp poller flags
+uint32_t from_epoll(uint32_t ev) {
+    uint32_t events = 0;
+    if (ev & EPOLLIN)
+        events |= poller::READABLE;
+    if (ev & EPOLLOUT)
+        events |= poller::WRITABLE;
+    if (ev & (EPOLLHUP | EPOLLRDHUP))
+        events |= poller::HANGUP;
+    if (ev & EPOLLERR)
+        events |= poller::ERRORS;
+    return events;
+}
+
+}  // namespace
+
+poller::poller(error_code& ec) noexcept {
+    handle_ = ::epoll_create1(EPOLL_CLOEXEC);
+    ec = (handle_ < 0) ? result<>::last_error() : error_code{};
+}
+
+poller::~poller() {
+    if (handle_ >= 0)
+        ::close(handle_);
+}
+
+result<> poller::add(socket_t h, uint32_t events) {
+    epoll_event ev{};
+    ev.events = to_epoll(events);
+    ev.data.fd = h;
+
+    if (::epoll_ctl(handle_, EPOLL_CTL_ADD, h, &ev) < 0)
+        return result<>::from_last_error();
+
+    ++n_;
+    return none{};
+}
+
+result<> poller::modify(socket_t h, uint32_t events) {
+    epoll_event ev{};
+    ev.events = to_epoll(events);
+    ev.data.fd = h;
+
+    if (::epoll_ctl(handle_, EPOLL_CTL_MOD, h, &ev) < 0)
+        return result<>::from_last_error();
+    return none{};
+}
+
+result<> poller::remove(socket_t h) {
+    // Pre 2.6.9 kernels require a non-null event pointer
+    epoll_event ev{};
+    if (::epoll_ctl(handle_, EPOLL_CTL_DEL, h, &ev) < 0)
+        return result<>::from_last_error();
+
+    --n_;
+    return none{};
+}
+
+result<size_t> poller::wait(event* evts, size_t maxEvts, milliseconds timeout) {
+    epoll_event kevts[DFLT_MAX_EVENTS];
+
+    int ms = timeout.count() < 0 ? -1 : int(timeout.count());
+    int n = int(std::min(maxEvts, DFLT_MAX_EVENTS));
+
+    if ((n = ::epoll_wait(handle_, kevts, n, ms)) < 0)
+        return result<size_t>::from_last_error();
+
+    for (int i = 0; i < n; ++i)
+        evts[i] = event{socket_t(kevts[i].data.fd), from_epoll(kevts[i].events)};
+
+    return size_t(n);
+}
+
+#elif defined(SOCKPP_POLLER_KQUEUE)
+
+// --------------------------------------------------------------------------
+// With kqueue, reads and writes are registered as separate filters. Both
+// filters are always installed, and just enabled or disabled as needed, so
+// that a modify or remove never has to know the previous state.
+
+namespace {
+
+result<> kq_ctl(int kq, socket_t h, uint32_t events, bool del = false) {
+    struct kevent kev[2];
+
+    if (del) {
+        EV_SET(&kev[0], h, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+        EV_SET(&kev[1], h, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+    }
+    else {
+        uint16_t rd = (events & poller::READABLE) ? EV_ENABLE : EV_DISABLE,
+                 wr = (events & poller::WRITABLE) ? EV_ENABLE : EV_DISABLE;
+
+        EV_SET(&kev[0], h, EVFILT_READ, EV_ADD | rd, 0, 0, nullptr);
+        EV_SET(&kev[1], h, EVFILT_WRITE, EV_ADD | wr, 0, 0, nullptr);
+    }
+
+    if (::kevent(kq, kev, 2, nullptr, 0, nullptr) < 0)
+        return result<>::from_last_error();
+    return none{};
+}
+
+}  // namespace
+
+poller::poller(error_code& ec) noexcept {
+    handle_ = ::kqueue();
+    ec = (handle_ < 0) ? result<>::last_error() : error_code{};
+}
+
+poller::~poller() {
+    if (handle_ >= 0)
+        ::close(handle_);
+}
+
+result<> poller::add(socket_t h, uint32_t events) {
+    auto res = kq_ctl(handle_, h, events);
+    if (res)
+        ++n_;
+    return res;
+}
+
+result<> poller::modify(socket_t h, uint32_t events) { return kq_ctl(handle_, h, events); }
+
+result<> poller::remove(socket_t h) {
+    auto res = kq_ctl(handle_, h, 0, true);
+    if (res)
+        --n_;
+    return res;
+}
+
+result<size_t> poller::wait(event* evts, size_t maxEvts, milliseconds timeout) {
+    struct kevent kevts[DFLT_MAX_EVENTS];
+
+    timespec ts, *pts = nullptr;
+    if (timeout.count() >= 0) {
+        auto sec = duration_cast<seconds>(timeout);
+        ts.tv_sec = time_t(sec.count());
+        ts.tv_nsec = long(duration_cast<nanoseconds>(timeout - sec).count());
+        pts = &ts;
+    }
+
+    int n = int(std::min(maxEvts, DFLT_MAX_EVENTS));
+    if ((n = ::kevent(handle_, nullptr, 0, kevts, n, pts)) < 0)
+        return result<size_t>::from_last_error();
+
+    for (int i = 0; i < n; ++i) {
+        uint32_t ev = (kevts[i].filter == EVFILT_WRITE) ? WRITABLE : READABLE;
+        if (kevts[i].flags & EV_EOF)
+            ev |= HANGUP;
+        if (kevts[i].flags & EV_ERROR)
+            ev |= ERRORS;
+        evts[i] = event{socket_t(kevts[i].ident), ev};
+    }
+
+    return size_t(n);
+}
+
+#else
+
+// --------------------------------------------------------------------------
+// The poll() fallback keeps an array of descriptors which is handed to the
+// OS on each wait.
+
+namespace {
+
+short to_poll(uint32_t events) {
+    short ev = 0;
+    if (events & poller::READABLE)
+        ev |= POLLIN;
+    if (events & poller::WRITABLE)
+        ev |= POLLOUT;
+    return ev;
+}
+
+uint32_t from_poll(short ev) {
+    uint32_t events = 0;
+    if (ev & POLLIN)
+        events |= poller::READABLE;
+    if (ev & POLLOUT)
+        events |= poller::WRITABLE;
+    if (ev & POLLHUP)
+        events |= poller::HANGUP;
+    if (ev & (POLLERR | POLLNVAL))
+        events |= poller::ERRORS;
+    return events;
+}
+
+}  // namespace
+
+poller::poller(error_code& ec) noexcept { ec = error_code{}; }
+
+poller::~poller() {}
+
+size_t poller::find(socket_t h) const {
+    auto it =
+        std::find_if(fds_.begin(), fds_.end(), [h](const auto& pfd) { return pfd.fd == h; });
+    return size_t(it - fds_.begin());
+}
+
+result<> poller::add(socket_t h, uint32_t events) {
+    if (find(h) != fds_.size())
+        return errc::file_exists;
+
+    auto pfd = decltype(fds_)::value_type{};
+    pfd.fd = h;
+    pfd.events = to_poll(events);
+    fds_.push_back(pfd);
+    ++n_;
+    return none{};
+}
+
+result<> poller::modify(socket_t h, uint32_t events) {
+    auto i = find(h);
+    if (i == fds_.size())
+        return errc::no_such_file_or_directory;
+
+    fds_[i].events = to_poll(events);
+    return none{};
+}
+
+result<> poller::remove(socket_t h) {
+    auto i = find(h);
+    if (i == fds_.size())
+        return errc::no_such_file_or_directory;
+
+    fds_[i] = fds_.back();
+    fds_.pop_back();
+    --n_;
+    return none{};
+}
+
+result<size_t> poller::wait(event* evts, size_t maxEvts, milliseconds timeout) {
+    int ms = timeout.count() < 0 ? -1 : int(timeout.count());
+
+    #if defined(_WIN32)
+    int n = ::WSAPoll(fds_.data(), ULONG(fds_.size()), ms);
+    #else
+    int n = ::poll(fds_.data(), nfds_t(fds_.size()), ms);
+    #endif
+
+    if (n < 0)
+        return result<size_t>::from_last_error();
+
+    size_t nevt = 0;
+    for (size_t i = 0; i < fds_.size() && nevt < maxEvts && n > 0; ++i) {
+        if (fds_[i].revents != 0) {
+            evts[nevt++] = event{socket_t(fds_[i].fd), from_poll(fds_[i].revents)};
+            --n;
+        }
+    }
+    return nevt;
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+// Platform-independent functions
+
+poller::poller() {
+    error_code ec;
+    *this = poller{ec};
+    if (ec)
+        throw std::system_error{ec};
+}
+
+poller::poller(poller&& other) noexcept : n_{other.n_} {
+#if defined(SOCKPP_POLLER_EPOLL) || defined(SOCKPP_POLLER_KQUEUE)
+    handle_ = other.handle_;
+    other.handle_ = -1;
+#else
+    fds_ = std::move(other.fds_);
+#endif
+    other.n_ = 0;
+}
+
+poller& poller::operator=(poller&& rhs) noexcept {
+    if (&rhs != this) {
+#if defined(SOCKPP_POLLER_EPOLL) || defined(SOCKPP_POLLER_KQUEUE)
+        std::swap(handle_, rhs.handle_);
+#else
+        std::swap(fds_, rhs.fds_);
+#endif
+        std::swap(n_, rhs.n_);
+    }
+    return *this;
+}
+
+result<size_t> poller::wait(std::vector<event>& evts, milliseconds timeout) {
+    size_t n = evts.capacity();
+    if (n == 0)
+        n = DFLT_MAX_EVENTS;
+    evts.resize(n);
+
+    auto res = wait(evts.data(), n, timeout);
+    evts.resize(res ? res.value() : 0);
+    return res;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
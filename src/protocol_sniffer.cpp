@@ -0,0 +1,280 @@
+// protocol_sniffer.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/protocol_sniffer.h"
+
+#include <algorithm>
+
+namespace sockpp {
+
+namespace {
+
+using match = protocol_sniffer::match;
+
+// Peeks straight from the OS, so that the bytes aren't counted in the
+// socket stats now, and again when the handler reads them.
+result<size_t> raw_peek(socket_t h, char* buf, size_t n) {
+#if defined(_WIN32)
+    ssize_t ret = ::recv(h, buf, int(n), MSG_PEEK);
+#else
+    ssize_t ret = ::recv(h, buf, n, MSG_PEEK);
+#endif
+    return (ret < 0) ? result<size_t>::from_last_error() : result<size_t>{size_t(ret)};
+}
+
+// Matches the data against the start of a protocol
+match match_prefix(std::string_view data, std::string_view prefix) {
+    auto n = std::min(data.size(), prefix.size());
+    if (data.substr(0, n) != prefix.substr(0, n))
+        return match::no;
+    return (n == prefix.size()) ? match::yes : match::more;
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+protocol_sniffer::protocol_sniffer(
+    reactor& rx, milliseconds timeout /*=milliseconds{2000}*/,
+    size_t peekSize /*=DFLT_PEEK_SIZE*/
+)
+    : rx_{rx}, peekSize_{std::max<size_t>(peekSize, 1)}, timeout_{timeout}, buf_(peekSize_) {}
+
+protocol_sniffer::~protocol_sniffer() {
+    for (auto acc : listeners_)
+        rx_.remove(*acc);
+    for (auto& [h, ent] : pending_)
+        rx_.remove(h);
+}
+
+void protocol_sniffer::add(matcher_type matcher, handler_type handler) {
+    routes_.push_back({std::move(matcher), std::move(handler)});
+}
+
+// --------------------------------------------------------------------------
+
+result<> protocol_sniffer::attach(acceptor& acc) {
+    if (auto res = acc.set_non_blocking(); !res)
+        return res;
+
+    auto res = rx_.add(acc, poller::READABLE, [this, &acc](uint32_t) { on_accept(acc); });
+    if (res)
+        listeners_.push_back(&acc);
+    return res;
+}
+
+void protocol_sniffer::detach(acceptor& acc) {
+    auto it = std::find(listeners_.begin(), listeners_.end(), &acc);
+    if (it != listeners_.end()) {
+        rx_.remove(acc);
+        listeners_.erase(it);
+    }
+}
+
+void protocol_sniffer::on_accept(acceptor& acc) {
+    while (true) {
+        auto res = acc.accept(nullptr, socket::NON_BLOCKING);
+        if (!res) {
+            if (res == errc::connection_aborted)
+                continue;
+            break;
+        }
+        watch(res.release(), false);
+    }
+}
+
+// --------------------------------------------------------------------------
+
+result<> protocol_sniffer::add_connection(stream_socket sock) {
+    bool nonBlocking = sock.is_non_blocking();
+    if (!nonBlocking) {
+        if (auto res = sock.set_non_blocking(); !res)
+            return res;
+    }
+    return watch(std::move(sock), nonBlocking);
+}
+
+result<> protocol_sniffer::watch(stream_socket sock, bool nonBlocking) {
+    auto h = sock.handle();
+    if (auto res = rx_.add(h, poller::READABLE, [this, h](uint32_t) { on_ready(h); }); !res)
+        return res;
+
+    pending_.emplace(h, entry{std::move(sock), clock::now() + timeout_, nonBlocking});
+    return none{};
+}
+
+void protocol_sniffer::on_ready(socket_t h) {
+    auto it = pending_.find(h);
+    if (it == pending_.end())
+        return;
+
+    auto res = raw_peek(h, buf_.data(), buf_.size());
+    if (!res) {
+        if (!res.is_would_block())
+            dispatch(h, handler_type{});
+        return;
+    }
+
+    // The peer closed before it could be matched
+    auto n = res.value();
+    if (n == 0) {
+        dispatch(h, handler_type{});
+        return;
+    }
+
+    std::string_view data{buf_.data(), n};
+    bool more = false;
+
+    for (const auto& r : routes_) {
+        auto m = r.matcher(data);
+        if (m == match::yes) {
+            dispatch(h, r.handler);
+            return;
+        }
+        more = more || (m == match::more);
+    }
+
+    if (!more || n >= peekSize_) {
+        dispatch(h, fallback_);
+        return;
+    }
+
+    // Sleep until there's more data than we've seen, rather than spinning
+    // on the level-triggered reactor with the same bytes.
+    auto& ent = it->second;
+    if (!ent.sock.recv_lowat(int(n + 1))) {
+        dispatch(h, fallback_);
+        return;
+    }
+    ent.lowat = true;
+}
+
+void protocol_sniffer::dispatch(socket_t h, const handler_type& handler) {
+    auto it = pending_.find(h);
+    if (it == pending_.end())
+        return;
+
+    rx_.remove(h);
+    auto ent = std::move(it->second);
+    pending_.erase(it);
+
+    // With no handler, the connection is closed as it goes out of scope.
+    // The handler may change the routes, so it's called from a copy.
+    if (!handler)
+        return;
+    auto fn = handler;
+
+    if (ent.lowat)
+        ent.sock.recv_lowat(1);
+    if (!ent.nonBlocking)
+        ent.sock.set_non_blocking(false);
+
+    fn(std::move(ent.sock));
+}
+
+// --------------------------------------------------------------------------
+
+size_t protocol_sniffer::expire(clock::time_point now /*=clock::now()*/) {
+    std::vector<socket_t> expired;
+    for (const auto& [h, ent] : pending_) {
+        if (ent.deadline <= now)
+            expired.push_back(h);
+    }
+
+    for (auto h : expired)
+        dispatch(h, fallback_);
+    return expired.size();
+}
+
+milliseconds protocol_sniffer::next_timeout() const {
+    if (pending_.empty())
+        return milliseconds{-1};
+
+    auto next = clock::time_point::max();
+    for (const auto& [h, ent] : pending_) next = std::min(next, ent.deadline);
+
+    auto ms = std::chrono::ceil<milliseconds>(next - clock::now());
+    return std::max(ms, milliseconds{0});
+}
+
+// --------------------------------------------------------------------------
+
+protocol_sniffer::matcher_type protocol_sniffer::prefix(std::string prefix) {
+    return [prefix = std::move(prefix)](std::string_view data) {
+        return match_prefix(data, prefix);
+    };
+}
+
+protocol_sniffer::matcher_type protocol_sniffer::tls() {
+    // A handshake record (22), with a major version of 3 and a minor
+    // version from SSL 3.0 (0) to TLS 1.3 (4).
+    return [](std::string_view data) {
+        auto n = data.size();
+        if (n == 0)
+            return match::more;
+        if (uint8_t(data[0]) != 0x16)
+            return match::no;
+        if (n < 2)
+            return match::more;
+        if (uint8_t(data[1]) != 0x03)
+            return match::no;
+        if (n < 3)
+            return match::more;
+        return (uint8_t(data[2]) <= 0x04) ? match::yes : match::no;
+    };
+}
+
+protocol_sniffer::matcher_type protocol_sniffer::http() {
+    static constexpr std::string_view PREFIXES[] = {
+        "GET ",     "HEAD ",  "POST ",  "PUT ",    "DELETE ",
+        "OPTIONS ", "PATCH ", "TRACE ", "CONNECT ", "PRI * HTTP/2.0"
+    };
+
+    return [](std::string_view data) {
+        auto ret = match::no;
+        for (auto p : PREFIXES) {
+            auto m = match_prefix(data, p);
+            if (m == match::yes)
+                return m;
+            if (m == match::more)
+                ret = m;
+        }
+        return ret;
+    };
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
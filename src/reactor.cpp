@@ -0,0 +1,140 @@
+// reactor.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/reactor.h"
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+reactor::reactor() { evts_.reserve(poller::DFLT_MAX_EVENTS); }
+
+reactor::reactor(error_code& ec) noexcept : poller_{ec} {
+    evts_.reserve(poller::DFLT_MAX_EVENTS);
+}
+
+// --------------------------------------------------------------------------
+
+result<> reactor::add(socket_t h, uint32_t events, handler_type handler) {
+    if (handlers_.count(h) != 0)
+        return errc::file_exists;
+
+    if (auto res = poller_.add(h, events); !res)
+        return res;
+
+    handlers_[h] = std::make_shared<entry>(entry{events, std::move(handler)});
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<> reactor::modify(socket_t h, uint32_t events) {
+    auto it = handlers_.find(h);
+    if (it == handlers_.end())
+        return errc::no_such_file_or_directory;
+
+    if (it->second->events == events)
+        return none{};
+
+    if (auto res = poller_.modify(h, events); !res)
+        return res;
+
+    it->second->events = events;
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+
+result<> reactor::remove(socket_t h) {
+    auto it = handlers_.find(h);
+    if (it == handlers_.end())
+        return errc::no_such_file_or_directory;
+
+    handlers_.erase(it);
+    return poller_.remove(h);
+}
+
+// --------------------------------------------------------------------------
+// Each handler is kept alive by a local reference while it runs, so that a
+// handler can safely remove its own socket. Each event's handle is looked
+// up again, so an event for a socket removed earlier in the same dispatch
+// is dropped. If the handle was reused by a newly-added socket, that
+// socket might see a spurious event, which is harmless for a non-blocking
+// socket.
+
+result<size_t> reactor::run_once(milliseconds timeout /*=-1*/) {
+    auto res = poller_.wait(evts_, timeout);
+    if (!res) {
+        if (res != errc::interrupted)
+            return res;
+        evts_.clear();
+    }
+
+    size_t n = 0;
+    for (const auto& evt : evts_) {
+        auto it = handlers_.find(evt.handle);
+        if (it == handlers_.end())
+            continue;
+
+        auto ent = it->second;
+        uint32_t events = evt.events & (ent->events | poller::HANGUP | poller::ERRORS);
+        if (events != 0) {
+            ent->handler(events);
+            ++n;
+        }
+    }
+
+    if (tickHandler_)
+        tickHandler_();
+    return n;
+}
+
+// --------------------------------------------------------------------------
+
+result<> reactor::run() {
+    stopped_ = false;
+
+    while (!stopped_ && !handlers_.empty()) {
+        if (auto res = run_once(); !res)
+            return res.error();
+    }
+    return none{};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
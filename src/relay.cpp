@@ -0,0 +1,279 @@
+// relay.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/relay.h"
+
+namespace sockpp {
+
+#if defined(__linux__)
+namespace {
+
+// Creates a pipe, which is left closed if the system won't give us one.
+splice_pipe make_pipe() {
+    error_code ec;
+    return splice_pipe{ec};
+}
+
+}  // namespace
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+//								direction
+/////////////////////////////////////////////////////////////////////////////
+
+relay::direction::direction(stream_socket& s, stream_socket& d)
+    : src{&s},
+      dst{&d}
+#if defined(__linux__)
+      ,
+      pipe{make_pipe()}
+#endif
+{
+}
+
+bool relay::direction::pending() const noexcept {
+#if defined(__linux__)
+    if (pipe.pending() != 0)
+        return true;
+#endif
+    return off < buf.size();
+}
+
+result<> relay::direction::pump(buffer_pool& pool) {
+#if defined(__linux__)
+    if (pipe.is_open())
+        return splice();
+#endif
+    return copy(pool);
+}
+
+// --------------------------------------------------------------------------
+// The pipe returns zero only once the source has hit the end of its stream
+// and everything that came before has gone out.
+
+#if defined(__linux__)
+result<> relay::direction::splice() {
+    while (!closed) {
+        auto res = pipe.relay(*src, *dst);
+        if (!res) {
+            if (res.is_would_block())
+                break;
+            return res.error();
+        }
+
+        if (res.value() == 0) {
+            eof = closed = true;
+            dst->shutdown(SHUT_WR);
+        }
+        nbytes += res.value();
+    }
+    return none{};
+}
+#endif
+
+// --------------------------------------------------------------------------
+// A buffer is only held while there's data in it, and nothing more is read
+// until it's all been written.
+
+result<> relay::direction::copy(buffer_pool& pool) {
+    while (!closed) {
+        if (off < buf.size()) {
+            auto res = dst->write(buf.data() + off, buf.size() - off);
+            if (!res) {
+                if (res.is_would_block())
+                    break;
+                return res.error();
+            }
+            off += res.value();
+            nbytes += res.value();
+
+            if (off < buf.size())
+                break;
+            buf.reset();
+            off = 0;
+        }
+        else if (eof) {
+            closed = true;
+            dst->shutdown(SHUT_WR);
+        }
+        else {
+            if (!buf)
+                buf = pool.get();
+
+            auto res = src->read(buf.data(), buf.capacity());
+            if (!res) {
+                buf.reset();
+                if (res.is_would_block())
+                    break;
+                return res.error();
+            }
+
+            if (res.value() == 0) {
+                buf.reset();
+                eof = true;
+            }
+            else {
+                buf.resize(res.value());
+                off = 0;
+            }
+        }
+    }
+    return none{};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								relay
+/////////////////////////////////////////////////////////////////////////////
+
+relay::relay(stream_socket& a, stream_socket& b, buffer_pool& pool)
+    : ab_{a, b}, ba_{b, a}, pool_{pool} {}
+
+buffer_pool& relay::default_pool() {
+    static buffer_pool pool;
+    return pool;
+}
+
+bool relay::is_spliced() const noexcept {
+#if defined(__linux__)
+    return ab_.pipe.is_open() && ba_.pipe.is_open();
+#else
+    return false;
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+result<bool> relay::pump() {
+    if (auto res = ab_.pump(pool_); !res)
+        return res.error();
+    if (auto res = ba_.pump(pool_); !res)
+        return res.error();
+    return done();
+}
+
+// --------------------------------------------------------------------------
+// A socket is read while its outgoing data has somewhere to go, and written
+// while there's incoming data backed up for it.
+
+uint32_t relay::interest(const direction& out, const direction& in) const noexcept {
+    uint32_t events = 0;
+    if (!out.eof && !out.pending())
+        events |= poller::READABLE;
+    if (in.pending())
+        events |= poller::WRITABLE;
+    return events;
+}
+
+// --------------------------------------------------------------------------
+
+result<> relay::attach(reactor& rx, done_handler onDone /*=nullptr*/) {
+    detach();
+
+    auto& a = *ab_.src;
+    auto& b = *ba_.src;
+
+    if (auto res = a.set_non_blocking(); !res)
+        return res;
+    if (auto res = b.set_non_blocking(); !res)
+        return res;
+
+    onDone_ = std::move(onDone);
+
+    if (auto res = rx.add(a, interest(ab_, ba_), [this](uint32_t) { on_ready(); }); !res)
+        return res;
+
+    if (auto res = rx.add(b, interest(ba_, ab_), [this](uint32_t) { on_ready(); }); !res) {
+        rx.remove(a);
+        return res;
+    }
+
+    rx_ = &rx;
+    return none{};
+}
+
+void relay::detach() {
+    if (rx_) {
+        rx_->remove(*ab_.src);
+        rx_->remove(*ba_.src);
+        rx_ = nullptr;
+    }
+}
+
+// --------------------------------------------------------------------------
+// The handler is called last, since it's allowed to destroy the relay.
+
+void relay::on_ready() {
+    error_code ec;
+
+    if (auto res = pump(); !res)
+        ec = res.error();
+    else if (!res.value()) {
+        auto res1 = rx_->modify(*ab_.src, interest(ab_, ba_));
+        auto res2 = rx_->modify(*ba_.src, interest(ba_, ab_));
+        if (res1 && res2)
+            return;
+        ec = res1 ? res2.error() : res1.error();
+    }
+
+    detach();
+    if (onDone_) {
+        auto fn = std::move(onDone_);
+        fn(*this, ec);
+    }
+}
+
+// --------------------------------------------------------------------------
+
+result<> relay::run() {
+    error_code ec;
+    reactor rx{ec};
+    if (ec)
+        return ec;
+
+    if (auto res = attach(rx, [&ec](relay&, error_code err) { ec = err; }); !res)
+        return res;
+
+    if (auto res = rx.run(); !res) {
+        detach();
+        return res;
+    }
+    if (ec)
+        return ec;
+    return none{};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,342 @@
+// resolver.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/resolver.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "sockpp/error.h"
+#include "stats.h"
+#include "trace.h"
+
+using namespace std;
+
+namespace sockpp {
+
+namespace {
+
+// Converts a getaddrinfo() failure to an error code
+error_code gai_error(int err) {
+#if defined(_WIN32)
+    return error_code{err, system_category()};
+#else
+    if (err == EAI_SYSTEM)
+        return result<>::last_error();
+    return make_error_code(static_cast<gai_errc>(err));
+#endif
+}
+
+// Sets the port of an IPv4 or IPv6 address
+void set_port(sock_address_any& addr, in_port_t port) {
+    if (addr.family() == AF_INET)
+        reinterpret_cast<sockaddr_in*>(addr.sockaddr_ptr())->sin_port = htons(port);
+    else if (addr.family() == AF_INET6)
+        reinterpret_cast<sockaddr_in6*>(addr.sockaddr_ptr())->sin6_port = htons(port);
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+resolver::resolver(
+    size_t nThreads /*=DFLT_NUM_THREADS*/, seconds ttl /*=DFLT_TTL*/,
+    seconds negTtl /*=DFLT_NEGATIVE_TTL*/, size_t maxEntries /*=DFLT_MAX_ENTRIES*/
+)
+    : ttl_{ttl},
+      negTtl_{negTtl},
+      maxEntries_{std::max<size_t>(maxEntries, 1)},
+      nThreads_{std::max<size_t>(nThreads, 1)} {}
+
+resolver::~resolver() {
+    decltype(inFlight_) canceled;
+    {
+        unique_lock<mutex> lk{mtx_};
+        quit_ = true;
+
+        // The queued lookups that no worker has started
+        for (const auto& key : queue_) {
+            auto it = inFlight_.find(key);
+            if (it != inFlight_.end()) {
+                canceled.insert(std::move(*it));
+                inFlight_.erase(it);
+            }
+        }
+        queue_.clear();
+    }
+    cv_.notify_all();
+
+    for (auto& thr : threads_) thr.join();
+
+    for (auto& [key, reqs] : canceled) {
+        for (auto& [port, h] : reqs) {
+            if (h)
+                h(errc::operation_canceled);
+        }
+    }
+}
+
+resolver& resolver::global() {
+    static resolver res;
+    return res;
+}
+
+// --------------------------------------------------------------------------
+
+resolver::result_type resolver::lookup(
+    const string& host, in_port_t port, int family /*=AF_UNSPEC*/
+) {
+    addrinfo *res, hints = addrinfo{};
+    hints.ai_family = family;
+    hints.ai_socktype = SOCK_STREAM;
+
+    SOCKPP_TRACE2(resolve__entry, host.c_str(), family);
+    auto t0 = detail::stats_now();
+    int err = ::getaddrinfo(host.c_str(), nullptr, &hints, &res);
+    detail::stats_latency_since(latency_op::resolve, t0);
+    SOCKPP_TRACE2(resolve__return, host.c_str(), err);
+    if (err != 0)
+        return gai_error(err);
+
+    // Split by family, keeping the resolver's order within each, and
+    // dropping any duplicates.
+    addr_list first, second;
+    int firstFamily = res->ai_family;
+
+    for (auto ai = res; ai; ai = ai->ai_next) {
+        if (ai->ai_family != AF_INET && ai->ai_family != AF_INET6)
+            continue;
+
+        sock_address_any addr{ai->ai_addr, socklen_t(ai->ai_addrlen)};
+        set_port(addr, port);
+
+        auto& v = (ai->ai_family == firstFamily) ? first : second;
+
+        auto dup = std::find_if(v.begin(), v.end(), [&addr](const auto& a) {
+            return a.size() == addr.size() &&
+                   std::memcmp(a.sockaddr_ptr(), addr.sockaddr_ptr(), a.size()) == 0;
+        });
+        if (dup == v.end())
+            v.push_back(addr);
+    }
+    ::freeaddrinfo(res);
+
+    addr_list addrs;
+    addrs.reserve(first.size() + second.size());
+
+    for (size_t i = 0; i < std::max(first.size(), second.size()); ++i) {
+        if (i < first.size())
+            addrs.push_back(first[i]);
+        if (i < second.size())
+            addrs.push_back(second[i]);
+    }
+
+    if (addrs.empty())
+        return errc::address_not_available;
+    return addrs;
+}
+
+// --------------------------------------------------------------------------
+
+const resolver::entry* resolver::find(const key_type& key) const {
+    auto it = cache_.find(key);
+    if (it == cache_.end() || it->second.expiry <= clock::now())
+        return nullptr;
+    return &it->second;
+}
+
+// --------------------------------------------------------------------------
+// When the cache is full, expired entries are purged, and failing that,
+// the one closest to expiring is dropped.
+
+void resolver::store(const key_type& key, const result_type& res) {
+    auto now = clock::now();
+
+    if (cache_.size() >= maxEntries_ && cache_.find(key) == cache_.end()) {
+        for (auto it = cache_.begin(); it != cache_.end();) {
+            if (it->second.expiry <= now)
+                it = cache_.erase(it);
+            else
+                ++it;
+        }
+
+        if (cache_.size() >= maxEntries_) {
+            auto it = std::min_element(cache_.begin(), cache_.end(), [](auto& a, auto& b) {
+                return a.second.expiry < b.second.expiry;
+            });
+            cache_.erase(it);
+        }
+    }
+
+    auto& e = cache_[key];
+    e.addrs = res ? res.value() : addr_list{};
+    e.err = res.error();
+    e.expiry = now + (res ? ttl_ : negTtl_);
+}
+
+// --------------------------------------------------------------------------
+
+resolver::result_type resolver::make_result(const entry& e, in_port_t port) {
+    if (e.err)
+        return e.err;
+
+    auto addrs = e.addrs;
+    for (auto& addr : addrs) set_port(addr, port);
+    return addrs;
+}
+
+// --------------------------------------------------------------------------
+
+resolver::result_type resolver::resolve(
+    const string& host, in_port_t port, int family /*=AF_UNSPEC*/
+) {
+    key_type key{family, host};
+    {
+        lock_guard<mutex> lk{mtx_};
+        if (auto e = find(key); e)
+            return make_result(*e, port);
+    }
+
+    auto res = lookup(host, 0, family);
+
+    lock_guard<mutex> lk{mtx_};
+    store(key, res);
+    return make_result(cache_[key], port);
+}
+
+// --------------------------------------------------------------------------
+// Queues a lookup for a worker, unless the name is already being looked up,
+// in which case the request just joins the existing one. A new worker is
+// started if none are idle and the pool isn't full.
+
+void resolver::enqueue(const key_type& key, in_port_t port, handler h) {
+    auto it = inFlight_.find(key);
+    if (it != inFlight_.end()) {
+        it->second.emplace_back(port, std::move(h));
+        return;
+    }
+
+    inFlight_[key].emplace_back(port, std::move(h));
+    queue_.push_back(key);
+
+    if (nIdle_ == 0 && threads_.size() < nThreads_)
+        threads_.emplace_back(&resolver::run, this);
+    else
+        cv_.notify_one();
+}
+
+// --------------------------------------------------------------------------
+
+void resolver::run() {
+    unique_lock<mutex> lk{mtx_};
+
+    while (true) {
+        ++nIdle_;
+        cv_.wait(lk, [this] { return quit_ || !queue_.empty(); });
+        --nIdle_;
+
+        if (quit_)
+            return;
+
+        auto key = std::move(queue_.front());
+        queue_.pop_front();
+
+        lk.unlock();
+        auto res = lookup(key.second, 0, key.first);
+        lk.lock();
+
+        store(key, res);
+        auto e = cache_[key];
+
+        auto reqs = std::move(inFlight_[key]);
+        inFlight_.erase(key);
+
+        lk.unlock();
+        for (auto& [port, h] : reqs) {
+            if (h)
+                h(make_result(e, port));
+        }
+        lk.lock();
+    }
+}
+
+// --------------------------------------------------------------------------
+
+resolver::result_type resolver::try_resolve(
+    const string& host, in_port_t port, int family /*=AF_UNSPEC*/
+) {
+    key_type key{family, host};
+    lock_guard<mutex> lk{mtx_};
+
+    if (auto e = find(key); e)
+        return make_result(*e, port);
+
+    enqueue(key, port, handler{});
+    return errc::operation_would_block;
+}
+
+// --------------------------------------------------------------------------
+
+void resolver::resolve_async(
+    const string& host, in_port_t port, handler h, int family /*=AF_UNSPEC*/
+) {
+    key_type key{family, host};
+    unique_lock<mutex> lk{mtx_};
+
+    if (auto e = find(key); e) {
+        auto res = make_result(*e, port);
+        lk.unlock();
+        h(std::move(res));
+        return;
+    }
+
+    enqueue(key, port, std::move(h));
+}
+
+// --------------------------------------------------------------------------
+
+size_t resolver::cache_size() const {
+    lock_guard<mutex> lk{mtx_};
+    return cache_.size();
+}
+
+void resolver::clear_cache() {
+    lock_guard<mutex> lk{mtx_};
+    cache_.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
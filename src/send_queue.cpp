@@ -0,0 +1,253 @@
+// send_queue.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/send_queue.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <system_error>
+#include <thread>
+
+namespace sockpp {
+
+// The most I/O vectors gathered for a single write
+static constexpr size_t MAX_FLUSH_IOV = 64;
+
+/////////////////////////////////////////////////////////////////////////////
+
+send_queue::send_queue(buffer_pool& pool) : pool_{pool}, tail_{&stub_}, head_{&stub_} {
+    if (auto res = check_pool(pool); !res)
+        throw std::system_error{res.error()};
+}
+
+send_queue::send_queue(buffer_pool& pool, error_code& ec) noexcept
+    : pool_{pool}, tail_{&stub_}, head_{&stub_} {
+    if (auto res = check_pool(pool); !res)
+        ec = res.error();
+}
+
+send_queue::~send_queue() {
+    collect();
+    while (sendHead_) {
+        auto n = sendHead_;
+        sendHead_ = n->lnext;
+        free_node(n);
+    }
+}
+
+// --------------------------------------------------------------------------
+// Each node is placed at the front of a chunk. The pool's slabs are
+// allocated with the fundamental alignment, so the chunks keep it as long
+// as their size is a multiple of it.
+
+result<> send_queue::check_pool(const buffer_pool& pool) noexcept {
+    auto sz = pool.chunk_size();
+    if (sz <= HEADER_SIZE || sz % alignof(std::max_align_t) != 0)
+        return errc::invalid_argument;
+    return none{};
+}
+
+send_queue::node* send_queue::make_node(pooled_buffer&& buf, size_t len) {
+    auto p = buf.data();
+    auto n = new (p) node{};
+    n->buf = std::move(buf);
+    n->off = HEADER_SIZE;
+    n->len = len;
+    return n;
+}
+
+// The node lives inside the buffer it holds, so the buffer is moved out
+// before the node is destroyed, and only then returned to the pool.
+
+void send_queue::free_node(node* n) noexcept {
+    auto buf = std::move(n->buf);
+    n->~node();
+}
+
+// --------------------------------------------------------------------------
+
+bool send_queue::push_chain(node* first, node* last, size_t nbytes) {
+    bool wasEmpty = size_.fetch_add(nbytes, std::memory_order_acq_rel) == 0;
+    auto prev = tail_.exchange(last, std::memory_order_acq_rel);
+    prev->next.store(first, std::memory_order_release);
+    return wasEmpty;
+}
+
+bool send_queue::push(message&& msg) {
+    if (!msg || msg.size() == 0) {
+        msg.buf_.reset();
+        return false;
+    }
+    auto len = msg.buf_.size();
+    auto n = make_node(std::move(msg.buf_), len);
+    return push_chain(n, n, len - HEADER_SIZE);
+}
+
+bool send_queue::push(const void* data, size_t n) {
+    if (n == 0)
+        return false;
+
+    auto p = static_cast<const uint8_t*>(data);
+    node *first = nullptr, *last = nullptr;
+
+    for (size_t i = 0; i < n;) {
+        auto buf = pool_.get();
+        auto m = std::min(n - i, buf.capacity() - HEADER_SIZE);
+        std::memcpy(buf.data() + HEADER_SIZE, p + i, m);
+        i += m;
+
+        auto nd = make_node(std::move(buf), HEADER_SIZE + m);
+        if (last)
+            last->next.store(nd, std::memory_order_relaxed);
+        else
+            first = nd;
+        last = nd;
+    }
+    return push_chain(first, last, n);
+}
+
+// --------------------------------------------------------------------------
+// The consumer side of the queue. The stub node is put back on the end
+// whenever the queue drains, so that the head is never the last node a
+// producer might still be linking to.
+
+send_queue::node* send_queue::pop() noexcept {
+    auto head = head_;
+    auto next = head->next.load(std::memory_order_acquire);
+
+    if (head == &stub_) {
+        if (!next)
+            return nullptr;
+        head_ = head = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        head_ = next;
+        return head;
+    }
+
+    // A producer is part way through a push
+    if (head != tail_.load(std::memory_order_acquire))
+        return nullptr;
+
+    stub_.next.store(nullptr, std::memory_order_relaxed);
+    push_chain(&stub_, &stub_, 0);
+
+    next = head->next.load(std::memory_order_acquire);
+    if (next) {
+        head_ = next;
+        return head;
+    }
+    return nullptr;
+}
+
+void send_queue::collect() noexcept {
+    while (auto n = pop()) {
+        n->lnext = nullptr;
+        if (sendTail_)
+            sendTail_->lnext = n;
+        else
+            sendHead_ = n;
+        sendTail_ = n;
+    }
+}
+
+// --------------------------------------------------------------------------
+
+// The size is reduced after every write, so that it only counts data that
+// hasn't gone out yet. A producer that adds to a non-zero size doesn't
+// signal, counting on a flush in progress to send its data. So before
+// returning, a flush that has run out of nodes has to check the size, and
+// wait out any producer that has counted its data but not yet linked it.
+
+result<size_t> send_queue::flush(stream_socket& sock) {
+    size_t nsent = 0;
+    collect();
+
+    while (true) {
+        while (sendHead_) {
+            iovec iov[MAX_FLUSH_IOV];
+            size_t niov = 0;
+
+            for (auto n = sendHead_; n && niov < MAX_FLUSH_IOV; n = n->lnext)
+                iov[niov++] = iovec{n->buf.data() + n->off, n->len - n->off};
+
+            auto res = sock.write(iov, niov);
+            if (!res) {
+                if (res == errc::interrupted)
+                    continue;
+                if (res.is_would_block())
+                    return nsent;
+                return res.error();
+            }
+
+            auto m = res.value();
+            nsent += m;
+            size_.fetch_sub(m, std::memory_order_acq_rel);
+
+            while (m > 0) {
+                auto n = sendHead_;
+                auto avail = n->len - n->off;
+                if (m < avail) {
+                    n->off += m;
+                    break;
+                }
+                m -= avail;
+                sendHead_ = n->lnext;
+                free_node(n);
+            }
+
+            if (!sendHead_) {
+                sendTail_ = nullptr;
+                collect();
+            }
+        }
+
+        if (size_.load(std::memory_order_acquire) == 0)
+            break;
+
+        // A producer is part way through a push
+        collect();
+        if (!sendHead_)
+            std::this_thread::yield();
+    }
+    return nsent;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
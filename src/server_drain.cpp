@@ -0,0 +1,137 @@
+// server_drain.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/server_drain.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+void server_drain::half_close(stream_socket* sock, conn_state& st) {
+    if (!st.halfClosed) {
+        st.halfClosed = true;
+        sock->shutdown(SHUT_WR);
+    }
+}
+
+void server_drain::add_connection(stream_socket& sock, bool busy /*=false*/) {
+    auto& st = conns_[&sock];
+    st.busy = busy;
+    if (draining_ && !busy)
+        half_close(&sock, st);
+}
+
+void server_drain::set_busy(stream_socket& sock, bool busy) {
+    auto it = conns_.find(&sock);
+    if (it == conns_.end())
+        return;
+
+    it->second.busy = busy;
+    if (draining_ && !busy)
+        half_close(it->first, it->second);
+}
+
+// --------------------------------------------------------------------------
+
+#if !defined(_WIN32)
+
+result<> server_drain::hand_off(unix_stream_socket& successor) {
+    for (auto acc : listeners_) {
+        if (!acc->is_open())
+            continue;
+
+        rx_.remove(*acc);
+        if (auto res = successor.send_socket(*acc); !res)
+            return res;
+    }
+    return none{};
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+
+void server_drain::start(milliseconds timeout) {
+    if (draining_)
+        return;
+
+    draining_ = true;
+    deadline_ = clock::now() + timeout;
+
+    for (auto acc : listeners_) {
+        if (acc->is_open()) {
+            rx_.remove(*acc);
+            acc->close();
+        }
+    }
+
+    for (auto& [sock, st] : conns_) {
+        if (!st.busy)
+            half_close(sock, st);
+    }
+}
+
+result<size_t> server_drain::run() {
+    start(milliseconds{0});
+
+    while (!conns_.empty()) {
+        auto now = clock::now();
+        if (now >= deadline_)
+            break;
+
+        auto ms = std::chrono::ceil<milliseconds>(deadline_ - now);
+        if (auto res = rx_.run_once(ms); !res)
+            return res.error();
+    }
+
+    return abort_all();
+}
+
+size_t server_drain::abort_all() {
+    size_t n = conns_.size();
+
+    for (auto& [sock, st] : conns_) {
+        if (sock->is_open()) {
+            rx_.remove(*sock);
+            sock->abort();
+        }
+    }
+    conns_.clear();
+    return n;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
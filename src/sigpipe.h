@@ -0,0 +1,123 @@
+// sigpipe.h
+//
+// An internal guard that keeps SIGPIPE from being raised by writes that
+// can't be told not to, like the ones made by OpenSSL, sendfile(), and
+// splice().
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#ifndef __sockpp_sigpipe_h
+#define __sockpp_sigpipe_h
+
+#include "sockpp/platform.h"
+
+// macOS has no sigtimedwait(), but the library's sockets there are
+// created with SO_NOSIGPIPE, which covers every kind of write.
+#if !defined(_WIN32) && !defined(__APPLE__)
+    #define SOCKPP_SIGPIPE_GUARD
+    #include <signal.h>
+
+    #include <cerrno>
+#endif
+
+namespace sockpp {
+namespace detail {
+
+#if defined(SOCKPP_SIGPIPE_GUARD)
+
+/**
+ * Blocks SIGPIPE on the calling thread for the life of the object.
+ *
+ * If a write in that time raises the signal, it is left pending while
+ * blocked, and is discarded before the old mask is restored, so the write
+ * just fails with `EPIPE`. A SIGPIPE that was already pending when the
+ * guard was created is left alone. The value of `errno` is preserved.
+ */
+class sigpipe_guard
+{
+    /** The thread's signal mask from before */
+    sigset_t oldMask_;
+    /** Whether a SIGPIPE was already pending */
+    bool wasPending_;
+
+    sigpipe_guard(const sigpipe_guard&) = delete;
+    sigpipe_guard& operator=(const sigpipe_guard&) = delete;
+
+    static bool is_pending() noexcept {
+        sigset_t pend;
+        sigemptyset(&pend);
+        return ::sigpending(&pend) == 0 && sigismember(&pend, SIGPIPE) == 1;
+    }
+
+public:
+    sigpipe_guard() noexcept {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGPIPE);
+        ::pthread_sigmask(SIG_BLOCK, &set, &oldMask_);
+        wasPending_ = is_pending();
+    }
+
+    ~sigpipe_guard() {
+        int err = errno;
+
+        if (!wasPending_ && is_pending()) {
+            sigset_t set;
+            sigemptyset(&set);
+            sigaddset(&set, SIGPIPE);
+            timespec ts{0, 0};
+            while (::sigtimedwait(&set, nullptr, &ts) < 0 && errno == EINTR)
+                ;
+        }
+        ::pthread_sigmask(SIG_SETMASK, &oldMask_, nullptr);
+        errno = err;
+    }
+};
+
+#else
+
+class sigpipe_guard
+{
+public:
+    sigpipe_guard() noexcept {}
+};
+
+#endif
+
+}  // namespace detail
+}  // namespace sockpp
+
+#endif  // __sockpp_sigpipe_h
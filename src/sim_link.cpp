@@ -0,0 +1,357 @@
+// sim_link.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/sim_link.h"
+
+#include <algorithm>
+#include <system_error>
+#include <vector>
+
+namespace sockpp {
+
+namespace {
+
+// The link's own I/O goes straight to the OS, so that it isn't counted in
+// the socket stats along with the application's.
+
+result<size_t> raw_recv(const socket& sock, char* buf, size_t n) {
+#if defined(_WIN32)
+    ssize_t ret = ::recv(sock.handle(), buf, int(n), 0);
+#else
+    ssize_t ret = ::recv(sock.handle(), buf, n, 0);
+#endif
+    return (ret < 0) ? result<size_t>::from_last_error() : result<size_t>{size_t(ret)};
+}
+
+result<size_t> raw_send(const socket& sock, const char* buf, size_t n) {
+#if defined(_WIN32)
+    ssize_t ret = ::send(sock.handle(), buf, int(n), 0);
+#else
+    ssize_t ret = ::send(sock.handle(), buf, n, MSG_NOSIGNAL);
+#endif
+    return (ret < 0) ? result<size_t>::from_last_error() : result<size_t>{size_t(ret)};
+}
+
+// The largest datagram that the link carries
+constexpr size_t MAX_DGRAM = 65536;
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//								sim_link
+/////////////////////////////////////////////////////////////////////////////
+
+sim_link::sim_link(const params& p, int type)
+    : params_{p}, type_{type}, rng_{p.seed}, ab_{ia_, ib_}, ba_{ib_, ia_} {
+    params_.mtu = std::max<size_t>(params_.mtu, 1);
+}
+
+// --------------------------------------------------------------------------
+// On Windows, the emulated socket pairs only do UNIX-domain streams and
+// loopback UDP.
+
+result<std::tuple<socket, socket>> sim_link::open() {
+#if defined(_WIN32)
+    int domain = (type_ == SOCK_DGRAM) ? AF_INET : AF_UNIX;
+#else
+    int domain = AF_UNIX;
+#endif
+
+    auto ares = socket::pair(domain, type_);
+    if (!ares)
+        return ares.error();
+
+    auto bres = socket::pair(domain, type_);
+    if (!bres)
+        return bres.error();
+
+    auto [a, ia] = ares.release();
+    auto [b, ib] = bres.release();
+    ia_ = std::move(ia);
+    ib_ = std::move(ib);
+
+    for (auto sock : {&ia_, &ib_}) {
+        if (auto res = sock->set_non_blocking(); !res)
+            return res.error();
+    }
+    return std::make_tuple(std::move(a), std::move(b));
+}
+
+// --------------------------------------------------------------------------
+// A splitmix64 generator, which is tiny, and gives the same sequence
+// everywhere, unlike the standard distributions.
+
+double sim_link::random() noexcept {
+    uint64_t z = (rng_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return double(z >> 11) * (1.0 / double(uint64_t(1) << 53));
+}
+
+// --------------------------------------------------------------------------
+// Reads everything that the application has written, at the current time.
+// A stream link stops at the queue limit, leaving the rest in the socket
+// for backpressure. A datagram link takes everything, and drops what
+// doesn't fit. Once the destination is gone, the data is just discarded.
+
+void sim_link::ingest(direction& d) {
+    const bool stream = (type_ == SOCK_STREAM);
+    std::vector<char> buf(stream ? params_.mtu : MAX_DGRAM);
+
+    while (!d.eof && (!stream || d.closed || d.queued < params_.queueLimit)) {
+        auto res = raw_recv(*d.src, buf.data(), buf.size());
+
+        if (!res) {
+            if (res.is_would_block() || !stream)
+                break;
+            // A reset stream ends like a closed one
+            res = result<size_t>{0};
+        }
+
+        size_t n = res.value();
+
+        if (stream && n == 0) {
+            d.eof = true;
+            if (!d.closed)
+                enqueue(d, std::string{}, true);
+        }
+        else if (d.closed || (!stream && d.queued + n > params_.queueLimit)) {
+            if (!stream)
+                ++d.cnt.dropped;
+        }
+        else {
+            enqueue(d, std::string(buf.data(), n), false);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// The packet waits for the link to finish sending the ones ahead of it,
+// takes its own time to send at the link's bandwidth, and then arrives
+// after the latency. A stream can't deliver anything ahead of an earlier
+// segment, so it's held up by any late one.
+
+void sim_link::enqueue(direction& d, std::string&& data, bool eof) {
+    const bool stream = (type_ == SOCK_STREAM);
+    size_t n = data.size();
+
+    nanoseconds tx{0};
+    if (params_.bandwidth)
+        tx = nanoseconds{uint64_t(n) * 1'000'000'000 / params_.bandwidth};
+
+    d.busyUntil = std::max(now_, d.busyUntil) + tx;
+    auto due = d.busyUntil + params_.latency;
+
+    if (!eof && params_.loss > 0.0 && random() < params_.loss) {
+        if (!stream) {
+            ++d.cnt.dropped;
+            return;
+        }
+        due += params_.retransmit;
+        ++d.cnt.retransmits;
+    }
+
+    if (stream) {
+        due = std::max(due, d.lastDue);
+        d.lastDue = due;
+    }
+    else if (params_.reorder > 0.0 && random() < params_.reorder) {
+        due += params_.reorderDelay;
+        ++d.cnt.reordered;
+    }
+
+    d.q.emplace(std::make_tuple(due, seq_++), packet{std::move(data), eof});
+    d.queued += n;
+}
+
+// --------------------------------------------------------------------------
+// Writes the packets that are due, in order, until the destination's
+// socket buffer fills. The rest wait for the application to read.
+
+void sim_link::deliver(direction& d) {
+    const bool stream = (type_ == SOCK_STREAM);
+    d.blocked = false;
+
+    while (!d.q.empty()) {
+        auto it = d.q.begin();
+        if (std::get<0>(it->first) > now_)
+            break;
+
+        auto& pkt = it->second;
+        size_t n = pkt.data.size();
+
+        if (pkt.eof) {
+            d.dst->shutdown(SHUT_WR);
+        }
+        else if (stream) {
+            while (d.off < n) {
+                auto res = raw_send(*d.dst, pkt.data.data() + d.off, n - d.off);
+                if (!res) {
+                    if (res.is_would_block()) {
+                        d.blocked = true;
+                        return;
+                    }
+                    // The other side is gone, so nothing more gets there
+                    d.closed = true;
+                    d.q.clear();
+                    d.queued = d.off = 0;
+                    return;
+                }
+                d.off += res.value();
+            }
+            ++d.cnt.packets;
+            d.cnt.bytes += n;
+        }
+        else {
+            auto res = raw_send(*d.dst, pkt.data.data(), n);
+            if (res.is_would_block()) {
+                d.blocked = true;
+                return;
+            }
+            if (res) {
+                ++d.cnt.packets;
+                d.cnt.bytes += n;
+            }
+            else {
+                ++d.cnt.dropped;
+            }
+        }
+
+        d.queued -= n;
+        d.off = 0;
+        d.q.erase(it);
+    }
+}
+
+// --------------------------------------------------------------------------
+// Data is read again after each delivery, since the delivery may have
+// made room for more under the queue limit, and that data enters the
+// link at the time the room was made.
+
+void sim_link::step(nanoseconds t) {
+    while (true) {
+        ingest(ab_);
+        ingest(ba_);
+        deliver(ab_);
+        deliver(ba_);
+        ingest(ab_);
+        ingest(ba_);
+
+        auto next = next_event();
+        if (!next || *next > t)
+            break;
+        now_ = std::max(now_, *next);
+    }
+}
+
+void sim_link::run_until(nanoseconds t) {
+    step(t);
+    now_ = std::max(now_, t);
+}
+
+nanoseconds sim_link::run() {
+    step(nanoseconds::max());
+    return now_;
+}
+
+std::optional<nanoseconds> sim_link::next_event() const noexcept {
+    std::optional<nanoseconds> next;
+
+    for (auto d : {&ab_, &ba_}) {
+        if (!d->blocked && !d->q.empty()) {
+            auto due = std::get<0>(d->q.begin()->first);
+            if (!next || due < *next)
+                next = due;
+        }
+    }
+    return next;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								sim_stream_link
+/////////////////////////////////////////////////////////////////////////////
+
+sim_stream_link::sim_stream_link(const params& p) : sim_link{p, SOCK_STREAM} {
+    if (auto res = init(); !res)
+        throw std::system_error{res.error()};
+}
+
+sim_stream_link::sim_stream_link(const params& p, error_code& ec) noexcept
+    : sim_link{p, SOCK_STREAM} {
+    if (auto res = init(); !res)
+        ec = res.error();
+}
+
+result<> sim_stream_link::init() {
+    auto res = open();
+    if (!res)
+        return res.error();
+
+    auto [a, b] = res.release();
+    a_ = stream_socket{a.release()};
+    b_ = stream_socket{b.release()};
+    return none{};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								sim_dgram_link
+/////////////////////////////////////////////////////////////////////////////
+
+sim_dgram_link::sim_dgram_link(const params& p) : sim_link{p, SOCK_DGRAM} {
+    if (auto res = init(); !res)
+        throw std::system_error{res.error()};
+}
+
+sim_dgram_link::sim_dgram_link(const params& p, error_code& ec) noexcept
+    : sim_link{p, SOCK_DGRAM} {
+    if (auto res = init(); !res)
+        ec = res.error();
+}
+
+result<> sim_dgram_link::init() {
+    auto res = open();
+    if (!res)
+        return res.error();
+
+    auto [a, b] = res.release();
+    a_ = datagram_socket{a.release()};
+    b_ = datagram_socket{b.release()};
+    return none{};
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -39,9 +39,29 @@
 #include <fcntl.h>
 
 #include <algorithm>
+#include <climits>
 #include <cstring>
 
 #include "sockpp/error.h"
+#include "sockpp/socket_view.h"
+#include "stats.h"
+
+#if defined(__linux__)
+    #include <linux/errqueue.h>
+    #include <linux/net_tstamp.h>
+#endif
+
+#if defined(_WIN32)
+    // Older MinGW headers don't have AF_UNIX support
+    #if __has_include(<afunix.h>)
+        #include <afunix.h>
+        #define SOCKPP_HAS_AFUNIX
+    #endif
+
+    #include <atomic>
+    #include <filesystem>
+    #include <string>
+#endif
 
 using namespace std::chrono;
 
@@ -63,17 +83,36 @@ timeval to_timeval(const microseconds& dur) {
     return tv;
 }
 
+// --------------------------------------------------------------------------
+// On systems without MSG_NOSIGNAL, like macOS, a write to a broken
+// connection would raise SIGPIPE unless the socket is told not to. This is
+// a no-op elsewhere, since every send passes MSG_NOSIGNAL instead.
+
+namespace {
+
+void no_sigpipe(socket_t h) noexcept {
+#if defined(SO_NOSIGPIPE)
+    socket_view{h}.set_option(SOL_SOCKET, SO_NOSIGPIPE, 1);
+#else
+    (void)h;
+#endif
+}
+
+}  // namespace
+
 /////////////////////////////////////////////////////////////////////////////
 //							socket_initializer
 /////////////////////////////////////////////////////////////////////////////
 
+// The process-wide SIGPIPE disposition is left to the application. The
+// library keeps its own writes from raising the signal, with MSG_NOSIGNAL
+// on each send or SO_NOSIGPIPE on each socket, and by blocking the signal
+// on the thread around the writes that can't be told, like sendfile().
+
 socket_initializer::socket_initializer() {
 #if defined(_WIN32)
     WSADATA wsadata;
     ::WSAStartup(MAKEWORD(2, 0), &wsadata);
-#else
-    // Don't signal on socket write errors.
-    ::signal(SIGPIPE, SIG_IGN);
 #endif
 }
 
@@ -101,10 +140,60 @@ result<> socket::close(socket_t h) noexcept {
 
 // --------------------------------------------------------------------------
 
-result<socket> socket::create(int domain, int type, int protocol /*=0*/) noexcept {
-    socket sock(::socket(domain, type, protocol));
-    if (!sock)
-        return result<socket>::from_last_error();
+// Where the system has SOCK_NONBLOCK and SOCK_CLOEXEC, the flags are
+// or'ed into the type, so the socket is born with them. Otherwise they're
+// set with separate calls after the socket is created.
+
+result<socket_t> socket::create_handle(
+    int domain, int type, int protocol /*=0*/, int flags /*=0*/
+) noexcept {
+#if defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+    if (flags & NON_BLOCKING)
+        type |= SOCK_NONBLOCK;
+    if (flags & CLOSE_ON_EXEC)
+        type |= SOCK_CLOEXEC;
+
+    auto res = check_socket(socket_t(::socket(domain, type, protocol)));
+    if (res)
+        no_sigpipe(res.value());
+    return res;
+#else
+    auto res = check_socket(socket_t(::socket(domain, type, protocol)));
+    if (!res)
+        return res;
+
+    socket_t h = res.value();
+    no_sigpipe(h);
+
+    if (flags & NON_BLOCKING) {
+        if (auto nbres = socket_view{h}.set_non_blocking(); !nbres) {
+            socket{h}.close();
+            return nbres.error();
+        }
+    }
+    #if !defined(_WIN32)
+    if (flags & CLOSE_ON_EXEC) {
+        if (::fcntl(h, F_SETFD, FD_CLOEXEC) < 0) {
+            auto err = result<socket_t>::from_last_error();
+            socket{h}.close();
+            return err;
+        }
+    }
+    #endif
+    return h;
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+result<socket> socket::create(
+    int domain, int type, int protocol /*=0*/, int flags /*=0*/
+) noexcept {
+    auto res = create_handle(domain, type, protocol, flags);
+    if (!res)
+        return res.error();
+
+    socket sock{res.value()};
     return sock;
 }
 
@@ -147,12 +236,191 @@ result<> socket::set_flag(int flag, bool on /*=true*/) {
     return set_flags(flags);
 }
 
+#endif
+
 // TODO: result<bool>?
 bool socket::is_non_blocking() const {
-    auto res = get_flags();
-    return (res) ? ((res.value() & O_NONBLOCK) != 0) : false;
+    return socket_view{handle_}.is_non_blocking();
+}
+
+// --------------------------------------------------------------------------
+// Windows has no socketpair(), so a stream pair is made by connecting to a
+// one-shot listener, and a datagram pair by connecting two bound sockets
+// to each other. The Internet families use the loopback interface. An
+// AF_UNIX stream pair (Windows 10 1803 and later) listens on a temporary
+// socket file, which is removed as soon as the pair is connected. That
+// needs <afunix.h>, and without it an AF_UNIX pair isn't supported.
+
+#if defined(_WIN32)
+
+namespace {
+
+using pair_result = result<std::tuple<socket, socket>>;
+
+// Removes the listener's socket file, if any, when it goes out of scope
+struct pair_path
+{
+    std::string path;
+    ~pair_path() {
+        if (!path.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    }
+};
+
+// Gets the address for one side of a pair to bind to.
+result<socklen_t> pair_address(int domain, sockaddr_storage& ss, pair_path& pp) {
+    static std::atomic<unsigned> count{0};
+
+    std::memset(&ss, 0, sizeof(ss));
+    switch (domain) {
+        case AF_INET: {
+            auto p = reinterpret_cast<sockaddr_in*>(&ss);
+            p->sin_family = AF_INET;
+            p->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            return socklen_t(sizeof(sockaddr_in));
+        }
+        case AF_INET6: {
+            auto p = reinterpret_cast<sockaddr_in6*>(&ss);
+            p->sin6_family = AF_INET6;
+            p->sin6_addr = in6addr_loopback;
+            return socklen_t(sizeof(sockaddr_in6));
+        }
+    #if defined(SOCKPP_HAS_AFUNIX)
+        case AF_UNIX: {
+            std::error_code ec;
+            auto dir = std::filesystem::temp_directory_path(ec);
+            if (ec)
+                return ec;
+
+            auto name = "sockpp-" + std::to_string(::GetCurrentProcessId()) + "-" +
+                        std::to_string(count++) + ".sock";
+            auto path = (dir / name).string();
+
+            auto p = reinterpret_cast<sockaddr_un*>(&ss);
+            if (path.size() >= sizeof(p->sun_path))
+                return errc::filename_too_long;
+
+            // A stale file from a crashed process would block the bind
+            std::filesystem::remove(path, ec);
+            pp.path = path;
+
+            p->sun_family = AF_UNIX;
+            std::memcpy(p->sun_path, path.c_str(), path.size() + 1);
+            return socklen_t(sizeof(sockaddr_un));
+        }
+    #endif
+    }
+    return errc::address_family_not_supported;
+}
+
+// Determines if two Internet addresses are the same host and port
+bool same_endpoint(const sockaddr_storage& a, const sockaddr_storage& b) {
+    if (a.ss_family != b.ss_family)
+        return false;
+
+    if (a.ss_family == AF_INET) {
+        auto pa = reinterpret_cast<const sockaddr_in*>(&a);
+        auto pb = reinterpret_cast<const sockaddr_in*>(&b);
+        return pa->sin_port == pb->sin_port && pa->sin_addr.s_addr == pb->sin_addr.s_addr;
+    }
+
+    auto pa = reinterpret_cast<const sockaddr_in6*>(&a);
+    auto pb = reinterpret_cast<const sockaddr_in6*>(&b);
+    return pa->sin6_port == pb->sin6_port &&
+           std::memcmp(&pa->sin6_addr, &pb->sin6_addr, sizeof(pa->sin6_addr)) == 0;
 }
 
+pair_result stream_pair(int domain, int type, int protocol) {
+    sockaddr_storage ss;
+    pair_path pp;
+
+    auto ares = pair_address(domain, ss, pp);
+    if (!ares)
+        return ares.error();
+
+    auto sa = reinterpret_cast<sockaddr*>(&ss);
+    auto len = ares.value();
+
+    auto lres = socket::create(domain, type, protocol);
+    if (!lres)
+        return lres.error();
+
+    auto lsock = lres.release();
+    if (::bind(lsock.handle(), sa, len) != 0 || ::listen(lsock.handle(), 1) != 0 ||
+        ::getsockname(lsock.handle(), sa, &len) != 0)
+        return pair_result::from_last_error();
+
+    auto cres = socket::create(domain, type, protocol);
+    if (!cres)
+        return cres.error();
+
+    auto sock0 = cres.release();
+    if (::connect(sock0.handle(), sa, len) != 0)
+        return pair_result::from_last_error();
+
+    sockaddr_storage peer;
+    auto plen = socklen_t(sizeof(peer));
+    socket sock1{::accept(lsock.handle(), reinterpret_cast<sockaddr*>(&peer), &plen)};
+    if (!sock1)
+        return pair_result::from_last_error();
+
+    if (domain != AF_UNIX) {
+        // Make sure the connection is our own, and not from some other
+        // process that got to the listener first.
+        sockaddr_storage self;
+        auto slen = socklen_t(sizeof(self));
+        if (::getsockname(sock0.handle(), reinterpret_cast<sockaddr*>(&self), &slen) != 0)
+            return pair_result::from_last_error();
+        if (!same_endpoint(self, peer))
+            return errc::connection_refused;
+
+        // Like a real socket pair, send small writes right away
+        (void)sock0.set_option<int>(IPPROTO_TCP, TCP_NODELAY, 1);
+        (void)sock1.set_option<int>(IPPROTO_TCP, TCP_NODELAY, 1);
+    }
+
+    return std::make_tuple(std::move(sock0), std::move(sock1));
+}
+
+pair_result dgram_pair(int domain, int type, int protocol) {
+    if (domain == AF_UNIX)
+        return errc::address_family_not_supported;
+
+    socket sock[2];
+    sockaddr_storage ss[2];
+    socklen_t len[2];
+    pair_path pp;
+
+    for (int i = 0; i < 2; ++i) {
+        auto ares = pair_address(domain, ss[i], pp);
+        if (!ares)
+            return ares.error();
+        len[i] = ares.value();
+
+        auto sres = socket::create(domain, type, protocol);
+        if (!sres)
+            return sres.error();
+
+        sock[i] = sres.release();
+        auto sa = reinterpret_cast<sockaddr*>(&ss[i]);
+        if (::bind(sock[i].handle(), sa, len[i]) != 0 ||
+            ::getsockname(sock[i].handle(), sa, &len[i]) != 0)
+            return pair_result::from_last_error();
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        auto sa = reinterpret_cast<const sockaddr*>(&ss[1 - i]);
+        if (::connect(sock[i].handle(), sa, len[1 - i]) != 0)
+            return pair_result::from_last_error();
+    }
+
+    return std::make_tuple(std::move(sock[0]), std::move(sock[1]));
+}
+
+}  // namespace
+
 #endif
 
 // --------------------------------------------------------------------------
@@ -166,17 +434,20 @@ socket::pair(int domain, int type, int protocol /*=0*/) noexcept {
     int sv[2];
 
     if (::socketpair(domain, type, protocol, sv) == 0) {
+        no_sigpipe(sv[0]);
+        no_sigpipe(sv[1]);
         res = std::make_tuple<socket, socket>(socket{sv[0]}, socket{sv[1]});
     }
     else {
         res = result<std::tuple<socket, socket>>::from_last_error();
     }
 #else
-    (void)domain;
-    (void)type;
-    (void)protocol;
-
-    res = errc::function_not_supported;
+    if (type == SOCK_STREAM)
+        res = stream_pair(domain, type, protocol);
+    else if (type == SOCK_DGRAM)
+        res = dgram_pair(domain, type, protocol);
+    else
+        res = errc::function_not_supported;
 #endif
 
     return res;
@@ -245,25 +516,43 @@ sock_address_any socket::peer_address() const {
     return sock_address_any(addrStore, len);
 }
 
+// --------------------------------------------------------------------------
+// Gets the local or peer address into a compact IP address, without the
+// intermediate sockaddr_storage.
+
+result<> socket::address(inet_any_address& addr) const noexcept {
+    sockaddr_in6 buf{};
+    socklen_t len = sizeof(buf);
+
+    addr.clear();
+    auto p = reinterpret_cast<sockaddr*>(&buf);
+
+    if (auto res = check_res_none(::getsockname(handle_, p, &len)); !res)
+        return res;
+    if (!addr.assign(p, len))
+        return errc::address_family_not_supported;
+    return none{};
+}
+
+result<> socket::peer_address(inet_any_address& addr) const noexcept {
+    sockaddr_in6 buf{};
+    socklen_t len = sizeof(buf);
+
+    addr.clear();
+    auto p = reinterpret_cast<sockaddr*>(&buf);
+
+    if (auto res = check_res_none(::getpeername(handle_, p, &len)); !res)
+        return res;
+    if (!addr.assign(p, len))
+        return errc::address_family_not_supported;
+    return none{};
+}
+
 // --------------------------------------------------------------------------
 
 result<> socket::get_option(int level, int optname, void* optval, socklen_t* optlen)
     const noexcept {
-    result<int> res;
-#if defined(_WIN32)
-    if (optval && optlen) {
-        int len = static_cast<int>(*optlen);
-        res =
-            check_res(::getsockopt(handle_, level, optname, static_cast<char*>(optval), &len)
-            );
-        if (res) {
-            *optlen = static_cast<socklen_t>(len);
-        }
-    }
-#else
-    res = check_res(::getsockopt(handle_, level, optname, optval, optlen));
-#endif
-    return (res) ? error_code{} : res.error();
+    return socket_view{handle_}.get_option(level, optname, optval, optlen);
 }
 
 // --------------------------------------------------------------------------
@@ -271,35 +560,171 @@ result<> socket::get_option(int level, int optname, void* optval, socklen_t* opt
 result<> socket::set_option(
     int level, int optname, const void* optval, socklen_t optlen
 ) noexcept {
-#if defined(_WIN32)
-    return check_res_none(::setsockopt(
-        handle_, level, optname, static_cast<const char*>(optval), static_cast<int>(optlen)
-    ));
+    return socket_view{handle_}.set_option(level, optname, optval, optlen);
+}
+
+// --------------------------------------------------------------------------
+
+result<microseconds> socket::busy_poll() const noexcept {
+#if defined(SO_BUSY_POLL)
+    auto res = get_option<int>(SOL_SOCKET, SO_BUSY_POLL);
+    if (!res)
+        return res.error();
+    return microseconds{res.value()};
 #else
-    return check_res_none(::setsockopt(handle_, level, optname, optval, optlen));
+    return errc::operation_not_supported;
 #endif
 }
 
-/// --------------------------------------------------------------------------
+result<> socket::busy_poll(microseconds t) noexcept {
+#if defined(SO_BUSY_POLL)
+    return set_option<int>(SOL_SOCKET, SO_BUSY_POLL, int(t.count()));
+#else
+    (void)t;
+    return errc::operation_not_supported;
+#endif
+}
 
-result<> socket::set_non_blocking(bool on /*=true*/) {
-#if defined(_WIN32)
-    unsigned long mode = on ? 1 : 0;
-    auto res = check_res(::ioctlsocket(handle_, FIONBIO, &mode));
-    return (res) ? error_code{} : res.error();
+// Some C libraries lag behind the kernel's option numbers.
+#if defined(__linux__)
+    #if !defined(SO_PREFER_BUSY_POLL)
+        #define SO_PREFER_BUSY_POLL 69
+    #endif
+    #if !defined(SO_BUSY_POLL_BUDGET)
+        #define SO_BUSY_POLL_BUDGET 70
+    #endif
+    #if !defined(SO_MAX_PACING_RATE)
+        #define SO_MAX_PACING_RATE 47
+    #endif
+    #if !defined(SO_INCOMING_CPU)
+        #define SO_INCOMING_CPU 49
+    #endif
+    #if !defined(SO_INCOMING_NAPI_ID)
+        #define SO_INCOMING_NAPI_ID 56
+    #endif
+#endif
+
+result<bool> socket::prefer_busy_poll() const noexcept {
+#if defined(SO_PREFER_BUSY_POLL)
+    return get_option<bool>(SOL_SOCKET, SO_PREFER_BUSY_POLL);
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> socket::prefer_busy_poll(bool on) noexcept {
+#if defined(SO_PREFER_BUSY_POLL)
+    return set_option(SOL_SOCKET, SO_PREFER_BUSY_POLL, on);
+#else
+    (void)on;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<unsigned> socket::busy_poll_budget() const noexcept {
+#if defined(SO_BUSY_POLL_BUDGET)
+    auto res = get_option<int>(SOL_SOCKET, SO_BUSY_POLL_BUDGET);
+    if (!res)
+        return res.error();
+    return unsigned(res.value());
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> socket::busy_poll_budget(unsigned n) noexcept {
+#if defined(SO_BUSY_POLL_BUDGET)
+    return set_option<int>(SOL_SOCKET, SO_BUSY_POLL_BUDGET, int(n));
 #else
-    return set_flag(O_NONBLOCK, on);
+    (void)n;
+    return errc::operation_not_supported;
 #endif
 }
 
+// The kernel takes the pacing rate as an unsigned long, so it's limited to
+// 32 bits on 32-bit systems.
+result<uint64_t> socket::max_pacing_rate() const noexcept {
+#if defined(SO_MAX_PACING_RATE)
+    auto res = get_option<unsigned long>(SOL_SOCKET, SO_MAX_PACING_RATE);
+    if (!res)
+        return res.error();
+    auto rate = res.value();
+    return rate == ULONG_MAX ? ~uint64_t(0) : uint64_t(rate);
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> socket::max_pacing_rate(uint64_t bytesPerSec) noexcept {
+#if defined(SO_MAX_PACING_RATE)
+    auto rate = (bytesPerSec > ULONG_MAX) ? ULONG_MAX : (unsigned long)bytesPerSec;
+    return set_option<unsigned long>(SOL_SOCKET, SO_MAX_PACING_RATE, rate);
+#else
+    (void)bytesPerSec;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<int> socket::incoming_cpu() const noexcept {
+#if defined(SO_INCOMING_CPU)
+    return get_option<int>(SOL_SOCKET, SO_INCOMING_CPU);
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> socket::incoming_cpu(int cpu) noexcept {
+#if defined(SO_INCOMING_CPU)
+    return set_option<int>(SOL_SOCKET, SO_INCOMING_CPU, cpu);
+#else
+    (void)cpu;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<unsigned> socket::napi_id() const noexcept {
+#if defined(SO_INCOMING_NAPI_ID)
+    return get_option<unsigned>(SOL_SOCKET, SO_INCOMING_NAPI_ID);
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+/// --------------------------------------------------------------------------
+
+result<> socket::set_non_blocking(bool on /*=true*/) {
+    return socket_view{handle_}.set_non_blocking(on);
+}
+
 // --------------------------------------------------------------------------
 // Shuts down all or part of the connection.
 
 result<> socket::shutdown(int how /*=SHUT_RDWR*/) {
+    return socket_view{handle_}.shutdown(how);
+}
+
+// --------------------------------------------------------------------------
+
+result<> socket::linger(bool on, seconds timeout /*=seconds{0}*/) noexcept {
+    ::linger lg{};
+#if defined(_WIN32)
+    lg.l_onoff = u_short(on ? 1 : 0);
+    lg.l_linger = u_short(timeout.count());
+#else
+    lg.l_onoff = on ? 1 : 0;
+    lg.l_linger = int(timeout.count());
+#endif
+    return set_option(SOL_SOCKET, SO_LINGER, lg);
+}
+
+result<> socket::abort() {
     if (handle_ == INVALID_SOCKET)
         return errc::invalid_argument;
 
-    return check_res_none(::shutdown(handle_, how));
+    // Close regardless, but report a failure to set the option
+    auto res = linger(true, seconds{0});
+    auto closeRes = close();
+    return res ? closeRes : res;
 }
 
 // --------------------------------------------------------------------------
@@ -314,6 +739,33 @@ result<> socket::close() {
 
 // --------------------------------------------------------------------------
 
+result<size_t>
+socket::send_to(const void* buf, size_t n, int flags, const sock_address& addr) {
+#if defined(_WIN32)
+    auto cbuf = reinterpret_cast<const char*>(buf);
+    ssize_t ret = ::sendto(handle(), cbuf, int(n), flags, addr.sockaddr_ptr(), addr.size());
+#else
+    ssize_t ret =
+        ::sendto(handle(), buf, n, flags | MSG_NOSIGNAL, addr.sockaddr_ptr(), addr.size());
+#endif
+    detail::stats_send(ret, n);
+    return check_res<ssize_t, size_t>(ret);
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> socket::send(const void* buf, size_t n, int flags /*=0*/) {
+#if defined(_WIN32)
+    ssize_t ret = ::send(handle(), reinterpret_cast<const char*>(buf), int(n), flags);
+#else
+    ssize_t ret = ::send(handle(), buf, n, flags | MSG_NOSIGNAL);
+#endif
+    detail::stats_send(ret, n);
+    return check_res<ssize_t, size_t>(ret);
+}
+
+// --------------------------------------------------------------------------
+
 result<size_t>
 socket::recv_from(void* buf, size_t n, int flags, sock_address* srcAddr /*=nullptr*/) {
     sockaddr* p = srcAddr ? srcAddr->sockaddr_ptr() : nullptr;
@@ -322,13 +774,226 @@ socket::recv_from(void* buf, size_t n, int flags, sock_address* srcAddr /*=nullp
     // TODO: Check returned length
 
 #if defined(_WIN32)
-    return check_res<ssize_t, size_t>(
-        ::recvfrom(handle(), reinterpret_cast<char*>(buf), int(n), flags, p, &len)
-    );
+    ssize_t ret = ::recvfrom(handle(), reinterpret_cast<char*>(buf), int(n), flags, p, &len);
 #else
-    return check_res<ssize_t, size_t>(::recvfrom(handle(), buf, n, flags, p, &len));
+    ssize_t ret = ::recvfrom(handle(), buf, n, flags, p, &len);
 #endif
+    detail::stats_recv(ret);
+    return check_res<ssize_t, size_t>(ret);
 }
 
+// --------------------------------------------------------------------------
+
+result<size_t> socket::recv(void* buf, size_t n, int flags /*=0*/) {
+#if defined(_WIN32)
+    ssize_t ret = ::recv(handle(), reinterpret_cast<char*>(buf), int(n), flags);
+#else
+    ssize_t ret = ::recv(handle(), buf, n, flags);
+#endif
+    detail::stats_recv(ret);
+    return check_res<ssize_t, size_t>(ret);
+}
+
+// --------------------------------------------------------------------------
+
+#if !defined(_WIN32)
+
+result<size_t> socket::send_msg(const msghdr& msg, int flags /*=0*/) {
+    ssize_t ret = ::sendmsg(handle(), &msg, flags | MSG_NOSIGNAL);
+    detail::stats_send(ret, msg.msg_iov, size_t(msg.msg_iovlen));
+    return check_res<ssize_t, size_t>(ret);
+}
+
+result<size_t> socket::recv_msg(msghdr& msg, int flags /*=0*/) {
+    ssize_t ret = ::recvmsg(handle(), &msg, flags);
+    detail::stats_recv(ret);
+    return check_res<ssize_t, size_t>(ret);
+}
+
+#endif
+
+// --------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+result<size_t> socket::zerocopy_completions(zerocopy_completion* comps, size_t n) {
+    size_t ncomp = 0;
+
+    while (ncomp < n) {
+        // The extended error is followed by the address of the offender
+        constexpr size_t CTRL_SZ =
+            CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6));
+        alignas(cmsghdr) char ctrl[CTRL_SZ];
+
+        msghdr msg{};
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+
+        if (::recvmsg(handle_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            if (errno == EINTR)
+                continue;
+            if (ncomp != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+
+        for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            bool isErr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                         (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+            if (!isErr)
+                continue;
+
+            sock_extended_err serr;
+            std::memcpy(&serr, CMSG_DATA(cmsg), sizeof(serr));
+
+            if (serr.ee_errno != 0 || serr.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                continue;
+
+            comps[ncomp++] = zerocopy_completion{
+                serr.ee_info, serr.ee_data, (serr.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0
+            };
+        }
+    }
+
+    return ncomp;
+}
+
+// --------------------------------------------------------------------------
+// Kernel timestamps
+
+namespace {
+
+nanoseconds to_nanoseconds(const timespec& ts) {
+    return seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec);
+}
+
+}  // namespace
+
+// Picks out the timestamps from the control data of a message. With
+// SO_TIMESTAMPING, the software time is in the first slot and the raw
+// hardware time in the last (the middle one is deprecated).
+bool socket::get_timestamps(const cmsghdr* cmsg, packet_timestamp& ts) noexcept {
+    if (cmsg->cmsg_level != SOL_SOCKET)
+        return false;
+
+    switch (cmsg->cmsg_type) {
+        case SCM_TIMESTAMPING: {
+            scm_timestamping stamps;
+            std::memcpy(&stamps, CMSG_DATA(cmsg), sizeof(stamps));
+            ts.software = to_nanoseconds(stamps.ts[0]);
+            ts.hardware = to_nanoseconds(stamps.ts[2]);
+            return true;
+        }
+        case SCM_TIMESTAMPNS: {
+            timespec t;
+            std::memcpy(&t, CMSG_DATA(cmsg), sizeof(t));
+            ts.software = to_nanoseconds(t);
+            return true;
+        }
+        case SCM_TIMESTAMP: {
+            timeval tv;
+            std::memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+            ts.software = seconds(tv.tv_sec) + microseconds(tv.tv_usec);
+            return true;
+        }
+    }
+    return false;
+}
+
+result<> socket::enable_timestamps(unsigned flags /*=TIMESTAMP_RX_SOFTWARE*/) {
+    int tsflags = 0;
+
+    if (flags & TIMESTAMP_RX_SOFTWARE)
+        tsflags |= SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (flags & TIMESTAMP_RX_HARDWARE)
+        tsflags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+    if (flags & TIMESTAMP_TX_SOFTWARE)
+        tsflags |= SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (flags & TIMESTAMP_TX_HARDWARE)
+        tsflags |= SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+
+    // Transmit timestamps carry an ID to match them to the sends, and no
+    // copy of the packet.
+    if (flags & (TIMESTAMP_TX_SOFTWARE | TIMESTAMP_TX_HARDWARE))
+        tsflags |= SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+
+    return set_option(SOL_SOCKET, SO_TIMESTAMPING, tsflags);
+}
+
+result<size_t> socket::recv_from(
+    void* buf, size_t n, packet_timestamp& ts, sock_address* srcAddr /*=nullptr*/,
+    int flags /*=0*/
+) {
+    iovec iov{buf, n};
+
+    // Room for the timestamps, plus any other option that the
+    // application may have turned on for the socket.
+    cmsg_buffer<CMSG_SPACE(sizeof(scm_timestamping)) + 128> ctrl;
+
+    auto res = recv_msg(&iov, 1, ctrl, srcAddr, flags);
+
+    ts = packet_timestamp{};
+    cmsg_reader rdr{ctrl};
+    for (auto cmsg = rdr.first(); cmsg; cmsg = rdr.next(cmsg))
+        get_timestamps(cmsg, ts);
+
+    return res;
+}
+
+// Each transmit timestamp comes with an extended error from the protocol
+// that identifies the send.
+
+result<size_t> socket::tx_timestamps(packet_timestamp* ts, size_t n) {
+    size_t nts = 0;
+
+    while (nts < n) {
+        cmsg_buffer<CMSG_SPACE(sizeof(scm_timestamping)) +
+                    CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))>
+            ctrl;
+
+        msghdr msg{};
+        msg.msg_control = ctrl.data();
+        msg.msg_controllen = ctrl.capacity();
+
+        if (::recvmsg(handle_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            if (errno == EINTR)
+                continue;
+            if (nts != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+
+        packet_timestamp pts;
+        bool haveTs = false, haveId = false;
+
+        cmsg_reader rdr{msg};
+        for (auto cmsg = rdr.first(); cmsg; cmsg = rdr.next(cmsg)) {
+            if (get_timestamps(cmsg, pts)) {
+                haveTs = true;
+            }
+            else if (cmsg->cmsg_level != SOL_SOCKET &&
+                     cmsg_reader::payload_size(cmsg) >= sizeof(sock_extended_err)) {
+                sock_extended_err serr;
+                std::memcpy(&serr, CMSG_DATA(cmsg), sizeof(serr));
+                if (serr.ee_errno == ENOMSG && serr.ee_origin == SO_EE_ORIGIN_TIMESTAMPING) {
+                    pts.id = serr.ee_data;
+                    haveId = true;
+                }
+            }
+        }
+
+        if (haveTs && haveId)
+            ts[nts++] = pts;
+    }
+
+    return nts;
+}
+
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
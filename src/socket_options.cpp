@@ -0,0 +1,108 @@
+// socket_options.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/socket_options.h"
+
+#include <algorithm>
+
+#include "sockpp/socket.h"
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+// Socket-level options are copied to accepted sockets everywhere. Linux
+// clones the listener's whole TCP state, apart from the ACK mode, while
+// the BSD's and macOS only pass on the Nagle and push flags.
+
+bool socket_options::is_inherited(int level, int name) noexcept {
+    if (level == SOL_SOCKET)
+        return true;
+
+    if (level == IPPROTO_TCP) {
+#if defined(__linux__)
+        return name != TCP_QUICKACK;
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || \
+    defined(__OpenBSD__) || defined(__DragonFly__)
+        return name == TCP_NODELAY || name == TCP_NOPUSH;
+#endif
+    }
+    (void)name;
+    return false;
+}
+
+// --------------------------------------------------------------------------
+
+socket_options& socket_options::set(int level, int name, int val) {
+    auto it = std::find_if(opts_.begin(), opts_.end(), [=](const option& opt) {
+        return opt.level == level && opt.name == name;
+    });
+
+    if (it != opts_.end()) {
+        it->value = val;
+        it->err = error_code{};
+    }
+    else
+        opts_.push_back(option{level, name, val, is_inherited(level, name), error_code{}});
+    return *this;
+}
+
+// --------------------------------------------------------------------------
+
+size_t socket_options::failed() const noexcept {
+    return size_t(std::count_if(opts_.begin(), opts_.end(), [](const option& opt) {
+        return bool(opt.err);
+    }));
+}
+
+// --------------------------------------------------------------------------
+
+result<> socket_options::apply(socket& sock, bool inherited, bool all) noexcept {
+    result<> ret;
+
+    for (auto& opt : opts_) {
+        if (!all && opt.inherited != inherited)
+            continue;
+
+        opt.err = sock.set_option(opt.level, opt.name, opt.value).error();
+        if (opt.err && ret)
+            ret = opt.err;
+    }
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
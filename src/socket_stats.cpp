@@ -0,0 +1,498 @@
+// socket_stats.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/socket_stats.h"
+
+#include <cmath>
+
+#include "stats.h"
+
+#if defined(SOCKPP_WITH_STATS)
+    #include <atomic>
+    #include <cerrno>
+    #include <mutex>
+    #include <vector>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+socket_stats& socket_stats::operator+=(const socket_stats& rhs) noexcept {
+    bytesIn += rhs.bytesIn;
+    bytesOut += rhs.bytesOut;
+    syscalls += rhs.syscalls;
+    wouldBlock += rhs.wouldBlock;
+    interrupted += rhs.interrupted;
+    partialWrites += rhs.partialWrites;
+    errors += rhs.errors;
+    throttles += rhs.throttles;
+    throttleNanos += rhs.throttleNanos;
+    for (size_t i = 0; i <= MAX_ERRNO; ++i) errnoCounts[i] += rhs.errnoCounts[i];
+    return *this;
+}
+
+socket_stats& socket_stats::operator-=(const socket_stats& rhs) noexcept {
+    bytesIn -= rhs.bytesIn;
+    bytesOut -= rhs.bytesOut;
+    syscalls -= rhs.syscalls;
+    wouldBlock -= rhs.wouldBlock;
+    interrupted -= rhs.interrupted;
+    partialWrites -= rhs.partialWrites;
+    errors -= rhs.errors;
+    throttles -= rhs.throttles;
+    throttleNanos -= rhs.throttleNanos;
+    for (size_t i = 0; i <= MAX_ERRNO; ++i) errnoCounts[i] -= rhs.errnoCounts[i];
+    return *this;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//                          latency_histogram
+/////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// The position of the highest set bit in a non-zero value
+inline unsigned floor_log2(uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - unsigned(__builtin_clzll(v));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long i;
+    _BitScanReverse64(&i, v);
+    return unsigned(i);
+#else
+    unsigned n = 0;
+    while (v >>= 1) ++n;
+    return n;
+#endif
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+// The first SUB_BUCKETS values each get a bucket of their own. After that,
+// each power of two is split into SUB_BUCKETS buckets of equal width, so
+// the index is the power, plus the next SUB_BITS bits below the top one.
+
+size_t latency_histogram::bucket_index(uint64_t ns) noexcept {
+    if (ns < SUB_BUCKETS)
+        return size_t(ns);
+
+    auto msb = floor_log2(ns);
+    if (msb >= MAX_BITS)
+        return N_BUCKETS - 1;
+
+    auto shift = msb - SUB_BITS;
+    return ((size_t(shift) + 1) << SUB_BITS) + size_t(ns >> shift) - SUB_BUCKETS;
+}
+
+uint64_t latency_histogram::bucket_lower(size_t i) noexcept {
+    if (i < SUB_BUCKETS)
+        return uint64_t(i);
+
+    auto shift = unsigned(i >> SUB_BITS) - 1;
+    return uint64_t(SUB_BUCKETS + (i & (SUB_BUCKETS - 1))) << shift;
+}
+
+uint64_t latency_histogram::bucket_upper(size_t i) noexcept {
+    auto shift = (i < SUB_BUCKETS) ? 0u : unsigned(i >> SUB_BITS) - 1;
+    return bucket_lower(i) + (uint64_t(1) << shift) - 1;
+}
+
+void latency_histogram::record(nanoseconds t) noexcept {
+    auto ns = (t.count() < 0) ? uint64_t(0) : uint64_t(t.count());
+    ++counts[bucket_index(ns)];
+    totalNanos += ns;
+}
+
+uint64_t latency_histogram::count() const noexcept {
+    uint64_t n = 0;
+    for (auto c : counts) n += c;
+    return n;
+}
+
+nanoseconds latency_histogram::mean() const noexcept {
+    auto n = count();
+    return nanoseconds{n ? int64_t(totalNanos / n) : 0};
+}
+
+nanoseconds latency_histogram::lowest() const noexcept {
+    for (size_t i = 0; i < N_BUCKETS; ++i) {
+        if (counts[i])
+            return nanoseconds{int64_t(bucket_lower(i))};
+    }
+    return nanoseconds{0};
+}
+
+nanoseconds latency_histogram::highest() const noexcept {
+    for (size_t i = N_BUCKETS; i > 0; --i) {
+        if (counts[i - 1])
+            return nanoseconds{int64_t(bucket_upper(i - 1))};
+    }
+    return nanoseconds{0};
+}
+
+nanoseconds latency_histogram::percentile(double pct) const noexcept {
+    auto n = count();
+    if (n == 0)
+        return nanoseconds{0};
+
+    // The rank of the value at the percentile, from 1 to n
+    pct = (pct < 0.0) ? 0.0 : (pct > 100.0) ? 100.0 : pct;
+    auto rank = uint64_t(std::ceil(pct / 100.0 * double(n)));
+    if (rank == 0)
+        rank = 1;
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < N_BUCKETS; ++i) {
+        sum += counts[i];
+        if (sum >= rank)
+            return nanoseconds{int64_t(bucket_upper(i))};
+    }
+    return highest();
+}
+
+latency_histogram& latency_histogram::operator+=(const latency_histogram& rhs) noexcept {
+    for (size_t i = 0; i < N_BUCKETS; ++i) counts[i] += rhs.counts[i];
+    totalNanos += rhs.totalNanos;
+    return *this;
+}
+
+latency_histogram& latency_histogram::operator-=(const latency_histogram& rhs) noexcept {
+    for (size_t i = 0; i < N_BUCKETS; ++i) counts[i] -= rhs.counts[i];
+    totalNanos -= rhs.totalNanos;
+    return *this;
+}
+
+// --------------------------------------------------------------------------
+
+latency_stats& latency_stats::operator+=(const latency_stats& rhs) noexcept {
+    for (size_t i = 0; i < N_OPS; ++i) ops[i] += rhs.ops[i];
+    return *this;
+}
+
+latency_stats& latency_stats::operator-=(const latency_stats& rhs) noexcept {
+    for (size_t i = 0; i < N_OPS; ++i) ops[i] -= rhs.ops[i];
+    return *this;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+#if !defined(SOCKPP_WITH_STATS)
+
+bool socket_stats::enabled() noexcept { return false; }
+
+socket_stats socket_stats::snapshot() { return socket_stats{}; }
+
+latency_stats latency_stats::snapshot() { return latency_stats{}; }
+
+latency_stats latency_stats::snapshot(std::thread::id) { return latency_stats{}; }
+
+void latency_stats::record(latency_op, nanoseconds) noexcept {}
+
+#else
+
+// --------------------------------------------------------------------------
+// Each thread that does I/O gets a slot of counters. Only the owning
+// thread writes to it, so the updates are plain relaxed loads and stores,
+// with no read-modify-write. They're atomic just so that a snapshot can
+// read them from another thread.
+
+namespace {
+
+using counter = std::atomic<uint64_t>;
+
+// The latency histograms for a thread. These are large, so they're only
+// allocated once the thread times something.
+struct latency_slot
+{
+    std::array<std::array<counter, latency_histogram::N_BUCKETS>, latency_stats::N_OPS>
+        counts{};
+    std::array<counter, latency_stats::N_OPS> totalNanos{};
+
+    void add_to(latency_stats& st) const noexcept {
+        for (size_t op = 0; op < latency_stats::N_OPS; ++op) {
+            auto& h = st.ops[op];
+            for (size_t i = 0; i < latency_histogram::N_BUCKETS; ++i)
+                h.counts[i] += counts[op][i].load(std::memory_order_relaxed);
+            h.totalNanos += totalNanos[op].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+struct stats_slot
+{
+    counter bytesIn{0}, bytesOut{0}, syscalls{0}, wouldBlock{0}, interrupted{0},
+        partialWrites{0}, errors{0}, throttles{0}, throttleNanos{0};
+    std::array<counter, socket_stats::MAX_ERRNO + 1> errnoCounts{};
+    std::atomic<latency_slot*> latency{nullptr};
+    std::thread::id owner{std::this_thread::get_id()};
+
+    stats_slot();
+    ~stats_slot();
+
+    void add_to(socket_stats& st) const noexcept {
+        st.bytesIn += bytesIn.load(std::memory_order_relaxed);
+        st.bytesOut += bytesOut.load(std::memory_order_relaxed);
+        st.syscalls += syscalls.load(std::memory_order_relaxed);
+        st.wouldBlock += wouldBlock.load(std::memory_order_relaxed);
+        st.interrupted += interrupted.load(std::memory_order_relaxed);
+        st.partialWrites += partialWrites.load(std::memory_order_relaxed);
+        st.errors += errors.load(std::memory_order_relaxed);
+        st.throttles += throttles.load(std::memory_order_relaxed);
+        st.throttleNanos += throttleNanos.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= socket_stats::MAX_ERRNO; ++i)
+            st.errnoCounts[i] += errnoCounts[i].load(std::memory_order_relaxed);
+    }
+};
+
+// The registry of live slots, and the totals from threads that have exited.
+// This is leaked so that it outlives any thread_local slot in the process.
+struct stats_registry
+{
+    std::mutex mtx;
+    std::vector<const stats_slot*> slots;
+    socket_stats retired;
+    latency_stats retiredLatency;
+};
+
+stats_registry& registry() {
+    static auto reg = new stats_registry;
+    return *reg;
+}
+
+stats_slot::stats_slot() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mtx};
+    reg.slots.push_back(this);
+}
+
+stats_slot::~stats_slot() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mtx};
+    add_to(reg.retired);
+    if (auto lat = latency.load(); lat) {
+        lat->add_to(reg.retiredLatency);
+        delete lat;
+    }
+    for (auto& p : reg.slots) {
+        if (p == this) {
+            p = reg.slots.back();
+            reg.slots.pop_back();
+            break;
+        }
+    }
+}
+
+inline void incr(counter& c, uint64_t n = 1) noexcept {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+int last_errno() noexcept {
+    #if defined(_WIN32)
+    return ::WSAGetLastError();
+    #else
+    return errno;
+    #endif
+}
+
+// Counts a failed call, leaving the error in place for the caller.
+void count_error(stats_slot& st) noexcept {
+    int err = last_errno();
+
+    incr(st.errors);
+    incr(st.errnoCounts[size_t(err) < socket_stats::MAX_ERRNO ? size_t(err)
+                                                              : socket_stats::MAX_ERRNO]);
+    #if defined(_WIN32)
+    if (err == WSAEWOULDBLOCK)
+        incr(st.wouldBlock);
+    else if (err == WSAEINTR)
+        incr(st.interrupted);
+    #else
+    if (err == EAGAIN || err == EWOULDBLOCK)
+        incr(st.wouldBlock);
+    else if (err == EINTR)
+        incr(st.interrupted);
+    #endif
+}
+
+// The slot for the calling thread. The error is saved around the first
+// use, since registering the slot could disturb it.
+stats_slot& this_thread_slot() noexcept {
+    int err = last_errno();
+    static thread_local stats_slot slot;
+    #if defined(_WIN32)
+    ::WSASetLastError(err);
+    #else
+    errno = err;
+    #endif
+    return slot;
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+void detail::stats_recv(ssize_t ret) noexcept {
+    auto& st = this_thread_slot();
+    incr(st.syscalls);
+    if (ret < 0)
+        count_error(st);
+    else
+        incr(st.bytesIn, uint64_t(ret));
+}
+
+void detail::stats_send(ssize_t ret, size_t n) noexcept {
+    auto& st = this_thread_slot();
+    incr(st.syscalls);
+    if (ret < 0)
+        count_error(st);
+    else {
+        incr(st.bytesOut, uint64_t(ret));
+        if (size_t(ret) < n)
+            incr(st.partialWrites);
+    }
+}
+
+void detail::stats_send(ssize_t ret, const iovec* ranges, size_t n) noexcept {
+    size_t len = 0;
+    for (size_t i = 0; i < n; ++i) len += ranges[i].iov_len;
+    stats_send(ret, len);
+}
+
+    #if defined(__linux__)
+void detail::stats_recv_batch(int ret, const mmsghdr* msgs) noexcept {
+    auto& st = this_thread_slot();
+    incr(st.syscalls);
+    if (ret < 0)
+        count_error(st);
+    else {
+        uint64_t len = 0;
+        for (int i = 0; i < ret; ++i) len += msgs[i].msg_len;
+        incr(st.bytesIn, len);
+    }
+}
+
+void detail::stats_send_batch(int ret, const mmsghdr* msgs, size_t n) noexcept {
+    auto& st = this_thread_slot();
+    incr(st.syscalls);
+    if (ret < 0)
+        count_error(st);
+    else {
+        uint64_t len = 0;
+        for (int i = 0; i < ret; ++i) len += msgs[i].msg_len;
+        incr(st.bytesOut, len);
+        if (size_t(ret) < n)
+            incr(st.partialWrites);
+    }
+}
+    #endif
+
+void detail::stats_throttle(nanoseconds t) noexcept {
+    auto& st = this_thread_slot();
+    incr(st.throttles);
+    incr(st.throttleNanos, uint64_t(t.count()));
+}
+
+void detail::stats_latency(latency_op op, nanoseconds t) noexcept {
+    auto& st = this_thread_slot();
+
+    // Only this thread stores the pointer, so there's no race to create it
+    auto lat = st.latency.load(std::memory_order_relaxed);
+    if (!lat) {
+        lat = new latency_slot;
+        st.latency.store(lat, std::memory_order_release);
+    }
+
+    auto ns = (t.count() < 0) ? uint64_t(0) : uint64_t(t.count());
+    incr(lat->counts[size_t(op)][latency_histogram::bucket_index(ns)]);
+    incr(lat->totalNanos[size_t(op)], ns);
+}
+
+// --------------------------------------------------------------------------
+
+bool socket_stats::enabled() noexcept { return true; }
+
+socket_stats socket_stats::snapshot() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mtx};
+
+    socket_stats st = reg.retired;
+    for (auto slot : reg.slots) slot->add_to(st);
+    return st;
+}
+
+// --------------------------------------------------------------------------
+
+latency_stats latency_stats::snapshot() {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mtx};
+
+    latency_stats st = reg.retiredLatency;
+    for (auto slot : reg.slots) {
+        if (auto lat = slot->latency.load(std::memory_order_acquire); lat)
+            lat->add_to(st);
+    }
+    return st;
+}
+
+latency_stats latency_stats::snapshot(std::thread::id thr) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lk{reg.mtx};
+
+    latency_stats st;
+    for (auto slot : reg.slots) {
+        if (slot->owner == thr) {
+            if (auto lat = slot->latency.load(std::memory_order_acquire); lat)
+                lat->add_to(st);
+            break;
+        }
+    }
+    return st;
+}
+
+void latency_stats::record(latency_op op, nanoseconds t) noexcept {
+    detail::stats_latency(op, t);
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
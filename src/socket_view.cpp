@@ -0,0 +1,273 @@
+// socket_view.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/socket_view.h"
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <climits>
+
+#include "stats.h"
+
+#if !defined(_WIN32)
+    #include <sys/ioctl.h>
+    #include <sys/uio.h>
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Converts a system call return value to a result.
+template <typename T, typename Tout = T>
+inline result<Tout> check_res(T ret) {
+    return (ret < 0) ? result<Tout>::from_last_error() : result<Tout>{Tout(ret)};
+}
+
+inline result<> check_res_none(int ret) {
+    return (ret < 0) ? result<>::from_last_error() : result<>{none{}};
+}
+
+#if defined(_WIN32)
+// The most buffers we'll convert on the stack for a single scatter/gather
+// call. A longer list just gets a partial read or write.
+constexpr size_t MAX_WSABUF = 64;
+
+// Converts (up to MAX_WSABUF) iovec's to WSABUF's
+size_t to_wsabuf(WSABUF* bufs, const iovec* ranges, size_t n) {
+    n = std::min(n, MAX_WSABUF);
+    for (size_t i = 0; i < n; ++i) {
+        bufs[i].len = static_cast<ULONG>(ranges[i].iov_len);
+        bufs[i].buf = static_cast<CHAR*>(ranges[i].iov_base);
+    }
+    return n;
+}
+#endif
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//								socket_view
+/////////////////////////////////////////////////////////////////////////////
+
+sa_family_t socket_view::family() const noexcept {
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+
+    if (::getsockname(handle_, reinterpret_cast<sockaddr*>(&addr), &len) < 0)
+        return AF_UNSPEC;
+    return addr.ss_family;
+}
+
+sock_address_any socket_view::address() const {
+    auto addrStore = sockaddr_storage{};
+    socklen_t len = sizeof(sockaddr_storage);
+
+    if (::getsockname(handle_, reinterpret_cast<sockaddr*>(&addrStore), &len) < 0)
+        return sock_address_any{};
+    return sock_address_any(addrStore, len);
+}
+
+sock_address_any socket_view::peer_address() const {
+    auto addrStore = sockaddr_storage{};
+    socklen_t len = sizeof(sockaddr_storage);
+
+    if (::getpeername(handle_, reinterpret_cast<sockaddr*>(&addrStore), &len) < 0)
+        return sock_address_any{};
+    return sock_address_any(addrStore, len);
+}
+
+// --------------------------------------------------------------------------
+
+result<> socket_view::get_option(int level, int optname, void* optval, socklen_t* optlen)
+    const noexcept {
+#if defined(_WIN32)
+    if (!optval || !optlen)
+        return none{};
+
+    int len = static_cast<int>(*optlen);
+    auto res = check_res_none(
+        ::getsockopt(handle_, level, optname, static_cast<char*>(optval), &len)
+    );
+    if (res)
+        *optlen = static_cast<socklen_t>(len);
+    return res;
+#else
+    return check_res_none(::getsockopt(handle_, level, optname, optval, optlen));
+#endif
+}
+
+result<> socket_view::set_option(
+    int level, int optname, const void* optval, socklen_t optlen
+) const noexcept {
+#if defined(_WIN32)
+    return check_res_none(::setsockopt(
+        handle_, level, optname, static_cast<const char*>(optval), static_cast<int>(optlen)
+    ));
+#else
+    return check_res_none(::setsockopt(handle_, level, optname, optval, optlen));
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+result<> socket_view::set_non_blocking(bool on /*=true*/) const {
+#if defined(_WIN32)
+    unsigned long mode = on ? 1 : 0;
+    return check_res_none(::ioctlsocket(handle_, FIONBIO, &mode));
+#else
+    // Unlike fcntl(), this doesn't need to read the flags first
+    int mode = on ? 1 : 0;
+    return check_res_none(::ioctl(handle_, FIONBIO, &mode));
+#endif
+}
+
+bool socket_view::is_non_blocking() const {
+#if defined(_WIN32)
+    return false;
+#else
+    int flags = ::fcntl(handle_, F_GETFL, 0);
+    return (flags >= 0) && (flags & O_NONBLOCK) != 0;
+#endif
+}
+
+result<> socket_view::shutdown(int how /*=SHUT_RDWR*/) const {
+    if (handle_ == INVALID_SOCKET)
+        return errc::invalid_argument;
+
+    return check_res_none(::shutdown(handle_, how));
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> socket_view::read(void* buf, size_t n) const {
+#if defined(_WIN32)
+    auto cbuf = reinterpret_cast<char*>(buf);
+    ssize_t ret = ::recv(handle_, cbuf, int(n), 0);
+#else
+    ssize_t ret = ::recv(handle_, buf, n, 0);
+#endif
+    detail::stats_recv(ret);
+    return check_res<ssize_t, size_t>(ret);
+}
+
+result<size_t> socket_view::read(const iovec* ranges, size_t n) const {
+    if (n == 0)
+        return 0;
+
+#if !defined(_WIN32)
+    n = std::min<size_t>(n, IOV_MAX);
+    ssize_t ret = ::readv(handle_, ranges, int(n));
+    detail::stats_recv(ret);
+    return check_res<ssize_t, size_t>(ret);
+#else
+    WSABUF bufs[MAX_WSABUF];
+    DWORD flags = 0, nread = 0, nbuf = DWORD(to_wsabuf(bufs, ranges, n));
+
+    auto ret = ::WSARecv(handle_, bufs, nbuf, &nread, &flags, nullptr, nullptr);
+    detail::stats_recv((ret == SOCKET_ERROR) ? ssize_t(-1) : ssize_t(nread));
+    if (ret == SOCKET_ERROR)
+        return result<size_t>::from_last_error();
+    return size_t(nread);
+#endif
+}
+
+result<size_t> socket_view::write(const void* buf, size_t n) const {
+#if defined(_WIN32)
+    auto cbuf = reinterpret_cast<const char*>(buf);
+    ssize_t ret = ::send(handle_, cbuf, int(n), 0);
+#else
+    ssize_t ret = ::send(handle_, buf, n, MSG_NOSIGNAL);
+#endif
+    detail::stats_send(ret, n);
+    return check_res<ssize_t, size_t>(ret);
+}
+
+result<size_t> socket_view::write(const iovec* ranges, size_t n) const {
+    if (n == 0)
+        return 0;
+
+#if !defined(_WIN32)
+    // sendmsg() rather than writev(), to pass MSG_NOSIGNAL
+    msghdr msg{};
+    msg.msg_iov = const_cast<iovec*>(ranges);
+    msg.msg_iovlen = decltype(msg.msg_iovlen)(std::min<size_t>(n, IOV_MAX));
+    n = size_t(msg.msg_iovlen);
+
+    ssize_t ret = ::sendmsg(handle_, &msg, MSG_NOSIGNAL);
+    detail::stats_send(ret, ranges, n);
+    return check_res<ssize_t, size_t>(ret);
+#else
+    WSABUF bufs[MAX_WSABUF];
+    DWORD nwritten = 0, nbuf = DWORD(to_wsabuf(bufs, ranges, n));
+
+    auto ret = ::WSASend(handle_, bufs, nbuf, &nwritten, 0, nullptr, nullptr);
+    detail::stats_send(
+        (ret == SOCKET_ERROR) ? ssize_t(-1) : ssize_t(nwritten), ranges, size_t(nbuf)
+    );
+    if (ret == SOCKET_ERROR)
+        return result<size_t>::from_last_error();
+    return size_t(nwritten);
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								unique_socket
+/////////////////////////////////////////////////////////////////////////////
+
+void unique_socket::reset(socket_t h /*=INVALID_SOCKET*/) noexcept {
+    if (h != handle_) {
+        close();
+        handle_ = h;
+    }
+}
+
+result<> unique_socket::close() noexcept {
+    socket_t h = release();
+    if (h == INVALID_SOCKET)
+        return none{};
+#if defined(_WIN32)
+    return check_res_none(::closesocket(h));
+#else
+    return check_res_none(::close(h));
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
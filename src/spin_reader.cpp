@@ -0,0 +1,172 @@
+// spin_reader.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/spin_reader.h"
+
+#include <chrono>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+namespace {
+
+// Without MSG_DONTWAIT, the socket itself must be put in non-blocking mode.
+#if defined(MSG_DONTWAIT)
+constexpr int NONBLOCK_FLAG = MSG_DONTWAIT;
+#else
+constexpr int NONBLOCK_FLAG = 0;
+#endif
+
+// Hint to the CPU that we're in a spin-wait loop.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+result<> spin_reader::pin_thread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return errc::invalid_argument;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    // This returns the error rather than setting errno
+    int ret = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    if (ret != 0)
+        return std::error_code{ret, std::generic_category()};
+    return none{};
+#else
+    (void)cpu;
+    return errc::operation_not_supported;
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+void spin_reader::pin_once() {
+    pinned_ = true;
+    if (params_.cpu < 0)
+        return;
+
+    // Pinning is a best-effort optimization, and a failure here shouldn't
+    // fail the read.
+    if (params_.pin)
+        params_.pin(params_.cpu);
+    else
+        pin_thread(params_.cpu);
+}
+
+// --------------------------------------------------------------------------
+
+result<> spin_reader::enable() {
+    result<> ret;
+
+    auto keep_first = [&ret](result<> res) {
+        if (!res && ret)
+            ret = std::move(res);
+    };
+
+    if (params_.busy_poll.count() > 0)
+        keep_first(sock_.busy_poll(params_.busy_poll));
+
+    if (params_.prefer_busy_poll)
+        keep_first(sock_.prefer_busy_poll(true));
+
+    if (params_.busy_poll_budget > 0)
+        keep_first(sock_.busy_poll_budget(params_.busy_poll_budget));
+
+    return ret;
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t>
+spin_reader::recv_from(void* buf, size_t n, sock_address* srcAddr, int flags /*=0*/) {
+    if (!pinned_)
+        pin_once();
+
+    ++stats_.reads;
+    flags |= NONBLOCK_FLAG;
+
+    auto res = sock_.recv_from(buf, n, flags, srcAddr);
+    if (!res.is_would_block()) {
+        if (res)
+            ++stats_.immediate;
+        return res;
+    }
+
+    if (params_.spin_time.count() <= 0) {
+        ++stats_.spinMisses;
+        return res;
+    }
+
+    // Checking the clock is cheap compared to the recv() system call, so
+    // it's done on every pass.
+    auto deadline = steady_clock::now() + params_.spin_time;
+
+    do {
+        cpu_relax();
+        ++stats_.spinTries;
+
+        res = sock_.recv_from(buf, n, flags, srcAddr);
+        if (!res.is_would_block()) {
+            if (res)
+                ++stats_.spinHits;
+            return res;
+        }
+    } while (steady_clock::now() < deadline);
+
+    ++stats_.spinMisses;
+    return res;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
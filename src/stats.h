@@ -0,0 +1,140 @@
+// stats.h
+//
+// Internal hooks that count socket I/O for the socket_stats snapshots.
+// These compile away to nothing unless the library is built with the
+// SOCKPP_WITH_STATS option.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+
+#ifndef __sockpp_stats_h
+#define __sockpp_stats_h
+
+#include "sockpp/platform.h"
+#include "sockpp/socket_stats.h"
+#include "sockpp/types.h"
+
+namespace sockpp {
+namespace detail {
+
+#if defined(SOCKPP_WITH_STATS)
+
+/**
+ * Counts a receive system call.
+ * @param ret The return value from the call.
+ */
+void stats_recv(ssize_t ret) noexcept;
+/**
+ * Counts a send system call.
+ * @param ret The return value from the call.
+ * @param n The number of bytes that were to be sent.
+ */
+void stats_send(ssize_t ret, size_t n) noexcept;
+/**
+ * Counts a vectored (gather) send system call.
+ * @param ret The return value from the call.
+ * @param ranges The buffers that were to be sent.
+ * @param n The number of buffers.
+ */
+void stats_send(ssize_t ret, const iovec* ranges, size_t n) noexcept;
+    #if defined(__linux__)
+/**
+ * Counts a batched receive system call, like recvmmsg().
+ * The bytes in are the sum of the lengths of the messages received.
+ * @param ret The return value from the call: the number of messages.
+ * @param msgs The message headers that were passed to the call.
+ */
+void stats_recv_batch(int ret, const mmsghdr* msgs) noexcept;
+/**
+ * Counts a batched send system call, like sendmmsg().
+ * The bytes out are the sum of the lengths of the messages sent, and a
+ * call that sends fewer than all the messages counts as a partial write.
+ * @param ret The return value from the call: the number of messages.
+ * @param msgs The message headers that were passed to the call.
+ * @param n The number of messages that were to be sent.
+ */
+void stats_send_batch(int ret, const mmsghdr* msgs, size_t n) noexcept;
+    #endif
+/**
+ * Counts a time that a pacer held back sends.
+ * @param t The length of the hold.
+ */
+void stats_throttle(nanoseconds t) noexcept;
+/**
+ * Records the time an operation took, in the thread's latency histograms.
+ * @param op The operation.
+ * @param t The time it took.
+ */
+void stats_latency(latency_op op, nanoseconds t) noexcept;
+
+/**
+ * Gets the time to start timing an operation.
+ * @return The current time.
+ */
+inline std::chrono::steady_clock::time_point stats_now() noexcept {
+    return std::chrono::steady_clock::now();
+}
+/**
+ * Records the time since an operation started.
+ * @param op The operation.
+ * @param t0 The time the operation started, from @ref stats_now().
+ */
+inline void stats_latency_since(latency_op op, std::chrono::steady_clock::time_point t0) noexcept {
+    stats_latency(op, std::chrono::steady_clock::now() - t0);
+}
+
+#else
+
+inline void stats_recv(ssize_t) noexcept {}
+inline void stats_send(ssize_t, size_t) noexcept {}
+inline void stats_send(ssize_t, const iovec*, size_t) noexcept {}
+    #if defined(__linux__)
+inline void stats_recv_batch(int, const mmsghdr*) noexcept {}
+inline void stats_send_batch(int, const mmsghdr*, size_t) noexcept {}
+    #endif
+inline void stats_throttle(nanoseconds) noexcept {}
+inline void stats_latency(latency_op, nanoseconds) noexcept {}
+
+// Without the counters, the clock isn't read at all
+inline std::chrono::steady_clock::time_point stats_now() noexcept { return {}; }
+inline void stats_latency_since(latency_op, std::chrono::steady_clock::time_point) noexcept {}
+
+#endif
+
+}  // namespace detail
+}  // namespace sockpp
+
+#endif  // __sockpp_stats_h
@@ -37,23 +37,98 @@
 #include "sockpp/stream_socket.h"
 
 #include <algorithm>
+#include <climits>
 #include <memory>
 
 #include "sockpp/error.h"
+#include "sockpp/pacer.h"
+#include "sockpp/socket_view.h"
+#include "sigpipe.h"
+#include "stats.h"
+#include "trace.h"
+
+#if defined(__linux__)
+    #include <sys/sendfile.h>
+#elif defined(__FreeBSD__) || defined(__DragonFly__) || defined(__APPLE__)
+    #include <sys/types.h>
+    #include <sys/uio.h>
+#elif defined(_WIN32)
+    #include <mswsock.h>
+#endif
 
 using namespace std::chrono;
 
 namespace sockpp {
 
+namespace {
+
+// The number of ranges passed on each call of a vectored read_n/write_n.
+// The first one may be a partially-completed copy of the caller's range.
+constexpr size_t MAX_IOV_CHUNK = 64;
+
+// Repeatedly does a vectored transfer, advancing through the ranges as
+// they complete. This only copies the iovec's, never the data.
+template <typename F>
+result<size_t> xfer_n(const iovec *ranges, size_t n, F &&xfer) {
+    iovec vec[MAX_IOV_CHUNK];
+    size_t i = 0, off = 0, nx = 0;
+
+    while (i < n) {
+        if (off == ranges[i].iov_len) {
+            ++i;
+            off = 0;
+            continue;
+        }
+
+        size_t nvec = 0;
+        vec[nvec++] = iovec{static_cast<char *>(ranges[i].iov_base) + off,
+                            ranges[i].iov_len - off};
+        for (size_t j = i + 1; j < n && nvec < MAX_IOV_CHUNK; ++j) vec[nvec++] = ranges[j];
+
+        auto res = xfer(vec, nvec);
+        if (!res) {
+            if (res.is_error(errc::interrupted))
+                continue;
+            return res.error();
+        }
+
+        size_t m = res.value();
+        if (m == 0)
+            break;
+        nx += m;
+
+        while (m > 0) {
+            size_t rem = ranges[i].iov_len - off;
+            if (m < rem) {
+                off += m;
+                m = 0;
+            }
+            else {
+                m -= rem;
+                ++i;
+                off = 0;
+            }
+        }
+    }
+
+    return nx;
+}
+
+}  // namespace
+
 /////////////////////////////////////////////////////////////////////////////
 
 // Creates a stream socket for the given domain/protocol.
 
-result<stream_socket> stream_socket::create(int domain, int protocol /*=0*/) {
-    if (auto res = create_handle(domain, protocol); !res)
+result<stream_socket> stream_socket::create(
+    int domain, int protocol /*=0*/, int flags /*=0*/
+) {
+    if (auto res = create_handle(domain, protocol, flags); !res)
         return res.error();
-    else
-        return stream_socket{res.value()};
+    else {
+        stream_socket sock{res.value()};
+        return sock;
+    }
 }
 
 // --------------------------------------------------------------------------
@@ -61,12 +136,23 @@ result<stream_socket> stream_socket::create(int domain, int protocol /*=0*/) {
 // because many non-*nix operating systems make a distinction.
 
 result<size_t> stream_socket::read(void *buf, size_t n) {
-#if defined(_WIN32)
-    auto cbuf = reinterpret_cast<char *>(buf);
-    return check_res<ssize_t, size_t>(::recv(handle(), cbuf, int(n), 0));
-#else
-    return check_res<ssize_t, size_t>(::recv(handle(), buf, n, 0));
-#endif
+    auto res = socket_view{handle()}.read(buf, n);
+    SOCKPP_TRACE3(read, handle(), n, detail::trace_ret(res));
+    return res;
+}
+
+// --------------------------------------------------------------------------
+
+result<pooled_buffer> stream_socket::read(buffer_pool& pool) {
+    auto buf = pool.get();
+    auto res = read(buf.data(), buf.capacity());
+    if (!res)
+        return res.error();
+
+    buf.resize(res.value());
+    if (buf.empty())
+        buf.reset();
+    return buf;
 }
 
 // --------------------------------------------------------------------------
@@ -79,10 +165,21 @@ result<size_t> stream_socket::read_n(void *buf, size_t n) {
 
     while (nx < n) {
         auto res = read(b + nx, n - nx);
-        if (!res && res != errc::interrupted)
+        if (!res) {
+            if (res.is_error(errc::interrupted)) {
+                SOCKPP_TRACE3(read_n__retry, handle(), nx, n);
+                continue;
+            }
             return res.error();
+        }
+
+        // The peer closed the connection
+        if (res.value() == 0)
+            break;
 
         nx += size_t(res.value());
+        if (nx < n)
+            SOCKPP_TRACE3(read_n__retry, handle(), nx, n);
     }
 
     return nx;
@@ -90,27 +187,14 @@ result<size_t> stream_socket::read_n(void *buf, size_t n) {
 
 // --------------------------------------------------------------------------
 
-result<size_t> stream_socket::read(const std::vector<iovec> &ranges) {
-    if (ranges.empty())
-        return 0;
-
-#if !defined(_WIN32)
-    return check_res<ssize_t, size_t>(::readv(handle(), ranges.data(), int(ranges.size())));
-#else
-    std::vector<WSABUF> bufs;
-    for (const auto &iovec : ranges) {
-        bufs.push_back(
-            {static_cast<ULONG>(iovec.iov_len), static_cast<CHAR *>(iovec.iov_base)}
-        );
-    }
+result<size_t> stream_socket::read(const iovec *ranges, size_t n) {
+    return socket_view{handle()}.read(ranges, n);
+}
 
-    DWORD flags = 0, nread = 0, nbuf = DWORD(bufs.size());
+// --------------------------------------------------------------------------
 
-    auto ret = ::WSARecv(handle(), bufs.data(), nbuf, &nread, &flags, nullptr, nullptr);
-    if (ret == SOCKET_ERROR)
-        return result<size_t>::from_last_error();
-    return size_t(nread);
-#endif
+result<size_t> stream_socket::read_n(const iovec *ranges, size_t n) {
+    return xfer_n(ranges, n, [this](const iovec *v, size_t nv) { return read(v, nv); });
 }
 
 // --------------------------------------------------------------------------
@@ -126,14 +210,34 @@ result<> stream_socket::read_timeout(const microseconds &to) {
 }
 
 // --------------------------------------------------------------------------
+// Without MSG_DONTWAIT, the socket is put into non-blocking mode for the
+// peek, if it isn't already.
 
-result<size_t> stream_socket::write(const void *buf, size_t n) {
-#if defined(_WIN32)
-    auto cbuf = reinterpret_cast<const char *>(buf);
-    return check_res<ssize_t, size_t>(::send(handle(), cbuf, int(n), 0));
+bool stream_socket::is_idle_alive() {
+    if (!is_open())
+        return false;
+
+    char c;
+#if defined(MSG_DONTWAIT)
+    auto res = recv(&c, 1, MSG_PEEK | MSG_DONTWAIT);
 #else
-    return check_res<ssize_t, size_t>(::send(handle(), buf, n, 0));
+    bool nonblock = is_non_blocking();
+    if (!nonblock && !set_non_blocking(true))
+        return false;
+    auto res = recv(&c, 1, MSG_PEEK);
+    if (!nonblock)
+        set_non_blocking(false);
 #endif
+
+    return res.is_would_block();
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> stream_socket::write(const void *buf, size_t n) {
+    auto res = socket_view{handle()}.write(buf, n);
+    SOCKPP_TRACE3(write, handle(), n, detail::trace_ret(res));
+    return res;
 }
 
 // --------------------------------------------------------------------------
@@ -141,37 +245,69 @@ result<size_t> stream_socket::write(const void *buf, size_t n) {
 result<size_t> stream_socket::write_n(const void *buf, size_t n) {
     const uint8_t *b = reinterpret_cast<const uint8_t *>(buf);
     size_t nx = 0;
+    auto t0 = detail::stats_now();
 
     while (nx < n) {
         auto res = write(b + nx, n - nx);
-        if (!res && res != errc::interrupted)
+        if (!res) {
+            if (res.is_error(errc::interrupted)) {
+                SOCKPP_TRACE3(write_n__retry, handle(), nx, n);
+                continue;
+            }
             return res.error();
+        }
+
         nx += size_t(res.value());
+        if (nx < n)
+            SOCKPP_TRACE3(write_n__retry, handle(), nx, n);
     }
 
+    detail::stats_latency_since(latency_op::write_n, t0);
     return nx;
 }
 
 // --------------------------------------------------------------------------
 
-result<size_t> stream_socket::write(const std::vector<iovec> &ranges) {
-#if !defined(_WIN32)
-    return check_res<ssize_t, size_t>(::writev(handle(), ranges.data(), int(ranges.size())));
-#else
-    std::vector<WSABUF> bufs;
-    for (const auto &iovec : ranges) {
-        bufs.push_back(
-            {static_cast<ULONG>(iovec.iov_len), static_cast<CHAR *>(iovec.iov_base)}
-        );
+result<size_t> stream_socket::write_n(const void *buf, size_t n, pacer &pc) {
+    auto nallow = pc.allow(n);
+    if (nallow == 0 && n != 0)
+        return errc::operation_would_block;
+
+    const uint8_t *b = reinterpret_cast<const uint8_t *>(buf);
+    size_t nx = 0;
+
+    while (nx < nallow) {
+        auto res = write(b + nx, nallow - nx);
+        if (!res) {
+            if (res.is_error(errc::interrupted))
+                continue;
+            pc.consume(nx);
+            if (nx == 0 || !res.is_would_block())
+                return res.error();
+            return nx;
+        }
+        nx += size_t(res.value());
     }
 
-    DWORD nwritten = 0, nmsg = DWORD(bufs.size());
+    pc.consume(nx);
+    return nx;
+}
 
-    if (::WSASend(handle(), bufs.data(), nmsg, &nwritten, 0, nullptr, nullptr) ==
-        SOCKET_ERROR)
-        return result<size_t>::from_last_error();
-    return size_t(nwritten);
-#endif
+// --------------------------------------------------------------------------
+
+result<size_t> stream_socket::write(const iovec *ranges, size_t n) {
+    return socket_view{handle()}.write(ranges, n);
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> stream_socket::write_n(const iovec *ranges, size_t n) {
+    auto t0 = detail::stats_now();
+    auto res =
+        xfer_n(ranges, n, [this](const iovec *v, size_t nv) { return write(v, nv); });
+    if (res)
+        detail::stats_latency_since(latency_op::write_n, t0);
+    return res;
 }
 
 // --------------------------------------------------------------------------
@@ -187,5 +323,86 @@ result<> stream_socket::write_timeout(const microseconds &to) {
     return set_option(SOL_SOCKET, SO_SNDTIMEO, tv);
 }
 
+// --------------------------------------------------------------------------
+// Sends part of a file using the zero-copy call for the platform.
+
+#if defined(__linux__)
+
+result<size_t> stream_socket::send_file(file_handle_t fd, uint64_t offset, size_t count) {
+    // The kernel won't transfer more than this in a single call anyway.
+    constexpr size_t MAX_SENDFILE = 0x7FFFF000;
+
+    // sendfile() has no flag to keep it from raising SIGPIPE
+    detail::sigpipe_guard guard;
+    off_t off = off_t(offset);
+    return check_res<ssize_t, size_t>(
+        ::sendfile(handle(), fd, &off, std::min(count, MAX_SENDFILE))
+    );
+}
+
+#elif defined(__FreeBSD__) || defined(__DragonFly__)
+
+result<size_t> stream_socket::send_file(file_handle_t fd, uint64_t offset, size_t count) {
+    off_t nsent = 0;
+    if (::sendfile(fd, handle(), off_t(offset), count, nullptr, &nsent, 0) < 0) {
+        // A non-blocking socket may have sent some of it
+        if (nsent == 0)
+            return result<size_t>::from_last_error();
+    }
+    return size_t(nsent);
+}
+
+#elif defined(__APPLE__)
+
+result<size_t> stream_socket::send_file(file_handle_t fd, uint64_t offset, size_t count) {
+    // A zero length would mean "to the end of the file"
+    if (count == 0)
+        return 0;
+
+    off_t len = off_t(count);
+    if (::sendfile(fd, handle(), off_t(offset), &len, nullptr, 0) < 0) {
+        // A non-blocking socket may have sent some of it
+        if (len == 0)
+            return result<size_t>::from_last_error();
+    }
+    return size_t(len);
+}
+
+#elif defined(_WIN32)
+
+result<size_t> stream_socket::send_file(file_handle_t fd, uint64_t offset, size_t count) {
+    // TransmitFile is limited to 2GB per call, and a zero count would
+    // send the whole file.
+    constexpr size_t MAX_TRANSMIT = 0x7FFFFFFE;
+    if (count == 0)
+        return 0;
+    count = std::min(count, MAX_TRANSMIT);
+
+    LARGE_INTEGER pos;
+    pos.QuadPart = LONGLONG(offset);
+    if (!::SetFilePointerEx(fd, pos, nullptr, FILE_BEGIN))
+        return result<size_t>::from_error(int(::GetLastError()));
+
+    if (!::TransmitFile(handle(), fd, DWORD(count), 0, nullptr, nullptr, 0))
+        return result<size_t>::from_last_error();
+    return count;
+}
+
+#else
+
+result<size_t> stream_socket::send_file(file_handle_t fd, uint64_t offset, size_t count) {
+    // No zero-copy call, so just bounce it through a buffer.
+    char buf[16 * 1024];
+
+    auto nread = ::pread(fd, buf, std::min(count, sizeof(buf)), off_t(offset));
+    if (nread < 0)
+        return result<size_t>::from_last_error();
+    if (nread == 0)
+        return 0;
+    return write(buf, size_t(nread));
+}
+
+#endif
+
 /////////////////////////////////////////////////////////////////////////////
 }  // namespace sockpp
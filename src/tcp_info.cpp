@@ -0,0 +1,182 @@
+// tcp_info.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstring>
+
+#include "sockpp/stream_socket.h"
+
+#if defined(_WIN32)
+    #include <mstcpip.h>
+#elif !defined(__linux__)
+    #include <netinet/tcp.h>
+#endif
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+#if defined(__linux__)
+
+namespace {
+
+// The kernel's struct tcp_info, up through the fields that we report.
+// The C library's copy of the struct in <netinet/tcp.h> often lags far
+// behind the kernel, and <linux/tcp.h> can't be included alongside it.
+// The kernel only ever appends to the struct and reports the length
+// that it filled in, so a mirror of the layout is safe on any version.
+struct kernel_tcp_info
+{
+    uint8_t state, caState, retransmits, probes, backoff, options, wscale, flags;
+
+    uint32_t rto, ato, sndMss, rcvMss;
+    uint32_t unacked, sacked, lost, retrans, fackets;
+    uint32_t lastDataSent, lastAckSent, lastDataRecv, lastAckRecv;
+    uint32_t pmtu, rcvSsthresh, rtt, rttvar, sndSsthresh, sndCwnd, advmss, reordering;
+    uint32_t rcvRtt, rcvSpace;
+    uint32_t totalRetrans;
+
+    uint64_t pacingRate, maxPacingRate, bytesAcked, bytesReceived;
+    uint32_t segsOut, segsIn;
+    uint32_t notsentBytes, minRtt, dataSegsIn, dataSegsOut;
+    uint64_t deliveryRate;
+    uint64_t busyTime, rwndLimited, sndbufLimited;
+    uint32_t delivered, deliveredCe;
+    uint64_t bytesSent, bytesRetrans;
+};
+
+// Whether the kernel filled in the field, given the length it returned
+#define HAS_FIELD(len, fld) \
+    (size_t(len) >= offsetof(kernel_tcp_info, fld) + sizeof(kernel_tcp_info::fld))
+
+}  // namespace
+
+result<tcp_info_snapshot> stream_socket::tcp_info(socket_t h) noexcept {
+    kernel_tcp_info ki{};
+    socklen_t len = sizeof(ki);
+
+    if (::getsockopt(h, IPPROTO_TCP, TCP_INFO, &ki, &len) < 0)
+        return result<tcp_info_snapshot>::from_last_error();
+
+    tcp_info_snapshot ti;
+    ti.rtt = microseconds(ki.rtt);
+    ti.rttVar = microseconds(ki.rttvar);
+    ti.sndCwnd = uint64_t(ki.sndCwnd) * ki.sndMss;
+    ti.sndMss = ki.sndMss;
+    ti.retransmits = ki.retransmits;
+    ti.totalRetrans = ki.totalRetrans;
+
+    if (HAS_FIELD(len, pacingRate))
+        ti.pacingRate = ki.pacingRate;
+    if (HAS_FIELD(len, bytesAcked))
+        ti.bytesAcked = ki.bytesAcked;
+    if (HAS_FIELD(len, bytesReceived))
+        ti.bytesReceived = ki.bytesReceived;
+    if (HAS_FIELD(len, minRtt))
+        ti.minRtt = microseconds(ki.minRtt);
+    if (HAS_FIELD(len, deliveryRate))
+        ti.deliveryRate = ki.deliveryRate;
+    if (HAS_FIELD(len, sndbufLimited)) {
+        ti.busyTime = microseconds(ki.busyTime);
+        ti.rwndLimited = microseconds(ki.rwndLimited);
+        ti.sndbufLimited = microseconds(ki.sndbufLimited);
+    }
+    if (HAS_FIELD(len, bytesRetrans))
+        ti.bytesRetrans = ki.bytesRetrans;
+
+    return ti;
+}
+
+#undef HAS_FIELD
+
+#elif defined(__APPLE__) && defined(TCP_CONNECTION_INFO)
+
+result<tcp_info_snapshot> stream_socket::tcp_info(socket_t h) noexcept {
+    ::tcp_connection_info ci{};
+    socklen_t len = sizeof(ci);
+
+    if (::getsockopt(h, IPPROTO_TCP, TCP_CONNECTION_INFO, &ci, &len) < 0)
+        return result<tcp_info_snapshot>::from_last_error();
+
+    // The round-trip times are reported in milliseconds
+    tcp_info_snapshot ti;
+    ti.rtt = milliseconds(ci.tcpi_srtt);
+    ti.rttVar = milliseconds(ci.tcpi_rttvar);
+    ti.sndCwnd = ci.tcpi_snd_cwnd;
+    ti.sndMss = ci.tcpi_maxseg;
+    ti.totalRetrans = ci.tcpi_txretransmitpackets;
+    ti.bytesReceived = ci.tcpi_rxbytes;
+    ti.bytesRetrans = ci.tcpi_txretransmitbytes;
+    return ti;
+}
+
+#elif defined(_WIN32) && defined(SIO_TCP_INFO)
+
+result<tcp_info_snapshot> stream_socket::tcp_info(socket_t h) noexcept {
+    DWORD ver = 0, nbytes = 0;
+    TCP_INFO_v0 wi{};
+
+    auto ret = ::WSAIoctl(
+        h, SIO_TCP_INFO, &ver, sizeof(ver), &wi, sizeof(wi), &nbytes, nullptr, nullptr
+    );
+    if (ret == SOCKET_ERROR)
+        return result<tcp_info_snapshot>::from_last_error();
+
+    tcp_info_snapshot ti;
+    ti.rtt = microseconds(wi.RttUs);
+    ti.minRtt = microseconds(wi.MinRttUs);
+    ti.sndCwnd = wi.Cwnd;
+    ti.sndMss = wi.Mss;
+    ti.retransmits = wi.TimeoutEpisodes;
+    ti.totalRetrans = wi.FastRetrans + wi.TimeoutEpisodes;
+    ti.bytesAcked = wi.BytesOut - wi.BytesInFlight;
+    ti.bytesReceived = wi.BytesIn;
+    ti.bytesRetrans = wi.BytesRetrans;
+    return ti;
+}
+
+#else
+
+result<tcp_info_snapshot> stream_socket::tcp_info(socket_t) noexcept {
+    return errc::operation_not_supported;
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,319 @@
+// tcp_options.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "sockpp/acceptor.h"
+#include "sockpp/stream_socket.h"
+
+using namespace std::chrono;
+
+// The option to cork a TCP socket, if the platform has one
+#if defined(TCP_CORK)
+    #define CORK_OPT TCP_CORK
+#elif defined(TCP_NOPUSH)
+    #define CORK_OPT TCP_NOPUSH
+#endif
+
+// The option to set the keepalive idle time, if the platform has one
+#if defined(TCP_KEEPIDLE)
+    #define KEEPIDLE_OPT TCP_KEEPIDLE
+#elif defined(TCP_KEEPALIVE)
+    #define KEEPIDLE_OPT TCP_KEEPALIVE
+#endif
+
+// The option for the user timeout, and whether it's in seconds
+#if defined(TCP_USER_TIMEOUT)
+    #define USER_TIMEOUT_OPT TCP_USER_TIMEOUT
+    #define USER_TIMEOUT_SECS false
+#elif defined(TCP_MAXRT)
+    #define USER_TIMEOUT_OPT TCP_MAXRT
+    #define USER_TIMEOUT_SECS true
+#elif defined(TCP_RXT_CONNDROPTIME)
+    #define USER_TIMEOUT_OPT TCP_RXT_CONNDROPTIME
+    #define USER_TIMEOUT_SECS true
+#endif
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// The longest name of a congestion control algorithm (TCP_CA_NAME_MAX)
+constexpr size_t CA_NAME_MAX = 16;
+
+// --------------------------------------------------------------------------
+// The setters work on any socket, so that an acceptor can apply them to
+// be inherited by its connections.
+
+result<> set_cork(socket& sock, bool on) {
+#if defined(CORK_OPT)
+    return sock.set_option(IPPROTO_TCP, CORK_OPT, on);
+#else
+    (void)sock;
+    (void)on;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> set_quickack(socket& sock, bool on) {
+#if defined(TCP_QUICKACK)
+    return sock.set_option(IPPROTO_TCP, TCP_QUICKACK, on);
+#else
+    (void)sock;
+    (void)on;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> set_notsent_lowat(socket& sock, unsigned n) {
+#if defined(TCP_NOTSENT_LOWAT)
+    return sock.set_option<unsigned>(IPPROTO_TCP, TCP_NOTSENT_LOWAT, n);
+#else
+    (void)sock;
+    (void)n;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> set_congestion(socket& sock, const string& name) {
+#if defined(TCP_CONGESTION)
+    return sock.set_option(IPPROTO_TCP, TCP_CONGESTION, name.data(), socklen_t(name.size()));
+#else
+    (void)sock;
+    (void)name;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> set_user_timeout(socket& sock, milliseconds to) {
+#if defined(USER_TIMEOUT_OPT)
+    auto val = USER_TIMEOUT_SECS ? unsigned(duration_cast<seconds>(to).count())
+                                 : unsigned(to.count());
+    return sock.set_option<unsigned>(IPPROTO_TCP, USER_TIMEOUT_OPT, val);
+#else
+    (void)sock;
+    (void)to;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> set_keepalive(socket& sock, const tcp_keepalive& ka) {
+    if (auto res = sock.set_option(SOL_SOCKET, SO_KEEPALIVE, true); !res)
+        return res;
+
+    if (ka.idle.count() > 0) {
+#if defined(KEEPIDLE_OPT)
+        auto res = sock.set_option<int>(IPPROTO_TCP, KEEPIDLE_OPT, int(ka.idle.count()));
+        if (!res)
+            return res;
+#else
+        return errc::operation_not_supported;
+#endif
+    }
+    if (ka.interval.count() > 0) {
+#if defined(TCP_KEEPINTVL)
+        auto res = sock.set_option<int>(IPPROTO_TCP, TCP_KEEPINTVL, int(ka.interval.count()));
+        if (!res)
+            return res;
+#else
+        return errc::operation_not_supported;
+#endif
+    }
+    if (ka.count > 0) {
+#if defined(TCP_KEEPCNT)
+        auto res = sock.set_option<int>(IPPROTO_TCP, TCP_KEEPCNT, ka.count);
+        if (!res)
+            return res;
+#else
+        return errc::operation_not_supported;
+#endif
+    }
+    return none{};
+}
+
+// Applies each of the options in the profile, skipping any that the
+// platform or running kernel doesn't have, and keeping the first error.
+result<> apply_profile(socket& sock, const tcp_profile& prof) {
+    result<> ret;
+
+    auto keep = [&ret](result<> res) {
+        if (!res && ret && !res.is_error(errc::operation_not_supported) &&
+            !res.is_error(errc::no_protocol_option))
+            ret = std::move(res);
+    };
+
+    if (prof.nodelay)
+        keep(sock.set_option(IPPROTO_TCP, TCP_NODELAY, *prof.nodelay));
+    if (prof.quickack)
+        keep(set_quickack(sock, *prof.quickack));
+    if (prof.notsentLowat)
+        keep(set_notsent_lowat(sock, *prof.notsentLowat));
+    if (prof.userTimeout)
+        keep(set_user_timeout(sock, *prof.userTimeout));
+    if (prof.keepalive)
+        keep(set_keepalive(sock, *prof.keepalive));
+    if (prof.congestion)
+        keep(set_congestion(sock, *prof.congestion));
+    if (prof.busyPoll)
+        keep(sock.busy_poll(*prof.busyPoll));
+
+    return ret;
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+// stream_socket
+
+result<bool> stream_socket::cork() const noexcept {
+#if defined(CORK_OPT)
+    return get_option<bool>(IPPROTO_TCP, CORK_OPT);
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> stream_socket::cork(bool on) noexcept { return set_cork(*this, on); }
+
+result<bool> stream_socket::quickack() const noexcept {
+#if defined(TCP_QUICKACK)
+    return get_option<bool>(IPPROTO_TCP, TCP_QUICKACK);
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> stream_socket::quickack(bool on) noexcept { return set_quickack(*this, on); }
+
+result<unsigned> stream_socket::notsent_lowat() const noexcept {
+#if defined(TCP_NOTSENT_LOWAT)
+    return get_option<unsigned>(IPPROTO_TCP, TCP_NOTSENT_LOWAT);
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> stream_socket::notsent_lowat(unsigned n) noexcept {
+    return set_notsent_lowat(*this, n);
+}
+
+result<> stream_socket::fastopen_connect(bool on) noexcept {
+#if defined(TCP_FASTOPEN_CONNECT)
+    return set_option(IPPROTO_TCP, TCP_FASTOPEN_CONNECT, on);
+#else
+    (void)on;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<string> stream_socket::congestion() const {
+#if defined(TCP_CONGESTION)
+    char buf[CA_NAME_MAX + 1]{};
+    socklen_t len = CA_NAME_MAX;
+
+    if (auto res = get_option(IPPROTO_TCP, TCP_CONGESTION, buf, &len); !res)
+        return res.error();
+    return string{buf, ::strnlen(buf, size_t(len))};
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> stream_socket::congestion(const string& name) noexcept {
+    return set_congestion(*this, name);
+}
+
+result<milliseconds> stream_socket::user_timeout() const noexcept {
+#if defined(USER_TIMEOUT_OPT)
+    auto res = get_option<unsigned>(IPPROTO_TCP, USER_TIMEOUT_OPT);
+    if (!res)
+        return res.error();
+    if (USER_TIMEOUT_SECS)
+        return milliseconds{seconds{res.value()}};
+    return milliseconds{res.value()};
+#else
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> stream_socket::user_timeout(milliseconds to) noexcept {
+    return set_user_timeout(*this, to);
+}
+
+result<> stream_socket::keepalive(const tcp_keepalive& ka) noexcept {
+    return set_keepalive(*this, ka);
+}
+
+result<> stream_socket::apply(const tcp_profile& prof) noexcept {
+    return apply_profile(*this, prof);
+}
+
+// --------------------------------------------------------------------------
+// acceptor
+
+result<> acceptor::fastopen(int queSize) noexcept {
+#if defined(TCP_FASTOPEN)
+    return set_option<int>(IPPROTO_TCP, TCP_FASTOPEN, queSize);
+#else
+    (void)queSize;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> acceptor::defer_accept(seconds timeout) noexcept {
+#if defined(TCP_DEFER_ACCEPT)
+    return set_option<int>(IPPROTO_TCP, TCP_DEFER_ACCEPT, int(timeout.count()));
+#elif defined(SO_ACCEPTFILTER)
+    if (timeout.count() == 0)
+        return set_option(SOL_SOCKET, SO_ACCEPTFILTER, nullptr, 0);
+
+    accept_filter_arg arg{};
+    ::strncpy(arg.af_name, "dataready", sizeof(arg.af_name) - 1);
+    return set_option(SOL_SOCKET, SO_ACCEPTFILTER, &arg, socklen_t(sizeof(arg)));
+#else
+    (void)timeout;
+    return errc::operation_not_supported;
+#endif
+}
+
+result<> acceptor::apply(const tcp_profile& prof) noexcept {
+    return apply_profile(*this, prof);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,239 @@
+// timer_wheel.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/timer_wheel.h"
+
+#include <algorithm>
+
+namespace sockpp {
+
+/////////////////////////////////////////////////////////////////////////////
+
+timer_wheel::timer_wheel(milliseconds resolution /*=milliseconds{1}*/)
+    : res_{std::max<clock::duration>(resolution, milliseconds{1})}, start_{clock::now()} {}
+
+timer_wheel::~timer_wheel() {
+    for (auto& level : slots_) {
+        for (auto& head : level) {
+            for (auto t = head; t; t = t->next_) {
+                t->wheel_ = nullptr;
+                t->slot_ = nullptr;
+            }
+            head = nullptr;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+
+uint64_t timer_wheel::to_tick(time_point tp) const {
+    if (tp <= start_)
+        return 0;
+    return uint64_t((tp - start_ + res_ - clock::duration{1}) / res_);
+}
+
+// --------------------------------------------------------------------------
+// A timer goes in the lowest level that spans its delay, in the slot for
+// its expiry tick at that level's granularity. A delay past the top level
+// is placed as far out as the top level reaches; the timer is moved along
+// again from there.
+
+void timer_wheel::link(timer& t) {
+    uint64_t delta = (t.expires_ > now_) ? (t.expires_ - now_) : 0, pos = t.expires_;
+    unsigned level = 0;
+
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) ++level;
+
+    constexpr uint64_t MAX_DELTA = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+    if (delta > MAX_DELTA)
+        pos = now_ + MAX_DELTA;
+
+    auto slot = unsigned(pos >> (SLOT_BITS * level)) & (SLOTS - 1);
+    auto& head = slots_[level][slot];
+    occupied_[level] |= uint64_t(1) << slot;
+
+    t.prev_ = nullptr;
+    t.next_ = head;
+    if (head)
+        head->prev_ = &t;
+    head = &t;
+    t.slot_ = &head;
+}
+
+void timer_wheel::unlink(timer& t) {
+    if (t.prev_)
+        t.prev_->next_ = t.next_;
+    else if (!(*t.slot_ = t.next_)) {
+        // The list emptied. It might be a local one while firing.
+        auto i = size_t(t.slot_ - &slots_[0][0]);
+        if (i < LEVELS * SLOTS)
+            occupied_[i / SLOTS] &= ~(uint64_t(1) << (i % SLOTS));
+    }
+
+    if (t.next_)
+        t.next_->prev_ = t.prev_;
+
+    t.prev_ = t.next_ = nullptr;
+    t.slot_ = nullptr;
+}
+
+void timer_wheel::cascade(unsigned level, unsigned slot) {
+    auto t = slots_[level][slot];
+    slots_[level][slot] = nullptr;
+    occupied_[level] &= ~(uint64_t(1) << slot);
+
+    while (t) {
+        auto next = t->next_;
+        link(*t);
+        t = next;
+    }
+}
+
+// --------------------------------------------------------------------------
+
+void timer_wheel::schedule_tick(timer& t, uint64_t tick) {
+    // The current tick has already been processed
+    tick = std::max(tick, now_ + 1);
+
+    if (t.slot_) {
+        if (t.wheel_ == this && tick >= t.expires_) {
+            t.expires_ = tick;
+            return;
+        }
+        t.cancel();
+    }
+
+    t.wheel_ = this;
+    t.expires_ = tick;
+    link(t);
+    ++n_;
+}
+
+void timer_wheel::cancel(timer& t) {
+    if (t.wheel_ != this || !t.slot_)
+        return;
+
+    unlink(t);
+    --n_;
+}
+
+// --------------------------------------------------------------------------
+// The slot being fired is moved to a local list first, so callbacks can
+// cancel or schedule timers freely, including the ones still waiting in
+// that list. The callback is copied before it runs, since it might
+// destroy its own timer.
+
+size_t timer_wheel::advance(time_point tp) {
+    uint64_t target = (tp <= start_) ? 0 : uint64_t((tp - start_) / res_);
+    size_t nfired = 0;
+
+    while (now_ < target) {
+        if (n_ == 0) {
+            now_ = target;
+            break;
+        }
+
+        // Skip over the empty first-level slots, up to the next cascade
+        auto next = unsigned(now_ + 1) & (SLOTS - 1);
+        if (next != 0 && (occupied_[0] >> next) == 0) {
+            now_ = std::min(target, now_ + (SLOTS - next));
+            continue;
+        }
+
+        ++now_;
+
+        unsigned top = 0;
+        while (top + 1 < LEVELS && (now_ & ((uint64_t(1) << (SLOT_BITS * (top + 1))) - 1)) == 0)
+            ++top;
+
+        for (unsigned level = top; level > 0; --level)
+            cascade(level, unsigned(now_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+        auto slot = unsigned(now_) & (SLOTS - 1);
+        timer* pending = slots_[0][slot];
+        slots_[0][slot] = nullptr;
+        occupied_[0] &= ~(uint64_t(1) << slot);
+
+        for (auto t = pending; t; t = t->next_) t->slot_ = &pending;
+
+        while (pending) {
+            auto& t = *pending;
+            unlink(t);
+
+            // The deadline was pushed back after it was placed
+            if (t.expires_ > now_) {
+                link(t);
+                continue;
+            }
+
+            --n_;
+            ++nfired;
+            if (t.cb_) {
+                auto cb = t.cb_;
+                cb();
+            }
+        }
+    }
+    return nfired;
+}
+
+// --------------------------------------------------------------------------
+
+milliseconds timer_wheel::next_timeout() const {
+    if (n_ == 0)
+        return milliseconds{-1};
+
+    // The next occupied slot in the first level, or the next cascade
+    auto next = unsigned(now_ + 1) & (SLOTS - 1);
+    uint64_t tick = now_ + (SLOTS - next) + ((next == 0) ? 1 - SLOTS : 0);
+
+    if (auto bits = (next == 0) ? 0 : (occupied_[0] >> next); bits != 0) {
+        unsigned k = 0;
+        while (!(bits & 1)) {
+            bits >>= 1;
+            ++k;
+        }
+        tick = now_ + 1 + k;
+    }
+
+    auto d = start_ + res_ * tick - clock::now();
+    if (d <= clock::duration::zero())
+        return milliseconds{0};
+    return std::chrono::ceil<milliseconds>(d);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
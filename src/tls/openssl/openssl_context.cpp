@@ -0,0 +1,430 @@
+// openssl_context.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/tls_context.h"
+
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "openssl_error.h"
+#include "sockpp/inet6_address.h"
+#include "sockpp/inet_address.h"
+
+namespace sockpp {
+
+using detail::last_ssl_error;
+
+/////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// The category for errors from the OpenSSL error queue. The code is the
+// packed library and reason from ERR_get_error().
+class tls_error_category : public std::error_category
+{
+public:
+    const char* name() const noexcept override { return "TLS"; }
+
+    std::string message(int c) const override {
+        char buf[256];
+        ERR_error_string_n((unsigned long)(unsigned(c)), buf, sizeof(buf));
+        return std::string(buf);
+    }
+};
+
+// Converts a library return code, where 1 is success.
+result<> check_ssl(int ret) {
+    if (ret == 1)
+        return none{};
+    return last_ssl_error();
+}
+
+// A memory BIO over a string, which is freed on scope exit.
+struct mem_bio
+{
+    BIO* bio;
+    explicit mem_bio(const string& s) : bio{BIO_new_mem_buf(s.data(), int(s.size()))} {}
+    ~mem_bio() { BIO_free(bio); }
+};
+
+// Gets the key by which a client caches the session for a server: the
+// name of the server, if one was given, otherwise its address, along
+// with the port in either case.
+string session_key(SSL* ssl) {
+    sockaddr_storage ss{};
+    socklen_t len = sizeof(ss);
+    if (::getpeername(SSL_get_fd(ssl), reinterpret_cast<sockaddr*>(&ss), &len) < 0)
+        return string{};
+
+    string addr;
+    in_port_t port;
+    if (ss.ss_family == AF_INET) {
+        inet_address a{*reinterpret_cast<sockaddr_in*>(&ss)};
+        addr = a.to_string();
+        port = a.port();
+    }
+    else if (ss.ss_family == AF_INET6) {
+        inet6_address a{*reinterpret_cast<sockaddr_in6*>(&ss)};
+        addr = a.to_string();
+        port = a.port();
+    }
+    else {
+        return string{};
+    }
+
+    if (auto name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name); name)
+        return string{name} + ':' + std::to_string(port);
+    return addr;
+}
+
+}  // namespace
+
+const error_category& tls_category() noexcept {
+    static tls_error_category c;
+    return c;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Shared state for the library callbacks.
+//
+// The client session cache is a simple LRU list of sessions, with an
+// index by key.
+
+struct tls_context::state
+{
+    using entry = std::pair<string, SSL_SESSION*>;
+
+    std::mutex lock;
+    std::list<entry> lru;
+    std::unordered_map<string, std::list<entry>::iterator> index;
+    size_t maxSessions{DFLT_SESSION_CACHE_SIZE};
+    bool resume{true};
+
+    ~state() { flush(); }
+
+    // Removes the oldest sessions until there are at most n. This must be
+    // called with the lock held.
+    void trim(size_t n) {
+        while (lru.size() > n) {
+            index.erase(lru.back().first);
+            SSL_SESSION_free(lru.back().second);
+            lru.pop_back();
+        }
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> g{lock};
+        trim(0);
+    }
+
+    // Takes ownership of the session.
+    void put(const string& key, SSL_SESSION* sess) {
+        std::lock_guard<std::mutex> g{lock};
+        if (auto it = index.find(key); it != index.end()) {
+            SSL_SESSION_free(it->second->second);
+            lru.erase(it->second);
+            index.erase(it);
+        }
+        lru.emplace_front(key, sess);
+        index[key] = lru.begin();
+        trim(maxSessions);
+    }
+
+    // Gets a new reference to a session, or null.
+    SSL_SESSION* get(const string& key) {
+        std::lock_guard<std::mutex> g{lock};
+        auto it = index.find(key);
+        if (it == index.end())
+            return nullptr;
+
+        auto sess = it->second->second;
+        if (!SSL_SESSION_is_resumable(sess)) {
+            SSL_SESSION_free(sess);
+            lru.erase(it->second);
+            index.erase(it);
+            return nullptr;
+        }
+        lru.splice(lru.begin(), lru, it->second);
+        SSL_SESSION_up_ref(sess);
+        return sess;
+    }
+
+    // Called by the library when a client gets a new session. For TLS 1.3
+    // this happens after the handshake, when the server's ticket is read.
+    static int on_new_session(SSL* ssl, SSL_SESSION* sess) {
+        auto st = static_cast<state*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+        if (!st || !st->resume)
+            return 0;
+
+        auto key = session_key(ssl);
+        if (key.empty())
+            return 0;
+
+        st->put(key, sess);
+        return 1;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+//								tls_context
+/////////////////////////////////////////////////////////////////////////////
+
+tls_context::tls_context(role_t role /*=CLIENT*/) {
+    error_code ec;
+    *this = tls_context{role, ec};
+    if (ec)
+        throw std::system_error{ec};
+}
+
+tls_context::tls_context(role_t role, error_code& ec) noexcept : role_{role} {
+    ec = error_code{};
+
+    try {
+        state_ = std::make_unique<state>();
+    }
+    catch (const std::bad_alloc&) {
+        ec = std::make_error_code(errc::not_enough_memory);
+        return;
+    }
+
+    ctx_ = SSL_CTX_new(role == CLIENT ? TLS_client_method() : TLS_server_method());
+    if (!ctx_) {
+        ec = last_ssl_error();
+        return;
+    }
+
+    SSL_CTX_set_app_data(ctx_, state_.get());
+    SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+
+    // Let write() send part of a buffer, like a plain socket, and retry
+    // with a different buffer address after a would-block.
+    SSL_CTX_set_mode(
+        ctx_, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER
+    );
+
+    if (role == CLIENT) {
+        SSL_CTX_set_verify(ctx_, SSL_VERIFY_PEER, nullptr);
+        SSL_CTX_set_default_verify_paths(ctx_);
+
+        SSL_CTX_set_session_cache_mode(
+            ctx_, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE
+        );
+        SSL_CTX_sess_set_new_cb(ctx_, &state::on_new_session);
+    }
+    else {
+        static const unsigned char SID_CTX[] = "sockpp";
+        SSL_CTX_set_session_id_context(ctx_, SID_CTX, sizeof(SID_CTX) - 1);
+        SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_SERVER);
+    }
+}
+
+tls_context::tls_context(tls_context&& other) noexcept
+    : ctx_{other.ctx_}, role_{other.role_}, state_{std::move(other.state_)} {
+    other.ctx_ = nullptr;
+}
+
+tls_context::~tls_context() {
+    if (ctx_)
+        SSL_CTX_free(ctx_);
+}
+
+tls_context& tls_context::operator=(tls_context&& rhs) noexcept {
+    if (&rhs != this) {
+        std::swap(ctx_, rhs.ctx_);
+        std::swap(role_, rhs.role_);
+        std::swap(state_, rhs.state_);
+    }
+    return *this;
+}
+
+// --------------------------------------------------------------------------
+// Trust, certificates and keys
+
+result<> tls_context::ca_file(const string& path) {
+    return check_ssl(SSL_CTX_load_verify_locations(ctx_, path.c_str(), nullptr));
+}
+
+result<> tls_context::ca_path(const string& dir) {
+    return check_ssl(SSL_CTX_load_verify_locations(ctx_, nullptr, dir.c_str()));
+}
+
+result<> tls_context::ca_pem(const string& pem) {
+    mem_bio mb{pem};
+    auto store = SSL_CTX_get_cert_store(ctx_);
+    int n = 0;
+
+    while (auto cert = PEM_read_bio_X509(mb.bio, nullptr, nullptr, nullptr)) {
+        int ret = X509_STORE_add_cert(store, cert);
+        X509_free(cert);
+        if (ret != 1)
+            return last_ssl_error();
+        ++n;
+    }
+
+    // Running out of PEM data leaves an error in the queue
+    ERR_clear_error();
+    if (n == 0)
+        return errc::invalid_argument;
+    return none{};
+}
+
+result<> tls_context::cert_file(const string& path) {
+    return check_ssl(SSL_CTX_use_certificate_chain_file(ctx_, path.c_str()));
+}
+
+result<> tls_context::cert_pem(const string& pem) {
+    mem_bio mb{pem};
+
+    auto cert = PEM_read_bio_X509(mb.bio, nullptr, nullptr, nullptr);
+    if (!cert)
+        return last_ssl_error();
+
+    int ret = SSL_CTX_use_certificate(ctx_, cert);
+    X509_free(cert);
+    if (ret != 1)
+        return last_ssl_error();
+
+    // Any remaining certificates are the chain. The context takes
+    // ownership of each one.
+    SSL_CTX_clear_chain_certs(ctx_);
+    while (auto ca = PEM_read_bio_X509(mb.bio, nullptr, nullptr, nullptr)) {
+        if (SSL_CTX_add0_chain_cert(ctx_, ca) != 1) {
+            X509_free(ca);
+            return last_ssl_error();
+        }
+    }
+    ERR_clear_error();
+    return none{};
+}
+
+result<> tls_context::key_file(const string& path) {
+    if (SSL_CTX_use_PrivateKey_file(ctx_, path.c_str(), SSL_FILETYPE_PEM) != 1)
+        return last_ssl_error();
+    return check_ssl(SSL_CTX_check_private_key(ctx_));
+}
+
+result<> tls_context::key_pem(const string& pem) {
+    mem_bio mb{pem};
+
+    auto pkey = PEM_read_bio_PrivateKey(mb.bio, nullptr, nullptr, nullptr);
+    if (!pkey)
+        return last_ssl_error();
+
+    int ret = SSL_CTX_use_PrivateKey(ctx_, pkey);
+    EVP_PKEY_free(pkey);
+    if (ret != 1)
+        return last_ssl_error();
+    return check_ssl(SSL_CTX_check_private_key(ctx_));
+}
+
+// --------------------------------------------------------------------------
+// Options
+
+void tls_context::verify_peer(bool on) {
+    int mode = SSL_VERIFY_NONE;
+    if (on)
+        mode = (role_ == CLIENT) ? SSL_VERIFY_PEER
+                                 : (SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT);
+    SSL_CTX_set_verify(ctx_, mode, nullptr);
+}
+
+result<> tls_context::ktls(bool on /*=true*/) {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+    if (on)
+        SSL_CTX_set_options(ctx_, SSL_OP_ENABLE_KTLS);
+    else
+        SSL_CTX_clear_options(ctx_, SSL_OP_ENABLE_KTLS);
+    return none{};
+#else
+    if (!on)
+        return none{};
+    return errc::operation_not_supported;
+#endif
+}
+
+void tls_context::session_resumption(bool on) {
+    state_->resume = on;
+
+    if (role_ == SERVER) {
+        if (on) {
+            SSL_CTX_clear_options(ctx_, SSL_OP_NO_TICKET);
+            SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_SERVER);
+            SSL_CTX_set_num_tickets(ctx_, 2);
+        }
+        else {
+            SSL_CTX_set_options(ctx_, SSL_OP_NO_TICKET);
+            SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_OFF);
+            SSL_CTX_set_num_tickets(ctx_, 0);
+        }
+    }
+    else if (!on) {
+        flush_sessions();
+    }
+}
+
+void tls_context::session_cache_size(size_t n) {
+    std::lock_guard<std::mutex> g{state_->lock};
+    state_->maxSessions = n;
+    state_->trim(n);
+}
+
+size_t tls_context::cached_sessions() const {
+    std::lock_guard<std::mutex> g{state_->lock};
+    return state_->lru.size();
+}
+
+void tls_context::flush_sessions() { state_->flush(); }
+
+void tls_context::resume_session(ssl_st* ssl) {
+    if (role_ != CLIENT || !state_->resume)
+        return;
+
+    auto key = session_key(ssl);
+    if (key.empty())
+        return;
+
+    if (auto sess = state_->get(key); sess) {
+        SSL_set_session(ssl, sess);
+        SSL_SESSION_free(sess);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
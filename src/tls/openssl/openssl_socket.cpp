@@ -0,0 +1,531 @@
+// openssl_socket.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/tls_socket.h"
+
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "../../sigpipe.h"
+#include "../../stats.h"
+#include "openssl_error.h"
+#include "sockpp/inet6_address.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/tls_acceptor.h"
+#include "sockpp/tls_connector.h"
+
+#if !defined(_WIN32)
+    #include <unistd.h>
+#endif
+
+namespace sockpp {
+
+namespace {
+
+// The largest amount of plaintext in a single TLS record
+constexpr size_t MAX_RECORD = 16384;
+
+// Determines if the name is a literal IPv4 or IPv6 address, which is
+// checked against the certificate differently than a host name, and is
+// never sent as SNI.
+bool is_ip_literal(const string& name) {
+    return inet_address::parse_address(name) || inet6_address::parse_address(name);
+}
+
+#if defined(SOCKPP_SIGPIPE_GUARD)
+
+// OpenSSL's socket BIO writes with a plain write(), which raises SIGPIPE
+// on a broken connection. This BIO is the same, except that it writes
+// with send() and MSG_NOSIGNAL. Everything else goes to the socket BIO,
+// including the controls that turn on kernel TLS. Once kernel TLS is
+// sending, the socket BIO has to do the writes, to mark the record types,
+// so the signal is blocked around them instead.
+
+int nosig_sock_write(BIO* b, const char* buf, int n) {
+    if (BIO_get_ktls_send(b)) {
+        detail::sigpipe_guard guard;
+        return BIO_meth_get_write(BIO_s_socket())(b, buf, n);
+    }
+
+    int fd = -1;
+    BIO_get_fd(b, &fd);
+
+    int ret = int(::send(fd, buf, size_t(n), MSG_NOSIGNAL));
+    BIO_clear_retry_flags(b);
+    if (ret <= 0 && BIO_sock_should_retry(ret))
+        BIO_set_retry_write(b);
+    return ret;
+}
+
+const BIO_METHOD* nosig_sock_method() {
+    static BIO_METHOD* meth = [] {
+        auto sock = BIO_s_socket();
+        auto m = BIO_meth_new(BIO_TYPE_SOCKET, "socket, no SIGPIPE");
+        if (m) {
+            BIO_meth_set_write(m, nosig_sock_write);
+            BIO_meth_set_read(m, BIO_meth_get_read(sock));
+            BIO_meth_set_puts(m, BIO_meth_get_puts(sock));
+            BIO_meth_set_ctrl(m, BIO_meth_get_ctrl(sock));
+            BIO_meth_set_create(m, BIO_meth_get_create(sock));
+            BIO_meth_set_destroy(m, BIO_meth_get_destroy(sock));
+        }
+        return m;
+    }();
+    return meth;
+}
+
+// Sets the socket for the session, the way SSL_set_fd() does, but with
+// the BIO above.
+
+int set_sock_bio(SSL* ssl, int fd) {
+    auto meth = nosig_sock_method();
+    if (!meth)
+        return 0;
+
+    auto bio = BIO_new(meth);
+    if (!bio)
+        return 0;
+
+    BIO_set_fd(bio, fd, BIO_NOCLOSE);
+    SSL_set_bio(ssl, bio, bio);
+    return 1;
+}
+
+#else
+
+// Sockets here don't raise SIGPIPE, so the plain socket BIO will do.
+
+int set_sock_bio(SSL* ssl, int fd) { return SSL_set_fd(ssl, fd); }
+
+#endif
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//								tls_socket
+/////////////////////////////////////////////////////////////////////////////
+
+tls_socket::tls_socket(tls_context& ctx, stream_socket&& sock, const string& peerName) {
+    if (auto res = attach(ctx, std::move(sock), peerName); !res)
+        throw std::system_error{res.error()};
+}
+
+tls_socket::~tls_socket() { close(); }
+
+tls_socket& tls_socket::operator=(tls_socket&& rhs) noexcept {
+    if (&rhs != this) {
+        close();
+        base::operator=(std::move(rhs));
+        ssl_ = rhs.ssl_;
+        rhs.ssl_ = nullptr;
+    }
+    return *this;
+}
+
+void tls_socket::free_session() noexcept {
+    if (ssl_) {
+        SSL_free(ssl_);
+        ssl_ = nullptr;
+    }
+}
+
+// --------------------------------------------------------------------------
+
+result<> tls_socket::attach(tls_context& ctx, stream_socket&& sock, const string& peerName) {
+    if (!ctx || !sock)
+        return errc::invalid_argument;
+
+    auto ssl = SSL_new(ctx.native_handle());
+    if (!ssl)
+        return detail::last_ssl_error();
+
+    if (set_sock_bio(ssl, int(sock.handle())) != 1) {
+        SSL_free(ssl);
+        return detail::last_ssl_error();
+    }
+
+    if (ctx.is_client()) {
+        SSL_set_connect_state(ssl);
+
+        if (!peerName.empty()) {
+            int ret = 1;
+            if (is_ip_literal(peerName)) {
+                ret = X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(ssl), peerName.c_str());
+            }
+            else {
+                ret = SSL_set_tlsext_host_name(ssl, peerName.c_str());
+                if (ret == 1)
+                    ret = SSL_set1_host(ssl, peerName.c_str());
+            }
+            if (ret != 1) {
+                SSL_free(ssl);
+                return detail::last_ssl_error();
+            }
+        }
+        ctx.resume_session(ssl);
+    }
+    else {
+        SSL_set_accept_state(ssl);
+    }
+
+    close();
+    base::operator=(std::move(sock));
+    ssl_ = ssl;
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+// Converts the result of a failed library call into an error code.
+// A TLS "want read" or "want write" means that a non-blocking socket
+// would have blocked.
+
+error_code tls_socket::last_tls_error(int ret) const {
+    // Grab errno before the library can touch it
+    auto sysErr = result<>::last_error();
+
+    switch (SSL_get_error(ssl_, ret)) {
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            ERR_clear_error();
+            return std::make_error_code(errc::resource_unavailable_try_again);
+
+        case SSL_ERROR_ZERO_RETURN:
+            ERR_clear_error();
+            return std::make_error_code(errc::not_connected);
+
+        case SSL_ERROR_SYSCALL:
+            ERR_clear_error();
+            if (sysErr)
+                return sysErr;
+            return std::make_error_code(errc::connection_reset);
+
+        case SSL_ERROR_SSL:
+            // The peer closed without a TLS close notification
+            if (ERR_GET_REASON(ERR_peek_last_error()) ==
+                SSL_R_UNEXPECTED_EOF_WHILE_READING) {
+                ERR_clear_error();
+                return std::make_error_code(errc::connection_reset);
+            }
+            return detail::last_ssl_error();
+
+        default:
+            return detail::last_ssl_error();
+    }
+}
+
+// --------------------------------------------------------------------------
+
+result<> tls_socket::handshake() {
+    if (!ssl_)
+        return errc::not_connected;
+
+    ERR_clear_error();
+    int ret = SSL_do_handshake(ssl_);
+    if (ret == 1)
+        return none{};
+    return last_tls_error(ret);
+}
+
+bool tls_socket::is_established() const { return ssl_ && SSL_is_init_finished(ssl_); }
+
+bool tls_socket::session_reused() const { return ssl_ && SSL_session_reused(ssl_) == 1; }
+
+bool tls_socket::ktls_send() const {
+#if defined(BIO_get_ktls_send) && !defined(OPENSSL_NO_KTLS)
+    return ssl_ && BIO_get_ktls_send(SSL_get_wbio(ssl_)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool tls_socket::ktls_recv() const {
+#if defined(BIO_get_ktls_recv) && !defined(OPENSSL_NO_KTLS)
+    return ssl_ && BIO_get_ktls_recv(SSL_get_rbio(ssl_)) != 0;
+#else
+    return false;
+#endif
+}
+
+string tls_socket::protocol() const {
+    return ssl_ ? string{SSL_get_version(ssl_)} : string{};
+}
+
+string tls_socket::cipher() const {
+    if (!ssl_)
+        return string{};
+    auto name = SSL_get_cipher_name(ssl_);
+    return name ? string{name} : string{};
+}
+
+// --------------------------------------------------------------------------
+// Reading
+
+result<size_t> tls_socket::read(void* buf, size_t n) {
+    if (!ssl_)
+        return errc::not_connected;
+
+    ERR_clear_error();
+    size_t nx = 0;
+    int ret = SSL_read_ex(ssl_, buf, n, &nx);
+    if (ret == 1) {
+        detail::stats_recv(ssize_t(nx));
+        return nx;
+    }
+
+    // A close notification from the peer is a clean end of stream
+    if (SSL_get_error(ssl_, ret) == SSL_ERROR_ZERO_RETURN)
+        return 0;
+
+    detail::stats_recv(-1);
+    return last_tls_error(ret);
+}
+
+// Fills the ranges in order, but doesn't wait for more data once some has
+// been read, the same as a readv().
+
+result<size_t> tls_socket::read(const iovec* ranges, size_t n) {
+    size_t nx = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (ranges[i].iov_len == 0)
+            continue;
+
+        if (nx > 0 && SSL_pending(ssl_) == 0)
+            break;
+
+        auto res = read(ranges[i].iov_base, ranges[i].iov_len);
+        if (!res)
+            return (nx > 0) ? result<size_t>{nx} : res;
+
+        nx += res.value();
+        if (res.value() < ranges[i].iov_len)
+            break;
+    }
+
+    return nx;
+}
+
+// --------------------------------------------------------------------------
+// Writing
+
+result<size_t> tls_socket::write(const void* buf, size_t n) {
+    if (!ssl_)
+        return errc::not_connected;
+
+    if (n == 0)
+        return 0;
+
+    ERR_clear_error();
+    size_t nx = 0;
+    int ret = SSL_write_ex(ssl_, buf, n, &nx);
+    if (ret == 1) {
+        detail::stats_send(ssize_t(nx), n);
+        return nx;
+    }
+
+    detail::stats_send(-1, n);
+    return last_tls_error(ret);
+}
+
+// Each write makes at least one TLS record, which costs a header, a MAC,
+// and a system call. So a batch of small ranges is gathered into a single
+// record, and larger ones are written in order.
+
+result<size_t> tls_socket::write(const iovec* ranges, size_t n) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) total += ranges[i].iov_len;
+
+    if (n > 1 && total <= MAX_RECORD) {
+        uint8_t buf[MAX_RECORD];
+        size_t off = 0;
+        for (size_t i = 0; i < n; ++i) {
+            std::memcpy(buf + off, ranges[i].iov_base, ranges[i].iov_len);
+            off += ranges[i].iov_len;
+        }
+        return write(buf, total);
+    }
+
+    size_t nx = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (ranges[i].iov_len == 0)
+            continue;
+
+        auto res = write(ranges[i].iov_base, ranges[i].iov_len);
+        if (!res)
+            return (nx > 0) ? result<size_t>{nx} : res;
+
+        nx += res.value();
+        if (res.value() < ranges[i].iov_len)
+            break;
+    }
+    return nx;
+}
+
+// With kernel TLS, the kernel encrypts whatever is written to the socket,
+// so the file can go straight from the page cache. Otherwise the file is
+// read and sent a record at a time.
+
+result<size_t> tls_socket::send_file(file_handle_t fd, uint64_t offset, size_t count) {
+    if (!ssl_)
+        return errc::not_connected;
+
+    if (ktls_send())
+        return base::send_file(fd, offset, count);
+
+    uint8_t buf[MAX_RECORD];
+    size_t nx = 0;
+
+    while (nx < count) {
+        size_t len = std::min(count - nx, MAX_RECORD);
+
+#if defined(_WIN32)
+        OVERLAPPED ov{};
+        ov.Offset = DWORD(offset);
+        ov.OffsetHigh = DWORD(offset >> 32);
+
+        DWORD nr = 0;
+        if (!::ReadFile(fd, buf, DWORD(len), &nr, &ov)) {
+            if (nx > 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+#else
+        ssize_t nr = ::pread(fd, buf, len, off_t(offset));
+        if (nr < 0) {
+            if (nx > 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+#endif
+        // End of file
+        if (nr == 0)
+            break;
+
+        auto res = write(buf, size_t(nr));
+        if (!res)
+            return (nx > 0) ? result<size_t>{nx} : res;
+
+        nx += res.value();
+        offset += res.value();
+
+        if (res.value() < size_t(nr))
+            break;
+    }
+    return nx;
+}
+
+#if defined(__linux__)
+result<size_t> tls_socket::write_zerocopy(const void* buf, size_t n) {
+    if (!ktls_send())
+        return errc::operation_not_supported;
+    return base::write_zerocopy(buf, n);
+}
+#endif
+
+// --------------------------------------------------------------------------
+
+result<> tls_socket::shutdown_tls() {
+    if (!ssl_ || !SSL_is_init_finished(ssl_))
+        return errc::not_connected;
+
+    ERR_clear_error();
+    int ret = SSL_shutdown(ssl_);
+    if (ret >= 0)
+        return none{};
+    return last_tls_error(ret);
+}
+
+result<> tls_socket::close() {
+    if (ssl_) {
+        // Let the peer know that the data wasn't truncated. This is best
+        // effort, and must not wait for the peer's reply.
+        if (SSL_is_init_finished(ssl_) && !(SSL_get_shutdown(ssl_) & SSL_SENT_SHUTDOWN)) {
+            SSL_shutdown(ssl_);
+            ERR_clear_error();
+        }
+        free_session();
+    }
+    return base::close();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								tls_connector
+/////////////////////////////////////////////////////////////////////////////
+
+result<> tls_connector::connect(
+    const sock_address& addr, const string& peerName /*=string{}*/,
+    microseconds timeout /*=microseconds{0}*/
+) {
+    connector conn;
+    auto res = (timeout.count() > 0) ? conn.connect(addr, timeout) : conn.connect(addr);
+    if (!res)
+        return res;
+
+    if (res = attach(*ctx_, std::move(conn), peerName); !res)
+        return res;
+
+    if (res = handshake(); !res)
+        close();
+    return res;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								tls_acceptor
+/////////////////////////////////////////////////////////////////////////////
+
+result<tls_socket>
+tls_acceptor::accept(sock_address* clientAddr /*=nullptr*/, int flags /*=0*/) {
+    auto res = base::accept(clientAddr, flags);
+    if (!res)
+        return res.error();
+
+    error_code ec;
+    tls_socket sock{*ctx_, res.release(), string{}, ec};
+    if (ec)
+        return ec;
+
+    if (!(flags & NON_BLOCKING)) {
+        if (auto hsRes = sock.handshake(); !hsRes)
+            return hsRes.error();
+    }
+    return sock;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,94 @@
+// trace.h
+//
+// Internal USDT probes on the library's hot paths, for tools like bpftrace
+// and perf. These compile away to nothing unless the library is built with
+// the SOCKPP_WITH_TRACING option.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+
+#ifndef __sockpp_trace_h
+#define __sockpp_trace_h
+
+#include <cstdint>
+
+#include "sockpp/result.h"
+
+// Each probe is in the "sockpp" provider. The double underscore in a name
+// becomes a dash in the ELF note, so `read_n__retry` is traced as
+// `usdt:...:sockpp:read_n-retry`. A probe that isn't attached costs a
+// single no-op instruction, plus getting its arguments into registers, so
+// the arguments are kept to values that are already at hand.
+
+#if defined(SOCKPP_WITH_TRACING)
+    #include <sys/sdt.h>
+
+    #define SOCKPP_TRACE1(name, a) DTRACE_PROBE1(sockpp, name, a)
+    #define SOCKPP_TRACE2(name, a, b) DTRACE_PROBE2(sockpp, name, a, b)
+    #define SOCKPP_TRACE3(name, a, b, c) DTRACE_PROBE3(sockpp, name, a, b, c)
+#else
+    #define SOCKPP_TRACE1(name, a) ((void)0)
+    #define SOCKPP_TRACE2(name, a, b) ((void)0)
+    #define SOCKPP_TRACE3(name, a, b, c) ((void)0)
+#endif
+
+namespace sockpp {
+namespace detail {
+
+/**
+ * Gets a byte count for a probe.
+ * @param res The result of an I/O call.
+ * @return The number of bytes on success, or the negated error code on
+ *  	   failure.
+ */
+inline int64_t trace_ret(const result<size_t>& res) noexcept {
+    return res ? int64_t(res.value()) : -int64_t(res.error().value());
+}
+
+/**
+ * Gets the error for a probe.
+ * @param res The result of a call.
+ * @return Zero on success, or the negated error code on failure.
+ */
+template <typename T>
+inline int64_t trace_err(const result<T>& res) noexcept {
+    return res ? 0 : -int64_t(res.error().value());
+}
+
+}  // namespace detail
+}  // namespace sockpp
+
+#endif  // __sockpp_trace_h
@@ -0,0 +1,638 @@
+// capture.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/capture.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <system_error>
+#include <thread>
+
+using namespace std::chrono;
+
+namespace sockpp {
+
+namespace {
+
+// The pcapng block types
+constexpr uint32_t SHB_TYPE = 0x0A0D0D0A;
+constexpr uint32_t IDB_TYPE = 0x00000001;
+constexpr uint32_t EPB_TYPE = 0x00000006;
+
+// The section header magic, which tells the byte order
+constexpr uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+// The sizes of the fixed parts of the blocks we write
+constexpr size_t SHB_SIZE = 28;
+constexpr size_t IDB_SIZE = 32;
+constexpr size_t EPB_SIZE = 32;
+
+// The interface option for the timestamp resolution
+constexpr uint16_t OPT_TSRESOL = 9;
+
+// The default timestamp resolution, in microseconds (10^-6)
+constexpr uint8_t DFLT_TSRESOL = 6;
+
+// The largest SocketCAN frame (CANFD_MTU)
+constexpr size_t MAX_CAN_FRAME = 72;
+
+// The most messages sent with a single sendmmsg()
+constexpr size_t MMSG_CHUNK = 64;
+
+inline void put16(char* p, uint16_t v) noexcept { std::memcpy(p, &v, sizeof(v)); }
+inline void put32(char* p, uint32_t v) noexcept { std::memcpy(p, &v, sizeof(v)); }
+
+inline uint16_t swap16(uint16_t v) noexcept { return uint16_t((v >> 8) | (v << 8)); }
+
+inline uint32_t swap32(uint32_t v) noexcept {
+    return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+inline size_t pad4(size_t n) noexcept { return (n + 3) & ~size_t(3); }
+
+// Converts the SocketCAN ID at the start of a frame between host and
+// network byte order. It's the same swap both ways.
+inline void swap_can_id(char* p) noexcept {
+    uint32_t id;
+    std::memcpy(&id, p, sizeof(id));
+    id = htonl(id);
+    std::memcpy(p, &id, sizeof(id));
+}
+
+// Converts a timestamp in the units of an interface to nanoseconds.
+nanoseconds to_nanos(uint64_t ts, uint8_t tsresol) noexcept {
+    static constexpr uint64_t POW10[] = {
+        1ULL,
+        10ULL,
+        100ULL,
+        1000ULL,
+        10000ULL,
+        100000ULL,
+        1000000ULL,
+        10000000ULL,
+        100000000ULL,
+        1000000000ULL,
+    };
+
+    if (tsresol & 0x80) {
+        auto secs = std::ldexp((long double)ts, -int(tsresol & 0x7F));
+        return nanoseconds{int64_t(secs * 1.0e9L)};
+    }
+    if (tsresol <= 9)
+        return nanoseconds{int64_t(ts * POW10[9 - tsresol])};
+    if (tsresol <= 18)
+        return nanoseconds{int64_t(ts / POW10[tsresol - 9])};
+    return nanoseconds{0};
+}
+
+// Sends a batch of messages straight out of a socket handle.
+result<size_t> send_batch(socket_t h, const iovec* bufs, size_t n) {
+    size_t nsent = 0;
+
+#if defined(__linux__)
+    mmsghdr msgs[MMSG_CHUNK];
+
+    while (nsent < n) {
+        size_t nchunk = std::min(n - nsent, MMSG_CHUNK);
+        std::memset(msgs, 0, nchunk * sizeof(mmsghdr));
+
+        for (size_t i = 0; i < nchunk; ++i) {
+            msgs[i].msg_hdr.msg_iov = const_cast<iovec*>(&bufs[nsent + i]);
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int ret = ::sendmmsg(h, msgs, unsigned(nchunk), MSG_NOSIGNAL);
+        if (ret < 0) {
+            if (nsent != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+
+        nsent += size_t(ret);
+        if (size_t(ret) < nchunk)
+            break;
+    }
+#else
+    while (nsent < n) {
+        if (::send(h, bufs[nsent].iov_base, bufs[nsent].iov_len, MSG_NOSIGNAL) < 0) {
+            if (nsent != 0)
+                break;
+            return result<size_t>::from_last_error();
+        }
+        ++nsent;
+    }
+#endif
+
+    return nsent;
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+//								capture_writer
+/////////////////////////////////////////////////////////////////////////////
+
+capture_writer::capture_writer(
+    const std::string& path, capture_link link, size_t snapLen /*=DFLT_SNAP_LEN*/,
+    size_t chunkSize /*=DFLT_CHUNK_SIZE*/
+) {
+    if (auto res = open(path, link, snapLen, chunkSize); !res)
+        throw std::system_error{res.error()};
+}
+
+capture_writer::capture_writer(
+    const std::string& path, capture_link link, error_code& ec
+) noexcept {
+    if (auto res = open(path, link); !res)
+        ec = res.error();
+}
+
+result<> capture_writer::open(
+    const std::string& path, capture_link link, size_t snapLen /*=DFLT_SNAP_LEN*/,
+    size_t chunkSize /*=DFLT_CHUNK_SIZE*/
+) noexcept {
+    close();
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0)
+        return result<>::last_error();
+
+    link_ = link;
+    snapLen_ = std::min<size_t>(std::max<size_t>(snapLen, 1), UINT32_MAX);
+    chunkSize_ = std::max<size_t>(chunkSize, 64 * 1024);
+
+    if (auto res = reserve(SHB_SIZE + IDB_SIZE); !res) {
+        close();
+        return res;
+    }
+
+    // The section header, with an unknown section length
+    char* p = base_;
+    put32(p, SHB_TYPE);
+    put32(p + 4, uint32_t(SHB_SIZE));
+    put32(p + 8, BYTE_ORDER_MAGIC);
+    put16(p + 12, 1);
+    put16(p + 14, 0);
+    put32(p + 16, UINT32_MAX);
+    put32(p + 20, UINT32_MAX);
+    put32(p + 24, uint32_t(SHB_SIZE));
+
+    // The interface, with nanosecond timestamps
+    p += SHB_SIZE;
+    put32(p, IDB_TYPE);
+    put32(p + 4, uint32_t(IDB_SIZE));
+    put16(p + 8, uint16_t(link));
+    put16(p + 10, 0);
+    put32(p + 12, uint32_t(snapLen_));
+    put16(p + 16, OPT_TSRESOL);
+    put16(p + 18, 1);
+    p[20] = 9;
+    std::memset(p + 21, 0, 7);
+    put32(p + 28, uint32_t(IDB_SIZE));
+
+    size_ = SHB_SIZE + IDB_SIZE;
+    return none{};
+}
+
+// The file is grown a chunk at a time, and the map grown along with it, so
+// that most writes are just a copy into memory.
+
+result<> capture_writer::reserve(size_t n) {
+    if (size_ + n <= mapSize_)
+        return none{};
+
+    size_t newSize = (size_ + n + chunkSize_ - 1) / chunkSize_ * chunkSize_;
+    if (::ftruncate(fd_, off_t(newSize)) < 0)
+        return result<>::last_error();
+
+    void* p;
+#if defined(__linux__)
+    if (base_)
+        p = ::mremap(base_, mapSize_, newSize, MREMAP_MAYMOVE);
+    else
+        p = ::mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#else
+    if (base_)
+        ::munmap(base_, mapSize_);
+    p = ::mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+
+    if (p == MAP_FAILED) {
+        auto err = result<>::last_error();
+#if !defined(__linux__)
+        base_ = nullptr;
+        mapSize_ = 0;
+#endif
+        return err;
+    }
+
+    base_ = static_cast<char*>(p);
+    mapSize_ = newSize;
+    return none{};
+}
+
+result<> capture_writer::write(
+    const void* data, size_t n, nanoseconds time /*=nanoseconds{0}*/
+) noexcept {
+    if (!is_open())
+        return errc::bad_file_descriptor;
+
+    if (time.count() == 0)
+        time = duration_cast<nanoseconds>(system_clock::now().time_since_epoch());
+
+    size_t capLen = std::min(n, snapLen_), padLen = pad4(capLen);
+    size_t blkLen = EPB_SIZE + padLen;
+
+    if (auto res = reserve(blkLen); !res)
+        return res;
+
+    auto ts = uint64_t(time.count());
+    char* p = base_ + size_;
+
+    put32(p, EPB_TYPE);
+    put32(p + 4, uint32_t(blkLen));
+    put32(p + 8, 0);
+    put32(p + 12, uint32_t(ts >> 32));
+    put32(p + 16, uint32_t(ts));
+    put32(p + 20, uint32_t(capLen));
+    put32(p + 24, uint32_t(std::min<size_t>(n, UINT32_MAX)));
+    std::memcpy(p + 28, data, capLen);
+    std::memset(p + 28 + capLen, 0, padLen - capLen);
+    put32(p + 28 + padLen, uint32_t(blkLen));
+
+    if (link_ == capture_link::socketcan && capLen >= sizeof(uint32_t))
+        swap_can_id(p + 28);
+
+    size_ += blkLen;
+    ++count_;
+    return none{};
+}
+
+result<size_t> capture_writer::write_many(
+    const iovec* bufs, const size_t* lens, size_t n,
+    const socket::packet_timestamp* ts /*=nullptr*/
+) noexcept {
+    // A single clock read for a batch without timestamps
+    auto now = duration_cast<nanoseconds>(system_clock::now().time_since_epoch());
+
+    for (size_t i = 0; i < n; ++i) {
+        auto t = (ts && ts[i].has_software()) ? ts[i].software : now;
+        if (auto res = write(bufs[i].iov_base, lens[i], t); !res) {
+            if (i == 0)
+                return res.error();
+            return i;
+        }
+    }
+    return n;
+}
+
+result<> capture_writer::flush() noexcept {
+    if (!is_open())
+        return errc::bad_file_descriptor;
+
+    if (::msync(base_, size_, MS_ASYNC) < 0)
+        return result<>::last_error();
+    return none{};
+}
+
+result<> capture_writer::close() noexcept {
+    if (fd_ < 0)
+        return none{};
+
+    result<> ret = none{};
+    if (base_)
+        ::munmap(base_, mapSize_);
+    if (::ftruncate(fd_, off_t(size_)) < 0)
+        ret = result<>::last_error();
+    ::close(fd_);
+
+    fd_ = -1;
+    base_ = nullptr;
+    mapSize_ = size_ = count_ = 0;
+    return ret;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								capture_reader
+/////////////////////////////////////////////////////////////////////////////
+
+capture_reader::capture_reader(const std::string& path) {
+    if (auto res = open(path); !res)
+        throw std::system_error{res.error()};
+}
+
+capture_reader::capture_reader(const std::string& path, error_code& ec) noexcept {
+    if (auto res = open(path); !res)
+        ec = res.error();
+}
+
+result<> capture_reader::open(const std::string& path) noexcept {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return result<>::last_error();
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0) {
+        auto err = result<>::last_error();
+        ::close(fd);
+        return err;
+    }
+
+    auto sz = size_t(st.st_size);
+    if (sz < SHB_SIZE) {
+        ::close(fd);
+        return errc::bad_message;
+    }
+
+    void* p = ::mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+    auto err = result<>::last_error();
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+        return err;
+
+    ::posix_madvise(p, sz, POSIX_MADV_SEQUENTIAL);
+    base_ = static_cast<const char*>(p);
+    size_ = sz;
+
+    // The block type of a section header reads the same in either order
+    uint32_t type;
+    std::memcpy(&type, base_, sizeof(type));
+    if (type != SHB_TYPE) {
+        close();
+        return errc::bad_message;
+    }
+
+    if (auto res = read_headers(); !res) {
+        close();
+        return res;
+    }
+    return none{};
+}
+
+uint16_t capture_reader::get16(size_t off) const noexcept {
+    uint16_t v;
+    std::memcpy(&v, base_ + off, sizeof(v));
+    return swap_ ? swap16(v) : v;
+}
+
+uint32_t capture_reader::get32(size_t off) const noexcept {
+    uint32_t v;
+    std::memcpy(&v, base_ + off, sizeof(v));
+    return swap_ ? swap32(v) : v;
+}
+
+// Reads the sections and interfaces up to the next packet, leaving the
+// position at the packet, or at the end of the data.
+
+result<> capture_reader::read_headers() noexcept {
+    while (size_ - pos_ >= 12) {
+        size_t blk = pos_;
+
+        // A new section can switch the byte order
+        if (get32(blk) == SHB_TYPE) {
+            if (size_ - blk < SHB_SIZE)
+                return errc::bad_message;
+
+            swap_ = false;
+            auto magic = get32(blk + 8);
+            if (magic == swap32(BYTE_ORDER_MAGIC))
+                swap_ = true;
+            else if (magic != BYTE_ORDER_MAGIC)
+                return errc::bad_message;
+            ifaces_.clear();
+        }
+
+        uint32_t type = get32(blk), len = get32(blk + 4);
+
+        // The zeroed tail of a file that's still being written
+        if (type == 0 && len == 0)
+            break;
+
+        if (len < 12 || len % 4 != 0 || len > size_ - blk)
+            return errc::bad_message;
+
+        if (type == EPB_TYPE)
+            break;
+
+        if (type == IDB_TYPE) {
+            if (len < 20)
+                return errc::bad_message;
+
+            iface ifc{capture_link(get16(blk + 8)), DFLT_TSRESOL};
+            for (size_t off = blk + 16; off + 4 <= blk + len - 4;) {
+                auto code = get16(off), optLen = get16(off + 2);
+                if (code == 0)
+                    break;
+                if (code == OPT_TSRESOL && optLen >= 1)
+                    ifc.tsresol = uint8_t(base_[off + 4]);
+                off += 4 + pad4(optLen);
+            }
+            ifaces_.push_back(ifc);
+        }
+        pos_ += len;
+    }
+    return none{};
+}
+
+result<bool> capture_reader::next(capture_record& rec) noexcept {
+    if (!is_open())
+        return errc::bad_file_descriptor;
+
+    if (auto res = read_headers(); !res)
+        return res.error();
+
+    size_t blk = pos_;
+    if (size_ - blk < 12 || get32(blk) != EPB_TYPE)
+        return false;
+
+    auto len = get32(blk + 4);
+    if (len < EPB_SIZE)
+        return errc::bad_message;
+
+    auto id = get32(blk + 8);
+    auto capLen = get32(blk + 20);
+    if (id >= ifaces_.size() || capLen > len - EPB_SIZE)
+        return errc::bad_message;
+
+    const auto& ifc = ifaces_[id];
+    uint64_t ts = (uint64_t(get32(blk + 12)) << 32) | get32(blk + 16);
+
+    rec.time = to_nanos(ts, ifc.tsresol);
+    rec.data = std::string_view{base_ + blk + 28, capLen};
+    rec.origLen = get32(blk + 24);
+    rec.link = ifc.link;
+
+    if (ifc.link == capture_link::socketcan && capLen >= sizeof(uint32_t)
+        && capLen <= sizeof(frame_)) {
+        std::memcpy(frame_, rec.data.data(), capLen);
+        swap_can_id(frame_);
+        rec.data = std::string_view{frame_, capLen};
+    }
+
+    pos_ += len;
+    return true;
+}
+
+void capture_reader::rewind() noexcept {
+    pos_ = 0;
+    swap_ = false;
+    ifaces_.clear();
+    if (base_)
+        read_headers();
+}
+
+void capture_reader::close() noexcept {
+    if (base_)
+        ::munmap(const_cast<char*>(base_), size_);
+
+    base_ = nullptr;
+    size_ = 0;
+    rewind();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//								capture_replayer
+/////////////////////////////////////////////////////////////////////////////
+
+result<size_t> capture_replayer::run(const sink_type& sink) {
+    using clock = steady_clock;
+
+    std::vector<iovec> iov;
+    iov.reserve(batchSize_);
+
+    capture_record rec;
+    bool first = true, held = false, done = false;
+    nanoseconds prev{0}, offset{0};
+    auto start = clock::now();
+    clock::time_point due = start;
+    size_t total = 0;
+
+    // Works out when the packet in `rec` should be sent
+    auto schedule = [&] {
+        if (first) {
+            prev = rec.time;
+            first = false;
+        }
+        auto gap = std::max(rec.time - prev, nanoseconds{0});
+        if (maxGap_.count() > 0)
+            gap = std::min(gap, maxGap_);
+        offset += gap;
+        prev = rec.time;
+
+        if (speed_ > 0.0)
+            due = start + duration_cast<clock::duration>(
+                              duration<double, std::nano>(double(offset.count()) / speed_)
+                          );
+    };
+
+    // Adds the packet in `rec` to the batch. SocketCAN frames only last
+    // until the next read, so they're copied.
+    auto add = [&] {
+        auto p = const_cast<char*>(rec.data.data());
+        auto n = rec.data.size();
+
+        if (rec.link == capture_link::socketcan) {
+            stage_.resize(batchSize_ * MAX_CAN_FRAME);
+            n = std::min(n, MAX_CAN_FRAME);
+            p = static_cast<char*>(std::memcpy(&stage_[iov.size() * MAX_CAN_FRAME], p, n));
+        }
+        iov.push_back(iovec{p, n});
+    };
+
+    while (!done) {
+        iov.clear();
+
+        if (!held) {
+            auto res = rdr_.next(rec);
+            if (!res)
+                return res.error();
+            if (!res.value())
+                break;
+            schedule();
+        }
+        held = false;
+
+        if (speed_ > 0.0)
+            std::this_thread::sleep_until(due);
+        add();
+
+        // Take whatever else is due by now
+        while (iov.size() < batchSize_) {
+            auto res = rdr_.next(rec);
+            if (!res)
+                return res.error();
+            if (!res.value()) {
+                done = true;
+                break;
+            }
+            schedule();
+            if (speed_ > 0.0 && due > clock::now()) {
+                held = true;
+                break;
+            }
+            add();
+        }
+
+        for (size_t sent = 0; sent < iov.size();) {
+            auto res = sink(&iov[sent], iov.size() - sent);
+            if (!res)
+                return res.error();
+            if (res.value() == 0)
+                return errc::no_buffer_space;
+            sent += res.value();
+        }
+        total += iov.size();
+    }
+    return total;
+}
+
+result<size_t> capture_replayer::run(raw_socket& sock) {
+    return run([h = sock.handle()](const iovec* bufs, size_t n) {
+        return send_batch(h, bufs, n);
+    });
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -56,7 +56,7 @@ unix_address::unix_address(const string& path) {
 
     addr_.sun_family = ADDRESS_FAMILY;
     // Remember, if len==MAX, there's no NUL terminator
-    ::strncpy(addr_.sun_path, path.c_str(), MAX_PATH_NAME);
+    std::memcpy(addr_.sun_path, path.data(), path.length());
 }
 
 unix_address::unix_address(const string& path, error_code& ec) noexcept {
@@ -67,7 +67,7 @@ unix_address::unix_address(const string& path, error_code& ec) noexcept {
         ec = error_code{};
         addr_.sun_family = ADDRESS_FAMILY;
         // Remember, if len==MAX, there's no NUL terminator
-        ::strncpy(addr_.sun_path, path.c_str(), MAX_PATH_NAME);
+        std::memcpy(addr_.sun_path, path.data(), path.length());
     }
 }
 
@@ -80,10 +80,43 @@ result<unix_address> unix_address::create(const string& path) {
     return unix_address{path};
 }
 
+result<unix_address> unix_address::create_abstract(const string& name) {
+#if defined(__linux__)
+    if (name.empty() || name.length() >= MAX_PATH_NAME)
+        return errc::invalid_argument;
+
+    return unix_address{string(1, '\0') + name};
+#else
+    (void)name;
+    return errc::operation_not_supported;
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+std::to_chars_result unix_address::to_chars(char* first, char* last) const noexcept {
+    static constexpr char PREFIX[] = "unix:";
+    static constexpr size_t PREFIX_LEN = sizeof(PREFIX) - 1;
+
+    // An abstract name is shown with a leading '@' in place of the NUL,
+    // the same as most system tools show it.
+    size_t n = path_len();
+    if (size_t(last - first) < PREFIX_LEN + n)
+        return {last, std::errc::value_too_large};
+
+    std::memcpy(first, PREFIX, PREFIX_LEN);
+    std::memcpy(first + PREFIX_LEN, addr_.sun_path, n);
+    if (is_abstract())
+        first[PREFIX_LEN] = ABSTRACT_PREFIX;
+    return {first + PREFIX_LEN + n, std::errc{}};
+}
+
 // --------------------------------------------------------------------------
 
 ostream& operator<<(ostream& os, const unix_address& addr) {
-    os << "unix:" << addr.path();
+    char buf[unix_address::MAX_STR_LEN];
+    auto res = addr.to_chars(buf, buf + sizeof(buf));
+    os.write(buf, res.ptr - buf);
     return os;
 }
 
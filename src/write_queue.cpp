@@ -0,0 +1,212 @@
+// write_queue.cpp
+//
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+
+#include "sockpp/write_queue.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sockpp {
+
+// The most I/O vectors gathered for a single write
+static constexpr size_t MAX_FLUSH_IOV = 64;
+
+/////////////////////////////////////////////////////////////////////////////
+
+write_queue::write_queue(
+    stream_socket& sock, size_t flushThreshold /*=DFLT_FLUSH_THRESHOLD*/,
+    size_t highMark /*=DFLT_HIGH_WATERMARK*/, size_t lowMark /*=DFLT_LOW_WATERMARK*/
+)
+    : sock_{sock},
+      flushThreshold_{flushThreshold},
+      highMark_{std::max<size_t>(highMark, 1)},
+      lowMark_{std::min(lowMark, highMark_ - 1)} {}
+
+// --------------------------------------------------------------------------
+
+void write_queue::update_pause() {
+    bool paused = paused_ ? (size_ > lowMark_) : (size_ >= highMark_);
+    if (paused != paused_) {
+        paused_ = paused;
+        if (handler_)
+            handler_(paused);
+    }
+}
+
+result<> write_queue::queued(size_t n) {
+    size_ += n;
+    update_pause();
+
+    if (size_ >= flushThreshold_) {
+        if (auto res = flush(); !res)
+            return res.error();
+    }
+    return none{};
+}
+
+// --------------------------------------------------------------------------
+// Small messages are appended to the last chunk while it has room, so a
+// burst of them goes out as one I/O vector. A chunk never reallocates,
+// since queued segments point into it.
+
+result<> write_queue::push(const void* buf, size_t n) {
+    if (paused_)
+        return errc::no_buffer_space;
+    if (n == 0)
+        return none{};
+
+    if (n > COPY_THRESHOLD) {
+        std::string s(static_cast<const char*>(buf), n);
+        return push(std::move(s));
+    }
+
+    if (segs_.empty() || !segs_.back().open ||
+        segs_.back().str.size() + n > segs_.back().str.capacity()) {
+        auto& seg = segs_.emplace_back();
+        seg.str.reserve(CHUNK_SIZE);
+        seg.data = seg.str.data();
+        seg.open = true;
+    }
+
+    auto& seg = segs_.back();
+    seg.str.append(static_cast<const char*>(buf), n);
+    seg.len += n;
+    return queued(n);
+}
+
+result<> write_queue::push(std::string&& s) {
+    if (s.size() <= COPY_THRESHOLD)
+        return push(s.data(), s.size());
+    if (paused_)
+        return errc::no_buffer_space;
+
+    auto n = s.size();
+    auto& seg = segs_.emplace_back();
+    seg.str = std::move(s);
+    seg.data = seg.str.data();
+    seg.len = n;
+    return queued(n);
+}
+
+result<> write_queue::push_segment(std::shared_ptr<const void> keep, const void* buf, size_t n) {
+    if (paused_)
+        return errc::no_buffer_space;
+    if (n == 0)
+        return none{};
+
+    auto& seg = segs_.emplace_back();
+    seg.keep = std::move(keep);
+    seg.data = static_cast<const char*>(buf);
+    seg.len = n;
+    return queued(n);
+}
+
+result<> write_queue::push(std::shared_ptr<const void> keep, const void* buf, size_t n) {
+    if (n <= COPY_THRESHOLD)
+        return push(buf, n);
+    return push_segment(std::move(keep), buf, n);
+}
+
+result<> write_queue::push(pooled_buffer&& buf) {
+    if (buf.size() <= COPY_THRESHOLD)
+        return push(buf.data(), buf.size());
+
+    auto p = std::make_shared<pooled_buffer>(std::move(buf));
+    auto data = p->data();
+    auto n = p->size();
+    return push_segment(std::move(p), data, n);
+}
+
+// --------------------------------------------------------------------------
+
+result<size_t> write_queue::flush() {
+    size_t nsent = 0;
+
+    while (!segs_.empty()) {
+        size_t budget = pacer_ ? pacer_->allow(size_) : size_;
+        if (budget == 0)
+            break;
+
+        iovec iov[MAX_FLUSH_IOV];
+        size_t niov = 0;
+
+        while (niov < segs_.size() && niov < MAX_FLUSH_IOV && budget > 0) {
+            auto len = std::min(segs_[niov].len, budget);
+            iov[niov] = iovec{const_cast<char*>(segs_[niov].data), len};
+            budget -= len;
+            ++niov;
+        }
+
+        auto res = sock_.write(iov, niov);
+        if (!res) {
+            if (res == errc::interrupted)
+                continue;
+            if (res.is_would_block())
+                break;
+            update_pause();
+            return res.error();
+        }
+
+        auto n = res.value();
+        if (pacer_)
+            pacer_->consume(n);
+        nsent += n;
+        size_ -= n;
+
+        while (n > 0) {
+            auto& seg = segs_.front();
+            if (n < seg.len) {
+                seg.data += n;
+                seg.len -= n;
+                break;
+            }
+            n -= seg.len;
+            segs_.pop_front();
+        }
+    }
+
+    update_pause();
+    return nsent;
+}
+
+void write_queue::clear() {
+    segs_.clear();
+    size_ = 0;
+    update_pause();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+}  // namespace sockpp
@@ -0,0 +1,69 @@
+// tcp_pair.h
+//
+// A connected pair of TCP sockets for the unit tests.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#ifndef __tcp_pair_h
+#define __tcp_pair_h
+
+#include <tuple>
+
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+/**
+ * A connected pair of TCP sockets on localhost.
+ * The acceptor is kept, so more connections can be made to it.
+ */
+struct tcp_pair
+{
+    sockpp::tcp_acceptor acc{sockpp::inet_address("localhost", 0)};
+    sockpp::tcp_connector cli{acc.address()};
+    sockpp::tcp_socket srv{acc.accept().release()};
+};
+
+/**
+ * Creates a connected pair of TCP sockets on localhost.
+ * @return The client and server sockets, in that order.
+ */
+inline std::tuple<sockpp::tcp_socket, sockpp::tcp_socket> make_tcp_pair() {
+    tcp_pair p;
+    return std::make_tuple(sockpp::tcp_socket{p.cli.release()}, std::move(p.srv));
+}
+
+#endif  // __tcp_pair_h
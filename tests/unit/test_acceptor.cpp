@@ -43,6 +43,12 @@
 #include "catch2_version.h"
 #include "sockpp/acceptor.h"
 #include "sockpp/inet_address.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+#endif
 
 using namespace std;
 using namespace sockpp;
@@ -126,6 +132,17 @@ TEST_CASE("acceptor create", "[acceptor]") {
 #endif
     }
 
+    SECTION("flags") {
+        auto res = acceptor::create(AF_INET, acceptor::NON_BLOCKING | acceptor::CLOSE_ON_EXEC);
+        REQUIRE(res);
+        auto sock = res.release();
+
+        REQUIRE(sock.is_non_blocking());
+#if !defined(_WIN32)
+        REQUIRE((::fcntl(sock.handle(), F_GETFD) & FD_CLOEXEC) != 0);
+#endif
+    }
+
     SECTION("invalid domain") {
         auto res = acceptor::create(AF_UNSPEC);
         REQUIRE(!res);
@@ -138,3 +155,140 @@ TEST_CASE("acceptor create", "[acceptor]") {
 #endif
     }
 }
+
+TEST_CASE("acceptor accept flags", "[acceptor]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector conn{acc.address()};
+
+    SECTION("default") {
+        auto res = acc.accept();
+        REQUIRE(res);
+        REQUIRE(!res.value().is_non_blocking());
+    }
+
+    SECTION("non-blocking") {
+        inet_address peer;
+        auto res = acc.accept(&peer, acceptor::NON_BLOCKING | acceptor::CLOSE_ON_EXEC);
+        REQUIRE(res);
+
+        auto sock = res.release();
+        REQUIRE(sock.is_non_blocking());
+        REQUIRE(peer == conn.address());
+
+#if !defined(_WIN32)
+        REQUIRE((::fcntl(sock.handle(), F_GETFD) & FD_CLOEXEC) != 0);
+#endif
+    }
+}
+
+TEST_CASE("acceptor accept_many", "[acceptor]") {
+    constexpr size_t N = 5;
+
+    tcp_acceptor acc{inet_address{"localhost", 0}, 16};
+    REQUIRE(acc.set_non_blocking());
+
+    std::vector<std::pair<tcp_socket, inet_address>> conns;
+
+    SECTION("empty queue") {
+        auto res = acc.accept_many(conns);
+        REQUIRE(res);
+        REQUIRE(res.value() == 0);
+        REQUIRE(conns.empty());
+    }
+
+    SECTION("drain") {
+        std::vector<tcp_connector> clients;
+        for (size_t i = 0; i < N; ++i) clients.emplace_back(acc.address());
+
+        auto res = acc.accept_many(conns, N + 10, acceptor::NON_BLOCKING);
+        REQUIRE(res);
+        REQUIRE(res.value() == N);
+        REQUIRE(conns.size() == N);
+
+        for (auto& [sock, peer] : conns) {
+            REQUIRE(sock.is_non_blocking());
+            REQUIRE(peer.port() != 0);
+        }
+    }
+
+    SECTION("limit") {
+        std::vector<tcp_connector> clients;
+        for (size_t i = 0; i < N; ++i) clients.emplace_back(acc.address());
+
+        REQUIRE(acc.accept_many(conns, 2).value() == 2);
+        REQUIRE(acc.accept_many(conns).value() == N - 2);
+        REQUIRE(conns.size() == N);
+    }
+}
+
+TEST_CASE("acceptor caches peer address", "[acceptor]") {
+    cached_tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector conn{acc.address()};
+
+    SECTION("with address") {
+        inet_address peer;
+        auto res = acc.accept(&peer);
+        REQUIRE(res);
+
+        auto sock = res.release();
+        REQUIRE(sock.has_cached_peer_address());
+        REQUIRE(sock.peer_address() == peer);
+        REQUIRE(sock.peer_address() == conn.address());
+
+        cached_tcp_socket moved{std::move(sock)};
+        REQUIRE(moved.has_cached_peer_address());
+        REQUIRE(moved.peer_address() == peer);
+        REQUIRE(!sock.has_cached_peer_address());
+    }
+
+    SECTION("without address") {
+        auto sock = acc.accept().release();
+        REQUIRE(!sock.has_cached_peer_address());
+        REQUIRE(sock.peer_address() == conn.address());
+
+        REQUIRE(sock.cache_peer_address());
+        REQUIRE(sock.has_cached_peer_address());
+        REQUIRE(sock.peer_address() == conn.address());
+    }
+
+    SECTION("not cached by default") {
+        tcp_acceptor acc2{inet_address{"localhost", 0}};
+        tcp_connector conn2{acc2.address()};
+
+        inet_address peer;
+        auto sock = acc2.accept(&peer).release();
+        REQUIRE(!sock.has_cached_peer_address());
+        REQUIRE(sock.peer_address() == peer);
+
+        // The cache costs nothing unless it's asked for
+        REQUIRE(sizeof(tcp_socket) == sizeof(stream_socket));
+        REQUIRE(sizeof(cached_tcp_socket) > sizeof(tcp_socket));
+    }
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("acceptor tcp options", "[acceptor]") {
+    tcp_acceptor acc;
+    REQUIRE(acc.open(inet_address{"localhost", 0}, 4, tcp_acceptor::REUSE));
+
+#if defined(TCP_FASTOPEN)
+    REQUIRE(acc.fastopen(16));
+#else
+    REQUIRE(acc.fastopen(16) == errc::operation_not_supported);
+#endif
+
+    tcp_profile prof;
+    prof.nodelay = true;
+    REQUIRE(acc.apply(prof));
+
+#if defined(__linux__)
+    // Linux passes the listener's options on to the accepted sockets
+    tcp_connector conn{acc.address()};
+    REQUIRE(conn);
+
+    auto res = acc.accept();
+    REQUIRE(res);
+    REQUIRE(res.value().nodelay().value());
+#endif
+}
@@ -0,0 +1,135 @@
+// test_acceptor_group.cpp
+//
+// Unit tests for the sockpp acceptor_group class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/acceptor_group.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+using namespace std::chrono;
+
+namespace {
+
+// Accepts connections from all the acceptors in the group until 'n' have
+// arrived or a second goes by. Returns the number accepted.
+size_t accept_all(tcp_acceptor_group& grp, size_t n) {
+    size_t nacc = 0;
+    auto deadline = steady_clock::now() + seconds(1);
+
+    while (nacc < n && steady_clock::now() < deadline) {
+        for (auto& acc : grp) {
+            while (acc.accept()) ++nacc;
+        }
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return nacc;
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("acceptor_group default", "[acceptor_group]") {
+    tcp_acceptor_group grp;
+    REQUIRE(!grp.is_open());
+    REQUIRE(grp.empty());
+    REQUIRE(tcp_acceptor_group::default_size() >= 1);
+}
+
+TEST_CASE("acceptor_group open", "[acceptor_group]") {
+    constexpr size_t N = 4;
+    tcp_acceptor_group grp{inet_address{"localhost", 0}, N, 32};
+
+    REQUIRE(grp.is_open());
+    REQUIRE(grp.size() == N);
+
+    auto addr = grp.address();
+    REQUIRE(addr.port() != 0);
+
+    for (const auto& acc : grp) REQUIRE(acc.address() == addr);
+
+    SECTION("connections") {
+        REQUIRE(grp.set_non_blocking());
+
+        constexpr size_t N_CONN = 16;
+        std::vector<tcp_connector> conns;
+        for (size_t i = 0; i < N_CONN; ++i) conns.emplace_back(addr);
+
+        REQUIRE(accept_all(grp, N_CONN) == N_CONN);
+    }
+
+    SECTION("close") {
+        grp.close();
+        REQUIRE(!grp.is_open());
+    }
+}
+
+TEST_CASE("acceptor_group errors", "[acceptor_group]") {
+    error_code ec;
+
+    tcp_acceptor_group grp{inet_address{"localhost", 0}, 0, 4, false, ec};
+    REQUIRE(ec == errc::invalid_argument);
+    REQUIRE(!grp.is_open());
+
+    // A plain listener without SO_REUSEPORT blocks the port for a group.
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_acceptor_group grp2{acc.address(), 2, 4, false, ec};
+    REQUIRE(ec);
+    REQUIRE(!grp2.is_open());
+}
+
+#if defined(__linux__)
+TEST_CASE("acceptor_group cpu steering", "[acceptor_group]") {
+    constexpr size_t N = 2;
+    error_code ec;
+    tcp_acceptor_group grp{inet_address{"localhost", 0}, N, 4, true, ec};
+
+    REQUIRE(!ec);
+    REQUIRE(grp.size() == N);
+    REQUIRE(grp.set_non_blocking());
+
+    tcp_connector conn{grp.address()};
+    REQUIRE(accept_all(grp, 1) == 1);
+}
+#endif
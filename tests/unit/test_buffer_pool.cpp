@@ -0,0 +1,175 @@
+// test_buffer_pool.cpp
+//
+// Unit tests for the sockpp buffer_pool class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/buffer_pool.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("buffer_pool get/release", "[buffer_pool]") {
+    buffer_pool pool{1024, 8};
+    REQUIRE(pool.chunk_size() == 1024);
+    REQUIRE(pool.capacity() == 0);
+
+    auto buf = pool.get();
+    REQUIRE(buf);
+    REQUIRE(buf.data() != nullptr);
+    REQUIRE(buf.capacity() == 1024);
+    REQUIRE(buf.empty());
+    REQUIRE(pool.capacity() == 8);
+
+    buf.resize(100);
+    REQUIRE(buf.size() == 100);
+
+    buf.resize(5000);
+    REQUIRE(buf.size() == 1024);
+
+    buf.reset();
+    REQUIRE(!buf);
+    REQUIRE(buf.capacity() == 0);
+}
+
+TEST_CASE("buffer_pool reuse", "[buffer_pool]") {
+    buffer_pool pool{256, 4};
+
+    std::set<uint8_t*> addrs;
+    for (int i = 0; i < 100; ++i) {
+        auto buf = pool.get();
+        addrs.insert(buf.data());
+    }
+
+    // Buffers returned to the pool are handed out again
+    REQUIRE(pool.capacity() == 4);
+    REQUIRE(addrs.size() <= 4);
+
+    SECTION("growth") {
+        std::vector<pooled_buffer> bufs;
+        for (int i = 0; i < 10; ++i) bufs.push_back(pool.get());
+
+        REQUIRE(pool.capacity() == 12);
+
+        std::set<uint8_t*> uniq;
+        for (auto& b : bufs) uniq.insert(b.data());
+        REQUIRE(uniq.size() == 10);
+    }
+}
+
+TEST_CASE("pooled_buffer move", "[buffer_pool]") {
+    buffer_pool pool{64, 2};
+
+    auto buf = pool.get();
+    auto p = buf.data();
+    buf.resize(10);
+
+    pooled_buffer buf2{std::move(buf)};
+    REQUIRE(!buf);
+    REQUIRE(buf2.data() == p);
+    REQUIRE(buf2.size() == 10);
+
+    buf = std::move(buf2);
+    REQUIRE(buf.data() == p);
+    REQUIRE(!buf2);
+}
+
+TEST_CASE("buffer_pool threads", "[buffer_pool]") {
+    constexpr size_t N_THR = 4, N_ITER = 1000;
+    buffer_pool pool{128, 16};
+
+    std::vector<int> ok(N_THR, 1);
+    std::vector<std::thread> thrs;
+
+    for (size_t i = 0; i < N_THR; ++i) {
+        thrs.emplace_back([&pool, &ok, i] {
+            std::vector<pooled_buffer> held;
+            for (size_t j = 0; j < N_ITER; ++j) {
+                auto buf = pool.get();
+                std::memset(buf.data(), int(i), buf.capacity());
+                held.push_back(std::move(buf));
+
+                if (held.size() == 40) {
+                    for (auto& b : held) {
+                        for (size_t k = 0; k < b.capacity(); ++k)
+                            if (b.data()[k] != uint8_t(i))
+                                ok[i] = 0;
+                    }
+                    held.clear();
+                }
+            }
+        });
+    }
+
+    for (auto& thr : thrs) thr.join();
+
+    for (size_t i = 0; i < N_THR; ++i) REQUIRE(ok[i]);
+}
+
+TEST_CASE("stream_socket read into pool", "[buffer_pool]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector conn{acc.address()};
+    auto ssock = acc.accept().release();
+
+    buffer_pool pool{64, 4};
+    const std::string STR{"This is a test"};
+
+    REQUIRE(conn.write(STR));
+
+    auto res = ssock.read(pool);
+    REQUIRE(res);
+
+    auto buf = res.release();
+    REQUIRE(buf.size() == STR.size());
+    REQUIRE(std::string(reinterpret_cast<char*>(buf.data()), buf.size()) == STR);
+
+    conn.close();
+    res = ssock.read(pool);
+    REQUIRE(res);
+    REQUIRE(res.value().empty());
+    REQUIRE(!res.value());
+}
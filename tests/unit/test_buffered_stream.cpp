@@ -0,0 +1,192 @@
+// test_buffered_stream.cpp
+//
+// Unit tests for the sockpp buffered_stream class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/buffered_stream.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "tcp_pair.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("buffered_stream lines", "[buffered_stream]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    buffered_stream strm{p.srv, 8};
+    REQUIRE(strm.capacity() == 8);
+
+    SECTION("read_line") {
+        REQUIRE(p.cli.write(string{"one\r\ntwo\nthree is longer\n"}));
+
+        REQUIRE(strm.read_line().value() == "one");
+        REQUIRE(strm.read_line().value() == "two");
+
+        // Needs the buffer to grow
+        REQUIRE(strm.read_line().value() == "three is longer");
+        REQUIRE(strm.capacity() > 8);
+        REQUIRE(strm.available() == 0);
+    }
+
+    SECTION("read_until split delimiter") {
+        REQUIRE(p.cli.write(string{"abc|"}));
+        REQUIRE(p.cli.write(string{"|def||"}));
+
+        REQUIRE(strm.read_until("||").value() == "abc");
+        REQUIRE(strm.read_until("||").value() == "def");
+        REQUIRE(strm.read_until("") == errc::invalid_argument);
+    }
+
+    SECTION("read_exact") {
+        REQUIRE(p.cli.write(string{"0123456789ABCDEF"}));
+
+        REQUIRE(strm.read_exact(3).value() == "012");
+        REQUIRE(strm.read_exact(10).value() == "3456789ABC");
+        REQUIRE(strm.read_exact(0).value().empty());
+
+        char buf[16];
+        auto res = strm.read(buf, sizeof(buf));
+        REQUIRE(res);
+        REQUIRE(string(buf, res.value()) == string("DEF").substr(0, res.value()));
+    }
+
+    SECTION("eof") {
+        REQUIRE(p.cli.write(string{"last"}));
+        p.cli.close();
+
+        // The connection closed in the middle of a line
+        REQUIRE(strm.read_line() == errc::connection_reset);
+        REQUIRE(strm.eof());
+        REQUIRE(strm.buffered() == "last");
+        REQUIRE(strm.read_exact(4).value() == "last");
+
+        REQUIRE(strm.read_line() == errc::not_connected);
+    }
+}
+
+TEST_CASE("buffered_stream frames", "[buffered_stream]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    buffered_stream strm{p.srv, 16, 64};
+
+    SECTION("16-bit big-endian") {
+        REQUIRE(p.cli.write(string{"\x00\x05hello\x00\x00\x00\x03"
+                                   "abc",
+                                   14}));
+
+        REQUIRE(strm.read_frame16().value() == "hello");
+        REQUIRE(strm.read_frame16().value().empty());
+        REQUIRE(strm.read_frame16().value() == "abc");
+    }
+
+    SECTION("32-bit little-endian") {
+        REQUIRE(p.cli.write(string{"\x04\x00\x00\x00wxyz", 8}));
+        REQUIRE(strm.read_frame32(buffered_stream::endian::little).value() == "wxyz");
+    }
+
+    SECTION("too big") {
+        REQUIRE(p.cli.write(string{"\x01\x00", 2}));
+        REQUIRE(strm.read_frame16() == errc::message_size);
+    }
+
+    SECTION("would block") {
+        REQUIRE(p.srv.set_non_blocking());
+        REQUIRE(p.cli.write(string{"\x00\x04"
+                                   "ab",
+                                   4}));
+
+        // Wait for the partial frame to arrive
+        for (int i = 0; i < 100 && strm.available() < 4; ++i) {
+            auto res = strm.read_frame16();
+            REQUIRE(!res);
+            this_thread::sleep_for(milliseconds{1});
+        }
+        REQUIRE(strm.available() == 4);
+
+        REQUIRE(p.cli.write(string{"cd"}));
+        result<std::string_view> res;
+        for (int i = 0; i < 100; ++i) {
+            if ((res = strm.read_frame16()))
+                break;
+            this_thread::sleep_for(milliseconds{1});
+        }
+        REQUIRE(res.value() == "abcd");
+    }
+
+    SECTION("frame lowat") {
+        REQUIRE(p.srv.set_non_blocking());
+        strm.frame_lowat(true);
+        REQUIRE(strm.frame_lowat());
+
+        // A whole frame doesn't touch the low-water mark
+        REQUIRE(p.cli.write(string{"\x00\x02xy", 4}));
+        result<std::string_view> res;
+        for (int i = 0; i < 100 && !(res = strm.read_frame16()); ++i)
+            this_thread::sleep_for(milliseconds{1});
+        REQUIRE(res.value() == "xy");
+        REQUIRE(p.srv.recv_lowat().value() == 1);
+
+        REQUIRE(p.cli.write(string{"\x00\x28"
+                                   "0123456789",
+                                   12}));
+        for (int i = 0; i < 100 && strm.available() < 12; ++i) {
+            REQUIRE(!strm.read_frame16());
+            this_thread::sleep_for(milliseconds{1});
+        }
+        if (!strm.frame_lowat()) {
+            WARN("SO_RCVLOWAT not supported. Skipping.");
+            return;
+        }
+
+        // Waiting in the kernel for the other 30 bytes of the frame
+        REQUIRE(p.srv.recv_lowat().value() == 30);
+
+        REQUIRE(p.cli.write(string(30, 'z')));
+        for (int i = 0; i < 100 && !(res = strm.read_frame16()); ++i)
+            this_thread::sleep_for(milliseconds{1});
+        REQUIRE(res.value() == "0123456789" + string(30, 'z'));
+        REQUIRE(p.srv.recv_lowat().value() == 1);
+    }
+}
@@ -0,0 +1,111 @@
+// test_can_bcm_socket.cpp
+//
+// Unit tests for the BCM CAN socket class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/can_bcm_socket.h"
+#include "sockpp/can_socket.h"
+
+using namespace sockpp;
+using namespace std;
+using namespace std::chrono;
+
+// *** NOTE: These tests need the "vcan0:" virtual interface, and are
+//   skipped if it isn't present. Set it up:
+//   $ ip link add type vcan && ip link set up vcan0
+
+static const string IFACE{"vcan0"};
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("can_bcm_socket", "[can]") {
+    auto addrRes = can_address::create(IFACE);
+    if (!addrRes) {
+        WARN("No " << IFACE << " interface. Skipping.");
+        return;
+    }
+    auto addr = addrRes.release();
+
+    can_bcm_socket bcm{addr};
+    REQUIRE(bcm);
+
+    SECTION("cyclic tx") {
+        can_socket rcvr{addr};
+        REQUIRE(rcvr.set_option(SOL_SOCKET, SO_RCVTIMEO, to_timeval(seconds{1})));
+
+        // The kernel sends the frame three times, 10ms apart
+        sockpp::can_frame frame{0x321, "cyclic"};
+        REQUIRE(bcm.tx_setup(&frame, 1, milliseconds{10}, 0, microseconds{0}, 0));
+
+        for (int i = 0; i < 3; ++i) {
+            sockpp::can_frame in;
+            REQUIRE(rcvr.recv(&in) == sizeof(::can_frame));
+            REQUIRE(in.can_id == 0x321);
+            REQUIRE(string((const char*)in.data, in.can_dlc) == "cyclic");
+        }
+
+        REQUIRE(bcm.tx_delete(0x321));
+        REQUIRE(bcm.tx_delete(0x321) == errc::invalid_argument);
+    }
+
+    SECTION("rx changed") {
+        can_socket sender{addr};
+        REQUIRE(bcm.set_option(SOL_SOCKET, SO_RCVTIMEO, to_timeval(seconds{1})));
+        REQUIRE(bcm.rx_filter_id(0x123));
+
+        REQUIRE(sender.send(sockpp::can_frame{0x123, "first"}));
+        REQUIRE(sender.send(sockpp::can_frame{0x123, "first"}));
+        REQUIRE(sender.send(sockpp::can_frame{0x123, "second"}));
+
+        // The duplicate frame is filtered out in the kernel
+        bcm_msg_head head;
+        sockpp::can_frame in;
+
+        REQUIRE(bcm.recv(head, &in, 1) == size_t(1));
+        REQUIRE(head.opcode == RX_CHANGED);
+        REQUIRE(string((const char*)in.data, in.can_dlc) == "first");
+
+        REQUIRE(bcm.recv(head, &in, 1) == size_t(1));
+        REQUIRE(string((const char*)in.data, in.can_dlc) == "second");
+
+        REQUIRE(bcm.rx_delete(0x123));
+    }
+}
@@ -0,0 +1,146 @@
+// test_can_filter_set.cpp
+//
+// Unit tests for the can_filter_set class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2_version.h"
+#include "sockpp/can_filter_set.h"
+
+using namespace sockpp;
+using namespace std;
+
+// Determines if any of the filters accepts the ID, the way the kernel
+// does it.
+static bool accepts(const vector<can_filter>& filters, canid_t id) {
+    for (const auto& f : filters) {
+        if ((id & f.can_mask) == (f.can_id & f.can_mask))
+            return true;
+    }
+    return false;
+}
+
+// Checks that the filters accept exactly the standard ID's in the set.
+static bool exact_sff(const can_filter_set& ids, const vector<can_filter>& filters) {
+    for (canid_t id = 0; id <= CAN_SFF_MASK; ++id) {
+        if (accepts(filters, id) != ids.contains(id))
+            return false;
+        // Extended frames with the same bits are never accepted
+        if (!ids.contains(id | CAN_EFF_FLAG) && accepts(filters, id | CAN_EFF_FLAG))
+            return false;
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("can_filter_set", "[can]") {
+    SECTION("empty") {
+        can_filter_set ids;
+        REQUIRE(ids.empty());
+        REQUIRE(ids.compile().empty());
+    }
+
+    SECTION("single") {
+        can_filter_set ids{0x123};
+        REQUIRE(!ids.empty());
+        REQUIRE(ids.contains(0x123));
+        REQUIRE(!ids.contains(0x124));
+
+        auto filters = ids.compile();
+        REQUIRE(filters.size() == 1);
+        REQUIRE(filters[0].can_id == 0x123);
+        REQUIRE(filters[0].can_mask == (CAN_SFF_MASK | CAN_EFF_FLAG));
+    }
+
+    SECTION("aligned range") {
+        can_filter_set ids;
+        ids.add(0x100, 0x1FF);
+
+        auto filters = ids.compile();
+        REQUIRE(filters.size() == 1);
+        REQUIRE(exact_sff(ids, filters));
+    }
+
+    SECTION("unaligned range") {
+        can_filter_set ids;
+        ids.add(0x101, 0x2FE);
+
+        auto filters = ids.compile();
+        REQUIRE(filters.size() < 20);
+        REQUIRE(exact_sff(ids, filters));
+    }
+
+    SECTION("scattered") {
+        // Every even ID from 0x200-0x2FF, plus some odd ones
+        can_filter_set ids;
+        for (canid_t id = 0x200; id < 0x300; id += 2) ids.add(id);
+        ids.add(0x011).add(0x013).add(0x7FF);
+
+        auto filters = ids.compile();
+        REQUIRE(filters.size() == 3);
+        REQUIRE(exact_sff(ids, filters));
+    }
+
+    SECTION("everything") {
+        can_filter_set ids;
+        ids.add(0, CAN_SFF_MASK);
+
+        auto filters = ids.compile();
+        REQUIRE(filters.size() == 1);
+        REQUIRE(filters[0].can_mask == CAN_EFF_FLAG);
+        REQUIRE(exact_sff(ids, filters));
+    }
+
+    SECTION("extended") {
+        can_filter_set ids;
+        ids.add(0x18FF0000 | CAN_EFF_FLAG, 0x18FFFFFF | CAN_EFF_FLAG);
+        ids.add(0x123);
+
+        auto filters = ids.compile();
+        REQUIRE(filters.size() == 2);
+
+        REQUIRE(accepts(filters, 0x18FF1234 | CAN_EFF_FLAG));
+        REQUIRE(!accepts(filters, 0x18FE1234 | CAN_EFF_FLAG));
+        REQUIRE(!accepts(filters, 0x1234));
+        REQUIRE(accepts(filters, 0x123));
+        REQUIRE(!accepts(filters, 0x123 | CAN_EFF_FLAG));
+
+        // RTR frames are accepted as well
+        REQUIRE(accepts(filters, 0x123 | CAN_RTR_FLAG));
+    }
+}
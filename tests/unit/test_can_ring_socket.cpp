@@ -0,0 +1,107 @@
+// test_can_ring_socket.cpp
+//
+// Unit tests for the can_ring_socket class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/can_ring_socket.h"
+#include "sockpp/can_socket.h"
+
+using namespace sockpp;
+using namespace std;
+
+// *** NOTE: These tests need the "vcan0:" virtual interface, and are
+//   skipped if it isn't present. Set it up:
+//   $ ip link add type vcan && ip link set up vcan0
+//   The ring also needs the CAP_NET_RAW capability.
+
+static const string IFACE{"vcan0"};
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("can_ring_socket", "[can]") {
+    SECTION("bad block size") {
+        can_ring_socket ring;
+        REQUIRE(ring.open(can_address{}, 1000) == errc::invalid_argument);
+        REQUIRE(!ring);
+    }
+
+    auto addrRes = can_address::create(IFACE);
+    if (!addrRes) {
+        WARN("No " << IFACE << " interface. Skipping.");
+        return;
+    }
+    auto addr = addrRes.release();
+
+    error_code ec;
+    can_ring_socket ring{addr, ec};
+    if (ec == errc::operation_not_permitted) {
+        WARN("No permission for a packet socket. Skipping.");
+        return;
+    }
+    REQUIRE(!ec);
+
+    can_socket sender{addr};
+    sockpp::can_frame out[3]{{0x101, "one"}, {0x102, "two"}, {0x103, "three"}};
+    REQUIRE(sender.send_many(out, 3) == size_t(3));
+
+    size_t n = 0;
+    bool ok = true;
+
+    while (n < 3) {
+        auto res = ring.read(
+            [&](const sockpp::canfd_frame& frame, nanoseconds ts) {
+                ok = ok && n < 3 && frame.can_id == out[n].can_id && !frame.is_fd() &&
+                     frame.len == out[n].can_dlc && ts.count() != 0;
+                ++n;
+            },
+            milliseconds{1000}
+        );
+        REQUIRE(res);
+        REQUIRE(res.value() != 0);
+    }
+
+    REQUIRE(ok);
+    REQUIRE(n == 3);
+
+    auto st = ring.stats();
+    REQUIRE(st);
+    REQUIRE(st.value().tp_drops == 0);
+}
@@ -0,0 +1,149 @@
+// test_can_socket.cpp
+//
+// Unit tests for the CAN frame and socket classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/can_socket.h"
+
+using namespace sockpp;
+using namespace std;
+
+// The frame classes have the same names as the C structs that they wrap,
+// so they need to be qualified here.
+
+// *** NOTE: The socket tests need the "vcan0:" virtual interface, and are
+//   skipped if it isn't present. Set it up:
+//   $ ip link add type vcan && ip link set up vcan0
+
+static const string IFACE{"vcan0"};
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("canfd_frame", "[can]") {
+    SECTION("default") {
+        sockpp::canfd_frame frame;
+        REQUIRE(!frame.is_fd());
+        REQUIRE(frame.mtu() == sizeof(::can_frame));
+    }
+
+    SECTION("data") {
+        const string DATA(48, 'x');
+        sockpp::canfd_frame frame{0x123, DATA, CANFD_BRS};
+
+        REQUIRE(frame.is_fd());
+        REQUIRE(frame.mtu() == sizeof(::canfd_frame));
+        REQUIRE(frame.can_id == 0x123);
+        REQUIRE(frame.len == 48);
+        REQUIRE((frame.flags & CANFD_BRS) != 0);
+        REQUIRE(string((const char*)frame.data, frame.len) == DATA);
+    }
+
+    SECTION("too long") {
+        const string DATA(100, 'x');
+        sockpp::canfd_frame frame{0x123, DATA};
+        REQUIRE(frame.len == CANFD_MAX_DLEN);
+    }
+
+    SECTION("classic") {
+        sockpp::canfd_frame frame{sockpp::can_frame{0x42, "hello"}};
+
+        REQUIRE(!frame.is_fd());
+        REQUIRE(frame.can_id == 0x42);
+        REQUIRE(frame.len == 5);
+        REQUIRE(string((const char*)frame.data, frame.len) == "hello");
+    }
+}
+
+TEST_CASE("can_socket batched I/O", "[can]") {
+    auto addrRes = can_address::create(IFACE);
+    if (!addrRes) {
+        WARN("No " << IFACE << " interface. Skipping.");
+        return;
+    }
+    auto addr = addrRes.release();
+
+    can_socket sender{addr}, rcvr{addr};
+    REQUIRE(rcvr.enable_timestamps());
+
+    sockpp::can_frame out[3]{{0x101, "one"}, {0x102, "two"}, {0x103, "three"}};
+    REQUIRE(sender.send_many(out, 3) == size_t(3));
+
+    sockpp::can_frame in[8];
+    can_socket::packet_timestamp ts[8];
+    size_t n = 0;
+    while (n < 3) {
+        auto res = rcvr.recv_many(in + n, 8 - n, ts + n);
+        REQUIRE(res);
+        n += res.value();
+    }
+
+    REQUIRE(n == 3);
+    for (size_t i = 0; i < n; ++i) {
+        REQUIRE(in[i].can_id == out[i].can_id);
+        REQUIRE(in[i].can_dlc == out[i].can_dlc);
+        REQUIRE(ts[i].has_software());
+    }
+
+    SECTION("fd") {
+        if (!sender.fd_frames(true) || !rcvr.fd_frames(true)) {
+            WARN("No FD support on " << IFACE << ". Skipping.");
+            return;
+        }
+        REQUIRE(rcvr.fd_frames().value());
+
+        sockpp::canfd_frame fdOut[2]{
+            {0x201, string(32, 'a')}, sockpp::can_frame{0x202, "classic"}
+        };
+        REQUIRE(sender.send_many(fdOut, 2) == size_t(2));
+
+        sockpp::canfd_frame fdIn[2];
+        n = 0;
+        while (n < 2) {
+            auto res = rcvr.recv_many(fdIn + n, 2 - n);
+            REQUIRE(res);
+            n += res.value();
+        }
+        REQUIRE(fdIn[0].is_fd());
+        REQUIRE(fdIn[0].len == 32);
+        REQUIRE(!fdIn[1].is_fd());
+        REQUIRE(fdIn[1].len == 7);
+    }
+}
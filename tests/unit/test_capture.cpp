@@ -0,0 +1,332 @@
+// test_capture.cpp
+//
+// Unit tests for the sockpp packet capture classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/capture.h"
+#include "sockpp/udp_socket.h"
+#include "sockpp/unix_dgram_socket.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace sockpp;
+
+namespace {
+
+// A capture file that's removed at the end of the test
+struct temp_file
+{
+    string path;
+
+    temp_file() {
+        char tmpl[] = "/tmp/sockpp_capture_XXXXXX";
+        int fd = ::mkstemp(tmpl);
+        ::close(fd);
+        path = tmpl;
+    }
+    ~temp_file() { ::unlink(path.c_str()); }
+};
+
+// Reads the whole file
+string slurp(const string& path) {
+    string s;
+    FILE* fp = ::fopen(path.c_str(), "rb");
+    char buf[4096];
+    size_t n;
+    while ((n = ::fread(buf, 1, sizeof(buf), fp)) > 0) s.append(buf, n);
+    ::fclose(fp);
+    return s;
+}
+
+// Writes a capture of n packets, the first at time t0, then one every gap
+void make_capture(
+    const string& path, size_t n, nanoseconds t0 = seconds{1000}, nanoseconds gap = milliseconds{1}
+) {
+    capture_writer cap{path, capture_link::payload};
+    for (size_t i = 0; i < n; ++i) {
+        auto s = "packet " + to_string(i);
+        cap.write(s.data(), s.size(), t0 + gap * i);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("capture round trip", "[capture]") {
+    temp_file tmp;
+    const auto T0 = seconds{1700000000} + nanoseconds{123456789};
+
+    {
+        capture_writer cap{tmp.path, capture_link::payload, 8};
+        REQUIRE(cap.is_open());
+        REQUIRE(cap.link() == capture_link::payload);
+
+        REQUIRE(cap.write("hello", 5, T0));
+        REQUIRE(cap.write("a longer packet", 15, T0 + microseconds{1}));
+        REQUIRE(cap.write("", 0, T0 + milliseconds{1}));
+
+        socket::packet_timestamp ts;
+        ts.software = T0 + seconds{1};
+        REQUIRE(cap.write("ts", 2, ts));
+
+        REQUIRE(cap.count() == 4);
+        auto sz = cap.size();
+        REQUIRE(cap.close());
+        REQUIRE(!cap.is_open());
+
+        // The file is cut back to the data
+        REQUIRE(slurp(tmp.path).size() == sz);
+    }
+
+    capture_reader rdr{tmp.path};
+    REQUIRE(rdr.is_open());
+    REQUIRE(rdr.link() == capture_link::payload);
+
+    capture_record rec;
+    REQUIRE(rdr.next(rec).value());
+    REQUIRE(rec.time == T0);
+    REQUIRE(rec.data == "hello");
+    REQUIRE(rec.origLen == 5);
+    REQUIRE(rec.link == capture_link::payload);
+
+    // Truncated to the snapshot length
+    REQUIRE(rdr.next(rec).value());
+    REQUIRE(rec.time == T0 + microseconds{1});
+    REQUIRE(rec.data == "a longer");
+    REQUIRE(rec.origLen == 15);
+
+    REQUIRE(rdr.next(rec).value());
+    REQUIRE(rec.data.empty());
+
+    REQUIRE(rdr.next(rec).value());
+    REQUIRE(rec.time == T0 + seconds{1});
+    REQUIRE(rec.data == "ts");
+
+    REQUIRE(!rdr.next(rec).value());
+    REQUIRE(!rdr.next(rec).value());
+
+    rdr.rewind();
+    REQUIRE(rdr.next(rec).value());
+    REQUIRE(rec.data == "hello");
+}
+
+TEST_CASE("capture grows the file", "[capture]") {
+    temp_file tmp;
+    const size_t N = 10000;
+    const string PKT(100, 'x');
+
+    {
+        capture_writer cap{tmp.path, capture_link::payload, 1500, 64 * 1024};
+
+        vector<iovec> bufs(10, iovec{const_cast<char*>(PKT.data()), PKT.size()});
+        vector<size_t> lens(10, PKT.size());
+        for (size_t i = 0; i < N; i += 10)
+            REQUIRE(cap.write_many(bufs.data(), lens.data(), 10).value() == 10);
+        REQUIRE(cap.count() == N);
+        REQUIRE(cap.flush());
+    }
+
+    capture_reader rdr{tmp.path};
+    capture_record rec;
+    size_t n = 0;
+    while (rdr.next(rec).value()) {
+        REQUIRE(rec.data == PKT);
+        ++n;
+    }
+    REQUIRE(n == N);
+}
+
+TEST_CASE("capture socketcan byte order", "[capture]") {
+    temp_file tmp;
+
+    // A classic CAN frame: ID, length, padding, then 8 data bytes
+    char frame[16]{};
+    uint32_t id = 0x123;
+    memcpy(frame, &id, sizeof(id));
+    frame[4] = 2;
+    frame[8] = 'h';
+    frame[9] = 'i';
+
+    {
+        capture_writer cap{tmp.path, capture_link::socketcan};
+        REQUIRE(cap.write(frame, sizeof(frame)));
+    }
+
+    // The file has the ID in network byte order
+    auto file = slurp(tmp.path);
+    REQUIRE(file.size() == 28 + 32 + 32 + 16);
+    REQUIRE(file.substr(28 + 32 + 28, 4) == string("\x00\x00\x01\x23", 4));
+
+    capture_reader rdr{tmp.path};
+    REQUIRE(rdr.link() == capture_link::socketcan);
+
+    capture_record rec;
+    REQUIRE(rdr.next(rec).value());
+    REQUIRE(rec.data == string(frame, sizeof(frame)));
+}
+
+TEST_CASE("capture reads big-endian files", "[capture]") {
+    temp_file tmp;
+
+    // A section, an interface with the default microsecond resolution,
+    // and one packet, all in big-endian order.
+    const string DATA{
+        "\x0A\x0D\x0D\x0A\x00\x00\x00\x1C\x1A\x2B\x3C\x4D\x00\x01\x00\x00"
+        "\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x00\x00\x00\x1C"
+        "\x00\x00\x00\x01\x00\x00\x00\x14\x00\x65\x00\x00\x00\x00\xFF\xFF"
+        "\x00\x00\x00\x14"
+        "\x00\x00\x00\x06\x00\x00\x00\x24\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x00\x0F\x42\x40\x00\x00\x00\x03\x00\x00\x00\x03"
+        "abc\x00\x00\x00\x00\x24",
+        28 + 20 + 36
+    };
+
+    {
+        FILE* fp = ::fopen(tmp.path.c_str(), "wb");
+        ::fwrite(DATA.data(), 1, DATA.size(), fp);
+        ::fclose(fp);
+    }
+
+    capture_reader rdr{tmp.path};
+    REQUIRE(rdr.link() == capture_link::ip);
+
+    capture_record rec;
+    REQUIRE(rdr.next(rec).value());
+    REQUIRE(rec.link == capture_link::ip);
+    REQUIRE(rec.time == seconds{1});
+    REQUIRE(rec.data == "abc");
+    REQUIRE(!rdr.next(rec).value());
+}
+
+TEST_CASE("capture errors", "[capture]") {
+    temp_file tmp;
+
+    capture_reader rdr;
+    REQUIRE(!rdr.is_open());
+    REQUIRE(rdr.open("/tmp/sockpp_no_such_capture") == errc::no_such_file_or_directory);
+
+    {
+        FILE* fp = ::fopen(tmp.path.c_str(), "wb");
+        ::fputs("this is not a pcapng file at all", fp);
+        ::fclose(fp);
+    }
+    REQUIRE(rdr.open(tmp.path) == errc::bad_message);
+
+    error_code ec;
+    capture_writer cap{"/no/such/dir/capture.pcapng", capture_link::ip, ec};
+    REQUIRE(ec);
+    REQUIRE(!cap.is_open());
+    REQUIRE(cap.write("x", 1) == errc::bad_file_descriptor);
+}
+
+TEST_CASE("capture replay", "[capture]") {
+    temp_file tmp;
+    const size_t N = 5;
+
+    SECTION("udp as fast as possible") {
+        make_capture(tmp.path, N, seconds{1000}, seconds{10});
+
+        udp_socket srv{inet_address{"localhost", 0}};
+        udp_socket cli;
+        REQUIRE(cli.connect(srv.address()));
+
+        capture_reader rdr{tmp.path};
+        capture_replayer rep{rdr, 2};
+        rep.speed(0.0);
+
+        auto start = steady_clock::now();
+        REQUIRE(rep.run(cli).value() == N);
+        REQUIRE(steady_clock::now() - start < seconds{1});
+
+        char buf[64];
+        for (size_t i = 0; i < N; ++i) {
+            auto n = srv.recv(buf, sizeof(buf)).value();
+            REQUIRE(string(buf, n) == "packet " + to_string(i));
+        }
+    }
+
+    SECTION("original timing") {
+        make_capture(tmp.path, N, seconds{1000}, milliseconds{10});
+
+        capture_reader rdr{tmp.path};
+        capture_replayer rep{rdr};
+
+        vector<steady_clock::time_point> times;
+        auto sink = [&](const iovec*, size_t n) -> result<size_t> {
+            for (size_t i = 0; i < n; ++i) times.push_back(steady_clock::now());
+            return n;
+        };
+
+        REQUIRE(rep.run(sink).value() == N);
+        REQUIRE(times.size() == N);
+        REQUIRE(times.back() - times.front() >= milliseconds{38});
+
+        // Faster, with the gaps cut short
+        rdr.rewind();
+        times.clear();
+        rep.speed(2.0);
+        rep.max_gap(milliseconds{4});
+        REQUIRE(rep.run(sink).value() == N);
+        REQUIRE(times.back() - times.front() >= milliseconds{7});
+        REQUIRE(times.back() - times.front() < milliseconds{38});
+    }
+
+    SECTION("raw socket") {
+        make_capture(tmp.path, N);
+
+        auto [a, b] = unix_dgram_socket::pair().release();
+        raw_socket sock{a.release()};
+
+        capture_reader rdr{tmp.path};
+        capture_replayer rep{rdr, 3};
+        rep.speed(0.0);
+        REQUIRE(rep.run(sock).value() == N);
+
+        char buf[64];
+        for (size_t i = 0; i < N; ++i) {
+            auto n = b.recv(buf, sizeof(buf)).value();
+            REQUIRE(string(buf, n) == "packet " + to_string(i));
+        }
+    }
+}
@@ -0,0 +1,126 @@
+// test_close_queue.cpp
+//
+// Unit tests for the sockpp close_queue class.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/close_queue.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "tcp_pair.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace sockpp;
+
+namespace {
+
+// Determines if the peer of the client closed the connection
+bool peer_closed(tcp_connector& cli) {
+    char buf[16];
+    return cli.read(buf, sizeof(buf)).value() == 0;
+}
+
+}  // namespace
+
+TEST_CASE("close_queue flush", "[close_queue]") {
+    tcp_pair p1, p2;
+    REQUIRE(p1.srv);
+    REQUIRE(p2.srv);
+
+    close_queue q;
+    REQUIRE(!q.background());
+
+    q.defer(std::move(p1.srv));
+    q.defer(std::move(p2.srv));
+    q.defer(INVALID_SOCKET);
+
+    // The sockets gave up their handles to the queue
+    REQUIRE(!p1.srv.is_open());
+    REQUIRE(!p2.srv.is_open());
+    REQUIRE(q.pending() == 2);
+
+    REQUIRE(q.flush() == 2);
+    REQUIRE(q.pending() == 0);
+    REQUIRE(q.closed() == 2);
+
+    REQUIRE(peer_closed(p1.cli));
+    REQUIRE(peer_closed(p2.cli));
+
+    REQUIRE(q.flush() == 0);
+}
+
+TEST_CASE("close_queue take", "[close_queue]") {
+    tcp_pair p;
+    close_queue q;
+
+    q.defer(std::move(p.srv));
+    auto handles = q.take();
+    REQUIRE(handles.size() == 1);
+    REQUIRE(q.pending() == 0);
+
+    // Ownership went back to the caller
+    tcp_socket sock{handles[0]};
+    REQUIRE(sock.write(string{"hi"}).value() == 2);
+}
+
+TEST_CASE("close_queue destructor", "[close_queue]") {
+    tcp_pair p;
+    {
+        close_queue q;
+        q.defer(std::move(p.srv));
+    }
+    REQUIRE(peer_closed(p.cli));
+}
+
+TEST_CASE("close_queue background", "[close_queue]") {
+    tcp_pair p;
+    close_queue q{true};
+    REQUIRE(q.background());
+
+    q.defer(std::move(p.srv));
+    for (int i = 0; i < 1000 && q.closed() == 0; ++i) this_thread::sleep_for(milliseconds{1});
+
+    REQUIRE(q.closed() == 1);
+    REQUIRE(q.pending() == 0);
+    REQUIRE(peer_closed(p.cli));
+}
@@ -0,0 +1,172 @@
+// test_cmsg.cpp
+//
+// Unit tests for the ancillary data builder and reader.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/cmsg.h"
+#include "sockpp/udp_socket.h"
+#include "sockpp/unix_stream_socket.h"
+
+using namespace sockpp;
+
+TEST_CASE("cmsg_buffer add", "[cmsg]") {
+    cmsg_buffer<CMSG_SPACE(sizeof(int)) * 2> buf;
+    REQUIRE(buf.empty());
+    REQUIRE(buf.size() == 0);
+
+    REQUIRE(buf.add(SOL_SOCKET, SCM_RIGHTS, int(3)));
+    REQUIRE(buf.size() == CMSG_SPACE(sizeof(int)));
+
+    REQUIRE(buf.add(SOL_SOCKET, SCM_RIGHTS, int(4)));
+    REQUIRE(buf.size() == buf.capacity());
+
+    // Full
+    REQUIRE(!buf.add(SOL_SOCKET, SCM_RIGHTS, int(5)));
+
+    buf.clear();
+    REQUIRE(buf.empty());
+}
+
+TEST_CASE("cmsg_reader", "[cmsg]") {
+    cmsg_buffer<128> buf;
+    REQUIRE(buf.add(SOL_SOCKET, SCM_RIGHTS, int(42)));
+    REQUIRE(buf.add(IPPROTO_IP, 8, uint16_t(1500)));
+
+    msghdr msg{};
+    msg.msg_control = buf.data();
+    msg.msg_controllen = buf.size();
+
+    cmsg_reader rdr{msg};
+    REQUIRE(!rdr.truncated());
+
+    size_t n = 0;
+    for (auto cmsg = rdr.first(); cmsg; cmsg = rdr.next(cmsg)) ++n;
+    REQUIRE(n == 2);
+
+    int fd = 0;
+    REQUIRE(rdr.get(SOL_SOCKET, SCM_RIGHTS, fd));
+    REQUIRE(fd == 42);
+
+    uint16_t mtu = 0;
+    REQUIRE(rdr.get(IPPROTO_IP, 8, mtu));
+    REQUIRE(mtu == 1500);
+
+    // Payload too small for the type
+    uint64_t big = 0;
+    REQUIRE(!rdr.get(IPPROTO_IP, 8, big));
+
+    REQUIRE(rdr.find(SOL_SOCKET, 99) == nullptr);
+}
+
+TEST_CASE("cmsg_reader from buffer", "[cmsg]") {
+    cmsg_buffer<128> buf;
+    int fds[] = {3, 4};
+    REQUIRE(buf.add_fds(fds, 2));
+    REQUIRE(buf.size() == CMSG_SPACE(2 * sizeof(int)));
+
+    cmsg_reader rdr{buf};
+    REQUIRE(!rdr.truncated());
+
+    int got[2] = {0, 0};
+    REQUIRE(rdr.get_fds(got, 2) == 2);
+    REQUIRE(got[0] == 3);
+    REQUIRE(got[1] == 4);
+
+    buf.received(buf.size(), MSG_CTRUNC);
+    REQUIRE(cmsg_reader{buf}.truncated());
+}
+
+TEST_CASE("socket send_msg/recv_msg", "[cmsg]") {
+    auto res = unix_stream_socket::pair();
+    REQUIRE(res);
+    auto [sa, sb] = res.release();
+
+    // Pass one end of a fresh socket pair, along with some data
+    auto pres = unix_stream_socket::pair();
+    REQUIRE(pres);
+    auto [pa, pb] = pres.release();
+
+    const std::string MSG{"Here's a socket"};
+    iovec iov{const_cast<char*>(MSG.data()), MSG.size()};
+
+    cmsg_buffer<CMSG_SPACE(sizeof(int))> ctrl;
+    int fd = pb.handle();
+    REQUIRE(ctrl.add_fds(&fd, 1));
+    REQUIRE(sa.send_msg(&iov, 1, ctrl) == MSG.size());
+    pb.close();
+
+    char buf[64];
+    iovec riov{buf, sizeof(buf)};
+    cmsg_buffer<CMSG_SPACE(sizeof(int) * 4)> rctrl;
+
+    REQUIRE(sb.recv_msg(&riov, 1, rctrl) == MSG.size());
+    REQUIRE(std::string(buf, MSG.size()) == MSG);
+
+    int rfd = -1;
+    REQUIRE(cmsg_reader{rctrl}.get_fds(&rfd, 1) == 1);
+    REQUIRE(rfd >= 0);
+
+    // The received descriptor is the other end of the pair
+    unix_stream_socket passed{rfd};
+    REQUIRE(pa.write("ping") == size_t(4));
+    REQUIRE(passed.read(buf, sizeof(buf)) == size_t(4));
+}
+
+TEST_CASE("datagram_socket recv_msg with pktinfo", "[cmsg]") {
+    udp_socket srv{inet_address{"localhost", 0}}, cli{inet_address{"localhost", 0}};
+    REQUIRE(srv.set_option(IPPROTO_IP, IP_PKTINFO, 1));
+
+    const std::string MSG{"Who am I talking to?"};
+    iovec iov{const_cast<char*>(MSG.data()), MSG.size()};
+    REQUIRE(cli.send_msg_to(&iov, 1, cmsg_buffer<1>{}, srv.address()) == MSG.size());
+
+    char buf[64];
+    iovec riov{buf, sizeof(buf)};
+    cmsg_buffer<CMSG_SPACE(sizeof(in_pktinfo))> ctrl;
+    inet_address src;
+
+    REQUIRE(srv.recv_msg(&riov, 1, ctrl, &src) == MSG.size());
+    REQUIRE(src == cli.address());
+
+    in_pktinfo pi{};
+    REQUIRE(cmsg_reader{ctrl}.get(IPPROTO_IP, IP_PKTINFO, pi));
+    REQUIRE(pi.ipi_addr.s_addr == htonl(INADDR_LOOPBACK));
+}
@@ -0,0 +1,153 @@
+// test_connection_pool.cpp
+//
+// Unit tests for the sockpp connection_pool class.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/connection_pool.h"
+#include "sockpp/tcp_acceptor.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace sockpp;
+
+using pool_t = connection_pool<tcp_connector>;
+
+TEST_CASE("connection_pool reuse", "[connection_pool]") {
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    auto addr = acc.address();
+
+    pool_t pool;
+    REQUIRE(pool.live_count(addr) == 0);
+
+    in_port_t port = 0;
+    {
+        auto res = pool.acquire(addr);
+        REQUIRE(res);
+        auto conn = res.release();
+        REQUIRE(conn);
+        REQUIRE(conn->is_open());
+        REQUIRE(conn.address() == addr);
+        port = conn->address().port();
+        REQUIRE(pool.live_count(addr) == 1);
+        REQUIRE(pool.idle_count(addr) == 0);
+    }
+    REQUIRE(pool.idle_count(addr) == 1);
+
+    SECTION("same connection comes back") {
+        auto conn = pool.acquire(addr).release();
+        REQUIRE(conn->address().port() == port);
+        REQUIRE(pool.live_count(addr) == 1);
+    }
+
+    SECTION("discarded") {
+        auto conn = pool.acquire(addr).release();
+        conn.discard();
+        conn.release();
+        REQUIRE(!conn);
+        REQUIRE(pool.live_count(addr) == 0);
+    }
+
+    SECTION("dead connection is replaced") {
+        // Close the server side of the idle connection
+        acc.accept().release().close();
+
+        auto conn = pool.acquire(addr).release();
+        REQUIRE(conn);
+        REQUIRE(conn->address().port() != port);
+        REQUIRE(pool.live_count(addr) == 1);
+    }
+
+    SECTION("unexpected data") {
+        auto srv = acc.accept().release();
+        REQUIRE(srv.write(string{"stale"}));
+        this_thread::sleep_for(milliseconds{10});
+
+        auto conn = pool.acquire(addr).release();
+        REQUIRE(conn->address().port() != port);
+    }
+
+    SECTION("evict idle") {
+        REQUIRE(pool.evict_idle() == 0);
+        REQUIRE(pool.evict_idle(pool_t::clock::now() + hours{1}) == 1);
+        REQUIRE(pool.live_count(addr) == 0);
+        REQUIRE(pool.idle_count(addr) == 0);
+    }
+}
+
+TEST_CASE("connection_pool limits", "[connection_pool]") {
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    auto addr = acc.address();
+
+    pool_t::options opts;
+    opts.max_per_host = 3;
+    opts.max_idle_per_host = 2;
+    pool_t pool{opts};
+
+    SECTION("max per host") {
+        auto c1 = pool.acquire(addr).release();
+        auto c2 = pool.acquire(addr).release();
+        auto c3 = pool.acquire(addr).release();
+        REQUIRE(pool.acquire(addr) == errc::resource_unavailable_try_again);
+
+        c3.release();
+        c2.release();
+        c1.release();
+
+        // One too many to keep idle
+        REQUIRE(pool.idle_count(addr) == 2);
+        REQUIRE(pool.live_count(addr) == 2);
+    }
+
+    SECTION("prewarm") {
+        REQUIRE(pool.prewarm({addr}, 5) == 2);
+        REQUIRE(pool.idle_count(addr) == 2);
+        REQUIRE(pool.live_count(addr) == 2);
+    }
+
+    SECTION("connect failure") {
+        // Nothing listening here once the acceptor is closed
+        acc.close();
+        REQUIRE(!pool.acquire(addr));
+        REQUIRE(pool.live_count(addr) == 0);
+    }
+}
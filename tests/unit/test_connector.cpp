@@ -42,9 +42,28 @@
 
 #include "catch2_version.h"
 #include "sockpp/connector.h"
+#include "sockpp/poller.h"
 #include "sockpp/sock_address.h"
+#include "sockpp/socket_view.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+#endif
 
 using namespace sockpp;
+using namespace std::chrono;
+
+namespace {
+
+// Gets the address of a local port that nothing is listening on.
+inet_address closed_address() {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    return acc.address();
+}
+
+}  // namespace
 
 // Test that connector errors properly when given an empty address.
 TEST_CASE("connector unspecified address", "[connector]") {
@@ -63,3 +82,242 @@ TEST_CASE("connector unspecified address", "[connector]") {
     REQUIRE(errc::address_family_not_supported == res);
 #endif
 }
+
+TEST_CASE("connector connect_async", "[connector]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector conn;
+
+    auto res = conn.connect_async(acc.address());
+    REQUIRE(res);
+    REQUIRE(conn.is_non_blocking());
+
+    if (!res.value()) {
+        poller pl;
+        REQUIRE(pl.add(conn, poller::WRITABLE));
+
+        std::vector<poller::event> evts;
+        REQUIRE(pl.wait(evts, seconds(2)));
+        REQUIRE(evts.size() == 1);
+    }
+
+    REQUIRE(conn.finish_connect());
+    REQUIRE(conn.peer_address() == acc.address());
+}
+
+TEST_CASE("connector create flags", "[connector]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector conn;
+
+    conn.create_flags(connector::CLOSE_ON_EXEC);
+    REQUIRE(conn.create_flags() == connector::CLOSE_ON_EXEC);
+
+    // The timed connect restores the mode from the flags
+    REQUIRE(conn.connect(acc.address(), seconds(2)));
+    REQUIRE(!conn.is_non_blocking());
+#if !defined(_WIN32)
+    REQUIRE((::fcntl(conn.handle(), F_GETFD) & FD_CLOEXEC) != 0);
+#endif
+
+    conn.create_flags(connector::NON_BLOCKING);
+    REQUIRE(conn.connect(acc.address(), seconds(2)));
+    REQUIRE(conn.is_non_blocking());
+    REQUIRE(socket_view{conn}.is_non_blocking());
+}
+
+TEST_CASE("connector open", "[connector]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector conn;
+
+    conn.options().nodelay(true);
+    REQUIRE(conn.open());
+    auto h = conn.handle();
+
+    // Settings made before the connect are kept
+    REQUIRE(conn.bind(inet_address{"localhost", 0}));
+    auto local = conn.address();
+    REQUIRE(conn.nodelay().value());
+
+    REQUIRE(conn.connect(acc.address()));
+    REQUIRE(conn.handle() == h);
+    REQUIRE(conn.address() == local);
+
+    // A reconnect needs a new socket, which gets the options again
+    REQUIRE(conn.connect(acc.address(), seconds(2)));
+    REQUIRE(conn.address() != local);
+    REQUIRE(conn.nodelay().value());
+
+    // The handle is only kept for an address of the same family
+    if (conn.open(AF_INET6)) {
+        REQUIRE(conn.connect(acc.address()));
+        REQUIRE(conn.family() == AF_INET);
+    }
+}
+
+TEST_CASE("connector connect_async refused", "[connector]") {
+    tcp_connector conn;
+
+    auto res = conn.connect_async(closed_address());
+    if (res && !res.value()) {
+        poller pl;
+        REQUIRE(pl.add(conn, poller::WRITABLE));
+
+        std::vector<poller::event> evts;
+        REQUIRE(pl.wait(evts, seconds(2)));
+        res = conn.finish_connect().error();
+    }
+
+    REQUIRE(res == errc::connection_refused);
+}
+
+TEST_CASE("connector connect_many", "[connector]") {
+    tcp_acceptor acc1{inet_address{"localhost", 0}, 8}, acc2{inet_address{"localhost", 0}, 8};
+
+    std::vector<inet_address> addrs{acc1.address(), closed_address(), acc2.address()};
+
+    auto results = tcp_connector::connect_many(addrs, seconds(2));
+    REQUIRE(results.size() == 3);
+
+    REQUIRE(results[0]);
+    REQUIRE(results[0].value().peer_address() == acc1.address());
+    REQUIRE(!results[0].value().is_non_blocking());
+
+    REQUIRE(results[1] == errc::connection_refused);
+
+    REQUIRE(results[2]);
+    REQUIRE(results[2].value().peer_address() == acc2.address());
+}
+
+TEST_CASE("connector resolve", "[connector]") {
+    auto res = connector::resolve("127.0.0.1", 12345);
+    REQUIRE(res);
+    REQUIRE(res.value().size() == 1);
+
+    auto& addr = res.value()[0];
+    REQUIRE(addr.family() == AF_INET);
+    REQUIRE(inet_address{addr} == inet_address{"127.0.0.1", 12345});
+
+    SECTION("interleaved") {
+        auto res = connector::resolve("localhost", 12345);
+        REQUIRE(res);
+
+        auto& addrs = res.value();
+        REQUIRE(!addrs.empty());
+
+        // The families alternate while both are available
+        for (size_t i = 1; i < addrs.size(); ++i) {
+            if (addrs[i].family() == addrs[i - 1].family()) {
+                for (size_t j = i; j < addrs.size(); ++j)
+                    REQUIRE(addrs[j].family() == addrs[i].family());
+                break;
+            }
+        }
+    }
+
+    SECTION("bad name") { REQUIRE(!connector::resolve("bad.address.invalid", 12345)); }
+}
+
+TEST_CASE("connector connect_race", "[connector]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    connector conn;
+
+    SECTION("skip refused") {
+        std::vector<sock_address_any> addrs{closed_address(), closed_address(), acc.address()};
+
+        REQUIRE(conn.connect_race(addrs, seconds(2)));
+        REQUIRE(conn.is_open());
+        REQUIRE(inet_address{conn.peer_address()} == acc.address());
+        REQUIRE(!conn.is_non_blocking());
+    }
+
+    SECTION("all refused") {
+        std::vector<sock_address_any> addrs{closed_address(), closed_address()};
+
+        auto res = conn.connect_race(addrs, seconds(2));
+        REQUIRE(res == errc::connection_refused);
+        REQUIRE(!conn);
+    }
+
+    SECTION("host name") {
+        // 'localhost' may resolve to ::1 first, which has no listener
+        REQUIRE(conn.connect_race("localhost", acc.address().port(), seconds(2)));
+        REQUIRE(inet_address{conn.peer_address()} == acc.address());
+    }
+
+    SECTION("empty") {
+        REQUIRE(conn.connect_race(std::vector<sock_address_any>{}) == errc::invalid_argument);
+    }
+}
+
+TEST_CASE("connector caches peer address", "[connector]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+
+    SECTION("constructor") {
+        cached_tcp_connector conn{acc.address()};
+        REQUIRE(conn.has_cached_peer_address());
+        REQUIRE(conn.peer_address() == acc.address());
+    }
+
+    SECTION("connect") {
+        cached_tcp_connector conn;
+        REQUIRE(!conn.has_cached_peer_address());
+
+        REQUIRE(conn.connect(acc.address()));
+        REQUIRE(conn.has_cached_peer_address());
+        REQUIRE(conn.peer_address() == acc.address());
+
+        REQUIRE(!conn.connect(closed_address()));
+        REQUIRE(!conn.has_cached_peer_address());
+    }
+
+    SECTION("race") {
+        cached_tcp_connector conn{acc.address()};
+        REQUIRE(conn.connect_race(std::vector<sock_address_any>{acc.address()}, seconds(2)));
+        REQUIRE(!conn.has_cached_peer_address());
+        REQUIRE(conn.peer_address() == acc.address());
+    }
+
+    SECTION("not cached by default") {
+        tcp_connector conn{acc.address()};
+        REQUIRE(!conn.has_cached_peer_address());
+        REQUIRE(conn.peer_address() == acc.address());
+        REQUIRE(sizeof(tcp_connector) == sizeof(connector));
+    }
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("connector connect_with_data", "[connector]") {
+    tcp_acceptor acc;
+    REQUIRE(acc.open(inet_address{"localhost", 0}));
+    acc.fastopen(16);
+
+    const std::string STR{"This is a test. This is only a test."};
+    char buf[64];
+
+    // The first connection gets a cookie, if Fast Open is enabled. The
+    // second can then send the data in the SYN. Either way the data
+    // should arrive.
+    for (int i = 0; i < 2; ++i) {
+        tcp_connector conn;
+        auto res = conn.connect_with_data(acc.address(), STR);
+        REQUIRE(res);
+        REQUIRE(res.value() == STR.size());
+        REQUIRE(conn.peer_address() == acc.address());
+
+        auto sock = acc.accept().release();
+        REQUIRE(sock);
+        REQUIRE(sock.read_n(buf, STR.size()) == STR.size());
+        REQUIRE(std::string(buf, STR.size()) == STR);
+
+        // And the connection is good for the rest of the conversation
+        REQUIRE(sock.write(STR) == STR.size());
+        REQUIRE(conn.read_n(buf, STR.size()) == STR.size());
+    }
+
+    SECTION("refused") {
+        tcp_connector conn;
+        auto res = conn.connect_with_data(closed_address(), STR);
+        REQUIRE(res == errc::connection_refused);
+        REQUIRE(!conn.is_open());
+    }
+}
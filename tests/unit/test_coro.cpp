@@ -0,0 +1,158 @@
+// test_coro.cpp
+//
+// Unit tests for the sockpp C++20 coroutine support.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/coro.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+
+namespace {
+
+task<int> answer() { co_return 42; }
+
+task<int> add_answers() {
+    int a = co_await answer();
+    int b = co_await answer();
+    co_return a + b;
+}
+
+task<int> thrower() {
+    throw std::runtime_error("oops");
+    co_return 0;
+}
+
+// Accepts one connection and echoes it back until the peer closes.
+task<size_t> echo_one(reactor& rctr, async_socket<tcp_acceptor>& acc) {
+    auto res = co_await acc.accept();
+    if (!res)
+        co_return 0;
+
+    async_socket<tcp_socket> sock{rctr, res.release()};
+    char buf[512];
+    size_t total = 0;
+
+    result<size_t> n;
+    while ((n = co_await sock.read(buf, sizeof(buf))) && n.value() > 0) {
+        if (!co_await sock.write_n(buf, n.value()))
+            break;
+        total += n.value();
+    }
+    co_return total;
+}
+
+// Connects, sends a message and reads it back.
+task<std::string> client(reactor& rctr, inet_address addr, std::string msg) {
+    async_socket<tcp_connector> conn{rctr};
+
+    if (!co_await conn.connect(addr))
+        co_return std::string{};
+
+    if (!co_await conn.write_n(msg.data(), msg.size()))
+        co_return std::string{};
+
+    std::string reply(msg.size(), '\0');
+    size_t n = 0;
+    while (n < reply.size()) {
+        auto res = co_await conn.read(&reply[n], reply.size() - n);
+        if (!res || res.value() == 0)
+            break;
+        n += res.value();
+    }
+    reply.resize(n);
+    co_return reply;
+}
+
+}  // namespace
+
+TEST_CASE("coro task", "[coro]") {
+    reactor rctr;
+
+    SECTION("value") { REQUIRE(block_on(rctr, answer()) == 42); }
+
+    SECTION("nested") { REQUIRE(block_on(rctr, add_answers()) == 84); }
+
+    SECTION("exception") { REQUIRE_THROWS_AS(block_on(rctr, thrower()), std::runtime_error); }
+
+    SECTION("lazy") {
+        auto t = answer();
+        REQUIRE(!t.done());
+        t.start();
+        REQUIRE(t.done());
+        REQUIRE(t.get() == 42);
+    }
+}
+
+TEST_CASE("coro socket echo", "[coro]") {
+    reactor rctr;
+    async_socket<tcp_acceptor> acc{rctr, tcp_acceptor{inet_address{"localhost", 0}}};
+    REQUIRE(acc);
+
+    // The server runs in the background, on the same reactor as the client
+    size_t nserved = 0;
+    auto srv = [&]() -> task<> { nserved = co_await echo_one(rctr, acc); };
+    spawn(srv());
+
+    const std::string MSG{"Hello, coroutines"};
+    REQUIRE(block_on(rctr, client(rctr, acc.sock().address(), MSG)) == MSG);
+
+    // The client closed when it finished, so the server sees EOF.
+    while (nserved == 0 && !rctr.empty()) REQUIRE(rctr.run_once(milliseconds(1000)));
+    REQUIRE(nserved == MSG.size());
+}
+
+TEST_CASE("coro connect refused", "[coro]") {
+    inet_address addr;
+    {
+        tcp_acceptor acc{inet_address{"localhost", 0}};
+        addr = acc.address();
+    }
+
+    reactor rctr;
+    async_socket<tcp_connector> conn{rctr};
+
+    auto t = [&]() -> task<result<>> { co_return co_await conn.connect(addr); };
+    auto res = block_on(rctr, t());
+    REQUIRE(!res);
+    REQUIRE(res == errc::connection_refused);
+}
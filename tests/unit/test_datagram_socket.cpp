@@ -38,11 +38,19 @@
 // --------------------------------------------------------------------------
 //
 
+#include <cstring>
 #include <string>
+#include <thread>
 
 #include "catch2_version.h"
 #include "sockpp/datagram_socket.h"
 #include "sockpp/inet_address.h"
+#include "sockpp/udp6_socket.h"
+#include "sockpp/udp_socket.h"
+
+#if !defined(_WIN32)
+    #include <net/if.h>
+#endif
 
 using namespace std;
 using namespace sockpp;
@@ -111,3 +119,324 @@ TEST_CASE("datagram_socket address constructor", "[datagram_socket]") {
 #endif
     }
 }
+
+TEST_CASE("datagram_socket batched I/O", "[datagram_socket]") {
+    const auto ANY_ADDR = inet_address("localhost", 0);
+
+    udp_socket srv{ANY_ADDR}, cli{ANY_ADDR};
+    const auto SRV_ADDR = srv.address();
+    const auto CLI_ADDR = cli.address();
+
+    const string MSGS[] = {"one", "two", "three"};
+    constexpr size_t N = sizeof(MSGS) / sizeof(MSGS[0]);
+
+    iovec outv[N];
+    for (size_t i = 0; i < N; ++i)
+        outv[i] = iovec{const_cast<char*>(MSGS[i].data()), MSGS[i].size()};
+
+    SECTION("send to one address") {
+        auto res = cli.send_many(outv, N, SRV_ADDR);
+        REQUIRE(res);
+        REQUIRE(res.value() == N);
+
+        char bufs[N + 1][32];
+        iovec inv[N + 1];
+        for (size_t i = 0; i <= N; ++i) inv[i] = iovec{bufs[i], sizeof(bufs[i])};
+
+        size_t lens[N + 1];
+        inet_address addrs[N + 1];
+
+        // Asking for more than are waiting shouldn't block
+        size_t nrecv = 0;
+        while (nrecv < N) {
+            res = srv.recv_many(inv + nrecv, lens + nrecv, N + 1 - nrecv, addrs + nrecv);
+            REQUIRE(res);
+            nrecv += res.value();
+        }
+        REQUIRE(nrecv == N);
+
+        for (size_t i = 0; i < N; ++i) {
+            REQUIRE(string(bufs[i], lens[i]) == MSGS[i]);
+            REQUIRE(addrs[i] == CLI_ADDR);
+        }
+    }
+
+    SECTION("send to separate addresses") {
+        inet_address dests[N] = {SRV_ADDR, CLI_ADDR, SRV_ADDR};
+
+        auto res = cli.send_many(outv, N, dests);
+        REQUIRE(res);
+        REQUIRE(res.value() == N);
+
+        char bufs[N][32];
+        iovec inv[N];
+        for (size_t i = 0; i < N; ++i) inv[i] = iovec{bufs[i], sizeof(bufs[i])};
+        size_t lens[N];
+
+        size_t nrecv = 0;
+        while (nrecv < 2) {
+            res = srv.recv_many(inv + nrecv, lens + nrecv, N - nrecv);
+            REQUIRE(res);
+            nrecv += res.value();
+        }
+        REQUIRE(nrecv == 2);
+        REQUIRE(string(bufs[0], lens[0]) == MSGS[0]);
+        REQUIRE(string(bufs[1], lens[1]) == MSGS[2]);
+
+        res = cli.recv_many(inv, lens, 1);
+        REQUIRE(res);
+        REQUIRE(res.value() == 1);
+        REQUIRE(string(bufs[0], lens[0]) == MSGS[1]);
+    }
+
+    SECTION("connected") {
+        REQUIRE(cli.connect(SRV_ADDR));
+
+        auto res = cli.send_many(outv, N);
+        REQUIRE(res);
+        REQUIRE(res.value() == N);
+
+        char bufs[N][32];
+        iovec inv[N];
+        for (size_t i = 0; i < N; ++i) inv[i] = iovec{bufs[i], sizeof(bufs[i])};
+        size_t lens[N];
+
+        size_t nrecv = 0;
+        while (nrecv < N) {
+            res = srv.recv_many(inv + nrecv, lens + nrecv, N - nrecv);
+            REQUIRE(res);
+            nrecv += res.value();
+        }
+        for (size_t i = 0; i < N; ++i) REQUIRE(string(bufs[i], lens[i]) == MSGS[i]);
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("datagram_socket segmentation offload", "[datagram_socket]") {
+    const auto ANY_ADDR = inet_address("localhost", 0);
+
+    udp_socket srv{ANY_ADDR}, cli{ANY_ADDR};
+    const auto SRV_ADDR = srv.address();
+
+    // Not all kernels support GSO/GRO
+    if (!srv.set_gro()) {
+        WARN("UDP GRO not supported");
+        return;
+    }
+
+    constexpr size_t SEG_SZ = 1000, N_SEG = 3;
+    char outbuf[SEG_SZ * N_SEG];
+    for (size_t i = 0; i < sizeof(outbuf); ++i) outbuf[i] = char(i / SEG_SZ + 'a');
+
+    auto res = cli.send_segments_to(outbuf, sizeof(outbuf), SEG_SZ, SRV_ADDR);
+    if (!res && res == errc::invalid_argument) {
+        WARN("UDP GSO not supported");
+        return;
+    }
+    REQUIRE(res);
+    REQUIRE(res.value() == sizeof(outbuf));
+
+    // The segments may or may not be coalesced on receive, but the
+    // reported segment size should always match what was sent.
+    char inbuf[65536];
+    size_t nrecv = 0;
+
+    while (nrecv < sizeof(outbuf)) {
+        size_t segSize = 0;
+        inet_address src;
+        res = srv.recv_segments_from(inbuf + nrecv, sizeof(inbuf) - nrecv, &segSize, &src);
+        REQUIRE(res);
+        REQUIRE(segSize == SEG_SZ);
+        REQUIRE(src == cli.address());
+        nrecv += res.value();
+    }
+
+    REQUIRE(nrecv == sizeof(outbuf));
+    REQUIRE(memcmp(inbuf, outbuf, sizeof(outbuf)) == 0);
+}
+#endif
+
+#if defined(__linux__)
+TEST_CASE("datagram_socket zerocopy", "[datagram_socket]") {
+    const auto ANY_ADDR = inet_address("localhost", 0);
+
+    udp_socket srv{ANY_ADDR}, cli{ANY_ADDR};
+
+    if (!cli.zerocopy(true)) {
+        WARN("SO_ZEROCOPY not supported for UDP");
+        return;
+    }
+
+    const string MSG(4096, 'u');
+    REQUIRE(cli.send_to(MSG.data(), MSG.size(), MSG_ZEROCOPY, srv.address()));
+    REQUIRE(cli.send_to(MSG.data(), MSG.size(), MSG_ZEROCOPY, srv.address()));
+
+    char buf[8192];
+    REQUIRE(srv.recv(buf, sizeof(buf)).value() == MSG.size());
+    REQUIRE(srv.recv(buf, sizeof(buf)).value() == MSG.size());
+
+    // The kernel may merge the notifications into a single range
+    socket::zerocopy_completion comps[2];
+    size_t ncomp = 0;
+    uint32_t last = 0;
+    bool done = false;
+
+    for (int i = 0; i < 100 && !done; ++i) {
+        auto res = cli.zerocopy_completions(comps, 2);
+        REQUIRE(res);
+        ncomp = res.value();
+        for (size_t j = 0; j < ncomp; ++j) {
+            last = comps[j].hi;
+            done = comps[j].contains(1);
+        }
+        if (!done)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(done);
+    REQUIRE(last == 1);
+}
+#endif
+
+#if defined(__linux__)
+TEST_CASE("datagram_socket timestamps", "[datagram_socket]") {
+    using std::chrono::system_clock;
+
+    const auto ANY_ADDR = inet_address("localhost", 0);
+    const string MSG{"timestamp me"};
+
+    udp_socket srv{ANY_ADDR}, cli{ANY_ADDR};
+    char buf[64];
+
+    SECTION("receive") {
+        REQUIRE(srv.enable_timestamps());
+
+        auto before = system_clock::now();
+        REQUIRE(cli.send_to(MSG, srv.address()));
+
+        socket::packet_timestamp ts;
+        inet_address src;
+        auto res = srv.recv_from(buf, sizeof(buf), ts, &src);
+        REQUIRE(res.value() == MSG.size());
+        REQUIRE(src == cli.address());
+
+        REQUIRE(ts.has_software());
+        REQUIRE(!ts.has_hardware());
+        REQUIRE(ts.time() >= before - std::chrono::milliseconds(10));
+        REQUIRE(ts.time() <= system_clock::now());
+    }
+
+    SECTION("receive without timestamps") {
+        REQUIRE(cli.send_to(MSG, srv.address()));
+
+        socket::packet_timestamp ts;
+        REQUIRE(srv.recv(buf, sizeof(buf), ts).value() == MSG.size());
+        REQUIRE(!ts.has_software());
+    }
+
+    SECTION("transmit") {
+        REQUIRE(cli.enable_timestamps(socket::TIMESTAMP_TX_SOFTWARE));
+
+        REQUIRE(cli.send_to(MSG, srv.address()));
+        REQUIRE(cli.send_to(MSG, srv.address()));
+
+        socket::packet_timestamp ts[2];
+        size_t nts = 0;
+
+        for (int i = 0; i < 100 && nts < 2; ++i) {
+            auto res = cli.tx_timestamps(ts + nts, 2 - nts);
+            REQUIRE(res);
+            nts += res.value();
+            if (nts < 2)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE(nts == 2);
+        REQUIRE(ts[0].has_software());
+        REQUIRE(ts[0].id == 0);
+        REQUIRE(ts[1].id == 1);
+        REQUIRE(ts[1].software >= ts[0].software);
+    }
+}
+#endif
+
+TEST_CASE("datagram_socket multicast options", "[datagram_socket]") {
+    udp_socket sock;
+    REQUIRE(sock);
+
+    REQUIRE(sock.multicast_ttl(8));
+    REQUIRE(sock.multicast_ttl().value() == 8);
+
+    REQUIRE(sock.multicast_loop(false));
+    REQUIRE(!sock.multicast_loop().value());
+    REQUIRE(sock.multicast_loop(true));
+    REQUIRE(sock.multicast_loop().value());
+
+    REQUIRE(sock.multicast_interface(0));
+
+#if defined(__linux__)
+    REQUIRE(sock.multicast_all().value());
+    REQUIRE(sock.multicast_all(false));
+    REQUIRE(!sock.multicast_all().value());
+#else
+    REQUIRE(sock.multicast_all(false) == errc::operation_not_supported);
+#endif
+}
+
+TEST_CASE("datagram_socket multicast options IPv6", "[datagram_socket]") {
+    udp6_socket sock;
+    REQUIRE(sock);
+
+    REQUIRE(sock.multicast_ttl(4));
+    REQUIRE(sock.multicast_ttl().value() == 4);
+
+    REQUIRE(sock.multicast_loop(false));
+    REQUIRE(!sock.multicast_loop().value());
+
+    REQUIRE(sock.multicast_interface(0));
+
+    // Only a multicast address can be joined
+    REQUIRE(!sock.join_group(inet6_address{"::1", 0}));
+}
+
+// The loopback interface is 'lo' on Linux
+#if defined(__linux__)
+TEST_CASE("datagram_socket multicast group", "[datagram_socket]") {
+    const auto GRP = inet_address{"239.255.0.1", 0};
+    const auto SRC = inet_address{"127.0.0.1", 0};
+    const unsigned LO = ::if_nametoindex("lo");
+
+    udp_socket srv;
+    REQUIRE(srv.reuse_address(true));
+    REQUIRE(srv.bind(inet_address{in_port_t(0)}));
+    const auto GRP_ADDR = inet_address{GRP.address(), srv.address().port()};
+
+    SECTION("join and leave") {
+        REQUIRE(srv.join_group(GRP, LO));
+        // Joining twice is an error
+        REQUIRE(!srv.join_group(GRP, LO));
+        REQUIRE(srv.leave_group(GRP, LO));
+        REQUIRE(!srv.leave_group(GRP, LO));
+    }
+
+    SECTION("source-specific") {
+        REQUIRE(srv.join_source_group(GRP, SRC, LO));
+        REQUIRE(srv.leave_source_group(GRP, SRC, LO));
+    }
+
+    SECTION("loopback delivery") {
+        REQUIRE(srv.join_group(GRP, LO));
+
+        udp_socket cli;
+        REQUIRE(cli.multicast_interface(LO));
+        REQUIRE(cli.multicast_loop(true));
+
+        const string MSG{"market data"};
+        REQUIRE(cli.send_to(MSG, GRP_ADDR));
+
+        char buf[64];
+        REQUIRE(srv.set_non_blocking());
+        auto res = srv.recv(buf, sizeof(buf));
+        REQUIRE(res);
+        REQUIRE(string(buf, res.value()) == MSG);
+    }
+}
+#endif
@@ -177,3 +177,61 @@ TEST_CASE("IPv6 create address", "[address]") {
     }
 #endif
 }
+
+TEST_CASE("IPv6 parse address", "[address]") {
+    SECTION("valid") {
+        auto res = inet6_address::parse_address("::1");
+        REQUIRE(res);
+        REQUIRE(std::memcmp(&res.value(), &LOCALHOST_ADDR, sizeof(in6_addr)) == 0);
+        REQUIRE(inet6_address::parse_address("fe80::1:2:3"));
+    }
+
+    SECTION("invalid") {
+        // A host name is never looked up
+        REQUIRE(inet6_address::parse_address("localhost") == errc::invalid_argument);
+        REQUIRE(!inet6_address::parse_address(""));
+        REQUIRE(!inet6_address::parse_address("1:2:3:4:5:6:7:8:9"));
+        REQUIRE(!inet6_address::parse_address(std::string(100, '1')));
+    }
+
+    SECTION("with port") {
+        auto res = inet6_address::parse("[::1]:12345");
+        REQUIRE(res);
+        REQUIRE(res.value() == inet6_address::loopback(12345));
+
+        res = inet6_address::parse("[::1]");
+        REQUIRE(res);
+        REQUIRE(res.value().port() == 0);
+
+        res = inet6_address::parse("::1");
+        REQUIRE(res);
+        REQUIRE(res.value() == inet6_address::loopback(0));
+
+        REQUIRE(!inet6_address::parse("[::1"));
+        REQUIRE(!inet6_address::parse("[::1]:"));
+        REQUIRE(!inet6_address::parse("[::1]80"));
+        REQUIRE(!inet6_address::parse("[::1]:65536"));
+    }
+}
+
+TEST_CASE("IPv6 address to_chars", "[address]") {
+    auto addr = inet6_address::loopback(PORT);
+    const std::string STR{"[::1]:" + std::to_string(PORT)};
+
+    char buf[inet6_address::MAX_STR_LEN];
+    auto res = addr.to_chars(buf, buf + sizeof(buf));
+    REQUIRE(res.ec == std::errc{});
+    REQUIRE(std::string(buf, res.ptr) == STR);
+    REQUIRE(addr.to_string() == STR);
+
+    SECTION("too small") {
+        auto res = addr.to_chars(buf, buf + 4);
+        REQUIRE(res.ec == std::errc::value_too_large);
+    }
+
+    SECTION("round trip") {
+        auto res = inet6_address::parse(addr.to_string());
+        REQUIRE(res);
+        REQUIRE(res.value() == addr);
+    }
+}
@@ -204,3 +204,71 @@ TEST_CASE("IPv4 create address", "[address]") {
     }
 #endif
 }
+
+TEST_CASE("IPv4 parse address", "[address]") {
+    SECTION("valid") {
+        auto res = inet_address::parse_address("192.168.1.23");
+        REQUIRE(res);
+        REQUIRE(ntohl(res.value()) == 0xC0A80117);
+
+        REQUIRE(inet_address::parse_address("0.0.0.0"));
+        REQUIRE(inet_address::parse_address("255.255.255.255"));
+    }
+
+    SECTION("invalid") {
+        // A host name is never looked up
+        REQUIRE(inet_address::parse_address(LOCALHOST_STR) == errc::invalid_argument);
+
+        REQUIRE(!inet_address::parse_address(""));
+        REQUIRE(!inet_address::parse_address("192.168.1"));
+        REQUIRE(!inet_address::parse_address("192.168.1.256"));
+        REQUIRE(!inet_address::parse_address("192.168.01.1"));
+        REQUIRE(!inet_address::parse_address("192.168.1.1."));
+        REQUIRE(!inet_address::parse_address("192.168.-1.1"));
+        REQUIRE(!inet_address::parse_address("192.168.1.1x"));
+    }
+
+    SECTION("with port") {
+        auto res = inet_address::parse("127.0.0.1:12345");
+        REQUIRE(res);
+        REQUIRE(res.value() == inet_address{LOCALHOST_ADDR, 12345});
+
+        res = inet_address::parse("127.0.0.1");
+        REQUIRE(res);
+        REQUIRE(res.value().port() == 0);
+
+        REQUIRE(!inet_address::parse("127.0.0.1:"));
+        REQUIRE(!inet_address::parse("127.0.0.1:65536"));
+        REQUIRE(!inet_address::parse("127.0.0.1:80x"));
+        REQUIRE(!inet_address::parse("localhost:80"));
+    }
+}
+
+TEST_CASE("IPv4 address to_chars", "[address]") {
+    inet_address addr{0xC0A80117, 65535};
+    const std::string STR{"192.168.1.23:65535"};
+
+    char buf[inet_address::MAX_STR_LEN];
+    auto res = addr.to_chars(buf, buf + sizeof(buf));
+    REQUIRE(res.ec == std::errc{});
+    REQUIRE(std::string(buf, res.ptr) == STR);
+    REQUIRE(addr.to_string() == STR);
+
+    SECTION("max length") {
+        inet_address addr{0xFFFFFFFF, 65535};
+        auto res = addr.to_chars(buf, buf + sizeof(buf));
+        REQUIRE(res.ec == std::errc{});
+        REQUIRE(size_t(res.ptr - buf) == inet_address::MAX_STR_LEN);
+    }
+
+    SECTION("too small") {
+        auto res = addr.to_chars(buf, buf + 10);
+        REQUIRE(res.ec == std::errc::value_too_large);
+    }
+
+    SECTION("round trip") {
+        auto res = inet_address::parse(addr.to_string());
+        REQUIRE(res);
+        REQUIRE(res.value() == addr);
+    }
+}
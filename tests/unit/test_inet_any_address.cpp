@@ -0,0 +1,170 @@
+// test_inet_any_address.cpp
+//
+// Unit tests for the sockpp inet_any_address class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include "catch2_version.h"
+#include "sockpp/inet_any_address.h"
+#include "sockpp/tcp6_acceptor.h"
+#include "sockpp/tcp6_connector.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+
+TEST_CASE("inet_any_address constructors", "[address]") {
+    SECTION("default") {
+        inet_any_address addr;
+
+        REQUIRE(!addr);
+        REQUIRE(!addr.is_set());
+        REQUIRE(addr.family() == AF_UNSPEC);
+        REQUIRE(addr.size() == 0);
+        REQUIRE(addr.port() == 0);
+        REQUIRE(addr.to_string().empty());
+    }
+
+    SECTION("ipv4") {
+        inet_address v4{"127.0.0.1", 12345};
+        inet_any_address addr{v4};
+
+        REQUIRE(addr);
+        REQUIRE(addr.is_v4());
+        REQUIRE(!addr.is_v6());
+        REQUIRE(addr.size() == sizeof(sockaddr_in));
+        REQUIRE(addr.port() == 12345);
+        REQUIRE(addr.to_inet() == v4);
+        REQUIRE(!addr.to_inet6());
+        REQUIRE(addr.to_string() == "127.0.0.1:12345");
+        REQUIRE(addr.to_sock_address_any() == v4);
+    }
+
+    SECTION("ipv6") {
+        inet6_address v6{"::1", 80};
+        inet_any_address addr{v6};
+
+        REQUIRE(addr.is_v6());
+        REQUIRE(addr.size() == sizeof(sockaddr_in6));
+        REQUIRE(addr.port() == 80);
+        REQUIRE(addr.to_inet6() == v6);
+        REQUIRE(!addr.to_inet());
+        REQUIRE(addr.to_string() == v6.to_string());
+    }
+
+    SECTION("create") {
+        auto res = inet_any_address::create(sock_address_any{inet_address{"10.0.0.1", 80}});
+        REQUIRE(res);
+        REQUIRE(res.value().is_v4());
+
+        res = inet_any_address::create(sock_address_any{});
+        REQUIRE(!res);
+        REQUIRE(res.error() == errc::address_family_not_supported);
+    }
+}
+
+TEST_CASE("inet_any_address compare and hash", "[address]") {
+    inet_any_address a{inet_address{"10.0.0.1", 80}}, b{inet_address{"10.0.0.1", 81}},
+        c{inet6_address{"::1", 80}};
+
+    REQUIRE(a == inet_any_address{inet_address{"10.0.0.1", 80}});
+    REQUIRE(a != b);
+    REQUIRE(a != c);
+    REQUIRE((a < b || b < a));
+    REQUIRE(a < c);
+
+    std::unordered_set<inet_any_address> uset{a, b, c, a};
+    REQUIRE(uset.size() == 3);
+
+    std::ostringstream os;
+    os << a;
+    REQUIRE(os.str() == "10.0.0.1:80");
+}
+
+TEST_CASE("inet_any_address from sockets", "[address]") {
+    SECTION("ipv4") {
+        tcp_acceptor acc{inet_address{"127.0.0.1", 0}};
+        REQUIRE(acc);
+
+        inet_any_address local;
+        REQUIRE(acc.address(local));
+        REQUIRE(local.to_inet() == acc.address());
+
+        tcp_connector conn{acc.address()};
+        REQUIRE(conn);
+
+        inet_any_address peer;
+        auto res = acc.accept(peer);
+        REQUIRE(res);
+        REQUIRE(peer.is_v4());
+        REQUIRE(peer.to_inet() == conn.address());
+
+        inet_any_address addr;
+        REQUIRE(res.value().peer_address(addr));
+        REQUIRE(addr == peer);
+
+        REQUIRE(conn.peer_address(addr));
+        REQUIRE(addr == local);
+    }
+
+    SECTION("ipv6") {
+        error_code ec;
+        tcp6_acceptor acc{inet6_address{"::1", 0}, 4, ec};
+        if (ec)
+            return;  // No IPv6 loopback on this host
+
+        tcp6_connector conn{acc.address()};
+        REQUIRE(conn);
+
+        inet_any_address peer;
+        auto res = acc.accept(peer);
+        REQUIRE(res);
+        REQUIRE(peer.is_v6());
+        REQUIRE(peer.to_inet6() == conn.address());
+    }
+
+    SECTION("error") {
+        tcp_socket sock;
+        inet_any_address addr{inet_address{"10.0.0.1", 80}};
+        REQUIRE(!sock.peer_address(addr));
+        REQUIRE(!addr);
+    }
+}
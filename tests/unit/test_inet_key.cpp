@@ -0,0 +1,181 @@
+// test_inet_key.cpp
+//
+// Unit tests for address hashing, ordering, and the sockpp inet_key class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "catch2_version.h"
+#include "sockpp/inet_key.h"
+
+using namespace sockpp;
+
+TEST_CASE("inet_address hashing and ordering", "[address]") {
+    inet_address a{"127.0.0.1", 1000}, b{"127.0.0.1", 2000}, c{"127.0.0.2", 1000};
+
+    SECTION("ordering") {
+        REQUIRE(a < b);
+        REQUIRE(b < c);
+        REQUIRE(!(a < a));
+        REQUIRE(!(b < a));
+    }
+
+    SECTION("hash") {
+        std::hash<inet_address> h;
+        REQUIRE(h(a) == h(inet_address{"127.0.0.1", 1000}));
+        REQUIRE(h(a) != h(b));
+        REQUIRE(h(a) != h(c));
+    }
+
+    SECTION("containers") {
+        std::unordered_map<inet_address, int> umap;
+        umap[a] = 1;
+        umap[b] = 2;
+        umap[inet_address{"127.0.0.1", 1000}] = 3;
+        REQUIRE(umap.size() == 2);
+        REQUIRE(umap[a] == 3);
+
+        std::map<inet_address, int> omap{{c, 3}, {a, 1}, {b, 2}};
+        REQUIRE(omap.begin()->first == a);
+        REQUIRE(omap.rbegin()->first == c);
+    }
+}
+
+TEST_CASE("inet6_address hashing and ordering", "[address]") {
+    inet6_address a{"::1", 1000}, b{"::1", 2000}, c{"::2", 1000};
+
+    REQUIRE(a < b);
+    REQUIRE(b < c);
+    REQUIRE(!(a < a));
+
+    std::hash<inet6_address> h;
+    REQUIRE(h(a) == h(inet6_address{"::1", 1000}));
+    REQUIRE(h(a) != h(b));
+    REQUIRE(h(a) != h(c));
+
+    std::unordered_set<inet6_address> uset{a, b, c, inet6_address{"::1", 2000}};
+    REQUIRE(uset.size() == 3);
+}
+
+TEST_CASE("sock_address_any hashing and ordering", "[address]") {
+    sock_address_any a{inet_address{"127.0.0.1", 1000}}, b{inet6_address{"::1", 1000}};
+
+    REQUIRE((a < b || b < a));
+    REQUIRE(!(a < a));
+
+    std::hash<sock_address_any> h;
+    REQUIRE(h(a) == h(sock_address_any{inet_address{"127.0.0.1", 1000}}));
+    REQUIRE(h(a) != h(b));
+
+    std::unordered_set<sock_address_any> uset{a, b, a};
+    REQUIRE(uset.size() == 2);
+}
+
+TEST_CASE("inet_key", "[address]") {
+    SECTION("default") {
+        inet_key key;
+        REQUIRE(key.port() == 0);
+        REQUIRE(!key.is_v4());
+        REQUIRE(key == inet_key{inet6_address{}});
+    }
+
+    SECTION("ipv4") {
+        inet_address addr{"192.168.1.2", 12345};
+        inet_key key{addr};
+
+        REQUIRE(key.is_v4());
+        REQUIRE(key.port() == 12345);
+        REQUIRE(key.to_inet() == addr);
+        REQUIRE(key.to_inet6().to_string() == "[::ffff:192.168.1.2]:12345");
+    }
+
+    SECTION("ipv6") {
+        inet6_address addr{"fe80::1", 80};
+        inet_key key{addr};
+
+        REQUIRE(!key.is_v4());
+        REQUIRE(key.port() == 80);
+        REQUIRE(key.to_inet6() == addr);
+    }
+
+    SECTION("v4-mapped is the same key") {
+        inet_key k4{inet_address{"10.0.0.1", 80}},
+            k6{inet6_address{"::ffff:10.0.0.1", 80}};
+        REQUIRE(k4 == k6);
+        REQUIRE(k4.hash() == k6.hash());
+    }
+
+    SECTION("create") {
+        auto res = inet_key::create(sock_address_any{inet_address{"10.0.0.1", 80}});
+        REQUIRE(res);
+        REQUIRE(res.value().is_v4());
+
+        res = inet_key::create(sock_address_any{inet6_address{"::1", 80}});
+        REQUIRE(res);
+        REQUIRE(!res.value().is_v4());
+
+        res = inet_key::create(sock_address_any{});
+        REQUIRE(!res);
+        REQUIRE(res.error() == errc::address_family_not_supported);
+    }
+
+    SECTION("ordering and hashing") {
+        inet_key a{inet_address{"10.0.0.1", 80}}, b{inet_address{"10.0.0.1", 81}},
+            c{inet_address{"10.0.0.2", 80}};
+
+        REQUIRE(a < b);
+        REQUIRE(b < c);
+        REQUIRE(a <= a);
+        REQUIRE(c > a);
+        REQUIRE(c >= b);
+        REQUIRE(a != b);
+
+        REQUIRE(a.hash() != b.hash());
+        REQUIRE(a.hash() != c.hash());
+
+        std::unordered_map<inet_key, int> umap{{a, 1}, {b, 2}, {c, 3}};
+        REQUIRE(umap.size() == 3);
+        REQUIRE(umap[inet_key{inet6_address{"::ffff:10.0.0.1", 81}}] == 2);
+
+        std::set<inet_key> oset{c, b, a};
+        REQUIRE(*oset.begin() == a);
+    }
+}
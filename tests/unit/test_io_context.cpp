@@ -0,0 +1,286 @@
+// test_io_context.cpp
+//
+// Unit tests for the sockpp io_context and io_context_pool classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/io_context.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+using namespace std::chrono;
+
+namespace {
+
+// Waits, up to a limit, for a condition set by another thread.
+template <typename F>
+bool wait_for(F cond, milliseconds limit = milliseconds(5000)) {
+    auto deadline = steady_clock::now() + limit;
+    while (!cond()) {
+        if (steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("io_context post", "[io_context]") {
+    io_context ctx;
+    std::thread thr{[&] { (void)ctx.run(); }};
+
+    SECTION("in order, on the loop thread") {
+        constexpr int N = 1000;
+        std::vector<int> seen;
+        std::atomic<bool> wrongThread{false};
+        std::atomic<bool> done{false};
+
+        for (int i = 0; i < N; ++i) {
+            ctx.post([&, i] {
+                if (!ctx.running_in_this_thread())
+                    wrongThread = true;
+                seen.push_back(i);
+                if (i == N - 1)
+                    done = true;
+            });
+        }
+
+        REQUIRE(wait_for([&] { return done.load(); }));
+        REQUIRE(!wrongThread);
+        REQUIRE(seen.size() == size_t(N));
+        for (int i = 0; i < N; ++i) REQUIRE(seen[i] == i);
+    }
+
+    SECTION("move-only function") {
+        std::atomic<int> val{0};
+        auto p = std::make_unique<int>(42);
+        ctx.post([&val, p = std::move(p)] { val = *p; });
+        REQUIRE(wait_for([&] { return val.load() == 42; }));
+    }
+
+    SECTION("many threads") {
+        constexpr int NTHR = 4, N = 500;
+        std::atomic<int> count{0};
+        std::vector<std::thread> posters;
+
+        for (int i = 0; i < NTHR; ++i) {
+            posters.emplace_back([&] {
+                for (int j = 0; j < N; ++j) ctx.post([&] { ++count; });
+            });
+        }
+        for (auto& t : posters) t.join();
+
+        REQUIRE(wait_for([&] { return count.load() == NTHR * N; }));
+    }
+
+    ctx.stop();
+    thr.join();
+    REQUIRE(!ctx.running_in_this_thread());
+}
+
+TEST_CASE("io_context sockets", "[io_context]") {
+    io_context ctx;
+    std::thread thr{[&] { (void)ctx.run(); }};
+
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector conn{acc.address()};
+    auto sock = std::make_shared<tcp_socket>(acc.accept().release());
+    REQUIRE(sock->set_non_blocking());
+
+    std::atomic<size_t> nread{0};
+
+    // Registration has to happen on the loop's own thread
+    ctx.post([&, sock] {
+        ctx.get_reactor().add(*sock, poller::READABLE, [&, sock](uint32_t) {
+            char buf[64];
+            if (auto res = sock->read(buf, sizeof(buf)); res)
+                nread += res.value();
+        });
+    });
+
+    REQUIRE(wait_for([&] { return ctx.load() == 1; }));
+    REQUIRE(conn.write("hello"));
+    REQUIRE(wait_for([&] { return nread.load() == 5; }));
+
+    ctx.post([&, sock] { ctx.get_reactor().remove(*sock); });
+    REQUIRE(wait_for([&] { return ctx.load() == 0; }));
+
+    ctx.stop();
+    thr.join();
+}
+
+TEST_CASE("io_context early stop", "[io_context]") {
+    io_context ctx;
+
+    // A stop that comes before the loop starts isn't lost
+    ctx.stop();
+    std::thread thr{[&] { (void)ctx.run(); }};
+    thr.join();
+
+    // ...and it holds until it's cleared
+    std::atomic<bool> ran{false};
+    ctx.restart();
+    thr = std::thread{[&] { (void)ctx.run(); }};
+    ctx.post([&] { ran = true; });
+    REQUIRE(wait_for([&] { return ran.load(); }));
+    ctx.stop();
+    thr.join();
+}
+
+TEST_CASE("io_context_pool stop after start", "[io_context]") {
+    // The threads may not have reached their loops when the pool is
+    // destroyed. This must not hang.
+    for (int i = 0; i < 50; ++i) {
+        io_context_pool pool{2};
+        pool.start();
+    }
+
+    // A stopped pool can be started again
+    io_context_pool pool{2};
+    pool.start();
+    pool.stop();
+    pool.join();
+
+    std::atomic<bool> ran{false};
+    pool.start();
+    pool[1].post([&] { ran = true; });
+    REQUIRE(wait_for([&] { return ran.load(); }));
+}
+
+TEST_CASE("io_context_pool", "[io_context]") {
+    constexpr size_t NCTX = 3;
+    io_context_pool pool{NCTX};
+    REQUIRE(pool.size() == NCTX);
+
+    SECTION("round robin") {
+        auto& a = pool.next();
+        auto& b = pool.next();
+        auto& c = pool.next();
+        REQUIRE(&a != &b);
+        REQUIRE(&b != &c);
+        REQUIRE(&pool.next() == &a);
+    }
+
+    SECTION("least loaded") {
+        // Nothing is registered yet, so any loop will do
+        auto& ctx = pool.least_loaded();
+        REQUIRE(ctx.load() == 0);
+    }
+
+    SECTION("submit and steal") {
+        pool.start();
+
+        // Block one loop, then submit work to it. The others should pick
+        // it up while it's stuck.
+        std::atomic<bool> release{false};
+        std::atomic<int> count{0};
+        auto& busy = pool[0];
+
+        busy.post([&] {
+            while (!release) std::this_thread::yield();
+        });
+
+        constexpr int N = 20;
+        for (int i = 0; i < N; ++i) busy.submit([&] { ++count; });
+
+        bool stolen = wait_for([&] { return count.load() == N; });
+        release = true;
+        REQUIRE(stolen);
+    }
+
+    pool.stop();
+    pool.join();
+}
+
+TEST_CASE("io_context_pool placement", "[io_context]") {
+    constexpr size_t NCTX = 3;
+    io_context_pool pool{NCTX};
+    REQUIRE(pool.placement_policy() == io_context_pool::placement::round_robin);
+
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    tcp_connector cli{acc.address()};
+    auto srv = acc.accept().release();
+    REQUIRE(srv);
+
+    REQUIRE(&pool.for_cpu(1) == &pool[1]);
+    REQUIRE(&pool.for_cpu(int(NCTX) + 2) == &pool[2]);
+    REQUIRE(pool[0].cpu() == -1);
+
+    SECTION("round robin") {
+        auto& a = pool.place(srv);
+        REQUIRE(&pool.place(srv) != &a);
+    }
+
+#if defined(__linux__)
+    SECTION("incoming cpu") {
+        REQUIRE(cli.write(std::string{"hello"}));
+        char buf[8];
+        REQUIRE(srv.read_n(buf, 5).value() == 5);
+
+        auto cpu = srv.incoming_cpu();
+        REQUIRE(cpu);
+        REQUIRE(cpu.value() >= 0);
+
+        pool.placement_policy(io_context_pool::placement::incoming_cpu);
+        REQUIRE(&pool.place(srv) == &pool.for_cpu(cpu.value()));
+
+        // Loopback traffic has no device queue
+        REQUIRE(srv.napi_id().value() == 0);
+    }
+
+    SECTION("pinned") {
+        pool.start(true);
+        REQUIRE(pool[0].cpu() == 0);
+
+        // Make sure all the loops are running before stopping them
+        std::atomic<size_t> ran{0};
+        for (size_t i = 0; i < NCTX; ++i) pool[i].post([&] { ++ran; });
+        REQUIRE(wait_for([&] { return ran.load() == NCTX; }));
+        pool.stop();
+        pool.join();
+    }
+#endif
+}
@@ -0,0 +1,135 @@
+// test_memsearch.cpp
+//
+// Unit tests for the sockpp vectorized memory searches.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/memsearch.h"
+
+using namespace std;
+using namespace sockpp;
+
+namespace {
+
+const search_kernel ALL_KERNELS[] = {
+    search_kernel::generic, search_kernel::sse2, search_kernel::avx2, search_kernel::neon
+};
+
+// The reference result, as an offset, or npos
+size_t ref_find(string_view s, string_view pat) { return s.find(pat); }
+
+size_t offset(const char* p, const char* q) {
+    return q ? size_t(q - p) : string_view::npos;
+}
+
+}  // namespace
+
+TEST_CASE("memsearch kernels", "[memsearch]") {
+    REQUIRE(search_kernel_supported(search_kernel::generic));
+    REQUIRE(search_kernel_supported(default_search_kernel()));
+    REQUIRE(string{to_string(search_kernel::avx2)} == "avx2");
+}
+
+TEST_CASE("memsearch find_byte", "[memsearch]") {
+    // Every length and position up to a few vectors, so that the
+    // unrolled loop, the single vectors, and the tail are all hit.
+    for (auto k : ALL_KERNELS) {
+        if (!search_kernel_supported(k))
+            continue;
+
+        for (size_t n = 0; n <= 200; ++n) {
+            string s(n, 'a');
+            REQUIRE(find_byte(k, s.data(), n, '\n') == nullptr);
+
+            for (size_t i = 0; i < n; ++i) {
+                s[i] = '\n';
+                REQUIRE(offset(s.data(), find_byte(k, s.data(), n, '\n')) == i);
+                s[i] = 'a';
+            }
+        }
+
+        // Only the first of several matches
+        string s(100, '\n');
+        REQUIRE(find_byte(k, s.data() + 3, 97, '\n') == s.data() + 3);
+    }
+}
+
+TEST_CASE("memsearch find_seq", "[memsearch]") {
+    const string_view pats[] = {"", "\n", "\r\n", "\r\n\r\n", "--boundary--"};
+
+    for (auto k : ALL_KERNELS) {
+        if (!search_kernel_supported(k))
+            continue;
+
+        for (auto pat : pats) {
+            for (size_t n = 0; n <= 100; ++n) {
+                // Partial matches everywhere: the first and last bytes of
+                // the pattern, but not the middle.
+                string s;
+                while (s.size() < n) s += (s.size() % 3 == 0) ? '\r' : '\n';
+                s.resize(n);
+
+                if (pat.size() < 3)
+                    s.assign(n, 'x');
+
+                REQUIRE(offset(s.data(), find_seq(k, s.data(), n, pat)) == ref_find(s, pat));
+
+                for (size_t i = 0; i + pat.size() <= n; ++i) {
+                    auto t = s;
+                    t.replace(i, pat.size(), pat);
+                    REQUIRE(offset(t.data(), find_seq(k, t.data(), n, pat)) == ref_find(t, pat));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("memsearch default kernel", "[memsearch]") {
+    string s(1000, 'x');
+    s.replace(777, 2, "\r\n");
+
+    REQUIRE(find_byte(s.data(), s.size(), '\n') == s.data() + 778);
+    REQUIRE(find_seq(s.data(), s.size(), "\r\n") == s.data() + 777);
+    REQUIRE(find_seq(s.data(), 778, "\r\n") == nullptr);
+}
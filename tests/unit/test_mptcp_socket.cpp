@@ -0,0 +1,85 @@
+// test_mptcp_socket.cpp
+//
+// Unit tests for the sockpp MPTCP sockets.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/mptcp_acceptor.h"
+#include "sockpp/mptcp_connector.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("mptcp socket", "[mptcp]") {
+    REQUIRE(mptcp_socket::PROTOCOL == IPPROTO_MPTCP);
+    REQUIRE(mptcp_connector{}.create_protocol() == IPPROTO_MPTCP);
+
+    auto sockRes = mptcp_socket::create();
+    if (!sockRes) {
+        REQUIRE(sockRes == errc::protocol_not_supported);
+        WARN("MPTCP is not supported. Skipping.");
+        return;
+    }
+    REQUIRE(sockRes.value().get_option<int>(SOL_SOCKET, SO_PROTOCOL).value() == IPPROTO_MPTCP);
+
+    mptcp_acceptor acc{inet_address{"localhost", 0}};
+    REQUIRE(acc);
+    REQUIRE(acc.get_option<int>(SOL_SOCKET, SO_PROTOCOL).value() == IPPROTO_MPTCP);
+
+    mptcp_connector conn{acc.address()};
+    REQUIRE(conn);
+    REQUIRE(conn.get_option<int>(SOL_SOCKET, SO_PROTOCOL).value() == IPPROTO_MPTCP);
+
+    auto srvRes = acc.accept();
+    REQUIRE(srvRes);
+    auto srv = srvRes.release();
+
+    REQUIRE(conn.write(string{"hello"}).value() == 5);
+
+    char buf[8];
+    REQUIRE(srv.read_n(buf, 5).value() == 5);
+    REQUIRE(string(buf, 5) == "hello");
+
+    SECTION("reconnect keeps the protocol") {
+        REQUIRE(conn.connect(acc.address()));
+        REQUIRE(conn.get_option<int>(SOL_SOCKET, SO_PROTOCOL).value() == IPPROTO_MPTCP);
+    }
+}
@@ -0,0 +1,99 @@
+// test_notifier.cpp
+//
+// Unit tests for the sockpp notifier class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <atomic>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/notifier.h"
+#include "sockpp/reactor.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("notifier", "[notifier]") {
+    notifier ntfy;
+    REQUIRE(ntfy.is_open());
+    REQUIRE(!ntfy.pending());
+
+    reactor rx;
+    int nwake = 0;
+    REQUIRE(rx.add(ntfy.handle(), poller::READABLE, [&](uint32_t) {
+        if (ntfy.reset())
+            ++nwake;
+    }));
+
+    SECTION("idle") {
+        REQUIRE(rx.run_once(milliseconds{10}).value() == 0);
+        REQUIRE(nwake == 0);
+    }
+
+    SECTION("coalesced") {
+        ntfy.notify();
+        ntfy.notify();
+        ntfy.notify();
+        REQUIRE(ntfy.pending());
+
+        REQUIRE(rx.run_once(milliseconds{1000}).value() == 1);
+        REQUIRE(nwake == 1);
+        REQUIRE(!ntfy.pending());
+
+        // Drained, so it doesn't fire again
+        REQUIRE(rx.run_once(milliseconds{10}).value() == 0);
+
+        ntfy.notify();
+        REQUIRE(rx.run_once(milliseconds{1000}).value() == 1);
+        REQUIRE(nwake == 2);
+    }
+
+    SECTION("other thread") {
+        thread thr{[&] {
+            this_thread::sleep_for(milliseconds{10});
+            ntfy.notify();
+        }};
+
+        REQUIRE(rx.run_once(milliseconds{5000}).value() == 1);
+        REQUIRE(nwake == 1);
+        thr.join();
+    }
+
+    REQUIRE(rx.remove(ntfy.handle()));
+}
@@ -0,0 +1,176 @@
+// test_pacer.cpp
+//
+// Unit tests for the sockpp pacer class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/pacer.h"
+#include "sockpp/socket_stats.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/write_queue.h"
+#include "tcp_pair.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("pacer bucket", "[pacer]") {
+    SECTION("unlimited") {
+        pacer pc{0};
+        auto t0 = pacer::clock::now();
+        REQUIRE(pc.take(1000000, t0) == 1000000);
+        REQUIRE(pc.delay(1000000, t0) == nanoseconds{0});
+        REQUIRE(!pc.throttled());
+    }
+
+    SECTION("default burst") {
+        REQUIRE(pacer{1000}.burst() == pacer::MIN_BURST);
+        REQUIRE(pacer{100000000}.burst() == 1000000);
+    }
+
+    SECTION("refill") {
+        // 1000 bytes/sec, with a 100 byte bucket
+        pacer pc{1000, 100};
+        auto t0 = pacer::clock::now();
+        REQUIRE(pc.burst() == 100);
+
+        REQUIRE(pc.take(60, t0) == 60);
+        REQUIRE(pc.take(60, t0) == 40);
+        REQUIRE(pc.throttled());
+        REQUIRE(pc.take(10, t0) == 0);
+
+        // 10ms adds 10 bytes
+        REQUIRE(pc.delay(10, t0) == milliseconds{10});
+        REQUIRE(pc.allow(100, t0 + milliseconds{10}) == 10);
+
+        // The bucket never holds more than the burst
+        REQUIRE(pc.allow(1000, t0 + seconds{5}) == 100);
+        REQUIRE(pc.delay(1000, t0 + seconds{5}) == nanoseconds{0});
+    }
+
+    SECTION("throttle time") {
+        pacer pc{1000, 100};
+        auto t0 = pacer::clock::now();
+        auto before = socket_stats::snapshot();
+
+        REQUIRE(pc.take(200, t0) == 100);
+        REQUIRE(pc.throttled());
+
+        // Still held back
+        REQUIRE(pc.take(100, t0 + milliseconds{50}) == 50);
+        REQUIRE(pc.throttled_time() == nanoseconds{0});
+
+        // The hold ends once a send is fully allowed
+        REQUIRE(pc.take(50, t0 + milliseconds{100}) == 50);
+        REQUIRE(!pc.throttled());
+        REQUIRE(pc.throttled_time() == milliseconds{100});
+
+        auto diff = socket_stats::snapshot() - before;
+        if (socket_stats::enabled()) {
+            REQUIRE(diff.throttles == 1);
+            REQUIRE(diff.throttleNanos == 100000000);
+        }
+        else {
+            REQUIRE(diff.throttles == 0);
+        }
+    }
+
+    SECTION("change rate") {
+        pacer pc{1000, 100};
+        REQUIRE(pc.take(60) == 60);
+
+        pc.rate(10000, 20);
+        REQUIRE(pc.rate() == 10000);
+        REQUIRE(pc.burst() == 20);
+        REQUIRE(pc.allow(100) == 20);
+    }
+}
+
+TEST_CASE("pacer write_n", "[pacer]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    // Slow enough that nothing is earned while the test runs
+    pacer pc{10, 100};
+    string msg(150, 'x');
+
+    auto res = p.cli.write_n(msg.data(), msg.size(), pc);
+    REQUIRE(res.value() == 100);
+
+    // The bucket is empty, so nothing more goes right away
+    res = p.cli.write_n(msg.data() + 100, 50, pc);
+    REQUIRE(res == errc::operation_would_block);
+    REQUIRE(pc.delay(50) > nanoseconds{0});
+
+    char buf[256];
+    REQUIRE(p.srv.read_n(buf, 100).value() == 100);
+}
+
+TEST_CASE("pacer write_queue", "[pacer]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    pacer pc{10, 100};
+    write_queue que{p.cli};
+    REQUIRE(que.get_pacer() == nullptr);
+    REQUIRE(que.flush_delay() == nanoseconds{0});
+
+    que.set_pacer(&pc);
+    REQUIRE(que.get_pacer() == &pc);
+
+    REQUIRE(que.push(string(60, 'a')));
+    REQUIRE(que.push(string(60, 'b')));
+    REQUIRE(que.size() == 120);
+
+    // Only the burst is sent
+    REQUIRE(que.flush().value() == 100);
+    REQUIRE(que.size() == 20);
+    REQUIRE(que.flush_delay() > nanoseconds{0});
+
+    // Nothing more until the bucket refills
+    REQUIRE(que.flush().value() == 0);
+    REQUIRE(que.size() == 20);
+
+    char buf[256];
+    REQUIRE(p.srv.read_n(buf, 100).value() == 100);
+    REQUIRE(string(buf, 60) == string(60, 'a'));
+    REQUIRE(string(buf + 60, 40) == string(40, 'b'));
+}
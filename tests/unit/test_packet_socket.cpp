@@ -0,0 +1,167 @@
+// test_packet_socket.cpp
+//
+// Unit tests for the packet_address and packet_socket classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <cstring>
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/packet_socket.h"
+
+using namespace sockpp;
+using namespace std;
+
+// These use the loopback interface with a local experimental EtherType,
+// so that the test packets don't get mixed up with anything else.
+
+static const string IFACE{"lo"};
+static const uint16_t PROTO = 0x88B5;
+
+// Makes an Ethernet frame for the test protocol with a sequence number.
+static vector<uint8_t> make_frame(uint32_t seq) {
+    vector<uint8_t> frame(64, 0);
+    frame[12] = uint8_t(PROTO >> 8);
+    frame[13] = uint8_t(PROTO & 0xFF);
+    memcpy(&frame[14], &seq, sizeof(seq));
+    return frame;
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("packet_address", "[packet]") {
+    auto res = packet_address::create(IFACE, PROTO);
+    REQUIRE(res);
+
+    auto addr = res.value();
+    REQUIRE(addr.family() == AF_PACKET);
+    REQUIRE(addr.index() > 0);
+    REQUIRE(addr.protocol() == PROTO);
+    REQUIRE(addr.iface() == IFACE);
+    REQUIRE(addr.to_string() == "packet:lo");
+
+    REQUIRE(!packet_address::create("nonexistent0"));
+}
+
+TEST_CASE("packet_socket rings", "[packet]") {
+    auto addr = packet_address::create(IFACE, PROTO).value();
+
+    packet_ring_params params;
+    params.block_size = 1 << 16;
+    params.rx_blocks = 4;
+    params.retire_timeout = milliseconds{1};
+
+    error_code ec;
+    packet_socket rcvr{addr, params, ec};
+    if (ec == errc::operation_not_permitted) {
+        WARN("No permission for a packet socket. Skipping.");
+        return;
+    }
+    REQUIRE(!ec);
+    REQUIRE(rcvr.has_rx_ring());
+    REQUIRE(!rcvr.has_tx_ring());
+
+    packet_ring_params txParams;
+    txParams.block_size = 1 << 16;
+    txParams.rx_blocks = 0;
+    txParams.tx_frames = 8;
+
+    packet_socket sender{addr, txParams};
+    REQUIRE(sender.has_tx_ring());
+    REQUIRE(!sender.has_rx_ring());
+    REQUIRE(sender.tx_max_size() > 1024);
+
+    const uint32_t N = 4;
+    for (uint32_t i = 0; i < N; ++i) {
+        auto frame = make_frame(i);
+        REQUIRE(sender.tx_queue(frame.data(), frame.size()));
+    }
+    REQUIRE(sender.tx_flush(true) == size_t(N * 64));
+
+    // The loopback reports each frame as outgoing, then again as received.
+    uint32_t n = 0;
+    bool ok = true;
+
+    for (int i = 0; i < 10 && n < N; ++i) {
+        auto res = rcvr.read(
+            [&](const packet_socket::packet& pkt) {
+                if (pkt.outgoing())
+                    return;
+                uint32_t seq;
+                memcpy(&seq, pkt.data() + 14, sizeof(seq));
+                ok = ok && pkt.size() == 64 && seq == n && pkt.timestamp().count() != 0;
+                ++n;
+            },
+            milliseconds{100}
+        );
+        REQUIRE(res);
+    }
+
+    REQUIRE(ok);
+    REQUIRE(n == N);
+
+    auto st = rcvr.stats();
+    REQUIRE(st);
+    REQUIRE(st.value().tp_drops == 0);
+
+    SECTION("oversized") {
+        vector<uint8_t> big(sender.tx_max_size() + 1);
+        REQUIRE(sender.tx_queue(big.data(), big.size()) == errc::message_size);
+    }
+
+    SECTION("no ring") {
+        packet_socket sock{addr};
+        REQUIRE(sock.tx_queue("x", 1) == errc::bad_file_descriptor);
+        REQUIRE(sock.read([](const packet_socket::packet&) {}, milliseconds{0}) ==
+                errc::bad_file_descriptor);
+    }
+
+    SECTION("fanout") {
+        packet_socket s1{addr}, s2{addr};
+        REQUIRE(s1.fanout(0x5150));
+        REQUIRE(s2.fanout(0x5150));
+    }
+
+    SECTION("bad params") {
+        packet_ring_params bad;
+        bad.block_size = 1000;
+        packet_socket sock;
+        REQUIRE(sock.open(addr, bad) == errc::invalid_argument);
+        REQUIRE(!sock);
+    }
+}
@@ -0,0 +1,225 @@
+// test_protocol_sniffer.cpp
+//
+// Unit tests for the sockpp protocol_sniffer class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <string>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/protocol_sniffer.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace sockpp;
+
+using match = protocol_sniffer::match;
+
+namespace {
+
+// A server that sorts its connections into TLS, HTTP, and the rest.
+struct server
+{
+    reactor rx;
+    protocol_sniffer sniffer;
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    vector<stream_socket> tls, http, other;
+
+    explicit server(milliseconds timeout = milliseconds{2000}) : sniffer{rx, timeout} {
+        sniffer.add(protocol_sniffer::tls(), [this](stream_socket s) {
+            tls.push_back(std::move(s));
+        });
+        sniffer.add(protocol_sniffer::http(), [this](stream_socket s) {
+            http.push_back(std::move(s));
+        });
+        rx.on_tick([this] { sniffer.expire(); });
+    }
+
+    size_t handled() const { return tls.size() + http.size() + other.size(); }
+
+    // Runs the loop until n connections are handed off
+    void run(size_t n) {
+        for (int i = 0; i < 100 && handled() < n; ++i) rx.run_once(milliseconds{10});
+    }
+};
+
+// Reads exactly n bytes from a connection that was handed off
+string read_all(stream_socket& sock, size_t n) {
+    string s(n, '\0');
+    auto res = sock.read_n(&s[0], n);
+    return res ? s.substr(0, res.value()) : string{};
+}
+
+}  // namespace
+
+TEST_CASE("protocol_sniffer matchers", "[protocol_sniffer]") {
+    SECTION("prefix") {
+        auto m = protocol_sniffer::prefix("SSH-");
+        REQUIRE(m("SSH-2.0-OpenSSH") == match::yes);
+        REQUIRE(m("SSH-") == match::yes);
+        REQUIRE(m("SS") == match::more);
+        REQUIRE(m("SX") == match::no);
+    }
+
+    SECTION("tls") {
+        auto m = protocol_sniffer::tls();
+        REQUIRE(m(string{"\x16\x03\x01\x02\x00", 5}) == match::yes);
+        REQUIRE(m(string{"\x16\x03\x04", 3}) == match::yes);
+        REQUIRE(m(string{"\x16\x03", 2}) == match::more);
+        REQUIRE(m(string{"\x16", 1}) == match::more);
+        REQUIRE(m(string{"\x16\x03\x05", 3}) == match::no);
+        REQUIRE(m(string{"\x17\x03\x03", 3}) == match::no);
+        REQUIRE(m("GET / HTTP/1.1") == match::no);
+    }
+
+    SECTION("http") {
+        auto m = protocol_sniffer::http();
+        REQUIRE(m("GET / HTTP/1.1\r\n") == match::yes);
+        REQUIRE(m("OPTIONS * HTTP/1.1") == match::yes);
+        REQUIRE(m("PRI * HTTP/2.0\r\n") == match::yes);
+        REQUIRE(m("P") == match::more);
+        REQUIRE(m("PU") == match::more);
+        REQUIRE(m("GET/") == match::no);
+        REQUIRE(m(string{"\x16\x03\x01", 3}) == match::no);
+    }
+}
+
+TEST_CASE("protocol_sniffer dispatch", "[protocol_sniffer]") {
+    server srv;
+    REQUIRE(srv.sniffer.attach(srv.acc));
+
+    SECTION("by protocol") {
+        const string TLS_HELLO{"\x16\x03\x01\x00\x05hello", 10};
+        const string REQ{"GET /index.html HTTP/1.1\r\n\r\n"};
+
+        tcp_connector c1{srv.acc.address()}, c2{srv.acc.address()};
+        REQUIRE(c1.write(TLS_HELLO));
+        REQUIRE(c2.write(REQ));
+
+        srv.run(2);
+        REQUIRE(srv.tls.size() == 1);
+        REQUIRE(srv.http.size() == 1);
+        REQUIRE(srv.sniffer.pending() == 0);
+
+        // The handlers get the sockets untouched, in blocking mode
+        REQUIRE(!srv.tls[0].is_non_blocking());
+        REQUIRE(read_all(srv.tls[0], TLS_HELLO.size()) == TLS_HELLO);
+        REQUIRE(read_all(srv.http[0], REQ.size()) == REQ);
+    }
+
+    SECTION("partial data") {
+        tcp_connector cli{srv.acc.address()};
+        REQUIRE(cli.write(string{"\x16"}));
+
+        for (int i = 0; i < 10; ++i) srv.rx.run_once(milliseconds{5});
+        REQUIRE(srv.handled() == 0);
+        REQUIRE(srv.sniffer.pending() == 1);
+
+        REQUIRE(cli.write(string{"\x03\x03"}));
+        srv.run(1);
+        REQUIRE(srv.tls.size() == 1);
+        REQUIRE(srv.tls[0].recv_lowat().value() == 1);
+        REQUIRE(read_all(srv.tls[0], 3) == string{"\x16\x03\x03"});
+    }
+
+    SECTION("no match") {
+        srv.sniffer.set_fallback([&](stream_socket s) { srv.other.push_back(std::move(s)); });
+
+        tcp_connector cli{srv.acc.address()};
+        REQUIRE(cli.write(string{"SSH-2.0-x\r\n"}));
+
+        srv.run(1);
+        REQUIRE(srv.other.size() == 1);
+        REQUIRE(read_all(srv.other[0], 4) == "SSH-");
+    }
+
+    SECTION("no match without a fallback") {
+        tcp_connector cli{srv.acc.address()};
+        REQUIRE(cli.write(string{"hello"}));
+
+        for (int i = 0; i < 100 && srv.sniffer.pending() == 0; ++i)
+            srv.rx.run_once(milliseconds{10});
+        for (int i = 0; i < 100 && srv.sniffer.pending() != 0; ++i)
+            srv.rx.run_once(milliseconds{10});
+
+        // The server closed the connection
+        char buf[16];
+        REQUIRE(cli.read_timeout(seconds{1}));
+        auto res = cli.read(buf, sizeof(buf));
+        REQUIRE((!res || res.value() == 0));
+        REQUIRE(srv.handled() == 0);
+    }
+
+    srv.sniffer.detach(srv.acc);
+}
+
+TEST_CASE("protocol_sniffer timeout", "[protocol_sniffer]") {
+    server srv{milliseconds{50}};
+    srv.sniffer.set_fallback([&](stream_socket s) { srv.other.push_back(std::move(s)); });
+
+    tcp_connector cli{srv.acc.address()};
+    auto res = srv.acc.accept();
+    REQUIRE(res);
+    REQUIRE(srv.sniffer.add_connection(res.release()));
+    REQUIRE(srv.sniffer.pending() == 1);
+
+    auto ms = srv.sniffer.next_timeout();
+    REQUIRE(ms.count() >= 0);
+    REQUIRE(ms <= milliseconds{50});
+
+    // The client never sends anything
+    srv.run(1);
+    REQUIRE(srv.other.size() == 1);
+    REQUIRE(srv.sniffer.pending() == 0);
+    REQUIRE(srv.sniffer.next_timeout() == milliseconds{-1});
+}
+
+TEST_CASE("acceptor defer_accept", "[protocol_sniffer]") {
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    auto res = acc.defer_accept(seconds{1});
+
+    if (res == errc::operation_not_supported) {
+        WARN("Deferred accept not supported. Skipping.");
+        return;
+    }
+    REQUIRE(res);
+    REQUIRE(acc.defer_accept(seconds{0}));
+}
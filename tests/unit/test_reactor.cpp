@@ -0,0 +1,186 @@
+// test_reactor.cpp
+//
+// Unit tests for the `poller` and `reactor` classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/reactor.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "tcp_pair.h"
+
+using namespace sockpp;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("poller add/remove", "[poller]") {
+    poller pl;
+    REQUIRE(pl.empty());
+
+    auto [csock, ssock] = make_tcp_pair();
+
+    REQUIRE(pl.add(ssock, poller::READABLE));
+    REQUIRE(pl.size() == 1);
+    REQUIRE(!pl.add(ssock, poller::READABLE));
+
+    REQUIRE(pl.remove(ssock));
+    REQUIRE(pl.empty());
+    REQUIRE(!pl.remove(ssock));
+}
+
+TEST_CASE("poller wait", "[poller]") {
+    poller pl;
+    auto [csock, ssock] = make_tcp_pair();
+
+    REQUIRE(pl.add(ssock, poller::READABLE));
+
+    std::vector<poller::event> evts;
+
+    SECTION("timeout") {
+        auto res = pl.wait(evts, milliseconds{10});
+        REQUIRE(res);
+        REQUIRE(res.value() == 0);
+        REQUIRE(evts.empty());
+    }
+
+    SECTION("readable") {
+        REQUIRE(csock.write_n("hello", 5).value() == 5);
+
+        auto res = pl.wait(evts, milliseconds{1000});
+        REQUIRE(res.value() == 1);
+        REQUIRE(evts[0].handle == ssock.handle());
+        REQUIRE(evts[0].readable());
+    }
+
+    SECTION("writable") {
+        REQUIRE(pl.modify(ssock, poller::WRITABLE));
+
+        auto res = pl.wait(evts, milliseconds{1000});
+        REQUIRE(res.value() == 1);
+        REQUIRE(evts[0].writable());
+        REQUIRE(!evts[0].readable());
+    }
+
+    SECTION("hangup") {
+        csock.close();
+
+        auto res = pl.wait(evts, milliseconds{1000});
+        REQUIRE(res.value() == 1);
+        REQUIRE(evts[0].readable());
+    }
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("reactor dispatch", "[reactor]") {
+    reactor rx;
+    auto [csock, ssock] = make_tcp_pair();
+    ssock.set_non_blocking();
+
+    std::string recvd;
+
+    REQUIRE(rx.add(ssock, poller::READABLE, [&](uint32_t events) {
+        REQUIRE((events & poller::READABLE) != 0);
+        char buf[64];
+        auto res = ssock.read(buf, sizeof(buf));
+        if (res.value() == 0) {
+            rx.remove(ssock);
+            return;
+        }
+        recvd.append(buf, res.value());
+        if (recvd.size() >= 5)
+            rx.stop();
+    }));
+
+    REQUIRE(rx.contains(ssock.handle()));
+    REQUIRE(!rx.add(ssock, poller::READABLE, [](uint32_t) {}));
+
+    SECTION("run until stopped") {
+        REQUIRE(csock.write_n("hello", 5).value() == 5);
+        REQUIRE(rx.run());
+        REQUIRE(rx.stopped());
+        REQUIRE(recvd == "hello");
+    }
+
+    SECTION("remove from handler") {
+        csock.close();
+        REQUIRE(rx.run());
+        REQUIRE(rx.empty());
+    }
+
+    SECTION("run_once timeout") {
+        auto res = rx.run_once(milliseconds{10});
+        REQUIRE(res);
+        REQUIRE(res.value() == 0);
+    }
+
+    SECTION("tick after dispatch") {
+        size_t nrecvd = 0;
+        rx.on_tick([&] { nrecvd = recvd.size(); });
+
+        REQUIRE(csock.write_n("hi", 2).value() == 2);
+        REQUIRE(rx.run_once(milliseconds{1000}).value() == 1);
+        REQUIRE(nrecvd == 2);
+    }
+}
+
+TEST_CASE("reactor for_each_handle", "[reactor]") {
+    reactor rx;
+    auto [c1, s1] = make_tcp_pair();
+    auto [c2, s2] = make_tcp_pair();
+
+    REQUIRE(rx.add(s1, poller::READABLE, [](uint32_t) {}));
+    REQUIRE(rx.add(s2, poller::READABLE, [](uint32_t) {}));
+
+    // Sample the TCP state of all the connections
+    size_t n = 0, nok = 0;
+    rx.for_each_handle([&](socket_t h) {
+        REQUIRE((h == s1.handle() || h == s2.handle()));
+        ++n;
+        if (stream_socket::tcp_info(h))
+            ++nok;
+    });
+
+    REQUIRE(n == 2);
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+    REQUIRE(nok == 2);
+#endif
+}
@@ -0,0 +1,177 @@
+// test_relay.cpp
+//
+// Unit tests for the sockpp relay class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <string>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/relay.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "tcp_pair.h"
+
+using namespace std;
+using namespace sockpp;
+
+namespace {
+
+// Runs the reactor until the condition is met, or it's clear it won't be.
+template <typename F>
+bool run_until(reactor& rx, F cond) {
+    for (int i = 0; i < 500 && !cond(); ++i)
+        rx.run_once(milliseconds{10});
+    return cond();
+}
+
+}  // namespace
+
+// The relay joins the server side of one pair to the client side of the
+// other, so data written on p1.cli comes out of p2.srv, and back.
+
+TEST_CASE("relay in a reactor", "[relay]") {
+    tcp_pair p1, p2;
+    REQUIRE(p1.srv);
+    REQUIRE(p2.srv);
+
+    reactor rx;
+    relay rly{p1.srv, p2.cli};
+
+#if defined(__linux__)
+    REQUIRE(rly.is_spliced());
+#endif
+
+    bool finished = false;
+    error_code err;
+    REQUIRE(rly.attach(rx, [&](relay&, error_code ec) {
+        finished = true;
+        err = ec;
+    }));
+    REQUIRE(rx.size() == 2);
+
+    REQUIRE(p1.cli.write(string{"hello"}));
+    REQUIRE(p2.srv.write(string{"world!"}));
+
+    REQUIRE(run_until(rx, [&] { return rly.bytes_a_to_b() == 5 && rly.bytes_b_to_a() == 6; }));
+
+    char buf[16];
+    REQUIRE(p2.srv.read_n(buf, 5).value() == 5);
+    REQUIRE(string(buf, 5) == "hello");
+    REQUIRE(p1.cli.read_n(buf, 6).value() == 6);
+    REQUIRE(string(buf, 6) == "world!");
+
+    // A half-close is passed along, and the other direction keeps working
+    REQUIRE(p1.cli.shutdown(SHUT_WR));
+    REQUIRE(p2.srv.set_non_blocking());
+    REQUIRE(run_until(rx, [&] {
+        auto res = p2.srv.read(buf, sizeof(buf));
+        return res && res.value() == 0;
+    }));
+    REQUIRE(p2.srv.set_non_blocking(false));
+    REQUIRE(!finished);
+
+    REQUIRE(p2.srv.write(string{"bye"}));
+    REQUIRE(run_until(rx, [&] { return rly.bytes_b_to_a() == 9; }));
+    REQUIRE(p1.cli.read_n(buf, 3).value() == 3);
+
+    REQUIRE(p2.srv.shutdown(SHUT_WR));
+    REQUIRE(run_until(rx, [&] { return finished; }));
+    REQUIRE(!err);
+    REQUIRE(rly.done());
+    REQUIRE(rx.empty());
+    REQUIRE(p1.cli.read(buf, sizeof(buf)).value() == 0);
+}
+
+TEST_CASE("relay run", "[relay]") {
+    tcp_pair p1, p2;
+    REQUIRE(p1.srv);
+    REQUIRE(p2.srv);
+
+    // More than fits in the socket buffers, so the relay has to wait on
+    // the destination.
+    const size_t N = 4 * 1024 * 1024;
+
+    relay rly{p1.srv, p2.cli};
+    result<> relayRes;
+    thread relayThr([&] { relayRes = rly.run(); });
+
+    thread writer([&] {
+        string data(N, 'x');
+        p1.cli.write_n(data.data(), data.size());
+        p1.cli.shutdown(SHUT_WR);
+    });
+
+    vector<char> buf(64 * 1024);
+    size_t n = 0;
+    result<size_t> res;
+    while ((res = p2.srv.read(buf.data(), buf.size())) && res.value() > 0)
+        n += res.value();
+
+    p2.srv.shutdown(SHUT_WR);
+    writer.join();
+    relayThr.join();
+
+    REQUIRE(res);
+    REQUIRE(n == N);
+    REQUIRE(relayRes);
+    REQUIRE(rly.bytes_a_to_b() == N);
+    REQUIRE(rly.bytes_b_to_a() == 0);
+}
+
+TEST_CASE("relay error", "[relay]") {
+    tcp_pair p1, p2;
+    REQUIRE(p1.srv);
+
+    reactor rx;
+    relay rly{p1.srv, p2.cli};
+
+    bool finished = false;
+    error_code err;
+    REQUIRE(rly.attach(rx, [&](relay&, error_code ec) {
+        finished = true;
+        err = ec;
+    }));
+
+    // A reset on one side ends the relay
+    REQUIRE(p1.cli.abort());
+    REQUIRE(run_until(rx, [&] { return finished; }));
+    REQUIRE(err);
+    REQUIRE(rx.empty());
+}
@@ -0,0 +1,149 @@
+// test_resolver.cpp
+//
+// Unit tests for the sockpp resolver class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <future>
+#include <string>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/resolver.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("resolver lookup", "[resolver]") {
+    auto res = resolver::lookup("127.0.0.1", 12345);
+    REQUIRE(res);
+    REQUIRE(res.value().size() == 1);
+    REQUIRE(inet_address{res.value()[0]} == inet_address{"127.0.0.1", 12345});
+
+    res = resolver::lookup("::1", 12345, AF_INET6);
+    if (res) {
+        REQUIRE(res.value().size() == 1);
+        REQUIRE(res.value()[0].family() == AF_INET6);
+    }
+
+    REQUIRE(!resolver::lookup("bad.address.invalid", 12345));
+}
+
+TEST_CASE("resolver cache", "[resolver]") {
+    resolver rslv;
+    REQUIRE(rslv.cache_size() == 0);
+
+    auto res = rslv.resolve("localhost", 80, AF_INET);
+    REQUIRE(res);
+    REQUIRE(rslv.cache_size() == 1);
+    REQUIRE(inet_address{res.value()[0]}.port() == 80);
+
+    // Same name, different port, comes from the cache
+    res = rslv.resolve("localhost", 8080, AF_INET);
+    REQUIRE(res);
+    REQUIRE(rslv.cache_size() == 1);
+    REQUIRE(inet_address{res.value()[0]}.port() == 8080);
+
+    SECTION("negative") {
+        auto res = rslv.resolve("bad.address.invalid", 80);
+        REQUIRE(!res);
+        REQUIRE(rslv.cache_size() == 2);
+
+        auto res2 = rslv.try_resolve("bad.address.invalid", 80);
+        REQUIRE(res2.error() == res.error());
+    }
+
+    SECTION("clear") {
+        rslv.clear_cache();
+        REQUIRE(rslv.cache_size() == 0);
+    }
+
+    SECTION("limit") {
+        resolver rslv2{1, resolver::DFLT_TTL, resolver::DFLT_NEGATIVE_TTL, 2};
+        rslv2.resolve("127.0.0.1", 80);
+        rslv2.resolve("127.0.0.2", 80);
+        rslv2.resolve("127.0.0.3", 80);
+        REQUIRE(rslv2.cache_size() == 2);
+    }
+}
+
+TEST_CASE("resolver async", "[resolver]") {
+    resolver rslv;
+
+    SECTION("handler") {
+        std::promise<resolver::result_type> prom;
+        auto fut = prom.get_future();
+
+        rslv.resolve_async("localhost", 80, [&prom](resolver::result_type res) {
+            prom.set_value(std::move(res));
+        });
+
+        REQUIRE(fut.wait_for(seconds(5)) == std::future_status::ready);
+        auto res = fut.get();
+        REQUIRE(res);
+        REQUIRE(!res.value().empty());
+        REQUIRE(rslv.cache_size() == 1);
+    }
+
+    SECTION("try") {
+        auto res = rslv.try_resolve("127.0.0.1", 80);
+        REQUIRE(res == errc::operation_would_block);
+
+        auto deadline = steady_clock::now() + seconds(5);
+        while (res == errc::operation_would_block && steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(milliseconds(1));
+            res = rslv.try_resolve("127.0.0.1", 80);
+        }
+
+        REQUIRE(res);
+        REQUIRE(inet_address{res.value()[0]} == inet_address{"127.0.0.1", 80});
+    }
+}
+
+TEST_CASE("resolver connect", "[resolver]") {
+    resolver rslv;
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+
+    tcp_connector conn;
+    REQUIRE(conn.connect("localhost", acc.address().port(), rslv));
+    REQUIRE(conn.peer_address() == acc.address());
+    REQUIRE(rslv.cache_size() == 1);
+}
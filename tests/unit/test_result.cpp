@@ -150,3 +150,51 @@ TEST_CASE("test result no error", "[result]") {
     REQUIRE(res.value() == int{});
     REQUIRE(res.value() != 42);
 }
+
+TEST_CASE("test result compact", "[result]") {
+    // Trivially-copyable results pack the value with the error
+    REQUIRE(sizeof(result<size_t>) <= 2 * sizeof(void*));
+    REQUIRE(sizeof(result<>) <= 2 * sizeof(void*));
+    REQUIRE(std::is_trivially_copyable<result<size_t>>::value);
+
+    auto res = result<size_t>::from_error(EAGAIN);
+    REQUIRE(!res);
+    REQUIRE(res.value() == 0);
+    REQUIRE(res.release() == 0);
+    REQUIRE(res.error() == error_code{EAGAIN, std::system_category()});
+    REQUIRE(res.error().category() == std::system_category());
+
+    res = size_t{512};
+    REQUIRE(res);
+    REQUIRE(res.value() == 512);
+    REQUIRE(res.error() == error_code{});
+}
+
+TEST_CASE("test result is_error", "[result]") {
+    auto res = result<size_t>::from_error(EINTR);
+    REQUIRE(res.is_error(errc::interrupted));
+    REQUIRE(!res.is_error(errc::bad_address));
+
+    auto gres = result<size_t>{errc::interrupted};
+    REQUIRE(gres.is_error(errc::interrupted));
+    REQUIRE(gres == errc::interrupted);
+    REQUIRE(gres != errc::timed_out);
+
+    auto ok = result<size_t>{size_t{1}};
+    REQUIRE(!ok.is_error(errc::interrupted));
+
+    // Non-trivial types use the general storage.
+    auto sres = result<string>::from_error(EINTR);
+    REQUIRE(sres.is_error(errc::interrupted));
+    REQUIRE(sres.value().empty());
+}
+
+TEST_CASE("test result is_would_block", "[result]") {
+    REQUIRE(result<size_t>{errc::operation_would_block}.is_would_block());
+    REQUIRE(result<size_t>{errc::resource_unavailable_try_again}.is_would_block());
+    REQUIRE(result<size_t>::from_error(EAGAIN).is_would_block());
+    REQUIRE(result<>::from_error(EWOULDBLOCK).is_would_block());
+
+    REQUIRE(!result<size_t>{errc::interrupted}.is_would_block());
+    REQUIRE(!result<size_t>{size_t{0}}.is_would_block());
+}
@@ -0,0 +1,95 @@
+// test_sctp_socket.cpp
+//
+// Unit tests for the sockpp SCTP sockets.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/sctp_acceptor.h"
+#include "sockpp/sctp_connector.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("sctp socket", "[sctp]") {
+    REQUIRE(sctp_socket::PROTOCOL == IPPROTO_SCTP);
+    REQUIRE(sctp_connector{}.create_protocol() == IPPROTO_SCTP);
+
+    sctp_acceptor acc;
+    auto res = acc.open(inet_address{"localhost", 0});
+    if (!res) {
+        REQUIRE(res == errc::protocol_not_supported);
+        WARN("SCTP is not supported. Skipping.");
+        return;
+    }
+
+    sctp_connector conn;
+    REQUIRE(conn.open());
+    REQUIRE(sctp_socket::init_streams(conn, 4, 4));
+    REQUIRE(conn.connect(acc.address()));
+
+    auto srvRes = acc.accept();
+    REQUIRE(srvRes);
+    sctp_socket srv = srvRes.release();
+    REQUIRE(srv.recv_info());
+
+    sctp_socket cli{std::move(conn)};
+    REQUIRE(cli.out_streams().value() == 4);
+    REQUIRE(srv.in_streams().value() == 4);
+    REQUIRE(cli.nodelay(true));
+
+    // Messages keep their boundaries and their streams
+    REQUIRE(cli.send("one", 3, sctp_msg_info{2, 0, false}).value() == 3);
+    REQUIRE(cli.send("three", 5, sctp_msg_info{3, 42, true}).value() == 5);
+
+    char buf[16];
+    sctp_msg_info info;
+
+    REQUIRE(srv.recv(buf, sizeof(buf), info).value() == 3);
+    REQUIRE(string(buf, 3) == "one");
+    REQUIRE(info.stream == 2);
+    REQUIRE(info.complete);
+
+    REQUIRE(srv.recv(buf, sizeof(buf), info).value() == 5);
+    REQUIRE(string(buf, 5) == "three");
+    REQUIRE(info.stream == 3);
+    REQUIRE(info.ppid == 42);
+    REQUIRE(info.unordered);
+}
@@ -0,0 +1,286 @@
+// test_send_queue.cpp
+//
+// Unit tests for the sockpp send_queue class.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/send_queue.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "tcp_pair.h"
+
+using namespace std;
+using namespace sockpp;
+
+namespace {
+
+string read_all(tcp_connector& cli, size_t n) {
+    string s(n, '\0');
+    auto res = cli.read_n(&s[0], n);
+    s.resize(res ? res.value() : 0);
+    return s;
+}
+
+}  // namespace
+
+TEST_CASE("send_queue pool check", "[send_queue]") {
+    constexpr size_t ALIGN = alignof(std::max_align_t);
+
+    SECTION("too small") {
+        buffer_pool pool{send_queue::HEADER_SIZE};
+        REQUIRE_THROWS_AS(send_queue{pool}, std::system_error);
+
+        error_code ec;
+        send_queue q{pool, ec};
+        REQUIRE(ec == errc::invalid_argument);
+    }
+
+    SECTION("misaligned") {
+        buffer_pool pool{send_queue::HEADER_SIZE + ALIGN + 1};
+        REQUIRE_THROWS_AS(send_queue{pool}, std::system_error);
+
+        error_code ec;
+        send_queue q{pool, ec};
+        REQUIRE(ec == errc::invalid_argument);
+    }
+
+    SECTION("usable") {
+        buffer_pool pool{send_queue::HEADER_SIZE + ALIGN};
+        REQUIRE_NOTHROW(send_queue{pool});
+
+        error_code ec;
+        send_queue q{pool, ec};
+        REQUIRE(!ec);
+        REQUIRE(q.push("x", 1));
+    }
+}
+
+TEST_CASE("send_queue single producer", "[send_queue]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    // Small buffers, so that messages span several
+    buffer_pool pool{send_queue::HEADER_SIZE + 16, 8};
+    send_queue q{pool};
+    REQUIRE(q.empty());
+
+    SECTION("copied") {
+        REQUIRE(q.push(string{"hello "}));
+        REQUIRE(!q.push(string{"world"}));
+        REQUIRE(!q.push(nullptr, 0));
+        REQUIRE(q.size() == 11);
+
+        REQUIRE(q.flush(p.srv).value() == 11);
+        REQUIRE(q.empty());
+        REQUIRE(read_all(p.cli, 11) == "hello world");
+
+        // The queue works again after draining
+        REQUIRE(q.push(string{"again"}));
+        REQUIRE(q.flush(p.srv).value() == 5);
+        REQUIRE(read_all(p.cli, 5) == "again");
+    }
+
+    SECTION("large message") {
+        string big;
+        for (int i = 0; i < 100; ++i) big += to_string(i) + ",";
+
+        REQUIRE(q.push(big));
+        REQUIRE(q.push(string{"end"}) == false);
+        REQUIRE(q.flush(p.srv).value() == big.size() + 3);
+        REQUIRE(read_all(p.cli, big.size() + 3) == big + "end");
+    }
+
+    SECTION("message") {
+        auto msg = q.make_message();
+        REQUIRE(msg);
+        REQUIRE(msg.size() == 0);
+        REQUIRE(msg.capacity() == 16);
+
+        memcpy(msg.data(), "direct", 6);
+        msg.resize(6);
+        REQUIRE(q.push(std::move(msg)));
+        REQUIRE(!msg);
+
+        REQUIRE(q.flush(p.srv).value() == 6);
+        REQUIRE(read_all(p.cli, 6) == "direct");
+    }
+
+    SECTION("unsent data is released") {
+        {
+            send_queue q2{pool};
+            q2.push(string(100, 'x'));
+        }
+        auto n = pool.capacity();
+
+        // The buffers went back to the pool, to be reused
+        q.push(string(100, 'x'));
+        REQUIRE(pool.capacity() == n);
+    }
+}
+
+TEST_CASE("send_queue multiple producers", "[send_queue]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    constexpr int NPROD = 4, NMSG = 2000;
+    constexpr size_t MSG_SZ = 8;
+
+    buffer_pool pool{256};
+    send_queue q{pool};
+
+    // Reads all the messages, counting each producer's that arrive in order
+    int next[NPROD] = {0};
+    thread rdr([&] {
+        char buf[MSG_SZ];
+        for (int i = 0; i < NPROD * NMSG; ++i) {
+            auto res = p.cli.read_n(buf, MSG_SZ);
+            if (!res || res.value() != MSG_SZ)
+                break;
+            int prod, seq;
+            memcpy(&prod, buf, 4);
+            memcpy(&seq, buf + 4, 4);
+            if (prod >= 0 && prod < NPROD && seq == next[prod])
+                ++next[prod];
+        }
+    });
+
+    vector<thread> prods;
+    for (int i = 0; i < NPROD; ++i) {
+        prods.emplace_back([&q, i] {
+            for (int j = 0; j < NMSG; ++j) {
+                char buf[MSG_SZ];
+                memcpy(buf, &i, 4);
+                memcpy(buf + 4, &j, 4);
+                q.push(buf, MSG_SZ);
+            }
+        });
+    }
+
+    size_t total = 0;
+    while (total < NPROD * NMSG * MSG_SZ) {
+        auto res = q.flush(p.srv);
+        REQUIRE(res);
+        total += res.value();
+        if (res.value() == 0)
+            this_thread::yield();
+    }
+
+    for (auto& thr : prods) thr.join();
+    rdr.join();
+    REQUIRE(q.empty());
+
+    for (int i = 0; i < NPROD; ++i) REQUIRE(next[i] == NMSG);
+}
+
+// The consumer only flushes when a push reports that the queue was empty,
+// as an event loop would. Data pushed while a flush is running must still
+// go out, or the queue is left stuck and never signals again.
+TEST_CASE("send_queue wakeups", "[send_queue]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    constexpr int NPROD = 4, NMSG = 100000;
+    constexpr size_t MSG_SZ = 16;
+    constexpr size_t TOTAL = NPROD * NMSG * MSG_SZ;
+
+    buffer_pool pool{256};
+    send_queue q{pool};
+
+    mutex mtx;
+    condition_variable cv;
+    int nsignal = 0;
+
+    thread rdr([&] {
+        char buf[4096];
+        size_t n = 0;
+        while (n < TOTAL) {
+            auto res = p.cli.read(buf, sizeof(buf));
+            if (!res || res.value() == 0)
+                break;
+            n += res.value();
+        }
+    });
+
+    vector<thread> prods;
+    for (int i = 0; i < NPROD; ++i) {
+        prods.emplace_back([&] {
+            char buf[MSG_SZ] = {0};
+            for (int j = 0; j < NMSG; ++j) {
+                if (q.push(buf, MSG_SZ)) {
+                    lock_guard<mutex> lk{mtx};
+                    ++nsignal;
+                    cv.notify_one();
+                }
+            }
+        });
+    }
+
+    size_t total = 0;
+    bool stuck = false;
+    while (total < TOTAL) {
+        {
+            unique_lock<mutex> lk{mtx};
+            if (!cv.wait_for(lk, seconds{5}, [&] { return nsignal > 0; })) {
+                stuck = true;
+                break;
+            }
+            nsignal = 0;
+        }
+        auto res = q.flush(p.srv);
+        if (!res)
+            break;
+        total += res.value();
+    }
+
+    for (auto& thr : prods) thr.join();
+    p.srv.shutdown();
+    rdr.join();
+
+    REQUIRE(!stuck);
+    REQUIRE(total == TOTAL);
+    REQUIRE(q.empty());
+}
@@ -0,0 +1,171 @@
+// test_server_drain.cpp
+//
+// Unit tests for the sockpp server_drain class.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <memory>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/server_drain.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace sockpp;
+
+namespace {
+
+// A tiny server: each connection is read to its end, then closed.
+struct server
+{
+    reactor rx;
+    server_drain drain{rx};
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    vector<unique_ptr<tcp_socket>> conns;
+
+    server() {
+        acc.set_non_blocking();
+        drain.add_listener(acc);
+        rx.add(acc, poller::READABLE, [this](uint32_t) {
+            while (auto res = acc.accept()) add(res.release());
+        });
+    }
+
+    void add(tcp_socket sock) {
+        sock.set_non_blocking();
+        conns.push_back(make_unique<tcp_socket>(std::move(sock)));
+        auto p = conns.back().get();
+
+        drain.add_connection(*p);
+        rx.add(*p, poller::READABLE, [this, p](uint32_t) {
+            char buf[64];
+            auto res = p->read(buf, sizeof(buf));
+            if (res && res.value() == 0) {
+                drain.remove_connection(*p);
+                rx.remove(*p);
+                p->close();
+            }
+        });
+    }
+
+    // Runs the loop until the connections are accepted
+    void accept(size_t n) {
+        for (int i = 0; i < 100 && conns.size() < n; ++i) rx.run_once(milliseconds{10});
+    }
+};
+
+}  // namespace
+
+TEST_CASE("server_drain", "[server_drain]") {
+    server srv;
+    tcp_connector cli{srv.acc.address()};
+    REQUIRE(cli);
+
+    srv.accept(1);
+    REQUIRE(srv.conns.size() == 1);
+    REQUIRE(srv.drain.size() == 1);
+
+    SECTION("idle connection closes cleanly") {
+        srv.drain.start(seconds{5});
+        REQUIRE(srv.drain.draining());
+        REQUIRE(!srv.acc.is_open());
+
+        // The client sees the end of stream, and closes its side
+        char buf[16];
+        REQUIRE(cli.read(buf, sizeof(buf)).value() == 0);
+        cli.close();
+
+        REQUIRE(srv.drain.run().value() == 0);
+        REQUIRE(srv.drain.size() == 0);
+        REQUIRE(!srv.conns[0]->is_open());
+    }
+
+    SECTION("busy connection finishes") {
+        srv.drain.set_busy(*srv.conns[0], true);
+        srv.drain.start(seconds{5});
+
+        // Still open for the response
+        REQUIRE(srv.conns[0]->write(string{"done"}));
+        srv.drain.set_busy(*srv.conns[0], false);
+
+        char buf[16];
+        REQUIRE(cli.read_n(buf, 4).value() == 4);
+        REQUIRE(cli.read(buf, sizeof(buf)).value() == 0);
+        cli.close();
+
+        REQUIRE(srv.drain.run().value() == 0);
+    }
+
+    SECTION("deadline resets the rest") {
+        srv.drain.set_busy(*srv.conns[0], true);
+        srv.drain.start(milliseconds{20});
+
+        REQUIRE(srv.drain.run().value() == 1);
+        REQUIRE(!srv.conns[0]->is_open());
+
+        char buf[16];
+        REQUIRE(cli.read(buf, sizeof(buf)) == errc::connection_reset);
+    }
+}
+
+#if !defined(_WIN32)
+TEST_CASE("server_drain hand off", "[server_drain]") {
+    server srv;
+    auto addr = srv.acc.address();
+
+    auto [a, b] = unix_stream_socket::pair().release();
+    REQUIRE(srv.drain.hand_off(a));
+    REQUIRE(!srv.acc.is_open());
+
+    // The successor takes over the listener, and keeps accepting
+    auto res = b.recv_socket<tcp_acceptor>();
+    REQUIRE(res);
+    auto acc = res.release();
+    REQUIRE(acc.address() == addr);
+
+    tcp_connector cli{addr};
+    REQUIRE(cli);
+    REQUIRE(acc.accept());
+
+    REQUIRE(srv.drain.run().value() == 0);
+}
+#endif
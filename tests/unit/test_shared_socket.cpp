@@ -0,0 +1,125 @@
+// test_shared_socket.cpp
+//
+// Unit tests for the sockpp shared_socket read and write halves.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/shared_socket.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "tcp_pair.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("shared_socket split", "[shared_socket]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+    auto h = p.srv.handle();
+    auto addr = p.srv.address();
+
+    auto [rd, wr] = split(std::move(p.srv));
+    REQUIRE(!p.srv);
+
+    // Both halves share the one handle
+    REQUIRE(rd.handle() == h);
+    REQUIRE(wr.handle() == h);
+    REQUIRE(rd.same_socket(wr));
+    REQUIRE(rd.use_count() == 2);
+    REQUIRE(rd.address() == addr);
+
+    SECTION("duplex") {
+        // Echo on a separate thread using the read half
+        thread thr([rd = std::move(rd)]() mutable {
+            char buf[64];
+            while (true) {
+                auto res = rd.read(buf, sizeof(buf));
+                if (!res || res.value() == 0)
+                    break;
+            }
+        });
+
+        REQUIRE(wr.write(string{"ping"}).value() == 4);
+
+        char buf[16];
+        REQUIRE(p.cli.read_n(buf, 4).value() == 4);
+        REQUIRE(string(buf, 4) == "ping");
+
+        p.cli.shutdown(SHUT_WR);
+        thr.join();
+
+        // The write half still holds the socket open
+        REQUIRE(wr.use_count() == 1);
+        REQUIRE(wr.is_open());
+        REQUIRE(wr.write(string{"last"}).value() == 4);
+        REQUIRE(p.cli.read_n(buf, 4).value() == 4);
+    }
+
+    SECTION("closed with the last half") {
+        {
+            auto wr2 = std::move(wr);
+        }
+        REQUIRE(rd.is_open());
+        REQUIRE(rd.use_count() == 1);
+
+        rd = read_half<tcp_socket>{};
+        REQUIRE(!rd);
+
+        // The peer sees the connection closed
+        char buf[16];
+        REQUIRE(p.cli.read(buf, sizeof(buf)).value() == 0);
+    }
+
+    SECTION("reunite") {
+        auto copy = wr;
+        REQUIRE(reunite(rd, wr) == errc::invalid_argument);
+        copy = write_half<tcp_socket>{};
+
+        auto res = reunite(rd, wr);
+        REQUIRE(res);
+        auto sock = res.release();
+        REQUIRE(sock.handle() == h);
+        REQUIRE(!rd);
+        REQUIRE(!wr);
+    }
+}
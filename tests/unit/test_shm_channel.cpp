@@ -0,0 +1,238 @@
+// test_shm_channel.cpp
+//
+// Unit tests for the shm_channel class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/shm_channel.h"
+
+using namespace sockpp;
+using namespace std;
+
+namespace {
+
+// Creates a connected pair of channels over a Unix socket pair.
+std::tuple<shm_channel, shm_channel> chan_pair(size_t cap = shm_channel::DFLT_CAPACITY) {
+    auto [s1, s2] = unix_stream_socket::pair().release();
+
+    auto res1 = shm_channel::create(std::move(s1), cap);
+    REQUIRE(res1);
+    auto res2 = shm_channel::attach(std::move(s2));
+    REQUIRE(res2);
+
+    return std::make_tuple(res1.release(), res2.release());
+}
+
+// The layout of the start of the shared memory, to play a peer that
+// doesn't follow the rules.
+struct raw_ring
+{
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) std::atomic<uint32_t> readerWaiting;
+    std::atomic<uint32_t> writerWaiting;
+    std::atomic<uint32_t> closed;
+};
+
+struct raw_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    raw_ring rings[2];
+};
+
+constexpr uint32_t RAW_MAGIC = 0x534B5050;
+constexpr size_t RAW_HDR_SIZE = 4096, RAW_CAP = 4096;
+
+// Offers a channel by hand, as create() would, optionally leaving the
+// memory unsealed. Returns the memory descriptor.
+int raw_offer(unix_stream_socket& sock, bool seal) {
+    int fds[5];
+    fds[0] = ::memfd_create("test-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    REQUIRE(fds[0] >= 0);
+    REQUIRE(::ftruncate(fds[0], off_t(RAW_HDR_SIZE + 2 * RAW_CAP)) == 0);
+    if (seal)
+        REQUIRE(::fcntl(fds[0], F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) == 0);
+
+    raw_header hdr{};
+    hdr.magic = RAW_MAGIC;
+    hdr.version = 1;
+    hdr.capacity = RAW_CAP;
+    REQUIRE(::pwrite(fds[0], &hdr, sizeof(hdr), 0) == ssize_t(sizeof(hdr)));
+
+    for (int i = 1; i < 5; ++i) fds[i] = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    REQUIRE(sock.send_fds(fds, 5, &RAW_MAGIC, sizeof(RAW_MAGIC)));
+
+    for (int i = 1; i < 5; ++i) ::close(fds[i]);
+    return fds[0];
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("shm_channel read/write", "[shm_channel]") {
+    auto [chan1, chan2] = chan_pair();
+
+    REQUIRE(chan1);
+    REQUIRE(chan2);
+    REQUIRE(chan1.capacity() == shm_channel::DFLT_CAPACITY);
+    REQUIRE(chan2.capacity() == shm_channel::DFLT_CAPACITY);
+
+    const string MSG{"Hello, shared memory"};
+    char buf[64];
+
+    REQUIRE(chan1.write(MSG) == MSG.size());
+    REQUIRE(chan2.read_n(buf, MSG.size()) == MSG.size());
+    REQUIRE(string(buf, MSG.size()) == MSG);
+
+    REQUIRE(chan2.write(MSG) == MSG.size());
+    REQUIRE(chan1.read(buf, sizeof(buf)) == MSG.size());
+    REQUIRE(string(buf, MSG.size()) == MSG);
+
+    SECTION("close") {
+        REQUIRE(chan1.write(MSG) == MSG.size());
+        chan1.close();
+        REQUIRE(!chan1);
+
+        // Pending data is still delivered, then end of stream
+        REQUIRE(chan2.read_n(buf, MSG.size()) == MSG.size());
+        REQUIRE(chan2.read(buf, sizeof(buf)) == size_t(0));
+        REQUIRE(chan2.write(MSG) == errc::broken_pipe);
+
+        REQUIRE(chan1.read(buf, sizeof(buf)) == errc::bad_file_descriptor);
+    }
+}
+
+TEST_CASE("shm_channel wraparound", "[shm_channel]") {
+    // The smallest ring, so the writer fills it and blocks many times
+    auto [chan1, chan2] = chan_pair(1);
+    REQUIRE(chan1.capacity() == 4096);
+
+    const size_t N = 256 * 1024;
+    vector<uint8_t> out(N), in(N);
+    for (size_t i = 0; i < N; ++i)
+        out[i] = uint8_t(i * 7 + i / 251);
+
+    chan1.spin_count(0);
+    chan2.spin_count(0);
+
+    std::thread thr([&, &chan1 = chan1] {
+        chan1.write_n(out.data(), N);
+        chan1.close();
+    });
+
+    REQUIRE(chan2.read_n(in.data(), N) == N);
+    thr.join();
+
+    REQUIRE(in == out);
+    REQUIRE(chan2.read(in.data(), N) == size_t(0));
+}
+
+TEST_CASE("shm_channel peer gone", "[shm_channel]") {
+    auto [s1, s2] = unix_stream_socket::pair().release();
+
+    auto res = shm_channel::create(std::move(s1));
+    REQUIRE(res);
+    auto chan = res.release();
+
+    // The peer never attaches, just drops the socket.
+    s2.close();
+
+    char buf[16];
+    REQUIRE(chan.read(buf, sizeof(buf)) == size_t(0));
+    REQUIRE(chan.write("x") == errc::broken_pipe);
+}
+
+TEST_CASE("shm_channel bad offer", "[shm_channel]") {
+    auto [s1, s2] = unix_stream_socket::pair().release();
+
+    REQUIRE(s1.write("NOPE"));
+    REQUIRE(shm_channel::attach(std::move(s2)) == errc::bad_message);
+}
+
+TEST_CASE("shm_channel unsealed memory", "[shm_channel]") {
+    auto [s1, s2] = unix_stream_socket::pair().release();
+
+    int fd = raw_offer(s1, false);
+    REQUIRE(shm_channel::attach(std::move(s2)) == errc::bad_message);
+    ::close(fd);
+}
+
+TEST_CASE("shm_channel corrupt ring", "[shm_channel]") {
+    auto [s1, s2] = unix_stream_socket::pair().release();
+
+    int fd = raw_offer(s1, true);
+    auto res = shm_channel::attach(std::move(s2));
+    REQUIRE(res);
+    auto chan = res.release();
+
+    auto p = ::mmap(nullptr, RAW_HDR_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    REQUIRE(p != MAP_FAILED);
+    auto hdr = static_cast<raw_header*>(p);
+
+    char buf[16];
+
+    SECTION("read") {
+        // The peer claims to have written more than the ring holds
+        hdr->rings[0].head = 2 * RAW_CAP;
+        REQUIRE(chan.read(buf, sizeof(buf)) == errc::bad_message);
+        REQUIRE(chan.write("x") == errc::broken_pipe);
+    }
+
+    SECTION("write") {
+        // The peer moves our tail past our head
+        hdr->rings[1].tail = 1;
+        REQUIRE(chan.write("x") == errc::bad_message);
+        REQUIRE(chan.write("x") == errc::broken_pipe);
+    }
+
+    ::munmap(p, RAW_HDR_SIZE);
+}
@@ -0,0 +1,248 @@
+// test_sim_link.cpp
+//
+// Unit tests for the sockpp simulated network links.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/sim_link.h"
+
+using namespace std;
+using namespace sockpp;
+
+namespace {
+
+// Reads everything that's waiting on a non-blocking stream socket.
+string read_all(stream_socket& sock) {
+    string s;
+    char buf[4096];
+    while (true) {
+        auto res = sock.read(buf, sizeof(buf));
+        if (!res || res.value() == 0)
+            break;
+        s.append(buf, res.value());
+    }
+    return s;
+}
+
+// Receives the (one-byte) datagrams waiting on a non-blocking socket.
+vector<int> recv_all(datagram_socket& sock) {
+    vector<int> v;
+    char c;
+    while (sock.recv(&c, 1))
+        v.push_back(c);
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("sim_stream_link timing", "[sim_link]") {
+    sim_link::params p;
+    p.latency = milliseconds{5};
+    p.bandwidth = 1'000'000;
+    p.mtu = 1000;
+
+    sim_stream_link link{p};
+    auto& a = link.first();
+    auto& b = link.second();
+    REQUIRE(b.set_non_blocking());
+    REQUIRE(link.now() == nanoseconds{0});
+
+    SECTION("bandwidth and latency") {
+        const string MSG(10000, 'x');
+        REQUIRE(a.write(MSG));
+
+        // Each 1000-byte segment takes 1ms to send, then 5ms to arrive
+        link.run_until(milliseconds{5});
+        REQUIRE(read_all(b).empty());
+
+        link.run_until(milliseconds{6});
+        REQUIRE(read_all(b).size() == 1000);
+        REQUIRE(link.next_event() == nanoseconds{milliseconds{7}});
+
+        REQUIRE(link.run() == milliseconds{15});
+        REQUIRE(read_all(b).size() == 9000);
+        REQUIRE(link.idle());
+        REQUIRE(link.a_to_b().packets == 10);
+        REQUIRE(link.a_to_b().bytes == 10000);
+        REQUIRE(link.b_to_a().packets == 0);
+    }
+
+    SECTION("eof") {
+        REQUIRE(a.write(string{"bye"}));
+        REQUIRE(a.shutdown(SHUT_WR));
+
+        link.advance(milliseconds{10});
+        char buf[16];
+        REQUIRE(b.read(buf, sizeof(buf)).value() == 3);
+        REQUIRE(b.read(buf, sizeof(buf)).value() == 0);
+    }
+
+    SECTION("echo") {
+        REQUIRE(a.write(string{"ping"}));
+        link.advance(milliseconds{10});
+        REQUIRE(read_all(b) == "ping");
+
+        REQUIRE(b.write(string{"pong"}));
+        link.run();
+        char buf[16];
+        REQUIRE(a.read(buf, sizeof(buf)).value() == 4);
+        REQUIRE(link.now() == milliseconds{15} + microseconds{4});
+    }
+}
+
+TEST_CASE("sim_stream_link loss", "[sim_link]") {
+    sim_link::params p;
+    p.latency = milliseconds{1};
+    p.loss = 1.0;
+    p.retransmit = milliseconds{50};
+
+    sim_stream_link link{p};
+    REQUIRE(link.first().write(string{"late"}));
+
+    // Lost segments are late, but still in order
+    REQUIRE(link.run() == milliseconds{51});
+    REQUIRE(link.a_to_b().retransmits == 1);
+
+    char buf[16];
+    REQUIRE(link.second().read(buf, sizeof(buf)).value() == 4);
+}
+
+TEST_CASE("sim_stream_link backpressure", "[sim_link]") {
+    sim_link::params p;
+    p.latency = milliseconds{1};
+    p.bandwidth = 10'000'000;
+    p.mtu = 1024;
+    p.queueLimit = 64 * 1024;
+
+    sim_stream_link link{p};
+    auto& a = link.first();
+    auto& b = link.second();
+    REQUIRE(a.set_non_blocking());
+    REQUIRE(b.set_non_blocking());
+
+    const size_t N = 1024 * 1024;
+    string data(N, '\0');
+    for (size_t i = 0; i < N; ++i) data[i] = char(i % 251);
+
+    size_t nsent = 0;
+    string rcvd;
+
+    for (int i = 0; i < 10000 && rcvd.size() < N; ++i) {
+        if (nsent < N) {
+            auto res = a.write(data.data() + nsent, N - nsent);
+            if (res)
+                nsent += res.value();
+        }
+        link.advance(milliseconds{1});
+        rcvd += read_all(b);
+    }
+
+    REQUIRE(rcvd.size() == N);
+    REQUIRE(rcvd == data);
+
+    // Limited by the bandwidth, about 100ms plus the latency
+    REQUIRE(link.now() >= milliseconds{100});
+    REQUIRE(link.now() <= milliseconds{110});
+}
+
+TEST_CASE("sim_dgram_link", "[sim_link]") {
+    sim_link::params p;
+    p.latency = milliseconds{2};
+    p.seed = 42;
+
+    SECTION("loss") {
+        p.loss = 0.5;
+
+        // The same seed loses the same datagrams
+        vector<int> v[2];
+        for (auto& rcvd : v) {
+            sim_dgram_link link{p};
+            REQUIRE(link.second().set_non_blocking());
+
+            for (int i = 0; i < 100; ++i) {
+                char c = char(i);
+                REQUIRE(link.first().send(string(1, c)));
+            }
+            REQUIRE(link.run() == milliseconds{2});
+
+            rcvd = recv_all(link.second());
+            REQUIRE(rcvd.size() + link.a_to_b().dropped == 100);
+            REQUIRE(link.a_to_b().dropped > 20);
+            REQUIRE(link.a_to_b().dropped < 80);
+        }
+        REQUIRE(v[0] == v[1]);
+    }
+
+    SECTION("reorder") {
+        p.reorder = 0.5;
+        p.reorderDelay = milliseconds{5};
+
+        sim_dgram_link link{p};
+        REQUIRE(link.second().set_non_blocking());
+
+        for (int i = 0; i < 20; ++i) {
+            char c = char(i);
+            REQUIRE(link.first().send(string(1, c)));
+        }
+        link.run();
+
+        auto rcvd = recv_all(link.second());
+        REQUIRE(rcvd.size() == 20);
+        REQUIRE(set<int>(rcvd.begin(), rcvd.end()).size() == 20);
+        REQUIRE(link.a_to_b().reordered > 0);
+        REQUIRE(!is_sorted(rcvd.begin(), rcvd.end()));
+    }
+
+    SECTION("queue limit") {
+        p.queueLimit = 10;
+
+        sim_dgram_link link{p};
+        for (int i = 0; i < 20; ++i) {
+            char c = char(i);
+            REQUIRE(link.first().send(string(1, c)));
+        }
+        link.run();
+        REQUIRE(link.a_to_b().packets == 10);
+        REQUIRE(link.a_to_b().dropped == 10);
+    }
+}
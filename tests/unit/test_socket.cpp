@@ -43,6 +43,11 @@
 #include "catch2_version.h"
 #include "sockpp/inet_address.h"
 #include "sockpp/socket.h"
+#include "sockpp/socket_view.h"
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+#endif
 
 using namespace sockpp;
 using namespace std::chrono;
@@ -235,6 +240,7 @@ TEST_CASE("socket address", "[socket]") {
     }
 }
 
+#if !defined(_WIN32)
 // Socket pair shouldn't work for TCP sockets on any known platform.
 // So this should fail, but fail gracefully and retain the error
 // in both sockets.
@@ -242,6 +248,23 @@ TEST_CASE("failed socket pair", "[socket]") {
     auto res = socket::pair(AF_INET, SOCK_STREAM);
     REQUIRE(!res);
 }
+#else
+// Windows has no socketpair(), so the library makes them over loopback.
+TEST_CASE("emulated socket pair", "[socket]") {
+    for (int type : {SOCK_STREAM, SOCK_DGRAM}) {
+        auto res = socket::pair(AF_INET, type);
+        REQUIRE(res);
+
+        auto [sock0, sock1] = res.release();
+        char buf[8];
+        REQUIRE(sock0.send(std::string{"hello"}).value() == 5);
+        REQUIRE(sock1.recv(buf, sizeof(buf)).value() == 5);
+        REQUIRE(sock1.send(std::string{"world"}).value() == 5);
+        REQUIRE(sock0.recv(buf, sizeof(buf)).value() == 5);
+        REQUIRE(std::string(buf, 5) == "world");
+    }
+}
+#endif
 
 // Test putting the socket into and out of non-blocking mode
 TEST_CASE("socket non-blocking mode", "[socket]") {
@@ -264,6 +287,41 @@ TEST_CASE("socket non-blocking mode", "[socket]") {
 #endif
 }
 
+#if !defined(_WIN32)
+// The mode belongs to the handle's open file description, so it's shared
+// with its duplicates and views.
+TEST_CASE("socket non-blocking mode follows the handle", "[socket]") {
+    auto sock = socket::create(AF_INET, SOCK_STREAM).release();
+    REQUIRE(sock.set_non_blocking());
+    REQUIRE(sock.set_non_blocking());
+    REQUIRE(socket_view{sock}.is_non_blocking());
+
+    // Moves carry the handle
+    sockpp::socket sock2{std::move(sock)};
+    REQUIRE(sock2.is_non_blocking());
+    REQUIRE(!sock.is_non_blocking());
+
+    sock = std::move(sock2);
+    REQUIRE(sock.is_non_blocking());
+
+    // A change through a clone is seen by the original, and a setter on
+    // the original isn't skipped on the belief that it's already set.
+    auto dup = sock.clone();
+    REQUIRE(dup.set_non_blocking(false));
+    REQUIRE(!sock.is_non_blocking());
+    REQUIRE(sock.set_non_blocking());
+    REQUIRE(dup.is_non_blocking());
+
+    // A change through a view, or straight through the OS, is seen too
+    REQUIRE(socket_view{sock}.set_non_blocking(false));
+    REQUIRE(!sock.is_non_blocking());
+    REQUIRE(::fcntl(sock.handle(), F_SETFL, O_NONBLOCK) == 0);
+    REQUIRE(sock.is_non_blocking());
+    REQUIRE(sock.set_non_blocking(false));
+    REQUIRE(!socket_view{sock}.is_non_blocking());
+}
+#endif
+
 // --------------------------------------------------------------------------
 
 // Test that the "last error" call to a socket gives the proper result
@@ -0,0 +1,109 @@
+// test_socket_options.cpp
+//
+// Unit tests for the sockpp socket_options class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include "catch2_version.h"
+#include "sockpp/socket_options.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace sockpp;
+
+TEST_CASE("socket_options set", "[socket_options]") {
+    socket_options opts;
+    REQUIRE(opts.empty());
+
+    opts.nodelay().recv_buffer_size(64 * 1024);
+    REQUIRE(opts.size() == 2);
+
+    // Setting an option again replaces the value
+    opts.nodelay(false);
+    REQUIRE(opts.size() == 2);
+    REQUIRE(opts.begin()->value == 0);
+
+    REQUIRE(socket_options::is_inherited(SOL_SOCKET, SO_RCVBUF));
+#if defined(__linux__)
+    REQUIRE(socket_options::is_inherited(IPPROTO_TCP, TCP_NODELAY));
+    REQUIRE(!socket_options::is_inherited(IPPROTO_TCP, TCP_QUICKACK));
+#endif
+
+    opts.clear();
+    REQUIRE(opts.empty());
+}
+
+TEST_CASE("socket_options acceptor", "[socket_options]") {
+    tcp_acceptor acc;
+    acc.options().nodelay().keepalive();
+    REQUIRE(acc.open(inet_address{"localhost", 0}));
+    REQUIRE(acc.options().failed() == 0);
+
+    tcp_connector conn{acc.address()};
+    REQUIRE(conn);
+
+    auto res = acc.accept();
+    REQUIRE(res);
+    auto sock = res.release();
+    REQUIRE(sock.nodelay().value());
+    REQUIRE(sock.keepalive().value());
+    REQUIRE(acc.options().failed() == 0);
+}
+
+TEST_CASE("socket_options connector", "[socket_options]") {
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+
+    SECTION("applied") {
+        tcp_connector conn;
+        conn.options().nodelay().send_buffer_size(32 * 1024);
+        REQUIRE(conn.connect(acc.address()));
+        REQUIRE(conn.nodelay().value());
+        REQUIRE(conn.options().failed() == 0);
+    }
+
+    SECTION("failure") {
+        tcp_connector conn;
+        conn.options().nodelay().set(SOL_SOCKET, 9999, 1);
+        REQUIRE(!conn.connect(acc.address()));
+        REQUIRE(!conn.is_open());
+        REQUIRE(conn.options().failed() == 1);
+
+        auto it = conn.options().begin();
+        REQUIRE(!it->err);
+        REQUIRE((++it)->err);
+    }
+}
@@ -0,0 +1,233 @@
+// test_socket_stats.cpp
+//
+// Unit tests for the socket_stats I/O counters.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/socket_stats.h"
+#include "sockpp/unix_dgram_socket.h"
+#include "sockpp/unix_stream_socket.h"
+
+using namespace std;
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("socket_stats arithmetic", "[socket_stats]") {
+    socket_stats a, b;
+    a.bytesIn = 100;
+    a.errors = 3;
+    a.errnoCounts[EAGAIN] = 3;
+    b.bytesIn = 40;
+    b.errors = 1;
+    b.errnoCounts[EAGAIN] = 1;
+
+    auto d = a - b;
+    REQUIRE(d.bytesIn == 60);
+    REQUIRE(d.errors == 2);
+    REQUIRE(d.errors_for(EAGAIN) == 2);
+    REQUIRE(d.errors_for(errc::resource_unavailable_try_again) == 2);
+    REQUIRE(d.errors_for(-1) == 0);
+
+    d += b;
+    REQUIRE(d.bytesIn == a.bytesIn);
+}
+
+TEST_CASE("socket_stats counting", "[socket_stats]") {
+    auto [a, b] = unix_stream_socket::pair().release_or_throw();
+    REQUIRE(b.set_non_blocking());
+
+    const string MSG{"Hello there"};
+    char buf[64];
+
+    auto before = socket_stats::snapshot();
+
+    REQUIRE(a.write(MSG) == MSG.size());
+    REQUIRE(b.read(buf, sizeof(buf)) == MSG.size());
+    REQUIRE(b.read(buf, sizeof(buf)) == errc::operation_would_block);
+
+    auto d = socket_stats::snapshot() - before;
+
+    if (!socket_stats::enabled()) {
+        REQUIRE(d.syscalls == 0);
+        REQUIRE(socket_stats::snapshot().bytesOut == 0);
+        return;
+    }
+
+    REQUIRE(d.syscalls >= 3);
+    REQUIRE(d.bytesOut >= MSG.size());
+    REQUIRE(d.bytesIn >= MSG.size());
+    REQUIRE(d.wouldBlock >= 1);
+    REQUIRE(d.errors >= 1);
+    REQUIRE(d.errors_for(errc::operation_would_block) >= 1);
+
+    SECTION("counts survive the thread") {
+        before = socket_stats::snapshot();
+        std::thread thr{[&a = a]() { a.write(string(16, 'x')); }};
+        thr.join();
+        REQUIRE((socket_stats::snapshot() - before).bytesOut >= 16);
+    }
+}
+
+// Batched sends and receives count each message's bytes.
+TEST_CASE("socket_stats counting batches", "[socket_stats]") {
+    auto [a, b] = unix_dgram_socket::pair().release_or_throw();
+
+    char msg1[] = "one", msg2[] = "three";
+    iovec out[] = {{msg1, 3}, {msg2, 5}};
+
+    char buf1[16], buf2[16];
+    iovec in[] = {{buf1, sizeof(buf1)}, {buf2, sizeof(buf2)}};
+    size_t lens[2];
+
+    auto before = socket_stats::snapshot();
+
+    REQUIRE(a.send_many(out, 2).value() == 2);
+    REQUIRE(b.recv_many(in, lens, 2).value() == 2);
+
+    auto d = socket_stats::snapshot() - before;
+
+    if (!socket_stats::enabled()) {
+        REQUIRE(d.syscalls == 0);
+        return;
+    }
+
+    REQUIRE(d.syscalls >= 2);
+    REQUIRE(d.bytesOut == 8);
+    REQUIRE(d.bytesIn == 8);
+    REQUIRE(d.partialWrites == 0);
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("latency_histogram buckets", "[socket_stats]") {
+    using hist = latency_histogram;
+
+    // Small values are exact
+    for (uint64_t v = 0; v < hist::SUB_BUCKETS; ++v) {
+        REQUIRE(hist::bucket_index(v) == v);
+        REQUIRE(hist::bucket_lower(v) == v);
+        REQUIRE(hist::bucket_upper(v) == v);
+    }
+
+    // The buckets are contiguous, and every value is in its own bucket
+    for (size_t i = 1; i < hist::N_BUCKETS; ++i) {
+        REQUIRE(hist::bucket_lower(i) == hist::bucket_upper(i - 1) + 1);
+        REQUIRE(hist::bucket_index(hist::bucket_lower(i)) == i);
+        REQUIRE(hist::bucket_index(hist::bucket_upper(i)) == i);
+    }
+
+    // Within the precision
+    for (uint64_t v : {100ull, 12345ull, 1000000ull, 987654321ull}) {
+        auto i = hist::bucket_index(v);
+        REQUIRE(hist::bucket_upper(i) - hist::bucket_lower(i) <= v / hist::SUB_BUCKETS);
+    }
+
+    // Too big goes in the last bucket
+    REQUIRE(hist::bucket_index(uint64_t(1) << 50) == hist::N_BUCKETS - 1);
+}
+
+TEST_CASE("latency_histogram values", "[socket_stats]") {
+    latency_histogram h;
+    REQUIRE(h.empty());
+    REQUIRE(h.percentile(50) == nanoseconds{0});
+
+    for (int i = 1; i <= 100; ++i) h.record(microseconds{i});
+
+    REQUIRE(h.count() == 100);
+    REQUIRE(h.mean() == nanoseconds{50500});
+    REQUIRE(h.lowest() <= microseconds{1});
+    REQUIRE(h.highest() >= microseconds{100});
+
+    auto p50 = h.percentile(50);
+    REQUIRE(p50 >= microseconds{50});
+    REQUIRE(p50 <= microseconds{54});
+
+    auto p99 = h.percentile(99);
+    REQUIRE(p99 >= microseconds{99});
+    REQUIRE(p99 <= microseconds{106});
+    REQUIRE(h.percentile(100) == h.highest());
+
+    SECTION("merge") {
+        latency_stats a, b;
+        a[latency_op::connect] = h;
+        b[latency_op::connect].record(milliseconds{1});
+
+        auto sum = a;
+        sum += b;
+        REQUIRE(sum[latency_op::connect].count() == 101);
+        REQUIRE(sum[latency_op::connect].highest() >= milliseconds{1});
+
+        auto d = sum - a;
+        REQUIRE(d[latency_op::connect].count() == 1);
+        REQUIRE(d[latency_op::write_n].empty());
+    }
+}
+
+TEST_CASE("latency_stats recording", "[socket_stats]") {
+    auto [a, b] = unix_stream_socket::pair().release_or_throw();
+    const string MSG{"Hello there"};
+
+    auto before = latency_stats::snapshot();
+    auto beforeThr = latency_stats::snapshot(this_thread::get_id());
+
+    REQUIRE(a.write_n(MSG.data(), MSG.size()) == MSG.size());
+    latency_stats::record(latency_op::first_byte, microseconds{250});
+
+    auto d = latency_stats::snapshot() - before;
+    auto dThr = latency_stats::snapshot(this_thread::get_id()) - beforeThr;
+
+    if (!latency_stats::enabled()) {
+        REQUIRE(d[latency_op::write_n].empty());
+        REQUIRE(d[latency_op::first_byte].empty());
+        return;
+    }
+
+    REQUIRE(d[latency_op::write_n].count() == 1);
+    REQUIRE(d[latency_op::first_byte].count() == 1);
+    REQUIRE(dThr[latency_op::first_byte].percentile(50) >= microseconds{250});
+
+    SECTION("histograms survive the thread") {
+        before = latency_stats::snapshot();
+        thread thr{[] { latency_stats::record(latency_op::resolve, milliseconds{2}); }};
+        thr.join();
+        REQUIRE((latency_stats::snapshot() - before)[latency_op::resolve].count() == 1);
+    }
+}
@@ -0,0 +1,154 @@
+// test_socket_view.cpp
+//
+// Unit tests for the sockpp socket_view and unique_socket classes.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/socket_view.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+
+using namespace std;
+using namespace sockpp;
+
+static_assert(sizeof(socket_view) == sizeof(socket_t), "socket_view is a bare handle");
+static_assert(sizeof(unique_socket) == sizeof(socket_t), "unique_socket is a bare handle");
+static_assert(is_trivially_copyable<socket_view>::value, "socket_view is a value type");
+static_assert(!is_polymorphic<unique_socket>::value, "unique_socket has no vtable");
+
+TEST_CASE("socket_view", "[socket_view]") {
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    tcp_connector cli{acc.address()};
+    auto srv = acc.accept().release();
+    REQUIRE(srv);
+
+    socket_view v{srv};
+    REQUIRE(v);
+    REQUIRE(v.handle() == srv.handle());
+    REQUIRE(v == socket_view{srv.handle()});
+    REQUIRE(v != socket_view{});
+
+    SECTION("properties") {
+        REQUIRE(v.family() == AF_INET);
+        REQUIRE(v.address() == srv.address());
+        REQUIRE(v.peer_address() == cli.address());
+        REQUIRE(socket_view{}.family() == AF_UNSPEC);
+
+        REQUIRE(v.set_option(IPPROTO_TCP, TCP_NODELAY, 1));
+        REQUIRE(v.get_option<int>(IPPROTO_TCP, TCP_NODELAY).value() != 0);
+        REQUIRE(srv.nodelay().value());
+    }
+
+    SECTION("read and write") {
+        REQUIRE(socket_view{cli}.write("hello", 5).value() == 5);
+
+        char buf[16];
+        REQUIRE(v.read(buf, sizeof(buf)).value() == 5);
+        REQUIRE(string(buf, 5) == "hello");
+
+        char a[] = "one", b[] = "two";
+        iovec iov[] = {{a, 3}, {b, 3}};
+        REQUIRE(v.write(iov, 2).value() == 6);
+        REQUIRE(cli.read_n(buf, 6).value() == 6);
+        REQUIRE(string(buf, 6) == "onetwo");
+    }
+
+#if !defined(_WIN32)
+    SECTION("non-blocking") {
+        REQUIRE(!v.is_non_blocking());
+        REQUIRE(v.set_non_blocking());
+        REQUIRE(v.is_non_blocking());
+        REQUIRE(srv.is_non_blocking());
+
+        char buf[16];
+        REQUIRE(v.read(buf, sizeof(buf)) == errc::resource_unavailable_try_again);
+    }
+#endif
+
+    SECTION("shutdown") {
+        REQUIRE(v.shutdown(SHUT_WR));
+
+        char buf[16];
+        REQUIRE(cli.read(buf, sizeof(buf)).value() == 0);
+        REQUIRE(socket_view{}.shutdown() == errc::invalid_argument);
+    }
+}
+
+TEST_CASE("unique_socket", "[socket_view]") {
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    tcp_connector cli{acc.address()};
+
+    vector<unique_socket> conns;
+    conns.emplace_back(acc.accept().release());
+    REQUIRE(conns.back());
+
+    SECTION("move and release") {
+        auto h = conns.back().handle();
+
+        unique_socket sock{std::move(conns.back())};
+        REQUIRE(!conns.back());
+        REQUIRE(sock.handle() == h);
+
+        tcp_socket tsock{sock.release()};
+        REQUIRE(!sock);
+        REQUIRE(tsock.handle() == h);
+    }
+
+    SECTION("closes") {
+        conns.clear();
+
+        char buf[16];
+        REQUIRE(cli.read(buf, sizeof(buf)).value() == 0);
+    }
+
+    SECTION("reset") {
+        auto& sock = conns.back();
+        REQUIRE(sock.close());
+        REQUIRE(!sock);
+        REQUIRE(sock.close());
+
+        char buf[16];
+        REQUIRE(cli.read(buf, sizeof(buf)).value() == 0);
+    }
+}
@@ -0,0 +1,161 @@
+// test_spin_reader.cpp
+//
+// Unit tests for the sockpp spin_reader class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/spin_reader.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/udp_socket.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("spin_stats hit_ratio", "[spin_reader]") {
+    spin_stats st;
+    REQUIRE(st.hit_ratio() == 0.0);
+
+    st.spinHits = 3;
+    st.spinMisses = 1;
+    REQUIRE(st.hit_ratio() == 0.75);
+}
+
+TEST_CASE("spin_reader udp", "[spin_reader]") {
+    const auto ANY_ADDR = inet_address("localhost", 0);
+
+    udp_socket srv{ANY_ADDR}, cli{ANY_ADDR};
+    const auto SRV_ADDR = srv.address();
+
+    const string MSG{"hello"};
+    char buf[64];
+
+    spin_params params;
+    params.spin_time = microseconds{100};
+
+    spin_reader rdr{srv, params};
+    REQUIRE(rdr.enable());
+
+    SECTION("immediate") {
+        REQUIRE(cli.send_to(MSG, SRV_ADDR));
+
+        inet_address addr;
+        auto res = rdr.recv_from(buf, sizeof(buf), &addr);
+        REQUIRE(res);
+        REQUIRE(string(buf, res.value()) == MSG);
+        REQUIRE(addr == cli.address());
+
+        REQUIRE(rdr.stats().reads == 1);
+        REQUIRE(rdr.stats().immediate == 1);
+        REQUIRE(rdr.stats().spinHits == 0);
+    }
+
+    SECTION("miss") {
+        auto res = rdr.recv(buf, sizeof(buf));
+        REQUIRE(!res);
+        REQUIRE(res == errc::resource_unavailable_try_again);
+
+        REQUIRE(rdr.stats().reads == 1);
+        REQUIRE(rdr.stats().spinMisses == 1);
+        REQUIRE(rdr.stats().spinTries > 0);
+
+        rdr.reset_stats();
+        REQUIRE(rdr.stats().reads == 0);
+    }
+
+    SECTION("spin hit") {
+        // Spin long enough that the sender can't miss the window
+        rdr.spin_time(seconds{5});
+
+        thread thr([&] {
+            this_thread::sleep_for(milliseconds{10});
+            cli.send_to(MSG, SRV_ADDR);
+        });
+
+        auto res = rdr.recv(buf, sizeof(buf));
+        thr.join();
+
+        REQUIRE(res);
+        REQUIRE(string(buf, res.value()) == MSG);
+        REQUIRE(rdr.stats().spinHits == 1);
+        REQUIRE(rdr.stats().spinMisses == 0);
+        REQUIRE(rdr.stats().hit_ratio() == 1.0);
+    }
+}
+
+TEST_CASE("spin_reader tcp", "[spin_reader]") {
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    REQUIRE(acc);
+
+    tcp_connector conn{acc.address()};
+    REQUIRE(conn);
+
+    auto res = acc.accept();
+    REQUIRE(res);
+    auto asock = res.release();
+
+    const string MSG{"hello"};
+    char buf[64];
+
+    int npin = 0;
+    spin_params params;
+    params.spin_time = microseconds{100};
+    params.cpu = 0;
+    params.pin = [&npin](int) -> result<> {
+        ++npin;
+        return none{};
+    };
+
+    spin_reader rdr{conn, params};
+
+    REQUIRE(!rdr.recv(buf, sizeof(buf)));
+    REQUIRE(asock.write(MSG));
+
+    auto n = rdr.recv(buf, sizeof(buf));
+    REQUIRE(n);
+    REQUIRE(string(buf, n.value()) == MSG);
+
+    // The hook is only called on the first read
+    REQUIRE(npin == 1);
+    REQUIRE(rdr.stats().reads == 2);
+    REQUIRE(rdr.stats().spinMisses == 1);
+    REQUIRE(rdr.stats().immediate + rdr.stats().spinHits == 1);
+}
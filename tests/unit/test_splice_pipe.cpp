@@ -0,0 +1,101 @@
+// test_splice_pipe.cpp
+//
+// Unit tests for the Linux `splice_pipe` class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <csignal>
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/splice_pipe.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/unix_stream_socket.h"
+#include "tcp_pair.h"
+
+using namespace sockpp;
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("splice_pipe relay", "[splice_pipe]") {
+    splice_pipe pipe;
+    REQUIRE(pipe.is_open());
+    REQUIRE(pipe.pending() == 0);
+
+    auto [inCli, inSrv] = make_tcp_pair();
+    auto [outSrv, outCli] = make_tcp_pair();
+
+    const std::string MSG{"This data goes through the kernel only."};
+    REQUIRE(inCli.write(MSG));
+
+    auto res = pipe.relay(inSrv, outSrv);
+    REQUIRE(res);
+    REQUIRE(res.value() == MSG.size());
+    REQUIRE(pipe.pending() == 0);
+
+    char buf[128];
+    REQUIRE(outCli.read_n(buf, MSG.size()).value() == MSG.size());
+    REQUIRE(std::string(buf, MSG.size()) == MSG);
+
+    SECTION("would block") {
+        inSrv.set_non_blocking();
+        res = pipe.relay(inSrv, outSrv);
+        REQUIRE(!res);
+        REQUIRE(res == errc::operation_would_block);
+    }
+
+    SECTION("end of stream") {
+        inCli.close();
+        res = pipe.relay(inSrv, outSrv);
+        REQUIRE(res);
+        REQUIRE(res.value() == 0);
+    }
+
+    SECTION("broken pipe") {
+        // With the default action, a SIGPIPE would kill the test
+        auto prev = std::signal(SIGPIPE, SIG_DFL);
+
+        auto [out, peer] = unix_stream_socket::pair().release_or_throw();
+        peer.close();
+
+        REQUIRE(inCli.write(MSG));
+        REQUIRE(pipe.relay(inSrv, out) == errc::broken_pipe);
+
+        std::signal(SIGPIPE, prev);
+    }
+}
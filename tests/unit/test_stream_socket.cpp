@@ -44,6 +44,12 @@
 #include "sockpp/inet_address.h"
 #include "sockpp/stream_socket.h"
 
+#if !defined(_WIN32)
+    #include <csignal>
+
+    #include "sockpp/unix_stream_socket.h"
+#endif
+
 using namespace std;
 using namespace sockpp;
 
@@ -109,3 +115,31 @@ TEST_CASE("stream_socket address constructor", "[stream_socket]") {
 TEST_CASE("stream_socket readn, writen", "[stream_socket]") {
     // auto lsock = stream_socket::create(AF
 }
+
+#if !defined(_WIN32)
+TEST_CASE("stream_socket broken pipe", "[stream_socket]") {
+    // With the default action, a SIGPIPE would kill the test
+    auto prev = std::signal(SIGPIPE, SIG_DFL);
+
+    auto [sock, peer] = unix_stream_socket::pair().release_or_throw();
+    peer.close();
+
+    const string MSG{"Hello"};
+    REQUIRE(sock.write(MSG.data(), MSG.size()) == errc::broken_pipe);
+    REQUIRE(sock.write_n(MSG.data(), MSG.size()) == errc::broken_pipe);
+
+    iovec iov{const_cast<char*>(MSG.data()), MSG.size()};
+    REQUIRE(sock.write(&iov, 1) == errc::broken_pipe);
+    REQUIRE(sock.send(MSG) == errc::broken_pipe);
+
+    // sendfile() can't be told, so the library blocks the signal for it
+    FILE* fp = std::tmpfile();
+    REQUIRE(fp);
+    std::fputs(MSG.c_str(), fp);
+    std::fflush(fp);
+    REQUIRE(sock.send_file(::fileno(fp), 0, MSG.size()) == errc::broken_pipe);
+    std::fclose(fp);
+
+    std::signal(SIGPIPE, prev);
+}
+#endif
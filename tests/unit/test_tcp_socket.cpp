@@ -38,9 +38,13 @@
 // --------------------------------------------------------------------------
 //
 
+#include <cstdio>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "catch2_version.h"
+#include "sockpp/socket_stats.h"
 #include "sockpp/tcp_acceptor.h"
 #include "sockpp/tcp_connector.h"
 #include "sockpp/tcp_socket.h"
@@ -113,6 +117,19 @@ TEST_CASE("tcp_socket read/write", "[stream_socket]") {
         REQUIRE(str2 == STR);
     }
 
+    SECTION("read_n at end of stream") {
+        char buf[512];  // N
+
+        // A short count when the peer closes part way through
+        REQUIRE(csock.write_n(STR.data(), N / 2).value() == N / 2);
+        csock.shutdown(SHUT_WR);
+        REQUIRE(ssock.read_n(buf, N).value() == N / 2);
+        REQUIRE(string(buf, N / 2) == STR.substr(0, N / 2));
+
+        // Nothing more once the stream has ended
+        REQUIRE(ssock.read_n(buf, N).value() == 0);
+    }
+
     SECTION("scatter/gather") {
         const string HEADER{"<start>"}, FOOTER{"<end>"};
 
@@ -142,4 +159,295 @@ TEST_CASE("tcp_socket read/write", "[stream_socket]") {
         REQUIRE(string(buf, N) == STR);
         REQUIRE(string(fbuf, N_FOOTER) == FOOTER);
     }
+
+    SECTION("scatter/gather array") {
+        const string HEADER{"<start>"}, FOOTER{"<end>"};
+        const size_t N_TOT = HEADER.length() + N + FOOTER.length();
+
+        iovec_array<4> outv;
+        REQUIRE(outv.empty());
+        REQUIRE(outv.push_back(HEADER));
+        REQUIRE(outv.push_back(STR.data(), N));
+        REQUIRE(outv.push_back(FOOTER));
+        REQUIRE(outv.size() == 3);
+        REQUIRE(outv.total_size() == N_TOT);
+
+        char hbuf[512], buf[512], fbuf[512];
+
+        iovec_array<3> inv;
+        inv.push_back(hbuf, HEADER.length());
+        inv.push_back(buf, N);
+        inv.push_back(fbuf, FOOTER.length());
+        REQUIRE(inv.full());
+        REQUIRE(!inv.push_back(buf, 1));
+
+        REQUIRE(csock.write(outv).value() == N_TOT);
+        REQUIRE(ssock.read(inv).value() == N_TOT);
+
+        REQUIRE(string(hbuf, HEADER.length()) == HEADER);
+        REQUIRE(string(buf, N) == STR);
+        REQUIRE(string(fbuf, FOOTER.length()) == FOOTER);
+
+        // Empty vectors are a no-op
+        REQUIRE(csock.write(outv.data(), 0).value() == 0);
+    }
+
+#if !defined(_WIN32)
+    SECTION("send_file") {
+        FILE* fp = std::tmpfile();
+        REQUIRE(fp);
+        REQUIRE(std::fwrite(STR.data(), 1, N, fp) == N);
+        std::fflush(fp);
+
+        const size_t OFF = 5;
+        size_t nsent = 0;
+        while (nsent < N - OFF) {
+            auto res = csock.send_file(fileno(fp), OFF + nsent, N - OFF - nsent);
+            REQUIRE(res);
+            nsent += res.value();
+        }
+
+        // Past the end of the file sends nothing
+        auto res = csock.send_file(fileno(fp), N, 16);
+        REQUIRE(res);
+        REQUIRE(res.value() == 0);
+
+        std::fclose(fp);
+
+        char buf[512];
+        REQUIRE(ssock.read_n(buf, N - OFF).value() == N - OFF);
+        REQUIRE(string(buf, N - OFF) == STR.substr(OFF));
+    }
+#endif
+}
+
+#if defined(__linux__)
+TEST_CASE("tcp_socket zerocopy", "[stream_socket]") {
+    tcp_acceptor asock{inet_address{"localhost", 0}};
+    tcp_connector csock{asock.address()};
+    auto ssock = asock.accept().release();
+
+    if (!csock.zerocopy(true)) {
+        WARN("SO_ZEROCOPY not supported");
+        return;
+    }
+    REQUIRE(csock.zerocopy().value());
+
+    const string STR(32 * 1024, 'z');
+    auto before = socket_stats::snapshot();
+    auto res = csock.write_zerocopy(STR.data(), STR.size());
+    REQUIRE(res);
+    size_t n = res.value();
+
+    // It goes through the regular send path, so it's counted
+    auto diff = socket_stats::snapshot() - before;
+    REQUIRE(diff.bytesOut == (socket_stats::enabled() ? n : 0));
+
+    std::vector<char> buf(STR.size());
+    REQUIRE(ssock.read_n(buf.data(), n).value() == n);
+
+    // The completion arrives shortly after the data is acknowledged.
+    socket::zerocopy_completion comp{};
+    size_t ncomp = 0;
+    for (int i = 0; i < 100 && ncomp == 0; ++i) {
+        auto cres = csock.zerocopy_completions(&comp, 1);
+        REQUIRE(cres);
+        if ((ncomp = cres.value()) == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    REQUIRE(ncomp == 1);
+    REQUIRE(comp.contains(0));
+    REQUIRE(!comp.contains(1));
+
+    // Nothing else is pending
+    REQUIRE(csock.zerocopy_completions(&comp, 1).value() == 0);
+}
+#endif
+
+TEST_CASE("tcp_socket vectored read_n/write_n", "[stream_socket]") {
+    tcp_acceptor asock{inet_address{"localhost", 0}};
+    tcp_connector csock{asock.address()};
+    auto ssock = asock.accept().release();
+
+    // Big enough to need several partial writes through the socket buffers
+    const size_t N = 512 * 1024;
+    std::vector<char> outbuf(3 * N), inbuf(3 * N);
+    for (size_t i = 0; i < outbuf.size(); ++i) outbuf[i] = char(i * 7);
+
+    const std::vector<iovec> outv{
+        iovec{outbuf.data(), 10}, iovec{outbuf.data() + 10, 0},
+        iovec{outbuf.data() + 10, 2 * N - 10}, iovec{outbuf.data() + 2 * N, N}
+    };
+
+    // Split the reads at different places than the writes
+    iovec_array<3> inv;
+    inv.push_back(inbuf.data(), N + 3);
+    inv.push_back(inbuf.data() + N + 3, 1);
+    inv.push_back(inbuf.data() + N + 4, 2 * N - 4);
+
+    result<size_t> wres;
+    std::thread thr([&] { wres = csock.write_n(outv); });
+
+    auto res = ssock.read_n(inv);
+    thr.join();
+
+    REQUIRE(wres);
+    REQUIRE(wres.value() == 3 * N);
+    REQUIRE(res);
+    REQUIRE(res.value() == 3 * N);
+    REQUIRE(inbuf == outbuf);
+
+    // The ranges should be untouched
+    REQUIRE(outv[2].iov_len == 2 * N - 10);
+    REQUIRE(inv[0].iov_len == N + 3);
+
+    // End of stream stops the read short
+    char buf[16];
+    iovec v{buf, sizeof(buf)};
+    csock.close();
+    res = ssock.read_n(&v, 1);
+    REQUIRE(res);
+    REQUIRE(res.value() == 0);
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("tcp_socket tcp_info", "[stream_socket]") {
+    tcp_acceptor asock{inet_address{"localhost", 0}};
+    tcp_connector csock{asock.address()};
+    REQUIRE(csock);
+
+    auto ssock = asock.accept().release();
+    REQUIRE(ssock);
+
+    const string STR{"This is a test. This is only a test."};
+    char buf[64];
+    REQUIRE(csock.write(STR) == STR.size());
+    REQUIRE(ssock.read_n(buf, STR.size()) == STR.size());
+    REQUIRE(ssock.write(STR) == STR.size());
+    REQUIRE(csock.read_n(buf, STR.size()) == STR.size());
+
+    auto res = csock.tcp_info();
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+    REQUIRE(res);
+    auto ti = res.value();
+    REQUIRE(ti.sndMss > 0);
+    REQUIRE(ti.sndCwnd >= ti.sndMss);
+    REQUIRE(ti.bytesReceived >= STR.size());
+    #if defined(__linux__)
+    REQUIRE(ti.bytesAcked >= STR.size());
+    #endif
+
+    // The handle version is the same thing
+    REQUIRE(stream_socket::tcp_info(ssock.handle()));
+
+    // Not a valid socket
+    REQUIRE(!stream_socket::tcp_info(INVALID_SOCKET));
+#else
+    REQUIRE(res == errc::operation_not_supported);
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("tcp_socket options", "[stream_socket]") {
+    tcp_acceptor asock{inet_address{"localhost", 0}};
+    tcp_connector csock{asock.address()};
+    REQUIRE(csock);
+
+    SECTION("nodelay") {
+        REQUIRE(csock.nodelay(true));
+        REQUIRE(csock.nodelay().value());
+        REQUIRE(csock.nodelay(false));
+        REQUIRE(!csock.nodelay().value());
+    }
+
+    SECTION("keepalive") {
+        REQUIRE(csock.keepalive(false));
+        REQUIRE(!csock.keepalive().value());
+
+        tcp_keepalive ka{seconds{30}, seconds{5}, 3};
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+        REQUIRE(csock.keepalive(ka));
+        REQUIRE(csock.keepalive().value());
+#endif
+    }
+
+#if defined(__linux__)
+    SECTION("cork") {
+        REQUIRE(csock.cork(true));
+        REQUIRE(csock.cork().value());
+        REQUIRE(csock.cork(false));
+        REQUIRE(!csock.cork().value());
+    }
+
+    SECTION("quickack") {
+        REQUIRE(csock.quickack(true));
+        REQUIRE(csock.quickack());
+    }
+
+    SECTION("notsent_lowat") {
+        REQUIRE(csock.notsent_lowat(32768));
+        REQUIRE(csock.notsent_lowat().value() == 32768);
+    }
+
+    SECTION("user_timeout") {
+        REQUIRE(csock.user_timeout(milliseconds{2500}));
+        REQUIRE(csock.user_timeout().value() == milliseconds{2500});
+    }
+
+    SECTION("congestion") {
+        auto res = csock.congestion();
+        REQUIRE(res);
+        auto name = res.value();
+        REQUIRE(!name.empty());
+
+        // Setting the current algorithm back never needs privileges
+        REQUIRE(csock.congestion(name));
+        REQUIRE(csock.congestion().value() == name);
+
+        REQUIRE(!csock.congestion("no-such-algorithm"));
+    }
+
+    SECTION("busy_poll") {
+        REQUIRE(csock.busy_poll(microseconds{0}));
+        REQUIRE(csock.busy_poll().value() == microseconds{0});
+    }
+
+    SECTION("prefer_busy_poll") {
+        auto res = csock.prefer_busy_poll(true);
+        // Older kernels don't have the option
+        if (res) {
+            REQUIRE(csock.prefer_busy_poll().value());
+            REQUIRE(csock.prefer_busy_poll(false));
+            REQUIRE(!csock.prefer_busy_poll().value());
+        }
+        else {
+            REQUIRE(res == errc::no_protocol_option);
+        }
+    }
+
+    SECTION("max_pacing_rate") {
+        REQUIRE(csock.max_pacing_rate(1000000));
+        REQUIRE(csock.max_pacing_rate().value() == 1000000);
+
+        REQUIRE(csock.max_pacing_rate(~uint64_t(0)));
+        REQUIRE(csock.max_pacing_rate().value() == ~uint64_t(0));
+    }
+#endif
+
+    SECTION("profile") {
+        auto prof = tcp_profile::low_latency();
+        prof.userTimeout = milliseconds{5000};
+        REQUIRE(csock.apply(prof));
+        REQUIRE(csock.nodelay().value());
+#if defined(__linux__)
+        REQUIRE(csock.notsent_lowat().value() == *prof.notsentLowat);
+#endif
+
+        // An empty profile doesn't change anything
+        REQUIRE(csock.apply(tcp_profile{}));
+        REQUIRE(csock.nodelay().value());
+    }
 }
@@ -0,0 +1,170 @@
+// test_timer_wheel.cpp
+//
+// Unit tests for the sockpp timer_wheel class.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <memory>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/timer_wheel.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace sockpp;
+
+using timer = timer_wheel::timer;
+
+TEST_CASE("timer_wheel fires on time", "[timer_wheel]") {
+    timer_wheel wheel;
+    auto t0 = wheel.now();
+
+    REQUIRE(wheel.empty());
+    REQUIRE(wheel.next_timeout() < milliseconds{0});
+
+    // Delays on each side of the level boundaries
+    const int64_t delays[] = {1, 2, 63, 64, 65, 127, 4095, 4096, 4097, 300000, 20000000};
+    vector<unique_ptr<timer>> timers;
+    vector<int64_t> fired;
+
+    for (auto d : delays) {
+        timers.push_back(make_unique<timer>([&] {
+            fired.push_back(duration_cast<milliseconds>(wheel.now() - t0).count());
+        }));
+        wheel.schedule(*timers.back(), milliseconds{d});
+    }
+    REQUIRE(wheel.size() == timers.size());
+    REQUIRE(wheel.next_timeout() >= milliseconds{0});
+
+    SECTION("one tick at a time near the boundaries") {
+        REQUIRE(wheel.advance(t0 + milliseconds{62}) == 2);
+        REQUIRE(wheel.advance(t0 + milliseconds{63}) == 1);
+        REQUIRE(wheel.advance(t0 + milliseconds{64}) == 1);
+        REQUIRE(wheel.advance(t0 + milliseconds{4095}) == 3);
+        REQUIRE(wheel.advance(t0 + milliseconds{4096}) == 1);
+    }
+
+    SECTION("one big step") {
+        REQUIRE(wheel.advance(t0 + milliseconds{30000000}) == timers.size());
+    }
+
+    wheel.advance(t0 + milliseconds{30000000});
+    REQUIRE(wheel.empty());
+    REQUIRE(fired == vector<int64_t>(begin(delays), end(delays)));
+}
+
+TEST_CASE("timer_wheel re-arm", "[timer_wheel]") {
+    timer_wheel wheel;
+    auto t0 = wheel.now();
+
+    int nfired = 0;
+    timer tmr{[&nfired] { ++nfired; }};
+
+    SECTION("later deadline") {
+        wheel.schedule(tmr, milliseconds{10});
+        REQUIRE(wheel.advance(t0 + milliseconds{5}) == 0);
+
+        // As on each read of an idle connection
+        wheel.schedule(tmr, milliseconds{10});
+        REQUIRE(wheel.size() == 1);
+
+        REQUIRE(wheel.advance(t0 + milliseconds{14}) == 0);
+        REQUIRE(tmr.scheduled());
+        REQUIRE(wheel.advance(t0 + milliseconds{15}) == 1);
+        REQUIRE(nfired == 1);
+        REQUIRE(!tmr.scheduled());
+    }
+
+    SECTION("earlier deadline") {
+        wheel.schedule(tmr, seconds{10});
+        wheel.schedule(tmr, milliseconds{3});
+        REQUIRE(wheel.size() == 1);
+        REQUIRE(wheel.advance(t0 + milliseconds{3}) == 1);
+    }
+
+    SECTION("cancel") {
+        wheel.schedule(tmr, milliseconds{3});
+        tmr.cancel();
+        REQUIRE(wheel.empty());
+        REQUIRE(wheel.advance(t0 + milliseconds{10}) == 0);
+        REQUIRE(nfired == 0);
+    }
+
+    SECTION("periodic") {
+        tmr.set_callback([&] {
+            if (++nfired < 3)
+                wheel.schedule(tmr, milliseconds{100});
+        });
+        wheel.schedule(tmr, milliseconds{100});
+        REQUIRE(wheel.advance(t0 + seconds{1}) == 3);
+        REQUIRE(nfired == 3);
+    }
+}
+
+TEST_CASE("timer_wheel lifetimes", "[timer_wheel]") {
+    SECTION("callback destroys its timer") {
+        timer_wheel wheel;
+        auto tmr = make_unique<timer>();
+        tmr->set_callback([&tmr] { tmr.reset(); });
+
+        wheel.schedule(*tmr, milliseconds{1});
+        REQUIRE(wheel.advance(wheel.now() + milliseconds{1}) == 1);
+        REQUIRE(!tmr);
+    }
+
+    SECTION("timer destroyed first") {
+        timer_wheel wheel;
+        {
+            timer tmr{[] {}};
+            wheel.schedule(tmr, milliseconds{1});
+            REQUIRE(wheel.size() == 1);
+        }
+        REQUIRE(wheel.empty());
+    }
+
+    SECTION("wheel destroyed first") {
+        timer tmr{[] {}};
+        {
+            timer_wheel wheel;
+            wheel.schedule(tmr, milliseconds{1});
+        }
+        REQUIRE(!tmr.scheduled());
+    }
+}
@@ -0,0 +1,338 @@
+// test_tls_socket.cpp
+//
+// Unit tests for the sockpp TLS secure sockets.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include <csignal>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/inet_address.h"
+#include "sockpp/tls_acceptor.h"
+#include "sockpp/tls_connector.h"
+
+#if !defined(_WIN32)
+    #include <unistd.h>
+#endif
+
+using namespace std;
+using namespace sockpp;
+
+namespace {
+
+// A self-signed certificate for "localhost", and its key, in PEM format.
+struct test_cert
+{
+    string cert, key;
+
+    test_cert() {
+        EVP_PKEY* pkey = EVP_EC_gen("P-256");
+        X509* x = X509_new();
+
+        X509_set_version(x, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(x), 1);
+        X509_gmtime_adj(X509_getm_notBefore(x), 0);
+        X509_gmtime_adj(X509_getm_notAfter(x), 3600);
+        X509_set_pubkey(x, pkey);
+
+        auto name = X509_get_subject_name(x);
+        X509_NAME_add_entry_by_txt(
+            name, "CN", MBSTRING_ASC, (const unsigned char*)"localhost", -1, -1, 0
+        );
+        X509_set_issuer_name(x, name);
+
+        X509V3_CTX v3;
+        X509V3_set_ctx(&v3, x, x, nullptr, nullptr, 0);
+        auto ext = X509V3_EXT_conf_nid(
+            nullptr, &v3, NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1"
+        );
+        X509_add_ext(x, ext, -1);
+        X509_EXTENSION_free(ext);
+
+        X509_sign(x, pkey, EVP_sha256());
+
+        cert = to_pem([x](BIO* b) { PEM_write_bio_X509(b, x); });
+        key = to_pem([pkey](BIO* b) {
+            PEM_write_bio_PrivateKey(b, pkey, nullptr, nullptr, 0, nullptr, nullptr);
+        });
+
+        X509_free(x);
+        EVP_PKEY_free(pkey);
+    }
+
+    template <typename F>
+    static string to_pem(F f) {
+        BIO* b = BIO_new(BIO_s_mem());
+        f(b);
+        char* p;
+        long n = BIO_get_mem_data(b, &p);
+        string s{p, size_t(n)};
+        BIO_free(b);
+        return s;
+    }
+};
+
+const test_cert& the_cert() {
+    static test_cert c;
+    return c;
+}
+
+// An echo server that handles a number of connections, one at a time.
+void run_echo(tls_acceptor& acc, int nconn) {
+    for (int i = 0; i < nconn; ++i) {
+        auto res = acc.accept();
+        if (!res)
+            continue;
+
+        auto sock = res.release();
+        char buf[512];
+        result<size_t> n;
+        while ((n = sock.read(buf, sizeof(buf))) && n.value() > 0)
+            sock.write_n(buf, n.value());
+    }
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("tls_context", "[tls]") {
+    SECTION("client") {
+        tls_context ctx;
+        REQUIRE(ctx);
+        REQUIRE(ctx.is_client());
+        REQUIRE(ctx.native_handle());
+        REQUIRE(ctx.cached_sessions() == 0);
+    }
+
+    SECTION("server") {
+        tls_context ctx{tls_context::SERVER};
+        REQUIRE(ctx);
+        REQUIRE(ctx.role() == tls_context::SERVER);
+
+        REQUIRE(ctx.cert_pem(the_cert().cert));
+        REQUIRE(ctx.key_pem(the_cert().key));
+    }
+
+    SECTION("bad PEM") {
+        tls_context ctx{tls_context::SERVER};
+        auto res = ctx.cert_pem("not a certificate");
+        REQUIRE(!res);
+        REQUIRE(res.error().category() == tls_category());
+        REQUIRE(!res.error_message().empty());
+
+        REQUIRE(ctx.ca_pem("") == errc::invalid_argument);
+    }
+
+    SECTION("move") {
+        tls_context ctx;
+        tls_context ctx2{std::move(ctx)};
+        REQUIRE(!ctx);
+        REQUIRE(ctx2);
+    }
+}
+
+TEST_CASE("tls_socket connection", "[tls]") {
+    const auto& tc = the_cert();
+
+    tls_context srvCtx{tls_context::SERVER};
+    REQUIRE(srvCtx.cert_pem(tc.cert));
+    REQUIRE(srvCtx.key_pem(tc.key));
+
+    tls_acceptor acc{srvCtx, inet_address{"localhost", 0}};
+    REQUIRE(acc);
+    const auto ADDR = inet_address{acc.address()};
+
+    tls_context cliCtx;
+    REQUIRE(cliCtx.ca_pem(tc.cert));
+
+    SECTION("echo") {
+        thread thr{run_echo, std::ref(acc), 1};
+
+        tls_connector conn{cliCtx};
+        REQUIRE(conn.connect(ADDR, "localhost"));
+        REQUIRE(conn.is_established());
+        REQUIRE(!conn.session_reused());
+        REQUIRE(conn.protocol() == "TLSv1.3");
+        REQUIRE(!conn.cipher().empty());
+
+        const string MSG{"This is a secure test"};
+        REQUIRE(conn.write(MSG).value() == MSG.size());
+
+        char buf[64];
+        REQUIRE(conn.read_n(buf, MSG.size()).value() == MSG.size());
+        REQUIRE(string(buf, MSG.size()) == MSG);
+
+        // Gathered writes go out as a single record
+        const string A{"abc"}, B{"defgh"};
+        iovec outv[] = {
+            iovec{const_cast<char*>(A.data()), A.size()},
+            iovec{const_cast<char*>(B.data()), B.size()}
+        };
+        REQUIRE(conn.write_n(outv, 2).value() == A.size() + B.size());
+        REQUIRE(conn.read_n(buf, A.size() + B.size()).value() == A.size() + B.size());
+        REQUIRE(string(buf, A.size() + B.size()) == A + B);
+
+        REQUIRE(conn.close());
+        thr.join();
+    }
+
+    SECTION("address as peer name") {
+        thread thr{run_echo, std::ref(acc), 1};
+
+        tls_connector conn{cliCtx};
+        REQUIRE(conn.connect(ADDR, "127.0.0.1"));
+        REQUIRE(conn.is_established());
+
+        conn.close();
+        thr.join();
+    }
+
+    SECTION("untrusted server") {
+        thread thr{run_echo, std::ref(acc), 1};
+
+        tls_context ctx;
+        tls_connector conn{ctx};
+        auto res = conn.connect(ADDR, "localhost");
+        REQUIRE(!res);
+        REQUIRE(res.error().category() == tls_category());
+        REQUIRE(!conn);
+
+        thr.join();
+    }
+
+    SECTION("wrong name") {
+        thread thr{run_echo, std::ref(acc), 1};
+
+        tls_connector conn{cliCtx};
+        REQUIRE(!conn.connect(ADDR, "example.com"));
+
+        thr.join();
+    }
+
+    SECTION("session resumption") {
+        thread thr{run_echo, std::ref(acc), 2};
+
+        const string MSG{"again"};
+        char buf[64];
+
+        for (int i = 0; i < 2; ++i) {
+            tls_connector conn{cliCtx, ADDR, "localhost"};
+            REQUIRE(conn.session_reused() == (i == 1));
+
+            // The TLS 1.3 session ticket arrives with the first read
+            REQUIRE(conn.write(MSG));
+            REQUIRE(conn.read_n(buf, MSG.size()).value() == MSG.size());
+        }
+        REQUIRE(cliCtx.cached_sessions() == 1);
+
+        cliCtx.flush_sessions();
+        REQUIRE(cliCtx.cached_sessions() == 0);
+
+        thr.join();
+    }
+
+#if !defined(_WIN32)
+    SECTION("send_file") {
+        thread thr{run_echo, std::ref(acc), 1};
+
+        char path[] = "/tmp/sockpp_tls_XXXXXX";
+        int fd = ::mkstemp(path);
+        REQUIRE(fd >= 0);
+        ::unlink(path);
+
+        string data;
+        for (int i = 0; i < 5000; ++i) data += char('a' + (i % 26));
+        REQUIRE(::write(fd, data.data(), data.size()) == ssize_t(data.size()));
+
+        tls_connector conn{cliCtx, ADDR, "localhost"};
+
+        // Skip the first 100 bytes of the file
+        constexpr size_t OFF = 100;
+        size_t n = 0;
+        while (n < data.size() - OFF) {
+            auto res = conn.send_file(fd, OFF + n, data.size() - OFF - n);
+            REQUIRE(res);
+            n += res.value();
+        }
+        ::close(fd);
+
+        string buf(n, '\0');
+        REQUIRE(conn.read_n(&buf[0], n).value() == n);
+        REQUIRE(buf == data.substr(OFF));
+
+        // Without kernel TLS, the raw zero-copy write would bypass the
+        // encryption, so it's refused.
+    #if defined(__linux__)
+        if (!conn.ktls_send())
+            REQUIRE(conn.write_zerocopy(buf.data(), 1) == errc::operation_not_supported);
+    #endif
+
+        conn.close();
+        thr.join();
+    }
+
+    SECTION("broken pipe") {
+        // With the default action, a SIGPIPE would kill the test
+        auto prev = std::signal(SIGPIPE, SIG_DFL);
+
+        thread thr{[&] { (void)acc.accept(); }};
+        tls_connector conn{cliCtx, ADDR, "localhost"};
+        thr.join();
+
+        // The first writes can land before the peer's reset arrives
+        const string MSG{"Anyone there?"};
+        result<size_t> res;
+        for (int i = 0; i < 100; ++i) {
+            if (!(res = conn.write(MSG)))
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE((res == errc::broken_pipe || res == errc::connection_reset));
+
+        conn.close();
+        std::signal(SIGPIPE, prev);
+    }
+#endif
+}
@@ -0,0 +1,158 @@
+// test_udp_flow_table.cpp
+//
+// Unit tests for the sockpp udp_flow_table class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <string>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/udp_flow_table.h"
+
+using namespace std;
+using namespace sockpp;
+
+using flow_table = udp_flow_table<udp_socket>;
+
+namespace {
+
+// Gets a client socket bound to an ephemeral port on localhost
+udp_socket client() {
+    udp_socket sock;
+    sock.bind(inet_address{"localhost", 0});
+    sock.set_option(SOL_SOCKET, SO_RCVTIMEO, to_timeval(seconds(2)));
+    return sock;
+}
+
+}  // namespace
+
+TEST_CASE("udp_flow_table hot peer", "[udp_flow_table]") {
+    auto srvRes = flow_table::open_listener(inet_address{"localhost", 0});
+    REQUIRE(srvRes);
+    auto srv = srvRes.release();
+    REQUIRE(srv.reuse_port().value());
+    srv.set_option(SOL_SOCKET, SO_RCVTIMEO, to_timeval(seconds(2)));
+
+    flow_table::options opts;
+    opts.hot_packets = 2;
+    opts.create_flags = 0;
+
+    flow_table tbl{srv.address(), opts};
+
+    vector<inet_address> opened;
+    tbl.on_open([&](udp_socket&, const inet_address& peer) { opened.push_back(peer); });
+
+    auto cli = client();
+    char buf[16];
+    inet_address peer;
+
+    // The first datagram is answered from the main socket
+    REQUIRE(cli.send_to(string{"one"}, srv.address()));
+    REQUIRE(srv.recv_from(buf, sizeof(buf), &peer).value() == 3);
+    REQUIRE(peer == cli.address());
+    REQUIRE(tbl.note(peer) == nullptr);
+    REQUIRE(tbl.size() == 1);
+    REQUIRE(tbl.socket_count() == 0);
+
+    // The second makes the peer hot
+    REQUIRE(cli.send_to(string{"two"}, srv.address()));
+    REQUIRE(srv.recv_from(buf, sizeof(buf), &peer).value() == 3);
+    auto flow = tbl.note(peer);
+    REQUIRE(flow != nullptr);
+    REQUIRE(tbl.socket_count() == 1);
+    REQUIRE(tbl.find(peer) == flow);
+    REQUIRE(opened.size() == 1);
+    REQUIRE(opened[0] == peer);
+
+    REQUIRE(flow->address() == srv.address());
+    REQUIRE(flow->peer_address() == peer);
+
+    // The reply comes from the server's address
+    REQUIRE(flow->send(string{"reply"}));
+    inet_address from;
+    REQUIRE(cli.recv_from(buf, sizeof(buf), &from).value() == 5);
+    REQUIRE(from == srv.address());
+
+#if defined(__linux__)
+    // And the peer's datagrams now go to its own socket
+    REQUIRE(cli.send_to(string{"three"}, srv.address()));
+    REQUIRE(flow->recv(buf, sizeof(buf)).value() == 5);
+    REQUIRE(string(buf, 5) == "three");
+#endif
+}
+
+TEST_CASE("udp_flow_table eviction", "[udp_flow_table]") {
+    auto srv = flow_table::open_listener(inet_address{"localhost", 0}).release();
+
+    flow_table::options opts;
+    opts.max_flows = 2;
+    opts.hot_packets = 1;
+    opts.idle_timeout = milliseconds(100);
+
+    flow_table tbl{srv.address(), opts};
+
+    vector<inet_address> closed;
+    tbl.on_close([&](udp_socket&, const inet_address& peer) { closed.push_back(peer); });
+
+    inet_address p1{"localhost", 10001}, p2{"localhost", 10002}, p3{"localhost", 10003};
+    auto t0 = flow_table::clock::now();
+
+    REQUIRE(tbl.note(p1, t0));
+    REQUIRE(tbl.note(p2, t0 + milliseconds(10)));
+    REQUIRE(tbl.size() == 2);
+
+    // Using p1 again leaves p2 as the least recently used
+    REQUIRE(tbl.note(p1, t0 + milliseconds(20)));
+    REQUIRE(tbl.note(p3, t0 + milliseconds(30)));
+    REQUIRE(tbl.size() == 2);
+    REQUIRE(closed.size() == 1);
+    REQUIRE(closed[0] == p2);
+    REQUIRE(!tbl.find(p2));
+
+    // Only p1 has been idle long enough
+    REQUIRE(tbl.evict_idle(t0 + milliseconds(125)) == 1);
+    REQUIRE(tbl.size() == 1);
+    REQUIRE(closed.back() == p1);
+
+    REQUIRE(tbl.remove(p3));
+    REQUIRE(!tbl.remove(p3));
+    REQUIRE(tbl.size() == 0);
+    REQUIRE(tbl.socket_count() == 0);
+    REQUIRE(closed.size() == 3);
+}
@@ -174,3 +174,51 @@ TEST_CASE("unix_address sockaddr_un constructor", "[address]") {
     unix_address addr2(unaddr);
     REQUIRE(!addr2);
 }
+
+TEST_CASE("unix_address to_chars", "[address]") {
+    unix_address addr{PATH};
+    const string STR{"unix:" + PATH};
+
+    char buf[unix_address::MAX_STR_LEN];
+    auto res = addr.to_chars(buf, buf + sizeof(buf));
+    REQUIRE(res.ec == std::errc{});
+    REQUIRE(string(buf, res.ptr) == STR);
+    REQUIRE(addr.to_string() == STR);
+
+    res = addr.to_chars(buf, buf + 5);
+    REQUIRE(res.ec == std::errc::value_too_large);
+}
+
+#if defined(__linux__)
+TEST_CASE("unix_address abstract", "[address]") {
+    const string NAME{"sockpp-test"};
+
+    auto res = unix_address::create_abstract(NAME);
+    REQUIRE(res);
+    auto addr = res.release();
+
+    REQUIRE(addr.is_set());
+    REQUIRE(addr.is_abstract());
+    REQUIRE('\0' + NAME == addr.path());
+    REQUIRE(offsetof(sockaddr_un, sun_path) + 1 + NAME.size() == addr.size());
+    REQUIRE(addr.to_string() == "unix:@" + NAME);
+
+    SECTION("path constructor") {
+        unix_address addr2{addr.path()};
+        REQUIRE(addr2.is_abstract());
+        REQUIRE(addr2 == addr);
+    }
+
+    SECTION("not abstract") {
+        REQUIRE(!unix_address{PATH}.is_abstract());
+        REQUIRE(!unix_address{}.is_abstract());
+    }
+
+    SECTION("bad names") {
+        REQUIRE(unix_address::create_abstract("") == errc::invalid_argument);
+
+        string name(unix_address::MAX_PATH_NAME, 'x');
+        REQUIRE(unix_address::create_abstract(name) == errc::invalid_argument);
+    }
+}
+#endif
@@ -0,0 +1,122 @@
+// test_unix_seqpacket_socket.cpp
+//
+// Unit tests for the Unix-domain sequenced-packet socket classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/unix_seqpacket_acceptor.h"
+#include "sockpp/unix_seqpacket_socket.h"
+
+using namespace sockpp;
+using namespace std;
+
+// SOCK_SEQPACKET isn't supported for Unix-domain sockets on macOS
+#if !defined(__APPLE__)
+
+TEST_CASE("unix seqpacket socket pair", "[unix_seqpacket_socket]") {
+    auto res = unix_seqpacket_socket::pair();
+    REQUIRE(res);
+
+    auto [sock1, sock2] = res.release();
+    REQUIRE(sock1);
+    REQUIRE(sock2);
+
+    // Each write is received as a separate message
+    REQUIRE(sock1.write("one") == size_t(3));
+    REQUIRE(sock1.write("three") == size_t(5));
+
+    char buf[64];
+    REQUIRE(sock2.read(buf, sizeof(buf)) == size_t(3));
+    REQUIRE(string(buf, 3) == "one");
+    REQUIRE(sock2.read_message(buf, sizeof(buf)) == size_t(5));
+    REQUIRE(string(buf, 5) == "three");
+
+    SECTION("truncated") {
+        REQUIRE(sock1.write("too long") == size_t(8));
+        REQUIRE(sock2.read_message(buf, 3) == errc::message_size);
+
+        // The rest of the message is gone
+        REQUIRE(sock1.write("next") == size_t(4));
+        REQUIRE(sock2.read_message(buf, sizeof(buf)) == size_t(4));
+        REQUIRE(string(buf, 4) == "next");
+    }
+
+    SECTION("closed") {
+        sock1.close();
+        REQUIRE(sock2.read_message(buf, sizeof(buf)) == size_t(0));
+    }
+}
+
+TEST_CASE("unix seqpacket acceptor", "[unix_seqpacket_socket]") {
+    #if defined(__linux__)
+    auto addr = unix_address::create_abstract("sockpp-seqpacket-test").release();
+    #else
+    const string PATH{"/tmp/sockpp-seqpacket-test.sock"};
+    ::unlink(PATH.c_str());
+    unix_address addr{PATH};
+    #endif
+
+    unix_seqpacket_acceptor acc;
+    REQUIRE(acc.open(addr));
+    REQUIRE(acc.address() == addr);
+
+    unix_seqpacket_connector conn;
+    REQUIRE(conn.connect(addr));
+    REQUIRE(conn.peer_address() == addr);
+
+    auto res = acc.accept();
+    REQUIRE(res);
+    auto sock = res.release();
+
+    REQUIRE(conn.write("hello") == size_t(5));
+    REQUIRE(conn.write("world") == size_t(5));
+
+    char buf[64];
+    REQUIRE(sock.read_message(buf, sizeof(buf)) == size_t(5));
+    REQUIRE(string(buf, 5) == "hello");
+    REQUIRE(sock.read_message(buf, sizeof(buf)) == size_t(5));
+    REQUIRE(string(buf, 5) == "world");
+
+    #if !defined(__linux__)
+    ::unlink(PATH.c_str());
+    #endif
+}
+
+#endif
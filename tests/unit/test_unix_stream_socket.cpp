@@ -41,6 +41,8 @@
 #include <string>
 
 #include "catch2_version.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
 #include "sockpp/unix_stream_socket.h"
 
 using namespace sockpp;
@@ -69,4 +71,89 @@ TEST_CASE("unix stream socket pair", "[unix_stream_socket]") {
 
     std::string msg{buf, buf + N};
     REQUIRE(msg == MSG);
+
+    // A unix address is large, so it's only kept when asked for
+    REQUIRE(sizeof(unix_stream_socket) == sizeof(stream_socket));
+    REQUIRE(!sock1.has_cached_peer_address());
+}
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("unix stream socket send_fds/recv_fds", "[unix_stream_socket]") {
+    auto [sock1, sock2] = unix_stream_socket::pair().release();
+
+    auto [pa, pb] = unix_stream_socket::pair().release();
+    int fds[] = {pa.handle(), pb.handle()};
+
+    const std::string MSG{"Two for you"};
+    REQUIRE(sock1.send_fds(fds, 2, MSG.data(), MSG.size()).value() == MSG.size());
+
+    char buf[64];
+    int rfds[4] = {-1, -1, -1, -1};
+    size_t nfd = 4;
+
+    REQUIRE(sock2.recv_fds(rfds, nfd, buf, sizeof(buf)).value() == MSG.size());
+    REQUIRE(nfd == 2);
+    REQUIRE(std::string(buf, MSG.size()) == MSG);
+
+    // The received descriptors are new handles to the same sockets
+    unix_stream_socket ra{rfds[0]}, rb{rfds[1]};
+    REQUIRE(ra.handle() != pa.handle());
+    REQUIRE(ra.write(MSG).value() == MSG.size());
+    REQUIRE(pb.read_n(buf, MSG.size()).value() == MSG.size());
+
+    SECTION("too many") {
+        int many[unix_stream_socket::MAX_FDS + 1] = {};
+        REQUIRE(sock1.send_fds(many, unix_stream_socket::MAX_FDS + 1, "x", 1) ==
+                errc::invalid_argument);
+    }
+}
+
+TEST_CASE("unix stream socket handoff", "[unix_stream_socket]") {
+    auto [sock1, sock2] = unix_stream_socket::pair().release();
+
+    SECTION("acceptor") {
+        tcp_acceptor acc{inet_address{"localhost", 0}};
+        auto addr = acc.address();
+
+        // A client that connects before the handoff stays in the backlog
+        tcp_connector early{addr};
+        REQUIRE(early);
+
+        REQUIRE(sock1.send_socket(acc));
+        REQUIRE(!acc.is_open());
+
+        auto res = sock2.recv_socket<tcp_acceptor>();
+        REQUIRE(res);
+        auto acc2 = res.release();
+        REQUIRE(acc2.address() == addr);
+
+        REQUIRE(acc2.accept());
+
+        tcp_connector late{addr};
+        REQUIRE(late);
+        REQUIRE(acc2.accept());
+    }
+
+    SECTION("connection") {
+        tcp_acceptor acc{inet_address{"localhost", 0}};
+        tcp_connector conn{acc.address()};
+        auto sock = acc.accept().release();
+
+        REQUIRE(sock1.send_socket(std::move(sock)));
+
+        auto res = sock2.recv_socket<tcp_socket>();
+        REQUIRE(res);
+        auto worker = res.release();
+
+        const std::string MSG{"Handled by the worker"};
+        char buf[64];
+        REQUIRE(conn.write(MSG).value() == MSG.size());
+        REQUIRE(worker.read_n(buf, MSG.size()).value() == MSG.size());
+    }
+
+    SECTION("peer closed") {
+        sock1.close();
+        REQUIRE(sock2.recv_socket<tcp_socket>() == errc::connection_reset);
+    }
 }
@@ -0,0 +1,220 @@
+// test_uring.cpp
+//
+// Unit tests for the `uring` I/O engine.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <cstring>
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/uring.h"
+#include "tcp_pair.h"
+
+using namespace sockpp;
+using namespace std::chrono;
+
+// --------------------------------------------------------------------------
+
+TEST_CASE("uring send/recv", "[uring]") {
+    error_code ec;
+    uring ring{32, ec};
+    if (ec) {
+        WARN("io_uring not available: " << ec.message());
+        return;
+    }
+
+    auto [csock, ssock] = make_tcp_pair();
+
+    const std::string MSG{"Hello, io_uring"};
+    char buf[64];
+
+    REQUIRE(ring.send(csock, MSG.data(), MSG.size(), 1));
+    REQUIRE(ring.recv(ssock, buf, sizeof(buf), 2));
+    REQUIRE(ring.pending() == 2);
+
+    uring::completion cqes[4];
+    size_t ndone = 0;
+    bool sent = false, rcvd = false;
+
+    while (ndone < 2) {
+        auto res = ring.wait(cqes, 4, seconds{2});
+        REQUIRE(res);
+        REQUIRE(res.value() > 0);
+
+        for (size_t i = 0; i < res.value(); ++i, ++ndone) {
+            auto n = cqes[i].get();
+            REQUIRE(n);
+            REQUIRE(n.value() == MSG.size());
+            if (cqes[i].user_data == 1)
+                sent = true;
+            else if (cqes[i].user_data == 2)
+                rcvd = true;
+        }
+    }
+
+    REQUIRE(sent);
+    REQUIRE(rcvd);
+    REQUIRE(std::string(buf, MSG.size()) == MSG);
+    REQUIRE(ring.pending() == 0);
+}
+
+TEST_CASE("uring close", "[uring]") {
+    error_code ec;
+    uring ring{32, ec};
+    if (ec) {
+        WARN("io_uring not available: " << ec.message());
+        return;
+    }
+
+    auto [csock, ssock] = make_tcp_pair();
+
+    REQUIRE(ring.close(std::move(ssock), 7));
+    REQUIRE(!ssock.is_open());
+
+    uring::completion cqe;
+    auto res = ring.wait(&cqe, 1, seconds{2});
+    REQUIRE(res.value() == 1);
+    REQUIRE(cqe.user_data == 7);
+    REQUIRE(cqe.get());
+
+    // The peer sees the connection closed
+    char buf[16];
+    REQUIRE(csock.read(buf, sizeof(buf)).value() == 0);
+}
+
+TEST_CASE("uring wait timeout", "[uring]") {
+    error_code ec;
+    uring ring{8, ec};
+    if (ec)
+        return;
+
+    auto [csock, ssock] = make_tcp_pair();
+
+    char buf[16];
+    REQUIRE(ring.recv(ssock, buf, sizeof(buf), 1));
+
+    uring::completion cqe;
+    auto res = ring.wait(&cqe, 1, milliseconds{10});
+    REQUIRE(res);
+    REQUIRE(res.value() == 0);
+
+    REQUIRE(ring.cancel(1, 2));
+    size_t n = 0;
+    while (n < 2) {
+        auto r = ring.wait(&cqe, 1, seconds{2});
+        REQUIRE(r);
+        REQUIRE(r.value() == 1);
+        ++n;
+    }
+}
+
+TEST_CASE("uring multishot accept", "[uring]") {
+    error_code ec;
+    uring ring{32, ec};
+    if (ec)
+        return;
+
+    tcp_acceptor acc{inet_address{"localhost", 0}};
+    auto addr = acc.address();
+
+    REQUIRE(ring.accept_multishot(acc, 42));
+    REQUIRE(ring.submit());
+
+    tcp_connector c1{addr}, c2{addr};
+
+    uring::completion cqes[4];
+    size_t naccept = 0;
+
+    while (naccept < 2) {
+        auto res = ring.wait(cqes, 4, seconds{2});
+        REQUIRE(res);
+        REQUIRE(res.value() > 0);
+
+        for (size_t i = 0; i < res.value(); ++i) {
+            REQUIRE(cqes[i].user_data == 42);
+            auto fd = cqes[i].get();
+            REQUIRE(fd);
+            if (!cqes[i].more())
+                WARN("multishot accept not supported by this kernel");
+            tcp_socket sock{socket_t(fd.value())};
+            REQUIRE(sock);
+            ++naccept;
+        }
+    }
+}
+
+TEST_CASE("uring buffer ring recv", "[uring]") {
+    error_code ec;
+    uring ring{32, ec};
+    if (ec)
+        return;
+
+    uring_buffer_ring bufs{ring, 1, 8, 256, ec};
+    if (ec) {
+        WARN("io_uring buffer rings not available: " << ec.message());
+        return;
+    }
+
+    REQUIRE(bufs.group_id() == 1);
+    REQUIRE(bufs.buffer_size() == 256);
+
+    auto [csock, ssock] = make_tcp_pair();
+
+    REQUIRE(ring.recv_select(ssock, bufs.group_id(), 7));
+    REQUIRE(ring.submit());
+
+    const std::string MSG{"buffer ring"};
+    REQUIRE(csock.write(MSG));
+
+    uring::completion cqe;
+    auto res = ring.wait(&cqe, 1, seconds{2});
+    REQUIRE(res);
+    REQUIRE(res.value() == 1);
+    REQUIRE(cqe.user_data == 7);
+    REQUIRE(cqe.has_buffer());
+
+    auto n = cqe.get();
+    REQUIRE(n);
+    REQUIRE(n.value() == MSG.size());
+    auto bid = cqe.buffer_id();
+    REQUIRE(std::string((const char*)bufs.buffer(bid), n.value()) == MSG);
+    bufs.recycle(bid);
+}
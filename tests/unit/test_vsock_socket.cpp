@@ -0,0 +1,106 @@
+// test_vsock_socket.cpp
+//
+// Unit tests for the sockpp vsock address and socket classes.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <sstream>
+#include <string>
+
+#include "catch2_version.h"
+#include "sockpp/vsock_acceptor.h"
+#include "sockpp/vsock_connector.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("vsock_address", "[vsock]") {
+    SECTION("default") {
+        vsock_address addr;
+        REQUIRE(!addr.is_set());
+        REQUIRE(addr.size() == sizeof(sockaddr_vm));
+    }
+
+    SECTION("cid and port") {
+        vsock_address addr{vsock_address::HOST_CID, 5000};
+        REQUIRE(addr.is_set());
+        REQUIRE(addr.family() == AF_VSOCK);
+        REQUIRE(addr.cid() == 2);
+        REQUIRE(addr.port() == 5000);
+        REQUIRE(addr.to_string() == "vsock:2:5000");
+
+        ostringstream os;
+        os << addr;
+        REQUIRE(os.str() == "vsock:2:5000");
+
+        vsock_address addr2{static_cast<const sock_address&>(addr)};
+        REQUIRE(addr2 == addr);
+    }
+
+    SECTION("any") {
+        vsock_address addr{1234};
+        REQUIRE(addr.cid() == vsock_address::ANY_CID);
+        REQUIRE(addr.to_string() == "vsock:-1:1234");
+    }
+}
+
+TEST_CASE("vsock_socket", "[vsock]") {
+    vsock_acceptor acc;
+    if (!acc.open(vsock_address{vsock_address::LOCAL_CID, vsock_address::ANY_PORT})) {
+        WARN("vsock loopback not available. Skipping.");
+        return;
+    }
+
+    auto addr = acc.address();
+    REQUIRE(addr.cid() == vsock_address::LOCAL_CID);
+    REQUIRE(addr.port() != vsock_address::ANY_PORT);
+
+    vsock_connector conn{addr};
+    REQUIRE(conn);
+
+    auto res = acc.accept();
+    REQUIRE(res);
+    auto srv = res.release();
+
+    const string MSG{"Hello, host"};
+    REQUIRE(conn.write(MSG) == MSG.size());
+
+    char buf[32];
+    REQUIRE(srv.read_n(buf, MSG.size()) == MSG.size());
+    REQUIRE(string(buf, MSG.size()) == MSG);
+}
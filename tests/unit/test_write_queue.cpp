@@ -0,0 +1,171 @@
+// test_write_queue.cpp
+//
+// Unit tests for the sockpp write_queue class.
+//
+
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/write_queue.h"
+#include "tcp_pair.h"
+
+using namespace std;
+using namespace sockpp;
+
+namespace {
+
+// Reads exactly n bytes from the socket
+string read_str(stream_socket& sock, size_t n) {
+    string s(n, '\0');
+    auto res = sock.read_n(&s[0], n);
+    s.resize(res ? res.value() : 0);
+    return s;
+}
+
+}  // namespace
+
+TEST_CASE("write_queue coalesces", "[write_queue]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    write_queue q{p.cli};
+    REQUIRE(q.empty());
+
+    SECTION("small messages share a segment") {
+        REQUIRE(q.push("one,", 4));
+        REQUIRE(q.push(string{"two,"}));
+        REQUIRE(q.push(std::string{"three"}));
+        REQUIRE(q.size() == 13);
+        REQUIRE(q.segments() == 1);
+
+        REQUIRE(q.flush().value() == 13);
+        REQUIRE(q.empty());
+        REQUIRE(read_str(p.srv, 13) == "one,two,three");
+    }
+
+    SECTION("large and shared messages") {
+        string big(2000, 'b');
+        auto shared = make_shared<const string>(3000, 's');
+        weak_ptr<const string> wk = shared;
+
+        REQUIRE(q.push("<", 1));
+        REQUIRE(q.push(string{big}));
+        REQUIRE(q.push(std::move(shared)));
+        REQUIRE(q.push(">", 1));
+        REQUIRE(q.segments() == 4);
+        REQUIRE(!wk.expired());
+
+        REQUIRE(q.flush().value() == 5002);
+        REQUIRE(wk.expired());
+        REQUIRE(read_str(p.srv, 5002) == "<" + big + string(3000, 's') + ">");
+    }
+
+    SECTION("pooled buffers") {
+        buffer_pool pool{1024};
+        auto buf = pool.get();
+        buf.resize(1000);
+        std::fill_n(buf.data(), 1000, uint8_t('p'));
+
+        REQUIRE(q.push(std::move(buf)));
+        REQUIRE(q.flush().value() == 1000);
+        REQUIRE(read_str(p.srv, 1000) == string(1000, 'p'));
+    }
+}
+
+TEST_CASE("write_queue flush threshold", "[write_queue]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+
+    write_queue q{p.cli, 100};
+
+    REQUIRE(q.push(string(60, 'x')));
+    REQUIRE(q.size() == 60);
+
+    // Passes the threshold, so it goes out on its own
+    REQUIRE(q.push(string(60, 'y')));
+    REQUIRE(q.empty());
+    REQUIRE(read_str(p.srv, 120) == string(60, 'x') + string(60, 'y'));
+}
+
+TEST_CASE("write_queue backpressure", "[write_queue]") {
+    tcp_pair p;
+    REQUIRE(p.srv);
+    REQUIRE(p.cli.set_non_blocking());
+
+    // Never flushes on its own
+    write_queue q{p.cli, size_t(-1), 1000, 200};
+
+    vector<bool> events;
+    q.on_backpressure([&events](bool paused) { events.push_back(paused); });
+
+    REQUIRE(q.push(string(600, 'a')));
+    REQUIRE(!q.paused());
+    REQUIRE(q.push(string(600, 'b')));
+    REQUIRE(q.paused());
+    REQUIRE(events == vector<bool>{true});
+
+    REQUIRE(q.push("c", 1) == errc::no_buffer_space);
+    REQUIRE(q.size() == 1200);
+
+    REQUIRE(q.flush().value() == 1200);
+    REQUIRE(!q.paused());
+    REQUIRE(events == vector<bool>{true, false});
+    REQUIRE(q.push("c", 1));
+
+    SECTION("slow peer") {
+        // Fill the socket buffers until the queue backs up
+        string blk(64 * 1024, 'z');
+        while (q.push(string{blk}) && q.flush() && q.empty());
+        REQUIRE(!q.empty());
+
+        // A would-block is not an error, and the data stays queued
+        auto n = q.size();
+        REQUIRE(q.flush().value() == 0);
+        REQUIRE(q.size() == n);
+
+        q.clear();
+        REQUIRE(q.empty());
+        REQUIRE(!q.paused());
+    }
+}
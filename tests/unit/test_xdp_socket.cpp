@@ -0,0 +1,244 @@
+// test_xdp_socket.cpp
+//
+// Unit tests for the xdp_socket class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "catch2_version.h"
+#include "sockpp/packet_socket.h"
+#include "sockpp/xdp_socket.h"
+
+using namespace sockpp;
+using namespace std;
+
+// These run on the loopback interface in copy mode. A tiny XDP program
+// redirects just the frames of one local experimental EtherType into the
+// socket, so that the rest of the loopback traffic isn't disturbed. The
+// tests are skipped if the program can't be loaded and attached.
+
+static const string IFACE{"lo"};
+static const uint16_t RX_PROTO = 0x88B6, TX_PROTO = 0x88B7;
+
+namespace {
+
+int sys_bpf(int cmd, bpf_attr& attr) {
+    return int(::syscall(__NR_bpf, cmd, &attr, sizeof(attr)));
+}
+
+// An XSKMAP and a program that redirects RX_PROTO frames into it, attached
+// to the interface for as long as the object lives.
+struct redirect_prog
+{
+    int mapFd = -1, progFd = -1, linkFd = -1;
+
+    explicit redirect_prog(unsigned ifindex) {
+        bpf_attr attr{};
+        attr.map_type = BPF_MAP_TYPE_XSKMAP;
+        attr.key_size = attr.value_size = sizeof(uint32_t);
+        attr.max_entries = 1;
+        if ((mapFd = sys_bpf(BPF_MAP_CREATE, attr)) < 0)
+            return;
+
+        // EtherType at offset 12, as loaded from network byte order
+        const int32_t ETYPE = int32_t(((RX_PROTO & 0xFF) << 8) | (RX_PROTO >> 8));
+
+        bpf_insn prog[] = {
+            {0x61, 2, 1, 0, 0},       // r2 = ctx->data
+            {0x61, 3, 1, 4, 0},       // r3 = ctx->data_end
+            {0xbf, 4, 2, 0, 0},       // r4 = r2
+            {0x07, 4, 0, 0, 14},      // r4 += 14
+            {0x2d, 4, 3, 8, 0},       // if r4 > r3 goto pass
+            {0x69, 4, 2, 12, 0},      // r4 = *(u16*)(r2 + 12)
+            {0x55, 4, 0, 6, ETYPE},   // if r4 != ETYPE goto pass
+            {0x61, 2, 1, 16, 0},      // r2 = ctx->rx_queue_index
+            {0x18, 1, BPF_PSEUDO_MAP_FD, 0, mapFd},
+            {0, 0, 0, 0, 0},           // r1 = map
+            {0xb7, 3, 0, 0, XDP_PASS},  // r3 = XDP_PASS
+            {0x85, 0, 0, 0, BPF_FUNC_redirect_map},
+            {0x95, 0, 0, 0, 0},         // exit
+            {0xb7, 0, 0, 0, XDP_PASS},  // pass: r0 = XDP_PASS
+            {0x95, 0, 0, 0, 0},         // exit
+        };
+
+        const char LICENSE[] = "BSD";
+
+        attr = bpf_attr{};
+        attr.prog_type = BPF_PROG_TYPE_XDP;
+        attr.insn_cnt = sizeof(prog) / sizeof(prog[0]);
+        attr.insns = uint64_t(uintptr_t(prog));
+        attr.license = uint64_t(uintptr_t(LICENSE));
+        if ((progFd = sys_bpf(BPF_PROG_LOAD, attr)) < 0)
+            return;
+
+        attr = bpf_attr{};
+        attr.link_create.prog_fd = uint32_t(progFd);
+        attr.link_create.target_ifindex = ifindex;
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+        linkFd = sys_bpf(BPF_LINK_CREATE, attr);
+    }
+
+    ~redirect_prog() {
+        for (int fd : {linkFd, progFd, mapFd}) {
+            if (fd >= 0)
+                ::close(fd);
+        }
+    }
+
+    explicit operator bool() const { return linkFd >= 0; }
+};
+
+// Makes an Ethernet frame for the protocol with a sequence number.
+vector<uint8_t> make_frame(uint16_t proto, uint32_t seq) {
+    vector<uint8_t> frame(64, 0);
+    frame[12] = uint8_t(proto >> 8);
+    frame[13] = uint8_t(proto & 0xFF);
+    memcpy(&frame[14], &seq, sizeof(seq));
+    return frame;
+}
+
+}  // namespace
+
+// --------------------------------------------------------------------------
+
+// The kernel releases the binding of an XDP socket to its queue lazily,
+// so the socket is opened just once, for all the checks.
+
+TEST_CASE("xdp_socket params", "[xdp]") {
+    SECTION("bad ring size") {
+        xdp_params params;
+        params.ring_size = 100;
+
+        xdp_socket sock;
+        REQUIRE(sock.open(IFACE, 0, params) == errc::invalid_argument);
+        REQUIRE(!sock);
+    }
+
+    SECTION("unopened") {
+        xdp_socket sock;
+        REQUIRE(sock.tx_queue("x", 1) == errc::bad_file_descriptor);
+        REQUIRE(sock.recv([](const xdp_frame&) {}, milliseconds{0}) ==
+                errc::bad_file_descriptor);
+    }
+}
+
+TEST_CASE("xdp_socket", "[xdp]") {
+    xdp_params params;
+    params.frame_size = 2048;
+    params.frame_count = 256;
+    params.ring_size = 128;
+    params.bind_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+
+    auto addr = packet_address::create(IFACE).value();
+    redirect_prog prog{unsigned(addr.index())};
+    if (!prog) {
+        WARN("Can't attach an XDP program to " << IFACE << ". Skipping.");
+        return;
+    }
+
+    error_code ec;
+    xdp_socket xsk{IFACE, 0, params, ec};
+    if (ec) {
+        WARN("Can't open an XDP socket on " << IFACE << ": " << ec.message());
+        return;
+    }
+    REQUIRE(xsk);
+    REQUIRE(xsk.queue_id() == 0);
+    REQUIRE(xsk.register_in_map(prog.mapFd));
+
+    // ----- Receive -----
+
+    packet_socket sender{packet_address{unsigned(addr.index()), RX_PROTO}};
+    const uint32_t N = 8;
+
+    for (uint32_t i = 0; i < N; ++i) {
+        auto frame = make_frame(RX_PROTO, i);
+        REQUIRE(sender.send_to(frame.data(), frame.size(), addr));
+    }
+
+    uint32_t n = 0;
+    bool ok = true;
+
+    for (int i = 0; i < 10 && n < N; ++i) {
+        auto res = xsk.recv(
+            [&](const xdp_frame& frame) {
+                uint32_t seq;
+                memcpy(&seq, frame.data() + 14, sizeof(seq));
+                ok = ok && frame.size() == 64 && seq == n;
+                ++n;
+            },
+            milliseconds{100}
+        );
+        REQUIRE(res);
+    }
+
+    REQUIRE(ok);
+    REQUIRE(n == N);
+
+    auto st = xsk.stats();
+    REQUIRE(st);
+    REQUIRE(st.value().rx_dropped == 0);
+
+    // ----- Transmit -----
+
+    packet_socket rcvr{packet_address{unsigned(addr.index()), TX_PROTO}};
+    REQUIRE(rcvr.set_option(SOL_SOCKET, SO_RCVTIMEO, to_timeval(seconds{1})));
+
+    for (uint32_t i = 0; i < N; ++i) {
+        auto frame = make_frame(TX_PROTO, i);
+        REQUIRE(xsk.tx_queue(frame.data(), frame.size()));
+    }
+    REQUIRE(xsk.tx_flush() == size_t(N));
+
+    for (uint32_t i = 0; i < N; ++i) {
+        uint8_t buf[128];
+        REQUIRE(rcvr.recv_from(buf, sizeof(buf)) == size_t(64));
+
+        uint32_t seq;
+        memcpy(&seq, buf + 14, sizeof(seq));
+        REQUIRE(seq == i);
+    }
+}
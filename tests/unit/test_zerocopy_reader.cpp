@@ -0,0 +1,116 @@
+// test_zerocopy_reader.cpp
+//
+// Unit tests for the sockpp zerocopy_reader class.
+//
+
+// --------------------------------------------------------------------------
+// This file is part of the "sockpp" C++ socket library.
+//
+// Copyright (c) 2026 Frank Pagliughi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+// contributors may be used to endorse or promote products derived from this
+// software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+// THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+//
+
+
+#include <string>
+#include <thread>
+
+#include "catch2_version.h"
+#include "sockpp/tcp_acceptor.h"
+#include "sockpp/tcp_connector.h"
+#include "sockpp/zerocopy_reader.h"
+
+using namespace std;
+using namespace sockpp;
+
+TEST_CASE("zerocopy_reader", "[zerocopy_reader]") {
+    tcp_acceptor acc{inet_address("localhost", 0)};
+    tcp_connector cli{acc.address()};
+    tcp_socket srv{acc.accept().release()};
+    REQUIRE(srv);
+
+    zerocopy_reader rdr{srv, 64 * 1024, 1024};
+    if (rdr.is_mapped()) {
+        REQUIRE(rdr.window_size() >= 64 * 1024);
+        REQUIRE(rdr.window_size() % 4096 == 0);
+    }
+    else
+        WARN("TCP zero-copy receive not supported. Testing the copy fallback.");
+
+    SECTION("stream") {
+        // A pattern that won't line up with the page boundaries
+        const size_t N = 1024 * 1024;
+        string data(N, '\0');
+        for (size_t i = 0; i < N; ++i) data[i] = char(i % 251);
+
+        thread thr{[&] {
+            cli.write_n(data.data(), N);
+            cli.shutdown(SHUT_WR);
+        }};
+
+        string got;
+        for (;;) {
+            auto res = rdr.read();
+            REQUIRE(res);
+            auto ch = res.value();
+            if (ch.empty())
+                break;
+            REQUIRE(ch.copied.size() <= 1024);
+            got.append(ch.mapped);
+            got.append(ch.copied);
+        }
+        thr.join();
+
+        REQUIRE(got.size() == N);
+        REQUIRE(got == data);
+    }
+
+    SECTION("non-blocking") {
+        REQUIRE(srv.set_non_blocking());
+        auto res = rdr.read();
+        REQUIRE(!res);
+        REQUIRE(
+            (res == errc::operation_would_block || res == errc::resource_unavailable_try_again)
+        );
+
+        REQUIRE(cli.write(string{"hello"}));
+        string got;
+        for (int i = 0; i < 100 && got.size() < 5; ++i) {
+            if ((res = rdr.read())) {
+                got.append(res.value().mapped);
+                got.append(res.value().copied);
+            }
+            else
+                this_thread::sleep_for(milliseconds{1});
+        }
+        REQUIRE(got == "hello");
+        rdr.release();
+    }
+}